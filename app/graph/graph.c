@@ -26,6 +26,7 @@ cmd_graph_help[] = "graph <usecases> coremask <bitmask> bsz <size> tmo <ns> "
 		   "pcap_file <output_capture_file>";
 
 static const char * const supported_usecases[] = {"l3fwd", "l2fwd"};
+static const char *profile_pmu_events[] = {"instructions", "cache-misses", "branch-misses"};
 struct graph_config graph_config;
 bool graph_started;
 
@@ -252,6 +253,92 @@ cmd_graph_stats_show_parsed(__rte_unused void *parsed_result, __rte_unused struc
 	graph_stats_print_to_file();
 }
 
+static void
+graph_profile_set(bool enable, bool pmu)
+{
+	struct rte_graph_profile_param prm;
+	struct lcore_conf *qconf;
+	uint32_t lcore_id;
+	int rc;
+
+	if (!graph_started) {
+		printf(MSG_CMD_FAIL, "graph profile");
+		return;
+	}
+
+	memset(&prm, 0, sizeof(prm));
+	if (pmu) {
+		prm.nb_pmu_events = RTE_DIM(profile_pmu_events);
+		prm.pmu_events = profile_pmu_events;
+	}
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		qconf = &lcore_conf[lcore_id];
+		if (qconf->graph == NULL)
+			continue;
+
+		if (enable)
+			rc = rte_graph_profile_enable(qconf->graph_id, &prm);
+		else
+			rc = rte_graph_profile_disable(qconf->graph_id);
+		if (rc < 0)
+			printf(MSG_CMD_FAIL, "graph profile");
+	}
+}
+
+void
+cmd_graph_profile_parsed(void *parsed_result, __rte_unused struct cmdline *cl,
+			 __rte_unused void *data)
+{
+	struct cmd_graph_profile_result *res = parsed_result;
+
+	graph_profile_set(strcmp(res->action, "enable") == 0, false);
+}
+
+void
+cmd_graph_profile_pmu_enable_parsed(__rte_unused void *parsed_result,
+				    __rte_unused struct cmdline *cl, __rte_unused void *data)
+{
+	graph_profile_set(true, true);
+}
+
+void
+cmd_graph_profile_show_parsed(__rte_unused void *parsed_result, __rte_unused struct cmdline *cl,
+			      __rte_unused void *data)
+{
+	struct lcore_conf *qconf;
+	uint32_t lcore_id;
+	size_t sz, len;
+	FILE *fp;
+
+	fp = fopen("/tmp/graph_profile.txt", "w+");
+	if (fp == NULL) {
+		printf(MSG_CMD_FAIL, "graph profile show");
+		return;
+	}
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		qconf = &lcore_conf[lcore_id];
+		if (qconf->graph != NULL)
+			rte_graph_profile_dump(fp, qconf->graph_id);
+	}
+
+	fseek(fp, 0L, SEEK_END);
+	sz = ftell(fp);
+	fseek(fp, 0L, SEEK_SET);
+
+	len = strlen(conn->msg_out);
+	conn->msg_out += len;
+
+	sz = RTE_MIN(sz, conn->msg_out_len_max - len - 1);
+	sz = fread(conn->msg_out, sizeof(char), sz, fp);
+	conn->msg_out[sz] = '\0';
+	len = strlen(conn->msg_out);
+	conn->msg_out_len_max -= len;
+
+	fclose(fp);
+}
+
 bool
 graph_status_get(void)
 {
@@ -442,9 +529,11 @@ cmd_help_graph_parsed(__rte_unused void *parsed_result, __rte_unused struct cmdl
 
 	len = strlen(conn->msg_out);
 	conn->msg_out += len;
-	snprintf(conn->msg_out, conn->msg_out_len_max, "\n%s\n%s\n%s\n%s\n",
+	snprintf(conn->msg_out, conn->msg_out_len_max, "\n%s\n%s\n%s\n%s\n%s\n%s\n%s\n",
 		 "----------------------------- graph command help -----------------------------",
-		 cmd_graph_help, "graph start", "graph stats show");
+		 cmd_graph_help, "graph start", "graph stats show",
+		 "graph profile <enable | disable>", "graph profile pmu enable",
+		 "graph profile show");
 
 	len = strlen(conn->msg_out);
 	conn->msg_out_len_max -= len;
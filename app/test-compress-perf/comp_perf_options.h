@@ -28,7 +28,8 @@ enum cleanup_st {
 enum cperf_test_type {
 	CPERF_TEST_TYPE_THROUGHPUT,
 	CPERF_TEST_TYPE_VERIFY,
-	CPERF_TEST_TYPE_PMDCC
+	CPERF_TEST_TYPE_PMDCC,
+	CPERF_TEST_TYPE_CHUNKED
 };
 
 enum comp_operation {
@@ -67,6 +68,8 @@ struct comp_test_data {
 	enum rte_comp_algorithm test_algo;
 
 	int window_sz;
+	uint32_t dict_sz;
+	uint32_t chunk_sz;
 	struct range_list level_lst;
 	uint8_t level;
 	int use_external_mbufs;
@@ -12,6 +12,7 @@
 
 #include <rte_string_fns.h>
 #include <rte_comp.h>
+#include <rte_compressdev_chunk.h>
 
 #include "comp_perf_options.h"
 
@@ -31,6 +32,8 @@
 #define CPERF_LEVEL		("compress-level")
 #define CPERF_WINDOW_SIZE	("window-sz")
 #define CPERF_EXTERNAL_MBUFS	("external-mbufs")
+#define CPERF_DICT_SIZE		("dict-sz")
+#define CPERF_CHUNK_SIZE	("chunk-sz")
 
 /* cyclecount-specific options */
 #define CPERF_CYCLECOUNT_DELAY_US ("cc-delay-us")
@@ -44,7 +47,7 @@ static void
 usage(char *progname)
 {
 	printf("%s [EAL options] --\n"
-		" --ptest throughput / verify / pmd-cyclecount\n"
+		" --ptest throughput / verify / pmd-cyclecount / chunked\n"
 		" --driver-name NAME: compress driver to use\n"
 		" --input-file NAME: file to compress and decompress\n"
 		" --extended-input-sz N: extend file data up to this size (default: no extension)\n"
@@ -69,6 +72,11 @@ usage(char *progname)
 		"		(e.g.: 15 => 32k, default: max supported by PMD)\n"
 		" --external-mbufs: use memzones as external buffers instead of\n"
 		"		keeping the data directly in mbuf area\n"
+		" --dict-sz N: use the first N bytes of the input data as\n"
+		"		preset dictionary (default: 0, no dictionary),\n"
+		"		or for chunked test, the N bytes preceding each chunk\n"
+		" --chunk-sz N: size of the chunks compressed in parallel,\n"
+		"		valid only for chunked test (default: 32768)\n"
 		" --cc-delay-us N: delay between enqueue and dequeue operations in microseconds\n"
 		"		valid only for cyclecount perf test (default: 500 us)\n"
 		" -h: prints this help\n",
@@ -105,6 +113,10 @@ parse_cperf_test_type(struct comp_test_data *test_data, const char *arg)
 		{
 			comp_perf_test_type_strs[CPERF_TEST_TYPE_PMDCC],
 			CPERF_TEST_TYPE_PMDCC
+		},
+		{
+			comp_perf_test_type_strs[CPERF_TEST_TYPE_CHUNKED],
+			CPERF_TEST_TYPE_CHUNKED
 		}
 	};
 
@@ -439,6 +451,39 @@ parse_window_sz(struct comp_test_data *test_data, const char *arg)
 	return 0;
 }
 
+static int
+parse_dict_sz(struct comp_test_data *test_data, const char *arg)
+{
+	int ret = parse_uint32_t(&test_data->dict_sz, arg);
+
+	if (ret) {
+		RTE_LOG(ERR, USER1, "Failed to parse dictionary size\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+parse_chunk_sz(struct comp_test_data *test_data, const char *arg)
+{
+	int ret = parse_uint32_t(&test_data->chunk_sz, arg);
+
+	if (ret) {
+		RTE_LOG(ERR, USER1, "Failed to parse chunk size\n");
+		return -1;
+	}
+
+	if (test_data->chunk_sz == 0 ||
+			test_data->chunk_sz > RTE_COMPRESSDEV_CHUNK_SZ_MAX) {
+		RTE_LOG(ERR, USER1, "Chunk size must be between 1 and %d\n",
+			RTE_COMPRESSDEV_CHUNK_SZ_MAX);
+		return -1;
+	}
+
+	return 0;
+}
+
 static int
 parse_driver_name(struct comp_test_data *test_data, const char *arg)
 {
@@ -647,6 +692,8 @@ static struct option lgopts[] = {
 	{ CPERF_LEVEL, required_argument, 0, 0 },
 	{ CPERF_WINDOW_SIZE, required_argument, 0, 0 },
 	{ CPERF_EXTERNAL_MBUFS, 0, 0, 0 },
+	{ CPERF_DICT_SIZE, required_argument, 0, 0 },
+	{ CPERF_CHUNK_SIZE, required_argument, 0, 0 },
 	{ CPERF_CYCLECOUNT_DELAY_US, required_argument, 0, 0 },
 	{ NULL, 0, 0, 0 }
 };
@@ -671,6 +718,8 @@ comp_perf_opts_parse_long(int opt_idx, struct comp_test_data *test_data)
 		{ CPERF_LEVEL,		parse_level },
 		{ CPERF_WINDOW_SIZE,	parse_window_sz },
 		{ CPERF_EXTERNAL_MBUFS,	parse_external_mbufs },
+		{ CPERF_DICT_SIZE,	parse_dict_sz },
+		{ CPERF_CHUNK_SIZE,	parse_chunk_sz },
 		{ CPERF_CYCLECOUNT_DELAY_US,	parse_cyclecount_delay_us },
 	};
 	unsigned int i;
@@ -725,6 +774,8 @@ comp_perf_options_default(struct comp_test_data *test_data)
 	test_data->test_op = COMPRESS_DECOMPRESS;
 	test_data->test_algo = RTE_COMP_ALGO_DEFLATE;
 	test_data->window_sz = -1;
+	test_data->dict_sz = 0;
+	test_data->chunk_sz = 32768;
 	test_data->level_lst.min = RTE_COMP_LEVEL_MIN;
 	test_data->level_lst.max = RTE_COMP_LEVEL_MAX;
 	test_data->level_lst.inc = 1;
@@ -0,0 +1,423 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_eal.h>
+#include <rte_log.h>
+#include <rte_cycles.h>
+#include <rte_mbuf.h>
+#include <rte_pause.h>
+#include <rte_compressdev.h>
+#include <rte_compressdev_chunk.h>
+
+#include "comp_perf_test_chunked.h"
+
+/* State shared by the lcores compressing the chunks of the same buffer */
+struct cperf_chunked_shared {
+	uint8_t dev_id;
+	uint16_t nb_workers;
+	struct rte_compressdev_chunk_ctx *chunk_ctx;
+	/* Compression level of the chunk context */
+	uint8_t level;
+	/* Set by the first queue pair lcore, read after a barrier */
+	int stop;
+
+	RTE_ATOMIC(uint16_t) barrier_cnt;
+	RTE_ATOMIC(uint32_t) barrier_sense;
+
+	uint8_t *comp_data;
+	size_t comp_data_sz;
+	size_t comp_sz;
+
+	/* Decompression resources of the verification */
+	struct rte_mempool *op_pool;
+	struct rte_mempool *mbuf_pool;
+};
+
+static struct cperf_chunked_shared *chunked_shared;
+
+void
+cperf_chunked_test_destructor(void *arg)
+{
+	struct cperf_chunked_ctx *ctx = arg;
+	struct cperf_chunked_shared *shared;
+
+	if (ctx == NULL)
+		return;
+
+	shared = ctx->shared;
+	rte_free(ctx);
+
+	if (--shared->nb_workers != 0)
+		return;
+
+	rte_compressdev_chunk_ctx_free(shared->chunk_ctx);
+	rte_mempool_free(shared->mbuf_pool);
+	rte_mempool_free(shared->op_pool);
+	rte_free(shared->comp_data);
+	rte_free(shared);
+	chunked_shared = NULL;
+}
+
+void *
+cperf_chunked_test_constructor(uint8_t dev_id, uint16_t qp_id,
+		struct comp_test_data *options)
+{
+	struct cperf_chunked_ctx *ctx;
+
+	if (options->test_algo != RTE_COMP_ALGO_DEFLATE) {
+		RTE_LOG(ERR, USER1,
+			"Chunked compression is only supported with DEFLATE\n");
+		return NULL;
+	}
+
+	ctx = rte_zmalloc_socket(NULL, sizeof(*ctx), 0, rte_socket_id());
+	if (ctx == NULL)
+		return NULL;
+
+	if (chunked_shared == NULL) {
+		chunked_shared = rte_zmalloc_socket(NULL,
+				sizeof(*chunked_shared), 0, rte_socket_id());
+		if (chunked_shared == NULL) {
+			rte_free(ctx);
+			return NULL;
+		}
+		chunked_shared->dev_id = dev_id;
+	}
+
+	ctx->dev_id = dev_id;
+	ctx->qp_id = qp_id;
+	ctx->options = options;
+	ctx->shared = chunked_shared;
+	chunked_shared->nb_workers++;
+
+	return ctx;
+}
+
+/* Wait for all the lcores of the test */
+static void
+chunked_barrier(struct cperf_chunked_ctx *ctx)
+{
+	struct cperf_chunked_shared *shared = ctx->shared;
+
+	ctx->sense ^= 1;
+	if (rte_atomic_fetch_add_explicit(&shared->barrier_cnt, 1,
+			rte_memory_order_acq_rel) == shared->nb_workers - 1) {
+		rte_atomic_store_explicit(&shared->barrier_cnt, 0,
+				rte_memory_order_relaxed);
+		rte_atomic_store_explicit(&shared->barrier_sense, ctx->sense,
+				rte_memory_order_release);
+		return;
+	}
+
+	while (rte_atomic_load_explicit(&shared->barrier_sense,
+			rte_memory_order_acquire) != ctx->sense)
+		rte_pause();
+}
+
+/* Create the chunk context of the current compression level */
+static int
+chunked_setup(struct cperf_chunked_shared *shared,
+		struct comp_test_data *test_data)
+{
+	struct rte_comp_xform xform = {
+		.type = RTE_COMP_COMPRESS,
+		.compress = {
+			.algo = RTE_COMP_ALGO_DEFLATE,
+			.deflate.huffman = test_data->huffman_enc,
+			.level = test_data->level,
+			.window_size = test_data->window_sz,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+			.hash_algo = RTE_COMP_HASH_ALGO_NONE
+		}
+	};
+	struct rte_compressdev_chunk_conf conf = {
+		.dev_id = shared->dev_id,
+		.nb_qps = shared->nb_workers,
+		.depth = test_data->burst_sz,
+		.chunk_sz = test_data->chunk_sz,
+		.dict_sz = test_data->dict_sz,
+		.xform = &xform,
+		.socket_id = rte_compressdev_socket_id(shared->dev_id),
+	};
+
+	if (shared->chunk_ctx != NULL && shared->level == test_data->level)
+		return 0;
+
+	rte_compressdev_chunk_ctx_free(shared->chunk_ctx);
+	shared->chunk_ctx = rte_compressdev_chunk_ctx_create(&conf);
+	if (shared->chunk_ctx == NULL) {
+		RTE_LOG(ERR, USER1,
+			"Chunk context could not be created: %s\n",
+			rte_strerror(rte_errno));
+		return -1;
+	}
+	shared->level = test_data->level;
+
+	return 0;
+}
+
+/* Get the DEFLATE stream of the buffer, growing the output as needed */
+static int
+chunked_finish(struct cperf_chunked_shared *shared)
+{
+	size_t len = shared->comp_data_sz;
+	int ret;
+
+	ret = rte_compressdev_chunk_finish(shared->chunk_ctx,
+			shared->comp_data, &len);
+	if (ret == -ENOSPC) {
+		rte_free(shared->comp_data);
+		shared->comp_data = rte_malloc_socket(NULL, len, 0,
+				rte_socket_id());
+		if (shared->comp_data == NULL) {
+			shared->comp_data_sz = 0;
+			RTE_LOG(ERR, USER1,
+				"Memory for the compressed data could not be allocated\n");
+			return -1;
+		}
+		shared->comp_data_sz = len;
+		ret = rte_compressdev_chunk_finish(shared->chunk_ctx,
+				shared->comp_data, &len);
+	}
+	if (ret < 0) {
+		RTE_LOG(ERR, USER1, "Chunked compression failed: %s\n",
+			rte_strerror(-ret));
+		return -1;
+	}
+	shared->comp_sz = len;
+
+	return 0;
+}
+
+/* Decompress the stitched stream on a stream of the device, in pieces
+ * fitting in an mbuf, and compare it with the input data.
+ */
+static int
+chunked_verify(struct cperf_chunked_shared *shared,
+		struct comp_test_data *test_data)
+{
+	const struct rte_compressdev_capabilities *cap;
+	struct rte_comp_xform xform = {
+		.type = RTE_COMP_DECOMPRESS,
+		.decompress = {
+			.algo = RTE_COMP_ALGO_DEFLATE,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+			.window_size = test_data->window_sz,
+			.hash_algo = RTE_COMP_HASH_ALGO_NONE
+		}
+	};
+	struct rte_mbuf *m_src = NULL, *m_dst = NULL;
+	struct rte_comp_op *op = NULL, *deq_op;
+	size_t in_off = 0, out_off = 0;
+	void *stream = NULL;
+	uint32_t len;
+	int ret = -1;
+
+	cap = rte_compressdev_capability_get(shared->dev_id,
+			RTE_COMP_ALGO_DEFLATE);
+	if (cap == NULL || !(cap->comp_feature_flags &
+			RTE_COMP_FF_STATEFUL_DECOMPRESSION)) {
+		RTE_LOG(INFO, USER1, "Stateful decompression not supported, "
+			"the chunked stream is not verified\n");
+		return 0;
+	}
+
+	if (shared->op_pool == NULL)
+		shared->op_pool = rte_comp_op_pool_create("chunked_op_pool",
+				1, 0, 0, rte_socket_id());
+	if (shared->mbuf_pool == NULL)
+		shared->mbuf_pool = rte_pktmbuf_pool_create("chunked_mbuf_pool",
+				2, 0, 0, MAX_MBUF_DATA_SIZE + RTE_PKTMBUF_HEADROOM,
+				rte_socket_id());
+	if (shared->op_pool == NULL || shared->mbuf_pool == NULL) {
+		RTE_LOG(ERR, USER1, "Verification pools could not be created\n");
+		return -1;
+	}
+
+	op = rte_comp_op_alloc(shared->op_pool);
+	m_src = rte_pktmbuf_alloc(shared->mbuf_pool);
+	m_dst = rte_pktmbuf_alloc(shared->mbuf_pool);
+	if (op == NULL || m_src == NULL || m_dst == NULL ||
+			rte_compressdev_stream_create(shared->dev_id, &xform,
+				&stream) < 0) {
+		RTE_LOG(ERR, USER1,
+			"Verification resources could not be allocated\n");
+		goto end;
+	}
+
+	while (1) {
+		len = RTE_MIN(shared->comp_sz - in_off,
+				(size_t)MAX_MBUF_DATA_SIZE);
+		rte_pktmbuf_reset(m_src);
+		rte_pktmbuf_reset(m_dst);
+		memcpy(rte_pktmbuf_append(m_src, len),
+				shared->comp_data + in_off, len);
+		rte_pktmbuf_append(m_dst, MAX_MBUF_DATA_SIZE);
+
+		op->op_type = RTE_COMP_OP_STATEFUL;
+		op->stream = stream;
+		op->m_src = m_src;
+		op->m_dst = m_dst;
+		op->src.offset = 0;
+		op->src.length = len;
+		op->dst.offset = 0;
+		op->flush_flag = in_off + len == shared->comp_sz ?
+				RTE_COMP_FLUSH_FINAL : RTE_COMP_FLUSH_NONE;
+		op->consumed = 0;
+		op->produced = 0;
+		op->status = RTE_COMP_OP_STATUS_NOT_PROCESSED;
+
+		while (rte_compressdev_enqueue_burst(shared->dev_id, 0,
+				&op, 1) == 0)
+			;
+		while (rte_compressdev_dequeue_burst(shared->dev_id, 0,
+				&deq_op, 1) == 0)
+			;
+
+		if ((op->status != RTE_COMP_OP_STATUS_SUCCESS &&
+				op->status !=
+				RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE) ||
+				out_off + op->produced >
+					test_data->input_data_sz ||
+				memcmp(rte_pktmbuf_mtod(m_dst, uint8_t *),
+					test_data->input_data + out_off,
+					op->produced) != 0) {
+			RTE_LOG(ERR, USER1, "Chunked stream does not match "
+				"the input data at offset %zu, status %u\n",
+				out_off, op->status);
+			goto end;
+		}
+
+		in_off += op->consumed;
+		out_off += op->produced;
+		if (op->status == RTE_COMP_OP_STATUS_SUCCESS &&
+				in_off == shared->comp_sz)
+			break;
+	}
+
+	if (out_off != test_data->input_data_sz) {
+		RTE_LOG(ERR, USER1, "Chunked stream decompressed to %zu bytes "
+			"instead of %zu\n", out_off, test_data->input_data_sz);
+		goto end;
+	}
+
+	ret = 0;
+
+end:
+	if (stream != NULL)
+		rte_compressdev_stream_free(shared->dev_id, stream);
+	rte_pktmbuf_free(m_src);
+	rte_pktmbuf_free(m_dst);
+	rte_comp_op_free(op);
+	return ret;
+}
+
+int
+cperf_chunked_test_runner(void *test_ctx)
+{
+	struct cperf_chunked_ctx *ctx = test_ctx;
+	struct cperf_chunked_shared *shared = ctx->shared;
+	struct comp_test_data *test_data = ctx->options;
+	static RTE_ATOMIC(uint16_t) display_once;
+	bool leader = ctx->qp_id == 0;
+	uint64_t tsc_start = 0, tsc_duration;
+	double gbps, base_gbps = 0;
+	uint16_t nb_qps = 1;
+	int ret = EXIT_SUCCESS;
+	uint32_t i;
+	int stop;
+
+	if (leader)
+		shared->stop = chunked_setup(shared, test_data) < 0;
+	chunked_barrier(ctx);
+	if (shared->stop)
+		return EXIT_FAILURE;
+
+	if (leader) {
+		uint16_t exp = 0;
+
+		if (rte_atomic_compare_exchange_strong_explicit(&display_once,
+				&exp, 1, rte_memory_order_relaxed,
+				rte_memory_order_relaxed))
+			printf("\n%12s%6s%12s%17s%15s%10s\n",
+				"Queue pairs", "Level", "Comp size",
+				"Comp ratio [%]", "Comp [Gbps]", "Speedup");
+	}
+
+	/* Double the number of queue pairs compressing the buffer
+	 * at each round, up to all of them.
+	 */
+	while (1) {
+		tsc_duration = 0;
+
+		/* The first compression of the buffer is not measured */
+		for (i = 0; i <= test_data->num_iter; i++) {
+			if (leader) {
+				if (test_data->perf_comp_force_stop) {
+					RTE_LOG(ERR, USER1,
+						"Perf. test has been aborted by user\n");
+					shared->stop = 1;
+					ret = EXIT_FAILURE;
+				} else if (rte_compressdev_chunk_start(
+						shared->chunk_ctx,
+						test_data->input_data,
+						test_data->input_data_sz) < 0) {
+					shared->stop = 1;
+					ret = EXIT_FAILURE;
+				}
+				tsc_start = rte_rdtsc_precise();
+			}
+
+			chunked_barrier(ctx);
+			stop = shared->stop;
+			if (stop)
+				break;
+
+			/* Errors are reported when the stream is stitched */
+			if (ctx->qp_id < nb_qps)
+				rte_compressdev_chunk_process(shared->chunk_ctx,
+						ctx->qp_id);
+
+			chunked_barrier(ctx);
+			if (!leader)
+				continue;
+
+			if (i != 0)
+				tsc_duration += rte_rdtsc_precise() - tsc_start;
+			if (chunked_finish(shared) < 0 ||
+					(i == 0 && nb_qps == shared->nb_workers &&
+					chunked_verify(shared, test_data) < 0)) {
+				shared->stop = 1;
+				ret = EXIT_FAILURE;
+			}
+		}
+
+		if (stop)
+			break;
+
+		if (leader && tsc_duration != 0) {
+			gbps = (double)test_data->input_data_sz * 8 *
+				test_data->num_iter * rte_get_tsc_hz() /
+				tsc_duration / 1000000000;
+			if (nb_qps == 1)
+				base_gbps = gbps;
+			printf("%12u%6u%12zu%17.2f%15.2f%10.2f\n",
+				nb_qps, test_data->level, shared->comp_sz,
+				(double)shared->comp_sz /
+					test_data->input_data_sz * 100,
+				gbps, base_gbps != 0 ? gbps / base_gbps : 0);
+		}
+
+		if (nb_qps == shared->nb_workers)
+			break;
+		nb_qps = RTE_MIN(nb_qps * 2, shared->nb_workers);
+	}
+
+	return ret;
+}
@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#ifndef _COMP_PERF_TEST_CHUNKED_
+#define _COMP_PERF_TEST_CHUNKED_
+
+#include <stdint.h>
+
+#include "comp_perf_options.h"
+
+struct cperf_chunked_shared;
+
+struct cperf_chunked_ctx {
+	uint8_t dev_id;
+	uint16_t qp_id;
+	struct comp_test_data *options;
+	struct cperf_chunked_shared *shared;
+	/* Phase of the last barrier crossed */
+	uint32_t sense;
+};
+
+void
+cperf_chunked_test_destructor(void *arg);
+
+int
+cperf_chunked_test_runner(void *test_ctx);
+
+void *
+cperf_chunked_test_constructor(uint8_t dev_id, uint16_t qp_id,
+		struct comp_test_data *options);
+
+#endif
@@ -554,6 +554,29 @@ prepare_bufs(struct comp_test_data *test_data, struct cperf_mem_resources *mem)
 	return 0;
 }
 
+/* Set the start of the input data as preset dictionary, if requested */
+int
+comp_perf_set_dict(const struct comp_test_data *test_data, uint8_t dev_id,
+		void *priv_xform)
+{
+	if (test_data->dict_sz == 0)
+		return 0;
+
+	if (test_data->dict_sz > test_data->input_data_sz) {
+		RTE_LOG(ERR, USER1,
+			"Dictionary size must not exceed the input data size\n");
+		return -1;
+	}
+
+	if (rte_compressdev_private_xform_dict_set(dev_id, priv_xform,
+			test_data->input_data, test_data->dict_sz) < 0) {
+		RTE_LOG(ERR, USER1, "Dictionary could not be set\n");
+		return -1;
+	}
+
+	return 0;
+}
+
 void
 print_test_dynamics(const struct comp_test_data *test_data)
 {
@@ -51,4 +51,8 @@ prepare_bufs(struct comp_test_data *test_data, struct cperf_mem_resources *mem);
 void
 print_test_dynamics(const struct comp_test_data *test_data);
 
+int
+comp_perf_set_dict(const struct comp_test_data *test_data, uint8_t dev_id,
+		void *priv_xform);
+
 #endif /* _COMP_PERF_TEST_COMMON_H_ */
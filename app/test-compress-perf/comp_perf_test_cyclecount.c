@@ -232,6 +232,12 @@ main_loop(struct cperf_cyclecount_ctx *ctx, enum rte_comp_xform_type type)
 		goto end;
 	}
 
+	/* Preset dictionary, shared by compression and decompression */
+	if (comp_perf_set_dict(test_data, dev_id, priv_xform) < 0) {
+		res = -1;
+		goto end;
+	}
+
 	tsc_start = rte_rdtsc_precise();
 	ret = cperf_cyclecount_op_setup(ops,
 				ctx,
@@ -123,6 +123,12 @@ main_loop(struct cperf_benchmark_ctx *ctx, enum rte_comp_xform_type type)
 		goto end;
 	}
 
+	/* Preset dictionary, shared by compression and decompression */
+	if (comp_perf_set_dict(test_data, dev_id, priv_xform) < 0) {
+		res = -1;
+		goto end;
+	}
+
 	uint64_t tsc_start, tsc_end, tsc_duration;
 
 	num_iter = test_data->num_iter;
@@ -131,6 +131,12 @@ main_loop(struct cperf_verify_ctx *ctx, enum rte_comp_xform_type type)
 		goto end;
 	}
 
+	/* Preset dictionary, shared by compression and decompression */
+	if (comp_perf_set_dict(test_data, dev_id, priv_xform) < 0) {
+		res = -1;
+		goto end;
+	}
+
 	num_iter = 1;
 
 	for (iter = 0; iter < num_iter; iter++) {
@@ -14,6 +14,7 @@
 
 #include "comp_perf.h"
 #include "comp_perf_options.h"
+#include "comp_perf_test_chunked.h"
 #include "comp_perf_test_common.h"
 #include "comp_perf_test_cyclecount.h"
 #include "comp_perf_test_throughput.h"
@@ -26,7 +27,8 @@ __extension__
 const char *comp_perf_test_type_strs[] = {
 	[CPERF_TEST_TYPE_THROUGHPUT] = "throughput",
 	[CPERF_TEST_TYPE_VERIFY] = "verify",
-	[CPERF_TEST_TYPE_PMDCC] = "pmd-cyclecount"
+	[CPERF_TEST_TYPE_PMDCC] = "pmd-cyclecount",
+	[CPERF_TEST_TYPE_CHUNKED] = "chunked"
 };
 
 __extension__
@@ -47,6 +49,12 @@ static const struct cperf_test cperf_testmap[] = {
 			cperf_cyclecount_test_constructor,
 			cperf_cyclecount_test_runner,
 			cperf_cyclecount_test_destructor
+	},
+
+	[CPERF_TEST_TYPE_CHUNKED] = {
+			cperf_chunked_test_constructor,
+			cperf_chunked_test_runner,
+			cperf_chunked_test_destructor
 	}
 };
 
@@ -131,6 +139,14 @@ comp_perf_check_capabilities(struct comp_test_data *test_data, uint8_t cdev_id)
 		test_data->max_sgl_segs = 1;
 	}
 
+	/* Preset dictionary */
+	if (test_data->dict_sz != 0 &&
+			(comp_flags & RTE_COMP_FF_PRESET_DICT) == 0) {
+		RTE_LOG(ERR, USER1, "Compress device does not support "
+				"preset dictionaries\n");
+		return -1;
+	}
+
 	/* Level 0 support */
 	if (test_data->level_lst.min == 0 &&
 			(comp_flags & RTE_COMP_FF_NONCOMPRESSED_BLOCKS) == 0) {
@@ -176,6 +192,10 @@ comp_perf_initialize_compressdev(struct comp_test_data *test_data,
 			nb_lcores);
 	}
 
+	/* The chunks of a buffer are spread on the queue pairs of a device */
+	if (test_data->test == CPERF_TEST_TYPE_CHUNKED)
+		enabled_cdev_count = 1;
+
 	/*
 	 * Calculate number of needed queue pairs, based on the amount
 	 * of available number of logical cores and compression devices.
@@ -223,6 +243,10 @@ comp_perf_initialize_compressdev(struct comp_test_data *test_data,
 			.max_nb_streams = 0
 		};
 		test_data->nb_qps = config.nb_queue_pairs;
+		/* One stream per chunk in flight, and one to verify */
+		if (test_data->test == CPERF_TEST_TYPE_CHUNKED)
+			config.max_nb_streams = RTE_MIN(test_data->nb_qps *
+					test_data->burst_sz + 1, UINT16_MAX);
 
 		if (rte_compressdev_configure(cdev_id, &config) < 0) {
 			RTE_LOG(ERR, USER1, "Device configuration failed\n");
@@ -445,7 +469,8 @@ main(int argc, char **argv)
 		i++;
 	}
 
-	print_test_dynamics(test_data);
+	if (test_data->test != CPERF_TEST_TYPE_CHUNKED)
+		print_test_dynamics(test_data);
 
 	while (test_data->level <= test_data->level_lst.max) {
 
@@ -30,6 +30,9 @@
 #define CPERF_OPTYPE		("optype")
 #define CPERF_SESSIONLESS	("sessionless")
 #define CPERF_SHARED_SESSION	("shared-session")
+#define CPERF_SESSIONS		("sessions")
+#define CPERF_SESSION_ZIPF	("session-zipf")
+#define CPERF_DECRYPT_PCT	("decrypt-pct")
 #define CPERF_OUT_OF_PLACE	("out-of-place")
 #define CPERF_TEST_FILE		("test-file")
 #define CPERF_TEST_NAME		("test-name")
@@ -113,6 +116,14 @@ struct cperf_options {
 	uint32_t test_buffer_size;
 	uint32_t *imix_buffer_sizes;
 	uint32_t nb_descriptors;
+	uint16_t nb_sessions;
+	uint8_t decrypt_pct;
+	double session_zipf;
+	/* Sequence of the session used by each op, an index greater than or
+	 * equal to nb_sessions selecting the reverse direction session.
+	 */
+	uint32_t *session_seq;
+	uint32_t session_seq_sz;
 	uint16_t nb_qps;
 	uint64_t low_prio_qp_mask;
 
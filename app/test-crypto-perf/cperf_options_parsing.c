@@ -42,6 +42,10 @@ usage(char *progname)
 		"        aead / pdcp / docsis / ipsec / modex / rsa / secp256r1 / eddsa / sm2 / tls-record : set operation type\n"
 		" --sessionless: enable session-less crypto operations\n"
 		" --shared-session: share 1 session across all queue pairs on crypto device\n"
+		" --sessions N: set the number of sessions per queue pair\n"
+		" --session-zipf S: pick the sessions with a Zipf distribution of\n"
+		"           exponent S instead of round-robin\n"
+		" --decrypt-pct N: set the percentage of operations in the reverse direction\n"
 		" --out-of-place: enable out-of-place crypto operations\n"
 		" --test-file NAME: set the test vector file path\n"
 		" --test-name NAME: set specific test name section in test file\n"
@@ -575,6 +579,52 @@ parse_shared_session(struct cperf_options *opts,
 	return 0;
 }
 
+static int
+parse_sessions(struct cperf_options *opts, const char *arg)
+{
+	int ret = parse_uint16_t(&opts->nb_sessions, arg);
+
+	if (ret || opts->nb_sessions == 0) {
+		RTE_LOG(ERR, USER1, "failed to parse number of sessions\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+parse_session_zipf(struct cperf_options *opts, const char *arg)
+{
+	char *end = NULL;
+	double s = strtod(arg, &end);
+
+	if (arg[0] == '\0' || end == NULL || *end != '\0' ||
+			!(s >= 0.0 && s <= 16.0)) {
+		RTE_LOG(ERR, USER1, "failed to parse session Zipf exponent\n");
+		return -1;
+	}
+
+	opts->session_zipf = s;
+
+	return 0;
+}
+
+static int
+parse_decrypt_pct(struct cperf_options *opts, const char *arg)
+{
+	uint32_t pct = 0;
+	int ret = parse_uint32_t(&pct, arg);
+
+	if (ret || pct > 100) {
+		RTE_LOG(ERR, USER1, "failed to parse decrypt percentage\n");
+		return -1;
+	}
+
+	opts->decrypt_pct = pct;
+
+	return 0;
+}
+
 static int
 parse_out_of_place(struct cperf_options *opts,
 		const char *arg __rte_unused)
@@ -1037,6 +1087,9 @@ static struct option lgopts[] = {
 	{ CPERF_SILENT, no_argument, 0, 0 },
 	{ CPERF_SESSIONLESS, no_argument, 0, 0 },
 	{ CPERF_SHARED_SESSION, no_argument, 0, 0 },
+	{ CPERF_SESSIONS, required_argument, 0, 0 },
+	{ CPERF_SESSION_ZIPF, required_argument, 0, 0 },
+	{ CPERF_DECRYPT_PCT, required_argument, 0, 0 },
 	{ CPERF_OUT_OF_PLACE, no_argument, 0, 0 },
 	{ CPERF_TEST_FILE, required_argument, 0, 0 },
 	{ CPERF_TEST_NAME, required_argument, 0, 0 },
@@ -1117,6 +1170,9 @@ cperf_options_default(struct cperf_options *opts)
 	opts->test_file = NULL;
 	opts->test_name = NULL;
 	opts->sessionless = 0;
+	opts->nb_sessions = 1;
+	opts->session_zipf = 0;
+	opts->decrypt_pct = 0;
 	opts->out_of_place = 0;
 	opts->csv = 0;
 
@@ -1175,6 +1231,9 @@ cperf_opts_parse_long(int opt_idx, struct cperf_options *opts)
 		{ CPERF_OPTYPE,		parse_op_type },
 		{ CPERF_SESSIONLESS,	parse_sessionless },
 		{ CPERF_SHARED_SESSION,	parse_shared_session },
+		{ CPERF_SESSIONS,	parse_sessions },
+		{ CPERF_SESSION_ZIPF,	parse_session_zipf },
+		{ CPERF_DECRYPT_PCT,	parse_decrypt_pct },
 		{ CPERF_OUT_OF_PLACE,	parse_out_of_place },
 		{ CPERF_IMIX,		parse_imix },
 		{ CPERF_TEST_FILE,	parse_test_file },
@@ -1464,6 +1523,58 @@ cperf_options_check(struct cperf_options *options)
 		return -EINVAL;
 	}
 
+	if (options->nb_sessions > 1 || options->decrypt_pct != 0) {
+		if (options->test != CPERF_TEST_TYPE_THROUGHPUT &&
+				options->test != CPERF_TEST_TYPE_LATENCY) {
+			RTE_LOG(ERR, USER1, "Multiple sessions are only "
+					"allowed in throughput and latency tests.\n");
+			return -EINVAL;
+		}
+		if (options->op_type != CPERF_CIPHER_ONLY &&
+				options->op_type != CPERF_AUTH_ONLY &&
+				options->op_type != CPERF_CIPHER_THEN_AUTH &&
+				options->op_type != CPERF_AUTH_THEN_CIPHER &&
+				options->op_type != CPERF_AEAD) {
+			RTE_LOG(ERR, USER1, "Multiple sessions are only "
+					"allowed with symmetric operations.\n");
+			return -EINVAL;
+		}
+		if (options->sessionless || options->shared_session) {
+			RTE_LOG(ERR, USER1, "Multiple sessions are not allowed "
+					"with session-less operations or "
+					"shared sessions.\n");
+			return -EINVAL;
+		}
+	}
+
+	if (options->decrypt_pct != 0) {
+		if (options->imix_distribution_count > 0 ||
+				options->out_of_place) {
+			RTE_LOG(ERR, USER1, "Reverse direction operations are "
+					"not allowed with IMIX or out of "
+					"place mode.\n");
+			return -EINVAL;
+		}
+		/* The digest must be computed on the ciphertext */
+		if ((options->op_type == CPERF_CIPHER_THEN_AUTH ||
+				options->op_type == CPERF_AUTH_THEN_CIPHER) &&
+				(!is_valid_chained_op(options) ||
+				 (options->op_type == CPERF_AUTH_THEN_CIPHER) ==
+				 (options->cipher_op ==
+				  RTE_CRYPTO_CIPHER_OP_ENCRYPT))) {
+			RTE_LOG(ERR, USER1, "Reverse direction operations are "
+					"only allowed with encrypt then "
+					"authenticate chains.\n");
+			return -EINVAL;
+		}
+	}
+
+	if (options->session_zipf != 0 && options->nb_sessions == 1) {
+		RTE_LOG(ERR, USER1, "Zipf distribution requires "
+				"multiple sessions.\n");
+		return -EINVAL;
+	}
+
 	if (options->op_type == CPERF_CIPHER_THEN_AUTH ||
 			options->op_type == CPERF_AUTH_THEN_CIPHER) {
 		if (!is_valid_chained_op(options)) {
@@ -1688,6 +1799,15 @@ cperf_options_dump(struct cperf_options *opts)
 	}
 	printf("# sessionless: %s\n", opts->sessionless ? "yes" : "no");
 	printf("# shared session: %s\n", opts->shared_session ? "yes" : "no");
+	if (opts->nb_sessions > 1 || opts->decrypt_pct != 0) {
+		printf("# sessions per queue pair: %u\n", opts->nb_sessions);
+		if (opts->session_zipf != 0)
+			printf("# session distribution: zipf %.2f\n",
+					opts->session_zipf);
+		else
+			printf("# session distribution: round-robin\n");
+		printf("# reverse direction ops: %u%%\n", opts->decrypt_pct);
+	}
 	printf("# out of place: %s\n", opts->out_of_place ? "yes" : "no");
 	if (opts->test == CPERF_TEST_TYPE_PMDCC)
 		printf("# inter-burst delay: %u ms\n", opts->pmdcc_delay);
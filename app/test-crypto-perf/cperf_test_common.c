@@ -2,6 +2,7 @@
  * Copyright(c) 2017 Intel Corporation
  */
 
+#include <rte_cycles.h>
 #include <rte_malloc.h>
 #include <rte_mbuf_pool_ops.h>
 
@@ -266,15 +267,37 @@ cperf_alloc_common_memory(const struct cperf_options *options,
 	return 0;
 }
 
+/* Copy len bytes of data in the segments of the mbuf */
+static void
+cperf_mbuf_data_set(struct rte_mbuf *mbuf,
+		const struct cperf_options *options,
+		const uint8_t *data, uint32_t len)
+{
+	uint32_t segment_sz = options->segment_sz - options->headroom_sz - options->tailroom_sz;
+	uint8_t *mbuf_data;
+	uint32_t remaining_bytes = len;
+
+	while (remaining_bytes) {
+		mbuf_data = rte_pktmbuf_mtod(mbuf, uint8_t *);
+
+		if (remaining_bytes <= segment_sz) {
+			memcpy(mbuf_data, data, remaining_bytes);
+			return;
+		}
+
+		memcpy(mbuf_data, data, segment_sz);
+		remaining_bytes -= segment_sz;
+		data += segment_sz;
+		mbuf = mbuf->next;
+	}
+}
+
 void
 cperf_mbuf_set(struct rte_mbuf *mbuf,
 		const struct cperf_options *options,
 		const struct cperf_test_vector *test_vector)
 {
-	uint32_t segment_sz = options->segment_sz - options->headroom_sz - options->tailroom_sz;
-	uint8_t *mbuf_data;
 	uint8_t *test_data;
-	uint32_t remaining_bytes = options->max_buffer_size;
 
 	if (options->op_type == CPERF_AEAD) {
 		test_data = (options->aead_op == RTE_CRYPTO_AEAD_OP_ENCRYPT) ?
@@ -287,19 +310,7 @@ cperf_mbuf_set(struct rte_mbuf *mbuf,
 				test_vector->ciphertext.data;
 	}
 
-	while (remaining_bytes) {
-		mbuf_data = rte_pktmbuf_mtod(mbuf, uint8_t *);
-
-		if (remaining_bytes <= segment_sz) {
-			memcpy(mbuf_data, test_data, remaining_bytes);
-			return;
-		}
-
-		memcpy(mbuf_data, test_data, segment_sz);
-		remaining_bytes -= segment_sz;
-		test_data += segment_sz;
-		mbuf = mbuf->next;
-	}
+	cperf_mbuf_data_set(mbuf, options, test_data, options->max_buffer_size);
 }
 
 bool
@@ -314,3 +325,292 @@ cperf_is_asym_test(const struct cperf_options *options)
 
 	return false;
 }
+
+/* Number of sessions used per queue pair, including the reverse direction */
+uint32_t
+cperf_sessions_count(const struct cperf_options *options)
+{
+	return options->nb_sessions * (options->decrypt_pct != 0 ? 2 : 1);
+}
+
+/* Options of the session processing the output of the configured one */
+static void
+cperf_options_reverse(struct cperf_options *options)
+{
+	options->cipher_op = options->cipher_op == RTE_CRYPTO_CIPHER_OP_ENCRYPT ?
+			RTE_CRYPTO_CIPHER_OP_DECRYPT : RTE_CRYPTO_CIPHER_OP_ENCRYPT;
+	options->auth_op = options->auth_op == RTE_CRYPTO_AUTH_OP_GENERATE ?
+			RTE_CRYPTO_AUTH_OP_VERIFY : RTE_CRYPTO_AUTH_OP_GENERATE;
+	options->aead_op = options->aead_op == RTE_CRYPTO_AEAD_OP_ENCRYPT ?
+			RTE_CRYPTO_AEAD_OP_DECRYPT : RTE_CRYPTO_AEAD_OP_ENCRYPT;
+
+	if (options->op_type == CPERF_CIPHER_THEN_AUTH)
+		options->op_type = CPERF_AUTH_THEN_CIPHER;
+	else if (options->op_type == CPERF_AUTH_THEN_CIPHER)
+		options->op_type = CPERF_CIPHER_THEN_AUTH;
+}
+
+/* Whether the ops of the options decrypt and verify the digest */
+static bool
+cperf_options_decrypt(const struct cperf_options *options)
+{
+	if (options->op_type == CPERF_AEAD)
+		return options->aead_op == RTE_CRYPTO_AEAD_OP_DECRYPT;
+	if (options->op_type == CPERF_AUTH_ONLY)
+		return options->auth_op == RTE_CRYPTO_AUTH_OP_VERIFY;
+
+	return options->cipher_op == RTE_CRYPTO_CIPHER_OP_DECRYPT;
+}
+
+/* Digest of the op, NULL when the ops of the options have none */
+static uint8_t *
+cperf_op_digest(const struct rte_crypto_op *op,
+		const struct cperf_options *options)
+{
+	if (options->op_type == CPERF_AEAD)
+		return op->sym->aead.digest.data;
+	if (options->op_type == CPERF_CIPHER_ONLY ||
+			options->auth_algo == RTE_CRYPTO_AUTH_NULL)
+		return NULL;
+
+	return op->sym->auth.digest.data;
+}
+
+/*
+ * Create the sessions of a queue pair when several sessions are used,
+ * the first one being the session already created for the test.
+ * The sessions are set to NULL when a single session is used.
+ */
+int
+cperf_sessions_create(struct rte_mempool *sess_mp, uint8_t dev_id,
+		const struct cperf_options *options,
+		const struct cperf_test_vector *test_vector,
+		const struct cperf_op_fns *op_fns,
+		uint16_t iv_offset, void *sess,
+		struct cperf_sessions **sessions)
+{
+	uint32_t i, nb_sessions = cperf_sessions_count(options);
+	struct cperf_options reverse_options;
+	struct cperf_sessions *s;
+
+	*sessions = NULL;
+	if (nb_sessions == 1)
+		return 0;
+
+	s = rte_zmalloc(NULL, sizeof(*s), 0);
+	if (s == NULL)
+		return -ENOMEM;
+
+	s->fwd_dec = cperf_options_decrypt(options);
+	s->populate_ops = op_fns->populate_ops;
+	s->test_vector = test_vector;
+	s->iv_offset = iv_offset;
+
+	s->sess = rte_zmalloc(NULL, sizeof(void *) * nb_sessions, 0);
+	if (s->sess == NULL)
+		goto err;
+
+	if (options->decrypt_pct != 0) {
+		s->ref = rte_malloc(NULL, options->max_buffer_size +
+				options->digest_sz, 0);
+		if (s->ref == NULL)
+			goto err;
+		s->ref_iova = rte_malloc_virt2iova(s->ref);
+	}
+
+	reverse_options = *options;
+	cperf_options_reverse(&reverse_options);
+
+	s->sess[0] = sess;
+	for (i = 1; i < nb_sessions; i++) {
+		s->sess[i] = op_fns->sess_create(sess_mp, dev_id,
+				i < options->nb_sessions ?
+					options : &reverse_options,
+				test_vector, iv_offset);
+		if (s->sess[i] == NULL) {
+			RTE_LOG(ERR, USER1, "Failed to create session %u of "
+					"%u, consider checking the maximum "
+					"number of sessions of the device\n",
+					i + 1, nb_sessions);
+			goto err;
+		}
+	}
+
+	*sessions = s;
+
+	return 0;
+err:
+	cperf_sessions_free(dev_id, options, s);
+
+	return -ENOMEM;
+}
+
+/* Free the sessions created by cperf_sessions_create() */
+void
+cperf_sessions_free(uint8_t dev_id, const struct cperf_options *options,
+		struct cperf_sessions *sessions)
+{
+	uint32_t i, nb_sessions = cperf_sessions_count(options);
+
+	if (sessions == NULL)
+		return;
+
+	if (sessions->sess != NULL)
+		for (i = 1; i < nb_sessions; i++)
+			if (sessions->sess[i] != NULL)
+				rte_cryptodev_sym_session_free(dev_id,
+						sessions->sess[i]);
+
+	rte_free(sessions->ref);
+	rte_free(sessions->sess);
+	rte_free(sessions);
+}
+
+/*
+ * Encrypt the test vector data of the current buffer size with an
+ * encrypting session, out of the measurements. The decrypting ops then
+ * process this data and its digest, so that their verification succeeds.
+ */
+int
+cperf_sessions_prepare(struct cperf_sessions *sessions, uint8_t dev_id,
+		uint16_t qp_id, struct rte_mempool *pool,
+		uint32_t src_buf_offset, const struct cperf_options *options)
+{
+	struct cperf_options *enc_options = &sessions->enc_options;
+	struct cperf_options *dec_options = &sessions->dec_options;
+	struct rte_crypto_op *op;
+	uint32_t imix_idx = 0;
+	const uint8_t *data;
+	uint8_t *digest;
+	uint64_t tsc_start;
+	int ret = -1;
+
+	*enc_options = *options;
+	*dec_options = *options;
+	cperf_options_reverse(sessions->fwd_dec ? enc_options : dec_options);
+	/* Copy the IV and AAD of the test vector in all the ops */
+	enc_options->test = CPERF_TEST_TYPE_VERIFY;
+	dec_options->test = CPERF_TEST_TYPE_VERIFY;
+	sessions->src_buf_offset = src_buf_offset;
+
+	if (options->decrypt_pct == 0)
+		return 0;
+
+	if (rte_mempool_get(pool, (void **)&op) != 0) {
+		RTE_LOG(ERR, USER1,
+			"Failed to allocate crypto operation "
+			"from the crypto operation pool.\n");
+		return -1;
+	}
+
+	sessions->populate_ops(&op, src_buf_offset, 0, 1,
+			sessions->sess[sessions->fwd_dec ?
+				options->nb_sessions : 0],
+			enc_options, sessions->test_vector,
+			sessions->iv_offset, &imix_idx, NULL);
+	cperf_mbuf_set(op->sym->m_src, enc_options, sessions->test_vector);
+
+	if (rte_cryptodev_enqueue_burst(dev_id, qp_id, &op, 1) != 1) {
+		RTE_LOG(ERR, USER1, "PMD cannot process the packet.\n");
+		goto out;
+	}
+
+	tsc_start = rte_rdtsc_precise();
+	while (rte_cryptodev_dequeue_burst(dev_id, qp_id, &op, 1) == 0) {
+		/* Check if 1 second timeout has been reached */
+		if ((rte_rdtsc_precise() - tsc_start) > rte_get_tsc_hz()) {
+			RTE_LOG(ERR, USER1, "Dequeue operation timed out.\n");
+			return -1;
+		}
+	}
+
+	if (op->status != RTE_CRYPTO_OP_STATUS_SUCCESS) {
+		RTE_LOG(ERR, USER1, "Failed to encrypt the data of the "
+				"decrypting operations.\n");
+		goto out;
+	}
+
+	data = rte_pktmbuf_read(op->sym->m_src, 0, options->test_buffer_size,
+			sessions->ref);
+	if (data == NULL)
+		goto out;
+	if (data != sessions->ref)
+		memcpy(sessions->ref, data, options->test_buffer_size);
+
+	digest = cperf_op_digest(op, enc_options);
+	if (digest != NULL)
+		memcpy(sessions->ref + options->max_buffer_size, digest,
+				options->digest_sz);
+
+	ret = 0;
+out:
+	rte_mempool_put(pool, op);
+
+	return ret;
+}
+
+/* Set the encrypted data and its digest in a decrypting op */
+static inline void
+cperf_sessions_ref_set(const struct cperf_sessions *sessions,
+		struct rte_crypto_op *op)
+{
+	const struct cperf_options *options = &sessions->dec_options;
+	uint8_t *digest = sessions->ref + options->max_buffer_size;
+	rte_iova_t digest_iova = sessions->ref_iova + options->max_buffer_size;
+
+	cperf_mbuf_data_set(op->sym->m_src, options, sessions->ref,
+			options->test_buffer_size);
+
+	if (options->op_type == CPERF_AEAD) {
+		op->sym->aead.digest.data = digest;
+		op->sym->aead.digest.phys_addr = digest_iova;
+	} else if (cperf_op_digest(op, options) != NULL) {
+		op->sym->auth.digest.data = digest;
+		op->sym->auth.digest.phys_addr = digest_iova;
+	}
+}
+
+/*
+ * Attach to the ops the next sessions of the session sequence.
+ * The ops of another direction than the configured one are set up again
+ * for their session, and the decrypting ops get the encrypted data.
+ */
+void
+cperf_sessions_attach(struct rte_crypto_op **ops, uint16_t nb_ops,
+		const struct cperf_sessions *sessions,
+		const struct cperf_options *options, uint32_t *seq_idx)
+{
+	uint32_t idx = *seq_idx;
+	uint32_t imix_idx = 0;
+	uint32_t sess_idx;
+	bool reverse, dec;
+	uint16_t i;
+
+	for (i = 0; i < nb_ops; i++) {
+		struct rte_crypto_op *op = ops[i];
+
+		sess_idx = options->session_seq[idx];
+		reverse = sess_idx >= options->nb_sessions;
+		dec = options->decrypt_pct != 0 &&
+				reverse != sessions->fwd_dec;
+
+		if (reverse || dec)
+			sessions->populate_ops(&op, sessions->src_buf_offset, 0,
+					1, sessions->sess[sess_idx],
+					dec ? &sessions->dec_options :
+						&sessions->enc_options,
+					sessions->test_vector,
+					sessions->iv_offset, &imix_idx, NULL);
+		else
+			rte_crypto_op_attach_sym_session(op,
+					sessions->sess[sess_idx]);
+
+		if (dec)
+			cperf_sessions_ref_set(sessions, op);
+
+		if (++idx == options->session_seq_sz)
+			idx = 0;
+	}
+
+	*seq_idx = idx;
+}
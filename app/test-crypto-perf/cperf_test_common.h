@@ -5,13 +5,35 @@
 #ifndef _CPERF_TEST_COMMON_H_
 #define _CPERF_TEST_COMMON_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <rte_mempool.h>
 
+#include "cperf_ops.h"
 #include "cperf_options.h"
 #include "cperf_test_vectors.h"
 
+/* Sessions of a queue pair when several are used */
+struct cperf_sessions {
+	/* The sessions of the configured direction, then the reverse ones */
+	void **sess;
+	/* Whether the configured direction decrypts */
+	bool fwd_dec;
+	/* Options of the encrypting and decrypting ops */
+	struct cperf_options enc_options;
+	struct cperf_options dec_options;
+
+	cperf_populate_ops_t populate_ops;
+	const struct cperf_test_vector *test_vector;
+	uint32_t src_buf_offset;
+	uint16_t iv_offset;
+
+	/* Encrypted test vector data, followed by its digest */
+	uint8_t *ref;
+	rte_iova_t ref_iova;
+};
+
 int
 cperf_alloc_common_memory(const struct cperf_options *options,
 			const struct cperf_test_vector *test_vector,
@@ -28,4 +50,29 @@ cperf_mbuf_set(struct rte_mbuf *mbuf,
 
 bool
 cperf_is_asym_test(const struct cperf_options *options);
+
+uint32_t
+cperf_sessions_count(const struct cperf_options *options);
+
+int
+cperf_sessions_create(struct rte_mempool *sess_mp, uint8_t dev_id,
+		const struct cperf_options *options,
+		const struct cperf_test_vector *test_vector,
+		const struct cperf_op_fns *op_fns,
+		uint16_t iv_offset, void *sess,
+		struct cperf_sessions **sessions);
+
+void
+cperf_sessions_free(uint8_t dev_id, const struct cperf_options *options,
+		struct cperf_sessions *sessions);
+
+int
+cperf_sessions_prepare(struct cperf_sessions *sessions, uint8_t dev_id,
+		uint16_t qp_id, struct rte_mempool *pool,
+		uint32_t src_buf_offset, const struct cperf_options *options);
+
+void
+cperf_sessions_attach(struct rte_crypto_op **ops, uint16_t nb_ops,
+		const struct cperf_sessions *sessions,
+		const struct cperf_options *options, uint32_t *seq_idx);
 #endif /* _CPERF_TEST_COMMON_H_ */
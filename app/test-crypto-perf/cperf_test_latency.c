@@ -1,6 +1,8 @@
 /* SPDX-License-Identifier: BSD-3-Clause
  * Copyright(c) 2016-2017 Intel Corporation
  */
+#include <stdlib.h>
+
 #include <rte_malloc.h>
 #include <rte_cycles.h>
 #include <rte_crypto.h>
@@ -25,6 +27,8 @@ struct cperf_latency_ctx {
 
 	void *sess;
 	uint8_t sess_owner;
+	/* All the sessions when several are used, the first being sess */
+	struct cperf_sessions *sessions;
 
 	cperf_populate_ops_t populate_ops;
 
@@ -34,6 +38,8 @@ struct cperf_latency_ctx {
 	const struct cperf_options *options;
 	const struct cperf_test_vector *test_vector;
 	struct cperf_op_result *res;
+	/* Sorted latencies of the ops, for the percentiles */
+	uint64_t *lat;
 };
 
 struct priv_op_data {
@@ -46,6 +52,7 @@ cperf_latency_test_free(struct cperf_latency_ctx *ctx)
 	if (ctx == NULL)
 		return;
 
+	cperf_sessions_free(ctx->dev_id, ctx->options, ctx->sessions);
 	if (ctx->sess != NULL && ctx->sess_owner) {
 		if (cperf_is_asym_test(ctx->options))
 			rte_cryptodev_asym_session_free(ctx->dev_id, ctx->sess);
@@ -64,6 +71,7 @@ cperf_latency_test_free(struct cperf_latency_ctx *ctx)
 
 	rte_mempool_free(ctx->pool);
 	rte_free(ctx->res);
+	rte_free(ctx->lat);
 	rte_free(ctx);
 }
 
@@ -84,6 +92,9 @@ cperf_latency_test_constructor(struct rte_mempool *sess_mp,
 
 	ctx->dev_id = dev_id;
 	ctx->qp_id = qp_id;
+	ctx->sessions = NULL;
+	ctx->res = NULL;
+	ctx->lat = NULL;
 
 	ctx->populate_ops = op_fns->populate_ops;
 	ctx->options = options;
@@ -107,6 +118,10 @@ cperf_latency_test_constructor(struct rte_mempool *sess_mp,
 		ctx->sess_owner = true;
 	}
 
+	if (cperf_sessions_create(sess_mp, dev_id, options, test_vector,
+			op_fns, iv_offset, ctx->sess, &ctx->sessions) < 0)
+		goto err;
+
 	if (cperf_alloc_common_memory(options, test_vector, dev_id, qp_id,
 			extra_op_priv_size,
 			&ctx->src_buf_offset, &ctx->dst_buf_offset,
@@ -119,6 +134,11 @@ cperf_latency_test_constructor(struct rte_mempool *sess_mp,
 	if (ctx->res == NULL)
 		goto err;
 
+	ctx->lat = rte_malloc(NULL, sizeof(uint64_t) *
+			ctx->options->total_ops, 0);
+	if (ctx->lat == NULL)
+		goto err;
+
 	return ctx;
 err:
 	cperf_latency_test_free(ctx);
@@ -140,6 +160,24 @@ store_timestamp(struct rte_crypto_op *op, uint64_t timestamp)
 	priv_data->result->tsc_end = timestamp;
 }
 
+static int
+cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Latency of the given per-mille percentile of the sorted latencies */
+static inline uint64_t
+cperf_percentile(const uint64_t *lat, uint64_t nb, uint32_t per_mille)
+{
+	uint64_t idx = (nb * per_mille + 999) / 1000;
+
+	return lat[idx == 0 ? 0 : idx - 1];
+}
+
 static int
 cperf_check_single_op(struct cperf_latency_ctx *ctx, uint16_t iv_offset)
 {
@@ -197,6 +235,7 @@ cperf_latency_test_runner(void *arg)
 	uint16_t test_burst_size;
 	uint8_t burst_size_idx = 0;
 	uint32_t imix_idx = 0;
+	uint32_t sess_seq_idx = 0;
 	int ret = 0;
 
 	static RTE_ATOMIC(uint16_t) display_once;
@@ -244,6 +283,12 @@ cperf_latency_test_runner(void *arg)
 	if (cperf_check_single_op(ctx, iv_offset) < 1)
 		return -1;
 
+	if (ctx->sessions != NULL &&
+			cperf_sessions_prepare(ctx->sessions, ctx->dev_id,
+				ctx->qp_id, ctx->pool, ctx->src_buf_offset,
+				ctx->options) < 0)
+		return -1;
+
 	while (test_burst_size <= ctx->options->max_burst_size) {
 		uint64_t ops_enqd = 0, ops_deqd = 0;
 		uint64_t b_idx = 0;
@@ -286,6 +331,11 @@ cperf_latency_test_runner(void *arg)
 						ctx->options,
 						ctx->test_vector);
 
+			if (ctx->sessions != NULL)
+				cperf_sessions_attach(ops, burst_size,
+						ctx->sessions, ctx->options,
+						&sess_seq_idx);
+
 			tsc_start = rte_rdtsc_precise();
 
 #ifdef CPERF_LINEARIZATION_ENABLE
@@ -395,8 +445,11 @@ cperf_latency_test_runner(void *arg)
 			tsc_max = RTE_MAX(tsc_val, tsc_max);
 			tsc_min = RTE_MIN(tsc_val, tsc_min);
 			tsc_tot += tsc_val;
+			ctx->lat[i] = tsc_val;
 		}
 
+		qsort(ctx->lat, tsc_idx, sizeof(uint64_t), cmp_u64);
+
 		double time_tot, time_avg, time_max, time_min;
 
 		const uint64_t tunit = 1000000; /* us */
@@ -452,6 +505,24 @@ cperf_latency_test_runner(void *arg)
 					tsc_avg, tsc_max, tsc_min);
 			printf("\n# time [us]\t%12.0f\t%10.3f\t%10.3f\t%10.3f",
 					time_tot, time_avg, time_max, time_min);
+			printf("\n#");
+			printf("\n#          \t         p50\t       p90\t"
+					"       p99\t     p99.9");
+			printf("\n#    cycles\t%12"PRIu64"\t%10"PRIu64"\t"
+					"%10"PRIu64"\t%10"PRIu64,
+					cperf_percentile(ctx->lat, tsc_idx, 500),
+					cperf_percentile(ctx->lat, tsc_idx, 900),
+					cperf_percentile(ctx->lat, tsc_idx, 990),
+					cperf_percentile(ctx->lat, tsc_idx, 999));
+			printf("\n# time [us]\t%12.3f\t%10.3f\t%10.3f\t%10.3f",
+					tunit * (double)cperf_percentile(ctx->lat,
+						tsc_idx, 500) / tsc_hz,
+					tunit * (double)cperf_percentile(ctx->lat,
+						tsc_idx, 900) / tsc_hz,
+					tunit * (double)cperf_percentile(ctx->lat,
+						tsc_idx, 990) / tsc_hz,
+					tunit * (double)cperf_percentile(ctx->lat,
+						tsc_idx, 999) / tsc_hz);
 			printf("\n\n");
 
 		}
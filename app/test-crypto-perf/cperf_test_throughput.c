@@ -22,6 +22,8 @@ struct cperf_throughput_ctx {
 
 	void *sess;
 	uint8_t sess_owner;
+	/* All the sessions when several are used, the first being sess */
+	struct cperf_sessions *sessions;
 
 	cperf_populate_ops_t populate_ops;
 
@@ -37,6 +39,7 @@ cperf_throughput_test_free(struct cperf_throughput_ctx *ctx)
 {
 	if (!ctx)
 		return;
+	cperf_sessions_free(ctx->dev_id, ctx->options, ctx->sessions);
 	if (ctx->sess != NULL && ctx->sess_owner) {
 		if (cperf_is_asym_test(ctx->options))
 			rte_cryptodev_asym_session_free(ctx->dev_id,
@@ -75,6 +78,7 @@ cperf_throughput_test_constructor(struct rte_mempool *sess_mp,
 
 	ctx->dev_id = dev_id;
 	ctx->qp_id = qp_id;
+	ctx->sessions = NULL;
 
 	ctx->populate_ops = op_fns->populate_ops;
 	ctx->options = options;
@@ -96,6 +100,10 @@ cperf_throughput_test_constructor(struct rte_mempool *sess_mp,
 		ctx->sess_owner = true;
 	}
 
+	if (cperf_sessions_create(sess_mp, dev_id, options, test_vector,
+			op_fns, iv_offset, ctx->sess, &ctx->sessions) < 0)
+		goto err;
+
 	if (cperf_alloc_common_memory(options, test_vector, dev_id, qp_id, 0,
 			&ctx->src_buf_offset, &ctx->dst_buf_offset,
 			&ctx->pool) < 0)
@@ -179,6 +187,27 @@ cperf_check_single_op(struct cperf_throughput_ctx *ctx, uint16_t iv_offset)
 	}
 }
 
+/*
+ * Number of ops which failed. Only the ops of the reverse direction
+ * workloads are all set up with valid data, so that they must succeed.
+ */
+static inline uint64_t
+cperf_ops_failed(const struct cperf_throughput_ctx *ctx,
+		struct rte_crypto_op **ops, uint16_t nb_ops)
+{
+	uint64_t nb_failed = 0;
+	uint16_t i;
+
+	if (ctx->options->decrypt_pct == 0)
+		return 0;
+
+	for (i = 0; i < nb_ops; i++)
+		if (ops[i]->status != RTE_CRYPTO_OP_STATUS_SUCCESS)
+			nb_failed++;
+
+	return nb_failed;
+}
+
 int
 cperf_throughput_test_runner(void *test_ctx)
 {
@@ -186,6 +215,7 @@ cperf_throughput_test_runner(void *test_ctx)
 	uint16_t test_burst_size;
 	uint8_t burst_size_idx = 0;
 	uint32_t imix_idx = 0;
+	uint32_t sess_seq_idx = 0;
 
 	static RTE_ATOMIC(uint16_t) display_once;
 
@@ -231,9 +261,16 @@ cperf_throughput_test_runner(void *test_ctx)
 	if (cperf_check_single_op(ctx, iv_offset) < 1)
 		return -1;
 
+	if (ctx->sessions != NULL &&
+			cperf_sessions_prepare(ctx->sessions, ctx->dev_id,
+				ctx->qp_id, ctx->pool, ctx->src_buf_offset,
+				ctx->options) < 0)
+		return -1;
+
 	while (test_burst_size <= ctx->options->max_burst_size) {
 		uint64_t ops_enqd = 0, ops_enqd_total = 0, ops_enqd_failed = 0;
 		uint64_t ops_deqd = 0, ops_deqd_total = 0, ops_deqd_failed = 0;
+		uint64_t ops_failed = 0;
 
 		uint64_t tsc_start, tsc_end, tsc_duration;
 
@@ -270,6 +307,11 @@ cperf_throughput_test_runner(void *test_ctx)
 						ctx->options, ctx->test_vector,
 						iv_offset, &imix_idx, &tsc_start);
 
+			if (ctx->sessions != NULL)
+				cperf_sessions_attach(ops, ops_needed,
+						ctx->sessions, ctx->options,
+						&sess_seq_idx);
+
 			/**
 			 * When ops_needed is smaller than ops_enqd, the
 			 * unused ops need to be moved to the front for
@@ -314,6 +356,9 @@ cperf_throughput_test_runner(void *test_ctx)
 					ops_processed, test_burst_size);
 
 			if (likely(ops_deqd))  {
+				ops_failed += cperf_ops_failed(ctx, ops_processed,
+						ops_deqd);
+
 				/* Free crypto ops so they can be reused. */
 				rte_mempool_put_bulk(ctx->pool,
 						(void **)ops_processed, ops_deqd);
@@ -342,6 +387,8 @@ cperf_throughput_test_runner(void *test_ctx)
 			if (ops_deqd == 0)
 				ops_deqd_failed++;
 			else {
+				ops_failed += cperf_ops_failed(ctx, ops_processed,
+						ops_deqd);
 				rte_mempool_put_bulk(ctx->pool,
 						(void **)ops_processed, ops_deqd);
 				ops_deqd_total += ops_deqd;
@@ -351,6 +398,12 @@ cperf_throughput_test_runner(void *test_ctx)
 		tsc_end = rte_rdtsc_precise();
 		tsc_duration = (tsc_end - tsc_start);
 
+		if (ops_failed != 0) {
+			RTE_LOG(ERR, USER1, "%"PRIu64" crypto operations "
+					"failed.\n", ops_failed);
+			return -1;
+		}
+
 		/* Calculate average operations processed per second */
 		double ops_per_second = ((double)ctx->options->total_ops /
 				tsc_duration) * rte_get_tsc_hz();
@@ -2,6 +2,7 @@
  * Copyright(c) 2016-2017 Intel Corporation
  */
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -291,16 +292,19 @@ cperf_initialize_cryptodev(struct cperf_options *opts, uint8_t *enabled_cdevs)
 				opts->nb_qps * nb_workers;
 #endif
 		} else
-			sessions_needed = enabled_cdev_count * opts->nb_qps;
+			sessions_needed = enabled_cdev_count * opts->nb_qps *
+				cperf_sessions_count(opts);
 
 		/*
 		 * A single session is required per queue pair
-		 * in each device
+		 * in each device, unless several sessions are used
 		 */
-		if (dev_max_nb_sess != 0 && dev_max_nb_sess < opts->nb_qps) {
+		if (dev_max_nb_sess != 0 && dev_max_nb_sess <
+				opts->nb_qps * cperf_sessions_count(opts)) {
 			RTE_LOG(ERR, USER1,
 				"Device does not support at least "
-				"%u sessions\n", opts->nb_qps);
+				"%u sessions\n",
+				opts->nb_qps * cperf_sessions_count(opts));
 			return -ENOTSUP;
 		}
 
@@ -662,6 +666,70 @@ cperf_check_test_vector(struct cperf_options *opts,
 	return 0;
 }
 
+/* Minimum number of entries of the session sequence */
+#define CPERF_SESSION_SEQ_SZ	65536
+
+/*
+ * Calculate the sequence of the sessions used by the ops, shared by all
+ * the queue pairs: round-robin or Zipf distributed among the sessions,
+ * with a share of the ops on the reverse direction sessions.
+ */
+static int
+cperf_session_seq_create(struct cperf_options *opts)
+{
+	uint32_t nb_sessions = opts->nb_sessions;
+	uint32_t seq_sz, idx, sess_idx, lo, hi;
+	double *cdf = NULL;
+	double r;
+
+	/* A multiple of the number of sessions, to keep round-robin even */
+	seq_sz = RTE_ALIGN_CEIL(CPERF_SESSION_SEQ_SZ, nb_sessions);
+	opts->session_seq = rte_malloc(NULL, sizeof(uint32_t) * seq_sz, 0);
+	if (opts->session_seq == NULL)
+		return -ENOMEM;
+	opts->session_seq_sz = seq_sz;
+
+	if (opts->session_zipf != 0) {
+		cdf = rte_malloc(NULL, sizeof(double) * nb_sessions, 0);
+		if (cdf == NULL)
+			return -ENOMEM;
+
+		/* Session k is picked with a probability of 1 / (k + 1)^s */
+		cdf[0] = 1.0;
+		for (sess_idx = 1; sess_idx < nb_sessions; sess_idx++)
+			cdf[sess_idx] = cdf[sess_idx - 1] +
+				1.0 / pow(sess_idx + 1, opts->session_zipf);
+	}
+
+	for (idx = 0; idx < seq_sz; idx++) {
+		if (cdf == NULL) {
+			sess_idx = idx % nb_sessions;
+		} else {
+			r = (double)rte_rand() / (double)UINT64_MAX *
+				cdf[nb_sessions - 1];
+			lo = 0;
+			hi = nb_sessions - 1;
+			while (lo < hi) {
+				sess_idx = (lo + hi) / 2;
+				if (r < cdf[sess_idx])
+					hi = sess_idx;
+				else
+					lo = sess_idx + 1;
+			}
+			sess_idx = lo;
+		}
+
+		if (rte_rand_max(100) < opts->decrypt_pct)
+			sess_idx += nb_sessions;
+
+		opts->session_seq[idx] = sess_idx;
+	}
+
+	rte_free(cdf);
+
+	return 0;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -808,6 +876,13 @@ main(int argc, char **argv)
 		i++;
 	}
 
+	if (cperf_sessions_count(&opts) > 1) {
+		if (cperf_session_seq_create(&opts) < 0) {
+			RTE_LOG(ERR, USER1, "Failed to create session sequence\n");
+			goto err;
+		}
+	}
+
 	if (opts.imix_distribution_count != 0) {
 		uint8_t buffer_size_count = opts.buffer_size_count;
 		uint16_t distribution_total[buffer_size_count];
@@ -930,6 +1005,7 @@ main(int argc, char **argv)
 					"Crypto device close error %d\n", ret);
 	}
 
+	rte_free(opts.session_seq);
 	free_test_vector(t_vec, &opts);
 
 	printf("\n");
@@ -956,6 +1032,7 @@ main(int argc, char **argv)
 
 	}
 	rte_free(opts.imix_buffer_sizes);
+	rte_free(opts.session_seq);
 	free_test_vector(t_vec, &opts);
 
 	if (rte_errno == ENOTSUP || cap_unsupported) {
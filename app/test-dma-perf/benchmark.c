@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <rte_bitops.h>
 #include <rte_time.h>
 #include <rte_mbuf.h>
 #include <rte_dmadev.h>
@@ -21,15 +22,24 @@
 #define TEST_WAIT_U_SECOND 10000
 #define POLL_MAX 1000
 
-#define CSV_LINE_DMA_FMT "Scenario %u,%u,%s,%u,%u,%u,%u,%.2lf,%" PRIu64 ",%.3lf,%.3lf\n"
+#define CSV_LINE_DMA_FMT "Scenario %u,%u,%s,%u,%u,%u,%u,%.2lf,%" PRIu64 ",%.3lf,%.3lf,%s\n"
 #define CSV_LINE_CPU_FMT "Scenario %u,%u,NA,NA,NA,%u,%u,%.2lf,%" PRIu64 ",%.3lf,%.3lf\n"
 
-#define CSV_TOTAL_LINE_FMT "Scenario %u Summary, , , , , ,%u,%.2lf,%.1lf,%.3lf,%.3lf\n"
+#define CSV_TOTAL_LINE_FMT "Scenario %u Summary, , , , , ,%u,%.2lf,%.1lf,%.3lf,%.3lf,%s\n"
+
+/* The latencies are counted in a log-linear histogram of cycles,
+ * with 2^LAT_HIST_SUB_BITS buckets for each power of two.
+ */
+#define LAT_HIST_SUB_BITS 4
+#define LAT_HIST_NB ((64 - LAT_HIST_SUB_BITS + 1) << LAT_HIST_SUB_BITS)
+/* The submit times are indexed by the 16-bit ring index of the ops. */
+#define LAT_RING_SZ (UINT16_MAX + 1)
 
 struct worker_info {
 	bool ready_flag;
 	bool start_flag;
 	bool stop_flag;
+	bool lat_flag;
 	uint32_t total_cpl;
 	uint32_t test_cpl;
 };
@@ -41,6 +51,19 @@ struct sge_info {
 	uint8_t nb_dsts;
 };
 
+struct lat_info {
+	uint64_t *submit_tsc;
+	uint64_t *hist;
+	uint16_t last_idx;
+	uint16_t nb_unsubmitted;
+};
+
+struct lat_result {
+	double p50;
+	double p99;
+	double p999;
+};
+
 struct lcore_params {
 	uint8_t scenario_id;
 	unsigned int lcore_id;
@@ -54,6 +77,11 @@ struct lcore_params {
 	struct rte_mbuf **srcs;
 	struct rte_mbuf **dsts;
 	struct sge_info sge;
+	uint32_t *buf_lens;
+	uint64_t async_cnt;
+	struct lat_info lat;
+	/* Next DMA channel handled by the same lcore. */
+	struct lcore_params *next;
 	volatile struct worker_info worker_info;
 };
 
@@ -93,6 +121,80 @@ calc_result(uint32_t buf_size, uint32_t nr_buf, uint16_t nb_workers, uint16_t te
 	*bandwidth = (ops * buf_size * 8) / (1000 * 1000 * 1000);
 }
 
+static inline uint32_t
+lat_hist_bucket(uint64_t cycles)
+{
+	uint32_t msb;
+
+	if (cycles < RTE_BIT64(LAT_HIST_SUB_BITS))
+		return cycles;
+
+	msb = rte_fls_u64(cycles) - 1;
+	return ((msb - LAT_HIST_SUB_BITS + 1) << LAT_HIST_SUB_BITS) |
+		((cycles >> (msb - LAT_HIST_SUB_BITS)) & (RTE_BIT64(LAT_HIST_SUB_BITS) - 1));
+}
+
+/* Middle of the range of cycles counted by a histogram bucket. */
+static double
+lat_hist_value(uint32_t bucket)
+{
+	uint32_t shift;
+	uint64_t low;
+
+	if (bucket < RTE_BIT32(LAT_HIST_SUB_BITS))
+		return bucket;
+
+	shift = (bucket >> LAT_HIST_SUB_BITS) - 1;
+	low = (RTE_BIT64(LAT_HIST_SUB_BITS) | (bucket & (RTE_BIT32(LAT_HIST_SUB_BITS) - 1)))
+		<< shift;
+	return low + (RTE_BIT64(shift) - 1) / 2.0;
+}
+
+static void
+calc_lat_result(const uint64_t *hist, struct lat_result *res)
+{
+	const double hz = rte_get_timer_hz();
+	uint64_t total = 0, cnt = 0;
+	uint32_t i;
+
+	memset(res, 0, sizeof(*res));
+
+	for (i = 0; i < LAT_HIST_NB; i++)
+		total += hist[i];
+	if (total == 0)
+		return;
+
+	for (i = 0; i < LAT_HIST_NB; i++) {
+		if (hist[i] == 0)
+			continue;
+		cnt += hist[i];
+		if (res->p50 == 0 && cnt * 1000 >= total * 500)
+			res->p50 = lat_hist_value(i) * 1E9 / hz;
+		if (res->p99 == 0 && cnt * 1000 >= total * 990)
+			res->p99 = lat_hist_value(i) * 1E9 / hz;
+		if (cnt * 1000 >= total * 999) {
+			res->p999 = lat_hist_value(i) * 1E9 / hz;
+			break;
+		}
+	}
+}
+
+static void
+output_lat_result(const uint64_t *hist, char *str, size_t len)
+{
+	struct lat_result res;
+
+	if (hist == NULL) {
+		strlcpy(str, "NA,NA,NA", len);
+		return;
+	}
+
+	calc_lat_result(hist, &res);
+	printf("Latency p50: %.1lf ns, p99: %.1lf ns, p99.9: %.1lf ns\n",
+		res.p50, res.p99, res.p999);
+	snprintf(str, len, "%.1lf,%.1lf,%.1lf", res.p50, res.p99, res.p999);
+}
+
 static void
 output_result(struct test_configure *cfg, struct lcore_params *para,
 			uint16_t kick_batch, uint64_t ave_cycle, uint32_t buf_size,
@@ -101,7 +203,9 @@ output_result(struct test_configure *cfg, struct lcore_params *para,
 	uint16_t ring_size = cfg->ring_size.cur;
 	uint8_t scenario_id = cfg->scenario_id;
 	uint32_t lcore_id = para->lcore_id;
+	uint16_t worker_id = para->worker_id;
 	char *dma_name = para->dma_name;
+	char lat_str[64];
 
 	if (cfg->is_dma) {
 		printf("lcore %u, DMA %s, DMA Ring Size: %u, Kick Batch Size: %u", lcore_id,
@@ -114,16 +218,18 @@ output_result(struct test_configure *cfg, struct lcore_params *para,
 		printf("lcore %u\n", lcore_id);
 	}
 
-	printf("Average Cycles/op: %" PRIu64 ", Buffer Size: %u B, Buffer Number: %u, Memory: %.2lf MB, Frequency: %.3lf Ghz.\n",
-			ave_cycle, buf_size, nr_buf, memory, rte_get_timer_hz()/1000000000.0);
+	printf("Average Cycles/op: %" PRIu64 ", Buffer Size: %u B%s, Buffer Number: %u, Memory: %.2lf MB, Frequency: %.3lf Ghz.\n",
+			ave_cycle, buf_size, para->buf_lens != NULL ? " (average)" : "",
+			nr_buf, memory, rte_get_timer_hz()/1000000000.0);
 	printf("Average Bandwidth: %.3lf Gbps, MOps: %.3lf\n", bandwidth, mops);
 
-	if (cfg->is_dma)
-		snprintf(output_str[lcore_id], MAX_OUTPUT_STR_LEN, CSV_LINE_DMA_FMT,
+	if (cfg->is_dma) {
+		output_lat_result(para->lat.hist, lat_str, sizeof(lat_str));
+		snprintf(output_str[worker_id], MAX_OUTPUT_STR_LEN, CSV_LINE_DMA_FMT,
 			scenario_id, lcore_id, dma_name, ring_size, kick_batch, buf_size,
-			nr_buf, memory, ave_cycle, bandwidth, mops);
-	else
-		snprintf(output_str[lcore_id], MAX_OUTPUT_STR_LEN, CSV_LINE_CPU_FMT,
+			nr_buf, memory, ave_cycle, bandwidth, mops, lat_str);
+	} else
+		snprintf(output_str[worker_id], MAX_OUTPUT_STR_LEN, CSV_LINE_CPU_FMT,
 			scenario_id, lcore_id, buf_size,
 			nr_buf, memory, ave_cycle, bandwidth, mops);
 }
@@ -229,6 +335,7 @@ config_dmadevs(struct test_configure *cfg)
 	uint16_t nb_dmadevs = 0;
 	uint8_t nb_sges = 0;
 	char *dma_name;
+	uint32_t j;
 
 	if (cfg->is_sg)
 		nb_sges = RTE_MAX(cfg->nb_src_sges, cfg->nb_dst_sges);
@@ -242,6 +349,14 @@ config_dmadevs(struct test_configure *cfg)
 			goto end;
 		}
 
+		for (j = 0; j < i; j++) {
+			if (cfg->dma_config[j].lcore_dma_map.dma_id == dev_id) {
+				fprintf(stderr, "Error: DMA %s is used by several workers.\n",
+					dma_name);
+				return -1;
+			}
+		}
+
 		ldm->dma_id = dev_id;
 		configure_dmadev_queue(dev_id, cfg, nb_sges, nb_dmadevs);
 		++nb_dmadevs;
@@ -266,135 +381,140 @@ error_exit(int dev_id)
 	rte_exit(EXIT_FAILURE, "DMA error\n");
 }
 
+/* Timestamp the ops enqueued since the previous submit. */
+static __rte_always_inline void
+lat_submitted(struct lat_info *lat)
+{
+	uint64_t tsc = rte_rdtsc();
+	uint16_t i;
+
+	for (i = 0; i < lat->nb_unsubmitted; i++)
+		lat->submit_tsc[(uint16_t)(lat->last_idx - i)] = tsc;
+	lat->nb_unsubmitted = 0;
+}
+
+static __rte_always_inline void
+lat_completed(struct lat_info *lat, uint16_t last_idx, uint16_t nr_cpl)
+{
+	uint64_t tsc = rte_rdtsc();
+	uint16_t i;
+
+	for (i = 0; i < nr_cpl; i++)
+		lat->hist[lat_hist_bucket(tsc - lat->submit_tsc[(uint16_t)(last_idx - i)])]++;
+}
+
 static inline void
-do_dma_submit_and_poll(uint16_t dev_id, uint64_t *async_cnt,
-			volatile struct worker_info *worker_info)
+do_dma_submit_and_poll(struct lcore_params *para)
 {
+	volatile struct worker_info *worker_info = &para->worker_info;
+	const uint16_t dev_id = para->dev_id;
+	uint16_t nr_cpl, last_idx;
 	int ret;
-	uint16_t nr_cpl;
 
 	ret = rte_dma_submit(dev_id, 0);
 	if (ret < 0)
 		error_exit(dev_id);
 
-	nr_cpl = rte_dma_completed(dev_id, 0, MAX_DMA_CPL_NB, NULL, NULL);
-	*async_cnt -= nr_cpl;
+	if (para->lat.hist != NULL)
+		lat_submitted(&para->lat);
+
+	nr_cpl = rte_dma_completed(dev_id, 0, MAX_DMA_CPL_NB, &last_idx, NULL);
+	para->async_cnt -= nr_cpl;
 	worker_info->total_cpl += nr_cpl;
+
+	if (para->lat.hist != NULL && nr_cpl != 0 && worker_info->lat_flag)
+		lat_completed(&para->lat, last_idx, nr_cpl);
 }
 
-static inline int
-do_dma_plain_mem_copy(void *p)
+static __rte_always_inline void
+do_dma_enqueue(struct lcore_params *para, uint32_t i, bool is_sg)
 {
-	struct lcore_params *para = (struct lcore_params *)p;
-	volatile struct worker_info *worker_info = &(para->worker_info);
-	const uint16_t dev_id = para->dev_id;
-	const uint32_t nr_buf = para->nr_buf;
-	const uint16_t kick_batch = para->kick_batch;
-	const uint32_t buf_size = para->buf_size;
-	struct rte_mbuf **srcs = para->srcs;
-	struct rte_mbuf **dsts = para->dsts;
-	uint16_t nr_cpl;
-	uint64_t async_cnt = 0;
-	uint32_t i;
-	uint32_t poll_cnt = 0;
 	int ret;
 
-	worker_info->stop_flag = false;
-	worker_info->ready_flag = true;
-
-	while (!worker_info->start_flag)
-		;
-
-	while (1) {
-		for (i = 0; i < nr_buf; i++) {
 dma_copy:
-			ret = rte_dma_copy(dev_id, 0, rte_mbuf_data_iova(srcs[i]),
-				rte_mbuf_data_iova(dsts[i]), buf_size, 0);
-			if (unlikely(ret < 0)) {
-				if (ret == -ENOSPC) {
-					do_dma_submit_and_poll(dev_id, &async_cnt, worker_info);
-					goto dma_copy;
-				} else
-					error_exit(dev_id);
-			}
-			async_cnt++;
-
-			if ((async_cnt % kick_batch) == 0)
-				do_dma_submit_and_poll(dev_id, &async_cnt, worker_info);
-		}
-
-		if (worker_info->stop_flag)
-			break;
+	if (is_sg)
+		ret = rte_dma_copy_sg(para->dev_id, 0,
+			&para->sge.srcs[i * para->sge.nb_srcs],
+			&para->sge.dsts[i * para->sge.nb_dsts],
+			para->sge.nb_srcs, para->sge.nb_dsts, 0);
+	else
+		ret = rte_dma_copy(para->dev_id, 0, rte_mbuf_data_iova(para->srcs[i]),
+			rte_mbuf_data_iova(para->dsts[i]),
+			para->buf_lens != NULL ? para->buf_lens[i] : para->buf_size, 0);
+	if (unlikely(ret < 0)) {
+		if (ret == -ENOSPC) {
+			do_dma_submit_and_poll(para);
+			goto dma_copy;
+		} else
+			error_exit(para->dev_id);
 	}
+	para->async_cnt++;
 
-	rte_dma_submit(dev_id, 0);
-	while ((async_cnt > 0) && (poll_cnt++ < POLL_MAX)) {
-		nr_cpl = rte_dma_completed(dev_id, 0, MAX_DMA_CPL_NB, NULL, NULL);
-		async_cnt -= nr_cpl;
+	if (para->lat.hist != NULL) {
+		para->lat.last_idx = ret;
+		para->lat.nb_unsubmitted++;
 	}
 
-	return 0;
+	if ((para->async_cnt % para->kick_batch) == 0)
+		do_dma_submit_and_poll(para);
 }
 
-static inline int
-do_dma_sg_mem_copy(void *p)
+/* Copy with all the DMA channels of an lcore, one op on each channel in turn. */
+static __rte_always_inline int
+do_dma_mem_copy(struct lcore_params *first, bool is_sg)
 {
-	struct lcore_params *para = (struct lcore_params *)p;
-	volatile struct worker_info *worker_info = &(para->worker_info);
-	struct rte_dma_sge *src_sges = para->sge.srcs;
-	struct rte_dma_sge *dst_sges = para->sge.dsts;
-	const uint8_t nb_src_sges = para->sge.nb_srcs;
-	const uint8_t nb_dst_sges = para->sge.nb_dsts;
-	const uint16_t kick_batch = para->kick_batch;
-	const uint16_t dev_id = para->dev_id;
-	uint32_t nr_buf = para->nr_buf;
-	uint64_t async_cnt = 0;
-	uint32_t poll_cnt = 0;
+	volatile struct worker_info *worker_info = &(first->worker_info);
+	struct lcore_params *para;
+	uint32_t nr_buf = first->nr_buf;
+	uint32_t poll_cnt;
 	uint16_t nr_cpl;
-	uint32_t i, j;
-	int ret;
+	uint32_t i;
 
-	nr_buf /= RTE_MAX(nb_src_sges, nb_dst_sges);
-	worker_info->stop_flag = false;
-	worker_info->ready_flag = true;
+	if (is_sg)
+		nr_buf /= RTE_MAX(first->sge.nb_srcs, first->sge.nb_dsts);
+
+	for (para = first; para != NULL; para = para->next) {
+		para->worker_info.stop_flag = false;
+		para->worker_info.ready_flag = true;
+	}
 
 	while (!worker_info->start_flag)
 		;
 
 	while (1) {
-		j = 0;
 		for (i = 0; i < nr_buf; i++) {
-dma_copy:
-			ret = rte_dma_copy_sg(dev_id, 0,
-				&src_sges[i * nb_src_sges], &dst_sges[j * nb_dst_sges],
-				nb_src_sges, nb_dst_sges, 0);
-			if (unlikely(ret < 0)) {
-				if (ret == -ENOSPC) {
-					do_dma_submit_and_poll(dev_id, &async_cnt, worker_info);
-					goto dma_copy;
-				} else
-					error_exit(dev_id);
-			}
-			async_cnt++;
-			j++;
-
-			if ((async_cnt % kick_batch) == 0)
-				do_dma_submit_and_poll(dev_id, &async_cnt, worker_info);
+			for (para = first; para != NULL; para = para->next)
+				do_dma_enqueue(para, i, is_sg);
 		}
 
 		if (worker_info->stop_flag)
 			break;
 	}
 
-	rte_dma_submit(dev_id, 0);
-	while ((async_cnt > 0) && (poll_cnt++ < POLL_MAX)) {
-		nr_cpl = rte_dma_completed(dev_id, 0, MAX_DMA_CPL_NB, NULL, NULL);
-		async_cnt -= nr_cpl;
+	for (para = first; para != NULL; para = para->next) {
+		rte_dma_submit(para->dev_id, 0);
+		poll_cnt = 0;
+		while ((para->async_cnt > 0) && (poll_cnt++ < POLL_MAX)) {
+			nr_cpl = rte_dma_completed(para->dev_id, 0, MAX_DMA_CPL_NB, NULL, NULL);
+			para->async_cnt -= nr_cpl;
+		}
 	}
 
 	return 0;
 }
 
+static int
+do_dma_plain_mem_copy(void *p)
+{
+	return do_dma_mem_copy(p, false);
+}
+
+static int
+do_dma_sg_mem_copy(void *p)
+{
+	return do_dma_mem_copy(p, true);
+}
+
 static inline int
 do_cpu_mem_copy(void *p)
 {
@@ -404,6 +524,7 @@ do_cpu_mem_copy(void *p)
 	const uint32_t buf_size = para->buf_size;
 	struct rte_mbuf **srcs = para->srcs;
 	struct rte_mbuf **dsts = para->dsts;
+	uint32_t *buf_lens = para->buf_lens;
 	uint32_t i;
 
 	worker_info->stop_flag = false;
@@ -418,7 +539,8 @@ do_cpu_mem_copy(void *p)
 			void *dst = rte_pktmbuf_mtod(srcs[i], void *);
 
 			/* copy buffer form src to dst */
-			rte_memcpy(dst, src, (size_t)buf_size);
+			rte_memcpy(dst, src,
+				buf_lens != NULL ? buf_lens[i] : (size_t)buf_size);
 			worker_info->total_cpl++;
 		}
 		if (worker_info->stop_flag)
@@ -435,10 +557,43 @@ dummy_free_ext_buf(void *addr, void *opaque)
 	RTE_SET_USED(opaque);
 }
 
+/* Pick a copy length at random, following the configured size distribution. */
+static uint32_t
+size_dist_pick(const struct test_configure *cfg)
+{
+	uint64_t total = 0, r;
+	uint8_t i;
+
+	for (i = 0; i < cfg->nb_size_dist; i++)
+		total += cfg->size_dist[i].weight;
+
+	r = rte_rand_max(total);
+	for (i = 0; i < cfg->nb_size_dist - 1; i++) {
+		if (r < cfg->size_dist[i].weight)
+			break;
+		r -= cfg->size_dist[i].weight;
+	}
+
+	return cfg->size_dist[i].size;
+}
+
+static uint32_t
+avg_buf_len(const uint32_t *buf_lens, uint32_t nr_buf)
+{
+	uint64_t total = 0;
+	uint32_t i;
+
+	for (i = 0; i < nr_buf; i++)
+		total += buf_lens[i];
+
+	return (total + nr_buf / 2) / nr_buf;
+}
+
 static int
 setup_memory_env(struct test_configure *cfg,
 			 struct rte_mbuf ***srcs, struct rte_mbuf ***dsts,
-			 struct rte_dma_sge **src_sges, struct rte_dma_sge **dst_sges)
+			 struct rte_dma_sge **src_sges, struct rte_dma_sge **dst_sges,
+			 uint32_t **buf_lens)
 {
 	unsigned int cur_buf_size = cfg->buf_size.cur;
 	unsigned int buf_size = cur_buf_size + RTE_PKTMBUF_HEADROOM;
@@ -507,6 +662,17 @@ setup_memory_env(struct test_configure *cfg,
 		memset(rte_pktmbuf_mtod((*dsts)[i], void *), 0, cur_buf_size);
 	}
 
+	if (cfg->nb_size_dist != 0) {
+		*buf_lens = rte_malloc(NULL, nr_buf * sizeof(uint32_t), 0);
+		if (*buf_lens == NULL) {
+			printf("Error: buf_lens malloc failed.\n");
+			return -1;
+		}
+
+		for (i = 0; i < nr_buf; i++)
+			(*buf_lens)[i] = size_dist_pick(cfg);
+	}
+
 	if (cfg->is_sg) {
 		uint8_t nb_src_sges = cfg->nb_src_sges;
 		uint8_t nb_dst_sges = cfg->nb_dst_sges;
@@ -574,6 +740,20 @@ align_buffer_count(struct test_configure *cfg, uint32_t *nr_sgsrc, uint32_t *nr_
 	return nr_buf;
 }
 
+/* Return the first worker running on the same lcore, if any. */
+static struct lcore_params *
+get_lcore_head(uint16_t worker_id, unsigned int lcore_id)
+{
+	uint16_t i;
+
+	for (i = 0; i < worker_id; i++) {
+		if (lcores[i]->lcore_id == lcore_id)
+			return lcores[i];
+	}
+
+	return NULL;
+}
+
 static lcore_function_t *
 get_work_function(struct test_configure *cfg)
 {
@@ -678,12 +858,17 @@ mem_copy_benchmark(struct test_configure *cfg)
 	unsigned int lcore_id = 0;
 	struct rte_mbuf **srcs = NULL, **dsts = NULL, **m = NULL;
 	struct rte_dma_sge *src_sges = NULL, *dst_sges = NULL;
+	uint32_t *buf_lens = NULL;
 	struct vchan_dev_config *vchan_dev = NULL;
 	struct lcore_dma_map_t *lcore_dma_map = NULL;
 	unsigned int buf_size = cfg->buf_size.cur;
 	uint16_t kick_batch = cfg->kick_batch.cur;
 	uint16_t nb_workers = cfg->num_worker;
 	uint16_t test_secs = cfg->test_secs;
+	struct lcore_params *head;
+	uint64_t *lat_hist = NULL;
+	char lat_str[64];
+	uint32_t op_size;
 	float memory = 0;
 	uint32_t avg_cycles = 0;
 	uint32_t avg_cycles_total;
@@ -696,7 +881,7 @@ mem_copy_benchmark(struct test_configure *cfg)
 	nr_buf = align_buffer_count(cfg, &nr_sgsrc, &nr_sgdst);
 	cfg->nr_buf = nr_buf;
 
-	if (setup_memory_env(cfg, &srcs, &dsts, &src_sges, &dst_sges) < 0)
+	if (setup_memory_env(cfg, &srcs, &dsts, &src_sges, &dst_sges, &buf_lens) < 0)
 		goto out;
 
 	if (cfg->is_dma)
@@ -717,10 +902,11 @@ mem_copy_benchmark(struct test_configure *cfg)
 
 		lcore_id = lcore_dma_map->lcore;
 		offset = nr_buf / nb_workers * i;
-		lcores[i] = rte_malloc(NULL, sizeof(struct lcore_params), 0);
+		lcores[i] = rte_zmalloc(NULL, sizeof(struct lcore_params), 0);
 		if (lcores[i] == NULL) {
 			printf("lcore parameters malloc failure for lcore %d\n", lcore_id);
-			break;
+			ret = -1;
+			goto out;
 		}
 		if (cfg->is_dma) {
 			lcores[i]->dma_name = lcore_dma_map->dma_names;
@@ -728,6 +914,19 @@ mem_copy_benchmark(struct test_configure *cfg)
 			lcores[i]->kick_batch = kick_batch;
 		}
 
+		if (cfg->is_dma && cfg->latency) {
+			lcores[i]->lat.submit_tsc = rte_malloc(NULL,
+					LAT_RING_SZ * sizeof(uint64_t), 0);
+			lcores[i]->lat.hist = rte_zmalloc(NULL,
+					LAT_HIST_NB * sizeof(uint64_t), 0);
+			if (lcores[i]->lat.submit_tsc == NULL || lcores[i]->lat.hist == NULL) {
+				printf("latency histogram malloc failure for lcore %d\n",
+					lcore_id);
+				ret = -1;
+				goto out;
+			}
+		}
+
 		lcores[i]->worker_id = i;
 		lcores[i]->nr_buf = (uint32_t)(nr_buf / nb_workers);
 		lcores[i]->buf_size = buf_size;
@@ -736,6 +935,8 @@ mem_copy_benchmark(struct test_configure *cfg)
 		lcores[i]->dsts = dsts + offset;
 		lcores[i]->scenario_id = cfg->scenario_id;
 		lcores[i]->lcore_id = lcore_id;
+		if (buf_lens != NULL)
+			lcores[i]->buf_lens = buf_lens + offset;
 
 		if (cfg->is_sg) {
 			lcores[i]->sge.nb_srcs = cfg->nb_src_sges;
@@ -751,7 +952,25 @@ mem_copy_benchmark(struct test_configure *cfg)
 				goto out;
 		}
 
-		rte_eal_remote_launch(get_work_function(cfg), (void *)(lcores[i]), lcore_id);
+		/* The DMA channels of an lcore are all run by its first worker. */
+		head = get_lcore_head(i, lcore_id);
+		if (head != NULL) {
+			if (!cfg->is_dma) {
+				printf("lcore %u is used by several workers\n", lcore_id);
+				ret = -1;
+				goto out;
+			}
+			while (head->next != NULL)
+				head = head->next;
+			head->next = lcores[i];
+		}
+	}
+
+	for (i = 0; i < nb_workers; i++) {
+		lcore_id = lcores[i]->lcore_id;
+		if (get_lcore_head(i, lcore_id) == NULL)
+			rte_eal_remote_launch(get_work_function(cfg), (void *)(lcores[i]),
+					      lcore_id);
 	}
 
 	while (1) {
@@ -770,13 +989,17 @@ mem_copy_benchmark(struct test_configure *cfg)
 		lcores[i]->worker_info.start_flag = true;
 
 	usleep(TEST_WAIT_U_SECOND);
-	for (i = 0; i < nb_workers; i++)
+	for (i = 0; i < nb_workers; i++) {
 		lcores[i]->worker_info.test_cpl = lcores[i]->worker_info.total_cpl;
+		lcores[i]->worker_info.lat_flag = true;
+	}
 
 	usleep(test_secs * 1000 * 1000);
-	for (i = 0; i < nb_workers; i++)
+	for (i = 0; i < nb_workers; i++) {
+		lcores[i]->worker_info.lat_flag = false;
 		lcores[i]->worker_info.test_cpl = lcores[i]->worker_info.total_cpl -
 						lcores[i]->worker_info.test_cpl;
+	}
 
 	for (i = 0; i < nb_workers; i++)
 		lcores[i]->worker_info.stop_flag = true;
@@ -795,6 +1018,7 @@ mem_copy_benchmark(struct test_configure *cfg)
 			for (i = 0; i < nr_buf_pt; i++) {
 				if (memcmp(rte_pktmbuf_mtod(src_buf[i], void *),
 							    rte_pktmbuf_mtod(dst_buf[i], void *),
+							    buf_lens != NULL ? buf_lens[offset + i] :
 							    cfg->buf_size.cur) != 0) {
 					printf("Copy validation fails for buffer number %d\n", i);
 					ret = -1;
@@ -845,27 +1069,45 @@ mem_copy_benchmark(struct test_configure *cfg)
 		}
 	}
 
+	if (cfg->is_dma && cfg->latency) {
+		lat_hist = rte_zmalloc(NULL, LAT_HIST_NB * sizeof(uint64_t), 0);
+		if (lat_hist == NULL) {
+			printf("Error: latency histogram malloc failed.\n");
+			ret = -1;
+			goto out;
+		}
+	}
+
 	mops_total = 0;
 	bandwidth_total = 0;
 	avg_cycles_total = 0;
 	for (i = 0; i < nb_workers; i++) {
 		vchan_dev = &cfg->dma_config[i].vchan_dev;
-		calc_result(buf_size, nr_buf, nb_workers, test_secs,
+		op_size = buf_size;
+		if (buf_lens != NULL)
+			op_size = avg_buf_len(lcores[i]->buf_lens, nr_buf / nb_workers);
+		calc_result(op_size, nr_buf, nb_workers, test_secs,
 			lcores[i]->worker_info.test_cpl,
 			&memory, &avg_cycles, &bandwidth, &mops);
 		printf("Direction: %s\n", vchan_dev->tdir == 0 ? "mem2mem" :
 			vchan_dev->tdir == 1 ? "mem2dev" : "dev2mem");
-		output_result(cfg, lcores[i], kick_batch, avg_cycles, buf_size,
+		output_result(cfg, lcores[i], kick_batch, avg_cycles, op_size,
 			nr_buf / nb_workers, memory, bandwidth, mops);
 		mops_total += mops;
 		bandwidth_total += bandwidth;
 		avg_cycles_total += avg_cycles;
+		if (lat_hist != NULL) {
+			for (j = 0; j < LAT_HIST_NB; j++)
+				lat_hist[j] += lcores[i]->lat.hist[j];
+		}
 	}
 	printf("\nAverage Cycles/op per worker: %.1lf, Total Bandwidth: %.3lf Gbps, Total MOps: %.3lf\n",
 		(avg_cycles_total * (float) 1.0) / nb_workers, bandwidth_total, mops_total);
+	output_lat_result(lat_hist, lat_str, sizeof(lat_str));
 	snprintf(output_str[MAX_WORKER_NB], MAX_OUTPUT_STR_LEN, CSV_TOTAL_LINE_FMT,
 			cfg->scenario_id, nr_buf, memory * nb_workers,
-			(avg_cycles_total * (float) 1.0) / nb_workers, bandwidth_total, mops_total);
+			(avg_cycles_total * (float) 1.0) / nb_workers, bandwidth_total, mops_total,
+			lat_str);
 
 out:
 
@@ -916,8 +1158,15 @@ mem_copy_benchmark(struct test_configure *cfg)
 	rte_free(dst_sges);
 	dst_sges = NULL;
 
+	rte_free(buf_lens);
+	rte_free(lat_hist);
+
 	/* free the worker parameters */
 	for (i = 0; i < nb_workers; i++) {
+		if (lcores[i] != NULL) {
+			rte_free(lcores[i]->lat.submit_tsc);
+			rte_free(lcores[i]->lat.hist);
+		}
 		rte_free(lcores[i]);
 		lcores[i] = NULL;
 	}
@@ -21,7 +21,7 @@
 
 #include "main.h"
 
-#define CSV_HDR_FMT "Case %u : %s,lcore,DMA,DMA ring size,kick batch size,buffer size(B),number of buffers,memory(MB),average cycle,bandwidth(Gbps),MOps\n"
+#define CSV_HDR_FMT "Case %u : %s,lcore,DMA,DMA ring size,kick batch size,buffer size(B),number of buffers,memory(MB),average cycle,bandwidth(Gbps),MOps,p50 latency(ns),p99 latency(ns),p99.9 latency(ns)\n"
 
 #define MAX_EAL_PARAM_NB 100
 #define MAX_EAL_PARAM_LEN 1024
@@ -119,6 +119,25 @@ run_test_case(struct test_configure *case_cfg)
 	return ret;
 }
 
+/* Several DMA workers may share an lcore, count the lcores only once. */
+static uint16_t
+count_worker_lcores(struct test_configure *case_cfg)
+{
+	uint16_t i, j, nb = 0;
+
+	for (i = 0; i < case_cfg->num_worker; i++) {
+		for (j = 0; j < i; j++) {
+			if (case_cfg->dma_config[j].lcore_dma_map.lcore ==
+					case_cfg->dma_config[i].lcore_dma_map.lcore)
+				break;
+		}
+		if (j == i)
+			nb++;
+	}
+
+	return nb;
+}
+
 static void
 run_test(uint32_t case_id, struct test_configure *case_cfg)
 {
@@ -134,7 +153,7 @@ run_test(uint32_t case_id, struct test_configure *case_cfg)
 	for (i = 0; i < RTE_DIM(output_str); i++)
 		memset(output_str[i], 0, MAX_OUTPUT_STR_LEN);
 
-	if (nb_lcores <= case_cfg->num_worker) {
+	if (nb_lcores <= count_worker_lcores(case_cfg)) {
 		printf("Case %u: Not enough lcores.\n", case_id);
 		return;
 	}
@@ -254,6 +273,45 @@ parse_entry(const char *value, struct test_configure_entry *entry)
 	return args_nr;
 }
 
+static int
+parse_size_dist(const char *value, struct test_configure *test_case)
+{
+	char input[255] = {0};
+	char *args[MAX_SIZE_DIST_NB];
+	struct size_dist_entry *entry;
+	uint32_t max_size = 0;
+	char *endptr;
+	int nb, j;
+
+	if (value == NULL || test_case == NULL)
+		return -1;
+
+	strlcpy(input, value, sizeof(input));
+	nb = rte_strsplit(input, strlen(input), args, MAX_SIZE_DIST_NB, ',');
+	if (nb <= 0)
+		return -1;
+
+	for (j = 0; j < nb; j++) {
+		entry = &test_case->size_dist[j];
+		entry->size = (uint32_t)strtoul(args[j], &endptr, 0);
+		if (*endptr != ':' || entry->size == 0)
+			return -1;
+		entry->weight = (uint32_t)strtoul(endptr + 1, &endptr, 0);
+		if (*endptr != '\0' || entry->weight == 0)
+			return -1;
+		max_size = RTE_MAX(max_size, entry->size);
+	}
+	test_case->nb_size_dist = nb;
+
+	/* The buffers are sized for the largest copies. */
+	test_case->buf_size.cur = test_case->buf_size.first = max_size;
+	test_case->buf_size.last = 0;
+	test_case->buf_size.incr = 0;
+	test_case->buf_size.op = OP_NONE;
+
+	return 0;
+}
+
 static int populate_dma_dev_config(const char *key, const char *value, void *test)
 {
 	struct lcore_dma_config *dma_config = (struct lcore_dma_config *)test;
@@ -298,7 +356,7 @@ load_configs(const char *path)
 	const char *case_type;
 	const char *lcore_dma;
 	const char *mem_size_str, *buf_size_str, *ring_size_str, *kick_batch_str,
-		*src_sges_str, *dst_sges_str;
+		*src_sges_str, *dst_sges_str, *buf_size_dist_str, *latency_str;
 	const char *skip;
 	struct rte_kvargs *kvlist;
 	int args_nr, nb_vp;
@@ -365,13 +423,24 @@ load_configs(const char *path)
 			nb_vp++;
 
 		buf_size_str = rte_cfgfile_get_entry(cfgfile, section_name, "buf_size");
-		args_nr = parse_entry(buf_size_str, &test_case->buf_size);
-		if (args_nr < 0) {
-			printf("parse error in case %d.\n", i + 1);
-			test_case->is_valid = false;
-			continue;
-		} else if (args_nr == 4)
-			nb_vp++;
+		buf_size_dist_str = rte_cfgfile_get_entry(cfgfile, section_name,
+							"buf_size_dist");
+		if (buf_size_dist_str != NULL) {
+			if (buf_size_str != NULL ||
+			    parse_size_dist(buf_size_dist_str, test_case) < 0) {
+				printf("parse buf_size_dist error in case %d.\n", i + 1);
+				test_case->is_valid = false;
+				continue;
+			}
+		} else {
+			args_nr = parse_entry(buf_size_str, &test_case->buf_size);
+			if (args_nr < 0) {
+				printf("parse error in case %d.\n", i + 1);
+				test_case->is_valid = false;
+				continue;
+			} else if (args_nr == 4)
+				nb_vp++;
+		}
 
 		if (is_dma) {
 			ring_size_str = rte_cfgfile_get_entry(cfgfile, section_name,
@@ -417,6 +486,16 @@ load_configs(const char *path)
 				test_case->is_sg = false;
 			}
 
+			if (test_case->is_sg && test_case->nb_size_dist != 0) {
+				printf("buf_size_dist can not be used with scatter-gather in case %d.\n",
+					i + 1);
+				test_case->is_valid = false;
+				continue;
+			}
+
+			latency_str = rte_cfgfile_get_entry(cfgfile, section_name, "latency");
+			test_case->latency = latency_str != NULL && atoi(latency_str) == 1;
+
 			kick_batch_str = rte_cfgfile_get_entry(cfgfile, section_name, "kick_batch");
 			args_nr = parse_entry(kick_batch_str, &test_case->kick_batch);
 			if (args_nr < 0) {
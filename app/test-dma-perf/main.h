@@ -15,6 +15,8 @@
 
 #define MAX_DMA_NB 128
 
+#define MAX_SIZE_DIST_NB 16
+
 extern char output_str[MAX_WORKER_NB + 1][MAX_OUTPUT_STR_LEN];
 
 typedef enum {
@@ -31,6 +33,11 @@ struct test_configure_entry {
 	uint32_t cur;
 };
 
+struct size_dist_entry {
+	uint32_t size;
+	uint32_t weight;
+};
+
 struct lcore_dma_map_t {
 	char dma_names[RTE_DEV_NAME_MAX_LEN];
 	uint32_t lcore;
@@ -67,6 +74,9 @@ struct test_configure {
 	uint8_t nb_src_sges;
 	uint8_t nb_dst_sges;
 	uint8_t cache_flush;
+	bool latency;
+	uint8_t nb_size_dist;
+	struct size_dist_entry size_dist[MAX_SIZE_DIST_NB];
 	uint32_t nr_buf;
 	uint16_t test_secs;
 	const char *eal_args;
@@ -38,6 +38,7 @@ enum app_args {
 	ARG_NUM_OF_LCORES,
 	ARG_NUM_OF_MBUF_SEGS,
 	ARG_NUM_OF_MATCH_MODE,
+	ARG_DEV_ID,
 };
 
 struct job_ctx {
@@ -75,6 +76,7 @@ struct regex_conf {
 	long job_len;
 	uint32_t nb_segs;
 	uint32_t match_mode;
+	uint16_t dev_id;
 };
 
 static void
@@ -90,7 +92,8 @@ usage(const char *prog_name)
 		" --nb_lcores N: number of lcores to use\n"
 		" --nb_segs N: number of mbuf segments\n"
 		" --match_mode N: match mode: 0 - None (default),"
-		"   1 - Highest Priority, 2 - Stop On Any\n",
+		"   1 - Highest Priority, 2 - Stop On Any\n"
+		" --dev_id N: RegEx device to use (default 0)\n",
 		prog_name);
 }
 
@@ -98,7 +101,7 @@ static void
 args_parse(int argc, char **argv, char *rules_file, char *data_file,
 	   uint32_t *nb_jobs, bool *perf_mode, uint32_t *nb_iterations,
 	   uint32_t *nb_qps, uint32_t *nb_lcores, uint32_t *nb_segs,
-	   uint32_t *match_mode)
+	   uint32_t *match_mode, uint16_t *dev_id)
 {
 	char **argvopt;
 	int opt;
@@ -124,6 +127,8 @@ args_parse(int argc, char **argv, char *rules_file, char *data_file,
 		{ "nb_segs", 1, 0, ARG_NUM_OF_MBUF_SEGS},
 		/* Match mode. */
 		{ "match_mode", 1, 0, ARG_NUM_OF_MATCH_MODE},
+		/* RegEx device. */
+		{ "dev_id", 1, 0, ARG_DEV_ID},
 		/* End of options */
 		{ 0, 0, 0, 0 }
 	};
@@ -172,6 +177,9 @@ args_parse(int argc, char **argv, char *rules_file, char *data_file,
 				rte_exit(EXIT_FAILURE,
 					 "Invalid match mode value\n");
 			break;
+		case ARG_DEV_ID:
+			*dev_id = atoi(optarg);
+			break;
 		case ARG_HELP:
 			usage(argv[0]);
 			break;
@@ -242,10 +250,9 @@ clone_buf(char *data_buf, char **buf, long data_len)
 }
 
 static int
-init_port(uint16_t *nb_max_payload, char *rules_file, uint8_t *nb_max_matches,
-	  uint32_t nb_qps)
+init_port(uint16_t id, uint16_t *nb_max_payload, char *rules_file,
+	  uint8_t *nb_max_matches, uint32_t nb_qps)
 {
-	uint16_t id;
 	uint16_t qp_id;
 	uint16_t num_devs;
 	char *rules = NULL;
@@ -266,6 +273,10 @@ init_port(uint16_t *nb_max_payload, char *rules_file, uint8_t *nb_max_matches,
 		printf("Error, no devices detected.\n");
 		return -EINVAL;
 	}
+	if (id >= num_devs) {
+		printf("Error, device %u not detected.\n", id);
+		return -EINVAL;
+	}
 
 	rules_len = read_file(rules_file, &rules);
 	if (rules_len < 0) {
@@ -274,41 +285,39 @@ init_port(uint16_t *nb_max_payload, char *rules_file, uint8_t *nb_max_matches,
 		goto error;
 	}
 
-	for (id = 0; id < num_devs; id++) {
-		res = rte_regexdev_info_get(id, &info);
-		if (res != 0) {
-			printf("Error, can't get device info.\n");
-			goto error;
-		}
-		printf(":: initializing dev: %d\n", id);
-		*nb_max_matches = info.max_matches;
-		*nb_max_payload = info.max_payload_size;
-		if (info.regexdev_capa & RTE_REGEXDEV_SUPP_MATCH_AS_END_F)
-			dev_conf.dev_cfg_flags |=
-			RTE_REGEXDEV_CFG_MATCH_AS_END_F;
-		dev_conf.nb_max_matches = info.max_matches;
-		dev_conf.nb_rules_per_group = info.max_rules_per_group;
-		dev_conf.rule_db_len = rules_len;
-		dev_conf.rule_db = rules;
-		res = rte_regexdev_configure(id, &dev_conf);
+	res = rte_regexdev_info_get(id, &info);
+	if (res != 0) {
+		printf("Error, can't get device info.\n");
+		goto error;
+	}
+	printf(":: initializing dev: %d\n", id);
+	*nb_max_matches = info.max_matches;
+	*nb_max_payload = info.max_payload_size;
+	if (info.regexdev_capa & RTE_REGEXDEV_SUPP_MATCH_AS_END_F)
+		dev_conf.dev_cfg_flags |=
+		RTE_REGEXDEV_CFG_MATCH_AS_END_F;
+	dev_conf.nb_max_matches = info.max_matches;
+	dev_conf.nb_rules_per_group = info.max_rules_per_group;
+	dev_conf.rule_db_len = rules_len;
+	dev_conf.rule_db = rules;
+	res = rte_regexdev_configure(id, &dev_conf);
+	if (res < 0) {
+		printf("Error, can't configure device %d.\n", id);
+		goto error;
+	}
+	if (info.regexdev_capa & RTE_REGEXDEV_CAPA_QUEUE_PAIR_OOS_F)
+		qp_conf.qp_conf_flags |=
+		RTE_REGEX_QUEUE_PAIR_CFG_OOS_F;
+	for (qp_id = 0; qp_id < nb_qps; qp_id++) {
+		res = rte_regexdev_queue_pair_setup(id, qp_id,
+						    &qp_conf);
 		if (res < 0) {
-			printf("Error, can't configure device %d.\n", id);
+			printf("Error, can't setup queue pair %u for "
+			       "device %d.\n", qp_id, id);
 			goto error;
 		}
-		if (info.regexdev_capa & RTE_REGEXDEV_CAPA_QUEUE_PAIR_OOS_F)
-			qp_conf.qp_conf_flags |=
-			RTE_REGEX_QUEUE_PAIR_CFG_OOS_F;
-		for (qp_id = 0; qp_id < nb_qps; qp_id++) {
-			res = rte_regexdev_queue_pair_setup(id, qp_id,
-							    &qp_conf);
-			if (res < 0) {
-				printf("Error, can't setup queue pair %u for "
-				       "device %d.\n", qp_id, id);
-				goto error;
-			}
-		}
-		printf(":: initializing device: %d done\n", id);
 	}
+	printf(":: initializing device: %d done\n", id);
 	rte_free(rules);
 	return 0;
 error:
@@ -405,7 +414,7 @@ run_regex(void *args)
 	uint32_t i;
 	uint32_t job_id;
 	uint16_t qp_id;
-	uint16_t dev_id = 0;
+	uint16_t dev_id = rgxc->dev_id;
 	uint8_t nb_matches;
 	uint16_t rsp_flags = 0;
 	struct rte_regexdev_match *match;
@@ -742,6 +751,7 @@ main(int argc, char **argv)
 	long job_len;
 	uint32_t nb_lcores = 1, nb_segs = 1;
 	uint32_t match_mode = 0;
+	uint16_t dev_id = 0;
 	struct regex_conf *rgxc;
 	uint32_t i;
 	struct qps_per_lcore *qps_per_lcore;
@@ -755,7 +765,7 @@ main(int argc, char **argv)
 	if (argc > 1)
 		args_parse(argc, argv, rules_file, data_file, &nb_jobs,
 				&perf_mode, &nb_iterations, &nb_qps,
-				&nb_lcores, &nb_segs, &match_mode);
+				&nb_lcores, &nb_segs, &match_mode, &dev_id);
 
 	if (nb_qps == 0)
 		rte_exit(EXIT_FAILURE, "Number of QPs must be greater than 0\n");
@@ -765,7 +775,7 @@ main(int argc, char **argv)
 		rte_exit(EXIT_FAILURE, "Number of jobs must be greater than 0\n");
 	if (distribute_qps_to_lcores(nb_lcores, nb_qps, &qps_per_lcore) < 0)
 		rte_exit(EXIT_FAILURE, "Failed to distribute queues to lcores!\n");
-	ret = init_port(&nb_max_payload, rules_file,
+	ret = init_port(dev_id, &nb_max_payload, rules_file,
 			&nb_max_matches, nb_qps);
 	if (ret < 0)
 		rte_exit(EXIT_FAILURE, "init port failed\n");
@@ -797,6 +807,7 @@ main(int argc, char **argv)
 			.data_len = data_len,
 			.job_len = job_len,
 			.match_mode = match_mode,
+			.dev_id = dev_id,
 		};
 		rte_eal_remote_launch(run_regex, &rgxc[i],
 				      qps_per_lcore[i].lcore_id);
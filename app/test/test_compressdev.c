@@ -13,6 +13,7 @@
 #include <rte_mempool.h>
 #include <rte_mbuf.h>
 #include <rte_compressdev.h>
+#include <rte_compressdev_chunk.h>
 #include <rte_string_fns.h>
 
 #include "test_compressdev_test_buffer.h"
@@ -3086,6 +3087,427 @@ make_memzone(const char *name, size_t size)
 	return memzone;
 }
 
+/* Process a single operation on linear buffers, with a private xform or
+ * a stream depending on the operation type. The source mbuf holds the
+ * whole input buffer, and the operation processes length bytes of it
+ * from the given offset.
+ */
+static int
+test_run_linear_op(void *xform_or_stream, enum rte_comp_op_type op_type,
+		enum rte_comp_flush_flag flush_flag, const uint8_t *in,
+		uint32_t in_len, uint32_t offset, uint32_t length,
+		uint8_t *out, uint32_t *out_len)
+{
+	struct comp_testsuite_params *ts_params = &testsuite_params;
+	struct rte_comp_op *op = NULL, *op_processed = NULL;
+	struct rte_mbuf *src, *dst;
+	uint8_t *data;
+	int ret = -1;
+
+	src = rte_pktmbuf_alloc(ts_params->large_mbuf_pool);
+	dst = rte_pktmbuf_alloc(ts_params->large_mbuf_pool);
+	if (src == NULL || dst == NULL) {
+		RTE_LOG(ERR, USER1, "Buffers could not be allocated\n");
+		goto exit;
+	}
+
+	data = (uint8_t *)rte_pktmbuf_append(src, in_len);
+	if (data == NULL ||
+			rte_pktmbuf_append(dst, rte_pktmbuf_tailroom(dst)) ==
+			NULL) {
+		RTE_LOG(ERR, USER1, "Buffers could not be filled\n");
+		goto exit;
+	}
+	memcpy(data, in, in_len);
+
+	op = rte_comp_op_alloc(ts_params->op_pool);
+	if (op == NULL) {
+		RTE_LOG(ERR, USER1, "Operation could not be allocated\n");
+		goto exit;
+	}
+	op->m_src = src;
+	op->m_dst = dst;
+	op->src.offset = offset;
+	op->src.length = length;
+	op->dst.offset = 0;
+	op->flush_flag = flush_flag;
+	op->op_type = op_type;
+	if (op_type == RTE_COMP_OP_STATEFUL)
+		op->stream = xform_or_stream;
+	else
+		op->private_xform = xform_or_stream;
+
+	if (test_run_enqueue_dequeue(&op, &op_processed, 1) < 0)
+		goto exit;
+
+	if (op_processed->status != RTE_COMP_OP_STATUS_SUCCESS ||
+			op_processed->consumed != length ||
+			op_processed->produced > *out_len) {
+		RTE_LOG(ERR, USER1, "Operation failed, status %d\n",
+			op_processed->status);
+		goto exit;
+	}
+
+	*out_len = op_processed->produced;
+	memcpy(out, rte_pktmbuf_mtod(dst, uint8_t *), *out_len);
+	ret = 0;
+
+exit:
+	rte_comp_op_free(op);
+	rte_pktmbuf_free(src);
+	rte_pktmbuf_free(dst);
+	return ret;
+}
+
+static int
+test_dict_run_op(void *xform_or_stream, enum rte_comp_op_type op_type,
+		const uint8_t *in, uint32_t in_len, uint8_t *out,
+		uint32_t *out_len)
+{
+	return test_run_linear_op(xform_or_stream, op_type,
+			RTE_COMP_FLUSH_FINAL, in, in_len, 0, in_len,
+			out, out_len);
+}
+
+/* Compress and decompress records which are parts of a preset dictionary,
+ * and check that they compress better than without the dictionary.
+ */
+static int
+test_compressdev_deflate_dict(void)
+{
+	struct comp_testsuite_params *ts_params = &testsuite_params;
+	const struct rte_compressdev_capabilities *capab;
+	const uint8_t *dict = (const uint8_t *)compress_test_bufs[0];
+	uint32_t dict_len = strlen(compress_test_bufs[0]);
+	uint32_t rec_len = RTE_MIN(dict_len / 4, 512U);
+	uint8_t comp_buf[1024], decomp_buf[1024];
+	uint32_t comp_len, decomp_len, nodict_len, i;
+	void *comp_xform = NULL, *decomp_xform = NULL;
+	void *comp_stream = NULL, *decomp_stream = NULL;
+	int ret = TEST_FAILED;
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_DEFLATE);
+	TEST_ASSERT(capab != NULL, "Failed to retrieve device capabilities");
+
+	if (!(capab->comp_feature_flags & RTE_COMP_FF_PRESET_DICT))
+		return -ENOTSUP;
+
+	if (rte_compressdev_private_xform_create(0, ts_params->def_comp_xform,
+			&comp_xform) < 0 ||
+			rte_compressdev_private_xform_create(0,
+			ts_params->def_decomp_xform, &decomp_xform) < 0) {
+		RTE_LOG(ERR, USER1, "Private xforms could not be created\n");
+		goto exit;
+	}
+
+	/* Reference size, without dictionary */
+	nodict_len = sizeof(comp_buf);
+	if (test_dict_run_op(comp_xform, RTE_COMP_OP_STATELESS,
+			dict + rec_len, rec_len, comp_buf, &nodict_len) < 0)
+		goto exit;
+
+	if (rte_compressdev_private_xform_dict_set(0, comp_xform,
+			dict, dict_len) < 0 ||
+			rte_compressdev_private_xform_dict_set(0, decomp_xform,
+			dict, dict_len) < 0) {
+		RTE_LOG(ERR, USER1, "Dictionary could not be set\n");
+		goto exit;
+	}
+
+	for (i = 0; i < 3; i++) {
+		const uint8_t *rec = dict + i * rec_len;
+
+		comp_len = sizeof(comp_buf);
+		decomp_len = sizeof(decomp_buf);
+		if (test_dict_run_op(comp_xform, RTE_COMP_OP_STATELESS,
+				rec, rec_len, comp_buf, &comp_len) < 0 ||
+				test_dict_run_op(decomp_xform,
+				RTE_COMP_OP_STATELESS, comp_buf, comp_len,
+				decomp_buf, &decomp_len) < 0)
+			goto exit;
+
+		if (decomp_len != rec_len ||
+				memcmp(decomp_buf, rec, rec_len) != 0) {
+			RTE_LOG(ERR, USER1, "Record %u not decompressed "
+				"correctly with the dictionary\n", i);
+			goto exit;
+		}
+		if (i == 1 && comp_len >= nodict_len) {
+			RTE_LOG(ERR, USER1, "Dictionary did not improve the "
+				"ratio: %u bytes, %u without\n",
+				comp_len, nodict_len);
+			goto exit;
+		}
+	}
+
+	/* A stream restarts with its dictionary after each record */
+	if (!(capab->comp_feature_flags & RTE_COMP_FF_STATEFUL_COMPRESSION) ||
+			!(capab->comp_feature_flags &
+			RTE_COMP_FF_STATEFUL_DECOMPRESSION)) {
+		ret = TEST_SUCCESS;
+		goto exit;
+	}
+
+	if (rte_compressdev_stream_create(0, ts_params->def_comp_xform,
+			&comp_stream) < 0 ||
+			rte_compressdev_stream_create(0,
+			ts_params->def_decomp_xform, &decomp_stream) < 0 ||
+			rte_compressdev_stream_dict_set(0, comp_stream,
+			dict, dict_len) < 0 ||
+			rte_compressdev_stream_dict_set(0, decomp_stream,
+			dict, dict_len) < 0) {
+		RTE_LOG(ERR, USER1, "Streams could not be set up\n");
+		goto exit;
+	}
+
+	for (i = 0; i < 3; i++) {
+		const uint8_t *rec = dict + i * rec_len;
+
+		comp_len = sizeof(comp_buf);
+		decomp_len = sizeof(decomp_buf);
+		if (test_dict_run_op(comp_stream, RTE_COMP_OP_STATEFUL,
+				rec, rec_len, comp_buf, &comp_len) < 0 ||
+				test_dict_run_op(decomp_stream,
+				RTE_COMP_OP_STATEFUL, comp_buf, comp_len,
+				decomp_buf, &decomp_len) < 0)
+			goto exit;
+
+		if (decomp_len != rec_len ||
+				memcmp(decomp_buf, rec, rec_len) != 0) {
+			RTE_LOG(ERR, USER1, "Record %u not decompressed "
+				"correctly with the stream dictionary\n", i);
+			goto exit;
+		}
+	}
+
+	ret = TEST_SUCCESS;
+
+exit:
+	if (comp_stream != NULL)
+		rte_compressdev_stream_free(0, comp_stream);
+	if (decomp_stream != NULL)
+		rte_compressdev_stream_free(0, decomp_stream);
+	if (comp_xform != NULL)
+		rte_compressdev_private_xform_free(0, comp_xform);
+	if (decomp_xform != NULL)
+		rte_compressdev_private_xform_free(0, decomp_xform);
+	return ret;
+}
+
+#define CHUNK_TEST_DEPTH 4
+#define CHUNK_TEST_SZ (16 * 1024)
+#define CHUNK_TEST_DATA_SZ (200 * 1024)
+
+/* Compress a buffer in chunks, and inflate the resulting stream with zlib */
+static int
+test_chunk_run(const uint8_t *data, uint32_t data_len, uint32_t dict_sz,
+		uint8_t *out, size_t *out_len, uint8_t *decomp)
+{
+	struct comp_testsuite_params *ts_params = &testsuite_params;
+	struct rte_compressdev_chunk_conf conf = {
+		.dev_id = 0,
+		.nb_qps = 1,
+		.depth = CHUNK_TEST_DEPTH,
+		.chunk_sz = CHUNK_TEST_SZ,
+		.dict_sz = dict_sz,
+		.xform = ts_params->def_comp_xform,
+		.socket_id = rte_socket_id(),
+	};
+	struct rte_compressdev_chunk_ctx *ctx;
+	size_t needed = 0;
+	z_stream stream;
+	int ret = -1;
+
+	ctx = rte_compressdev_chunk_ctx_create(&conf);
+	if (ctx == NULL) {
+		RTE_LOG(ERR, USER1, "Chunk context could not be created\n");
+		return -1;
+	}
+
+	if (rte_compressdev_chunk_start(ctx, data, data_len) < 0 ||
+			rte_compressdev_chunk_process(ctx, 0) !=
+				(int)DIV_CEIL(data_len, CHUNK_TEST_SZ)) {
+		RTE_LOG(ERR, USER1, "Chunks could not be compressed\n");
+		goto exit;
+	}
+
+	if (rte_compressdev_chunk_finish(ctx, NULL, &needed) != -ENOSPC ||
+			needed > *out_len ||
+			rte_compressdev_chunk_finish(ctx, out, out_len) < 0 ||
+			*out_len != needed) {
+		RTE_LOG(ERR, USER1, "Chunks could not be stitched\n");
+		goto exit;
+	}
+
+	memset(&stream, 0, sizeof(stream));
+	if (inflateInit2(&stream, -DEFAULT_WINDOW_SIZE) != Z_OK)
+		goto exit;
+	stream.next_in = out;
+	stream.avail_in = *out_len;
+	stream.next_out = decomp;
+	stream.avail_out = data_len;
+	ret = inflate(&stream, Z_FINISH);
+	inflateEnd(&stream);
+
+	if (ret != Z_STREAM_END || stream.total_out != data_len ||
+			memcmp(decomp, data, data_len) != 0) {
+		RTE_LOG(ERR, USER1, "Chunked stream not decompressed "
+			"correctly, zlib status %d\n", ret);
+		ret = -1;
+		goto exit;
+	}
+	ret = 0;
+
+exit:
+	rte_compressdev_chunk_ctx_free(ctx);
+	return ret;
+}
+
+/* Compress a large buffer in independent and in primed chunks, each chunk
+ * being a stateful operation on its own stream.
+ */
+static int
+test_compressdev_deflate_chunked(void)
+{
+	const struct rte_compressdev_capabilities *capab;
+	struct rte_compressdev_config config = {
+		.socket_id = rte_socket_id(),
+		.nb_queue_pairs = 1,
+		.max_nb_priv_xforms = NUM_MAX_XFORMS,
+		.max_nb_streams = CHUNK_TEST_DEPTH
+	};
+	size_t out_len, nodict_len, len;
+	uint8_t *data, *out, *decomp;
+	uint32_t i;
+	int ret = TEST_FAILED;
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_DEFLATE);
+	TEST_ASSERT(capab != NULL, "Failed to retrieve device capabilities");
+
+	if (!(capab->comp_feature_flags & RTE_COMP_FF_STATEFUL_COMPRESSION))
+		return -ENOTSUP;
+
+	/* One stream per chunk in flight */
+	rte_compressdev_stop(0);
+	if (rte_compressdev_configure(0, &config) < 0 ||
+			rte_compressdev_queue_pair_setup(0, 0,
+				NUM_MAX_INFLIGHT_OPS, rte_socket_id()) < 0 ||
+			rte_compressdev_start(0) < 0) {
+		RTE_LOG(ERR, USER1, "Device could not be reconfigured\n");
+		return TEST_FAILED;
+	}
+
+	out_len = CHUNK_TEST_DATA_SZ * COMPRESS_BUF_SIZE_RATIO;
+	data = rte_malloc(NULL, CHUNK_TEST_DATA_SZ, 0);
+	out = rte_malloc(NULL, out_len, 0);
+	decomp = rte_malloc(NULL, CHUNK_TEST_DATA_SZ, 0);
+	if (data == NULL || out == NULL || decomp == NULL) {
+		RTE_LOG(ERR, USER1, "Buffers could not be allocated\n");
+		goto exit;
+	}
+
+	for (i = 0; i < CHUNK_TEST_DATA_SZ; i += len) {
+		len = strlen(compress_test_bufs[(i / 64) %
+				RTE_DIM(compress_test_bufs)]);
+		len = RTE_MIN(len, (size_t)CHUNK_TEST_DATA_SZ - i);
+		memcpy(data + i, compress_test_bufs[(i / 64) %
+				RTE_DIM(compress_test_bufs)], len);
+	}
+
+	nodict_len = out_len;
+	if (test_chunk_run(data, CHUNK_TEST_DATA_SZ, 0, out, &nodict_len,
+			decomp) < 0)
+		goto exit;
+
+	if (capab->comp_feature_flags & RTE_COMP_FF_PRESET_DICT) {
+		len = out_len;
+		if (test_chunk_run(data, CHUNK_TEST_DATA_SZ,
+				1 << DEFAULT_WINDOW_SIZE, out, &len,
+				decomp) < 0)
+			goto exit;
+		if (len > nodict_len) {
+			RTE_LOG(ERR, USER1, "Primed chunks did not improve "
+				"the ratio: %zu bytes, %zu without\n",
+				len, nodict_len);
+			goto exit;
+		}
+	}
+
+	ret = TEST_SUCCESS;
+
+exit:
+	rte_free(data);
+	rte_free(out);
+	rte_free(decomp);
+	return ret;
+}
+
+/* End a compression stream with an empty final operation, whose source
+ * offset is the end of the source mbuf.
+ */
+static int
+test_compressdev_deflate_stateful_empty_final(void)
+{
+	struct comp_testsuite_params *ts_params = &testsuite_params;
+	const struct rte_compressdev_capabilities *capab;
+	const uint8_t *in = (const uint8_t *)compress_test_bufs[0];
+	uint32_t in_len = RTE_MIN(strlen(compress_test_bufs[0]), 1024U);
+	uint8_t comp_buf[2048], decomp_buf[2048];
+	uint32_t comp_len, final_len, decomp_len;
+	void *comp_stream = NULL, *decomp_xform = NULL;
+	int ret = TEST_FAILED;
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_DEFLATE);
+	TEST_ASSERT(capab != NULL, "Failed to retrieve device capabilities");
+
+	if (!(capab->comp_feature_flags & RTE_COMP_FF_STATEFUL_COMPRESSION))
+		return -ENOTSUP;
+
+	if (rte_compressdev_stream_create(0, ts_params->def_comp_xform,
+			&comp_stream) < 0 ||
+			rte_compressdev_private_xform_create(0,
+			ts_params->def_decomp_xform, &decomp_xform) < 0) {
+		RTE_LOG(ERR, USER1, "Stream or private xform could not be "
+			"created\n");
+		goto exit;
+	}
+
+	comp_len = sizeof(comp_buf);
+	if (test_run_linear_op(comp_stream, RTE_COMP_OP_STATEFUL,
+			RTE_COMP_FLUSH_NONE, in, in_len, 0, in_len,
+			comp_buf, &comp_len) < 0)
+		goto exit;
+
+	final_len = sizeof(comp_buf) - comp_len;
+	if (test_run_linear_op(comp_stream, RTE_COMP_OP_STATEFUL,
+			RTE_COMP_FLUSH_FINAL, in, in_len, in_len, 0,
+			comp_buf + comp_len, &final_len) < 0) {
+		RTE_LOG(ERR, USER1, "Empty final operation failed\n");
+		goto exit;
+	}
+	comp_len += final_len;
+
+	decomp_len = sizeof(decomp_buf);
+	if (test_run_linear_op(decomp_xform, RTE_COMP_OP_STATELESS,
+			RTE_COMP_FLUSH_FINAL, comp_buf, comp_len, 0, comp_len,
+			decomp_buf, &decomp_len) < 0)
+		goto exit;
+
+	if (decomp_len != in_len || memcmp(decomp_buf, in, in_len) != 0) {
+		RTE_LOG(ERR, USER1, "Stream not decompressed correctly\n");
+		goto exit;
+	}
+
+	ret = TEST_SUCCESS;
+
+exit:
+	if (comp_stream != NULL)
+		rte_compressdev_stream_free(0, comp_stream);
+	if (decomp_xform != NULL)
+		rte_compressdev_private_xform_free(0, decomp_xform);
+	return ret;
+}
+
 static int
 test_compressdev_external_mbufs(void)
 {
@@ -4193,6 +4615,12 @@ static struct unit_test_suite compressdev_testsuite  = {
 			test_compressdev_deflate_stateful_decomp),
 		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
 			test_compressdev_deflate_stateful_decomp_checksum),
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_deflate_dict),
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_deflate_stateful_empty_final),
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_deflate_chunked),
 		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
 			test_compressdev_external_mbufs),
 		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
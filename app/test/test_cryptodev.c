@@ -17865,6 +17865,15 @@ test_scheduler_mode_pkt_size_distr_op(void)
 	return 0;
 }
 
+static int
+test_scheduler_mode_latency_aware_op(void)
+{
+	TEST_ASSERT(test_scheduler_mode_op(CDEV_SCHED_MODE_LATENCY_AWARE) ==
+			0, "Failed to set latency-aware mode");
+
+	return 0;
+}
+
 static int
 scheduler_multicore_testsuite_setup(void)
 {
@@ -17905,6 +17914,16 @@ scheduler_pkt_size_distr_testsuite_setup(void)
 	return 0;
 }
 
+static int
+scheduler_latency_aware_testsuite_setup(void)
+{
+	if (test_scheduler_attach_worker_op() < 0)
+		return TEST_SKIPPED;
+	if (test_scheduler_mode_op(CDEV_SCHED_MODE_LATENCY_AWARE) < 0)
+		return TEST_SKIPPED;
+	return 0;
+}
+
 static void
 scheduler_mode_testsuite_teardown(void)
 {
@@ -20087,11 +20106,18 @@ test_cryptodev_scheduler(void)
 		.teardown = scheduler_mode_testsuite_teardown,
 		.unit_test_cases = {TEST_CASES_END()}
 	};
+	static struct unit_test_suite scheduler_latency_aware = {
+		.suite_name = "Scheduler Latency Aware Unit Test Suite",
+		.setup = scheduler_latency_aware_testsuite_setup,
+		.teardown = scheduler_mode_testsuite_teardown,
+		.unit_test_cases = {TEST_CASES_END()}
+	};
 	struct unit_test_suite *sched_mode_suites[] = {
 		&scheduler_multicore,
 		&scheduler_round_robin,
 		&scheduler_failover,
-		&scheduler_pkt_size_distr
+		&scheduler_pkt_size_distr,
+		&scheduler_latency_aware
 	};
 	static struct unit_test_suite scheduler_config = {
 		.suite_name = "Crypto Device Scheduler Config Unit Test Suite",
@@ -20101,6 +20127,7 @@ test_cryptodev_scheduler(void)
 			TEST_CASE(test_scheduler_mode_roundrobin_op),
 			TEST_CASE(test_scheduler_mode_failover_op),
 			TEST_CASE(test_scheduler_mode_pkt_size_distr_op),
+			TEST_CASE(test_scheduler_mode_latency_aware_op),
 			TEST_CASE(test_scheduler_detach_worker_op),
 
 			TEST_CASES_END() /**< NULL terminate array */
@@ -87,7 +87,7 @@ clear_packet_count(void)
 static int
 handle_work(void *arg)
 {
-	alignas(RTE_CACHE_LINE_SIZE) struct rte_mbuf *buf[8];
+	alignas(RTE_CACHE_LINE_SIZE) struct rte_mbuf *buf[BURST];
 	struct worker_params *wp = arg;
 	struct rte_distributor *db = wp->dist;
 	unsigned int num;
@@ -298,6 +298,65 @@ sanity_test(struct worker_params *wp, struct rte_mempool *p)
 }
 
 
+/* sanity_test_ordered sends packets of many flows through a distributor
+ * created with RTE_DISTRIBUTOR_F_ORDERED and verifies that they are
+ * returned in the order they were sent.
+ */
+static int
+sanity_test_ordered(struct worker_params *wp, struct rte_mempool *p)
+{
+	struct rte_distributor *d = wp->dist;
+	struct rte_mbuf *many_bufs[BIG_BATCH], *return_bufs[BIG_BATCH];
+	unsigned int num_returned = 0;
+	unsigned int processed = 0;
+	unsigned int i;
+
+	printf("=== Ordered distributor test (%s) ===\n", wp->name);
+	clear_packet_count();
+
+	rte_distributor_flush(d);
+	rte_distributor_clear_returns(d);
+
+	if (rte_mempool_get_bulk(p, (void *)many_bufs, BIG_BATCH) != 0) {
+		printf("line %d: Error getting mbufs from pool\n", __LINE__);
+		return -1;
+	}
+	for (i = 0; i < BIG_BATCH; i++)
+		many_bufs[i]->hash.usr = i << 2;
+
+	/* process() may accept fewer packets than given while the reorder
+	 * window is full, or none to just hand out the backlogs.
+	 */
+	while (num_returned < BIG_BATCH) {
+		processed += rte_distributor_process(d, &many_bufs[processed],
+				RTE_MIN((unsigned int)BURST, BIG_BATCH - processed));
+		num_returned += rte_distributor_returned_pkts(d,
+				&return_bufs[num_returned],
+				BIG_BATCH - num_returned);
+	}
+
+	if (total_packet_count() != BIG_BATCH) {
+		printf("Line %d: Error, not all packets handled. "
+				"Expected %u, got %u\n",
+				__LINE__, BIG_BATCH, total_packet_count());
+		rte_mempool_put_bulk(p, (void *)many_bufs, BIG_BATCH);
+		return -1;
+	}
+
+	for (i = 0; i < BIG_BATCH; i++) {
+		if (return_bufs[i] != many_bufs[i]) {
+			printf("Line %d: Error, packet %u returned out of order\n",
+					__LINE__, i);
+			rte_mempool_put_bulk(p, (void *)many_bufs, BIG_BATCH);
+			return -1;
+		}
+	}
+
+	rte_mempool_put_bulk(p, (void *)many_bufs, BIG_BATCH);
+	printf("Ordered distributor test passed\n\n");
+	return 0;
+}
+
 /* to test that the distributor does not lose packets, we use this worker
  * function which frees mbufs when it gets them. The distributor thread does
  * the mbuf allocation. If distributor drops packets we'll eventually run out
@@ -781,6 +840,36 @@ int test_error_distributor_create_numworkers(void)
 	return 0;
 }
 
+static
+int test_error_distributor_create_params(void)
+{
+	struct rte_distributor_params params = {
+		.name = "test_params",
+		.socket_id = rte_socket_id(),
+		.num_workers = rte_lcore_count() - 1,
+		.alg_type = RTE_DIST_ALG_BURST,
+		.burst_size = 12,
+	};
+	struct rte_distributor *d;
+
+	d = rte_distributor_create_with_params(&params);
+	if (d != NULL || rte_errno != EINVAL) {
+		printf("ERROR: No error on create() with invalid burst size\n");
+		return -1;
+	}
+
+	params.alg_type = RTE_DIST_ALG_SINGLE;
+	params.burst_size = 0;
+	params.flags = RTE_DISTRIBUTOR_F_ORDERED;
+	d = rte_distributor_create_with_params(&params);
+	if (d != NULL || rte_errno != EINVAL) {
+		printf("ERROR: No error on create() with ordered single mode\n");
+		return -1;
+	}
+
+	return 0;
+}
+
 
 /* Useful function which ensures that all worker functions terminate */
 static void
@@ -825,6 +914,7 @@ test_distributor(void)
 {
 	static struct rte_distributor *ds;
 	static struct rte_distributor *db;
+	static struct rte_distributor *dbo;
 	static struct rte_distributor *dist[2];
 	static struct rte_mempool *p;
 	int i;
@@ -873,6 +963,26 @@ test_distributor(void)
 		rte_distributor_clear_returns(ds);
 	}
 
+	if (dbo == NULL) {
+		struct rte_distributor_params params = {
+			.name = "Test_dist_ordered",
+			.socket_id = rte_socket_id(),
+			.num_workers = rte_lcore_count() - 1,
+			.alg_type = RTE_DIST_ALG_BURST,
+			.burst_size = BURST,
+			.flags = RTE_DISTRIBUTOR_F_ORDERED,
+		};
+
+		dbo = rte_distributor_create_with_params(&params);
+		if (dbo == NULL) {
+			printf("Error creating ordered burst distributor\n");
+			return -1;
+		}
+	} else {
+		rte_distributor_flush(dbo);
+		rte_distributor_clear_returns(dbo);
+	}
+
 	const unsigned nb_bufs = (511 * rte_lcore_count()) < BIG_BATCH ?
 			(BIG_BATCH * 2) - 1 : (511 * rte_lcore_count());
 	if (p == NULL) {
@@ -938,8 +1048,23 @@ test_distributor(void)
 
 	}
 
+	/* burst of 32 packets per worker, returned in order */
+	worker_params.dist = dbo;
+	strlcpy(worker_params.name, "ordered", sizeof(worker_params.name));
+
+	rte_eal_mp_remote_launch(handle_work, &worker_params, SKIP_MAIN);
+	if (sanity_test(&worker_params, p) < 0)
+		goto err;
+	quit_workers(&worker_params, p);
+
+	rte_eal_mp_remote_launch(handle_work, &worker_params, SKIP_MAIN);
+	if (sanity_test_ordered(&worker_params, p) < 0)
+		goto err;
+	quit_workers(&worker_params, p);
+
 	if (test_error_distributor_create_numworkers() == -1 ||
-			test_error_distributor_create_name() == -1) {
+			test_error_distributor_create_name() == -1 ||
+			test_error_distributor_create_params() == -1) {
 		printf("rte_distributor_create parameter check tests failed");
 		return -1;
 	}
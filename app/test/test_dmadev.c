@@ -1315,6 +1315,8 @@ test_dma(void)
 
 	/* attempt to create skeleton instance - ignore errors due to one being already present*/
 	rte_vdev_init(pmd, NULL);
+	/* and a skeleton instance with several cpuwork threads */
+	rte_vdev_init("dma_skeleton_mt", "threads=4,nt_thresh=1024");
 
 	if (rte_dma_count_avail() == 0)
 		return TEST_SKIPPED;
@@ -325,6 +325,138 @@ static int test_five_keys(void)
 	return 0;
 }
 
+/*
+ * Sequence of operations for bursts of keys:
+ *      - add keys (bulk)
+ *      - lookup keys: hit
+ *      - add keys (bulk update, with a key repeated in the burst)
+ *      - lookup keys: hit (updated data)
+ *      - delete keys : hit
+ *      - add keys (bulk) to a small table until bursts fail,
+ *        checking the number of keys of the table
+ */
+#define BULK_TEST_NUM_KEYS (128 * RTE_EFD_BURST_MAX)
+static int test_bulk_update(void)
+{
+	struct rte_efd_table *handle;
+	static uint64_t bulk_keys[BULK_TEST_NUM_KEYS];
+	static efd_value_t bulk_data[BULK_TEST_NUM_KEYS];
+	const void *key_array[RTE_EFD_BURST_MAX];
+	efd_value_t value_array[RTE_EFD_BURST_MAX];
+	int status[RTE_EFD_BURST_MAX];
+	efd_value_t prev_value;
+	unsigned int i, j, added, failed;
+	int ret;
+	printf("Entering %s\n", __func__);
+
+	handle = rte_efd_create("test_bulk_update", TABLE_SIZE,
+			sizeof(bulk_keys[0]),
+			efd_get_all_sockets_bitmask(), test_socket_id);
+	TEST_ASSERT_NOT_NULL(handle, "Error creating the efd table\n");
+
+	for (i = 0; i < BULK_TEST_NUM_KEYS; i++) {
+		bulk_keys[i] = rte_rand();
+		bulk_data[i] = mrand48() & VALUE_BITMASK;
+	}
+
+	TEST_ASSERT_EQUAL(rte_efd_update_bulk(handle, test_socket_id,
+			RTE_EFD_BURST_MAX + 1, key_array, value_array, status),
+			-EINVAL, "Burst bigger than RTE_EFD_BURST_MAX accepted");
+
+	/* Add */
+	for (i = 0; i < BULK_TEST_NUM_KEYS; i += RTE_EFD_BURST_MAX) {
+		for (j = 0; j < RTE_EFD_BURST_MAX; j++)
+			key_array[j] = &bulk_keys[i + j];
+		ret = rte_efd_update_bulk(handle, test_socket_id,
+				RTE_EFD_BURST_MAX, key_array, &bulk_data[i],
+				status);
+		TEST_ASSERT_EQUAL(ret, RTE_EFD_BURST_MAX,
+				"Error inserting the keys, only %d added", ret);
+		TEST_ASSERT_EQUAL(rte_efd_count(handle), i + RTE_EFD_BURST_MAX,
+				"Wrong number of keys after bulk insert");
+	}
+
+	/* Lookup */
+	for (i = 0; i < BULK_TEST_NUM_KEYS; i++)
+		TEST_ASSERT_EQUAL(rte_efd_lookup(handle, test_socket_id,
+				&bulk_keys[i]), bulk_data[i],
+				"failed to find key %u", i);
+
+	/*
+	 * Update, the first key of each burst is replaced by the second one
+	 * with another value, which must be overwritten by the second update.
+	 */
+	for (i = 0; i < BULK_TEST_NUM_KEYS; i += RTE_EFD_BURST_MAX) {
+		for (j = 0; j < RTE_EFD_BURST_MAX; j++) {
+			bulk_data[i + j] = (bulk_data[i + j] + 1) & VALUE_BITMASK;
+			key_array[j] = &bulk_keys[i + j];
+			value_array[j] = bulk_data[i + j];
+		}
+		key_array[0] = &bulk_keys[i + 1];
+		value_array[0] = (bulk_data[i + 1] + 1) & VALUE_BITMASK;
+		ret = rte_efd_update_bulk(handle, test_socket_id,
+				RTE_EFD_BURST_MAX, key_array, value_array,
+				status);
+		TEST_ASSERT_EQUAL(ret, RTE_EFD_BURST_MAX,
+				"Error updating the keys, only %d updated", ret);
+		bulk_data[i] = (bulk_data[i] - 1) & VALUE_BITMASK;
+	}
+	TEST_ASSERT_EQUAL(rte_efd_count(handle), BULK_TEST_NUM_KEYS,
+			"Wrong number of keys after bulk update");
+
+	/* Lookup */
+	for (i = 0; i < BULK_TEST_NUM_KEYS; i++)
+		TEST_ASSERT_EQUAL(rte_efd_lookup(handle, test_socket_id,
+				&bulk_keys[i]), bulk_data[i],
+				"failed to find updated key %u", i);
+
+	/* Delete */
+	for (i = 0; i < BULK_TEST_NUM_KEYS; i++) {
+		TEST_ASSERT_SUCCESS(rte_efd_delete(handle, test_socket_id,
+				&bulk_keys[i], &prev_value),
+				"failed to delete key %u", i);
+		TEST_ASSERT_EQUAL(prev_value, bulk_data[i],
+				"failed to delete the expected value, got %d, "
+				"expected %d", prev_value, bulk_data[i]);
+	}
+	TEST_ASSERT_EQUAL(rte_efd_count(handle), 0,
+			"Wrong number of keys after delete");
+
+	rte_efd_free(handle);
+
+	/*
+	 * Fill a single chunk table, the bursts failing at the end must only
+	 * count the keys actually added, whether the chunk was restored or not.
+	 */
+	handle = rte_efd_create("test_bulk_update_full", 1,
+			sizeof(bulk_keys[0]),
+			efd_get_all_sockets_bitmask(), test_socket_id);
+	TEST_ASSERT_NOT_NULL(handle, "Error creating the efd table\n");
+
+	added = 0;
+	failed = 0;
+	for (i = 0; i < BULK_TEST_NUM_KEYS && failed < 4;
+			i += RTE_EFD_BURST_MAX) {
+		for (j = 0; j < RTE_EFD_BURST_MAX; j++)
+			key_array[j] = &bulk_keys[i + j];
+		ret = rte_efd_update_bulk(handle, test_socket_id,
+				RTE_EFD_BURST_MAX, key_array, &bulk_data[i],
+				status);
+		TEST_ASSERT(ret >= 0, "Error updating the keys");
+		if (ret != RTE_EFD_BURST_MAX)
+			failed++;
+		added += ret;
+		TEST_ASSERT_EQUAL(rte_efd_count(handle), added,
+				"Wrong number of keys, %u instead of %u",
+				rte_efd_count(handle), added);
+	}
+	TEST_ASSERT(failed != 0, "Single chunk table never full");
+
+	rte_efd_free(handle);
+
+	return 0;
+}
+
 /*
  * Test to see the average table utilization (entries added/max entries)
  * before hitting a random entry that cannot be added
@@ -463,6 +595,8 @@ test_efd(void)
 		return -1;
 	if (test_five_keys() < 0)
 		return -1;
+	if (test_bulk_update() < 0)
+		return -1;
 	if (test_efd_creation_with_bad_parameters() < 0)
 		return -1;
 	if (test_average_table_utilization() < 0)
@@ -31,6 +31,7 @@ test_efd_perf(void)
 #define MAX_ENTRIES (1 << 19)
 #define KEYS_TO_ADD (MAX_ENTRIES * 3 / 4) /* 75% table utilization */
 #define NUM_LOOKUPS (KEYS_TO_ADD * 5) /* Loop among keys added, several times */
+#define MW_KEYSIZE_IDX 2 /* Key size used by the multi-writer tests */
 
 #if RTE_EFD_VALUE_NUM_BITS == 32
 #define VALUE_BITMASK 0xffffffff
@@ -381,6 +382,155 @@ run_all_tbl_perf_tests(void)
 	return 0;
 }
 
+struct efd_writer_params {
+	struct rte_efd_table *efd_table;
+	unsigned int writer_id;
+	unsigned int num_writers;
+	bool bulk;
+};
+
+static struct efd_writer_params writer_params[RTE_MAX_LCORE];
+
+/*
+ * Each writer adds the bursts of keys matching its index, so that
+ * the writers work concurrently on random chunks of the same table.
+ */
+static int
+efd_writer(void *arg)
+{
+	const struct efd_writer_params *wp = arg;
+	const void *keys_burst[RTE_EFD_BURST_MAX];
+	int status[RTE_EFD_BURST_MAX];
+	unsigned int i, j, k;
+	int ret;
+
+	for (j = wp->writer_id; j < KEYS_TO_ADD / RTE_EFD_BURST_MAX;
+			j += wp->num_writers) {
+		i = j * RTE_EFD_BURST_MAX;
+		if (wp->bulk) {
+			for (k = 0; k < RTE_EFD_BURST_MAX; k++)
+				keys_burst[k] = keys[i + k];
+			ret = rte_efd_update_bulk(wp->efd_table,
+					test_socket_id, RTE_EFD_BURST_MAX,
+					keys_burst, &data[i], status);
+			if (ret != RTE_EFD_BURST_MAX) {
+				printf("Error in rte_efd_update_bulk, "
+						"%d keys updated\n", ret);
+				return -1;
+			}
+			continue;
+		}
+		for (k = 0; k < RTE_EFD_BURST_MAX; k++) {
+			ret = rte_efd_update(wp->efd_table, test_socket_id,
+					keys[i + k], data[i + k]);
+			if (ret != 0) {
+				printf("Error %d in rte_efd_update\n", ret);
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int
+timed_multi_writer_adds(struct efd_perf_params *params,
+		unsigned int num_writers, bool bulk, double *rate)
+{
+	unsigned int lcore_id, n = 0;
+	uint64_t start_tsc, time_taken;
+	int ret = 0;
+
+	params->efd_table = rte_efd_create("test_efd_perf_mw",
+			MAX_ENTRIES, params->key_size,
+			efd_get_all_sockets_bitmask(), test_socket_id);
+	TEST_ASSERT_NOT_NULL(params->efd_table, "Error creating the efd table\n");
+
+	start_tsc = rte_rdtsc();
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (n == num_writers)
+			break;
+		writer_params[lcore_id] = (struct efd_writer_params) {
+			.efd_table = params->efd_table,
+			.writer_id = n++,
+			.num_writers = num_writers,
+			.bulk = bulk,
+		};
+		rte_eal_remote_launch(efd_writer, &writer_params[lcore_id],
+				lcore_id);
+	}
+	n = 0;
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (n++ == num_writers)
+			break;
+		if (rte_eal_wait_lcore(lcore_id) < 0)
+			ret = -1;
+	}
+	time_taken = rte_rdtsc() - start_tsc;
+
+	*rate = (double)(KEYS_TO_ADD / RTE_EFD_BURST_MAX * RTE_EFD_BURST_MAX) *
+			rte_get_tsc_hz() / time_taken;
+
+	/* Check that the concurrent updates did not corrupt each other */
+	for (n = 0; ret == 0 && n < KEYS_TO_ADD / RTE_EFD_BURST_MAX *
+			RTE_EFD_BURST_MAX; n++) {
+		if (rte_efd_lookup(params->efd_table, test_socket_id,
+				keys[n]) != data[n]) {
+			printf("Value mismatch after concurrent updates: "
+					"key #%u\n", n);
+			ret = -1;
+		}
+	}
+
+	perform_frees(params);
+	return ret;
+}
+
+static int
+run_multi_writer_perf_tests(void)
+{
+	unsigned int num_writers, max_writers = rte_lcore_count() - 1;
+	double rate[2];
+	struct efd_perf_params params;
+
+	if (max_writers == 0) {
+		printf("At least 2 lcores are needed for the multi-writer tests, "
+				"skipping\n");
+		return 0;
+	}
+
+	printf("\nMeasuring multi-writer performance, please wait\n");
+	fflush(stdout);
+
+	if (setup_keys_and_data(&params, MW_KEYSIZE_IDX) < 0) {
+		printf("Could not create keys/data/table\n");
+		return -1;
+	}
+	/* Only the keys are needed, the tables are created per test */
+	perform_frees(&params);
+
+	printf("\nResults (in million updates/second, keysize %d)\n",
+			hashtest_key_lens[MW_KEYSIZE_IDX]);
+	printf("-----------------------------------\n");
+	printf("\n%-18s%-18s%-18s\n", "Writers", "Update", "Update_bulk");
+	for (num_writers = 1; ;
+			num_writers = RTE_MIN(num_writers * 2, max_writers)) {
+		if (timed_multi_writer_adds(&params, num_writers, false,
+					&rate[0]) < 0 ||
+				timed_multi_writer_adds(&params, num_writers,
+					true, &rate[1]) < 0)
+			return exit_with_fail("timed_multi_writer_adds",
+					&params, num_writers);
+
+		printf("%-18u%-18.2f%-18.2f\n", num_writers,
+				rate[0] / 1e6, rate[1] / 1e6);
+		if (num_writers == max_writers)
+			break;
+	}
+
+	return 0;
+}
+
 static int
 test_efd_perf(void)
 {
@@ -388,6 +538,9 @@ test_efd_perf(void)
 	if (run_all_tbl_perf_tests() < 0)
 		return -1;
 
+	if (run_multi_writer_perf_tests() < 0)
+		return -1;
+
 	return 0;
 }
 
@@ -30,6 +30,9 @@ test_event_eth_rx_intr_adapter_common(void)
 
 #include <rte_eventdev.h>
 #include <rte_bus_vdev.h>
+#include <rte_eth_ring.h>
+#include <rte_ring.h>
+#include <rte_service.h>
 
 #include <rte_event_eth_rx_adapter.h>
 
@@ -41,6 +44,13 @@ test_event_eth_rx_intr_adapter_common(void)
 #define TEST_DEV_ID		0
 #define TEST_ETHDEV_ID		0
 #define TEST_ETH_QUEUE_ID	0
+#define TEST_VECTOR_INST_ID	1
+#define TEST_VECTOR_EVDEV	"event_sw_rxa_vec"
+#define TEST_VECTOR_RING	"rxa_vec"
+#define TEST_VECTOR_SZ		4
+/* Flow groups of the Rx adapter, packets are spread by RSS hash modulo */
+#define TEST_VECTOR_NB_FLOWS	8
+#define TEST_VECTOR_NB_PKTS	(TEST_VECTOR_SZ * TEST_VECTOR_NB_FLOWS)
 
 struct event_eth_rx_adapter_test_params {
 	struct rte_mempool *mp;
@@ -1489,6 +1499,45 @@ adapter_get_set_params(void)
 		    "Expected %u got %u",
 		    in_params.max_nb_rx, out_params.max_nb_rx);
 
+	/* Case 7: Idle waits and servicing weight updates are disabled
+	 * by default
+	 */
+	err = rte_event_eth_rx_adapter_runtime_params_init(&in_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(in_params.idle_polls == 0 &&
+		    in_params.weight_update_ms == 0,
+		    "Expected idle waits and weight updates disabled");
+
+	/* Case 8: Enable idle waits and servicing weight updates */
+	in_params.idle_polls = 64;
+	in_params.idle_wait_us = 50;
+	in_params.weight_update_ms = 100;
+
+	err = rte_event_eth_rx_adapter_runtime_params_set(TEST_INST_ID,
+							  &in_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_runtime_params_get(TEST_INST_ID,
+							  &out_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(in_params.idle_polls == out_params.idle_polls,
+		    "Expected %u got %u",
+		    in_params.idle_polls, out_params.idle_polls);
+	TEST_ASSERT(in_params.idle_wait_us == out_params.idle_wait_us,
+		    "Expected %u got %u",
+		    in_params.idle_wait_us, out_params.idle_wait_us);
+	TEST_ASSERT(in_params.weight_update_ms == out_params.weight_update_ms,
+		    "Expected %u got %u",
+		    in_params.weight_update_ms, out_params.weight_update_ms);
+
+	/* Case 9: Disable them back */
+	err = rte_event_eth_rx_adapter_runtime_params_init(&in_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_runtime_params_set(TEST_INST_ID,
+							  &in_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
 	rc = TEST_SUCCESS;
 skip:
 	err = rte_event_eth_rx_adapter_queue_del(TEST_INST_ID,
@@ -1498,6 +1547,198 @@ adapter_get_set_params(void)
 	return rc;
 }
 
+/* The adapter enqueues on the second event port, set up by the test */
+static int
+vector_port_conf_cb(uint8_t id, uint8_t event_dev_id,
+		    struct rte_event_eth_rx_adapter_conf *conf,
+		    void *conf_arg)
+{
+	RTE_SET_USED(id);
+	RTE_SET_USED(event_dev_id);
+	RTE_SET_USED(conf_arg);
+
+	conf->event_port_id = 1;
+	conf->max_nb_rx = 128;
+
+	return 0;
+}
+
+/* Check that with an event device scheduling vectors by flow, the packets
+ * of an Rx queue are aggregated in vectors of a single flow group, each
+ * flow group of the queue having its own flow id.
+ */
+static int
+adapter_vector_flow(void)
+{
+	struct rte_event_eth_rx_adapter_queue_conf queue_conf = { 0 };
+	struct rte_event_dev_config config = {
+		.nb_event_queues = 1,
+		.nb_event_ports = 2,
+		.nb_events_limit = 4096,
+		.nb_event_queue_flows = 1024,
+		.nb_event_port_dequeue_depth = 32,
+		.nb_event_port_enqueue_depth = 32,
+	};
+	static const struct rte_eth_conf eth_conf;
+	struct rte_mbuf *pkts[TEST_VECTOR_NB_PKTS];
+	uint32_t flow_ids[TEST_VECTOR_NB_FLOWS];
+	struct rte_event_queue_conf qconf;
+	struct rte_event_dev_info dev_info;
+	struct rte_mempool *vector_mp;
+	struct rte_event_vector *vec;
+	uint32_t evdev_sid, rxa_sid;
+	struct rte_event ev[32];
+	struct rte_ring *r;
+	uint16_t i, j, n, nb_pkts;
+	uint32_t flow;
+	int evdev, port, iter, err;
+
+	if (rte_vdev_init(TEST_VECTOR_EVDEV, NULL) < 0) {
+		printf("Failed to create %s, skipping\n", TEST_VECTOR_EVDEV);
+		return TEST_SKIPPED;
+	}
+	evdev = rte_event_dev_get_dev_id(TEST_VECTOR_EVDEV);
+	TEST_ASSERT(evdev >= 0, "Failed to get event device id");
+
+	err = rte_event_dev_info_get(evdev, &dev_info);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	if (!(dev_info.event_dev_cap & RTE_EVENT_DEV_CAP_EVENT_VECTOR)) {
+		rte_vdev_uninit(TEST_VECTOR_EVDEV);
+		return TEST_SKIPPED;
+	}
+
+	err = rte_event_dev_configure(evdev, &config);
+	TEST_ASSERT(err == 0, "Event device configuration failed %d", err);
+	err = rte_event_queue_default_conf_get(evdev, 0, &qconf);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	qconf.schedule_type = RTE_SCHED_TYPE_ATOMIC;
+	err = rte_event_queue_setup(evdev, 0, &qconf);
+	TEST_ASSERT(err == 0, "Event queue setup failed %d", err);
+	err = rte_event_port_setup(evdev, 0, NULL);
+	TEST_ASSERT(err == 0, "Event port setup failed %d", err);
+	err = rte_event_port_setup(evdev, 1, NULL);
+	TEST_ASSERT(err == 0, "Event port setup failed %d", err);
+	err = rte_event_port_link(evdev, 0, NULL, NULL, 0);
+	TEST_ASSERT(err == 1, "Event port link failed %d", err);
+
+	r = rte_ring_create(TEST_VECTOR_RING, 256, rte_socket_id(),
+			    RING_F_SP_ENQ | RING_F_SC_DEQ);
+	TEST_ASSERT_NOT_NULL(r, "Failed to create ring");
+	port = rte_eth_from_ring(r);
+	TEST_ASSERT(port >= 0, "Failed to create ring port");
+	err = rte_eth_dev_configure(port, 1, 1, &eth_conf);
+	TEST_ASSERT(err == 0, "Port configuration failed %d", err);
+	err = rte_eth_rx_queue_setup(port, 0, 256, rte_socket_id(), NULL,
+				     default_params.mp);
+	TEST_ASSERT(err == 0, "Rx queue setup failed %d", err);
+	err = rte_eth_tx_queue_setup(port, 0, 256, rte_socket_id(), NULL);
+	TEST_ASSERT(err == 0, "Tx queue setup failed %d", err);
+	err = rte_eth_dev_start(port);
+	TEST_ASSERT(err == 0, "Port start failed %d", err);
+
+	vector_mp = rte_event_vector_pool_create("rxa_vec_pool", 64, 0,
+						 TEST_VECTOR_SZ,
+						 rte_socket_id());
+	TEST_ASSERT_NOT_NULL(vector_mp, "Failed to create vector pool");
+
+	err = rte_event_eth_rx_adapter_create_ext(TEST_VECTOR_INST_ID, evdev,
+						  vector_port_conf_cb, NULL);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	queue_conf.rx_queue_flags = RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR;
+	queue_conf.servicing_weight = 1;
+	queue_conf.ev.queue_id = 0;
+	queue_conf.ev.sched_type = RTE_SCHED_TYPE_ATOMIC;
+	queue_conf.ev.priority = RTE_EVENT_DEV_PRIORITY_NORMAL;
+	queue_conf.vector_sz = TEST_VECTOR_SZ;
+	queue_conf.vector_timeout_ns = 1E8;
+	queue_conf.vector_mp = vector_mp;
+	err = rte_event_eth_rx_adapter_queue_add(TEST_VECTOR_INST_ID, port, 0,
+						 &queue_conf);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_service_id_get(TEST_VECTOR_INST_ID,
+						      &rxa_sid);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	err = rte_event_dev_service_id_get(evdev, &evdev_sid);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	rte_service_runstate_set(rxa_sid, 1);
+	rte_service_set_runstate_mapped_check(rxa_sid, 0);
+	rte_service_runstate_set(evdev_sid, 1);
+	rte_service_set_runstate_mapped_check(evdev_sid, 0);
+
+	err = rte_event_dev_start(evdev);
+	TEST_ASSERT(err == 0, "Event device start failed %d", err);
+	err = rte_event_eth_rx_adapter_start(TEST_VECTOR_INST_ID);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	/* Interleave the flows, packet i being of flow group i % NB_FLOWS */
+	err = rte_pktmbuf_alloc_bulk(default_params.mp, pkts,
+				     TEST_VECTOR_NB_PKTS);
+	TEST_ASSERT(err == 0, "Failed to allocate mbufs");
+	for (i = 0; i < TEST_VECTOR_NB_PKTS; i++) {
+		rte_pktmbuf_append(pkts[i], 64);
+		pkts[i]->ol_flags |= RTE_MBUF_F_RX_RSS_HASH;
+		pkts[i]->hash.rss = (i << 8) | (i % TEST_VECTOR_NB_FLOWS);
+	}
+	n = rte_ring_enqueue_bulk(r, (void **)pkts, TEST_VECTOR_NB_PKTS, NULL);
+	TEST_ASSERT(n == TEST_VECTOR_NB_PKTS, "Failed to enqueue packets");
+
+	for (i = 0; i < TEST_VECTOR_NB_FLOWS; i++)
+		flow_ids[i] = UINT32_MAX;
+
+	nb_pkts = 0;
+	for (iter = 0; iter < 1000 && nb_pkts < TEST_VECTOR_NB_PKTS; iter++) {
+		rte_service_run_iter_on_app_lcore(rxa_sid, 1);
+		rte_service_run_iter_on_app_lcore(evdev_sid, 1);
+		n = rte_event_dequeue_burst(evdev, 0, ev, RTE_DIM(ev), 0);
+		for (i = 0; i < n; i++) {
+			TEST_ASSERT(ev[i].event_type ==
+				    RTE_EVENT_TYPE_ETH_RX_ADAPTER_VECTOR,
+				    "Unexpected event type %u",
+				    ev[i].event_type);
+			vec = ev[i].vec;
+			TEST_ASSERT(vec->nb_elem == TEST_VECTOR_SZ,
+				    "Expected %u packets got %u",
+				    TEST_VECTOR_SZ, vec->nb_elem);
+			flow = vec->mbufs[0]->hash.rss % TEST_VECTOR_NB_FLOWS;
+			for (j = 1; j < vec->nb_elem; j++)
+				TEST_ASSERT(vec->mbufs[j]->hash.rss %
+					    TEST_VECTOR_NB_FLOWS == flow,
+					    "Vector of several flow groups");
+			TEST_ASSERT(flow_ids[flow] == UINT32_MAX,
+				    "Several vectors of flow group %u", flow);
+			flow_ids[flow] = ev[i].flow_id;
+			nb_pkts += vec->nb_elem;
+			rte_pktmbuf_free_bulk(vec->mbufs, vec->nb_elem);
+			rte_mempool_put(rte_mempool_from_obj(vec), vec);
+		}
+	}
+	TEST_ASSERT(nb_pkts == TEST_VECTOR_NB_PKTS, "Expected %u packets got %u",
+		    TEST_VECTOR_NB_PKTS, nb_pkts);
+
+	for (i = 0; i < TEST_VECTOR_NB_FLOWS; i++)
+		for (j = i + 1; j < TEST_VECTOR_NB_FLOWS; j++)
+			TEST_ASSERT(flow_ids[i] != flow_ids[j],
+				    "Flow groups %u and %u share flow id %u",
+				    i, j, flow_ids[i]);
+
+	rte_event_eth_rx_adapter_stop(TEST_VECTOR_INST_ID);
+	rte_event_dev_stop(evdev);
+	err = rte_event_eth_rx_adapter_queue_del(TEST_VECTOR_INST_ID, port, 0);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	err = rte_event_eth_rx_adapter_free(TEST_VECTOR_INST_ID);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	rte_event_dev_close(evdev);
+	rte_vdev_uninit(TEST_VECTOR_EVDEV);
+	rte_eth_dev_stop(port);
+	rte_vdev_uninit("net_ring_" TEST_VECTOR_RING);
+	rte_ring_free(r);
+	rte_mempool_free(vector_mp);
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite event_eth_rx_tests = {
 	.suite_name = "rx event eth adapter test suite",
 	.setup = testsuite_setup,
@@ -1524,6 +1765,7 @@ static struct unit_test_suite event_eth_rx_tests = {
 			     adapter_get_set_params),
 		TEST_CASE_ST(adapter_create_ext_with_params, adapter_free,
 			     adapter_start_stop),
+		TEST_CASE_ST(NULL, NULL, adapter_vector_flow),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
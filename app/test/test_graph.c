@@ -1062,6 +1062,77 @@ test_print_stats(void)
 	return 0;
 }
 
+static int
+test_graph_profile(void)
+{
+	struct rte_graph *graph = rte_graph_lookup("worker0");
+	struct rte_graph_node_profile prof;
+	rte_node_t src_id;
+	uint64_t calls, hist_sum;
+	int i;
+
+	if (!graph) {
+		printf("Graph lookup failed\n");
+		return -1;
+	}
+
+	src_id = rte_node_from_name("test_node_source1");
+	if (rte_graph_profile_enable(graph_id, NULL)) {
+		printf("Graph profile enable failed\n");
+		return -1;
+	}
+
+	if (!rte_graph_profile_is_enabled(graph_id)) {
+		printf("Graph profile not reported as enabled\n");
+		goto fail;
+	}
+
+	for (i = 0; i < 5; i++)
+		rte_graph_walk(graph);
+
+	if (rte_graph_node_profile_get(graph_id, src_id, &prof)) {
+		printf("Graph node profile get failed\n");
+		goto fail;
+	}
+
+	if (prof.calls != 5) {
+		printf("Profile call count mismatch, expected = 5 got = %" PRIu64 "\n",
+		       prof.calls);
+		goto fail;
+	}
+
+	hist_sum = 0;
+	for (i = 0; i < RTE_GRAPH_PROFILE_HIST_BUCKETS; i++)
+		hist_sum += prof.hist[i];
+	if (hist_sum != prof.calls) {
+		printf("Profile histogram does not match call count\n");
+		goto fail;
+	}
+
+	rte_graph_profile_dump(stdout, graph_id);
+
+	/* Profiling data must stay frozen once disabled */
+	calls = prof.calls;
+	if (rte_graph_profile_disable(graph_id))
+		goto fail;
+	rte_graph_walk(graph);
+	if (rte_graph_node_profile_get(graph_id, src_id, &prof) || prof.calls != calls) {
+		printf("Profile data updated after disable\n");
+		return -1;
+	}
+
+	if (rte_graph_profile_reset(graph_id) ||
+	    rte_graph_node_profile_get(graph_id, src_id, &prof) || prof.calls != 0) {
+		printf("Profile reset failed\n");
+		return -1;
+	}
+
+	return 0;
+fail:
+	rte_graph_profile_disable(graph_id);
+	return -1;
+}
+
 static int
 graph_setup(void)
 {
@@ -1140,6 +1211,7 @@ static struct unit_test_suite graph_testsuite = {
 		TEST_CASE(test_graph_lookup_functions),
 		TEST_CASE(test_graph_walk),
 		TEST_CASE(test_print_stats),
+		TEST_CASE(test_graph_profile),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
@@ -43,6 +43,7 @@ test_ipsec(void)
 #define REPLAY_WIN_64	64
 #define REPLAY_WIN_128	128
 #define REPLAY_WIN_256	256
+#define REPLAY_WIN_4096	4096
 #define DATA_64_BYTES	64
 #define DATA_80_BYTES	80
 #define DATA_100_BYTES	100
@@ -117,6 +118,10 @@ static const struct ipsec_test_cfg test_cfg[] = {
 	{REPLAY_WIN_128, ESN_ENABLED, RTE_IPSEC_SAFLAG_SQN_ATOM,
 		DATA_80_BYTES, 1, 0},
 	{REPLAY_WIN_256, ESN_DISABLED, 0, DATA_100_BYTES, 1, 0},
+	{REPLAY_WIN_4096, ESN_ENABLED, RTE_IPSEC_SAFLAG_SQN_MT,
+		DATA_64_BYTES, 1, 0},
+	{REPLAY_WIN_4096, ESN_DISABLED, RTE_IPSEC_SAFLAG_SQN_MT,
+		DATA_80_BYTES, BURST_SIZE, REORDER_PKTS},
 };
 
 static const int num_cfg = RTE_DIM(test_cfg);
@@ -2169,7 +2174,7 @@ test_ipsec_replay_inb_outside_null_null_wrapper(void)
 }
 
 static int
-test_ipsec_replay_inb_repeat_null_null(int i)
+test_ipsec_replay_inb_repeat_null_null(int i, uint32_t sqn)
 {
 	struct ipsec_testsuite_params *ts_params = &testsuite_params;
 	struct ipsec_unitest_params *ut_params = &unittest_params;
@@ -2185,7 +2190,7 @@ test_ipsec_replay_inb_repeat_null_null(int i)
 
 	/* Generate test mbuf data */
 	ut_params->ibuf[0] = setup_test_string_tunneled(ts_params->mbuf_pool,
-		null_encrypted_data, test_cfg[i].pkt_sz, INBOUND_SPI, 1);
+		null_encrypted_data, test_cfg[i].pkt_sz, INBOUND_SPI, sqn);
 	if (ut_params->ibuf[0] == NULL)
 		rc = TEST_FAILED;
 	else
@@ -2215,7 +2220,7 @@ test_ipsec_replay_inb_repeat_null_null(int i)
 
 		ut_params->ibuf[0] = setup_test_string_tunneled(
 			ts_params->mbuf_pool, null_encrypted_data,
-			test_cfg[i].pkt_sz, INBOUND_SPI, 1);
+			test_cfg[i].pkt_sz, INBOUND_SPI, sqn);
 		if (ut_params->ibuf[0] == NULL)
 			rc = TEST_FAILED;
 		else
@@ -2227,12 +2232,12 @@ test_ipsec_replay_inb_repeat_null_null(int i)
 			if (rc == 0) {
 				RTE_LOG(ERR, USER1,
 					"packet is not repeated in the replay window, cfg %d seq %u\n",
-					i, 1);
+					i, sqn);
 				rc = TEST_FAILED;
 			} else {
 				RTE_LOG(ERR, USER1,
 					"packet is repeated in the replay window, cfg %d seq %u\n",
-					i, 1);
+					i, sqn);
 				rc = 0;
 			}
 		}
@@ -2261,7 +2266,29 @@ test_ipsec_replay_inb_repeat_null_null_wrapper(void)
 
 	for (i = 0; i < num_cfg && rc == 0; i++) {
 		ut_params->ipsec_xform.options.esn = test_cfg[i].esn;
-		rc = test_ipsec_replay_inb_repeat_null_null(i);
+		rc = test_ipsec_replay_inb_repeat_null_null(i, 1);
+	}
+
+	return rc;
+}
+
+static int
+test_ipsec_replay_inb_repeat_high_null_null_wrapper(void)
+{
+	int i;
+	int rc = 0;
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+
+	ut_params->ipsec_xform.spi = INBOUND_SPI;
+	ut_params->ipsec_xform.direction = RTE_SECURITY_IPSEC_SA_DIR_INGRESS;
+	ut_params->ipsec_xform.proto = RTE_SECURITY_IPSEC_SA_PROTO_ESP;
+	ut_params->ipsec_xform.mode = RTE_SECURITY_IPSEC_SA_MODE_TUNNEL;
+	ut_params->ipsec_xform.tunnel.type = RTE_SECURITY_IPSEC_TUNNEL_IPV4;
+
+	for (i = 0; i < num_cfg && rc == 0; i++) {
+		ut_params->ipsec_xform.options.esn = test_cfg[i].esn;
+		/* seq number in the upper half of a window bucket */
+		rc = test_ipsec_replay_inb_repeat_null_null(i, 40);
 	}
 
 	return rc;
@@ -2570,6 +2597,167 @@ test_ipsec_crypto_inb_burst_2sa_4grp_null_null_wrapper(void)
 	return rc;
 }
 
+#define MT_NUM_SQN	2048
+#define MT_MAX_WORKERS	4
+
+struct ipsec_mt_worker {
+	struct rte_mbuf *mb[2 * MT_NUM_SQN];
+	uint32_t sqn[2 * MT_NUM_SQN];
+	uint32_t num;
+	uint32_t acc[2 * MT_NUM_SQN];
+	uint32_t nb_acc;
+	uint64_t bytes;
+};
+
+static struct ipsec_mt_worker ipsec_mt_workers[MT_MAX_WORKERS];
+
+static int
+ipsec_mt_inb_worker(void *arg)
+{
+	struct ipsec_mt_worker *w = arg;
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+	struct rte_mbuf *mb[BURST_SIZE];
+	uint32_t i, j, k, l, n;
+
+	for (i = 0; i != w->num; i += n) {
+		n = RTE_MIN(w->num - i, (uint32_t)BURST_SIZE);
+		memcpy(mb, w->mb + i, n * sizeof(mb[0]));
+
+		k = rte_ipsec_pkt_process(&ut_params->ss[0], mb, n);
+
+		/* accepted packets are moved to the front of the burst */
+		for (j = 0; j != k; j++) {
+			for (l = i; w->mb[l] != mb[j]; l++)
+				;
+			w->acc[w->nb_acc++] = w->sqn[l];
+			w->bytes += mb[j]->pkt_len;
+		}
+	}
+
+	return 0;
+}
+
+static int
+test_ipsec_inline_crypto_inb_mt_null_null(void)
+{
+	struct ipsec_testsuite_params *ts_params = &testsuite_params;
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+	struct ipsec_mt_worker *w;
+	struct rte_ipsec_sa_stats stats;
+	uint8_t hits[MT_NUM_SQN + 1];
+	uint32_t i, nb_workers, nb_acc, s;
+	uint32_t lcore_id[MT_MAX_WORKERS];
+	uint64_t bytes;
+	int32_t rc;
+
+	nb_workers = 0;
+	RTE_LCORE_FOREACH_WORKER(s) {
+		if (nb_workers == MT_MAX_WORKERS)
+			break;
+		lcore_id[nb_workers++] = s;
+	}
+	if (nb_workers < 2) {
+		RTE_LOG(INFO, USER1, "Need at least two worker lcores\n");
+		return TEST_SKIPPED;
+	}
+
+	rc = create_sa(RTE_SECURITY_ACTION_TYPE_INLINE_CRYPTO,
+			REPLAY_WIN_4096, RTE_IPSEC_SAFLAG_SQN_MT, 0);
+	if (rc != 0) {
+		RTE_LOG(ERR, USER1, "create_sa failed\n");
+		return rc;
+	}
+
+	/*
+	 * Spread sequence numbers among the workers, each of them also gets
+	 * a duplicate of the packets processed by the previous worker,
+	 * so that the same sequence number is checked by two lcores at once.
+	 * Packets are generated here, as it updates the global outer header.
+	 */
+	memset(ipsec_mt_workers, 0, sizeof(ipsec_mt_workers));
+	for (s = 1; s <= MT_NUM_SQN && rc == 0; s++) {
+		for (i = 0; i != 2 && rc == 0; i++) {
+			w = &ipsec_mt_workers[(s + i) % nb_workers];
+			w->mb[w->num] = setup_test_string_tunneled(
+				ts_params->mbuf_pool, null_plain_data,
+				DATA_64_BYTES, INBOUND_SPI, s);
+			if (w->mb[w->num] == NULL)
+				rc = TEST_FAILED;
+			else
+				w->sqn[w->num++] = s;
+		}
+	}
+
+	if (rc == 0) {
+		for (i = 0; i != nb_workers; i++)
+			rte_eal_remote_launch(ipsec_mt_inb_worker,
+				&ipsec_mt_workers[i], lcore_id[i]);
+		for (i = 0; i != nb_workers; i++)
+			rte_eal_wait_lcore(lcore_id[i]);
+
+		memset(hits, 0, sizeof(hits));
+		nb_acc = 0;
+		bytes = 0;
+		for (i = 0; i != nb_workers; i++) {
+			w = &ipsec_mt_workers[i];
+			for (s = 0; s != w->nb_acc; s++)
+				hits[w->acc[s]]++;
+			nb_acc += w->nb_acc;
+			bytes += w->bytes;
+		}
+
+		for (s = 1; s <= MT_NUM_SQN && rc == 0; s++) {
+			if (hits[s] != 1) {
+				RTE_LOG(ERR, USER1,
+					"sqn %u accepted %u times\n",
+					s, hits[s]);
+				rc = TEST_FAILED;
+			}
+		}
+
+		if (rc == 0 && nb_acc != MT_NUM_SQN) {
+			RTE_LOG(ERR, USER1, "%u packets accepted, expected %u\n",
+				nb_acc, MT_NUM_SQN);
+			rc = TEST_FAILED;
+		}
+
+		if (rc == 0) {
+			rte_ipsec_sa_stats_get(ut_params->ss[0].sa, &stats);
+			if (stats.count != nb_acc || stats.bytes != bytes) {
+				RTE_LOG(ERR, USER1,
+					"SA stats %" PRIu64 " packets %" PRIu64
+					" bytes, expected %u packets %" PRIu64
+					" bytes\n", stats.count, stats.bytes,
+					nb_acc, bytes);
+				rc = TEST_FAILED;
+			}
+		}
+	}
+
+	for (i = 0; i != nb_workers; i++) {
+		w = &ipsec_mt_workers[i];
+		rte_pktmbuf_free_bulk(w->mb, w->num);
+	}
+
+	destroy_sa(0);
+	return rc;
+}
+
+static int
+test_ipsec_inline_crypto_inb_mt_null_null_wrapper(void)
+{
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+
+	ut_params->ipsec_xform.spi = INBOUND_SPI;
+	ut_params->ipsec_xform.direction = RTE_SECURITY_IPSEC_SA_DIR_INGRESS;
+	ut_params->ipsec_xform.proto = RTE_SECURITY_IPSEC_SA_PROTO_ESP;
+	ut_params->ipsec_xform.mode = RTE_SECURITY_IPSEC_SA_MODE_TUNNEL;
+	ut_params->ipsec_xform.tunnel.type = RTE_SECURITY_IPSEC_TUNNEL_IPV4;
+	ut_params->ipsec_xform.options.esn = ESN_DISABLED;
+
+	return test_ipsec_inline_crypto_inb_mt_null_null();
+}
+
 static struct unit_test_suite ipsec_testsuite  = {
 	.suite_name = "IPsec NULL Unit Test Suite",
 	.setup = testsuite_setup,
@@ -2599,12 +2787,16 @@ static struct unit_test_suite ipsec_testsuite  = {
 			test_ipsec_replay_inb_outside_null_null_wrapper),
 		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
 			test_ipsec_replay_inb_repeat_null_null_wrapper),
+		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
+			test_ipsec_replay_inb_repeat_high_null_null_wrapper),
 		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
 			test_ipsec_replay_inb_inside_burst_null_null_wrapper),
 		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
 			test_ipsec_crypto_inb_burst_2sa_null_null_wrapper),
 		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
 			test_ipsec_crypto_inb_burst_2sa_4grp_null_null_wrapper),
+		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
+			test_ipsec_inline_crypto_inb_mt_null_null_wrapper),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
@@ -1744,6 +1744,132 @@ test_roundrobin_rx_burst_on_multiple_members(void)
 	return remove_members_and_stop_bonding_device();
 }
 
+/* Empty polls after which a member is idle, and idle member polling period */
+#define TEST_RX_IDLE_POLLS (8)
+
+static int
+test_roundrobin_rx_idle_member_skip_disabled(void)
+{
+	struct rte_mbuf *gen_pkt_burst[MAX_PKT_BURST] = { NULL };
+	struct rte_mbuf *rx_pkt_burst[MAX_PKT_BURST] = { NULL };
+	int i, nb_rx, burst_size = 20;
+
+	/* Initialize bonding device with 4 members in round robin mode */
+	TEST_ASSERT_SUCCESS(initialize_bonding_device_with_members(
+			BONDING_MODE_ROUND_ROBIN, 0, 4, 1),
+			"Failed to initialize bonding device with members");
+
+	TEST_ASSERT_EQUAL(rte_eth_bond_rx_idle_skip_get(
+			test_params->bonding_port_id), 0,
+			"Idle member skipping is not disabled by default");
+
+	/* Make all members look idle */
+	for (i = 0; i < 2 * TEST_RX_IDLE_POLLS; i++)
+		TEST_ASSERT_EQUAL(rte_eth_rx_burst(test_params->bonding_port_id,
+				0, rx_pkt_burst, MAX_PKT_BURST), 0,
+				"Unexpected packets received");
+
+	TEST_ASSERT_EQUAL(generate_test_burst(
+			gen_pkt_burst, burst_size, 0, 1, 0, 0, 0), burst_size,
+			"burst generation failed");
+	virtual_ethdev_add_mbufs_to_rx_queue(test_params->member_port_ids[3],
+			gen_pkt_burst, burst_size);
+
+	/* Every member is polled on each burst */
+	nb_rx = rte_eth_rx_burst(test_params->bonding_port_id, 0, rx_pkt_burst,
+			MAX_PKT_BURST);
+	TEST_ASSERT_EQUAL(nb_rx, burst_size,
+			"round-robin rx burst failed (%d != %d)", nb_rx, burst_size);
+
+	for (i = 0; i < nb_rx; i++)
+		rte_pktmbuf_free(rx_pkt_burst[i]);
+
+	/* Clean up and remove members from bonding device */
+	return remove_members_and_stop_bonding_device();
+}
+
+static int
+test_roundrobin_rx_idle_member_wake_up(void)
+{
+	struct rte_mbuf *gen_pkt_burst[MAX_PKT_BURST] = { NULL };
+	struct rte_mbuf *rx_pkt_burst[MAX_PKT_BURST] = { NULL };
+	int i, nb_rx, burst_size = 20;
+
+	/* Initialize bonding device with 4 members and idle member skipping */
+	TEST_ASSERT_SUCCESS(configure_ethdev(test_params->bonding_port_id, 0, 0),
+			"Failed to configure bonding port (%d)",
+			test_params->bonding_port_id);
+	while (test_params->bonding_member_count < 4)
+		TEST_ASSERT_SUCCESS(test_add_member_to_bonding_device(),
+				"Failed to add member to bonding port (%d)",
+				test_params->bonding_port_id);
+	TEST_ASSERT_SUCCESS(rte_eth_bond_mode_set(test_params->bonding_port_id,
+			BONDING_MODE_ROUND_ROBIN),
+			"Failed to set round robin mode on port (%d)",
+			test_params->bonding_port_id);
+	TEST_ASSERT_SUCCESS(rte_eth_bond_rx_idle_skip_set(
+			test_params->bonding_port_id, 1),
+			"Failed to enable idle member skipping");
+	TEST_ASSERT_EQUAL(rte_eth_bond_rx_idle_skip_get(
+			test_params->bonding_port_id), 1,
+			"Idle member skipping is not enabled");
+	TEST_ASSERT_SUCCESS(rte_eth_dev_start(test_params->bonding_port_id),
+			"Failed to start bonding port (%d)",
+			test_params->bonding_port_id);
+	enable_bonding_members();
+
+	TEST_ASSERT_FAIL(rte_eth_bond_rx_idle_skip_set(
+			test_params->bonding_port_id, 0),
+			"Idle member skipping changed while started");
+
+	/* Make all members idle */
+	for (i = 0; i < TEST_RX_IDLE_POLLS; i++)
+		TEST_ASSERT_EQUAL(rte_eth_rx_burst(test_params->bonding_port_id,
+				0, rx_pkt_burst, MAX_PKT_BURST), 0,
+				"Unexpected packets received");
+
+	TEST_ASSERT_EQUAL(generate_test_burst(
+			gen_pkt_burst, burst_size, 0, 1, 0, 0, 0), burst_size,
+			"burst generation failed");
+	virtual_ethdev_add_mbufs_to_rx_queue(test_params->member_port_ids[1],
+			gen_pkt_burst, burst_size);
+
+	/* The idle member is skipped, then polled within one period */
+	nb_rx = rte_eth_rx_burst(test_params->bonding_port_id, 0, rx_pkt_burst,
+			MAX_PKT_BURST);
+	TEST_ASSERT_EQUAL(nb_rx, 0, "Idle member was not skipped");
+	for (i = 1; i < TEST_RX_IDLE_POLLS && nb_rx == 0; i++)
+		nb_rx = rte_eth_rx_burst(test_params->bonding_port_id, 0,
+				rx_pkt_burst, MAX_PKT_BURST);
+	TEST_ASSERT_EQUAL(nb_rx, burst_size,
+			"Idle member not polled within %d bursts (%d != %d)",
+			TEST_RX_IDLE_POLLS, nb_rx, burst_size);
+	for (i = 0; i < nb_rx; i++)
+		rte_pktmbuf_free(rx_pkt_burst[i]);
+
+	/* The member is no longer idle and is polled on the next burst */
+	TEST_ASSERT_EQUAL(generate_test_burst(
+			gen_pkt_burst, burst_size, 0, 1, 0, 0, 0), burst_size,
+			"burst generation failed");
+	virtual_ethdev_add_mbufs_to_rx_queue(test_params->member_port_ids[1],
+			gen_pkt_burst, burst_size);
+	nb_rx = rte_eth_rx_burst(test_params->bonding_port_id, 0, rx_pkt_burst,
+			MAX_PKT_BURST);
+	TEST_ASSERT_EQUAL(nb_rx, burst_size,
+			"Woken up member not polled (%d != %d)", nb_rx, burst_size);
+	for (i = 0; i < nb_rx; i++)
+		rte_pktmbuf_free(rx_pkt_burst[i]);
+
+	/* Clean up and remove members from bonding device */
+	TEST_ASSERT_SUCCESS(remove_members_and_stop_bonding_device(),
+			"Failed to remove members");
+	TEST_ASSERT_SUCCESS(rte_eth_bond_rx_idle_skip_set(
+			test_params->bonding_port_id, 0),
+			"Failed to disable idle member skipping");
+
+	return 0;
+}
+
 static int
 test_roundrobin_verify_mac_assignment(void)
 {
@@ -2695,6 +2821,15 @@ test_balance_xmit_policy_configuration(void)
 			BALANCE_XMIT_POLICY_LAYER34,
 			"balance xmit policy not as expected.");
 
+
+	TEST_ASSERT_SUCCESS(rte_eth_bond_xmit_policy_set(
+			test_params->bonding_port_id, BALANCE_XMIT_POLICY_FLOWLET),
+			"Failed to set balance xmit policy.");
+
+	TEST_ASSERT_EQUAL(rte_eth_bond_xmit_policy_get(test_params->bonding_port_id),
+			BALANCE_XMIT_POLICY_FLOWLET,
+			"balance xmit policy not as expected.");
+
 	/* Invalid port id */
 	TEST_ASSERT_FAIL(rte_eth_bond_xmit_policy_get(INVALID_PORT_ID),
 			"Expected call to failed as invalid port specified.");
@@ -3025,6 +3160,87 @@ test_balance_l34_tx_burst_ipv6_toggle_udp_port(void)
 	return balance_l34_tx_burst(0, 0, 0, 0, 1);
 }
 
+#define TEST_BALANCE_FLOWLET_BURST_SIZE_1	(20)
+#define TEST_BALANCE_FLOWLET_BURST_SIZE_2	(10)
+
+static int
+test_balance_flowlet_tx_burst(void)
+{
+	struct rte_mbuf *pkts_burst[TEST_BALANCE_FLOWLET_BURST_SIZE_1 +
+			TEST_BALANCE_FLOWLET_BURST_SIZE_2];
+	struct rte_eth_stats port_stats;
+	int nb_tx;
+
+	TEST_ASSERT_SUCCESS(initialize_bonding_device_with_members(
+			BONDING_MODE_BALANCE, 0, 2, 1),
+			"Failed to initialize_bonding_device_with_members.");
+
+	TEST_ASSERT_SUCCESS(rte_eth_bond_xmit_policy_set(
+			test_params->bonding_port_id, BALANCE_XMIT_POLICY_FLOWLET),
+			"Failed to set balance xmit policy.");
+
+	/* A burst of a first flow followed by a second flow */
+	TEST_ASSERT_EQUAL(generate_test_burst(pkts_burst,
+			TEST_BALANCE_FLOWLET_BURST_SIZE_1, 0, 1, 0, 0, 0),
+			TEST_BALANCE_FLOWLET_BURST_SIZE_1, "failed to generate burst");
+	TEST_ASSERT_EQUAL(generate_test_burst(
+			&pkts_burst[TEST_BALANCE_FLOWLET_BURST_SIZE_1],
+			TEST_BALANCE_FLOWLET_BURST_SIZE_2, 0, 1, 0, 1, 0),
+			TEST_BALANCE_FLOWLET_BURST_SIZE_2, "failed to generate burst");
+
+	/*
+	 * The first flow stays on a single member, the second one starts
+	 * a flowlet which goes to the other, less loaded, member.
+	 */
+	nb_tx = rte_eth_tx_burst(test_params->bonding_port_id, 0, pkts_burst,
+			TEST_BALANCE_FLOWLET_BURST_SIZE_1 +
+			TEST_BALANCE_FLOWLET_BURST_SIZE_2);
+	TEST_ASSERT_EQUAL(nb_tx, TEST_BALANCE_FLOWLET_BURST_SIZE_1 +
+			TEST_BALANCE_FLOWLET_BURST_SIZE_2, "tx burst failed");
+
+	rte_eth_stats_get(test_params->member_port_ids[0], &port_stats);
+	TEST_ASSERT_EQUAL(port_stats.opackets,
+			(uint64_t)TEST_BALANCE_FLOWLET_BURST_SIZE_1,
+			"Member Port (%d) opackets value (%u) not as expected (%d)",
+			test_params->member_port_ids[0],
+			(unsigned int)port_stats.opackets,
+			TEST_BALANCE_FLOWLET_BURST_SIZE_1);
+
+	rte_eth_stats_get(test_params->member_port_ids[1], &port_stats);
+	TEST_ASSERT_EQUAL(port_stats.opackets,
+			(uint64_t)TEST_BALANCE_FLOWLET_BURST_SIZE_2,
+			"Member Port (%d) opackets value (%u) not as expected (%d)",
+			test_params->member_port_ids[1],
+			(unsigned int)port_stats.opackets,
+			TEST_BALANCE_FLOWLET_BURST_SIZE_2);
+
+	/*
+	 * After an idle gap, the first flow starts a new flowlet
+	 * and moves to the least loaded member.
+	 */
+	rte_delay_ms(10);
+
+	TEST_ASSERT_EQUAL(generate_test_burst(pkts_burst,
+			TEST_BALANCE_FLOWLET_BURST_SIZE_2, 0, 1, 0, 0, 0),
+			TEST_BALANCE_FLOWLET_BURST_SIZE_2, "failed to generate burst");
+
+	nb_tx = rte_eth_tx_burst(test_params->bonding_port_id, 0, pkts_burst,
+			TEST_BALANCE_FLOWLET_BURST_SIZE_2);
+	TEST_ASSERT_EQUAL(nb_tx, TEST_BALANCE_FLOWLET_BURST_SIZE_2,
+			"tx burst failed");
+
+	rte_eth_stats_get(test_params->member_port_ids[1], &port_stats);
+	TEST_ASSERT_EQUAL(port_stats.opackets,
+			(uint64_t)2 * TEST_BALANCE_FLOWLET_BURST_SIZE_2,
+			"Member Port (%d) opackets value (%u) not as expected (%d)",
+			test_params->member_port_ids[1],
+			(unsigned int)port_stats.opackets,
+			2 * TEST_BALANCE_FLOWLET_BURST_SIZE_2);
+
+	/* Clean up and remove members from bonding device */
+	return remove_members_and_stop_bonding_device();
+}
+
 #define TEST_BAL_MEMBER_TX_FAIL_MEMBER_COUNT			(2)
 #define TEST_BAL_MEMBER_TX_FAIL_BURST_SIZE_1			(40)
 #define TEST_BAL_MEMBER_TX_FAIL_BURST_SIZE_2			(20)
@@ -5164,6 +5380,8 @@ static struct unit_test_suite link_bonding_test_suite  = {
 		TEST_CASE(test_roundrobin_tx_burst_member_tx_fail),
 		TEST_CASE(test_roundrobin_rx_burst_on_single_member),
 		TEST_CASE(test_roundrobin_rx_burst_on_multiple_members),
+		TEST_CASE(test_roundrobin_rx_idle_member_skip_disabled),
+		TEST_CASE(test_roundrobin_rx_idle_member_wake_up),
 		TEST_CASE(test_roundrobin_verify_promiscuous_enable_disable),
 		TEST_CASE(test_roundrobin_verify_mac_assignment),
 		TEST_CASE(test_roundrobin_verify_member_link_status_change_behaviour),
@@ -5186,6 +5404,7 @@ static struct unit_test_suite link_bonding_test_suite  = {
 		TEST_CASE(test_balance_l34_tx_burst_ipv6_toggle_ip_addr),
 		TEST_CASE(test_balance_l34_tx_burst_vlan_ipv6_toggle_ip_addr),
 		TEST_CASE(test_balance_l34_tx_burst_ipv6_toggle_udp_port),
+		TEST_CASE(test_balance_flowlet_tx_burst),
 		TEST_CASE(test_balance_tx_burst_member_tx_fail),
 		TEST_CASE(test_balance_rx_burst),
 		TEST_CASE(test_balance_verify_promiscuous_enable_disable),
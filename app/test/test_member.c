@@ -30,6 +30,7 @@ struct rte_member_setsum *setsum_ht;
 struct rte_member_setsum *setsum_cache;
 struct rte_member_setsum *setsum_vbf;
 struct rte_member_setsum *setsum_sketch;
+struct rte_member_setsum *setsum_cuckoo;
 
 /* 5-tuple key type */
 struct __rte_packed_begin flow_key {
@@ -692,6 +693,125 @@ test_member_loadfactor(void)
 	return 0;
 }
 
+/* Keys added to the cuckoo filter, the others are used as negative keys. */
+#define CUCKOO_NUM_KEYS (MAX_ENTRIES * 9 / 10)
+
+static int
+cuckoo_lookup_bulk_all(unsigned int start, unsigned int end,
+		unsigned int *num_matches)
+{
+	const void *key_array[RTE_MEMBER_LOOKUP_BULK_MAX];
+	member_set_t set_ids[RTE_MEMBER_LOOKUP_BULK_MAX];
+	unsigned int i, j, n;
+	int ret;
+
+	*num_matches = 0;
+	/* vary the burst size to cover the vector and the scalar paths */
+	for (i = start, n = 1; i < end; i += n, n = n % 63 + 1) {
+		n = RTE_MIN(n, end - i);
+		for (j = 0; j < n; j++)
+			key_array[j] = &generated_keys[i + j];
+		ret = rte_member_lookup_bulk(setsum_cuckoo, key_array, n,
+				set_ids);
+		if (ret < 0)
+			return -1;
+		*num_matches += ret;
+		for (j = 0; j < n; j++) {
+			if (set_ids[j] != RTE_MEMBER_NO_MATCH && set_ids[j] != 1)
+				return -1;
+			ret -= set_ids[j] != RTE_MEMBER_NO_MATCH;
+		}
+		/* returned count must match the set ids */
+		if (ret != 0)
+			return -1;
+	}
+	return 0;
+}
+
+/*
+ * Sequence of operations for cuckoo filter
+ *
+ *  - add keys, no false negative with single and bulk lookup
+ *  - lookup keys not added, false positive rate is low
+ *  - delete half of the keys, the other half is still found
+ *  - reset, then add keys until the filter is full
+ */
+static int
+test_member_cuckoo(void)
+{
+	unsigned int i, num_matches, added_keys;
+	member_set_t set_id;
+	int ret;
+
+	params.key_len = KEY_SIZE;
+	params.num_keys = MAX_ENTRIES;
+	params.name = "test_member_cuckoo";
+	params.type = RTE_MEMBER_TYPE_CUCKOO;
+	setsum_cuckoo = rte_member_create(&params);
+	if (setsum_cuckoo == NULL) {
+		printf("Creation of cuckoo filter setsum fail\n");
+		return -1;
+	}
+
+	TEST_ASSERT(rte_member_add(setsum_cuckoo, &generated_keys[0], 2) ==
+			-EINVAL, "cuckoo filter accepts only set id 1");
+
+	for (i = 0; i < CUCKOO_NUM_KEYS; i++) {
+		ret = rte_member_add(setsum_cuckoo, &generated_keys[i], 1);
+		TEST_ASSERT(ret >= 0, "cuckoo filter insert error");
+	}
+
+	for (i = 0; i < CUCKOO_NUM_KEYS; i++) {
+		ret = rte_member_lookup(setsum_cuckoo, &generated_keys[i],
+				&set_id);
+		TEST_ASSERT(ret == 1 && set_id == 1,
+				"cuckoo filter single lookup error");
+	}
+
+	TEST_ASSERT(cuckoo_lookup_bulk_all(0, CUCKOO_NUM_KEYS,
+			&num_matches) == 0, "cuckoo filter bulk lookup error");
+	TEST_ASSERT(num_matches == CUCKOO_NUM_KEYS,
+			"cuckoo filter bulk lookup false negative");
+
+	TEST_ASSERT(cuckoo_lookup_bulk_all(CUCKOO_NUM_KEYS, MAX_ENTRIES,
+			&num_matches) == 0, "cuckoo filter bulk lookup error");
+	printf("Cuckoo filter false positive rate = %.3f%% (%u/%u)\n",
+		(double)num_matches / (MAX_ENTRIES - CUCKOO_NUM_KEYS) * 100,
+		num_matches, MAX_ENTRIES - CUCKOO_NUM_KEYS);
+	TEST_ASSERT(num_matches < (MAX_ENTRIES - CUCKOO_NUM_KEYS) / 100,
+			"cuckoo filter false positive rate too high");
+
+	for (i = 0; i < CUCKOO_NUM_KEYS; i += 2) {
+		ret = rte_member_delete(setsum_cuckoo, &generated_keys[i], 1);
+		TEST_ASSERT(ret == 0, "cuckoo filter key deletion error");
+	}
+	for (i = 1; i < CUCKOO_NUM_KEYS; i += 2) {
+		ret = rte_member_lookup(setsum_cuckoo, &generated_keys[i],
+				&set_id);
+		TEST_ASSERT(ret == 1 && set_id == 1,
+				"cuckoo filter lookup error after deletion");
+	}
+
+	rte_member_reset(setsum_cuckoo);
+	TEST_ASSERT(cuckoo_lookup_bulk_all(0, MAX_ENTRIES,
+			&num_matches) == 0, "cuckoo filter bulk lookup error");
+	TEST_ASSERT(num_matches == 0, "cuckoo filter reset error");
+
+	/* Add random entries until key cannot be added */
+	ret = 0;
+	for (added_keys = 0; ret >= 0 && added_keys < MAX_ENTRIES;
+			added_keys++)
+		ret = rte_member_add(setsum_cuckoo, &generated_keys[added_keys],
+				1);
+	printf("Keys inserted in cuckoo filter = %.2f%% (%u/%u)\n",
+		(double)added_keys / params.num_keys * 100,
+		added_keys, params.num_keys);
+
+	rte_member_free(setsum_cuckoo);
+	setsum_cuckoo = NULL;
+	return 0;
+}
+
 static void
 perform_free(void)
 {
@@ -986,6 +1106,12 @@ test_member(void)
 		return -1;
 	}
 
+	if (test_member_cuckoo() < 0) {
+		rte_member_free(setsum_cuckoo);
+		perform_free();
+		return -1;
+	}
+
 	if (test_member_sketch() < 0) {
 		perform_free();
 		return -1;
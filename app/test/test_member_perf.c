@@ -51,6 +51,7 @@ enum sstype {
 	HT = 0,
 	CACHE,
 	VBF,
+	CUCKOO,
 	SKETCH,
 	SKETCH_BOUNDED,
 	SKETCH_BYTE,
@@ -168,6 +169,7 @@ setup_keys_and_data(struct member_perf_params *params, unsigned int cycle,
 
 		data[HT][i] = data[CACHE][i] = (rte_rand() & 0x7FFE) + 1;
 		data[VBF][i] = rte_rand() % VBF_SET_CNT + 1;
+		data[CUCKOO][i] = 1;
 	}
 
 	/* Remove duplicates from the keys array */
@@ -242,6 +244,12 @@ setup_keys_and_data(struct member_perf_params *params, unsigned int cycle,
 	if (params->setsum[VBF] == NULL)
 		fprintf(stderr, "VBF create fail\n");
 
+	member_params.name = "test_member_cuckoo";
+	member_params.type = RTE_MEMBER_TYPE_CUCKOO;
+	params->setsum[CUCKOO] = rte_member_create(&member_params);
+	if (params->setsum[CUCKOO] == NULL)
+		fprintf(stderr, "CUCKOO create fail\n");
+
 	member_params.name = "test_member_sketch";
 	member_params.key_len = params->key_size;
 	member_params.type = RTE_MEMBER_TYPE_SKETCH;
@@ -571,6 +571,233 @@ test_stats_reset_for_port(void)
 	return TEST_SUCCESS;
 }
 
+static int
+test_ring_link_port_setup(uint16_t port)
+{
+	struct rte_eth_conf null_conf;
+
+	memset(&null_conf, 0, sizeof(struct rte_eth_conf));
+
+	if (rte_eth_dev_configure(port, 1, 1, &null_conf) < 0) {
+		printf("Configure failed for port %u\n", port);
+		return -1;
+	}
+
+	if (rte_eth_tx_queue_setup(port, 0, RING_SIZE, SOCKET0, NULL) < 0) {
+		printf("TX queue setup failed port %u\n", port);
+		return -1;
+	}
+
+	if (rte_eth_rx_queue_setup(port, 0, RING_SIZE, SOCKET0, NULL, mp) < 0) {
+		printf("RX queue setup failed port %u\n", port);
+		return -1;
+	}
+
+	if (rte_eth_dev_start(port) < 0) {
+		printf("Error starting port %u\n", port);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+test_ring_link_send(uint16_t tx_port, uint16_t rx_port)
+{
+	struct rte_mbuf *tx_bufs[RING_SIZE / 2];
+	struct rte_mbuf *rx_bufs[RING_SIZE];
+	struct rte_eth_stats stats;
+	int i, nb_rx;
+
+	if (rte_pktmbuf_alloc_bulk(mp, tx_bufs, RING_SIZE / 2) != 0) {
+		printf("Failed to allocate mbufs\n");
+		return -1;
+	}
+	for (i = 0; i < RING_SIZE / 2; i++)
+		rte_pktmbuf_append(tx_bufs[i], 64);
+
+	rte_eth_stats_reset(tx_port);
+	rte_eth_stats_reset(rx_port);
+
+	if (rte_eth_tx_burst(tx_port, 0, tx_bufs, RING_SIZE / 2) != RING_SIZE / 2) {
+		printf("Failed to transmit packet burst port %u\n", tx_port);
+		rte_pktmbuf_free_bulk(tx_bufs, RING_SIZE / 2);
+		return -1;
+	}
+
+	/* the packets are not looped back to the sender */
+	if (rte_eth_rx_queue_count(tx_port, 0) != 0 ||
+			rte_eth_rx_queue_count(rx_port, 0) != RING_SIZE / 2) {
+		printf("Error: packets are not queued to port %u\n", rx_port);
+		return -1;
+	}
+
+	nb_rx = rte_eth_rx_burst(rx_port, 0, rx_bufs, RING_SIZE);
+	if (nb_rx != RING_SIZE / 2) {
+		printf("Failed to receive packet burst on port %u\n", rx_port);
+		rte_pktmbuf_free_bulk(rx_bufs, nb_rx);
+		return -1;
+	}
+
+	for (i = 0; i < RING_SIZE / 2; i++)
+		if (rx_bufs[i] != tx_bufs[i] || rx_bufs[i]->port != rx_port) {
+			printf("Error: received data does not match that transmitted\n");
+			rte_pktmbuf_free_bulk(rx_bufs, nb_rx);
+			return -1;
+		}
+	rte_pktmbuf_free_bulk(rx_bufs, nb_rx);
+
+	rte_eth_stats_get(tx_port, &stats);
+	if (stats.opackets != RING_SIZE / 2 || stats.obytes != 64 * RING_SIZE / 2 ||
+			stats.ipackets != 0 || stats.oerrors != 0) {
+		printf("Error: port %u stats are not as expected\n", tx_port);
+		return -1;
+	}
+
+	rte_eth_stats_get(rx_port, &stats);
+	if (stats.ipackets != RING_SIZE / 2 || stats.ibytes != 64 * RING_SIZE / 2 ||
+			stats.opackets != 0) {
+		printf("Error: port %u stats are not as expected\n", rx_port);
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Size of the links tested for backpressure, RING_SIZE / 2 */
+#define LINK_RING_SIZE 128
+
+static int
+test_ring_link_backpressure(uint16_t tx_port, uint16_t rx_port)
+{
+	struct rte_mbuf *bufs[LINK_RING_SIZE];
+	int nb_rx;
+
+	if (rte_eth_tx_descriptor_status(tx_port, 0, 0) != RTE_ETH_TX_DESC_DONE ||
+			rte_eth_tx_descriptor_status(tx_port, 0, LINK_RING_SIZE - 1) !=
+				RTE_ETH_TX_DESC_DONE ||
+			rte_eth_rx_descriptor_status(rx_port, 0, 0) !=
+				RTE_ETH_RX_DESC_AVAIL) {
+		printf("Error: descriptor status of empty link is not as expected\n");
+		return -1;
+	}
+
+	if (rte_pktmbuf_alloc_bulk(mp, bufs, LINK_RING_SIZE) != 0) {
+		printf("Failed to allocate mbufs\n");
+		return -1;
+	}
+
+	if (rte_eth_tx_burst(tx_port, 0, bufs, LINK_RING_SIZE / 2) !=
+			LINK_RING_SIZE / 2) {
+		printf("Failed to transmit packet burst port %u\n", tx_port);
+		rte_pktmbuf_free_bulk(bufs, LINK_RING_SIZE);
+		return -1;
+	}
+
+	/* half of the ring is still free */
+	if (rte_eth_tx_descriptor_status(tx_port, 0, LINK_RING_SIZE / 2 - 1) !=
+				RTE_ETH_TX_DESC_DONE ||
+			rte_eth_tx_descriptor_status(tx_port, 0, LINK_RING_SIZE / 2) !=
+				RTE_ETH_TX_DESC_FULL) {
+		printf("Error: Tx descriptor status of half full link is not as expected\n");
+		rte_pktmbuf_free_bulk(&bufs[LINK_RING_SIZE / 2], LINK_RING_SIZE / 2);
+		goto drain;
+	}
+
+	if (rte_eth_tx_burst(tx_port, 0, &bufs[LINK_RING_SIZE / 2],
+			LINK_RING_SIZE / 2) != LINK_RING_SIZE / 2) {
+		printf("Failed to fill the link of port %u\n", tx_port);
+		rte_pktmbuf_free_bulk(&bufs[LINK_RING_SIZE / 2], LINK_RING_SIZE / 2);
+		goto drain;
+	}
+
+	if (rte_eth_tx_descriptor_status(tx_port, 0, 0) != RTE_ETH_TX_DESC_FULL ||
+			rte_eth_rx_descriptor_status(rx_port, 0, LINK_RING_SIZE - 1) !=
+				RTE_ETH_RX_DESC_DONE) {
+		printf("Error: descriptor status of full link is not as expected\n");
+		goto drain;
+	}
+
+	nb_rx = rte_eth_rx_burst(rx_port, 0, bufs, LINK_RING_SIZE);
+	rte_pktmbuf_free_bulk(bufs, nb_rx);
+	if (nb_rx != LINK_RING_SIZE) {
+		printf("Failed to receive packet burst on port %u\n", rx_port);
+		return -1;
+	}
+
+	return 0;
+
+drain:
+	nb_rx = rte_eth_rx_burst(rx_port, 0, bufs, LINK_RING_SIZE);
+	rte_pktmbuf_free_bulk(bufs, nb_rx);
+	return -1;
+}
+
+static int
+test_ring_link(const char *args, bool backpressure)
+{
+	uint16_t port0 = RTE_MAX_ETHPORTS, port1 = RTE_MAX_ETHPORTS;
+	int ret = TEST_FAILED;
+
+	printf("Testing ring link with %s\n", args);
+
+	if (rte_vdev_init("net_ring_link0", args) != 0 ||
+			rte_vdev_init("net_ring_link1", args) != 0) {
+		printf("Failed to create ring link ports\n");
+		goto out;
+	}
+
+	/* a link connects two ports only */
+	if (rte_vdev_init("net_ring_link2", args) == 0) {
+		printf("Error: a third port was attached to the link\n");
+		rte_vdev_uninit("net_ring_link2");
+		goto out;
+	}
+
+	if (rte_eth_dev_get_port_by_name("net_ring_link0", &port0) != 0 ||
+			rte_eth_dev_get_port_by_name("net_ring_link1", &port1) != 0)
+		goto out;
+
+	if (test_ring_link_port_setup(port0) != 0 ||
+			test_ring_link_port_setup(port1) != 0)
+		goto out;
+
+	if (test_ring_link_send(port0, port1) != 0 ||
+			test_ring_link_send(port1, port0) != 0)
+		goto out;
+
+	if (backpressure && (test_ring_link_backpressure(port0, port1) != 0 ||
+			test_ring_link_backpressure(port1, port0) != 0))
+		goto out;
+
+	ret = TEST_SUCCESS;
+out:
+	if (port0 != RTE_MAX_ETHPORTS)
+		rte_eth_dev_stop(port0);
+	if (port1 != RTE_MAX_ETHPORTS)
+		rte_eth_dev_stop(port1);
+	rte_vdev_uninit("net_ring_link0");
+	rte_vdev_uninit("net_ring_link1");
+
+	return ret;
+}
+
+static int
+test_pmd_ring_link(void)
+{
+	TEST_ASSERT(test_ring_link("link=ring_link", false) == TEST_SUCCESS,
+			"test ring link failed");
+	TEST_ASSERT(test_ring_link("link=ring_clink,compress=1", false) == TEST_SUCCESS,
+			"test ring link with compressed pointers failed");
+	TEST_ASSERT(test_ring_link("link=ring_blink,size=" RTE_STR(LINK_RING_SIZE),
+			true) == TEST_SUCCESS, "test ring link backpressure failed");
+	TEST_ASSERT(rte_vdev_init("net_ring_link0",
+			"link=ring_link_name_of_24_chr") != 0,
+			"ring link with a too long name was created");
+
+	return TEST_SUCCESS;
+}
+
 static struct
 unit_test_suite test_pmd_ring_suite  = {
 	.setup = test_pmd_ringcreate_setup,
@@ -583,6 +810,7 @@ unit_test_suite test_pmd_ring_suite  = {
 		TEST_CASE(test_stats_reset_for_port),
 		TEST_CASE(test_pmd_ring_pair_create_attach),
 		TEST_CASE(test_command_line_ring_port),
+		TEST_CASE(test_pmd_ring_link),
 		TEST_CASES_END()
 	}
 };
@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <rte_bus_vdev.h>
+#include <rte_regexdev.h>
+
+static int
+test_regexdev_selftest_impl(const char *pmd, const char *opts)
+{
+	int dev_id;
+	int ret;
+
+	dev_id = rte_regexdev_get_dev_id(pmd);
+	if (dev_id < 0) {
+		if (rte_vdev_init(pmd, opts) != 0)
+			return TEST_SKIPPED;
+		dev_id = rte_regexdev_get_dev_id(pmd);
+		if (dev_id < 0)
+			return TEST_FAILED;
+	}
+
+	ret = rte_regexdev_selftest(dev_id);
+
+	rte_vdev_uninit(pmd);
+
+	return ret == 0 ? TEST_SUCCESS : TEST_FAILED;
+}
+
+static int
+test_regexdev_selftest_sw(void)
+{
+	return test_regexdev_selftest_impl("regex_sw", "");
+}
+
+REGISTER_FAST_TEST(regexdev_selftest_sw, true, true, test_regexdev_selftest_sw);
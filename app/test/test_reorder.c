@@ -329,6 +329,108 @@ test_reorder_drain(void)
 	return ret;
 }
 
+static int
+test_reorder_insert_bulk(void)
+{
+#define BULK_NUM_BUFS 64u
+
+	struct rte_reorder_buffer *b = NULL;
+	struct rte_mempool *p = test_params->p;
+	const unsigned int size = 32;
+	struct rte_mbuf *bufs[BULK_NUM_BUFS];
+	struct rte_mbuf *robufs[BULK_NUM_BUFS];
+	int ret = 0;
+	unsigned int i, cnt;
+
+	memset(bufs, 0, sizeof(bufs));
+	memset(robufs, 0, sizeof(robufs));
+
+	b = rte_reorder_create("test_insert_bulk", rte_socket_id(), size);
+	TEST_ASSERT_NOT_NULL(b, "Failed to create reorder buffer");
+
+	for (i = 0; i < BULK_NUM_BUFS; i++) {
+		bufs[i] = rte_pktmbuf_alloc(p);
+		TEST_ASSERT_NOT_NULL(bufs[i], "Packet allocation failed\n");
+		/* swap sequence numbers of each pair of packets */
+		*rte_reorder_seqn(bufs[i]) = i ^ 1;
+	}
+
+	ret = rte_reorder_min_seqn_set(b, 0);
+	if (ret != 0) {
+		printf("%s:%d: failed to set minimum sequence number\n",
+				__func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+
+	/* packets 2 to 31 fit in the window, packets 0 and 1 are missing */
+	cnt = rte_reorder_insert_bulk(b, &bufs[2], size - 2);
+	if (cnt != size - 2) {
+		printf("%s:%d:%u: number of expected packets not inserted\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+	for (i = 2; i < size; i++)
+		bufs[i] = NULL;
+
+	cnt = rte_reorder_drain(b, robufs, BULK_NUM_BUFS);
+	if (cnt != 0) {
+		printf("%s:%d:%u: drained packets out of order\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+
+	/* packets 0 and 1 fill the gap, the whole window is drained at once */
+	cnt = rte_reorder_insert_bulk(b, &bufs[0], 2);
+	if (cnt != 2) {
+		printf("%s:%d: failed to insert packets\n", __func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	bufs[0] = NULL;
+	bufs[1] = NULL;
+
+	cnt = rte_reorder_drain(b, robufs, BULK_NUM_BUFS);
+	if (cnt != size) {
+		printf("%s:%d:%u: number of expected packets not drained\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+	for (i = 0; i < cnt; i++) {
+		if (*rte_reorder_seqn(robufs[i]) != i) {
+			printf("%s:%d: packet %u drained out of order\n",
+					__func__, __LINE__, i);
+			ret = -1;
+			goto exit;
+		}
+		rte_pktmbuf_free(robufs[i]);
+		robufs[i] = NULL;
+	}
+
+	/* packet far out of the window stops the bulk insertion */
+	*rte_reorder_seqn(bufs[size + 1]) = 4 * size;
+	cnt = rte_reorder_insert_bulk(b, &bufs[size], 2);
+	if (cnt != 1 || rte_errno != ERANGE) {
+		printf("%s:%d:%u: out of range packet inserted\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+	bufs[size] = NULL;
+
+	ret = 0;
+exit:
+	rte_reorder_free(b);
+	for (i = 0; i < BULK_NUM_BUFS; i++) {
+		rte_pktmbuf_free(bufs[i]);
+		rte_pktmbuf_free(robufs[i]);
+	}
+	return ret;
+}
+
 static void
 buffer_to_reorder_move(struct rte_mbuf **mbuf, struct rte_reorder_buffer *b)
 {
@@ -539,6 +641,7 @@ static struct unit_test_suite reorder_test_suite  = {
 		TEST_CASE(test_reorder_free),
 		TEST_CASE(test_reorder_insert),
 		TEST_CASE(test_reorder_drain),
+		TEST_CASE(test_reorder_insert_bulk),
 		TEST_CASE(test_reorder_drain_up_to_seqn),
 		TEST_CASE(test_reorder_set_seqn),
 		TEST_CASES_END()
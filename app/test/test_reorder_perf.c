@@ -0,0 +1,216 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_random.h>
+#include <rte_reorder.h>
+
+#define REORDER_PERF_SIZE 1024
+#define REORDER_PERF_NB_MBUFS (4 * REORDER_PERF_SIZE)
+#define REORDER_PERF_ITERATIONS 256
+#define REORDER_PERF_BURST 32
+
+static struct rte_mbuf *mbufs[REORDER_PERF_NB_MBUFS];
+static struct rte_mbuf *out[REORDER_PERF_NB_MBUFS];
+
+enum reorder_perf_mode {
+	REORDER_PERF_BASELINE, /* per-entry NULL checks, as before the bitmap */
+	REORDER_PERF_SINGLE,
+	REORDER_PERF_BULK,
+};
+
+static const char * const reorder_perf_mode_names[] = {
+	[REORDER_PERF_BASELINE] = "baseline",
+	[REORDER_PERF_SINGLE] = "single",
+	[REORDER_PERF_BULK] = "bulk",
+};
+
+/*
+ * Order buffer without bitmap, filled and drained one entry at a time
+ * like rte_reorder_insert() and rte_reorder_drain() did before the bitmap.
+ * The benchmark never overflows the window, so there is no ready buffer.
+ */
+static struct {
+	struct rte_mbuf *entries[REORDER_PERF_SIZE];
+	unsigned int head;
+	uint32_t min_seqn;
+} baseline;
+
+static int
+baseline_insert(struct rte_mbuf *mbuf)
+{
+	uint32_t offset = *rte_reorder_seqn(mbuf) - baseline.min_seqn;
+
+	if (offset >= REORDER_PERF_SIZE)
+		return -1;
+	baseline.entries[(baseline.head + offset) & (REORDER_PERF_SIZE - 1)] = mbuf;
+
+	return 0;
+}
+
+static unsigned int
+baseline_drain(struct rte_mbuf **drain, unsigned int max)
+{
+	unsigned int n = 0;
+
+	while (n < max && baseline.entries[baseline.head] != NULL) {
+		drain[n++] = baseline.entries[baseline.head];
+		baseline.entries[baseline.head] = NULL;
+		baseline.min_seqn++;
+		baseline.head = (baseline.head + 1) & (REORDER_PERF_SIZE - 1);
+	}
+
+	return n;
+}
+
+/*
+ * Shuffle mbufs within bursts of given size, like packets completed
+ * out of order by parallel workers or crypto devices.
+ */
+static void
+shuffle_mbufs(unsigned int spread)
+{
+	struct rte_mbuf *tmp;
+	unsigned int i, j;
+
+	for (i = 0; i < REORDER_PERF_NB_MBUFS; i++) {
+		j = (i & ~(spread - 1)) + rte_rand_max(spread);
+		tmp = mbufs[i];
+		mbufs[i] = mbufs[j];
+		mbufs[j] = tmp;
+	}
+}
+
+static int
+run_reorder_perf(struct rte_reorder_buffer *b, unsigned int spread,
+		enum reorder_perf_mode mode)
+{
+	unsigned int iter, i, n, drained;
+	uint32_t seqn = 0;
+	uint64_t start, cycles = 0;
+
+	rte_reorder_reset(b);
+	if (rte_reorder_min_seqn_set(b, seqn) != 0)
+		return -1;
+	memset(&baseline, 0, sizeof(baseline));
+	baseline.min_seqn = seqn;
+
+	for (iter = 0; iter < REORDER_PERF_ITERATIONS; iter++) {
+		/* number packets in order, then shuffle them */
+		for (i = 0; i < REORDER_PERF_NB_MBUFS; i++)
+			*rte_reorder_seqn(mbufs[i]) = seqn++;
+		shuffle_mbufs(spread);
+
+		drained = 0;
+		start = rte_rdtsc_precise();
+		for (i = 0; i < REORDER_PERF_NB_MBUFS; i += REORDER_PERF_BURST) {
+			switch (mode) {
+			case REORDER_PERF_BASELINE:
+				for (n = 0; n < REORDER_PERF_BURST; n++)
+					if (baseline_insert(mbufs[i + n]) != 0)
+						return -1;
+				drained += baseline_drain(&out[drained],
+						REORDER_PERF_NB_MBUFS - drained);
+				break;
+			case REORDER_PERF_SINGLE:
+				for (n = 0; n < REORDER_PERF_BURST; n++)
+					if (rte_reorder_insert(b, mbufs[i + n]) != 0)
+						return -1;
+				drained += rte_reorder_drain(b, &out[drained],
+						REORDER_PERF_NB_MBUFS - drained);
+				break;
+			case REORDER_PERF_BULK:
+				n = rte_reorder_insert_bulk(b, &mbufs[i],
+						REORDER_PERF_BURST);
+				if (n != REORDER_PERF_BURST)
+					return -1;
+				drained += rte_reorder_drain(b, &out[drained],
+						REORDER_PERF_NB_MBUFS - drained);
+				break;
+			}
+		}
+		cycles += rte_rdtsc_precise() - start;
+
+		if (drained != REORDER_PERF_NB_MBUFS) {
+			printf("Only %u packets drained out of %u\n",
+					drained, REORDER_PERF_NB_MBUFS);
+			return -1;
+		}
+		for (i = 1; i < drained; i++) {
+			if (*rte_reorder_seqn(out[i]) !=
+					*rte_reorder_seqn(out[i - 1]) + 1) {
+				printf("Packet %u drained out of order\n", i);
+				return -1;
+			}
+		}
+		/* keep the drained order for the next iteration */
+		memcpy(mbufs, out, sizeof(mbufs));
+	}
+
+	printf("%-12s %-10u %.2f\n", reorder_perf_mode_names[mode], spread,
+			(double)cycles / (REORDER_PERF_ITERATIONS *
+				REORDER_PERF_NB_MBUFS));
+
+	return 0;
+}
+
+static int
+test_reorder_perf(void)
+{
+	static const unsigned int spreads[] = {1, 8, 64, 512};
+	struct rte_reorder_buffer *b;
+	struct rte_mempool *p;
+	enum reorder_perf_mode mode;
+	unsigned int i;
+	int ret = TEST_SUCCESS;
+
+	p = rte_pktmbuf_pool_create("RO_PERF_POOL", REORDER_PERF_NB_MBUFS, 0,
+			0, RTE_MBUF_DEFAULT_BUF_SIZE, rte_socket_id());
+	if (p == NULL) {
+		printf("Error creating mempool\n");
+		return TEST_FAILED;
+	}
+
+	b = rte_reorder_create("RO_PERF", rte_socket_id(), REORDER_PERF_SIZE);
+	if (b == NULL) {
+		printf("Error creating reorder buffer\n");
+		rte_mempool_free(p);
+		return TEST_FAILED;
+	}
+
+	if (rte_pktmbuf_alloc_bulk(p, mbufs, REORDER_PERF_NB_MBUFS) != 0) {
+		printf("Error allocating mbufs\n");
+		rte_reorder_free(b);
+		rte_mempool_free(p);
+		return TEST_FAILED;
+	}
+
+	printf("\n%-12s %-10s %s\n", "Insert", "Spread", "Cycles/packet");
+	for (i = 0; i < RTE_DIM(spreads) && ret == TEST_SUCCESS; i++) {
+		for (mode = REORDER_PERF_BASELINE;
+				mode <= REORDER_PERF_BULK && ret == TEST_SUCCESS;
+				mode++) {
+			if (run_reorder_perf(b, spreads[i], mode) != 0)
+				ret = TEST_FAILED;
+		}
+	}
+
+	/* on error, some mbufs are still owned by the reorder buffer */
+	if (ret == TEST_SUCCESS)
+		rte_pktmbuf_free_bulk(mbufs, REORDER_PERF_NB_MBUFS);
+	rte_reorder_free(b);
+	rte_mempool_free(p);
+
+	return ret;
+}
+
+REGISTER_PERF_TEST(reorder_perf_autotest, test_reorder_perf);
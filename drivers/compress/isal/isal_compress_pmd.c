@@ -34,6 +34,10 @@ isal_comp_set_priv_xform_parameters(struct isal_priv_xform *priv_xform,
 	if (xform == NULL)
 		return -EINVAL;
 
+	priv_xform->dict = NULL;
+	priv_xform->dict_str = NULL;
+	priv_xform->dict_len = 0;
+
 	/* Set compression private xform variables */
 	if (xform->type == RTE_COMP_COMPRESS) {
 		/* Set private xform type - COMPRESS/DECOMPRESS */
@@ -230,6 +234,148 @@ isal_comp_set_priv_xform_parameters(struct isal_priv_xform *priv_xform,
 	return 0;
 }
 
+/* Hash a compression dictionary once, for the level of the private xform */
+static int
+isal_deflate_dict_process(struct isal_priv_xform *priv_xform,
+		const uint8_t *dict, uint32_t dict_len)
+{
+	struct isal_zstream *stream;
+	int ret;
+
+	if (priv_xform->dict_str == NULL) {
+		priv_xform->dict_str = rte_malloc(NULL,
+				sizeof(struct isal_dict), 0);
+		if (priv_xform->dict_str == NULL)
+			return -ENOMEM;
+	}
+
+	/* Only the level of the stream is used to hash the dictionary */
+	stream = rte_zmalloc(NULL, sizeof(*stream), 0);
+	if (stream == NULL)
+		return -ENOMEM;
+	stream->level = priv_xform->compress.level;
+
+	ret = isal_deflate_process_dict(stream, priv_xform->dict_str,
+			RTE_CAST_PTR(uint8_t *, dict), dict_len);
+	rte_free(stream);
+	if (ret != COMP_OK) {
+		ISAL_PMD_LOG(ERR, "Failed to process compression dictionary");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Set the preset dictionary of private xform, only its last window is kept */
+int
+isal_comp_set_priv_xform_dict(struct isal_priv_xform *priv_xform,
+		const uint8_t *dict, uint32_t dict_len)
+{
+	int ret;
+
+	if (dict_len > ISAL_DEF_HIST_SIZE) {
+		dict += dict_len - ISAL_DEF_HIST_SIZE;
+		dict_len = ISAL_DEF_HIST_SIZE;
+	}
+
+	priv_xform->dict_len = 0;
+	if (dict_len == 0)
+		return 0;
+
+	/* The compression dictionary is hashed here and only copied to the
+	 * stream of each operation by isal_deflate_reset_dict().
+	 */
+	if (priv_xform->type == RTE_COMP_COMPRESS) {
+		ret = isal_deflate_dict_process(priv_xform, dict, dict_len);
+		if (ret != 0)
+			return ret;
+		priv_xform->dict_len = dict_len;
+		return 0;
+	}
+
+	/* The window sized buffer is kept, as the dictionary may be set
+	 * again before each data stream.
+	 */
+	if (priv_xform->dict == NULL) {
+		priv_xform->dict = rte_malloc(NULL, ISAL_DEF_HIST_SIZE, 0);
+		if (priv_xform->dict == NULL)
+			return -ENOMEM;
+	}
+	memcpy(priv_xform->dict, dict, dict_len);
+	priv_xform->dict_len = dict_len;
+
+	return 0;
+}
+
+/* Initialize compression stream for new data */
+static int
+isal_deflate_stream_init(struct isal_zstream *stream,
+		struct isal_priv_xform *priv_xform)
+{
+	/* Required due to init clearing level_buf */
+	uint8_t *temp_level_buf = stream->level_buf;
+
+	/* Initialize compression stream */
+	isal_deflate_init(stream);
+
+	stream->level_buf = temp_level_buf;
+
+	/* Set Checksum flag */
+	stream->gzip_flag = priv_xform->compress.chksum;
+
+	stream->flush = NO_FLUSH;
+
+	/* set compression level & intermediate level buffer size */
+	stream->level = priv_xform->compress.level;
+	stream->level_buf_size = priv_xform->level_buffer_size;
+
+	/* Set op huffman code */
+	if (priv_xform->compress.deflate.huffman == RTE_COMP_HUFFMAN_FIXED)
+		isal_deflate_set_hufftables(stream, NULL,
+				IGZIP_HUFFTABLE_STATIC);
+	else if (priv_xform->compress.deflate.huffman ==
+			RTE_COMP_HUFFMAN_DEFAULT)
+		isal_deflate_set_hufftables(stream, NULL,
+			IGZIP_HUFFTABLE_DEFAULT);
+	/* Dynamically change the huffman code to suit the input data */
+	else if (priv_xform->compress.deflate.huffman ==
+			RTE_COMP_HUFFMAN_DYNAMIC)
+		isal_deflate_set_hufftables(stream, NULL,
+				IGZIP_HUFFTABLE_DEFAULT);
+
+	/* Preset dictionary, the history preceding the data */
+	if (priv_xform->dict_len != 0 &&
+			isal_deflate_reset_dict(stream,
+				priv_xform->dict_str) != COMP_OK) {
+		ISAL_PMD_LOG(ERR, "Failed to set compression dictionary");
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Initialize decompression state for new data */
+static int
+isal_inflate_state_init(struct inflate_state *state,
+		struct isal_priv_xform *priv_xform)
+{
+	/* Initialize decompression state */
+	isal_inflate_init(state);
+
+	/* Set Checksum flag */
+	state->crc_flag = priv_xform->decompress.chksum;
+
+	/* Preset dictionary, the history preceding the data */
+	if (priv_xform->dict_len != 0 &&
+			isal_inflate_set_dict(state, priv_xform->dict,
+				priv_xform->dict_len) != ISAL_DECOMP_OK) {
+		ISAL_PMD_LOG(ERR, "Failed to set decompression dictionary");
+		return -1;
+	}
+
+	return 0;
+}
+
 /* Compression using chained mbufs for input/output data */
 static int
 chained_mbuf_compression(struct rte_comp_op *op, struct isal_comp_qp *qp)
@@ -418,37 +564,11 @@ process_isal_deflate(struct rte_comp_op *op, struct isal_comp_qp *qp,
 	int ret = 0;
 	op->status = RTE_COMP_OP_STATUS_SUCCESS;
 
-	/* Required due to init clearing level_buf */
-	uint8_t *temp_level_buf = qp->stream->level_buf;
-
-	/* Initialize compression stream */
-	isal_deflate_init(qp->stream);
-
-	qp->stream->level_buf = temp_level_buf;
-
-	/* Set Checksum flag */
-	qp->stream->gzip_flag = priv_xform->compress.chksum;
-
 	/* Stateless operation, input will be consumed in one go */
-	qp->stream->flush = NO_FLUSH;
-
-	/* set compression level & intermediate level buffer size */
-	qp->stream->level = priv_xform->compress.level;
-	qp->stream->level_buf_size = priv_xform->level_buffer_size;
-
-	/* Set op huffman code */
-	if (priv_xform->compress.deflate.huffman == RTE_COMP_HUFFMAN_FIXED)
-		isal_deflate_set_hufftables(qp->stream, NULL,
-				IGZIP_HUFFTABLE_STATIC);
-	else if (priv_xform->compress.deflate.huffman ==
-			RTE_COMP_HUFFMAN_DEFAULT)
-		isal_deflate_set_hufftables(qp->stream, NULL,
-			IGZIP_HUFFTABLE_DEFAULT);
-	/* Dynamically change the huffman code to suit the input data */
-	else if (priv_xform->compress.deflate.huffman ==
-			RTE_COMP_HUFFMAN_DYNAMIC)
-		isal_deflate_set_hufftables(qp->stream, NULL,
-				IGZIP_HUFFTABLE_DEFAULT);
+	if (isal_deflate_stream_init(qp->stream, priv_xform) < 0) {
+		op->status = RTE_COMP_OP_STATUS_ERROR;
+		return -1;
+	}
 
 	if (op->m_src->pkt_len < (op->src.length + op->src.offset)) {
 		ISAL_PMD_LOG(ERR, "Input mbuf(s) not big enough.");
@@ -463,8 +583,9 @@ process_isal_deflate(struct rte_comp_op *op, struct isal_comp_qp *qp,
 		return -1;
 	}
 
-	/* Chained mbufs */
-	if (op->m_src->nb_segs > 1 || op->m_dst->nb_segs > 1) {
+	/* Chained mbufs, or a dictionary which the stateless API does not use */
+	if (op->m_src->nb_segs > 1 || op->m_dst->nb_segs > 1 ||
+			priv_xform->dict_len != 0) {
 		ret = chained_mbuf_compression(op, qp);
 		if (ret < 0)
 			return ret;
@@ -536,11 +657,10 @@ process_isal_inflate(struct rte_comp_op *op, struct isal_comp_qp *qp,
 
 	op->status = RTE_COMP_OP_STATUS_SUCCESS;
 
-	/* Initialize decompression state */
-	isal_inflate_init(qp->state);
-
-	/* Set Checksum flag */
-	qp->state->crc_flag = priv_xform->decompress.chksum;
+	if (isal_inflate_state_init(qp->state, priv_xform) < 0) {
+		op->status = RTE_COMP_OP_STATUS_ERROR;
+		return -1;
+	}
 
 	if (op->m_src->pkt_len < (op->src.length + op->src.offset)) {
 		ISAL_PMD_LOG(ERR, "Input mbuf(s) not big enough.");
@@ -555,8 +675,9 @@ process_isal_inflate(struct rte_comp_op *op, struct isal_comp_qp *qp,
 		return -1;
 	}
 
-	/* Chained mbufs */
-	if (op->m_src->nb_segs > 1 || op->m_dst->nb_segs > 1) {
+	/* Chained mbufs, or a dictionary which the stateless API does not use */
+	if (op->m_src->nb_segs > 1 || op->m_dst->nb_segs > 1 ||
+			priv_xform->dict_len != 0) {
 		ret = chained_mbuf_decompression(op, qp);
 		if (ret !=  0)
 			return ret;
@@ -609,6 +730,223 @@ process_isal_inflate(struct rte_comp_op *op, struct isal_comp_qp *qp,
 	return ret;
 }
 
+/* Find the segment holding an offset of a chained mbuf */
+static struct rte_mbuf *
+isal_mbuf_seek(struct rte_mbuf *m, uint32_t *offset)
+{
+	while (*offset >= m->data_len && m->next != NULL) {
+		*offset -= m->data_len;
+		m = m->next;
+	}
+
+	return m;
+}
+
+/* Stateful Compression Function */
+static int
+process_isal_deflate_stateful(struct rte_comp_op *op,
+		struct isal_comp_stream *stream)
+{
+	struct isal_zstream *zstream = stream->stream;
+	uint32_t src_off = op->src.offset, dst_off = op->dst.offset;
+	uint32_t src_left = op->src.length, len;
+	struct rte_mbuf *src, *dst;
+	uint64_t total_in, total_out;
+	uint16_t flush;
+	int ret, last;
+
+	if (stream->restart) {
+		if (isal_deflate_stream_init(zstream, &stream->priv_xform) < 0) {
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			return -1;
+		}
+		stream->restart = 0;
+	}
+
+	switch (op->flush_flag) {
+	case RTE_COMP_FLUSH_NONE:
+	case RTE_COMP_FLUSH_FINAL:
+		flush = NO_FLUSH;
+		break;
+	case RTE_COMP_FLUSH_SYNC:
+		flush = SYNC_FLUSH;
+		break;
+	case RTE_COMP_FLUSH_FULL:
+		flush = FULL_FLUSH;
+		break;
+	default:
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		return -1;
+	}
+
+	src = isal_mbuf_seek(op->m_src, &src_off);
+	dst = isal_mbuf_seek(op->m_dst, &dst_off);
+	zstream->avail_out = dst->data_len - dst_off;
+	zstream->next_out = rte_pktmbuf_mtod_offset(dst, uint8_t *, dst_off);
+
+	total_in = zstream->total_in;
+	total_out = zstream->total_out;
+
+	/* The flush and the end of stream only apply to the last segment */
+	for (;;) {
+		if (src_off == src->data_len && src_left != 0) {
+			src = src->next;
+			src_off = 0;
+		}
+		len = RTE_MIN(src->data_len - src_off, src_left);
+		last = len == src_left;
+		zstream->avail_in = len;
+		zstream->next_in = rte_pktmbuf_mtod_offset(src, uint8_t *,
+				src_off);
+		zstream->flush = last ? flush : NO_FLUSH;
+		zstream->end_of_stream = last &&
+				op->flush_flag == RTE_COMP_FLUSH_FINAL;
+
+		ret = isal_deflate(zstream);
+		if (ret != COMP_OK) {
+			ISAL_PMD_LOG(ERR, "Compression operation failed");
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			stream->restart = 1;
+			return ret;
+		}
+
+		src_off += len - zstream->avail_in;
+		src_left -= len - zstream->avail_in;
+
+		if (zstream->avail_out == 0) {
+			if (dst->next == NULL)
+				break;
+			dst = dst->next;
+			zstream->avail_out = dst->data_len;
+			zstream->next_out = rte_pktmbuf_mtod(dst, uint8_t *);
+		} else if (last) {
+			break;
+		}
+	}
+
+	op->consumed = zstream->total_in - total_in;
+	op->produced = zstream->total_out - total_out;
+
+	/* The history is kept until the end of the data stream */
+	if (zstream->end_of_stream) {
+		if (zstream->internal_state.state == ZSTATE_END) {
+			op->status = RTE_COMP_OP_STATUS_SUCCESS;
+			stream->restart = 1;
+		} else {
+			op->status =
+				RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE;
+		}
+	} else if (src_left != 0 || zstream->avail_out == 0) {
+		op->status = RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE;
+	} else {
+		op->status = RTE_COMP_OP_STATUS_SUCCESS;
+	}
+
+	return 0;
+}
+
+/* Stateful Decompression Function */
+static int
+process_isal_inflate_stateful(struct rte_comp_op *op,
+		struct isal_comp_stream *stream)
+{
+	struct inflate_state *state = stream->state;
+	uint32_t src_off = op->src.offset, dst_off = op->dst.offset;
+	uint32_t src_left = op->src.length, len;
+	struct rte_mbuf *src, *dst;
+	uint32_t total_out;
+	int ret;
+
+	if (stream->restart) {
+		if (isal_inflate_state_init(state, &stream->priv_xform) < 0) {
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			return -1;
+		}
+		stream->restart = 0;
+	}
+
+	src = isal_mbuf_seek(op->m_src, &src_off);
+	dst = isal_mbuf_seek(op->m_dst, &dst_off);
+	state->avail_out = dst->data_len - dst_off;
+	state->next_out = rte_pktmbuf_mtod_offset(dst, uint8_t *, dst_off);
+
+	total_out = state->total_out;
+
+	for (;;) {
+		if (src_off == src->data_len && src_left != 0) {
+			src = src->next;
+			src_off = 0;
+		}
+		len = RTE_MIN(src->data_len - src_off, src_left);
+		state->avail_in = len;
+		state->next_in = rte_pktmbuf_mtod_offset(src, uint8_t *,
+				src_off);
+
+		ret = isal_inflate(state);
+		if (ret < 0) {
+			ISAL_PMD_LOG(ERR, "Decompression operation failed");
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			stream->restart = 1;
+			return ret;
+		}
+
+		src_off += len - state->avail_in;
+		src_left -= len - state->avail_in;
+
+		if (state->block_state == ISAL_BLOCK_FINISH)
+			break;
+		if (state->avail_out == 0) {
+			if (dst->next == NULL)
+				break;
+			dst = dst->next;
+			state->avail_out = dst->data_len;
+			state->next_out = rte_pktmbuf_mtod(dst, uint8_t *);
+		} else if (src_left == 0) {
+			break;
+		}
+	}
+
+	op->consumed = op->src.length - src_left;
+	op->produced = state->total_out - total_out;
+
+	/* The history is kept until the end of the data stream */
+	if (state->block_state == ISAL_BLOCK_FINISH) {
+		op->status = RTE_COMP_OP_STATUS_SUCCESS;
+		op->output_chksum = state->crc;
+		stream->restart = 1;
+	} else if (state->avail_out == 0) {
+		op->status = RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE;
+	} else {
+		op->status = RTE_COMP_OP_STATUS_SUCCESS;
+	}
+
+	return 0;
+}
+
+/* Process stateful compression/decompression operation */
+static int
+process_stateful_op(struct rte_comp_op *op, struct isal_comp_stream *stream)
+{
+	if (unlikely(stream == NULL ||
+			op->m_src->pkt_len < op->src.offset + op->src.length ||
+			op->dst.offset >= op->m_dst->pkt_len)) {
+		ISAL_PMD_LOG(ERR, "Invalid stream or buffers for stateful"
+				" operation");
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		return -EINVAL;
+	}
+
+	switch (stream->priv_xform.type) {
+	case RTE_COMP_COMPRESS:
+		return process_isal_deflate_stateful(op, stream);
+	case RTE_COMP_DECOMPRESS:
+		return process_isal_inflate_stateful(op, stream);
+	default:
+		ISAL_PMD_LOG(ERR, "Operation Not Supported");
+		return -ENOTSUP;
+	}
+}
+
 /* Process compression/decompression operation */
 static int
 process_op(struct isal_comp_qp *qp, struct rte_comp_op *op,
@@ -639,15 +977,14 @@ isal_comp_pmd_enqueue_burst(void *queue_pair, struct rte_comp_op **ops,
 	int16_t num_enq = RTE_MIN(qp->num_free_elements, nb_ops);
 
 	for (i = 0; i < num_enq; i++) {
-		if (unlikely(ops[i]->op_type != RTE_COMP_OP_STATELESS)) {
-			ops[i]->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
-			ISAL_PMD_LOG(ERR, "Stateful operation not Supported");
-			qp->qp_stats.enqueue_err_count++;
-			continue;
-		}
-		retval = process_op(qp, ops[i], ops[i]->private_xform);
+		if (ops[i]->op_type == RTE_COMP_OP_STATEFUL)
+			retval = process_stateful_op(ops[i], ops[i]->stream);
+		else
+			retval = process_op(qp, ops[i], ops[i]->private_xform);
 		if (unlikely(retval < 0) ||
-				ops[i]->status != RTE_COMP_OP_STATUS_SUCCESS) {
+				(ops[i]->status != RTE_COMP_OP_STATUS_SUCCESS &&
+				ops[i]->status !=
+				RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE)) {
 			qp->qp_stats.enqueue_err_count++;
 		}
 	}
@@ -20,7 +20,10 @@ static const struct rte_compressdev_capabilities isal_pmd_capabilities[] = {
 					RTE_COMP_FF_HUFFMAN_FIXED |
 					RTE_COMP_FF_HUFFMAN_DYNAMIC |
 					RTE_COMP_FF_CRC32_CHECKSUM |
-					RTE_COMP_FF_ADLER32_CHECKSUM,
+					RTE_COMP_FF_ADLER32_CHECKSUM |
+					RTE_COMP_FF_STATEFUL_COMPRESSION |
+					RTE_COMP_FF_STATEFUL_DECOMPRESSION |
+					RTE_COMP_FF_PRESET_DICT,
 		.window_size = {
 			.min = 15,
 			.max = 15,
@@ -348,12 +351,129 @@ isal_comp_pmd_priv_xform_free(struct rte_compressdev *dev, void *priv_xform)
 
 	/* Zero out the whole structure */
 	if (priv_xform) {
+		rte_free(((struct isal_priv_xform *)priv_xform)->dict);
+		rte_free(((struct isal_priv_xform *)priv_xform)->dict_str);
 		memset(priv_xform, 0, sizeof(struct isal_priv_xform));
 		rte_mempool_put(internals->priv_xform_mp, priv_xform);
 	}
 	return 0;
 }
 
+/** Set the preset dictionary of a private xform */
+static int
+isal_comp_pmd_priv_xform_dict_set(__rte_unused struct rte_compressdev *dev,
+		void *priv_xform, const uint8_t *dict, uint32_t dict_len)
+{
+	return isal_comp_set_priv_xform_dict(priv_xform, dict, dict_len);
+}
+
+/** Free stream data */
+static int
+isal_comp_pmd_stream_free(__rte_unused struct rte_compressdev *dev,
+		void *stream)
+{
+	struct isal_comp_stream *isal_stream = stream;
+
+	if (isal_stream == NULL)
+		return -EINVAL;
+
+	if (isal_stream->stream)
+		rte_free(isal_stream->stream->level_buf);
+	rte_free(isal_stream->stream);
+	rte_free(isal_stream->state);
+	rte_free(isal_stream->priv_xform.dict);
+	rte_free(isal_stream->priv_xform.dict_str);
+	rte_free(isal_stream);
+
+	return 0;
+}
+
+/** Set up stream data, keeping the history between stateful operations */
+static int
+isal_comp_pmd_stream_create(struct rte_compressdev *dev,
+		const struct rte_comp_xform *xform, void **stream)
+{
+	struct isal_comp_stream *isal_stream;
+	int socket_id = dev->data->socket_id;
+	int ret;
+
+	if (xform == NULL) {
+		ISAL_PMD_LOG(ERR, "Invalid Xform struct");
+		return -EINVAL;
+	}
+
+	/* The checksum of a compressed stream would be mixed with its data */
+	if (xform->type == RTE_COMP_COMPRESS &&
+			xform->compress.chksum != RTE_COMP_CHECKSUM_NONE) {
+		ISAL_PMD_LOG(ERR, "Checksum not supported by stateful"
+				" compression");
+		return -ENOTSUP;
+	}
+
+	isal_stream = rte_zmalloc_socket("Isa-l compression stream data",
+			sizeof(*isal_stream), RTE_CACHE_LINE_SIZE, socket_id);
+	if (isal_stream == NULL) {
+		ISAL_PMD_LOG(ERR, "Failed to allocate stream memory");
+		return -ENOMEM;
+	}
+
+	ret = isal_comp_set_priv_xform_parameters(&isal_stream->priv_xform,
+			xform);
+	if (ret != 0) {
+		ISAL_PMD_LOG(ERR, "Failed to configure stream parameters");
+		rte_free(isal_stream);
+		return ret;
+	}
+
+	if (xform->type == RTE_COMP_COMPRESS) {
+		isal_stream->stream = rte_zmalloc_socket(
+				"Isa-l compression stream",
+				sizeof(struct isal_zstream),
+				RTE_CACHE_LINE_SIZE, socket_id);
+		if (isal_stream->stream == NULL)
+			goto stream_create_cleanup;
+		isal_stream->stream->level_buf = rte_zmalloc_socket(
+				"Isa-l compression lev_buf",
+				ISAL_DEF_LVL3_DEFAULT, RTE_CACHE_LINE_SIZE,
+				socket_id);
+		if (isal_stream->stream->level_buf == NULL)
+			goto stream_create_cleanup;
+	} else {
+		isal_stream->state = rte_zmalloc_socket(
+				"Isa-l decompression state",
+				sizeof(struct inflate_state),
+				RTE_CACHE_LINE_SIZE, socket_id);
+		if (isal_stream->state == NULL)
+			goto stream_create_cleanup;
+	}
+
+	isal_stream->restart = 1;
+	*stream = isal_stream;
+
+	return 0;
+
+stream_create_cleanup:
+	ISAL_PMD_LOG(ERR, "Failed to allocate stream memory");
+	isal_comp_pmd_stream_free(dev, isal_stream);
+	return -ENOMEM;
+}
+
+/** Set the preset dictionary of a stream, used from its next start */
+static int
+isal_comp_pmd_stream_dict_set(__rte_unused struct rte_compressdev *dev,
+		void *stream, const uint8_t *dict, uint32_t dict_len)
+{
+	struct isal_comp_stream *isal_stream = stream;
+	int ret;
+
+	ret = isal_comp_set_priv_xform_dict(&isal_stream->priv_xform,
+			dict, dict_len);
+	if (ret == 0)
+		isal_stream->restart = 1;
+
+	return ret;
+}
+
 struct rte_compressdev_ops isal_pmd_ops = {
 		.dev_configure		= isal_comp_pmd_config,
 		.dev_start		= isal_comp_pmd_start,
@@ -370,6 +490,12 @@ struct rte_compressdev_ops isal_pmd_ops = {
 
 		.private_xform_create	= isal_comp_pmd_priv_xform_create,
 		.private_xform_free	= isal_comp_pmd_priv_xform_free,
+
+		.stream_create		= isal_comp_pmd_stream_create,
+		.stream_free		= isal_comp_pmd_stream_free,
+
+		.private_xform_dict_set	= isal_comp_pmd_priv_xform_dict_set,
+		.stream_dict_set	= isal_comp_pmd_stream_dict_set,
 };
 
 struct rte_compressdev_ops *isal_compress_pmd_ops = &isal_pmd_ops;
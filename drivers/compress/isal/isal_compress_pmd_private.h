@@ -44,6 +44,24 @@ struct __rte_cache_aligned isal_priv_xform {
 		struct rte_comp_decompress_xform decompress;
 	};
 	uint32_t level_buffer_size;
+	/* Preset decompression dictionary, NULL if none */
+	uint8_t *dict;
+	/* Preset compression dictionary hashed for the level, NULL if none */
+	struct isal_dict *dict_str;
+	/* Preset dictionary length */
+	uint32_t dict_len;
+};
+
+/** ISA-L stream structure, keeping the state between stateful operations */
+struct __rte_cache_aligned isal_comp_stream {
+	/* Stream parameters and dictionary */
+	struct isal_priv_xform priv_xform;
+	/* Compression stream information */
+	struct isal_zstream *stream;
+	/* Decompression state information */
+	struct inflate_state *state;
+	/* Next operation starts a new data stream */
+	uint8_t restart;
 };
 
 /** Set and validate NULL comp private xform parameters */
@@ -51,6 +69,11 @@ extern int
 isal_comp_set_priv_xform_parameters(struct isal_priv_xform *priv_xform,
 			const struct rte_comp_xform *xform);
 
+/** Set the preset dictionary of a private xform */
+extern int
+isal_comp_set_priv_xform_dict(struct isal_priv_xform *priv_xform,
+			const uint8_t *dict, uint32_t dict_len);
+
 /** device specific operations function pointer structure */
 extern struct rte_compressdev_ops *isal_compress_pmd_ops;
 
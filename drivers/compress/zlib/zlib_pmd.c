@@ -15,29 +15,67 @@
 		(data = rte_pktmbuf_mtod(mbuf, uint8_t *)),	\
 		(len = rte_pktmbuf_data_len(mbuf)) : 0)
 
+/** Reset the stream for new data, preceded by its preset dictionary if any */
+int
+zlib_stream_reset(struct zlib_stream *stream)
+{
+	if (stream->reset(&stream->strm) != Z_OK)
+		return -1;
+
+	if (stream->dict_len != 0 && stream->set_dict(&stream->strm,
+			stream->dict, stream->dict_len) != Z_OK)
+		return -1;
+
+	return 0;
+}
+
 static void
-process_zlib_deflate(struct rte_comp_op *op, z_stream *strm)
+process_zlib_deflate(struct rte_comp_op *op, struct zlib_stream *stream)
 {
-	int ret, flush, fin_flush;
+	int ret = Z_OK, flush, fin_flush;
 	struct rte_mbuf *mbuf_src = op->m_src;
 	struct rte_mbuf *mbuf_dst = op->m_dst;
+	z_stream *strm = &stream->strm;
+	uLong total_in, total_out;
 
 	switch (op->flush_flag) {
+	case RTE_COMP_FLUSH_NONE:
+		fin_flush = Z_NO_FLUSH;
+		break;
+	case RTE_COMP_FLUSH_SYNC:
+		fin_flush = Z_SYNC_FLUSH;
+		break;
 	case RTE_COMP_FLUSH_FULL:
+		fin_flush = Z_FULL_FLUSH;
+		break;
 	case RTE_COMP_FLUSH_FINAL:
 		fin_flush = Z_FINISH;
 		break;
 	default:
-		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
-		ZLIB_PMD_ERR("Invalid flush value");
-		return;
+		fin_flush = -1;
+		break;
+	}
+
+	/* A stateless operation always completes the deflate stream */
+	if (op->op_type == RTE_COMP_OP_STATELESS) {
+		if (fin_flush == Z_FULL_FLUSH)
+			fin_flush = Z_FINISH;
+		else if (fin_flush != Z_FINISH)
+			fin_flush = -1;
 	}
 
-	if (unlikely(!strm)) {
+	if (fin_flush < 0) {
 		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
-		ZLIB_PMD_ERR("Invalid z_stream");
+		ZLIB_PMD_ERR("Invalid flush value");
 		return;
 	}
+
+	/* The stream counters include the data of the previous operations
+	 * of a stream, and the preset dictionary.
+	 */
+	total_in = strm->total_in;
+	total_out = strm->total_out;
+
 	/* Update z_stream with the inputs provided by application */
 	strm->next_in = rte_pktmbuf_mtod_offset(mbuf_src, uint8_t *,
 			op->src.offset);
@@ -56,8 +94,10 @@ process_zlib_deflate(struct rte_comp_op *op, z_stream *strm)
 
 	do {
 		/* Set flush value to Z_FINISH for last block */
-		if ((op->src.length - strm->total_in) <= strm->avail_in) {
-			strm->avail_in = (op->src.length - strm->total_in);
+		if ((op->src.length - (strm->total_in - total_in)) <=
+				strm->avail_in) {
+			strm->avail_in = op->src.length -
+					(strm->total_in - total_in);
 			flush = fin_flush;
 		}
 		do {
@@ -78,8 +118,12 @@ process_zlib_deflate(struct rte_comp_op *op, z_stream *strm)
 			COMPUTE_BUF(mbuf_dst, strm->next_out, strm->avail_out));
 
 		if (!strm->avail_out) {
-			/* there is no space for compressed output */
-			op->status = RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
+			/* there is no space for compressed output, a stream
+			 * keeps its state to continue with more space
+			 */
+			op->status = op->op_type == RTE_COMP_OP_STATEFUL ?
+				RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE :
+				RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
 			break;
 		}
 
@@ -92,31 +136,35 @@ process_zlib_deflate(struct rte_comp_op *op, z_stream *strm)
 	/* Update op stats */
 	switch (op->status) {
 	case RTE_COMP_OP_STATUS_SUCCESS:
-		op->consumed += strm->total_in;
+	case RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE:
+		op->consumed += strm->total_in - total_in;
 	/* Fall-through */
 	case RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED:
-		op->produced += strm->total_out;
+		op->produced += strm->total_out - total_out;
 		break;
 	default:
 		ZLIB_PMD_ERR("stats not updated for status:%d",
 				op->status);
 	}
 
-	deflateReset(strm);
+	/* A stream keeps its history until its end */
+	if (op->op_type == RTE_COMP_OP_STATELESS || ret == Z_STREAM_END ||
+			op->status == RTE_COMP_OP_STATUS_ERROR)
+		zlib_stream_reset(stream);
 }
 
 static void
-process_zlib_inflate(struct rte_comp_op *op, z_stream *strm)
+process_zlib_inflate(struct rte_comp_op *op, struct zlib_stream *stream)
 {
-	int ret, flush;
+	int ret = Z_OK, flush;
 	struct rte_mbuf *mbuf_src = op->m_src;
 	struct rte_mbuf *mbuf_dst = op->m_dst;
+	z_stream *strm = &stream->strm;
+	uLong total_in, total_out;
+
+	total_in = strm->total_in;
+	total_out = strm->total_out;
 
-	if (unlikely(!strm)) {
-		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
-		ZLIB_PMD_ERR("Invalid z_stream");
-		return;
-	}
 	strm->next_in = rte_pktmbuf_mtod_offset(mbuf_src, uint8_t *,
 			op->src.offset);
 
@@ -133,6 +181,11 @@ process_zlib_inflate(struct rte_comp_op *op, z_stream *strm)
 	op->status = RTE_COMP_OP_STATUS_SUCCESS;
 
 	do {
+		/* Do not read beyond the source data of the operation */
+		if ((op->src.length - (strm->total_in - total_in)) <=
+				strm->avail_in)
+			strm->avail_in = op->src.length -
+					(strm->total_in - total_in);
 		do {
 			ret = inflate(strm, flush);
 
@@ -165,8 +218,12 @@ process_zlib_inflate(struct rte_comp_op *op, z_stream *strm)
 			COMPUTE_BUF(mbuf_dst, strm->next_out, strm->avail_out));
 
 		if (!strm->avail_out) {
-			/* there is no more space for decompressed output */
-			op->status = RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
+			/* there is no more space for decompressed output,
+			 * a stream keeps its state to continue with more space
+			 */
+			op->status = op->op_type == RTE_COMP_OP_STATEFUL ?
+				RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE :
+				RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
 			break;
 		}
 	/* Read next input buffer to be processed, exit if compressed
@@ -178,17 +235,21 @@ process_zlib_inflate(struct rte_comp_op *op, z_stream *strm)
 	/* Update op stats */
 	switch (op->status) {
 	case RTE_COMP_OP_STATUS_SUCCESS:
-		op->consumed += strm->total_in;
+	case RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE:
+		op->consumed += strm->total_in - total_in;
 	/* Fall-through */
 	case RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED:
-		op->produced += strm->total_out;
+		op->produced += strm->total_out - total_out;
 		break;
 	default:
 		ZLIB_PMD_ERR("stats not produced for status:%d",
 				op->status);
 	}
 
-	inflateReset(strm);
+	/* A stream keeps its history until its end */
+	if (op->op_type == RTE_COMP_OP_STATELESS || ret == Z_STREAM_END ||
+			op->status == RTE_COMP_OP_STATUS_ERROR)
+		zlib_stream_reset(stream);
 }
 
 /** Process comp operation for mbuf */
@@ -198,16 +259,21 @@ process_zlib_op(struct zlib_qp *qp, struct rte_comp_op *op)
 	struct zlib_stream *stream;
 	struct zlib_priv_xform *private_xform;
 
-	if ((op->op_type == RTE_COMP_OP_STATEFUL) ||
+	if (op->op_type == RTE_COMP_OP_STATEFUL) {
+		stream = op->stream;
+	} else {
+		private_xform = (struct zlib_priv_xform *)op->private_xform;
+		stream = private_xform != NULL ? &private_xform->stream : NULL;
+	}
+
+	if (unlikely(stream == NULL) ||
 			(op->src.offset > rte_pktmbuf_data_len(op->m_src)) ||
 			(op->dst.offset > rte_pktmbuf_data_len(op->m_dst))) {
 		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
 		ZLIB_PMD_ERR("Invalid source or destination buffers or "
 			     "invalid Operation requested");
 	} else {
-		private_xform = (struct zlib_priv_xform *)op->private_xform;
-		stream = &private_xform->stream;
-		stream->comp(op, &stream->strm);
+		stream->comp(op, stream);
 	}
 	/* whatever is out of op, put it into completion queue with
 	 * its status
@@ -228,10 +294,15 @@ zlib_set_stream_parameters(const struct rte_comp_xform *xform,
 	strm->zfree = Z_NULL;
 	strm->opaque = Z_NULL;
 
+	stream->dict = NULL;
+	stream->dict_len = 0;
+
 	switch (xform->type) {
 	case RTE_COMP_COMPRESS:
 		stream->comp = process_zlib_deflate;
 		stream->free = deflateEnd;
+		stream->reset = deflateReset;
+		stream->set_dict = deflateSetDictionary;
 		/** Compression window bits */
 		switch (xform->compress.algo) {
 		case RTE_COMP_ALGO_DEFLATE:
@@ -292,6 +363,8 @@ zlib_set_stream_parameters(const struct rte_comp_xform *xform,
 	case RTE_COMP_DECOMPRESS:
 		stream->comp = process_zlib_inflate;
 		stream->free = inflateEnd;
+		stream->reset = inflateReset;
+		stream->set_dict = inflateSetDictionary;
 		/** window bits */
 		switch (xform->decompress.algo) {
 		case RTE_COMP_ALGO_DEFLATE:
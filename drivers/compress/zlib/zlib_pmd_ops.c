@@ -15,7 +15,10 @@ static const struct rte_compressdev_capabilities zlib_pmd_capabilities[] = {
 		.algo = RTE_COMP_ALGO_DEFLATE,
 		.comp_feature_flags = (RTE_COMP_FF_NONCOMPRESSED_BLOCKS |
 					RTE_COMP_FF_HUFFMAN_FIXED |
-					RTE_COMP_FF_HUFFMAN_DYNAMIC),
+					RTE_COMP_FF_HUFFMAN_DYNAMIC |
+					RTE_COMP_FF_STATEFUL_COMPRESSION |
+					RTE_COMP_FF_STATEFUL_DECOMPRESSION |
+					RTE_COMP_FF_PRESET_DICT),
 		.window_size = {
 			.min = 8,
 			.max = 15,
@@ -268,6 +271,7 @@ zlib_pmd_stream_free(__rte_unused struct rte_compressdev *dev,
 		return -EINVAL;
 
 	stream->free(&stream->strm);
+	rte_free(stream->dict);
 	/* Zero out the whole structure */
 	memset(stream, 0, sizeof(struct zlib_stream));
 	struct rte_mempool *mp = rte_mempool_from_obj(stream);
@@ -284,6 +288,51 @@ zlib_pmd_private_xform_free(struct rte_compressdev *dev,
 	return zlib_pmd_stream_free(dev, private_xform);
 }
 
+/** Set the preset dictionary of a stream, used from its next (re)start */
+static int
+zlib_pmd_stream_dict_set(__rte_unused struct rte_compressdev *dev,
+		void *zstream, const uint8_t *dict, uint32_t dict_len)
+{
+	struct zlib_stream *stream = (struct zlib_stream *)zstream;
+
+	if (!stream)
+		return -EINVAL;
+
+	/* Only the last window of the dictionary can be referenced */
+	if (dict_len > ZLIB_MAX_DICT_LEN) {
+		dict += dict_len - ZLIB_MAX_DICT_LEN;
+		dict_len = ZLIB_MAX_DICT_LEN;
+	}
+
+	/* The window sized buffer is kept, as the dictionary may be set
+	 * again before each data stream.
+	 */
+	if (dict_len != 0 && stream->dict == NULL) {
+		stream->dict = rte_malloc(NULL, ZLIB_MAX_DICT_LEN, 0);
+		if (stream->dict == NULL)
+			return -ENOMEM;
+	}
+
+	if (dict_len != 0)
+		memcpy(stream->dict, dict, dict_len);
+	stream->dict_len = dict_len;
+
+	if (zlib_stream_reset(stream) < 0) {
+		ZLIB_PMD_ERR("failed to set dictionary");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/** Set the preset dictionary of a private xform */
+static int
+zlib_pmd_private_xform_dict_set(struct rte_compressdev *dev,
+		void *private_xform, const uint8_t *dict, uint32_t dict_len)
+{
+	return zlib_pmd_stream_dict_set(dev, private_xform, dict, dict_len);
+}
+
 struct rte_compressdev_ops zlib_pmd_ops = {
 		.dev_configure		= zlib_pmd_config,
 		.dev_start		= zlib_pmd_start,
@@ -301,8 +350,11 @@ struct rte_compressdev_ops zlib_pmd_ops = {
 		.private_xform_create	= zlib_pmd_private_xform_create,
 		.private_xform_free	= zlib_pmd_private_xform_free,
 
-		.stream_create	= NULL,
-		.stream_free	= NULL
+		.stream_create		= zlib_pmd_stream_create,
+		.stream_free		= zlib_pmd_stream_free,
+
+		.private_xform_dict_set	= zlib_pmd_private_xform_dict_set,
+		.stream_dict_set	= zlib_pmd_stream_dict_set
 };
 
 struct rte_compressdev_ops *rte_zlib_pmd_ops = &zlib_pmd_ops;
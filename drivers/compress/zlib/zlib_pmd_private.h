@@ -14,6 +14,9 @@
 
 #define DEF_MEM_LEVEL			8
 
+#define ZLIB_MAX_DICT_LEN		(1 << 15)
+/**< Largest preset dictionary, as only a 32K window can be referenced */
+
 extern int zlib_logtype_driver;
 #define RTE_LOGTYPE_ZLIB_DRIVER zlib_logtype_driver
 #define ZLIB_PMD_LOG(level, ...) \
@@ -41,11 +44,18 @@ struct __rte_cache_aligned zlib_qp {
 	/**< Unique Queue Pair Name */
 };
 
+struct zlib_stream;
+
 /* Algorithm handler function prototype */
-typedef void (*comp_func_t)(struct rte_comp_op *op, z_stream *strm);
+typedef void (*comp_func_t)(struct rte_comp_op *op,
+		struct zlib_stream *stream);
 
 typedef int (*comp_free_t)(z_stream *strm);
 
+typedef int (*comp_reset_t)(z_stream *strm);
+
+typedef int (*comp_dict_t)(z_stream *strm, const Bytef *dict, uInt dict_len);
+
 /** ZLIB Stream structure */
 struct __rte_cache_aligned zlib_stream {
 	z_stream strm;
@@ -54,6 +64,14 @@ struct __rte_cache_aligned zlib_stream {
 	/**< Operation (compression/decompression) */
 	comp_free_t free;
 	/**< Free Operation (compression/decompression) */
+	comp_reset_t reset;
+	/**< Reset Operation (compression/decompression) */
+	comp_dict_t set_dict;
+	/**< Set dictionary Operation (compression/decompression) */
+	uint8_t *dict;
+	/**< Preset dictionary, NULL if none */
+	uint32_t dict_len;
+	/**< Preset dictionary length */
 };
 
 /** ZLIB private xform structure */
@@ -65,6 +83,9 @@ int
 zlib_set_stream_parameters(const struct rte_comp_xform *xform,
 		struct zlib_stream *stream);
 
+int
+zlib_stream_reset(struct zlib_stream *stream);
+
 /** Device specific operations function pointer structure */
 extern struct rte_compressdev_ops *rte_zlib_pmd_ops;
 
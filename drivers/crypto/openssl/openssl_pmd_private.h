@@ -107,6 +107,8 @@ struct __rte_cache_aligned openssl_session {
 
 	enum rte_crypto_aead_algorithm aead_algo;
 	/**< AEAD algorithm */
+	uint8_t aead_burst;
+	/**< AEAD operations of the session may be processed in bursts */
 
 	/** Cipher Parameters */
 	struct {
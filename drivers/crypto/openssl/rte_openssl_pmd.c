@@ -320,6 +320,14 @@ get_aead_algo(enum rte_crypto_aead_algorithm sess_algo, size_t keylen,
 				res = -EINVAL;
 			}
 			break;
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+		case RTE_CRYPTO_AEAD_CHACHA20_POLY1305:
+			if (keylen == 32)
+				*algo = EVP_chacha20_poly1305();
+			else
+				res = -EINVAL;
+			break;
+#endif
 		default:
 			res = -EINVAL;
 			break;
@@ -339,7 +347,7 @@ openssl_set_sess_aead_enc_param(struct openssl_session *sess,
 		EVP_CIPHER_CTX **ctx)
 {
 	int iv_type = 0;
-	unsigned int do_ccm;
+	unsigned int do_ccm = 0;
 
 	sess->cipher.direction = RTE_CRYPTO_CIPHER_OP_ENCRYPT;
 	sess->auth.operation = RTE_CRYPTO_AUTH_OP_GENERATE;
@@ -350,7 +358,6 @@ openssl_set_sess_aead_enc_param(struct openssl_session *sess,
 		iv_type = EVP_CTRL_GCM_SET_IVLEN;
 		if (tag_len != 16)
 			return -EINVAL;
-		do_ccm = 0;
 		break;
 	case RTE_CRYPTO_AEAD_AES_CCM:
 		iv_type = EVP_CTRL_CCM_SET_IVLEN;
@@ -359,6 +366,13 @@ openssl_set_sess_aead_enc_param(struct openssl_session *sess,
 			return -EINVAL;
 		do_ccm = 1;
 		break;
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+	case RTE_CRYPTO_AEAD_CHACHA20_POLY1305:
+		iv_type = EVP_CTRL_AEAD_SET_IVLEN;
+		if (tag_len != 16)
+			return -EINVAL;
+		break;
+#endif
 	default:
 		return -ENOTSUP;
 	}
@@ -419,6 +433,13 @@ openssl_set_sess_aead_dec_param(struct openssl_session *sess,
 			return -EINVAL;
 		do_ccm = 1;
 		break;
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+	case RTE_CRYPTO_AEAD_CHACHA20_POLY1305:
+		iv_type = EVP_CTRL_AEAD_SET_IVLEN;
+		if (tag_len != 16)
+			return -EINVAL;
+		break;
+#endif
 	default:
 		return -ENOTSUP;
 	}
@@ -789,6 +810,10 @@ openssl_set_session_aead_parameters(struct openssl_session *sess,
 	sess->auth.digest_length = xform->aead.digest_length;
 
 	sess->aead_algo = xform->aead.algo;
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+	sess->aead_burst = xform->aead.algo == RTE_CRYPTO_AEAD_AES_GCM ||
+			xform->aead.algo == RTE_CRYPTO_AEAD_CHACHA20_POLY1305;
+#endif
 	/* Select cipher direction */
 	if (xform->aead.op == RTE_CRYPTO_AEAD_OP_ENCRYPT)
 		return openssl_set_sess_aead_enc_param(sess, xform->aead.algo,
@@ -836,6 +861,7 @@ openssl_set_session_parameters(struct openssl_session *sess,
 
 	/* Default IV length = 0 */
 	sess->iv.length = 0;
+	sess->aead_burst = 0;
 
 	/* cipher_xform must be check before auth_xform */
 	if (cipher_xform) {
@@ -1796,7 +1822,7 @@ process_openssl_combined_op(struct openssl_qp *qp, struct rte_crypto_op *op,
 
 	if (sess->cipher.direction == RTE_CRYPTO_CIPHER_OP_ENCRYPT) {
 		if (sess->auth.algo == RTE_CRYPTO_AUTH_AES_GMAC ||
-				sess->aead_algo == RTE_CRYPTO_AEAD_AES_GCM)
+				sess->aead_algo != RTE_CRYPTO_AEAD_AES_CCM)
 			status = process_openssl_auth_encryption_gcm(
 					mbuf_src, offset, srclen,
 					aad, aadlen, iv,
@@ -1809,7 +1835,7 @@ process_openssl_combined_op(struct openssl_qp *qp, struct rte_crypto_op *op,
 
 	} else {
 		if (sess->auth.algo == RTE_CRYPTO_AUTH_AES_GMAC ||
-				sess->aead_algo == RTE_CRYPTO_AEAD_AES_GCM)
+				sess->aead_algo != RTE_CRYPTO_AEAD_AES_CCM)
 			status = process_openssl_auth_decryption_gcm(
 					mbuf_src, offset, srclen,
 					aad, aadlen, iv,
@@ -1831,6 +1857,106 @@ process_openssl_combined_op(struct openssl_qp *qp, struct rte_crypto_op *op,
 	}
 }
 
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+/** Process AES-GCM or ChaCha20-Poly1305 operation on contiguous buffers */
+static __rte_always_inline int
+process_openssl_aead_contig(EVP_CIPHER_CTX *ctx, int enc, uint8_t *src,
+		uint8_t *dst, int srclen, uint8_t *aad, int aadlen, uint8_t *iv,
+		uint8_t *tag)
+{
+	int len = 0;
+
+	if (!enc && EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, 16,
+			tag) <= 0)
+		return -EINVAL;
+
+	if (EVP_CipherInit_ex(ctx, NULL, NULL, NULL, iv, enc) <= 0)
+		return -EINVAL;
+
+	if (aadlen > 0)
+		if (EVP_CipherUpdate(ctx, NULL, &len, aad, aadlen) <= 0)
+			return -EINVAL;
+
+	if (srclen > 0)
+		if (EVP_CipherUpdate(ctx, dst, &len, src, srclen) <= 0)
+			return -EINVAL;
+
+	if (EVP_CipherFinal_ex(ctx, dst + srclen, &len) <= 0)
+		return enc ? -EINVAL : -EFAULT;
+
+	if (enc && EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, 16,
+			tag) <= 0)
+		return -EINVAL;
+
+	return 0;
+}
+
+/**
+ * Process a burst of AES-GCM or ChaCha20-Poly1305 operations sharing
+ * a session, with the cipher context of the queue pair looked up once.
+ * The processed operations are put in the ring in bulk.
+ *
+ * Return the number of operations enqueued in the ring.
+ */
+static uint16_t
+process_openssl_aead_burst(struct openssl_qp *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops, struct openssl_session *sess)
+{
+	int enc = sess->cipher.direction == RTE_CRYPTO_CIPHER_OP_ENCRYPT;
+	EVP_CIPHER_CTX *ctx = get_local_cipher_ctx(sess, qp);
+	struct rte_mbuf *msrc, *mdst;
+	struct rte_crypto_op *op;
+	uint8_t *src, *dst, *tag;
+	uint32_t offset;
+	int srclen, status;
+	uint16_t i;
+
+	/* do not process operations which could not be returned */
+	nb_ops = RTE_MIN((unsigned int)nb_ops,
+			rte_ring_free_count(qp->processed_ops));
+
+	for (i = 0; i < nb_ops; i++) {
+		op = ops[i];
+		msrc = op->sym->m_src;
+		mdst = op->sym->m_dst ? op->sym->m_dst : op->sym->m_src;
+
+		op->status = RTE_CRYPTO_OP_STATUS_NOT_PROCESSED;
+
+		if (unlikely(ctx == NULL || !rte_pktmbuf_is_contiguous(msrc) ||
+				!rte_pktmbuf_is_contiguous(mdst))) {
+			process_openssl_combined_op(qp, op, sess, msrc, mdst);
+		} else {
+			srclen = op->sym->aead.data.length;
+			offset = op->sym->aead.data.offset;
+			src = rte_pktmbuf_mtod_offset(msrc, uint8_t *, offset);
+			dst = rte_pktmbuf_mtod_offset(mdst, uint8_t *, offset);
+			tag = op->sym->aead.digest.data;
+			if (tag == NULL)
+				tag = dst + srclen;
+
+			status = process_openssl_aead_contig(ctx, enc, src, dst,
+					srclen, op->sym->aead.aad.data,
+					sess->auth.aad_length,
+					rte_crypto_op_ctod_offset(op, uint8_t *,
+						sess->iv.offset),
+					tag);
+			if (status == -EFAULT)
+				op->status = RTE_CRYPTO_OP_STATUS_AUTH_FAILED;
+			else if (status != 0)
+				op->status = RTE_CRYPTO_OP_STATUS_ERROR;
+		}
+
+		if (op->status == RTE_CRYPTO_OP_STATUS_ERROR)
+			break;
+		if (op->status == RTE_CRYPTO_OP_STATUS_NOT_PROCESSED)
+			op->status = RTE_CRYPTO_OP_STATUS_SUCCESS;
+	}
+
+	return rte_ring_enqueue_burst(qp->processed_ops, (void **)ops, i,
+			NULL);
+}
+#endif
+
 /** Process cipher operation */
 static void
 process_openssl_cipher_op(struct openssl_qp *qp, struct rte_crypto_op *op,
@@ -3562,12 +3688,41 @@ openssl_pmd_enqueue_burst(void *queue_pair, struct rte_crypto_op **ops,
 	void *sess;
 	struct openssl_qp *qp = queue_pair;
 	int i, retval;
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+	uint16_t n, nb_done;
+#endif
 
 	for (i = 0; i < nb_ops; i++) {
 		sess = get_session(qp, ops[i]);
 		if (unlikely(sess == NULL))
 			goto enqueue_err;
 
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+		/* Process the following AEAD operations of the same session
+		 * together.
+		 */
+		if (ops[i]->type == RTE_CRYPTO_OP_TYPE_SYMMETRIC &&
+				ops[i]->sess_type == RTE_CRYPTO_OP_WITH_SESSION &&
+				((struct openssl_session *)sess)->aead_burst) {
+			for (n = 1; i + n < nb_ops; n++)
+				if (ops[i + n]->type != RTE_CRYPTO_OP_TYPE_SYMMETRIC ||
+						ops[i + n]->sess_type !=
+						RTE_CRYPTO_OP_WITH_SESSION ||
+						ops[i + n]->sym->session !=
+						ops[i]->sym->session)
+					break;
+
+			nb_done = process_openssl_aead_burst(qp, &ops[i], n,
+					sess);
+			if (unlikely(nb_done < n)) {
+				i += nb_done;
+				goto enqueue_err;
+			}
+			i += n - 1;
+			continue;
+		}
+#endif
+
 		if (ops[i]->type == RTE_CRYPTO_OP_TYPE_SYMMETRIC)
 			retval = process_op(qp, ops[i],
 					(struct openssl_session *) sess);
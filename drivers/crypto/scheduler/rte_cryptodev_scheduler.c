@@ -537,6 +537,13 @@ rte_cryptodev_scheduler_mode_set(uint8_t scheduler_id,
 			return -1;
 		}
 		break;
+	case CDEV_SCHED_MODE_LATENCY_AWARE:
+		if (rte_cryptodev_scheduler_load_user_scheduler(scheduler_id,
+				crypto_scheduler_latency_aware) < 0) {
+			CR_SCHED_LOG(ERR, "Failed to load scheduler");
+			return -1;
+		}
+		break;
 	default:
 		CR_SCHED_LOG(ERR, "Not yet supported");
 		return -ENOTSUP;
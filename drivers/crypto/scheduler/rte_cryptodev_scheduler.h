@@ -40,6 +40,8 @@ extern "C" {
 #define SCHEDULER_MODE_NAME_FAIL_OVER		fail-over
 /** multi-core scheduling mode string */
 #define SCHEDULER_MODE_NAME_MULTI_CORE		multi-core
+/** Latency-aware scheduling mode string */
+#define SCHEDULER_MODE_NAME_LATENCY_AWARE	latency-aware
 
 /**
  * Crypto scheduler PMD operation modes
@@ -56,6 +58,8 @@ enum rte_cryptodev_scheduler_mode {
 	CDEV_SCHED_MODE_FAILOVER,
 	/** multi-core mode */
 	CDEV_SCHED_MODE_MULTICORE,
+	/** Latency-aware mode */
+	CDEV_SCHED_MODE_LATENCY_AWARE,
 
 	CDEV_SCHED_MODE_COUNT /**< number of modes */
 };
@@ -276,6 +280,8 @@ extern struct rte_cryptodev_scheduler *crypto_scheduler_pkt_size_based_distr;
 extern struct rte_cryptodev_scheduler *crypto_scheduler_failover;
 /** multi-core mode scheduler */
 extern struct rte_cryptodev_scheduler *crypto_scheduler_multicore;
+/** Latency-aware mode scheduler */
+extern struct rte_cryptodev_scheduler *crypto_scheduler_latency_aware;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,338 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <cryptodev_pmd.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+
+#include "rte_cryptodev_scheduler_operations.h"
+#include "scheduler_pmd_private.h"
+
+/* Number of enqueued bursts tracked per worker, must be a power of 2 */
+#define LA_NB_BURSTS		128
+#define LA_BURSTS_MASK		(LA_NB_BURSTS - 1)
+/* The per-op cost estimate moves by 1/2^LA_EWMA_SHIFT of each sample */
+#define LA_EWMA_SHIFT		3
+/* Decay of the estimate of an idle worker which is not selected */
+#define LA_IDLE_DECAY_SHIFT	4
+/* Per-op cost in microseconds assumed for a worker not sampled yet */
+#define LA_INIT_OP_US		1
+
+struct la_burst {
+	uint64_t tsc;
+	/* Ops of the burst not dequeued yet */
+	uint32_t nb_ops;
+	/* In-flight ops of the worker once the burst was enqueued */
+	uint32_t depth;
+};
+
+struct la_worker {
+	struct scheduler_worker worker;
+	/* Estimated cycles spent per in-flight op until completion */
+	uint64_t op_cycles;
+	/* No burst of the worker has completed yet */
+	bool unsampled;
+	uint32_t burst_head;
+	uint32_t burst_tail;
+	struct la_burst bursts[LA_NB_BURSTS];
+};
+
+struct la_scheduler_qp_ctx {
+	struct la_worker workers[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS];
+	uint32_t nb_workers;
+
+	uint32_t last_deq_worker_idx;
+};
+
+/* Pick the worker with the lowest expected completion time of a burst,
+ * given its in-flight depth and its estimated cost per op.
+ */
+static __rte_always_inline uint32_t
+la_select_worker(struct la_scheduler_qp_ctx *la_qp_ctx, uint16_t nb_ops)
+{
+	uint64_t cost, best_cost = UINT64_MAX;
+	struct la_worker *w;
+	uint32_t i, best = 0;
+
+	for (i = 0; i < la_qp_ctx->nb_workers; i++) {
+		w = &la_qp_ctx->workers[i];
+		cost = (w->worker.nb_inflight_cops + nb_ops) * w->op_cycles;
+		if (cost < best_cost) {
+			best_cost = cost;
+			best = i;
+		}
+	}
+
+	/* Let the estimate of the idle workers decay, so that a worker which
+	 * was slow once gets another chance.
+	 */
+	for (i = 0; i < la_qp_ctx->nb_workers; i++) {
+		w = &la_qp_ctx->workers[i];
+		if (i != best && w->worker.nb_inflight_cops == 0)
+			w->op_cycles -= w->op_cycles >> LA_IDLE_DECAY_SHIFT;
+	}
+
+	return best;
+}
+
+static __rte_always_inline void
+la_burst_record(struct la_worker *w, uint16_t nb_ops)
+{
+	struct la_burst *burst;
+
+	if (w->burst_head - w->burst_tail == LA_NB_BURSTS) {
+		/* No room left, account the ops in the latest burst */
+		burst = &w->bursts[(w->burst_head - 1) & LA_BURSTS_MASK];
+		burst->nb_ops += nb_ops;
+		burst->depth = w->worker.nb_inflight_cops;
+		return;
+	}
+
+	burst = &w->bursts[w->burst_head & LA_BURSTS_MASK];
+	burst->tsc = rte_rdtsc();
+	burst->nb_ops = nb_ops;
+	burst->depth = w->worker.nb_inflight_cops;
+	w->burst_head++;
+}
+
+/* Update the cost estimate of a worker with the bursts fully dequeued,
+ * assuming the ops of a queue pair complete in order.
+ */
+static __rte_always_inline void
+la_burst_complete(struct la_worker *w, uint16_t nb_ops)
+{
+	struct la_burst *burst;
+	uint64_t tsc = 0;
+	uint64_t sample;
+
+	while (nb_ops != 0 && w->burst_tail != w->burst_head) {
+		burst = &w->bursts[w->burst_tail & LA_BURSTS_MASK];
+		if (burst->nb_ops > nb_ops) {
+			burst->nb_ops -= nb_ops;
+			break;
+		}
+
+		nb_ops -= burst->nb_ops;
+		if (tsc == 0)
+			tsc = rte_rdtsc();
+		/* A null estimate would make the worker always selected */
+		sample = RTE_MAX((tsc - burst->tsc) /
+				RTE_MAX(burst->depth, 1U), 1ULL);
+		if (w->unsampled) {
+			w->op_cycles = sample;
+			w->unsampled = false;
+		} else if (sample >= w->op_cycles)
+			w->op_cycles += (sample - w->op_cycles) >> LA_EWMA_SHIFT;
+		else
+			w->op_cycles -= (w->op_cycles - sample) >> LA_EWMA_SHIFT;
+		w->burst_tail++;
+	}
+}
+
+static uint16_t
+schedule_enqueue(void *qp, struct rte_crypto_op **ops, uint16_t nb_ops)
+{
+	struct la_scheduler_qp_ctx *la_qp_ctx =
+			((struct scheduler_qp_ctx *)qp)->private_qp_ctx;
+	uint32_t worker_idx;
+	struct la_worker *w;
+	uint16_t processed_ops;
+
+	if (unlikely(nb_ops == 0))
+		return 0;
+
+	worker_idx = la_select_worker(la_qp_ctx, nb_ops);
+	w = &la_qp_ctx->workers[worker_idx];
+
+	scheduler_set_worker_sessions(ops, nb_ops, worker_idx);
+	processed_ops = rte_cryptodev_enqueue_burst(w->worker.dev_id,
+			w->worker.qp_id, ops, nb_ops);
+	if (processed_ops < nb_ops)
+		scheduler_retrieve_sessions(ops + processed_ops,
+			nb_ops - processed_ops);
+
+	if (processed_ops == 0)
+		return 0;
+
+	w->worker.nb_inflight_cops += processed_ops;
+	la_burst_record(w, processed_ops);
+
+	return processed_ops;
+}
+
+static uint16_t
+schedule_enqueue_ordering(void *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct rte_ring *order_ring =
+			((struct scheduler_qp_ctx *)qp)->order_ring;
+	uint16_t nb_ops_to_enq = get_max_enqueue_order_count(order_ring,
+			nb_ops);
+	uint16_t nb_ops_enqd = schedule_enqueue(qp, ops,
+			nb_ops_to_enq);
+
+	scheduler_order_insert(order_ring, ops, nb_ops_enqd);
+
+	return nb_ops_enqd;
+}
+
+static uint16_t
+schedule_dequeue(void *qp, struct rte_crypto_op **ops, uint16_t nb_ops)
+{
+	struct la_scheduler_qp_ctx *la_qp_ctx =
+			((struct scheduler_qp_ctx *)qp)->private_qp_ctx;
+	uint32_t worker_idx = la_qp_ctx->last_deq_worker_idx;
+	uint16_t nb_deq_ops = 0, nb_worker_ops;
+	struct la_worker *w;
+	uint32_t i;
+
+	/* Dequeue from all the workers with in-flight ops, as the bursts are
+	 * not spread evenly among them.
+	 */
+	for (i = 0; i < la_qp_ctx->nb_workers && nb_deq_ops < nb_ops; i++) {
+		w = &la_qp_ctx->workers[worker_idx];
+		if (++worker_idx == la_qp_ctx->nb_workers)
+			worker_idx = 0;
+
+		if (w->worker.nb_inflight_cops == 0)
+			continue;
+
+		nb_worker_ops = rte_cryptodev_dequeue_burst(w->worker.dev_id,
+				w->worker.qp_id, ops + nb_deq_ops,
+				nb_ops - nb_deq_ops);
+		if (nb_worker_ops == 0)
+			continue;
+
+		scheduler_retrieve_sessions(ops + nb_deq_ops, nb_worker_ops);
+		w->worker.nb_inflight_cops -= nb_worker_ops;
+		la_burst_complete(w, nb_worker_ops);
+		nb_deq_ops += nb_worker_ops;
+	}
+
+	la_qp_ctx->last_deq_worker_idx = worker_idx;
+
+	return nb_deq_ops;
+}
+
+static uint16_t
+schedule_dequeue_ordering(void *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct rte_ring *order_ring =
+			((struct scheduler_qp_ctx *)qp)->order_ring;
+
+	schedule_dequeue(qp, ops, nb_ops);
+
+	return scheduler_order_drain(order_ring, ops, nb_ops);
+}
+
+static int
+worker_attach(__rte_unused struct rte_cryptodev *dev,
+		__rte_unused uint8_t worker_id)
+{
+	return 0;
+}
+
+static int
+worker_detach(__rte_unused struct rte_cryptodev *dev,
+		__rte_unused uint8_t worker_id)
+{
+	return 0;
+}
+
+static int
+scheduler_start(struct rte_cryptodev *dev)
+{
+	struct scheduler_ctx *sched_ctx = dev->data->dev_private;
+	uint64_t init_op_cycles;
+	uint16_t i;
+
+	/* Start all the workers with the same estimate, so that the bursts
+	 * are spread by in-flight depth until they are sampled.
+	 */
+	init_op_cycles = RTE_MAX(rte_get_tsc_hz() / US_PER_S * LA_INIT_OP_US,
+			1ULL);
+
+	if (sched_ctx->reordering_enabled) {
+		dev->enqueue_burst = &schedule_enqueue_ordering;
+		dev->dequeue_burst = &schedule_dequeue_ordering;
+	} else {
+		dev->enqueue_burst = &schedule_enqueue;
+		dev->dequeue_burst = &schedule_dequeue;
+	}
+
+	for (i = 0; i < dev->data->nb_queue_pairs; i++) {
+		struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[i];
+		struct la_scheduler_qp_ctx *la_qp_ctx =
+				qp_ctx->private_qp_ctx;
+		uint32_t j;
+
+		memset(la_qp_ctx->workers, 0, sizeof(la_qp_ctx->workers));
+		for (j = 0; j < sched_ctx->nb_workers; j++) {
+			la_qp_ctx->workers[j].worker.dev_id =
+					sched_ctx->workers[j].dev_id;
+			la_qp_ctx->workers[j].worker.qp_id = i;
+			la_qp_ctx->workers[j].op_cycles = init_op_cycles;
+			la_qp_ctx->workers[j].unsampled = true;
+		}
+
+		la_qp_ctx->nb_workers = sched_ctx->nb_workers;
+
+		la_qp_ctx->last_deq_worker_idx = 0;
+	}
+
+	return 0;
+}
+
+static int
+scheduler_stop(__rte_unused struct rte_cryptodev *dev)
+{
+	return 0;
+}
+
+static int
+scheduler_config_qp(struct rte_cryptodev *dev, uint16_t qp_id)
+{
+	struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[qp_id];
+	struct la_scheduler_qp_ctx *la_qp_ctx;
+
+	la_qp_ctx = rte_zmalloc_socket(NULL, sizeof(*la_qp_ctx), 0,
+			rte_socket_id());
+	if (!la_qp_ctx) {
+		CR_SCHED_LOG(ERR, "failed allocate memory for private queue pair");
+		return -ENOMEM;
+	}
+
+	qp_ctx->private_qp_ctx = (void *)la_qp_ctx;
+
+	return 0;
+}
+
+static int
+scheduler_create_private_ctx(__rte_unused struct rte_cryptodev *dev)
+{
+	return 0;
+}
+
+static struct rte_cryptodev_scheduler_ops scheduler_la_ops = {
+	worker_attach,
+	worker_detach,
+	scheduler_start,
+	scheduler_stop,
+	scheduler_config_qp,
+	scheduler_create_private_ctx,
+	NULL,	/* option_set */
+	NULL	/* option_get */
+};
+
+static struct rte_cryptodev_scheduler scheduler = {
+		.name = "latency-aware-scheduler",
+		.description = "scheduler which will enqueue each burst to "
+				"the worker crypto device with the lowest "
+				"expected completion time",
+		.mode = CDEV_SCHED_MODE_LATENCY_AWARE,
+		.ops = &scheduler_la_ops
+};
+
+struct rte_cryptodev_scheduler *crypto_scheduler_latency_aware = &scheduler;
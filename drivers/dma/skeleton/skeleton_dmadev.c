@@ -15,6 +15,10 @@
 #include <rte_log.h>
 #include <rte_malloc.h>
 #include <rte_memcpy.h>
+#include <rte_pause.h>
+#ifdef RTE_ARCH_X86
+#include <rte_vect.h>
+#endif
 
 #include <rte_dmadev_pmd.h>
 
@@ -58,8 +62,93 @@ skeldma_configure(struct rte_dma_dev *dev, const struct rte_dma_conf *conf,
 	return 0;
 }
 
+#ifdef RTE_ARCH_X86
+#if defined(__AVX512F__)
+#define SKELDMA_NT_ALIGN	64
+#elif defined(__AVX2__)
+#define SKELDMA_NT_ALIGN	32
+#else
+#define SKELDMA_NT_ALIGN	16
+#endif
+
+/* Copy with non-temporal stores, which do not pollute the cache with
+ * the destination data. The caller must order the stores with rte_wmb()
+ * before reporting the copy as done.
+ */
+static void
+copy_nt(void *dst, const void *src, size_t len)
+{
+	uint8_t *d = dst;
+	const uint8_t *s = src;
+	size_t n;
+
+	/* Align the destination with a regular copy. */
+	n = (SKELDMA_NT_ALIGN - ((uintptr_t)d & (SKELDMA_NT_ALIGN - 1))) &
+		(SKELDMA_NT_ALIGN - 1);
+	n = RTE_MIN(n, len);
+	rte_memcpy(d, s, n);
+	d += n;
+	s += n;
+	len -= n;
+
+	for (; len >= 4 * SKELDMA_NT_ALIGN; len -= 4 * SKELDMA_NT_ALIGN) {
+#if defined(__AVX512F__)
+		__m512i v0 = _mm512_loadu_si512((const void *)s);
+		__m512i v1 = _mm512_loadu_si512((const void *)(s + 64));
+		__m512i v2 = _mm512_loadu_si512((const void *)(s + 128));
+		__m512i v3 = _mm512_loadu_si512((const void *)(s + 192));
+
+		_mm512_stream_si512((void *)d, v0);
+		_mm512_stream_si512((void *)(d + 64), v1);
+		_mm512_stream_si512((void *)(d + 128), v2);
+		_mm512_stream_si512((void *)(d + 192), v3);
+#elif defined(__AVX2__)
+		__m256i v0 = _mm256_loadu_si256((const __m256i *)s);
+		__m256i v1 = _mm256_loadu_si256((const __m256i *)(s + 32));
+		__m256i v2 = _mm256_loadu_si256((const __m256i *)(s + 64));
+		__m256i v3 = _mm256_loadu_si256((const __m256i *)(s + 96));
+
+		_mm256_stream_si256((__m256i *)d, v0);
+		_mm256_stream_si256((__m256i *)(d + 32), v1);
+		_mm256_stream_si256((__m256i *)(d + 64), v2);
+		_mm256_stream_si256((__m256i *)(d + 96), v3);
+#else
+		__m128i v0 = _mm_loadu_si128((const __m128i *)s);
+		__m128i v1 = _mm_loadu_si128((const __m128i *)(s + 16));
+		__m128i v2 = _mm_loadu_si128((const __m128i *)(s + 32));
+		__m128i v3 = _mm_loadu_si128((const __m128i *)(s + 48));
+
+		_mm_stream_si128((__m128i *)d, v0);
+		_mm_stream_si128((__m128i *)(d + 16), v1);
+		_mm_stream_si128((__m128i *)(d + 32), v2);
+		_mm_stream_si128((__m128i *)(d + 48), v3);
+#endif
+		d += 4 * SKELDMA_NT_ALIGN;
+		s += 4 * SKELDMA_NT_ALIGN;
+	}
+
+	rte_memcpy(d, s, len);
+}
+#else
+static void
+copy_nt(void *dst, const void *src, size_t len)
+{
+	rte_memcpy(dst, src, len);
+}
+#endif
+
 static inline void
-do_copy_sg_one(struct rte_dma_sge *src, struct rte_dma_sge *dst, uint16_t nb_dst, uint64_t offset)
+do_copy(const struct skeldma_hw *hw, void *dst, const void *src, uint32_t len)
+{
+	if (hw->nt_thresh != 0 && len >= hw->nt_thresh)
+		copy_nt(dst, src, len);
+	else
+		rte_memcpy(dst, src, len);
+}
+
+static inline void
+do_copy_sg_one(const struct skeldma_hw *hw, struct rte_dma_sge *src,
+	       struct rte_dma_sge *dst, uint16_t nb_dst, uint64_t offset)
 {
 	uint32_t src_off = 0, dst_off = 0;
 	uint32_t copy_len = 0;
@@ -78,9 +167,9 @@ do_copy_sg_one(struct rte_dma_sge *src, struct rte_dma_sge *dst, uint16_t nb_dst
 
 	for (/* Use the above index */; i < nb_dst; i++, copy_len = dst[i].length) {
 		copy_len = RTE_MIN(copy_len, src->length - src_off);
-		rte_memcpy((uint8_t *)(uintptr_t)dst[i].addr + dst_off,
-			   (uint8_t *)(uintptr_t)src->addr + src_off,
-			   copy_len);
+		do_copy(hw, (uint8_t *)(uintptr_t)dst[i].addr + dst_off,
+			(uint8_t *)(uintptr_t)src->addr + src_off,
+			copy_len);
 		src_off += copy_len;
 		if (src_off >= src->length)
 			break;
@@ -89,13 +178,13 @@ do_copy_sg_one(struct rte_dma_sge *src, struct rte_dma_sge *dst, uint16_t nb_dst
 }
 
 static inline void
-do_copy_sg(struct skeldma_desc *desc)
+do_copy_sg(const struct skeldma_hw *hw, struct skeldma_desc *desc)
 {
 	uint64_t offset = 0;
 	uint16_t i;
 
 	for (i = 0; i < desc->copy_sg.nb_src; i++) {
-		do_copy_sg_one(&desc->copy_sg.src[i], desc->copy_sg.dst,
+		do_copy_sg_one(hw, &desc->copy_sg.src[i], desc->copy_sg.dst,
 			       desc->copy_sg.nb_dst, offset);
 		offset += desc->copy_sg.src[i].length;
 	}
@@ -104,12 +193,15 @@ do_copy_sg(struct skeldma_desc *desc)
 static inline void
 do_fill(struct skeldma_desc *desc)
 {
-	uint8_t *fills = (uint8_t *)&desc->fill.pattern;
+	uint64_t pattern = desc->fill.pattern;
 	uint8_t *dst = (uint8_t *)desc->fill.dst;
+	uint32_t len = desc->fill.len;
 	uint32_t i;
 
-	for (i = 0; i < desc->fill.len; i++)
-		dst[i] = fills[i % 8];
+	/* The pattern is repeated from the start of the destination. */
+	for (i = 0; i + sizeof(pattern) <= len; i += sizeof(pattern))
+		memcpy(dst + i, &pattern, sizeof(pattern));
+	memcpy(dst + i, &pattern, len - i);
 }
 
 static uint32_t
@@ -118,32 +210,58 @@ cpuwork_thread(void *param)
 #define SLEEP_THRESHOLD		10000
 #define SLEEP_US_VAL		10
 
-	struct rte_dma_dev *dev = param;
-	struct skeldma_hw *hw = dev->data->dev_private;
-	struct skeldma_desc *desc = NULL;
-	int ret;
+	struct skeldma_worker *worker = param;
+	struct skeldma_hw *hw = worker->hw;
+	struct skeldma_desc *descs[SKELDMA_MAX_BURST];
+	struct skeldma_desc *desc;
+	uint16_t first;
+	uint32_t i, n;
 
 	while (!hw->exit_flag) {
-		ret = rte_ring_dequeue(hw->desc_running, (void **)&desc);
-		if (ret) {
-			hw->zero_req_count++;
-			if (hw->zero_req_count == 0)
-				hw->zero_req_count = SLEEP_THRESHOLD;
-			if (hw->zero_req_count >= SLEEP_THRESHOLD)
+		/* Share the running descriptors among the cpuwork threads. */
+		n = rte_ring_count(hw->desc_running) / hw->nb_threads;
+		n = RTE_MIN(RTE_MAX(n, 1U), (uint32_t)SKELDMA_MAX_BURST);
+		n = rte_ring_dequeue_burst(hw->desc_running, (void **)descs,
+					   n, NULL);
+		if (n == 0) {
+			worker->zero_req_count++;
+			if (worker->zero_req_count == 0)
+				worker->zero_req_count = SLEEP_THRESHOLD;
+			if (worker->zero_req_count >= SLEEP_THRESHOLD)
 				rte_delay_us_sleep(SLEEP_US_VAL);
 			continue;
 		}
-		hw->zero_req_count = 0;
-
-		if (desc->op == SKELDMA_OP_COPY)
-			rte_memcpy(desc->copy.dst, desc->copy.src, desc->copy.len);
-		else if (desc->op == SKELDMA_OP_COPY_SG)
-			do_copy_sg(desc);
-		else if (desc->op == SKELDMA_OP_FILL)
-			do_fill(desc);
+		worker->zero_req_count = 0;
+
+		for (i = 0; i < n; i++) {
+			desc = descs[i];
+			if (desc->op == SKELDMA_OP_COPY)
+				do_copy(hw, desc->copy.dst, desc->copy.src,
+					desc->copy.len);
+			else if (desc->op == SKELDMA_OP_COPY_SG)
+				do_copy_sg(hw, desc);
+			else if (desc->op == SKELDMA_OP_FILL)
+				do_fill(desc);
+		}
 
-		rte_atomic_fetch_add_explicit(&hw->completed_count, 1, rte_memory_order_release);
-		(void)rte_ring_enqueue(hw->desc_completed, (void *)desc);
+		/* Make non-temporal stores visible before completion. */
+		if (hw->nt_thresh != 0)
+			rte_wmb();
+
+		/* Wait for the threads which took older descriptors,
+		 * which never wait for this one, so that is bounded.
+		 */
+		first = descs[0]->ridx;
+		while (rte_atomic_load_explicit(&hw->cpl_ridx,
+				rte_memory_order_acquire) != first)
+			rte_pause();
+
+		(void)rte_ring_enqueue_burst(hw->desc_completed,
+					     (void **)descs, n, NULL);
+		rte_atomic_fetch_add_explicit(&hw->completed_count, n,
+					      rte_memory_order_release);
+		rte_atomic_store_explicit(&hw->cpl_ridx, (uint16_t)(first + n),
+					  rte_memory_order_release);
 	}
 
 	return 0;
@@ -159,12 +277,28 @@ fflush_ring(struct skeldma_hw *hw, struct rte_ring *ring)
 	}
 }
 
+static void
+cpuwork_stop(struct skeldma_hw *hw, uint16_t nb_threads)
+{
+	uint16_t i;
+
+	hw->exit_flag = true;
+	rte_delay_ms(1);
+
+	for (i = 0; i < nb_threads; i++) {
+		(void)pthread_cancel((pthread_t)hw->workers[i].thread.opaque_id);
+		rte_thread_join(hw->workers[i].thread, NULL);
+	}
+}
+
 static int
 skeldma_start(struct rte_dma_dev *dev)
 {
 	struct skeldma_hw *hw = dev->data->dev_private;
 	char name[RTE_THREAD_INTERNAL_NAME_SIZE];
+	struct skeldma_worker *worker;
 	rte_cpuset_t cpuset;
+	uint16_t i;
 	int ret;
 
 	if (hw->desc_mem == NULL) {
@@ -184,27 +318,39 @@ skeldma_start(struct rte_dma_dev *dev)
 	hw->ridx = 0;
 	hw->last_ridx = hw->ridx - 1;
 	hw->submitted_count = 0;
-	hw->zero_req_count = 0;
 	hw->completed_count = 0;
+	hw->cpl_ridx = hw->ridx;
 	hw->exit_flag = false;
+	for (i = 0; i < hw->nb_threads; i++)
+		hw->workers[i].zero_req_count = 0;
 
 	rte_mb();
 
-	snprintf(name, sizeof(name), "dma-skel%d", dev->data->dev_id);
-	ret = rte_thread_create_internal_control(&hw->thread, name,
-			cpuwork_thread, dev);
-	if (ret) {
-		SKELDMA_LOG(ERR, "Start cpuwork thread fail!");
-		return -EINVAL;
-	}
+	for (i = 0; i < hw->nb_threads; i++) {
+		worker = &hw->workers[i];
+		if (hw->nb_threads == 1)
+			snprintf(name, sizeof(name), "dma-skel%d",
+				 dev->data->dev_id);
+		else
+			snprintf(name, sizeof(name), "dma-sk%d-%u",
+				 dev->data->dev_id, i);
+		ret = rte_thread_create_internal_control(&worker->thread, name,
+				cpuwork_thread, worker);
+		if (ret) {
+			SKELDMA_LOG(ERR, "Start cpuwork thread %u fail!", i);
+			cpuwork_stop(hw, i);
+			return -EINVAL;
+		}
 
-	if (hw->lcore_id != -1) {
-		cpuset = rte_lcore_cpuset(hw->lcore_id);
-		ret = rte_thread_set_affinity_by_id(hw->thread, &cpuset);
-		if (ret)
-			SKELDMA_LOG(WARNING,
-				"Set thread affinity lcore = %d fail!",
-				hw->lcore_id);
+		if (worker->lcore_id != -1) {
+			cpuset = rte_lcore_cpuset(worker->lcore_id);
+			ret = rte_thread_set_affinity_by_id(worker->thread,
+							    &cpuset);
+			if (ret)
+				SKELDMA_LOG(WARNING,
+					"Set thread affinity lcore = %d fail!",
+					worker->lcore_id);
+		}
 	}
 
 	return 0;
@@ -215,11 +361,7 @@ skeldma_stop(struct rte_dma_dev *dev)
 {
 	struct skeldma_hw *hw = dev->data->dev_private;
 
-	hw->exit_flag = true;
-	rte_delay_ms(1);
-
-	(void)pthread_cancel((pthread_t)hw->thread.opaque_id);
-	rte_thread_join(hw->thread, NULL);
+	cpuwork_stop(hw, hw->nb_threads);
 
 	return 0;
 }
@@ -250,7 +392,8 @@ vchan_setup(struct skeldma_hw *hw, int16_t dev_id, uint16_t nb_desc)
 				  RING_F_SP_ENQ | RING_F_SC_DEQ);
 	snprintf(name, RTE_RING_NAMESIZE, "dma_skel_desc_run_%d", dev_id);
 	running = rte_ring_create(name, nb_desc, hw->socket_id,
-				  RING_F_SP_ENQ | RING_F_SC_DEQ);
+				  RING_F_SP_ENQ |
+				  (hw->nb_threads > 1 ? 0 : RING_F_SC_DEQ));
 	snprintf(name, RTE_RING_NAMESIZE, "dma_skel_desc_comp_%d", dev_id);
 	completed = rte_ring_create(name, nb_desc, hw->socket_id,
 				    RING_F_SP_ENQ | RING_F_SC_DEQ);
@@ -331,14 +474,18 @@ skeldma_vchan_status(const struct rte_dma_dev *dev,
 		uint16_t vchan, enum rte_dma_vchan_status *status)
 {
 	struct skeldma_hw *hw = dev->data->dev_private;
+	uint16_t i;
 
 	RTE_SET_USED(vchan);
 
 	*status = RTE_DMA_VCHAN_IDLE;
 	if (hw->submitted_count != rte_atomic_load_explicit(&hw->completed_count,
-			rte_memory_order_acquire)
-			|| hw->zero_req_count == 0)
+			rte_memory_order_acquire))
 		*status = RTE_DMA_VCHAN_ACTIVE;
+	for (i = 0; i < hw->nb_threads; i++) {
+		if (hw->workers[i].zero_req_count == 0)
+			*status = RTE_DMA_VCHAN_ACTIVE;
+	}
 	return 0;
 }
 
@@ -377,15 +524,19 @@ skeldma_dump(const struct rte_dma_dev *dev, FILE *f)
 #define GET_RING_COUNT(ring)	((ring) ? (rte_ring_count(ring)) : 0)
 
 	struct skeldma_hw *hw = dev->data->dev_private;
+	uint16_t i;
 
+	for (i = 0; i < hw->nb_threads; i++)
+		(void)fprintf(f, "    thread%u lcore_id: %d\n",
+			i, hw->workers[i].lcore_id);
 	(void)fprintf(f,
-		"    lcore_id: %d\n"
+		"    nt_thresh: %u\n"
 		"    socket_id: %d\n"
 		"    desc_empty_ring_count: %u\n"
 		"    desc_pending_ring_count: %u\n"
 		"    desc_running_ring_count: %u\n"
 		"    desc_completed_ring_count: %u\n",
-		hw->lcore_id, hw->socket_id,
+		hw->nt_thresh, hw->socket_id,
 		GET_RING_COUNT(hw->desc_empty),
 		GET_RING_COUNT(hw->desc_pending),
 		GET_RING_COUNT(hw->desc_running),
@@ -404,14 +555,15 @@ skeldma_dump(const struct rte_dma_dev *dev, FILE *f)
 static inline void
 submit(struct skeldma_hw *hw, struct skeldma_desc *desc)
 {
-	uint16_t count = rte_ring_count(hw->desc_pending);
-	struct skeldma_desc *pend_desc = NULL;
+	void *pend_descs[SKELDMA_MAX_BURST];
+	uint32_t n;
 
-	while (count > 0) {
-		(void)rte_ring_dequeue(hw->desc_pending, (void **)&pend_desc);
-		(void)rte_ring_enqueue(hw->desc_running, (void *)pend_desc);
-		count--;
-	}
+	do {
+		n = rte_ring_dequeue_burst(hw->desc_pending, pend_descs,
+					   RTE_DIM(pend_descs), NULL);
+		(void)rte_ring_enqueue_burst(hw->desc_running, pend_descs, n,
+					     NULL);
+	} while (n == RTE_DIM(pend_descs));
 
 	if (desc)
 		(void)rte_ring_enqueue(hw->desc_running, (void *)desc);
@@ -514,33 +666,43 @@ skeldma_submit(void *dev_private, uint16_t vchan)
 	return 0;
 }
 
+static inline uint16_t
+reap_completed(struct skeldma_hw *hw, const uint16_t nb_cpls,
+	       uint16_t *last_idx, enum rte_dma_status_code *status)
+{
+	struct skeldma_desc *descs[SKELDMA_MAX_BURST];
+	uint16_t count = 0;
+	uint32_t i, n;
+
+	while (count < nb_cpls) {
+		n = rte_ring_dequeue_burst(hw->desc_completed, (void **)descs,
+				RTE_MIN(nb_cpls - count, SKELDMA_MAX_BURST),
+				NULL);
+		if (n == 0)
+			break;
+		if (status != NULL) {
+			for (i = 0; i < n; i++)
+				status[count + i] = RTE_DMA_STATUS_SUCCESSFUL;
+		}
+		hw->last_ridx = descs[n - 1]->ridx;
+		(void)rte_ring_enqueue_burst(hw->desc_empty, (void **)descs, n,
+					     NULL);
+		count += n;
+	}
+	*last_idx = hw->last_ridx;
+
+	return count;
+}
+
 static uint16_t
 skeldma_completed(void *dev_private,
 		  uint16_t vchan, const uint16_t nb_cpls,
 		  uint16_t *last_idx, bool *has_error)
 {
-	struct skeldma_hw *hw = dev_private;
-	struct skeldma_desc *desc = NULL;
-	uint16_t index = 0;
-	uint16_t count;
-
 	RTE_SET_USED(vchan);
 	RTE_SET_USED(has_error);
 
-	count = RTE_MIN(nb_cpls, rte_ring_count(hw->desc_completed));
-	while (index < count) {
-		(void)rte_ring_dequeue(hw->desc_completed, (void **)&desc);
-		if (index == count - 1) {
-			hw->last_ridx = desc->ridx;
-			*last_idx = desc->ridx;
-		}
-		index++;
-		(void)rte_ring_enqueue(hw->desc_empty, (void *)desc);
-	}
-	if (unlikely(count == 0))
-		*last_idx = hw->last_ridx;
-
-	return count;
+	return reap_completed(dev_private, nb_cpls, last_idx, NULL);
 }
 
 static uint16_t
@@ -548,27 +710,9 @@ skeldma_completed_status(void *dev_private,
 			 uint16_t vchan, const uint16_t nb_cpls,
 			 uint16_t *last_idx, enum rte_dma_status_code *status)
 {
-	struct skeldma_hw *hw = dev_private;
-	struct skeldma_desc *desc = NULL;
-	uint16_t index = 0;
-	uint16_t count;
-
 	RTE_SET_USED(vchan);
 
-	count = RTE_MIN(nb_cpls, rte_ring_count(hw->desc_completed));
-	while (index < count) {
-		(void)rte_ring_dequeue(hw->desc_completed, (void **)&desc);
-		if (index == count - 1) {
-			hw->last_ridx = desc->ridx;
-			*last_idx = desc->ridx;
-		}
-		status[index++] = RTE_DMA_STATUS_SUCCESSFUL;
-		(void)rte_ring_enqueue(hw->desc_empty, (void *)desc);
-	}
-	if (unlikely(count == 0))
-		*last_idx = hw->last_ridx;
-
-	return count;
+	return reap_completed(dev_private, nb_cpls, last_idx, status);
 }
 
 static uint16_t
@@ -597,14 +741,16 @@ static const struct rte_dma_dev_ops skeldma_ops = {
 };
 
 static int
-skeldma_create(const char *name, struct rte_vdev_device *vdev, int lcore_id)
+skeldma_create(const char *name, struct rte_vdev_device *vdev,
+	       const struct skeldma_args *args)
 {
 	struct rte_dma_dev *dev;
 	struct skeldma_hw *hw;
 	int socket_id;
+	uint16_t i;
 
-	socket_id = (lcore_id < 0) ? rte_socket_id() :
-				     rte_lcore_to_socket_id(lcore_id);
+	socket_id = (args->nb_lcores == 0) ? rte_socket_id() :
+			rte_lcore_to_socket_id(args->lcore_ids[0]);
 	dev = rte_dma_pmd_allocate(name, socket_id, sizeof(struct skeldma_hw));
 	if (dev == NULL) {
 		SKELDMA_LOG(ERR, "Unable to allocate dmadev: %s", name);
@@ -623,8 +769,14 @@ skeldma_create(const char *name, struct rte_vdev_device *vdev, int lcore_id)
 	dev->fp_obj->burst_capacity = skeldma_burst_capacity;
 
 	hw = dev->data->dev_private;
-	hw->lcore_id = lcore_id;
 	hw->socket_id = socket_id;
+	hw->nb_threads = RTE_MAX(args->nb_threads, args->nb_lcores);
+	hw->nt_thresh = args->nt_thresh;
+	for (i = 0; i < hw->nb_threads; i++) {
+		hw->workers[i].hw = hw;
+		hw->workers[i].lcore_id = (i < args->nb_lcores) ?
+				args->lcore_ids[i] : -1;
+	}
 
 	dev->state = RTE_DMA_DEV_READY;
 
@@ -642,23 +794,59 @@ skeldma_parse_lcore(const char *key __rte_unused,
 		    const char *value,
 		    void *opaque)
 {
+	struct skeldma_args *args = opaque;
 	int lcore_id;
 
 	if (value == NULL || opaque == NULL)
 		return -EINVAL;
 
+	/* One cpuwork thread per lcore, the key may be repeated. */
 	lcore_id = atoi(value);
-	if (lcore_id >= 0 && lcore_id < RTE_MAX_LCORE)
-		*(int *)opaque = lcore_id;
+	if (lcore_id >= 0 && lcore_id < RTE_MAX_LCORE &&
+	    args->nb_lcores < SKELDMA_MAX_THREADS)
+		args->lcore_ids[args->nb_lcores++] = lcore_id;
+
+	return 0;
+}
+
+static int
+skeldma_parse_threads(const char *key __rte_unused,
+		      const char *value,
+		      void *opaque)
+{
+	int nb_threads;
+
+	if (value == NULL || opaque == NULL)
+		return -EINVAL;
+
+	nb_threads = atoi(value);
+	if (nb_threads > 0 && nb_threads <= SKELDMA_MAX_THREADS)
+		*(uint16_t *)opaque = nb_threads;
+
+	return 0;
+}
+
+static int
+skeldma_parse_nt_thresh(const char *key __rte_unused,
+			const char *value,
+			void *opaque)
+{
+	if (value == NULL || opaque == NULL)
+		return -EINVAL;
+
+	*(uint32_t *)opaque = strtoul(value, NULL, 0);
 
 	return 0;
 }
 
 static void
-skeldma_parse_vdev_args(struct rte_vdev_device *vdev, int *lcore_id)
+skeldma_parse_vdev_args(struct rte_vdev_device *vdev,
+			struct skeldma_args *vargs)
 {
 	static const char *const args[] = {
 		SKELDMA_ARG_LCORE,
+		SKELDMA_ARG_THREADS,
+		SKELDMA_ARG_NT_THRESH,
 		NULL
 	};
 
@@ -674,8 +862,13 @@ skeldma_parse_vdev_args(struct rte_vdev_device *vdev, int *lcore_id)
 		return;
 
 	(void)rte_kvargs_process(kvlist, SKELDMA_ARG_LCORE,
-				 skeldma_parse_lcore, lcore_id);
-	SKELDMA_LOG(INFO, "Parse lcore_id = %d", *lcore_id);
+				 skeldma_parse_lcore, vargs);
+	(void)rte_kvargs_process(kvlist, SKELDMA_ARG_THREADS,
+				 skeldma_parse_threads, &vargs->nb_threads);
+	(void)rte_kvargs_process(kvlist, SKELDMA_ARG_NT_THRESH,
+				 skeldma_parse_nt_thresh, &vargs->nt_thresh);
+	SKELDMA_LOG(INFO, "Parse %u lcore(s), %u thread(s), nt_thresh = %u",
+		    vargs->nb_lcores, vargs->nb_threads, vargs->nt_thresh);
 
 	rte_kvargs_free(kvlist);
 }
@@ -683,8 +876,10 @@ skeldma_parse_vdev_args(struct rte_vdev_device *vdev, int *lcore_id)
 static int
 skeldma_probe(struct rte_vdev_device *vdev)
 {
+	struct skeldma_args args = {
+		.nb_threads = 1,
+	};
 	const char *name;
-	int lcore_id = -1;
 	int ret;
 
 	name = rte_vdev_device_name(vdev);
@@ -696,12 +891,12 @@ skeldma_probe(struct rte_vdev_device *vdev)
 		return -EINVAL;
 	}
 
-	skeldma_parse_vdev_args(vdev, &lcore_id);
+	skeldma_parse_vdev_args(vdev, &args);
 
-	ret = skeldma_create(name, vdev, lcore_id);
+	ret = skeldma_create(name, vdev, &args);
 	if (ret >= 0)
-		SKELDMA_LOG(INFO, "Create %s dmadev with lcore-id %d",
-			name, lcore_id);
+		SKELDMA_LOG(INFO, "Create %s dmadev with %u cpuwork thread(s)",
+			name, RTE_MAX(args.nb_threads, args.nb_lcores));
 
 	return ret < 0 ? ret : 0;
 }
@@ -731,4 +926,6 @@ static struct rte_vdev_driver skeldma_pmd_drv = {
 
 RTE_PMD_REGISTER_VDEV(dma_skeleton, skeldma_pmd_drv);
 RTE_PMD_REGISTER_PARAM_STRING(dma_skeleton,
-		SKELDMA_ARG_LCORE "=<uint16> ");
+		SKELDMA_ARG_LCORE "=<uint16> "
+		SKELDMA_ARG_THREADS "=<uint16> "
+		SKELDMA_ARG_NT_THRESH "=<uint32> ");
@@ -10,8 +10,13 @@
 #include <rte_thread.h>
 
 #define SKELDMA_ARG_LCORE	"lcore"
+#define SKELDMA_ARG_THREADS	"threads"
+#define SKELDMA_ARG_NT_THRESH	"nt_thresh"
 
 #define SKELDMA_MAX_SGES	4
+#define SKELDMA_MAX_THREADS	16
+/* Max number of descriptors fetched at once by a cpuwork thread */
+#define SKELDMA_MAX_BURST	32
 
 enum skeldma_op {
 	SKELDMA_OP_COPY,
@@ -43,11 +48,29 @@ struct skeldma_desc {
 	};
 };
 
-struct skeldma_hw {
+struct skeldma_hw;
+
+struct skeldma_worker {
+	struct skeldma_hw *hw;
 	int lcore_id; /* cpuwork task affinity core */
-	int socket_id;
 	rte_thread_t thread; /* cpuwork task thread */
+	alignas(RTE_CACHE_LINE_SIZE) volatile uint32_t zero_req_count;
+};
+
+struct skeldma_args {
+	int lcore_ids[SKELDMA_MAX_THREADS];
+	uint16_t nb_lcores;
+	uint16_t nb_threads;
+	uint32_t nt_thresh;
+};
+
+struct skeldma_hw {
+	int socket_id;
+	uint16_t nb_threads;
+	/* Copies of at least that length use non-temporal stores, 0 to disable */
+	uint32_t nt_thresh;
 	volatile int exit_flag; /* cpuwork task exit flag */
+	struct skeldma_worker workers[SKELDMA_MAX_THREADS];
 
 	struct skeldma_desc *desc_mem;
 
@@ -66,6 +89,11 @@ struct skeldma_hw {
 	 *  -----------     cpuwork thread working     -----------
 	 *  |completed|<-------------------------------| running |
 	 *  -----------                                -----------
+	 *
+	 * With multiple cpuwork threads, each one takes a burst of
+	 * descriptors from the running ring, and moves it to the completed
+	 * ring once all the older descriptors were moved, so that
+	 * descriptors are completed in ring idx order.
 	 */
 	struct rte_ring *desc_empty;
 	struct rte_ring *desc_pending;
@@ -80,7 +108,7 @@ struct skeldma_hw {
 
 	/* Cache delimiter for cpuwork thread's operation data */
 	alignas(RTE_CACHE_LINE_SIZE) char cache2;
-	volatile uint32_t zero_req_count;
+	RTE_ATOMIC(uint16_t) cpl_ridx; /* ring idx of next completed desc */
 	RTE_ATOMIC(uint64_t) completed_count;
 };
 
@@ -100,16 +100,26 @@
 
 #define DSW_MAX_EVENTS_RECORDED (128)
 
-#define DSW_MAX_FLOWS_PER_MIGRATION (8)
+#define DSW_MAX_FLOWS_PER_MIGRATION (16)
 
-/* Only one outstanding migration per port is allowed */
+/* A port may start a new migration before the unpausing of its
+ * previous one is confirmed, but the control messages from a port are
+ * processed in order, so the unpause request of a migration always
+ * comes before the pause request of the next one. At most one set of
+ * flows is thus paused on behalf of every port.
+ */
 #define DSW_MAX_PAUSED_FLOWS (DSW_MAX_PORTS*DSW_MAX_FLOWS_PER_MIGRATION)
 
-/* Enough room for pause request/confirm and unpaus request/confirm for
- * all possible senders.
+/* Enough room for pause request/confirm and unpause request/confirm
+ * for all possible senders.
  */
 #define DSW_CTL_IN_RING_SIZE ((DSW_MAX_PORTS-1)*4)
 
+/* The maximum number of control messages processed by a port during
+ * one background processing run.
+ */
+#define DSW_CTL_DEQUEUE_BURST_SIZE (16)
+
 /* With DSW_SORT_DEQUEUED enabled, the scheduler will, at the point of
  * dequeue(), arrange events so that events with the same flow id on
  * the same queue forms a back-to-back "burst", and also so that such
@@ -129,8 +139,7 @@ struct dsw_queue_flow {
 enum dsw_migration_state {
 	DSW_MIGRATION_STATE_IDLE,
 	DSW_MIGRATION_STATE_FINISH_PENDING,
-	DSW_MIGRATION_STATE_PAUSING,
-	DSW_MIGRATION_STATE_UNPAUSING
+	DSW_MIGRATION_STATE_PAUSING
 };
 
 struct __rte_cache_aligned dsw_port {
@@ -177,6 +186,10 @@ struct __rte_cache_aligned dsw_port {
 	uint64_t emigration_start;
 	uint64_t emigrations;
 	uint64_t emigration_latency;
+	uint64_t emigration_latency_max;
+	uint64_t emigration_pauses;
+	uint64_t emigration_pause_latency;
+	uint64_t emigration_aborts;
 
 	uint8_t emigration_target_port_ids[DSW_MAX_FLOWS_PER_MIGRATION];
 	struct dsw_queue_flow
@@ -184,6 +197,14 @@ struct __rte_cache_aligned dsw_port {
 	uint8_t emigration_targets_len;
 	uint8_t cfm_cnt;
 
+	/* The unpausing of the flows of the previous migration
+	 * overlaps with the selection and pausing of the flows of the
+	 * next one.
+	 */
+	uint64_t unpausing_start;
+	uint8_t unpausing_flows_len;
+	uint8_t unpause_cfm_cnt;
+
 	uint64_t immigrations;
 
 	uint16_t paused_flows_len;
@@ -261,7 +282,8 @@ struct dsw_evdev {
 
 #define DSW_CTL_PAUSE_REQ (0)
 #define DSW_CTL_UNPAUSE_REQ (1)
-#define DSW_CTL_CFM (2)
+#define DSW_CTL_PAUSE_CFM (2)
+#define DSW_CTL_UNPAUSE_CFM (3)
 
 struct __rte_aligned(4) dsw_ctl_msg {
 	uint8_t type;
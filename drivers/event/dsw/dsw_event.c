@@ -198,10 +198,12 @@ dsw_port_ctl_enqueue(struct dsw_port *port, struct dsw_ctl_msg *msg)
 		rte_pause();
 }
 
-static int
-dsw_port_ctl_dequeue(struct dsw_port *port, struct dsw_ctl_msg *msg)
+static unsigned int
+dsw_port_ctl_dequeue_burst(struct dsw_port *port, struct dsw_ctl_msg *msgs,
+			   unsigned int num)
 {
-	return rte_ring_dequeue_elem(port->ctl_in_ring, msg, sizeof(*msg));
+	return rte_ring_dequeue_burst_elem(port->ctl_in_ring, msgs,
+					   sizeof(*msgs), num, NULL);
 }
 
 static void
@@ -268,6 +270,8 @@ dsw_port_add_paused_flows(struct dsw_port *port, struct dsw_queue_flow *qfs,
 				"Pausing queue_id %d flow_hash %d.",
 				qf->queue_id, qf->flow_hash);
 
+		RTE_ASSERT(port->paused_flows_len < DSW_MAX_PAUSED_FLOWS);
+
 		port->paused_flows[port->paused_flows_len] = *qf;
 		port->paused_flows_len++;
 	};
@@ -325,7 +329,7 @@ dsw_port_handle_pause_flows(struct dsw_evdev *dsw, struct dsw_port *port,
 			    uint8_t qfs_len)
 {
 	struct dsw_ctl_msg cfm = {
-		.type = DSW_CTL_CFM,
+		.type = DSW_CTL_PAUSE_CFM,
 		.originating_port_id = port->id
 	};
 
@@ -740,14 +744,17 @@ dsw_port_flush_no_longer_paused_events(struct dsw_evdev *dsw,
 }
 
 static void
-dsw_port_emigration_stats(struct dsw_port *port, uint8_t finished)
+dsw_port_emigration_stats(struct dsw_port *port, uint64_t start,
+			  uint8_t finished)
 {
 	uint64_t flow_migration_latency;
 
-	flow_migration_latency =
-		(rte_get_timer_cycles() - port->emigration_start);
+	flow_migration_latency = (rte_get_timer_cycles() - start);
 	port->emigration_latency += (flow_migration_latency * finished);
 	port->emigrations += finished;
+
+	if (flow_migration_latency > port->emigration_latency_max)
+		port->emigration_latency_max = flow_migration_latency;
 }
 
 static void
@@ -783,7 +790,8 @@ dsw_port_end_emigration(struct dsw_evdev *dsw, struct dsw_port *port,
 	finished = port->emigration_targets_len - left_qfs_len;
 
 	if (finished > 0)
-		dsw_port_emigration_stats(port, finished);
+		dsw_port_emigration_stats(port, port->emigration_start,
+					  finished);
 
 	for (i = 0; i < left_qfs_len; i++) {
 		port->emigration_target_port_ids[i] = left_port_ids[i];
@@ -959,6 +967,8 @@ dsw_port_abort_migration(struct dsw_port *source_port)
 	source_port->emigration_targets_len = 0;
 
 	source_port->migration_state = DSW_MIGRATION_STATE_IDLE;
+
+	source_port->emigration_aborts++;
 }
 
 static void
@@ -1020,7 +1030,7 @@ dsw_port_handle_unpause_flows(struct dsw_evdev *dsw, struct dsw_port *port,
 {
 	uint16_t i;
 	struct dsw_ctl_msg cfm = {
-		.type = DSW_CTL_CFM,
+		.type = DSW_CTL_UNPAUSE_CFM,
 		.originating_port_id = port->id
 	};
 
@@ -1133,20 +1143,19 @@ dsw_port_forward_emigrated_event(struct dsw_evdev *dsw,
 			&source_port->emigration_target_qfs[i];
 		uint8_t dest_port_id =
 			source_port->emigration_target_port_ids[i];
-		struct dsw_port *dest_port = &dsw->ports[dest_port_id];
 
 		if (event->queue_id == qf->queue_id &&
 		    dsw_flow_id_hash(event->flow_id) == qf->flow_hash) {
-			/* No need to care about bursting forwarded
-			 * events (to the destination port's in_ring),
-			 * since migration doesn't happen very often,
-			 * and also the majority of the dequeued
-			 * events will likely *not* be forwarded.
+			/* With many flows migrating at once, the
+			 * forwarded events may be numerous, so they
+			 * are sent in bursts via the output
+			 * buffer. The buffer to the destination port
+			 * cannot hold any events of the migrating
+			 * flows, since it was flushed before the flow
+			 * table update.
 			 */
-			while (rte_event_ring_enqueue_burst(dest_port->in_ring,
-							    event, 1,
-							    NULL) != 1)
-				rte_pause();
+			dsw_port_buffer_non_paused(dsw, source_port,
+						   dest_port_id, event);
 			return;
 		}
 	}
@@ -1218,50 +1227,89 @@ dsw_port_move_emigrating_flows(struct dsw_evdev *dsw,
 	dsw_port_ctl_broadcast(dsw, source_port, DSW_CTL_UNPAUSE_REQ,
 			       source_port->emigration_target_qfs,
 			       source_port->emigration_targets_len);
-	source_port->cfm_cnt = 0;
-	source_port->migration_state = DSW_MIGRATION_STATE_UNPAUSING;
+
+	/* Since every other port processes the unpause request
+	 * before any later pause request from this port, there is no
+	 * need to wait for the unpause confirmations before starting
+	 * the next migration. The unpausing is tracked separately,
+	 * for statistics only.
+	 */
+	RTE_ASSERT(source_port->unpausing_flows_len == 0);
+
+	source_port->unpausing_start = source_port->emigration_start;
+	source_port->unpausing_flows_len = source_port->emigration_targets_len;
+	source_port->unpause_cfm_cnt = 0;
+
+	source_port->emigration_targets_len = 0;
+	source_port->migration_state = DSW_MIGRATION_STATE_IDLE;
+	source_port->seen_events_len = 0;
 }
 
 static void
-dsw_port_handle_confirm(struct dsw_evdev *dsw, struct dsw_port *port)
+dsw_port_handle_pause_confirm(struct dsw_evdev *dsw, struct dsw_port *port)
 {
+	RTE_VERIFY(port->migration_state == DSW_MIGRATION_STATE_PAUSING);
+
 	port->cfm_cnt++;
 
 	if (port->cfm_cnt == (dsw->num_ports - 1)) {
-		switch (port->migration_state) {
-		case DSW_MIGRATION_STATE_PAUSING:
-			dsw_port_move_emigrating_flows(dsw, port);
-			break;
-		case DSW_MIGRATION_STATE_UNPAUSING:
-			dsw_port_end_emigration(dsw, port,
-						RTE_SCHED_TYPE_ATOMIC);
-			break;
-		default:
-			RTE_VERIFY(0);
-			break;
-		}
+		port->emigration_pause_latency +=
+			(rte_get_timer_cycles() - port->emigration_start);
+		port->emigration_pauses++;
+
+		dsw_port_move_emigrating_flows(dsw, port);
+	}
+}
+
+static void
+dsw_port_handle_unpause_confirm(struct dsw_evdev *dsw, struct dsw_port *port)
+{
+	RTE_VERIFY(port->unpausing_flows_len > 0);
+
+	port->unpause_cfm_cnt++;
+
+	if (port->unpause_cfm_cnt == (dsw->num_ports - 1)) {
+		DSW_LOG_DP_PORT_LINE(DEBUG, port->id, "Migration completed for "
+				"%d flows.", port->unpausing_flows_len);
+
+		dsw_port_emigration_stats(port, port->unpausing_start,
+					  port->unpausing_flows_len);
+		port->unpausing_flows_len = 0;
 	}
 }
 
 static void
 dsw_port_ctl_process(struct dsw_evdev *dsw, struct dsw_port *port)
 {
-	struct dsw_ctl_msg msg;
+	struct dsw_ctl_msg msgs[DSW_CTL_DEQUEUE_BURST_SIZE];
+	unsigned int num;
+	unsigned int i;
+
+	/* With many ports, a migration requires a large number of
+	 * confirmations, so all messages available are processed at
+	 * once, rather than one per call.
+	 */
+	num = dsw_port_ctl_dequeue_burst(port, msgs, RTE_DIM(msgs));
+
+	for (i = 0; i < num; i++) {
+		struct dsw_ctl_msg *msg = &msgs[i];
 
-	if (dsw_port_ctl_dequeue(port, &msg) == 0) {
-		switch (msg.type) {
+		switch (msg->type) {
 		case DSW_CTL_PAUSE_REQ:
 			dsw_port_handle_pause_flows(dsw, port,
-						    msg.originating_port_id,
-						    msg.qfs, msg.qfs_len);
+						    msg->originating_port_id,
+						    msg->qfs, msg->qfs_len);
 			break;
 		case DSW_CTL_UNPAUSE_REQ:
 			dsw_port_handle_unpause_flows(dsw, port,
-						      msg.originating_port_id,
-						      msg.qfs, msg.qfs_len);
+						      msg->originating_port_id,
+						      msg->qfs, msg->qfs_len);
+			break;
+		case DSW_CTL_PAUSE_CFM:
+			dsw_port_handle_pause_confirm(dsw, port);
 			break;
-		case DSW_CTL_CFM:
-			dsw_port_handle_confirm(dsw, port);
+		case DSW_CTL_UNPAUSE_CFM:
+			dsw_port_handle_unpause_confirm(dsw, port);
 			break;
 		}
 	}
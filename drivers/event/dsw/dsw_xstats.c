@@ -97,6 +97,21 @@ dsw_xstats_port_get_migration_latency(struct dsw_evdev *dsw, uint8_t port_id,
 	return num_emigrations > 0 ? total_latency / num_emigrations : 0;
 }
 
+DSW_GEN_PORT_ACCESS_FN(emigration_latency_max)
+
+static uint64_t
+dsw_xstats_port_get_migration_pause_latency(struct dsw_evdev *dsw,
+					    uint8_t port_id,
+					    uint8_t queue_id __rte_unused)
+{
+	uint64_t total_latency = dsw->ports[port_id].emigration_pause_latency;
+	uint64_t num_pauses = dsw->ports[port_id].emigration_pauses;
+
+	return num_pauses > 0 ? total_latency / num_pauses : 0;
+}
+
+DSW_GEN_PORT_ACCESS_FN(emigration_aborts)
+
 static uint64_t
 dsw_xstats_port_get_event_proc_latency(struct dsw_evdev *dsw, uint8_t port_id,
 				       uint8_t queue_id __rte_unused)
@@ -150,6 +165,12 @@ static struct dsw_xstats_port dsw_port_xstats[] = {
 	  false },
 	{ "port_%u_migration_latency", dsw_xstats_port_get_migration_latency,
 	  false },
+	{ "port_%u_migration_latency_max",
+	  dsw_xstats_port_get_emigration_latency_max, false },
+	{ "port_%u_migration_pause_latency",
+	  dsw_xstats_port_get_migration_pause_latency, false },
+	{ "port_%u_migration_aborts", dsw_xstats_port_get_emigration_aborts,
+	  false },
 	{ "port_%u_immigrations", dsw_xstats_port_get_immigrations,
 	  false },
 	{ "port_%u_event_proc_latency", dsw_xstats_port_get_event_proc_latency,
@@ -27,36 +27,36 @@ iq_count(const struct sw_iq *iq)
 }
 
 static __rte_always_inline struct sw_queue_chunk *
-iq_alloc_chunk(struct sw_evdev *sw)
+iq_alloc_chunk(struct sw_sched_shard *shard)
 {
-	struct sw_queue_chunk *chunk = sw->chunk_list_head;
-	sw->chunk_list_head = chunk->next;
+	struct sw_queue_chunk *chunk = shard->chunk_list_head;
+	shard->chunk_list_head = chunk->next;
 	chunk->next = NULL;
 	return chunk;
 }
 
 static __rte_always_inline void
-iq_free_chunk(struct sw_evdev *sw, struct sw_queue_chunk *chunk)
+iq_free_chunk(struct sw_sched_shard *shard, struct sw_queue_chunk *chunk)
 {
-	chunk->next = sw->chunk_list_head;
-	sw->chunk_list_head = chunk;
+	chunk->next = shard->chunk_list_head;
+	shard->chunk_list_head = chunk;
 }
 
 static __rte_always_inline void
-iq_free_chunk_list(struct sw_evdev *sw, struct sw_queue_chunk *head)
+iq_free_chunk_list(struct sw_sched_shard *shard, struct sw_queue_chunk *head)
 {
 	while (head) {
 		struct sw_queue_chunk *next;
 		next = head->next;
-		iq_free_chunk(sw, head);
+		iq_free_chunk(shard, head);
 		head = next;
 	}
 }
 
 static __rte_always_inline void
-iq_init(struct sw_evdev *sw, struct sw_iq *iq)
+iq_init(struct sw_sched_shard *shard, struct sw_iq *iq)
 {
-	iq->head = iq_alloc_chunk(sw);
+	iq->head = iq_alloc_chunk(shard);
 	iq->tail = iq->head;
 	iq->head_idx = 0;
 	iq->tail_idx = 0;
@@ -64,7 +64,8 @@ iq_init(struct sw_evdev *sw, struct sw_iq *iq)
 }
 
 static __rte_always_inline void
-iq_enqueue(struct sw_evdev *sw, struct sw_iq *iq, const struct rte_event *ev)
+iq_enqueue(struct sw_sched_shard *shard, struct sw_iq *iq,
+	   const struct rte_event *ev)
 {
 	iq->tail->events[iq->tail_idx++] = *ev;
 	iq->count++;
@@ -74,7 +75,7 @@ iq_enqueue(struct sw_evdev *sw, struct sw_iq *iq, const struct rte_event *ev)
 		 * number of inflight events and number of IQS such that
 		 * allocation will always succeed.
 		 */
-		struct sw_queue_chunk *chunk = iq_alloc_chunk(sw);
+		struct sw_queue_chunk *chunk = iq_alloc_chunk(shard);
 		iq->tail->next = chunk;
 		iq->tail = chunk;
 		iq->tail_idx = 0;
@@ -82,14 +83,14 @@ iq_enqueue(struct sw_evdev *sw, struct sw_iq *iq, const struct rte_event *ev)
 }
 
 static __rte_always_inline void
-iq_pop(struct sw_evdev *sw, struct sw_iq *iq)
+iq_pop(struct sw_sched_shard *shard, struct sw_iq *iq)
 {
 	iq->head_idx++;
 	iq->count--;
 
 	if (unlikely(iq->head_idx == SW_EVS_PER_Q_CHUNK)) {
 		struct sw_queue_chunk *next = iq->head->next;
-		iq_free_chunk(sw, iq->head);
+		iq_free_chunk(shard, iq->head);
 		iq->head = next;
 		iq->head_idx = 0;
 	}
@@ -103,7 +104,7 @@ iq_peek(struct sw_iq *iq)
 
 /* Note: the caller must ensure that count <= iq_count() */
 static __rte_always_inline uint16_t
-iq_dequeue_burst(struct sw_evdev *sw,
+iq_dequeue_burst(struct sw_sched_shard *shard,
 		 struct sw_iq *iq,
 		 struct rte_event *ev,
 		 uint16_t count)
@@ -129,7 +130,7 @@ iq_dequeue_burst(struct sw_evdev *sw,
 
 		/* Move to the next chunk */
 		next = current->next;
-		iq_free_chunk(sw, current);
+		iq_free_chunk(shard, current);
 		current = next;
 		index = 0;
 	}
@@ -137,7 +138,7 @@ iq_dequeue_burst(struct sw_evdev *sw,
 done:
 	if (unlikely(index == SW_EVS_PER_Q_CHUNK)) {
 		struct sw_queue_chunk *next = current->next;
-		iq_free_chunk(sw, current);
+		iq_free_chunk(shard, current);
 		iq->head = next;
 		iq->head_idx = 0;
 	} else {
@@ -151,7 +152,7 @@ iq_dequeue_burst(struct sw_evdev *sw,
 }
 
 static __rte_always_inline void
-iq_put_back(struct sw_evdev *sw,
+iq_put_back(struct sw_sched_shard *shard,
 	    struct sw_iq *iq,
 	    struct rte_event *ev,
 	    unsigned int count)
@@ -179,7 +180,7 @@ iq_put_back(struct sw_evdev *sw,
 		for (i = 0; i < avail_space; i++)
 			iq->head->events[i] = ev[remaining + i];
 
-		new_head = iq_alloc_chunk(sw);
+		new_head = iq_alloc_chunk(shard);
 		new_head->next = iq->head;
 		iq->head = new_head;
 		iq->head_idx = SW_EVS_PER_Q_CHUNK - remaining;
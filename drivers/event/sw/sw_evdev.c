@@ -24,6 +24,7 @@
 #define MIN_BURST_SIZE_ARG "min_burst"
 #define DEQ_BURST_SIZE_ARG "deq_burst"
 #define REFIL_ONCE_ARG "refill_once"
+#define SCHED_SHARDS_ARG "sched_shards"
 
 static void
 sw_info_get(struct rte_eventdev *dev, struct rte_event_dev_info *info);
@@ -52,6 +53,14 @@ sw_port_link(struct rte_eventdev *dev, void *port, const uint8_t queues[],
 			break;
 		}
 
+		/* ports cannot move to another shard while running */
+		if (sw->started && q->shard != p->shard) {
+			SW_LOG_ERR("Queue %u and port %u are scheduled by different shards",
+					q->id, p->id);
+			rte_errno = EINVAL;
+			break;
+		}
+
 		for (j = 0; j < q->cq_num_mapped_cqs; j++) {
 			if (q->cq_map[j] == p->id)
 				break;
@@ -346,10 +355,31 @@ sw_queue_setup(struct rte_eventdev *dev, uint8_t queue_id,
 	return qid_init(sw, queue_id, type, conf);
 }
 
+/* Number of IQ chunks needed by a shard, sized for worst-case spread of
+ * events across its IQs.
+ */
+static int
+sw_shard_num_chunks(uint32_t qid_count)
+{
+	return ((SW_INFLIGHT_EVENTS_TOTAL/SW_EVS_PER_Q_CHUNK)+1) +
+			qid_count*SW_IQS_MAX*2;
+}
+
 static void
 sw_init_qid_iqs(struct sw_evdev *sw)
 {
-	int i, j;
+	uint32_t s;
+	int i, j, chunk = 0;
+
+	/* Give each shard its share of the (all free) IQ chunks */
+	for (s = 0; s < sw->nb_shards; s++) {
+		struct sw_sched_shard *shard = &sw->shards[s];
+		int num_chunks = sw_shard_num_chunks(shard->qid_count);
+
+		shard->chunk_list_head = NULL;
+		for (i = 0; i < num_chunks; i++)
+			iq_free_chunk(shard, &sw->chunks[chunk++]);
+	}
 
 	/* Initialize the IQ memory of all configured qids */
 	for (i = 0; i < RTE_EVENT_MAX_QUEUES_PER_DEV; i++) {
@@ -359,7 +389,7 @@ sw_init_qid_iqs(struct sw_evdev *sw)
 			continue;
 
 		for (j = 0; j < SW_IQS_MAX; j++)
-			iq_init(sw, &qid->iq[j]);
+			iq_init(&sw->shards[qid->shard], &qid->iq[j]);
 	}
 }
 
@@ -389,6 +419,12 @@ sw_ports_empty(struct sw_evdev *sw)
 			return 0;
 	}
 
+	for (i = 0; i < sw->nb_shards; i++) {
+		if (sw->shards[i].xfer_ring &&
+		     rte_event_ring_count(sw->shards[i].xfer_ring))
+			return 0;
+	}
+
 	return 1;
 }
 
@@ -419,9 +455,9 @@ sw_drain_ports(struct rte_eventdev *dev)
 }
 
 static void
-sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
+sw_drain_queue(struct rte_eventdev *dev, struct sw_sched_shard *shard,
+		struct sw_iq *iq)
 {
-	struct sw_evdev *sw = sw_pmd_priv(dev);
 	eventdev_stop_flush_t flush;
 	uint8_t dev_id;
 	void *arg;
@@ -433,7 +469,7 @@ sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
 	while (iq_count(iq) > 0) {
 		struct rte_event ev;
 
-		iq_dequeue_burst(sw, iq, &ev, 1);
+		iq_dequeue_burst(shard, iq, &ev, 1);
 
 		if (flush)
 			flush(dev_id, ev, arg);
@@ -447,8 +483,11 @@ sw_drain_queues(struct rte_eventdev *dev)
 	unsigned int i, j;
 
 	for (i = 0; i < sw->qid_count; i++) {
+		struct sw_qid *qid = &sw->qids[i];
+
 		for (j = 0; j < SW_IQS_MAX; j++)
-			sw_drain_queue(dev, &sw->qids[i].iq[j]);
+			sw_drain_queue(dev, &sw->shards[qid->shard],
+					&qid->iq[j]);
 	}
 }
 
@@ -465,7 +504,8 @@ sw_clean_qid_iqs(struct rte_eventdev *dev)
 		for (j = 0; j < SW_IQS_MAX; j++) {
 			if (!qid->iq[j].head)
 				continue;
-			iq_free_chunk_list(sw, qid->iq[j].head);
+			iq_free_chunk_list(&sw->shards[qid->shard],
+					qid->iq[j].head);
 			qid->iq[j].head = NULL;
 		}
 	}
@@ -507,16 +547,20 @@ sw_dev_configure(const struct rte_eventdev *dev)
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 	const struct rte_eventdev_data *data = dev->data;
 	const struct rte_event_dev_config *conf = &data->dev_conf;
-	int num_chunks, i;
+	int num_chunks;
+	uint32_t i;
 
 	sw->qid_count = conf->nb_event_queues;
 	sw->port_count = conf->nb_event_ports;
 	sw->nb_events_limit = conf->nb_events_limit;
 	rte_atomic32_set(&sw->inflights, 0);
 
-	/* Number of chunks sized for worst-case spread of events across IQs */
-	num_chunks = ((SW_INFLIGHT_EVENTS_TOTAL/SW_EVS_PER_Q_CHUNK)+1) +
-			sw->qid_count*SW_IQS_MAX*2;
+	/* Number of chunks sized for worst-case spread of events across the
+	 * IQs of each shard. They are shared out between the shards in
+	 * sw_start().
+	 */
+	num_chunks = sw_shard_num_chunks(0) * (sw->nb_shards - 1) +
+			sw_shard_num_chunks(sw->qid_count);
 
 	/* If this is a reconfiguration, free the previous IQ allocation. All
 	 * IQ chunk references were cleaned out of the QIDs in sw_stop(), and
@@ -532,9 +576,26 @@ sw_dev_configure(const struct rte_eventdev *dev)
 	if (!sw->chunks)
 		return -ENOMEM;
 
-	sw->chunk_list_head = NULL;
-	for (i = 0; i < num_chunks; i++)
-		iq_free_chunk(sw, &sw->chunks[i]);
+	/* Rings for the events handed over between shards, which can hold
+	 * all the events inflight.
+	 */
+	for (i = 0; sw->nb_shards > 1 && i < sw->nb_shards; i++) {
+		struct sw_sched_shard *shard = &sw->shards[i];
+		char buf[RTE_RING_NAMESIZE];
+
+		if (shard->xfer_ring != NULL)
+			continue;
+
+		snprintf(buf, sizeof(buf), "sw%d_s%u_xfer_ring",
+				dev->data->dev_id, i);
+		shard->xfer_ring = rte_event_ring_create(buf,
+				SW_INFLIGHT_EVENTS_TOTAL, sw->data->socket_id,
+				RING_F_SC_DEQ | RING_F_EXACT_SZ);
+		if (shard->xfer_ring == NULL) {
+			SW_LOG_ERR("Error creating xfer ring for shard %u", i);
+			return -ENOMEM;
+		}
+	}
 
 	if (conf->event_dev_cfg & RTE_EVENT_DEV_CFG_PER_DEQUEUE_TIMEOUT)
 		return -ENOTSUP;
@@ -608,7 +669,8 @@ sw_info_get(struct rte_eventdev *dev, struct rte_event_dev_info *info)
 				RTE_EVENT_DEV_CAP_MULTIPLE_QUEUE_PORT |
 				RTE_EVENT_DEV_CAP_NONSEQ_MODE |
 				RTE_EVENT_DEV_CAP_CARRY_FLOW_ID |
-				RTE_EVENT_DEV_CAP_MAINTENANCE_FREE),
+				RTE_EVENT_DEV_CAP_MAINTENANCE_FREE |
+				RTE_EVENT_DEV_CAP_EVENT_VECTOR),
 			.max_profiles_per_port = 1,
 	};
 
@@ -623,16 +685,47 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	static const char * const q_type_strings[] = {
 			"Ordered", "Atomic", "Parallel", "Directed"
 	};
+	struct sw_sched_shard total = {0};
 	uint32_t i;
 	fprintf(f, "EventDev %s: ports %d, qids %d\n",
 		dev->data->name, sw->port_count, sw->qid_count);
 
+	for (i = 0; i < sw->nb_shards; i++) {
+		const struct sw_sched_shard *shard = &sw->shards[i];
+
+		total.stats.rx_pkts += shard->stats.rx_pkts;
+		total.stats.rx_dropped += shard->stats.rx_dropped;
+		total.stats.tx_pkts += shard->stats.tx_pkts;
+		total.sched_called += shard->sched_called;
+		total.sched_cq_qid_called += shard->sched_cq_qid_called;
+		total.sched_no_iq_enqueues += shard->sched_no_iq_enqueues;
+		total.sched_no_cq_enqueues += shard->sched_no_cq_enqueues;
+	}
+
 	fprintf(f, "\trx   %"PRIu64"\n\tdrop %"PRIu64"\n\ttx   %"PRIu64"\n",
-		sw->stats.rx_pkts, sw->stats.rx_dropped, sw->stats.tx_pkts);
-	fprintf(f, "\tsched calls: %"PRIu64"\n", sw->sched_called);
-	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n", sw->sched_cq_qid_called);
-	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n", sw->sched_no_iq_enqueues);
-	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n", sw->sched_no_cq_enqueues);
+		total.stats.rx_pkts, total.stats.rx_dropped,
+		total.stats.tx_pkts);
+	fprintf(f, "\tsched calls: %"PRIu64"\n", total.sched_called);
+	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n",
+		total.sched_cq_qid_called);
+	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n",
+		total.sched_no_iq_enqueues);
+	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n",
+		total.sched_no_cq_enqueues);
+
+	for (i = 0; sw->nb_shards > 1 && i < sw->nb_shards; i++) {
+		const struct sw_sched_shard *shard = &sw->shards[i];
+
+		fprintf(f, "  Shard %d: qids %u, ports %u\n", i,
+			shard->qid_count, shard->port_count);
+		fprintf(f, "\trx   %"PRIu64"\tdrop %"PRIu64"\ttx   %"PRIu64
+			"\txfer %"PRIu64"\n", shard->stats.rx_pkts,
+			shard->stats.rx_dropped, shard->stats.tx_pkts,
+			shard->sched_xfer_pkts);
+		fprintf(f, "\tsched calls: %"PRIu64"\tbusy cycles: %"PRIu64
+			"\n", shard->sched_called, shard->sched_busy_cycles);
+	}
+
 	uint32_t inflights = rte_atomic32_read(&sw->inflights);
 	uint32_t credits = sw->nb_events_limit - inflights;
 	fprintf(f, "\tinflight %d, credits: %d\n", inflights, credits);
@@ -762,6 +855,114 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	}
 }
 
+static uint32_t
+sw_qid_group_find(uint16_t *group, uint32_t qid)
+{
+	while (group[qid] != qid) {
+		group[qid] = group[group[qid]];
+		qid = group[qid];
+	}
+
+	return qid;
+}
+
+/* Partition the qids into groups, such that qids linked to the same port
+ * are in the same group, and spread the groups over the scheduler shards,
+ * largest group first.
+ */
+static void
+sw_assign_shards(struct sw_evdev *sw)
+{
+	uint16_t group[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	uint32_t group_size[RTE_EVENT_MAX_QUEUES_PER_DEV] = {0};
+	int group_shard[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	uint32_t shard_size[SW_SCHED_SHARDS_MAX] = {0};
+	uint32_t i, j, p;
+
+	for (i = 0; i < sw->qid_count; i++) {
+		group[i] = i;
+		group_shard[i] = -1;
+	}
+
+	for (p = 0; p < sw->port_count; p++) {
+		int first = -1;
+
+		for (i = 0; i < sw->qid_count; i++) {
+			const struct sw_qid *qid = &sw->qids[i];
+
+			for (j = 0; j < qid->cq_num_mapped_cqs; j++)
+				if (qid->cq_map[j] == p)
+					break;
+			if (j == qid->cq_num_mapped_cqs)
+				continue;
+
+			if (first < 0)
+				first = i;
+			else
+				group[sw_qid_group_find(group, i)] =
+					sw_qid_group_find(group, first);
+		}
+	}
+
+	for (i = 0; i < sw->qid_count; i++)
+		group_size[sw_qid_group_find(group, i)]++;
+
+	for (;;) {
+		uint32_t largest = 0, size = 0, shard = 0;
+
+		for (i = 0; i < sw->qid_count; i++) {
+			if (group_shard[i] < 0 && group_size[i] > size) {
+				largest = i;
+				size = group_size[i];
+			}
+		}
+		if (size == 0)
+			break;
+
+		for (j = 1; j < sw->nb_shards; j++)
+			if (shard_size[j] < shard_size[shard])
+				shard = j;
+
+		group_shard[largest] = shard;
+		shard_size[shard] += size;
+	}
+
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_sched_shard *shard = &sw->shards[i];
+
+		shard->id = i;
+		shard->qid_count = 0;
+		shard->port_count = 0;
+		if (sw->nb_shards > 1 && shard_size[i] == 0)
+			SW_LOG_INFO("No queue scheduled by shard %u", i);
+	}
+
+	for (i = 0; i < sw->qid_count; i++)
+		sw->qids[i].shard = group_shard[sw_qid_group_find(group, i)];
+
+	/* ports follow their qids, and unlinked ports are spread evenly */
+	for (p = 0; p < sw->port_count; p++) {
+		struct sw_port *port = &sw->ports[p];
+		struct sw_sched_shard *shard;
+
+		port->shard = p % sw->nb_shards;
+		for (i = 0; i < sw->qid_count; i++) {
+			const struct sw_qid *qid = &sw->qids[i];
+
+			for (j = 0; j < qid->cq_num_mapped_cqs; j++)
+				if (qid->cq_map[j] == p)
+					break;
+			if (j < qid->cq_num_mapped_cqs) {
+				port->shard = qid->shard;
+				break;
+			}
+		}
+
+		shard = &sw->shards[port->shard];
+		shard->port_ids[shard->port_count++] = p;
+	}
+}
+
 static int
 sw_start(struct rte_eventdev *dev)
 {
@@ -792,18 +993,23 @@ sw_start(struct rte_eventdev *dev)
 			return -ENOLINK;
 		}
 
-	/* build up our prioritized array of qids */
+	sw_assign_shards(sw);
+
+	/* build up the prioritized arrays of qids of the shards */
 	/* We don't use qsort here, as if all/multiple entries have the same
 	 * priority, the result is non-deterministic. From "man 3 qsort":
 	 * "If two members compare as equal, their order in the sorted
 	 * array is undefined."
 	 */
-	uint32_t qidx = 0;
 	for (j = 0; j <= RTE_EVENT_DEV_PRIORITY_LOWEST; j++) {
 		for (i = 0; i < sw->qid_count; i++) {
 			if (sw->qids[i].priority == j) {
-				sw->qids_prioritized[qidx] = &sw->qids[i];
-				qidx++;
+				struct sw_sched_shard *shard =
+					&sw->shards[sw->qids[i].shard];
+
+				shard->qids_prioritized[shard->qid_count] =
+					&sw->qids[i];
+				shard->qid_count++;
 			}
 		}
 	}
@@ -863,11 +1069,20 @@ sw_close(struct rte_eventdev *dev)
 		sw_port_release(&sw->ports[i]);
 	sw->port_count = 0;
 
-	memset(&sw->stats, 0, sizeof(sw->stats));
-	sw->sched_called = 0;
-	sw->sched_no_iq_enqueues = 0;
-	sw->sched_no_cq_enqueues = 0;
-	sw->sched_cq_qid_called = 0;
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_sched_shard *shard = &sw->shards[i];
+
+		memset(&shard->stats, 0, sizeof(shard->stats));
+		shard->sched_called = 0;
+		shard->sched_no_iq_enqueues = 0;
+		shard->sched_no_cq_enqueues = 0;
+		shard->sched_cq_qid_called = 0;
+		shard->sched_xfer_pkts = 0;
+		shard->sched_busy_cycles = 0;
+
+		rte_event_ring_free(shard->xfer_ring);
+		shard->xfer_ring = NULL;
+	}
 
 	return 0;
 }
@@ -932,6 +1147,16 @@ set_refill_once(const char *key __rte_unused, const char *value, void *opaque)
 	return 0;
 }
 
+static int
+set_sched_shards(const char *key __rte_unused, const char *value, void *opaque)
+{
+	int *sched_shards = opaque;
+	*sched_shards = atoi(value);
+	if (*sched_shards < 1 || *sched_shards > SW_SCHED_SHARDS_MAX)
+		return -1;
+	return 0;
+}
+
 static int32_t sw_sched_service_func(void *args)
 {
 	struct rte_eventdev *dev = args;
@@ -980,6 +1205,7 @@ sw_probe(struct rte_vdev_device *vdev)
 		MIN_BURST_SIZE_ARG,
 		DEQ_BURST_SIZE_ARG,
 		REFIL_ONCE_ARG,
+		SCHED_SHARDS_ARG,
 		NULL
 	};
 	const char *name;
@@ -992,6 +1218,8 @@ sw_probe(struct rte_vdev_device *vdev)
 	int min_burst_size = 1;
 	int deq_burst_size = SCHED_DEQUEUE_DEFAULT_BURST_SIZE;
 	int refill_once = 0;
+	int sched_shards = 1;
+	uint32_t i;
 
 	name = rte_vdev_device_name(vdev);
 	params = rte_vdev_device_args(vdev);
@@ -1063,6 +1291,16 @@ sw_probe(struct rte_vdev_device *vdev)
 				return ret;
 			}
 
+			ret = rte_kvargs_process(kvlist, SCHED_SHARDS_ARG,
+					set_sched_shards, &sched_shards);
+			if (ret != 0) {
+				SW_LOG_ERR(
+					"%s: Error parsing scheduler shards parameter",
+					name);
+				rte_kvargs_free(kvlist);
+				return ret;
+			}
+
 			rte_kvargs_free(kvlist);
 		}
 	}
@@ -1070,9 +1308,11 @@ sw_probe(struct rte_vdev_device *vdev)
 	SW_LOG_INFO(
 			"Creating eventdev sw device %s, numa_node=%d, "
 			"sched_quanta=%d, credit_quanta=%d "
-			"min_burst=%d, deq_burst=%d, refill_once=%d",
+			"min_burst=%d, deq_burst=%d, refill_once=%d, "
+			"sched_shards=%d",
 			name, socket_id, sched_quanta, credit_quanta,
-			min_burst_size, deq_burst_size, refill_once);
+			min_burst_size, deq_burst_size, refill_once,
+			sched_shards);
 
 	dev = rte_event_pmd_vdev_init(name,
 			sizeof(struct sw_evdev), socket_id, vdev);
@@ -1098,6 +1338,11 @@ sw_probe(struct rte_vdev_device *vdev)
 	sw->sched_min_burst_size = min_burst_size;
 	sw->sched_deq_burst_size = deq_burst_size;
 	sw->refill_once_per_iter = refill_once;
+	sw->nb_shards = sched_shards;
+	for (i = 0; i < sw->nb_shards; i++) {
+		sw->shards[i].id = i;
+		rte_spinlock_init(&sw->shards[i].lock);
+	}
 
 	/* register service with EAL */
 	struct rte_service_spec service;
@@ -1108,6 +1353,9 @@ sw_probe(struct rte_vdev_device *vdev)
 	service.socket_id = socket_id;
 	service.callback = sw_sched_service_func;
 	service.callback_userdata = (void *)dev;
+	/* the shards can be scheduled concurrently by several lcores */
+	if (sw->nb_shards > 1)
+		service.capabilities = RTE_SERVICE_CAP_MT_SAFE;
 
 	int32_t ret = rte_service_component_register(&service, &sw->service_id);
 	if (ret) {
@@ -1146,5 +1394,5 @@ RTE_PMD_REGISTER_VDEV(EVENTDEV_NAME_SW_PMD, evdev_sw_pmd_drv);
 RTE_PMD_REGISTER_PARAM_STRING(event_sw, NUMA_NODE_ARG "=<int> "
 		SCHED_QUANTA_ARG "=<int>" CREDIT_QUANTA_ARG "=<int>"
 		MIN_BURST_SIZE_ARG "=<int>" DEQ_BURST_SIZE_ARG "=<int>"
-		REFIL_ONCE_ARG "=<int>");
+		REFIL_ONCE_ARG "=<int>" SCHED_SHARDS_ARG "=<int>");
 RTE_LOG_REGISTER_DEFAULT(eventdev_sw_log_level, NOTICE);
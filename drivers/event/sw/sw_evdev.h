@@ -9,6 +9,7 @@
 #include <rte_eventdev.h>
 #include <eventdev_pmd_vdev.h>
 #include <rte_atomic.h>
+#include <rte_spinlock.h>
 
 #define SW_DEFAULT_CREDIT_QUANTA 32
 #define SW_DEFAULT_SCHED_QUANTA 128
@@ -36,6 +37,11 @@
 /* Flush the pipeline after this many no enq to cq */
 #define SCHED_NO_ENQ_CYCLE_FLUSH 256
 
+/* max number of scheduler shards */
+#define SW_SCHED_SHARDS_MAX 8
+/* events buffered before being handed to another shard */
+#define SW_SCHED_XFER_BURST_SIZE 32
+
 
 #define SW_PORT_HIST_LIST (MAX_SW_PROD_Q_DEPTH) /* size of our history list */
 #define NUM_SAMPLES 64 /* how many data points use for average stats */
@@ -133,6 +139,8 @@ struct sw_qid {
 	uint32_t window_size;          /* Used to wrap reorder_buffer_index */
 
 	uint8_t priority;
+	/* scheduler shard owning this QID */
+	uint8_t shard;
 };
 
 struct sw_hist_list_entry {
@@ -207,6 +215,53 @@ struct sw_port {
 	struct rte_event cq_buf[MAX_SW_CONS_Q_DEPTH];
 
 	uint8_t num_qids_mapped;
+	/* scheduler shard pulling from and pushing to this port */
+	uint8_t shard;
+};
+
+/* The QIDs are partitioned into groups, with no port linked to QIDs of
+ * two groups, and each group is scheduled by its own shard. The flow
+ * pinning and reorder state of a QID, and the history list of a port,
+ * are only accessed by the shard owning them, which allows the shards
+ * to run concurrently on different service cores. Events enqueued to a
+ * QID of another shard are handed over through that shard's xfer ring.
+ */
+struct __rte_cache_aligned sw_sched_shard {
+	rte_spinlock_t lock;
+	uint8_t id;
+
+	/* QIDs of this shard sorted by priority level */
+	uint32_t qid_count;
+	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	/* ports linked to the QIDs of this shard */
+	uint32_t port_count;
+	uint8_t port_ids[SW_PORTS_MAX];
+
+	/* Events enqueued by other shards to the QIDs of this shard */
+	struct rte_event_ring *xfer_ring;
+	uint16_t xfer_buf_count[SW_SCHED_SHARDS_MAX];
+	struct rte_event xfer_buf[SW_SCHED_SHARDS_MAX][SW_SCHED_XFER_BURST_SIZE];
+
+	/* IQ chunks available to the QIDs of this shard */
+	struct sw_queue_chunk *chunk_list_head;
+
+	/* Current values */
+	uint32_t sched_flush_count;
+	uint32_t sched_min_burst;
+
+	/* Completion target of non-ordered history list entries */
+	struct reorder_buffer_entry dummy_rob;
+
+	/* Stats */
+	struct sw_point_stats stats;
+	uint64_t sched_called;
+	uint64_t sched_no_iq_enqueues;
+	uint64_t sched_no_cq_enqueues;
+	uint64_t sched_cq_qid_called;
+	uint64_t sched_last_iter_bitmask;
+	uint8_t sched_progress_last_iter;
+	uint64_t sched_xfer_pkts;
+	uint64_t sched_busy_cycles;
 };
 
 struct sw_evdev {
@@ -226,9 +281,6 @@ struct sw_evdev {
 	uint32_t sched_deq_burst_size;
 	/* Refill pp buffers only once per scheduler call*/
 	uint32_t refill_once_per_iter;
-	/* Current values */
-	uint32_t sched_flush_count;
-	uint32_t sched_min_burst;
 
 	/* Contains all ports - load balanced and directed */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_port ports[SW_PORTS_MAX];
@@ -243,24 +295,16 @@ struct sw_evdev {
 
 	/* Internal queues - one per logical queue */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_qid qids[RTE_EVENT_MAX_QUEUES_PER_DEV];
-	struct sw_queue_chunk *chunk_list_head;
 	struct sw_queue_chunk *chunks;
 
 	/* Cache how many packets are in each cq */
 	alignas(RTE_CACHE_LINE_SIZE) uint16_t cq_ring_space[SW_PORTS_MAX];
 
-	/* Array of pointers to load-balanced QIDs sorted by priority level */
-	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	/* Scheduler shards */
+	uint32_t nb_shards;
+	struct sw_sched_shard shards[SW_SCHED_SHARDS_MAX];
 
-	/* Stats */
-	alignas(RTE_CACHE_LINE_SIZE) struct sw_point_stats stats;
-	uint64_t sched_called;
 	int32_t sched_quanta;
-	uint64_t sched_no_iq_enqueues;
-	uint64_t sched_no_cq_enqueues;
-	uint64_t sched_cq_qid_called;
-	uint64_t sched_last_iter_bitmask;
-	uint8_t sched_progress_last_iter;
 
 	uint8_t started;
 	uint32_t credit_update_quanta;
@@ -2,6 +2,7 @@
  * Copyright(c) 2016-2017 Intel Corporation
  */
 
+#include <rte_cycles.h>
 #include <rte_ring.h>
 #include <rte_hash_crc.h>
 #include <rte_event_ring.h>
@@ -29,8 +30,8 @@
 
 
 static inline uint32_t
-sw_schedule_atomic_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
-		uint32_t iq_num, unsigned int count)
+sw_schedule_atomic_to_cq(struct sw_evdev *sw, struct sw_sched_shard *shard,
+		struct sw_qid * const qid, uint32_t iq_num, unsigned int count)
 {
 	struct rte_event qes[MAX_PER_IQ_DEQUEUE]; /* count <= MAX */
 	struct rte_event blocked_qes[MAX_PER_IQ_DEQUEUE];
@@ -45,7 +46,7 @@ sw_schedule_atomic_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 	 */
 	uint32_t qid_id = qid->id;
 
-	iq_dequeue_burst(sw, &qid->iq[iq_num], qes, count);
+	iq_dequeue_burst(shard, &qid->iq[iq_num], qes, count);
 	for (i = 0; i < count; i++) {
 		const struct rte_event *qe = &qes[i];
 		const uint16_t flow_id = SW_HASH_FLOWID(qes[i].flow_id);
@@ -108,14 +109,15 @@ sw_schedule_atomic_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 			p->cq_buf_count = 0;
 		}
 	}
-	iq_put_back(sw, &qid->iq[iq_num], blocked_qes, nb_blocked);
+	iq_put_back(shard, &qid->iq[iq_num], blocked_qes, nb_blocked);
 
 	return count - nb_blocked;
 }
 
 static inline uint32_t
-sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
-		uint32_t iq_num, unsigned int count, int keep_order)
+sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_sched_shard *shard,
+		struct sw_qid * const qid, uint32_t iq_num, unsigned int count,
+		int keep_order)
 {
 	uint32_t i;
 	uint32_t cq_idx = qid->cq_next_tx;
@@ -174,7 +176,7 @@ sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 					(void *)&p->hist_list[head].rob_entry);
 
 		sw->ports[cq].cq_buf[sw->ports[cq].cq_buf_count++] = *qe;
-		iq_pop(sw, &qid->iq[iq_num]);
+		iq_pop(shard, &qid->iq[iq_num]);
 
 		rte_compiler_barrier();
 		p->inflights++;
@@ -187,8 +189,9 @@ sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 }
 
 static uint32_t
-sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
-		uint32_t iq_num, unsigned int count __rte_unused)
+sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_sched_shard *shard,
+		struct sw_qid * const qid, uint32_t iq_num,
+		unsigned int count __rte_unused)
 {
 	uint32_t cq_id = qid->cq_map[0];
 	struct sw_port *port = &sw->ports[cq_id];
@@ -200,7 +203,7 @@ sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 
 	/* burst dequeue from the QID IQ ring */
 	struct sw_iq *iq = &qid->iq[iq_num];
-	uint32_t ret = iq_dequeue_burst(sw, iq,
+	uint32_t ret = iq_dequeue_burst(shard, iq,
 			&port->cq_buf[port->cq_buf_count], count_free);
 	port->cq_buf_count += ret;
 
@@ -215,15 +218,15 @@ sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 }
 
 static uint32_t
-sw_schedule_qid_to_cq(struct sw_evdev *sw)
+sw_schedule_qid_to_cq(struct sw_evdev *sw, struct sw_sched_shard *shard)
 {
 	uint32_t pkts = 0;
 	uint32_t qid_idx;
 
-	sw->sched_cq_qid_called++;
+	shard->sched_cq_qid_called++;
 
-	for (qid_idx = 0; qid_idx < sw->qid_count; qid_idx++) {
-		struct sw_qid *qid = sw->qids_prioritized[qid_idx];
+	for (qid_idx = 0; qid_idx < shard->qid_count; qid_idx++) {
+		struct sw_qid *qid = shard->qids_prioritized[qid_idx];
 
 		int type = qid->type;
 		int iq_num = PKT_MASK_TO_IQ(qid->iq_pkt_mask);
@@ -235,16 +238,16 @@ sw_schedule_qid_to_cq(struct sw_evdev *sw)
 		uint32_t pkts_done = 0;
 		uint32_t count = iq_count(&qid->iq[iq_num]);
 
-		if (count >= sw->sched_min_burst) {
+		if (count >= shard->sched_min_burst) {
 			if (type == SW_SCHED_TYPE_DIRECT)
-				pkts_done += sw_schedule_dir_to_cq(sw, qid,
-						iq_num, count);
+				pkts_done += sw_schedule_dir_to_cq(sw, shard,
+						qid, iq_num, count);
 			else if (type == RTE_SCHED_TYPE_ATOMIC)
-				pkts_done += sw_schedule_atomic_to_cq(sw, qid,
-						iq_num, count);
+				pkts_done += sw_schedule_atomic_to_cq(sw, shard,
+						qid, iq_num, count);
 			else
-				pkts_done += sw_schedule_parallel_to_cq(sw, qid,
-						iq_num, count,
+				pkts_done += sw_schedule_parallel_to_cq(sw,
+						shard, qid, iq_num, count,
 						type == RTE_SCHED_TYPE_ORDERED);
 		}
 
@@ -260,28 +263,86 @@ sw_schedule_qid_to_cq(struct sw_evdev *sw)
 	return pkts;
 }
 
+static void
+sw_xfer_flush(struct sw_evdev *sw, struct sw_sched_shard *shard,
+		uint8_t dest_shard)
+{
+	uint16_t count = shard->xfer_buf_count[dest_shard];
+	uint16_t n;
+
+	if (count == 0)
+		return;
+
+	/* The xfer rings are sized for all the events inflight, so the
+	 * enqueue is expected to always succeed.
+	 */
+	n = rte_event_ring_enqueue_burst(sw->shards[dest_shard].xfer_ring,
+			shard->xfer_buf[dest_shard], count, NULL);
+	shard->stats.rx_dropped += count - n;
+	shard->xfer_buf_count[dest_shard] = 0;
+}
+
+static void
+sw_xfer_flush_all(struct sw_evdev *sw, struct sw_sched_shard *shard)
+{
+	uint32_t i;
+
+	for (i = 0; i < sw->nb_shards; i++)
+		sw_xfer_flush(sw, shard, i);
+}
+
+/* Push a QE into its QID at the right priority. A QE to a QID owned by
+ * another shard is buffered, to be handed over to that shard.
+ * Returns the number of QEs pushed into an IQ of this shard.
+ */
+static __rte_always_inline uint32_t
+sw_qid_enqueue(struct sw_evdev *sw, struct sw_sched_shard *shard,
+		const struct rte_event *qe)
+{
+	uint32_t iq_num = PRIO_TO_IQ(qe->priority);
+	struct sw_qid *qid = &sw->qids[qe->queue_id];
+
+	if (unlikely(qid->shard != shard->id)) {
+		uint16_t *count = &shard->xfer_buf_count[qid->shard];
+
+		if (*count == SW_SCHED_XFER_BURST_SIZE)
+			sw_xfer_flush(sw, shard, qid->shard);
+		shard->xfer_buf[qid->shard][(*count)++] = *qe;
+		shard->sched_xfer_pkts++;
+		return 0;
+	}
+
+	qid->iq_pkt_mask |= (1 << (iq_num));
+	iq_enqueue(shard, &qid->iq[iq_num], qe);
+	qid->iq_pkt_count[iq_num]++;
+	qid->stats.rx_pkts++;
+
+	return 1;
+}
+
 /* This function will perform re-ordering of packets, and injecting into
- * the appropriate QID IQ. As LB and DIR QIDs are in the same array, but *NOT*
- * contiguous in that array, this function accepts a "range" of QIDs to scan.
+ * the appropriate QID IQ. Only the ordered QIDs of the shard are scanned.
  */
 static uint16_t
-sw_schedule_reorder(struct sw_evdev *sw, int qid_start, int qid_end)
+sw_schedule_reorder(struct sw_evdev *sw, struct sw_sched_shard *shard)
 {
 	/* Perform egress reordering */
 	struct rte_event *qe;
 	uint32_t pkts_iter = 0;
+	uint32_t qid_idx;
 
-	for (; qid_start < qid_end; qid_start++) {
-		struct sw_qid *qid = &sw->qids[qid_start];
+	for (qid_idx = 0; qid_idx < sw->qid_count; qid_idx++) {
+		struct sw_qid *qid = &sw->qids[qid_idx];
 		unsigned int i, num_entries_in_use;
 
-		if (qid->type != RTE_SCHED_TYPE_ORDERED)
+		if (qid->type != RTE_SCHED_TYPE_ORDERED ||
+				qid->shard != shard->id)
 			continue;
 
 		num_entries_in_use = rob_ring_free_count(
 					qid->reorder_buffer_freelist);
 
-		if (num_entries_in_use < sw->sched_min_burst)
+		if (num_entries_in_use < shard->sched_min_burst)
 			num_entries_in_use = 0;
 
 		for (i = 0; i < num_entries_in_use; i++) {
@@ -294,32 +355,20 @@ sw_schedule_reorder(struct sw_evdev *sw, int qid_start, int qid_end)
 				break;
 
 			for (j = 0; j < entry->num_fragments; j++) {
-				uint16_t dest_qid;
-				uint16_t dest_iq;
-
 				int idx = entry->fragment_index + j;
 				qe = &entry->fragments[idx];
 
-				dest_qid = qe->queue_id;
-				dest_iq  = PRIO_TO_IQ(qe->priority);
-
-				if (dest_qid >= sw->qid_count) {
-					sw->stats.rx_dropped++;
+				if (qe->queue_id >= sw->qid_count) {
+					shard->stats.rx_dropped++;
 					continue;
 				}
 
 				pkts_iter++;
 
-				struct sw_qid *q = &sw->qids[dest_qid];
-				struct sw_iq *iq = &q->iq[dest_iq];
-
 				/* we checked for space above, so enqueue must
 				 * succeed
 				 */
-				iq_enqueue(sw, iq, qe);
-				q->iq_pkt_mask |= (1 << (dest_iq));
-				q->iq_pkt_count[dest_iq]++;
-				q->stats.rx_pkts++;
+				sw_qid_enqueue(sw, shard, qe);
 			}
 
 			entry->ready = (j != entry->num_fragments);
@@ -352,9 +401,10 @@ sw_refill_pp_buf(struct sw_evdev *sw, struct sw_port *port)
 }
 
 static __rte_always_inline uint32_t
-__pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
+__pull_port_lb(struct sw_evdev *sw, struct sw_sched_shard *shard,
+		uint32_t port_id, int allow_reorder)
 {
-	static struct reorder_buffer_entry dummy_rob;
+	struct reorder_buffer_entry *dummy_rob = &shard->dummy_rob;
 	uint32_t pkts_iter = 0;
 	struct sw_port *port = &sw->ports[port_id];
 
@@ -372,9 +422,6 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 		if (!allow_reorder && !eop)
 			flags = QE_FLAG_VALID;
 
-		uint32_t iq_num = PRIO_TO_IQ(qe->priority);
-		struct sw_qid *qid = &sw->qids[qe->queue_id];
-
 		/* now process based on flags. Note that for directed
 		 * queues, the enqueue_flush masks off all but the
 		 * valid flag. This makes FWD and PARTIAL enqueues just
@@ -401,7 +448,7 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 				const uintptr_t valid = (rob_ptr != 0);
 				needs_reorder = valid;
 				rob_ptr |=
-					((valid - 1) & (uintptr_t)&dummy_rob);
+					((valid - 1) & (uintptr_t)dummy_rob);
 				struct reorder_buffer_entry *tmp_rob_ptr =
 					(struct reorder_buffer_entry *)rob_ptr;
 				tmp_rob_ptr->ready = eop * needs_reorder;
@@ -424,7 +471,7 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 				 */
 				int num_frag = rob_entry->num_fragments;
 				if (num_frag == SW_FRAGMENTS_MAX)
-					sw->stats.rx_dropped++;
+					shard->stats.rx_dropped++;
 				else {
 					int idx = rob_entry->num_fragments++;
 					rob_entry->fragments[idx] = *qe;
@@ -432,14 +479,7 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 				goto end_qe;
 			}
 
-			/* Use the iq_num from above to push the QE
-			 * into the qid at the right priority
-			 */
-
-			qid->iq_pkt_mask |= (1 << (iq_num));
-			iq_enqueue(sw, &qid->iq[iq_num], qe);
-			qid->iq_pkt_count[iq_num]++;
-			qid->stats.rx_pkts++;
+			sw_qid_enqueue(sw, shard, qe);
 			pkts_iter++;
 		}
 
@@ -452,19 +492,22 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 }
 
 static uint32_t
-sw_schedule_pull_port_lb(struct sw_evdev *sw, uint32_t port_id)
+sw_schedule_pull_port_lb(struct sw_evdev *sw, struct sw_sched_shard *shard,
+		uint32_t port_id)
 {
-	return __pull_port_lb(sw, port_id, 1);
+	return __pull_port_lb(sw, shard, port_id, 1);
 }
 
 static uint32_t
-sw_schedule_pull_port_no_reorder(struct sw_evdev *sw, uint32_t port_id)
+sw_schedule_pull_port_no_reorder(struct sw_evdev *sw,
+		struct sw_sched_shard *shard, uint32_t port_id)
 {
-	return __pull_port_lb(sw, port_id, 0);
+	return __pull_port_lb(sw, shard, port_id, 0);
 }
 
 static uint32_t
-sw_schedule_pull_port_dir(struct sw_evdev *sw, uint32_t port_id)
+sw_schedule_pull_port_dir(struct sw_evdev *sw, struct sw_sched_shard *shard,
+		uint32_t port_id)
 {
 	uint32_t pkts_iter = 0;
 	struct sw_port *port = &sw->ports[port_id];
@@ -480,19 +523,9 @@ sw_schedule_pull_port_dir(struct sw_evdev *sw, uint32_t port_id)
 		if ((flags & QE_FLAG_VALID) == 0)
 			goto end_qe;
 
-		uint32_t iq_num = PRIO_TO_IQ(qe->priority);
-		struct sw_qid *qid = &sw->qids[qe->queue_id];
-		struct sw_iq *iq = &qid->iq[iq_num];
-
 		port->stats.rx_pkts++;
 
-		/* Use the iq_num from above to push the QE
-		 * into the qid at the right priority
-		 */
-		qid->iq_pkt_mask |= (1 << (iq_num));
-		iq_enqueue(sw, iq, qe);
-		qid->iq_pkt_count[iq_num]++;
-		qid->stats.rx_pkts++;
+		sw_qid_enqueue(sw, shard, qe);
 		pkts_iter++;
 
 end_qe:
@@ -503,46 +536,65 @@ sw_schedule_pull_port_dir(struct sw_evdev *sw, uint32_t port_id)
 	return pkts_iter;
 }
 
-int32_t
-sw_event_schedule(struct rte_eventdev *dev)
+static uint32_t
+sw_schedule_pull_xfer(struct sw_evdev *sw, struct sw_sched_shard *shard)
+{
+	struct rte_event qes[SCHED_DEQUEUE_MAX_BURST_SIZE];
+	uint32_t i, n;
+
+	n = rte_event_ring_dequeue_burst(shard->xfer_ring, qes,
+			sw->sched_deq_burst_size, NULL);
+	for (i = 0; i < n; i++)
+		sw_qid_enqueue(sw, shard, &qes[i]);
+
+	return n;
+}
+
+static int32_t
+sw_schedule_shard(struct sw_evdev *sw, struct sw_sched_shard *shard)
 {
-	struct sw_evdev *sw = sw_pmd_priv(dev);
 	uint32_t in_pkts, out_pkts;
 	uint32_t out_pkts_total = 0, in_pkts_total = 0;
 	int32_t sched_quanta = sw->sched_quanta;
+	uint64_t xfer_pkts = shard->sched_xfer_pkts;
 	uint32_t i;
 
-	sw->sched_called++;
-	if (unlikely(!sw->started))
-		return -EAGAIN;
-
 	do {
 		uint32_t in_pkts_this_iteration = 0;
 
 		/* Pull from rx_ring for ports */
 		do {
 			in_pkts = 0;
-			for (i = 0; i < sw->port_count; i++) {
-				/* ack the unlinks in progress as done */
-				if (sw->ports[i].unlinks_in_progress)
-					sw->ports[i].unlinks_in_progress = 0;
+			for (i = 0; i < shard->port_count; i++) {
+				uint32_t port_id = shard->port_ids[i];
+				struct sw_port *port = &sw->ports[port_id];
 
-				if (sw->ports[i].is_directed)
-					in_pkts += sw_schedule_pull_port_dir(sw, i);
-				else if (sw->ports[i].num_ordered_qids > 0)
-					in_pkts += sw_schedule_pull_port_lb(sw, i);
+				/* ack the unlinks in progress as done */
+				if (port->unlinks_in_progress)
+					port->unlinks_in_progress = 0;
+
+				if (port->is_directed)
+					in_pkts += sw_schedule_pull_port_dir(sw,
+							shard, port_id);
+				else if (port->num_ordered_qids > 0)
+					in_pkts += sw_schedule_pull_port_lb(sw,
+							shard, port_id);
 				else
-					in_pkts += sw_schedule_pull_port_no_reorder(sw, i);
+					in_pkts += sw_schedule_pull_port_no_reorder(
+							sw, shard, port_id);
 			}
 
+			/* Pull the QEs handed over by other shards */
+			if (shard->xfer_ring != NULL)
+				in_pkts += sw_schedule_pull_xfer(sw, shard);
+
 			/* QID scan for re-ordered */
-			in_pkts += sw_schedule_reorder(sw, 0,
-					sw->qid_count);
+			in_pkts += sw_schedule_reorder(sw, shard);
 			in_pkts_this_iteration += in_pkts;
 		} while (in_pkts > 4 &&
 				(int)in_pkts_this_iteration < sched_quanta);
 
-		out_pkts = sw_schedule_qid_to_cq(sw);
+		out_pkts = sw_schedule_qid_to_cq(sw, shard);
 		out_pkts_total += out_pkts;
 		in_pkts_total += in_pkts_this_iteration;
 
@@ -550,14 +602,19 @@ sw_event_schedule(struct rte_eventdev *dev)
 			break;
 	} while ((int)out_pkts_total < sched_quanta);
 
-	sw->stats.tx_pkts += out_pkts_total;
-	sw->stats.rx_pkts += in_pkts_total;
+	/* QEs handed over to other shards are accounted there */
+	if (shard->xfer_ring != NULL)
+		sw_xfer_flush_all(sw, shard);
+	xfer_pkts = shard->sched_xfer_pkts - xfer_pkts;
 
-	sw->sched_no_iq_enqueues += (in_pkts_total == 0);
-	sw->sched_no_cq_enqueues += (out_pkts_total == 0);
+	shard->stats.tx_pkts += out_pkts_total;
+	shard->stats.rx_pkts += in_pkts_total - xfer_pkts;
+
+	shard->sched_no_iq_enqueues += (in_pkts_total == 0);
+	shard->sched_no_cq_enqueues += (out_pkts_total == 0);
 
 	uint64_t work_done = (in_pkts_total + out_pkts_total) != 0;
-	sw->sched_progress_last_iter = work_done;
+	shard->sched_progress_last_iter = work_done;
 
 	uint64_t cqs_scheds_last_iter = 0;
 
@@ -565,48 +622,96 @@ sw_event_schedule(struct rte_eventdev *dev)
 	 * worker cores: aka, do the ring transfers batched.
 	 */
 	int no_enq = 1;
-	for (i = 0; i < sw->port_count; i++) {
-		struct sw_port *port = &sw->ports[i];
+	for (i = 0; i < shard->port_count; i++) {
+		uint32_t port_id = shard->port_ids[i];
+		struct sw_port *port = &sw->ports[port_id];
 		struct rte_event_ring *worker = port->cq_worker_ring;
 
 		/* If shadow ring has 0 pkts, pull from worker ring */
 		if (sw->refill_once_per_iter && port->pp_buf_count == 0)
 			sw_refill_pp_buf(sw, port);
 
-		if (port->cq_buf_count >= sw->sched_min_burst) {
+		if (port->cq_buf_count >= shard->sched_min_burst) {
 			rte_event_ring_enqueue_burst(worker,
 					port->cq_buf,
 					port->cq_buf_count,
-					&sw->cq_ring_space[i]);
+					&sw->cq_ring_space[port_id]);
 			port->cq_buf_count = 0;
 			no_enq = 0;
-			cqs_scheds_last_iter |= (1ULL << i);
+			cqs_scheds_last_iter |= (1ULL << port_id);
 		} else {
-			sw->cq_ring_space[i] =
+			sw->cq_ring_space[port_id] =
 					rte_event_ring_free_count(worker) -
 					port->cq_buf_count;
 		}
 	}
 
 	if (no_enq) {
-		if (unlikely(sw->sched_flush_count > SCHED_NO_ENQ_CYCLE_FLUSH))
-			sw->sched_min_burst = 1;
+		if (unlikely(shard->sched_flush_count >
+				SCHED_NO_ENQ_CYCLE_FLUSH))
+			shard->sched_min_burst = 1;
 		else
-			sw->sched_flush_count++;
+			shard->sched_flush_count++;
 	} else {
-		if (sw->sched_flush_count)
-			sw->sched_flush_count--;
+		if (shard->sched_flush_count)
+			shard->sched_flush_count--;
 		else
-			sw->sched_min_burst = sw->sched_min_burst_size;
+			shard->sched_min_burst = sw->sched_min_burst_size;
 	}
 
 	/* Provide stats on what eventdev ports were scheduled to this
 	 * iteration. If more than 64 ports are active, always report that
 	 * all Eventdev ports have been scheduled events.
 	 */
-	sw->sched_last_iter_bitmask = cqs_scheds_last_iter;
+	shard->sched_last_iter_bitmask = cqs_scheds_last_iter;
 	if (unlikely(sw->port_count >= 64))
-		sw->sched_last_iter_bitmask = UINT64_MAX;
+		shard->sched_last_iter_bitmask = UINT64_MAX;
 
 	return work_done ? 0 : -EAGAIN;
 }
+
+int32_t
+sw_event_schedule(struct rte_eventdev *dev)
+{
+	struct sw_evdev *sw = sw_pmd_priv(dev);
+	int32_t ret = -EAGAIN;
+	uint32_t start, i;
+
+	if (sw->nb_shards == 1) {
+		sw->shards[0].sched_called++;
+		if (unlikely(!sw->started))
+			return -EAGAIN;
+
+		return sw_schedule_shard(sw, &sw->shards[0]);
+	}
+
+	if (unlikely(!sw->started))
+		return -EAGAIN;
+
+	/* The service may run on several lcores at once. Each lcore
+	 * starts with its own shard, and then schedules any shard not
+	 * being scheduled by another lcore, so that all shards make
+	 * progress whatever the number of service lcores.
+	 */
+	start = rte_lcore_id() % sw->nb_shards;
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_sched_shard *shard =
+			&sw->shards[(start + i) % sw->nb_shards];
+		uint64_t begin;
+
+		if (!rte_spinlock_trylock(&shard->lock))
+			continue;
+
+		begin = rte_get_timer_cycles();
+		shard->sched_called++;
+		if (sw_schedule_shard(sw, shard) == 0) {
+			shard->sched_busy_cycles +=
+				rte_get_timer_cycles() - begin;
+			ret = 0;
+		}
+
+		rte_spinlock_unlock(&shard->lock);
+	}
+
+	return ret;
+}
@@ -3303,6 +3303,129 @@ worker_loopback(struct test *t, uint8_t disable_implicit_release)
 	return 0;
 }
 
+static int
+sched_shards_xfer(struct test *t, uint8_t src_port, uint8_t dst_port,
+		struct rte_event *ev)
+{
+	const uint64_t magic = ev->u64;
+	int i;
+
+	if (rte_event_enqueue_burst(evdev, t->port[src_port], ev, 1) != 1) {
+		printf("%d: Failed to enqueue\n", __LINE__);
+		return -1;
+	}
+
+	/* one call for the source shard, one for the destination shard */
+	for (i = 0; i < 2; i++)
+		rte_service_run_iter_on_app_lcore(t->service_id, 1);
+
+	if (rte_event_dequeue_burst(evdev, t->port[dst_port], ev, 1, 0) != 1) {
+		printf("%d: Failed to dequeue from port %u\n", __LINE__,
+				dst_port);
+		rte_event_dev_dump(evdev, stdout);
+		return -1;
+	}
+	if (ev->u64 != magic) {
+		printf("%d: Wrong event dequeued\n", __LINE__);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+sched_shards(struct test *t)
+{
+	static const char * const xstats_names[] = {
+		"dev_shard_0_xfer", "dev_shard_1_xfer" };
+	const char *eventdev_name = "event_sw_shards";
+	const int evdev_saved = evdev;
+	const uint32_t service_id_saved = t->service_id;
+	struct rte_event ev = {
+		.op = RTE_EVENT_OP_NEW,
+		.priority = RTE_EVENT_DEV_PRIORITY_NORMAL,
+		.sched_type = RTE_SCHED_TYPE_ATOMIC,
+		.queue_id = 1,
+		.flow_id = 3,
+		.u64 = 0xcafe,
+	};
+	uint32_t service_id;
+	uint8_t qid;
+	unsigned int i;
+	int ret = -1;
+
+	if (rte_vdev_init(eventdev_name, "sched_shards=2") < 0) {
+		printf("%d: Error creating eventdev\n", __LINE__);
+		return -1;
+	}
+	evdev = rte_event_dev_get_dev_id(eventdev_name);
+	if (evdev < 0 ||
+			rte_event_dev_service_id_get(evdev, &service_id) < 0) {
+		printf("%d: Error finding eventdev service\n", __LINE__);
+		goto out;
+	}
+	rte_service_runstate_set(service_id, 1);
+	rte_service_set_runstate_mapped_check(service_id, 0);
+
+	/* Two pipeline stages, each on its own shard */
+	if (init(t, 2, 2) < 0 ||
+			create_ports(t, 2) < 0 ||
+			create_atomic_qids(t, 2) < 0) {
+		printf("%d: Error initializing device\n", __LINE__);
+		goto out_cleanup;
+	}
+	t->service_id = service_id;
+
+	for (i = 0; i < 2; i++) {
+		if (rte_event_port_link(evdev, t->port[i], &t->qid[i],
+				NULL, 1) != 1) {
+			printf("%d: error mapping qid %u\n", __LINE__, i);
+			goto out_cleanup;
+		}
+	}
+
+	if (rte_event_dev_start(evdev) < 0) {
+		printf("%d: Error with start call\n", __LINE__);
+		goto out_cleanup;
+	}
+
+	/* port 0 to qid 1, scheduled to port 1 by the other shard */
+	if (sched_shards_xfer(t, 0, 1, &ev) < 0)
+		goto out_cleanup;
+
+	/* and back to qid 0 */
+	ev.op = RTE_EVENT_OP_FORWARD;
+	ev.queue_id = 0;
+	if (sched_shards_xfer(t, 1, 0, &ev) < 0)
+		goto out_cleanup;
+
+	for (i = 0; i < RTE_DIM(xstats_names); i++) {
+		uint64_t val = rte_event_dev_xstats_by_name_get(evdev,
+				xstats_names[i], NULL);
+		if (val != 1) {
+			printf("%d: %s is %"PRIu64", expected 1\n", __LINE__,
+					xstats_names[i], val);
+			goto out_cleanup;
+		}
+	}
+
+	/* a link across the shards is refused once started */
+	qid = t->qid[1];
+	if (rte_event_port_link(evdev, t->port[0], &qid, NULL, 1) != 0) {
+		printf("%d: link across shards not refused\n", __LINE__);
+		goto out_cleanup;
+	}
+
+	ret = 0;
+out_cleanup:
+	cleanup(t);
+out:
+	evdev = evdev_saved;
+	t->service_id = service_id_saved;
+	rte_vdev_uninit(eventdev_name);
+	return ret;
+}
+
 static struct rte_mempool *eventdev_func_mempool;
 
 int
@@ -3521,6 +3644,12 @@ test_sw_eventdev(void)
 		printf("ERROR - Ordered & Atomic hist-list test FAILED.\n");
 		goto test_fail;
 	}
+	printf("*** Running Scheduler Shards test...\n");
+	ret = sched_shards(t);
+	if (ret != 0) {
+		printf("ERROR - Scheduler Shards test FAILED.\n");
+		goto test_fail;
+	}
 	if (rte_lcore_count() >= 3) {
 		printf("*** Running Worker loopback test...\n");
 		ret = worker_loopback(t, 0);
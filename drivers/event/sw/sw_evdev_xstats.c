@@ -19,6 +19,9 @@ enum xstats_type {
 	no_cq_enq,
 	sched_last_iter_bitmask,
 	sched_progress_last_iter,
+	/* scheduler shard specific */
+	xfer,
+	busy_cycles,
 	/* port_specific */
 	rx_used,
 	rx_free,
@@ -49,23 +52,50 @@ struct sw_xstats_entry {
 };
 
 static uint64_t
-get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
+get_shard_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 		enum xstats_type type, int extra_arg __rte_unused)
 {
+	const struct sw_sched_shard *shard = &sw->shards[obj_idx];
+
 	switch (type) {
-	case rx: return sw->stats.rx_pkts;
-	case tx: return sw->stats.tx_pkts;
-	case dropped: return sw->stats.rx_dropped;
-	case calls: return sw->sched_called;
-	case no_iq_enq: return sw->sched_no_iq_enqueues;
-	case no_cq_enq: return sw->sched_no_cq_enqueues;
-	case sched_last_iter_bitmask: return sw->sched_last_iter_bitmask;
-	case sched_progress_last_iter: return sw->sched_progress_last_iter;
+	case rx: return shard->stats.rx_pkts;
+	case tx: return shard->stats.tx_pkts;
+	case dropped: return shard->stats.rx_dropped;
+	case calls: return shard->sched_called;
+	case no_iq_enq: return shard->sched_no_iq_enqueues;
+	case no_cq_enq: return shard->sched_no_cq_enqueues;
+	case sched_last_iter_bitmask: return shard->sched_last_iter_bitmask;
+	case sched_progress_last_iter: return shard->sched_progress_last_iter;
+	case xfer: return shard->sched_xfer_pkts;
+	case busy_cycles: return shard->sched_busy_cycles;
 
 	default: return -1;
 	}
 }
 
+static uint64_t
+get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
+		enum xstats_type type, int extra_arg)
+{
+	uint64_t val = 0;
+	uint16_t i;
+
+	/* the device stats are the sum of the stats of its shards, except
+	 * the last iteration ones which are merged
+	 */
+	for (i = 0; i < sw->nb_shards; i++) {
+		uint64_t shard_val = get_shard_stat(sw, i, type, extra_arg);
+
+		if (type == sched_last_iter_bitmask ||
+				type == sched_progress_last_iter)
+			val |= shard_val;
+		else
+			val += shard_val;
+	}
+
+	return val;
+}
+
 static uint64_t
 get_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 		enum xstats_type type, int extra_arg __rte_unused)
@@ -190,6 +220,15 @@ sw_xstats_init(struct sw_evdev *sw)
 	};
 	/* all device stats are allowed to be reset */
 
+	static const char * const shard_stats[] = { "rx", "tx", "drop",
+			"xfer", "sched_calls", "sched_no_iq_enq",
+			"sched_no_cq_enq", "busy_cycles",
+	};
+	static const enum xstats_type shard_types[] = { rx, tx, dropped,
+			xfer, calls, no_iq_enq, no_cq_enq, busy_cycles,
+	};
+	/* all shard stats are allowed to be reset */
+
 	static const char * const port_stats[] = {"rx", "tx", "drop",
 			"inflight", "avg_pkt_cycles", "credits",
 			"rx_ring_used", "rx_ring_free",
@@ -238,6 +277,7 @@ sw_xstats_init(struct sw_evdev *sw)
 	 * joined by the compiler.
 	 */
 	RTE_BUILD_BUG_ON(RTE_DIM(dev_stats) != RTE_DIM(dev_types));
+	RTE_BUILD_BUG_ON(RTE_DIM(shard_stats) != RTE_DIM(shard_types));
 	RTE_BUILD_BUG_ON(RTE_DIM(port_stats) != RTE_DIM(port_types));
 	RTE_BUILD_BUG_ON(RTE_DIM(qid_stats) != RTE_DIM(qid_types));
 	RTE_BUILD_BUG_ON(RTE_DIM(qid_iq_stats) != RTE_DIM(qid_iq_types));
@@ -251,7 +291,11 @@ sw_xstats_init(struct sw_evdev *sw)
 	/* other vars */
 	const uint32_t cons_bkt_shift =
 		(MAX_SW_CONS_Q_DEPTH >> SW_DEQ_STAT_BUCKET_SHIFT);
+	/* per shard stats are only of interest with several shards */
+	const unsigned int nb_shard_stats =
+		sw->nb_shards > 1 ? sw->nb_shards : 0;
 	const unsigned int count = RTE_DIM(dev_stats) +
+			nb_shard_stats * RTE_DIM(shard_stats) +
 			sw->port_count * RTE_DIM(port_stats) +
 			sw->port_count * RTE_DIM(port_bucket_stats) *
 				(cons_bkt_shift + 1) +
@@ -259,7 +303,7 @@ sw_xstats_init(struct sw_evdev *sw)
 			sw->qid_count * SW_IQS_MAX * RTE_DIM(qid_iq_stats) +
 			sw->qid_count * sw->port_count *
 				RTE_DIM(qid_port_stats);
-	unsigned int i, port, qid, iq, bkt, stat = 0;
+	unsigned int i, shard, port, qid, iq, bkt, stat = 0;
 
 	sw->xstats = rte_zmalloc_socket(NULL, sizeof(sw->xstats[0]) * count, 0,
 			sw->data->socket_id);
@@ -276,6 +320,19 @@ sw_xstats_init(struct sw_evdev *sw)
 		};
 		snprintf(sname, sizeof(sname), "dev_%s", dev_stats[i]);
 	}
+	for (shard = 0; shard < nb_shard_stats; shard++) {
+		for (i = 0; i < RTE_DIM(shard_stats); i++, stat++) {
+			sw->xstats[stat] = (struct sw_xstats_entry){
+				.fn = get_shard_stat,
+				.obj_idx = shard,
+				.stat = shard_types[i],
+				.mode = RTE_EVENT_DEV_XSTATS_DEVICE,
+				.reset_allowed = 1,
+			};
+			snprintf(sname, sizeof(sname), "dev_shard_%u_%s",
+					shard, shard_stats[i]);
+		}
+	}
 	sw->xstats_count_mode_dev = stat;
 
 	for (port = 0; port < sw->port_count; port++) {
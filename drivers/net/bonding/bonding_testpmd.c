@@ -177,6 +177,8 @@ static void cmd_set_bonding_balance_xmit_policy_parsed(void *parsed_result,
 		policy = BALANCE_XMIT_POLICY_LAYER23;
 	} else if (!strcmp(res->policy, "l34")) {
 		policy = BALANCE_XMIT_POLICY_LAYER34;
+	} else if (!strcmp(res->policy, "flowlet")) {
+		policy = BALANCE_XMIT_POLICY_FLOWLET;
 	} else {
 		fprintf(stderr, "\t Invalid xmit policy selection");
 		return;
@@ -204,12 +206,12 @@ static cmdline_parse_token_num_t cmd_setbonding_balance_xmit_policy_port =
 		port_id, RTE_UINT16);
 static cmdline_parse_token_string_t cmd_setbonding_balance_xmit_policy_policy =
 	TOKEN_STRING_INITIALIZER(struct cmd_set_bonding_balance_xmit_policy_result,
-		policy, "l2#l23#l34");
+		policy, "l2#l23#l34#flowlet");
 
 static cmdline_parse_inst_t cmd_set_balance_xmit_policy = {
 	.f = cmd_set_bonding_balance_xmit_policy_parsed,
 	.help_str = "set bonding balance_xmit_policy <port_id> "
-		"l2|l23|l34: "
+		"l2|l23|l34|flowlet: "
 		"Set the bonding balance_xmit_policy for port_id",
 	.data = NULL,
 	.tokens = {
@@ -731,7 +733,7 @@ static struct testpmd_driver_commands bonding_cmds = {
 	},
 	{
 		&cmd_set_balance_xmit_policy,
-		"set bonding balance_xmit_policy (port_id) (l2|l23|l34)\n"
+		"set bonding balance_xmit_policy (port_id) (l2|l23|l34|flowlet)\n"
 		"	Set the transmit balance policy for bonding device running in balance mode.\n",
 	},
 	{
@@ -32,6 +32,7 @@
 #define PMD_BOND_XMIT_POLICY_LAYER2_KVARG	("l2")
 #define PMD_BOND_XMIT_POLICY_LAYER23_KVARG	("l23")
 #define PMD_BOND_XMIT_POLICY_LAYER34_KVARG	("l34")
+#define PMD_BOND_XMIT_POLICY_FLOWLET_KVARG	("flowlet")
 
 extern int bond_logtype;
 #define RTE_LOGTYPE_BOND bond_logtype
@@ -47,6 +48,11 @@ extern struct rte_vdev_driver pmd_bond_drv;
 
 extern const struct rte_flow_ops bond_flow_ops;
 
+/** Consecutive empty polls after which a member is considered idle */
+#define BOND_RX_EMPTY_POLL_THRESH	8
+/** Idle members are only polled once every this number of Rx bursts */
+#define BOND_RX_IDLE_POLL_PERIOD	8
+
 /** Port Queue Mapping Structure */
 struct bond_rx_queue {
 	uint16_t queue_id;
@@ -61,6 +67,34 @@ struct bond_rx_queue {
 	/**< Copy of RX configuration structure for queue */
 	struct rte_mempool *mb_pool;
 	/**< Reference to mbuf pool to use for RX queue */
+	uint32_t poll_count;
+	/**< Number of Rx bursts done on this queue */
+	uint16_t nb_empty_polls;
+	/**< Number of entries in empty_polls */
+	uint16_t empty_polls_members;
+	/**< Active member count for which empty_polls is valid */
+	uint8_t *empty_polls;
+	/**< Consecutive empty polls of each active member, if idle skip is on */
+};
+
+/** Number of flowlet entries per Tx queue, must be a power of 2 */
+#define BOND_FLOWLET_TABLE_SIZE		4096
+/** Idle time in microseconds after which a flow may change member */
+#define BOND_FLOWLET_GAP_US		500
+/** Bytes accounted for each used descriptor of a member Tx queue */
+#define BOND_FLOWLET_DESC_BYTES		1024
+#define BOND_FLOWLET_PORT_SHIFT		48
+#define BOND_FLOWLET_TSC_MASK		((UINT64_C(1) << BOND_FLOWLET_PORT_SHIFT) - 1)
+
+/** Flowlet policy state of a Tx queue */
+struct bond_flowlet_state {
+	uint64_t entries[BOND_FLOWLET_TABLE_SIZE];
+	/**< Member port id + 1 in the upper 16 bits, last Tx TSC in the others */
+	uint64_t member_bytes[RTE_MAX_ETHPORTS];
+	/**< Bytes recently sent per member port, halved every flowlet gap */
+	uint64_t last_decay_tsc;
+	uint64_t gap_tsc;
+	/**< Flowlet gap in TSC cycles */
 };
 
 struct bond_tx_queue {
@@ -72,6 +106,8 @@ struct bond_tx_queue {
 	/**< Number of TX descriptors available for the queue */
 	struct rte_eth_txconf tx_conf;
 	/**< Copy of TX configuration structure for queue */
+	struct bond_flowlet_state *flowlet;
+	/**< State of the flowlet transmit policy, only allocated with it */
 };
 
 /** Bonding member devices structure */
@@ -131,6 +167,9 @@ struct bond_dev_private {
 	uint32_t link_down_delay_ms;
 	uint32_t link_up_delay_ms;
 
+	uint8_t rx_idle_skip;
+	/**< Flag for whether idle members are polled less often on Rx */
+
 	uint32_t speed_capa;
 	/**< Supported speeds bitmap (RTE_ETH_LINK_SPEED_). */
 
@@ -277,6 +316,9 @@ void
 burst_xmit_l34_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
 		uint16_t member_count, uint16_t *members);
 
+int
+bond_ethdev_flowlet_setup(struct rte_eth_dev *eth_dev);
+
 
 void
 bond_ethdev_primary_set(struct bond_dev_private *internals,
@@ -17,6 +17,7 @@
  * load balancing of network ports
  */
 
+#include <rte_compat.h>
 #include <rte_ether.h>
 
 #ifdef __cplusplus
@@ -91,6 +92,9 @@ extern "C" {
 /**< Layer 2+3 (Ethernet MAC + IP Addresses) transmit load balancing */
 #define BALANCE_XMIT_POLICY_LAYER34		(2)
 /**< Layer 3+4 (IP Addresses + UDP Ports) transmit load balancing */
+#define BALANCE_XMIT_POLICY_FLOWLET		(3)
+/**< Layer 3+4 flowlets placed on the least loaded member; a flow keeps its
+ * member until it is idle for longer than the flowlet gap */
 
 /**
  * Create a bonding rte_eth_dev device
@@ -347,6 +351,43 @@ rte_eth_bond_link_up_prop_delay_set(uint16_t bonding_port_id,
 int
 rte_eth_bond_link_up_prop_delay_get(uint16_t bonding_port_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enable or disable the skipping of idle members on Rx.
+ * When enabled, a member which returned no packet for several consecutive
+ * polls of a queue is only polled once every few Rx bursts of this queue,
+ * until it returns packets again. Packets received by such a member may
+ * then only be returned by a later Rx burst. Disabled by default.
+ *
+ * The bonding device must be stopped.
+ *
+ * @param bonding_port_id	Port ID of bonding device.
+ * @param enable		1 to enable, 0 to disable.
+ *
+ * @return
+ *  0 on success, negative value otherwise.
+ */
+__rte_experimental
+int
+rte_eth_bond_rx_idle_skip_set(uint16_t bonding_port_id, uint8_t enable);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get whether idle members are skipped on Rx.
+ *
+ * @param bonding_port_id	Port ID of bonding device.
+ *
+ * @return
+ *  1 if enabled, 0 if disabled, negative value otherwise.
+ */
+__rte_experimental
+int
+rte_eth_bond_rx_idle_skip_get(uint16_t bonding_port_id);
+
 
 #ifdef __cplusplus
 }
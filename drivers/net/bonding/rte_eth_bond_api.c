@@ -1005,6 +1005,11 @@ rte_eth_bond_xmit_policy_set(uint16_t bonding_port_id, uint8_t policy)
 		internals->balance_xmit_policy = policy;
 		internals->burst_xmit_hash = burst_xmit_l23_hash;
 		break;
+	case BALANCE_XMIT_POLICY_FLOWLET:
+		if (bond_ethdev_flowlet_setup(
+				&rte_eth_devices[bonding_port_id]) != 0)
+			return -1;
+		/* fall through */
 	case BALANCE_XMIT_POLICY_LAYER34:
 		internals->balance_xmit_policy = policy;
 		internals->burst_xmit_hash = burst_xmit_l34_hash;
@@ -1114,3 +1119,38 @@ rte_eth_bond_link_up_prop_delay_get(uint16_t bonding_port_id)
 
 	return internals->link_up_delay_ms;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_bond_rx_idle_skip_set, 25.07)
+int
+rte_eth_bond_rx_idle_skip_set(uint16_t bonding_port_id, uint8_t enable)
+{
+	struct rte_eth_dev *bonding_eth_dev;
+	struct bond_dev_private *internals;
+
+	if (valid_bonding_port_id(bonding_port_id) != 0)
+		return -1;
+
+	bonding_eth_dev = &rte_eth_devices[bonding_port_id];
+	/* The Rx queue state is allocated at start */
+	if (bonding_eth_dev->data->dev_started)
+		return -1;
+
+	internals = bonding_eth_dev->data->dev_private;
+	internals->rx_idle_skip = enable ? 1 : 0;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_bond_rx_idle_skip_get, 25.07)
+int
+rte_eth_bond_rx_idle_skip_get(uint16_t bonding_port_id)
+{
+	struct bond_dev_private *internals;
+
+	if (valid_bonding_port_id(bonding_port_id) != 0)
+		return -1;
+
+	internals = rte_eth_devices[bonding_port_id].data->dev_private;
+
+	return internals->rx_idle_skip;
+}
@@ -20,6 +20,7 @@
 #include <rte_alarm.h>
 #include <rte_cycles.h>
 #include <rte_string_fns.h>
+#include <rte_vect.h>
 
 #include "rte_eth_bond.h"
 #include "eth_bond_private.h"
@@ -56,6 +57,45 @@ get_vlan_offset(struct rte_ether_hdr *eth_hdr, uint16_t *proto)
 	return vlan_offset;
 }
 
+/*
+ * When idle member skipping is enabled, a member which returned no packet
+ * for several polls is only polled once every BOND_RX_IDLE_POLL_PERIOD
+ * bursts, so that the busy members of a large bond do not pay for the
+ * empty polls of the idle ones. The empty polls are counted per position
+ * in the active member list, and are reset when this list changes size.
+ * Members beyond the count allocated at start are always polled.
+ */
+static inline void
+bond_rx_idle_update(struct bond_rx_queue *bd_rx_q, uint16_t member_count)
+{
+	bd_rx_q->poll_count++;
+	if (unlikely(bd_rx_q->empty_polls_members != member_count)) {
+		if (bd_rx_q->empty_polls != NULL)
+			memset(bd_rx_q->empty_polls, 0, bd_rx_q->nb_empty_polls);
+		bd_rx_q->empty_polls_members = member_count;
+	}
+}
+
+static inline bool
+bond_rx_member_idle(const struct bond_rx_queue *bd_rx_q, uint16_t idx)
+{
+	return idx < bd_rx_q->nb_empty_polls &&
+		bd_rx_q->empty_polls[idx] >= BOND_RX_EMPTY_POLL_THRESH &&
+		(bd_rx_q->poll_count % BOND_RX_IDLE_POLL_PERIOD) != 0;
+}
+
+static inline void
+bond_rx_member_polled(struct bond_rx_queue *bd_rx_q, uint16_t idx,
+		uint16_t nb_rx)
+{
+	if (idx >= bd_rx_q->nb_empty_polls)
+		return;
+	if (nb_rx != 0)
+		bd_rx_q->empty_polls[idx] = 0;
+	else if (bd_rx_q->empty_polls[idx] < BOND_RX_EMPTY_POLL_THRESH)
+		bd_rx_q->empty_polls[idx]++;
+}
+
 static uint16_t
 bond_ethdev_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -64,6 +104,8 @@ bond_ethdev_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	uint16_t num_rx_total = 0;
 	uint16_t member_count;
 	uint16_t active_member;
+	uint16_t member_port;
+	uint16_t member_idx;
 	int i;
 
 	/* Cast to structure, containing bonding device's port id and queue id */
@@ -71,22 +113,34 @@ bond_ethdev_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	internals = bd_rx_q->dev_private;
 	member_count = internals->active_member_count;
 	active_member = bd_rx_q->active_member;
+	if (active_member >= member_count)
+		active_member = 0;
+	bond_rx_idle_update(bd_rx_q, member_count);
 
+	/*
+	 * Start from a different member at each call, so that the members
+	 * share the burst in a round-robin fashion.
+	 */
 	for (i = 0; i < member_count && nb_pkts; i++) {
 		uint16_t num_rx_member;
 
+		member_idx = active_member;
+		member_port = internals->active_members[member_idx];
+		if (++active_member >= member_count)
+			active_member = 0;
+		if (bond_rx_member_idle(bd_rx_q, member_idx))
+			continue;
+
 		/*
 		 * Offset of pointer to *bufs increases as packets are received
 		 * from other members.
 		 */
-		num_rx_member =
-			rte_eth_rx_burst(internals->active_members[active_member],
+		num_rx_member = rte_eth_rx_burst(member_port,
 					 bd_rx_q->queue_id,
 					 bufs + num_rx_total, nb_pkts);
+		bond_rx_member_polled(bd_rx_q, member_idx, num_rx_member);
 		num_rx_total += num_rx_member;
 		nb_pkts -= num_rx_member;
-		if (++active_member >= member_count)
-			active_member = 0;
 	}
 
 	if (++bd_rx_q->active_member >= member_count)
@@ -292,6 +346,57 @@ is_bond_mac_addr(const struct rte_ether_addr *ea,
 	return false;
 }
 
+/*
+ * Classify the Ethernet header of up to 64 packets: set the packet bit in
+ * *slow for slow protocol frames, and in *foreign when the destination is
+ * not the primary bonding MAC address. The header is compared with a single
+ * vector operation where available.
+ */
+static inline void
+rx_burst_8023ad_classify(struct rte_mbuf **bufs, uint16_t nb_pkts,
+		const struct rte_ether_addr *bond_mac, uint64_t *slow,
+		uint64_t *foreign)
+{
+	uint64_t slow_mask = 0, foreign_mask = 0;
+	uint16_t i;
+
+#if defined(RTE_ARCH_X86)
+	/* Primary MAC in bytes 0-5, slow protocol Ethernet type in 12-13 */
+	const __m128i pattern = _mm_set_epi8(0, 0,
+			RTE_ETHER_TYPE_SLOW & 0xff, RTE_ETHER_TYPE_SLOW >> 8,
+			0, 0, 0, 0, 0, 0,
+			bond_mac->addr_bytes[5], bond_mac->addr_bytes[4],
+			bond_mac->addr_bytes[3], bond_mac->addr_bytes[2],
+			bond_mac->addr_bytes[1], bond_mac->addr_bytes[0]);
+
+	for (i = 0; i < nb_pkts; i++) {
+		const __m128i hdr = _mm_loadu_si128(
+				rte_pktmbuf_mtod(bufs[i], const __m128i *));
+		const int match = _mm_movemask_epi8(
+				_mm_cmpeq_epi8(hdr, pattern));
+
+		slow_mask |= (uint64_t)((match & 0x3000) == 0x3000) << i;
+		foreign_mask |= (uint64_t)((match & 0x3f) != 0x3f) << i;
+	}
+#else
+	const uint16_t ether_type_slow_be =
+		rte_be_to_cpu_16(RTE_ETHER_TYPE_SLOW);
+
+	for (i = 0; i < nb_pkts; i++) {
+		const struct rte_ether_hdr *hdr =
+			rte_pktmbuf_mtod(bufs[i], const struct rte_ether_hdr *);
+
+		slow_mask |= (uint64_t)(hdr->ether_type == ether_type_slow_be)
+				<< i;
+		foreign_mask |= (uint64_t)!rte_is_same_ether_addr(
+				&hdr->dst_addr, bond_mac) << i;
+	}
+#endif
+
+	*slow = slow_mask;
+	*foreign = foreign_mask;
+}
+
 static inline uint16_t
 rx_burst_8023ad(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts,
 		bool dedicated_rxq)
@@ -313,10 +418,14 @@ rx_burst_8023ad(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts,
 	uint8_t collecting;  /* current member collecting status */
 	const uint8_t promisc = rte_eth_promiscuous_get(internals->port_id);
 	const uint8_t allmulti = rte_eth_allmulticast_get(internals->port_id);
+	uint64_t slow, foreign, check;
 	uint8_t subtype;
+	uint16_t m;
 	uint16_t i;
 	uint16_t j;
 	uint16_t k;
+	uint16_t n;
+	uint16_t num_rx_member;
 
 	/* Copy member list to protect against member up/down changes during tx
 	 * bursting */
@@ -329,62 +438,96 @@ rx_burst_8023ad(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts,
 		bd_rx_q->active_member = 0;
 		idx = 0;
 	}
-	for (i = 0; i < member_count && num_rx_total < nb_pkts; i++) {
-		j = num_rx_total;
-		collecting = ACTOR_STATE(&bond_mode_8023ad_ports[members[idx]],
+	bond_rx_idle_update(bd_rx_q, member_count);
+
+	for (m = 0; m < member_count && num_rx_total < nb_pkts; m++) {
+		uint16_t member_idx = idx;
+		uint16_t member_port = members[member_idx];
+
+		if (unlikely(++idx == member_count))
+			idx = 0;
+		if (bond_rx_member_idle(bd_rx_q, member_idx))
+			continue;
+
+		collecting = ACTOR_STATE(&bond_mode_8023ad_ports[member_port],
 					 COLLECTING);
 
 		/* Read packets from this member */
-		num_rx_total += rte_eth_rx_burst(members[idx], bd_rx_q->queue_id,
+		num_rx_member = rte_eth_rx_burst(member_port, bd_rx_q->queue_id,
 				&bufs[num_rx_total], nb_pkts - num_rx_total);
+		bond_rx_member_polled(bd_rx_q, member_idx, num_rx_member);
+
+		/*
+		 * Packets are filtered in place, j is the next free position
+		 * and k the next packet to look at.
+		 */
+		j = num_rx_total;
+		num_rx_total += num_rx_member;
+		for (k = j; k < num_rx_total; k += n) {
+			n = RTE_MIN(num_rx_total - k, 64);
 
-		for (k = j; k < 2 && k < num_rx_total; k++)
-			rte_prefetch0(rte_pktmbuf_mtod(bufs[k], void *));
-
-		/* Handle slow protocol packets. */
-		while (j < num_rx_total) {
-			if (j + 3 < num_rx_total)
-				rte_prefetch0(rte_pktmbuf_mtod(bufs[j + 3], void *));
-
-			hdr = rte_pktmbuf_mtod(bufs[j], struct rte_ether_hdr *);
-			subtype = ((struct slow_protocol_frame *)hdr)->slow_protocol.subtype;
-
-			/* Remove packet from array if:
-			 * - it is slow packet but no dedicated rxq is present,
-			 * - member is not in collecting state,
-			 * - bonding interface is not in promiscuous mode and
-			 *   packet address isn't in mac_addrs array:
-			 *   - packet is unicast,
-			 *   - packet is multicast and bonding interface
-			 *     is not in allmulti,
+			/* Prefetch the headers of the whole member burst */
+			for (i = k; i < k + n; i++)
+				rte_prefetch0(rte_pktmbuf_mtod(bufs[i], void *));
+
+			rx_burst_8023ad_classify(&bufs[k], n, &bond_mac[0],
+					&slow, &foreign);
+
+			/*
+			 * Only slow frames, and frames not sent to the primary
+			 * address when not promiscuous, need a closer look.
 			 */
-			if (unlikely(
-				(!dedicated_rxq &&
-				 is_lacp_packets(hdr->ether_type, subtype,
-						 bufs[j])) ||
-				!collecting ||
-				(!promisc &&
-				 !is_bond_mac_addr(&hdr->dst_addr, bond_mac,
-						   BOND_MAX_MAC_ADDRS) &&
-				 (rte_is_unicast_ether_addr(&hdr->dst_addr) ||
-				  !allmulti)))) {
-				if (hdr->ether_type == ether_type_slow_be) {
-					bond_mode_8023ad_handle_slow_pkt(
-					    internals, members[idx], bufs[j]);
-				} else
-					rte_pktmbuf_free(bufs[j]);
+			check = slow | (promisc ? 0 : foreign);
+			if (likely(check == 0 && collecting)) {
+				if (j != k)
+					memmove(&bufs[j], &bufs[k],
+						sizeof(bufs[0]) * n);
+				j += n;
+				continue;
+			}
+
+			for (i = 0; i < n; i++) {
+				struct rte_mbuf *pkt = bufs[k + i];
 
-				/* Packet is managed by mode 4 or dropped, shift the array */
-				num_rx_total--;
-				if (j < num_rx_total) {
-					memmove(&bufs[j], &bufs[j + 1], sizeof(bufs[0]) *
-						(num_rx_total - j));
+				if (likely(collecting &&
+						(check & RTE_BIT64(i)) == 0)) {
+					bufs[j++] = pkt;
+					continue;
 				}
-			} else
-				j++;
+
+				hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr *);
+				subtype = ((struct slow_protocol_frame *)hdr)->slow_protocol.subtype;
+
+				/* Remove packet from array if:
+				 * - it is slow packet but no dedicated rxq is present,
+				 * - member is not in collecting state,
+				 * - bonding interface is not in promiscuous mode and
+				 *   packet address isn't in mac_addrs array:
+				 *   - packet is unicast,
+				 *   - packet is multicast and bonding interface
+				 *     is not in allmulti,
+				 */
+				if (unlikely(
+					(!dedicated_rxq &&
+					 is_lacp_packets(hdr->ether_type, subtype,
+							 pkt)) ||
+					!collecting ||
+					(!promisc &&
+					 !is_bond_mac_addr(&hdr->dst_addr, bond_mac,
+							   BOND_MAX_MAC_ADDRS) &&
+					 (rte_is_unicast_ether_addr(&hdr->dst_addr) ||
+					  !allmulti)))) {
+					if (hdr->ether_type == ether_type_slow_be) {
+						bond_mode_8023ad_handle_slow_pkt(
+						    internals, member_port, pkt);
+					} else
+						rte_pktmbuf_free(pkt);
+				} else
+					bufs[j++] = pkt;
+			}
 		}
-		if (unlikely(++idx == member_count))
-			idx = 0;
+		/* Packets managed by mode 4 or dropped are not returned */
+		num_rx_total = j;
 	}
 
 	if (++bd_rx_q->active_member >= member_count)
@@ -755,77 +898,151 @@ burst_xmit_l23_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
 	}
 }
 
-void
-burst_xmit_l34_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
-		uint16_t member_count, uint16_t *members)
+static inline uint32_t
+l34_hash(struct rte_mbuf *buf)
 {
 	struct rte_ether_hdr *eth_hdr;
 	uint16_t proto;
 	size_t vlan_offset;
-	int i;
 
 	struct rte_udp_hdr *udp_hdr;
 	struct rte_tcp_hdr *tcp_hdr;
 	uint32_t hash, l3hash, l4hash;
 
-	for (i = 0; i < nb_pkts; i++) {
-		eth_hdr = rte_pktmbuf_mtod(buf[i], struct rte_ether_hdr *);
-		size_t pkt_end = (size_t)eth_hdr + rte_pktmbuf_data_len(buf[i]);
-		proto = eth_hdr->ether_type;
-		vlan_offset = get_vlan_offset(eth_hdr, &proto);
-		l3hash = 0;
-		l4hash = 0;
+	eth_hdr = rte_pktmbuf_mtod(buf, struct rte_ether_hdr *);
+	size_t pkt_end = (size_t)eth_hdr + rte_pktmbuf_data_len(buf);
+	proto = eth_hdr->ether_type;
+	vlan_offset = get_vlan_offset(eth_hdr, &proto);
+	l3hash = 0;
+	l4hash = 0;
+
+	if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
+		struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		size_t ip_hdr_offset;
+
+		l3hash = ipv4_hash(ipv4_hdr);
+
+		/* there is no L4 header in fragmented packet */
+		if (likely(rte_ipv4_frag_pkt_is_fragmented(ipv4_hdr) == 0)) {
+			ip_hdr_offset = (ipv4_hdr->version_ihl
+				& RTE_IPV4_HDR_IHL_MASK) *
+				RTE_IPV4_IHL_MULTIPLIER;
+
+			if (ipv4_hdr->next_proto_id == IPPROTO_TCP) {
+				tcp_hdr = (struct rte_tcp_hdr *)
+					((char *)ipv4_hdr + ip_hdr_offset);
+				if ((size_t)tcp_hdr + sizeof(*tcp_hdr)
+						<= pkt_end)
+					l4hash = HASH_L4_PORTS(tcp_hdr);
+			} else if (ipv4_hdr->next_proto_id == IPPROTO_UDP) {
+				udp_hdr = (struct rte_udp_hdr *)
+					((char *)ipv4_hdr + ip_hdr_offset);
+				if ((size_t)udp_hdr + sizeof(*udp_hdr)
+						< pkt_end)
+					l4hash = HASH_L4_PORTS(udp_hdr);
+			}
+		}
+	} else if  (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
+		struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		l3hash = ipv6_hash(ipv6_hdr);
+
+		if (ipv6_hdr->proto == IPPROTO_TCP) {
+			tcp_hdr = (struct rte_tcp_hdr *)(ipv6_hdr + 1);
+			l4hash = HASH_L4_PORTS(tcp_hdr);
+		} else if (ipv6_hdr->proto == IPPROTO_UDP) {
+			udp_hdr = (struct rte_udp_hdr *)(ipv6_hdr + 1);
+			l4hash = HASH_L4_PORTS(udp_hdr);
+		}
+	}
 
-		if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
-			struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			size_t ip_hdr_offset;
+	hash = l3hash ^ l4hash;
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
 
-			l3hash = ipv4_hash(ipv4_hdr);
+	return hash;
+}
 
-			/* there is no L4 header in fragmented packet */
-			if (likely(rte_ipv4_frag_pkt_is_fragmented(ipv4_hdr)
-								== 0)) {
-				ip_hdr_offset = (ipv4_hdr->version_ihl
-					& RTE_IPV4_HDR_IHL_MASK) *
-					RTE_IPV4_IHL_MULTIPLIER;
-
-				if (ipv4_hdr->next_proto_id == IPPROTO_TCP) {
-					tcp_hdr = (struct rte_tcp_hdr *)
-						((char *)ipv4_hdr +
-							ip_hdr_offset);
-					if ((size_t)tcp_hdr + sizeof(*tcp_hdr)
-							<= pkt_end)
-						l4hash = HASH_L4_PORTS(tcp_hdr);
-				} else if (ipv4_hdr->next_proto_id ==
-								IPPROTO_UDP) {
-					udp_hdr = (struct rte_udp_hdr *)
-						((char *)ipv4_hdr +
-							ip_hdr_offset);
-					if ((size_t)udp_hdr + sizeof(*udp_hdr)
-							< pkt_end)
-						l4hash = HASH_L4_PORTS(udp_hdr);
-				}
-			}
-		} else if  (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
-			struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			l3hash = ipv6_hash(ipv6_hdr);
+void
+burst_xmit_l34_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
+		uint16_t member_count, uint16_t *members)
+{
+	int i;
+
+	for (i = 0; i < nb_pkts; i++)
+		members[i] = l34_hash(buf[i]) % member_count;
+}
+
+/*
+ * Select the member of each packet with the flowlet policy.
+ *
+ * Packets of a flow are sent on the same member as long as the flow keeps
+ * sending. Once the flow was idle for longer than the flowlet gap, its next
+ * packets start a new flowlet, which is placed on the least loaded member.
+ * The load of a member is estimated from the bytes recently sent on it
+ * through this queue and from the occupancy of its Tx queue.
+ */
+static void
+burst_xmit_flowlet(struct bond_tx_queue *bd_tx_q, struct rte_mbuf **buf,
+		uint16_t nb_pkts, uint16_t *member_port_ids, uint16_t member_count,
+		uint16_t *members)
+{
+	struct bond_flowlet_state *fl = bd_tx_q->flowlet;
+	uint64_t load[RTE_MAX_ETHPORTS];
+	bool load_valid = false;
+	uint64_t now = rte_rdtsc();
+	uint64_t *entry;
+	uint32_t len;
+	uint16_t i, j, idx;
+	int used;
+
+	/* Forget the bytes sent a few periods ago */
+	if (now - fl->last_decay_tsc > fl->gap_tsc) {
+		for (i = 0; i < RTE_MAX_ETHPORTS; i++)
+			fl->member_bytes[i] >>= 1;
+		fl->last_decay_tsc = now;
+	}
 
-			if (ipv6_hdr->proto == IPPROTO_TCP) {
-				tcp_hdr = (struct rte_tcp_hdr *)(ipv6_hdr + 1);
-				l4hash = HASH_L4_PORTS(tcp_hdr);
-			} else if (ipv6_hdr->proto == IPPROTO_UDP) {
-				udp_hdr = (struct rte_udp_hdr *)(ipv6_hdr + 1);
-				l4hash = HASH_L4_PORTS(udp_hdr);
+	for (i = 0; i < nb_pkts; i++) {
+		entry = &fl->entries[l34_hash(buf[i]) &
+				(BOND_FLOWLET_TABLE_SIZE - 1)];
+		idx = member_count;
+
+		/* Keep the member of an active flowlet if still usable */
+		if (*entry != 0 && ((now - *entry) & BOND_FLOWLET_TSC_MASK) <
+				fl->gap_tsc)
+			idx = find_member_by_id(member_port_ids, member_count,
+					(*entry >> BOND_FLOWLET_PORT_SHIFT) - 1);
+
+		if (idx == member_count) {
+			if (!load_valid) {
+				for (j = 0; j < member_count; j++) {
+					load[j] = fl->member_bytes[member_port_ids[j]];
+					used = rte_eth_tx_queue_count(
+							member_port_ids[j],
+							bd_tx_q->queue_id);
+					if (used > 0)
+						load[j] += (uint64_t)used *
+							BOND_FLOWLET_DESC_BYTES;
+				}
+				load_valid = true;
 			}
+			idx = 0;
+			for (j = 1; j < member_count; j++)
+				if (load[j] < load[idx])
+					idx = j;
 		}
 
-		hash = l3hash ^ l4hash;
-		hash ^= hash >> 16;
-		hash ^= hash >> 8;
+		*entry = (now & BOND_FLOWLET_TSC_MASK) |
+				((uint64_t)(member_port_ids[idx] + 1) <<
+					BOND_FLOWLET_PORT_SHIFT);
+		members[i] = idx;
 
-		members[i] = hash % member_count;
+		len = rte_pktmbuf_pkt_len(buf[i]);
+		fl->member_bytes[member_port_ids[idx]] += len;
+		if (load_valid)
+			load[idx] += len;
 	}
 }
 
@@ -1176,8 +1393,13 @@ tx_burst_balance(void *queue, struct rte_mbuf **bufs, uint16_t nb_bufs,
 	 * Populate members mbuf with the packets which are to be sent on it
 	 * selecting output member using hash based on xmit policy
 	 */
-	internals->burst_xmit_hash(bufs, nb_bufs, member_count,
-			bufs_member_port_idxs);
+	if (internals->balance_xmit_policy == BALANCE_XMIT_POLICY_FLOWLET &&
+			bd_tx_q->flowlet != NULL)
+		burst_xmit_flowlet(bd_tx_q, bufs, nb_bufs, member_port_ids,
+				member_count, bufs_member_port_idxs);
+	else
+		internals->burst_xmit_hash(bufs, nb_bufs, member_count,
+				bufs_member_port_idxs);
 
 	for (i = 0; i < nb_bufs; i++) {
 		/* Populate member mbuf arrays with mbufs for that member. */
@@ -2015,6 +2237,40 @@ bond_ethdev_primary_set(struct bond_dev_private *internals,
 static int
 bond_ethdev_promiscuous_enable(struct rte_eth_dev *eth_dev);
 
+/*
+ * Size the empty poll counters of the Rx queues by the member count,
+ * only when idle member skipping is enabled.
+ */
+static int
+bond_ethdev_rx_idle_setup(struct rte_eth_dev *eth_dev)
+{
+	struct bond_dev_private *internals = eth_dev->data->dev_private;
+	struct bond_rx_queue *bd_rx_q;
+	uint16_t i;
+
+	for (i = 0; i < eth_dev->data->nb_rx_queues; i++) {
+		bd_rx_q = eth_dev->data->rx_queues[i];
+		if (bd_rx_q == NULL)
+			continue;
+
+		rte_free(bd_rx_q->empty_polls);
+		bd_rx_q->empty_polls = NULL;
+		bd_rx_q->nb_empty_polls = 0;
+		bd_rx_q->empty_polls_members = 0;
+		if (!internals->rx_idle_skip)
+			continue;
+
+		bd_rx_q->empty_polls = rte_zmalloc_socket(NULL,
+				internals->member_count, 0,
+				eth_dev->data->numa_node);
+		if (bd_rx_q->empty_polls == NULL)
+			return -1;
+		bd_rx_q->nb_empty_polls = internals->member_count;
+	}
+
+	return 0;
+}
+
 static int
 bond_ethdev_start(struct rte_eth_dev *eth_dev)
 {
@@ -2102,6 +2358,12 @@ bond_ethdev_start(struct rte_eth_dev *eth_dev)
 	if (mac_address_members_update(eth_dev) != 0)
 		goto out_err;
 
+	if (bond_ethdev_rx_idle_setup(eth_dev) != 0) {
+		RTE_BOND_LOG(ERR, "bonding port (%d) failed to allocate Rx idle state",
+				eth_dev->data->port_id);
+		goto out_err;
+	}
+
 	if (internals->user_defined_primary_port)
 		bond_ethdev_primary_set(internals, internals->primary_port);
 
@@ -2127,11 +2389,16 @@ bond_ethdev_start(struct rte_eth_dev *eth_dev)
 static void
 bond_ethdev_free_queues(struct rte_eth_dev *dev)
 {
+	struct bond_rx_queue *bd_rx_q;
+	struct bond_tx_queue *bd_tx_q;
 	uint16_t i;
 
 	if (dev->data->rx_queues != NULL) {
 		for (i = 0; i < dev->data->nb_rx_queues; i++) {
-			rte_free(dev->data->rx_queues[i]);
+			bd_rx_q = dev->data->rx_queues[i];
+			if (bd_rx_q != NULL)
+				rte_free(bd_rx_q->empty_polls);
+			rte_free(bd_rx_q);
 			dev->data->rx_queues[i] = NULL;
 		}
 		dev->data->nb_rx_queues = 0;
@@ -2139,7 +2406,10 @@ bond_ethdev_free_queues(struct rte_eth_dev *dev)
 
 	if (dev->data->tx_queues != NULL) {
 		for (i = 0; i < dev->data->nb_tx_queues; i++) {
-			rte_free(dev->data->tx_queues[i]);
+			bd_tx_q = dev->data->tx_queues[i];
+			if (bd_tx_q != NULL)
+				rte_free(bd_tx_q->flowlet);
+			rte_free(bd_tx_q);
 			dev->data->tx_queues[i] = NULL;
 		}
 		dev->data->nb_tx_queues = 0;
@@ -2415,11 +2685,27 @@ bond_ethdev_rx_queue_setup(struct rte_eth_dev *dev, uint16_t rx_queue_id,
 	return 0;
 }
 
+static int
+bond_tx_queue_flowlet_alloc(struct bond_tx_queue *bd_tx_q, int socket_id)
+{
+	struct bond_flowlet_state *fl;
+
+	fl = rte_zmalloc_socket(NULL, sizeof(*fl), 0, socket_id);
+	if (fl == NULL)
+		return -1;
+
+	fl->gap_tsc = rte_get_tsc_hz() * BOND_FLOWLET_GAP_US / US_PER_S;
+	bd_tx_q->flowlet = fl;
+
+	return 0;
+}
+
 static int
 bond_ethdev_tx_queue_setup(struct rte_eth_dev *dev, uint16_t tx_queue_id,
 		uint16_t nb_tx_desc, unsigned int socket_id __rte_unused,
 		const struct rte_eth_txconf *tx_conf)
 {
+	struct bond_dev_private *internals = dev->data->dev_private;
 	struct bond_tx_queue *bd_tx_q  = (struct bond_tx_queue *)
 			rte_zmalloc_socket(NULL, sizeof(struct bond_tx_queue),
 					0, dev->data->numa_node);
@@ -2433,31 +2719,62 @@ bond_ethdev_tx_queue_setup(struct rte_eth_dev *dev, uint16_t tx_queue_id,
 	bd_tx_q->nb_tx_desc = nb_tx_desc;
 	memcpy(&(bd_tx_q->tx_conf), tx_conf, sizeof(bd_tx_q->tx_conf));
 
+	if (internals->balance_xmit_policy == BALANCE_XMIT_POLICY_FLOWLET &&
+			bond_tx_queue_flowlet_alloc(bd_tx_q,
+				dev->data->numa_node) != 0) {
+		rte_free(bd_tx_q);
+		return -1;
+	}
+
 	dev->data->tx_queues[tx_queue_id] = bd_tx_q;
 
 	return 0;
 }
 
+/*
+ * Allocate the flowlet state of the Tx queues already set up, when the
+ * flowlet policy is selected after them.
+ */
+int
+bond_ethdev_flowlet_setup(struct rte_eth_dev *eth_dev)
+{
+	struct bond_tx_queue *bd_tx_q;
+	uint16_t i;
+
+	for (i = 0; i < eth_dev->data->nb_tx_queues; i++) {
+		bd_tx_q = eth_dev->data->tx_queues[i];
+		if (bd_tx_q == NULL || bd_tx_q->flowlet != NULL)
+			continue;
+		if (bond_tx_queue_flowlet_alloc(bd_tx_q,
+				eth_dev->data->numa_node) != 0)
+			return -1;
+	}
+
+	return 0;
+}
+
 static void
 bond_ethdev_rx_queue_release(struct rte_eth_dev *dev, uint16_t queue_id)
 {
-	void *queue = dev->data->rx_queues[queue_id];
+	struct bond_rx_queue *bd_rx_q = dev->data->rx_queues[queue_id];
 
-	if (queue == NULL)
+	if (bd_rx_q == NULL)
 		return;
 
-	rte_free(queue);
+	rte_free(bd_rx_q->empty_polls);
+	rte_free(bd_rx_q);
 }
 
 static void
 bond_ethdev_tx_queue_release(struct rte_eth_dev *dev, uint16_t queue_id)
 {
-	void *queue = dev->data->tx_queues[queue_id];
+	struct bond_tx_queue *bd_tx_q = dev->data->tx_queues[queue_id];
 
-	if (queue == NULL)
+	if (bd_tx_q == NULL)
 		return;
 
-	rte_free(queue);
+	rte_free(bd_tx_q->flowlet);
+	rte_free(bd_tx_q);
 }
 
 static void
@@ -3425,6 +3742,9 @@ dump_basic(const struct rte_eth_dev *dev, FILE *f)
 		case BALANCE_XMIT_POLICY_LAYER34:
 			fprintf(f, "BALANCE_XMIT_POLICY_LAYER34");
 			break;
+		case BALANCE_XMIT_POLICY_FLOWLET:
+			fprintf(f, "BALANCE_XMIT_POLICY_FLOWLET");
+			break;
 		default:
 			fprintf(f, "Unknown");
 		}
@@ -4280,7 +4600,7 @@ RTE_PMD_REGISTER_PARAM_STRING(net_bonding,
 	"member=<ifc> "
 	"primary=<ifc> "
 	"mode=[0-6] "
-	"xmit_policy=[l2 | l23 | l34] "
+	"xmit_policy=[l2 | l23 | l34 | flowlet] "
 	"agg_mode=[count | stable | bandwidth] "
 	"socket_id=<int> "
 	"mac=<mac addr> "
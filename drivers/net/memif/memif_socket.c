@@ -620,6 +620,8 @@ memif_disconnect(struct rte_eth_dev *dev)
 		}
 	}
 
+	/* copies in flight may still access the shared memory */
+	memif_dma_drain(dev);
 	memif_free_regions(dev);
 
 	/* reset connection configuration */
@@ -0,0 +1,142 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <string.h>
+
+#include <rte_dmadev.h>
+#include <rte_pmd_memif.h>
+
+#include <cmdline_parse.h>
+#include <cmdline_parse_num.h>
+#include <cmdline_parse_string.h>
+
+#include "testpmd.h"
+
+#define MEMIF_TESTPMD_DMA_DESC 1024
+
+/* Configure and start a DMA device with a single memory to memory channel. */
+static int
+memif_testpmd_dma_setup(int16_t dma_id)
+{
+	struct rte_dma_vchan_conf qconf = {
+		.direction = RTE_DMA_DIR_MEM_TO_MEM,
+	};
+	struct rte_dma_conf dev_conf = {
+		.nb_vchans = 1,
+	};
+	struct rte_dma_info info;
+	int ret;
+
+	ret = rte_dma_info_get(dma_id, &info);
+	if (ret != 0)
+		return ret;
+	qconf.nb_desc = RTE_MAX(RTE_MIN(MEMIF_TESTPMD_DMA_DESC, info.max_desc),
+				info.min_desc);
+
+	ret = rte_dma_stop(dma_id);
+	if (ret != 0)
+		return ret;
+	ret = rte_dma_configure(dma_id, &dev_conf);
+	if (ret != 0)
+		return ret;
+	ret = rte_dma_vchan_setup(dma_id, 0, &qconf);
+	if (ret != 0)
+		return ret;
+	return rte_dma_start(dma_id);
+}
+
+/* *** SET MEMIF DMA *** */
+struct cmd_set_memif_dma_result {
+	cmdline_fixed_string_t set;
+	cmdline_fixed_string_t memif;
+	cmdline_fixed_string_t dma;
+	portid_t port_id;
+	cmdline_fixed_string_t dir;
+	uint16_t queue_id;
+	int16_t dma_id;
+};
+
+static void cmd_set_memif_dma_parsed(void *parsed_result,
+	__rte_unused struct cmdline *cl, __rte_unused void *data)
+{
+	struct cmd_set_memif_dma_result *res = parsed_result;
+	int ret;
+
+	if (!port_is_stopped(res->port_id)) {
+		fprintf(stderr, "Please stop port %u first\n", res->port_id);
+		return;
+	}
+
+	if (res->dma_id >= 0) {
+		ret = memif_testpmd_dma_setup(res->dma_id);
+		if (ret != 0) {
+			fprintf(stderr, "Failed to start DMA device %d: %s\n",
+				res->dma_id, strerror(-ret));
+			return;
+		}
+	}
+
+	if (strcmp(res->dir, "rxq") == 0)
+		ret = rte_pmd_memif_rx_dma_configure(res->port_id,
+				res->queue_id, res->dma_id, 0);
+	else
+		ret = rte_pmd_memif_tx_dma_configure(res->port_id,
+				res->queue_id, res->dma_id, 0);
+	if (ret != 0)
+		fprintf(stderr, "Failed to set DMA device of port %u %s %u: %s\n",
+			res->port_id, res->dir, res->queue_id, strerror(-ret));
+}
+
+static cmdline_parse_token_string_t cmd_set_memif_dma_set =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_memif_dma_result,
+		set, "set");
+static cmdline_parse_token_string_t cmd_set_memif_dma_memif =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_memif_dma_result,
+		memif, "memif");
+static cmdline_parse_token_string_t cmd_set_memif_dma_dma =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_memif_dma_result,
+		dma, "dma");
+static cmdline_parse_token_num_t cmd_set_memif_dma_port =
+	TOKEN_NUM_INITIALIZER(struct cmd_set_memif_dma_result,
+		port_id, RTE_UINT16);
+static cmdline_parse_token_string_t cmd_set_memif_dma_dir =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_memif_dma_result,
+		dir, "rxq#txq");
+static cmdline_parse_token_num_t cmd_set_memif_dma_queue =
+	TOKEN_NUM_INITIALIZER(struct cmd_set_memif_dma_result,
+		queue_id, RTE_UINT16);
+static cmdline_parse_token_num_t cmd_set_memif_dma_dma_id =
+	TOKEN_NUM_INITIALIZER(struct cmd_set_memif_dma_result,
+		dma_id, RTE_INT16);
+
+static cmdline_parse_inst_t cmd_set_memif_dma = {
+	.f = cmd_set_memif_dma_parsed,
+	.help_str = "set memif dma <port_id> rxq|txq <queue_id> <dma_id>: "
+		"Offload the copies of a memif queue to a DMA device, "
+		"-1 to copy with the CPU",
+	.data = NULL,
+	.tokens = {
+		(void *)&cmd_set_memif_dma_set,
+		(void *)&cmd_set_memif_dma_memif,
+		(void *)&cmd_set_memif_dma_dma,
+		(void *)&cmd_set_memif_dma_port,
+		(void *)&cmd_set_memif_dma_dir,
+		(void *)&cmd_set_memif_dma_queue,
+		(void *)&cmd_set_memif_dma_dma_id,
+		NULL
+	}
+};
+
+static struct testpmd_driver_commands memif_cmds = {
+	.commands = {
+	{
+		&cmd_set_memif_dma,
+		"set memif dma (port_id) (rxq|txq) (queue_id) (dma_id)\n"
+		"	Offload the copies of a memif queue to a DMA device,\n"
+		"	which is configured with a single channel.\n",
+	},
+	{ NULL, NULL },
+	},
+};
+TESTPMD_ADD_DRIVER_COMMANDS(memif_cmds)
@@ -27,8 +27,12 @@
 #include <rte_memory.h>
 #include <rte_memzone.h>
 #include <rte_eal_memconfig.h>
+#include <rte_cycles.h>
+#include <rte_dmadev.h>
 
+#include <eal_export.h>
 #include "rte_eth_memif.h"
+#include "rte_pmd_memif.h"
 #include "memif_socket.h"
 
 #define ETH_MEMIF_ID_ARG		"id"
@@ -292,6 +296,399 @@ memif_pktmbuf_chain(struct rte_mbuf *head, struct rte_mbuf *cur_tail,
 	return 0;
 }
 
+/*
+ * Shared memory buffers are accessed by the DMA device through
+ * their virtual address, the EAL runs in IOVA as VA mode.
+ */
+static inline rte_iova_t
+memif_dma_iova(const void *addr)
+{
+	return (rte_iova_t)(uintptr_t)addr;
+}
+
+/*
+ * Start a copy on the DMA channel of the queue, or do it with the CPU
+ * if it is short or the channel is full. Return the number of DMA copies.
+ */
+static inline uint16_t
+memif_dma_copy(struct memif_queue_dma *dma, uint16_t *capacity,
+	       void *dst, rte_iova_t dst_iova, const void *src,
+	       rte_iova_t src_iova, uint16_t len)
+{
+	if (len >= ETH_MEMIF_DMA_COPY_THRESHOLD && *capacity > 0 &&
+	    rte_dma_copy(dma->dma_id, dma->vchan_id, src_iova, dst_iova,
+			 len, 0) >= 0) {
+		(*capacity)--;
+		return 1;
+	}
+
+	rte_memcpy(dst, src, len);
+	return 0;
+}
+
+/*
+ * Account the DMA copies completed since the last call to the in-flight
+ * packets, in order. On return, all the copies of the packets from
+ * pkt_tail to pkt_done are done.
+ */
+static void
+memif_dma_complete(struct memif_queue *mq)
+{
+	struct memif_queue_dma *dma = &mq->dma;
+	enum rte_dma_status_code status[ETH_MEMIF_DMA_MAX_COMPLETED];
+	uint16_t mask = (1 << mq->log2_ring_size) - 1;
+	struct memif_dma_pkt *pkt;
+	uint16_t nb_done, last_idx, i, n, idx;
+	bool error = false;
+
+	if (dma->nb_pending != 0) {
+		nb_done = rte_dma_completed(dma->dma_id, dma->vchan_id,
+				RTE_MIN(dma->nb_pending, ETH_MEMIF_DMA_MAX_COMPLETED),
+				&last_idx, &error);
+		dma->nb_pending -= nb_done;
+		dma->nb_done += nb_done;
+
+		if (unlikely(error)) {
+			nb_done = rte_dma_completed_status(dma->dma_id,
+					dma->vchan_id,
+					RTE_MIN(dma->nb_pending,
+						ETH_MEMIF_DMA_MAX_COMPLETED),
+					&last_idx, status);
+			/* Flag the packets of the failed copies */
+			for (i = 0; i < nb_done; i++) {
+				if (status[i] == RTE_DMA_STATUS_SUCCESSFUL)
+					continue;
+				dma->n_errors++;
+				n = dma->nb_done + i;
+				for (idx = dma->pkt_done; ; idx++) {
+					pkt = &dma->pkts[idx & mask];
+					if (n < pkt->nb_copies)
+						break;
+					n -= pkt->nb_copies;
+				}
+				pkt->flags |= ETH_MEMIF_DMA_PKT_ERROR;
+			}
+			dma->nb_pending -= nb_done;
+			dma->nb_done += nb_done;
+		}
+	}
+
+	while (dma->pkt_done != dma->pkt_head) {
+		pkt = &dma->pkts[dma->pkt_done & mask];
+		if (pkt->nb_copies > dma->nb_done)
+			break;
+		dma->nb_done -= pkt->nb_copies;
+		dma->pkt_done++;
+	}
+}
+
+static uint16_t
+eth_memif_rx_dma(struct memif_queue *mq, memif_ring_t *ring,
+		 struct pmd_process_private *proc_private,
+		 struct pmd_internals *pmd, struct rte_mbuf **bufs,
+		 uint16_t nb_pkts)
+{
+	struct memif_queue_dma *dma = &mq->dma;
+	uint16_t cur_slot, last_slot, start_slot, n_slots, ring_size, mask;
+	uint16_t cp_len, nb_copies, nb_started = 0, capacity, s0, head;
+	uint16_t n_new_pkts = 0, n_rx_pkts = 0, released;
+	memif_ring_type_t type = mq->type;
+	struct rte_mbuf *mbuf, *mbuf_head, *mbuf_tail;
+	struct memif_dma_pkt *pkt;
+	memif_desc_t *d0;
+	uint16_t flags;
+	void *src;
+
+	ring_size = 1 << mq->log2_ring_size;
+	mask = ring_size - 1;
+
+	/* Start the copies of the new packets */
+	cur_slot = dma->slot;
+	if (type == MEMIF_RING_C2S)
+		last_slot = rte_atomic_load_explicit(&ring->head, rte_memory_order_acquire);
+	else
+		last_slot = rte_atomic_load_explicit(&ring->tail, rte_memory_order_acquire);
+	n_slots = last_slot - cur_slot;
+	capacity = rte_dma_burst_capacity(dma->dma_id, dma->vchan_id);
+
+	while (n_slots && n_new_pkts < nb_pkts &&
+	       (uint16_t)(dma->pkt_head - dma->pkt_tail) < ring_size) {
+		mbuf_head = rte_pktmbuf_alloc(mq->mempool);
+		if (unlikely(mbuf_head == NULL))
+			break;
+		mbuf = mbuf_head;
+		start_slot = cur_slot;
+		nb_copies = 0;
+		flags = 0;
+
+next_slot:
+		mbuf->port = mq->in_port;
+		s0 = cur_slot & mask;
+		d0 = &ring->desc[s0];
+
+		cp_len = d0->length;
+		rte_pktmbuf_data_len(mbuf) = cp_len;
+		rte_pktmbuf_pkt_len(mbuf) = cp_len;
+		if (mbuf != mbuf_head)
+			rte_pktmbuf_pkt_len(mbuf_head) += cp_len;
+
+		src = memif_get_buffer(proc_private, d0);
+		nb_copies += memif_dma_copy(dma, &capacity,
+				rte_pktmbuf_mtod(mbuf, void *),
+				rte_pktmbuf_iova(mbuf), src,
+				memif_dma_iova(src), cp_len);
+
+		cur_slot++;
+		n_slots--;
+
+		if (d0->flags & MEMIF_DESC_FLAG_NEXT) {
+			mbuf_tail = mbuf;
+			mbuf = rte_pktmbuf_alloc(mq->mempool);
+			if (unlikely(mbuf == NULL)) {
+				/* Retry the packet on next call */
+				flags = ETH_MEMIF_DMA_PKT_DROP;
+				n_slots += cur_slot - start_slot;
+				cur_slot = start_slot;
+				goto start_done;
+			}
+			if (unlikely(memif_pktmbuf_chain(mbuf_head, mbuf_tail,
+							 mbuf) < 0)) {
+				MIF_LOG(ERR, "number-of-segments-overflow");
+				rte_pktmbuf_free(mbuf);
+				/* Skip the remaining segments */
+				flags = ETH_MEMIF_DMA_PKT_DROP;
+				do {
+					d0 = &ring->desc[cur_slot++ & mask];
+					n_slots--;
+				} while (d0->flags & MEMIF_DESC_FLAG_NEXT);
+				goto start_done;
+			}
+			goto next_slot;
+		}
+
+start_done:
+		/* The packet is kept until its copies are done */
+		pkt = &dma->pkts[dma->pkt_head++ & mask];
+		pkt->mbuf = mbuf_head;
+		pkt->nb_copies = nb_copies;
+		pkt->slot = cur_slot;
+		pkt->flags = flags;
+		nb_started += nb_copies;
+		if (unlikely(flags != 0) && cur_slot == start_slot)
+			break;
+		n_new_pkts++;
+	}
+
+	dma->slot = cur_slot;
+	if (nb_started != 0) {
+		dma->nb_pending += nb_started;
+		rte_dma_submit(dma->dma_id, dma->vchan_id);
+	}
+
+	/* Return the packets whose copies are done and release their slots */
+	memif_dma_complete(mq);
+	released = (type == MEMIF_RING_C2S) ? mq->last_head : mq->last_tail;
+	while (dma->pkt_tail != dma->pkt_done && n_rx_pkts < nb_pkts) {
+		pkt = &dma->pkts[dma->pkt_tail++ & mask];
+		released = pkt->slot;
+		if (unlikely(pkt->flags != 0)) {
+			rte_pktmbuf_free(pkt->mbuf);
+			continue;
+		}
+		mq->n_bytes += rte_pktmbuf_pkt_len(pkt->mbuf);
+		bufs[n_rx_pkts++] = pkt->mbuf;
+	}
+
+	if (type == MEMIF_RING_C2S) {
+		if (released != mq->last_head) {
+			rte_atomic_store_explicit(&ring->tail, released,
+						  rte_memory_order_release);
+			mq->last_head = released;
+		}
+	} else {
+		mq->last_tail = released;
+
+		/* Supply the sender with the released buffers */
+		head = rte_atomic_load_explicit(&ring->head, rte_memory_order_relaxed);
+		n_slots = ring_size - head + mq->last_tail;
+
+		while (n_slots--) {
+			s0 = head++ & mask;
+			d0 = &ring->desc[s0];
+			d0->length = pmd->run.pkt_buffer_size;
+		}
+		rte_atomic_store_explicit(&ring->head, head, rte_memory_order_release);
+	}
+
+	mq->n_pkts += n_rx_pkts;
+	return n_rx_pkts;
+}
+
+/* Give the packets whose copies are done to the peer and free them */
+static void
+memif_tx_dma_complete(struct memif_queue *mq, memif_ring_t *ring)
+{
+	struct memif_queue_dma *dma = &mq->dma;
+	uint16_t mask = (1 << mq->log2_ring_size) - 1;
+	struct memif_dma_pkt *pkt;
+	uint16_t slot;
+	uint64_t a = 1;
+	ssize_t size;
+
+	memif_dma_complete(mq);
+	if (dma->pkt_tail == dma->pkt_done)
+		return;
+
+	do {
+		pkt = &dma->pkts[dma->pkt_tail++ & mask];
+		slot = pkt->slot;
+		rte_pktmbuf_free(pkt->mbuf);
+	} while (dma->pkt_tail != dma->pkt_done);
+
+	if (mq->type == MEMIF_RING_C2S)
+		rte_atomic_store_explicit(&ring->head, slot, rte_memory_order_release);
+	else
+		rte_atomic_store_explicit(&ring->tail, slot, rte_memory_order_release);
+
+	if (((ring->flags & MEMIF_RING_FLAG_MASK_INT) == 0) &&
+	    (rte_intr_fd_get(mq->intr_handle) >= 0)) {
+		size = write(rte_intr_fd_get(mq->intr_handle), &a,
+			     sizeof(a));
+		if (unlikely(size < 0)) {
+			MIF_LOG(WARNING,
+				"Failed to send interrupt. %s", strerror(errno));
+		}
+	}
+}
+
+static uint16_t
+eth_memif_tx_dma(struct memif_queue *mq, memif_ring_t *ring,
+		 struct pmd_process_private *proc_private,
+		 struct pmd_internals *pmd, struct rte_mbuf **bufs,
+		 uint16_t nb_pkts)
+{
+	struct memif_queue_dma *dma = &mq->dma;
+	uint16_t slot, saved_slot, n_free, n_need, ring_size, mask;
+	uint16_t src_len, src_off, dst_len, dst_off, cp_len, nb_segs;
+	uint16_t nb_copies, nb_started = 0, capacity, n_tx_pkts = 0;
+	memif_ring_type_t type = mq->type;
+	struct rte_mbuf *mbuf, *mbuf_head;
+	struct memif_dma_pkt *pkt;
+	memif_desc_t *d0;
+	uint32_t room;
+	uint8_t *dst;
+
+	ring_size = 1 << mq->log2_ring_size;
+	mask = ring_size - 1;
+
+	/* Release the slots of the packets copied since last call */
+	memif_tx_dma_complete(mq, ring);
+
+	/*
+	 * The slots up to dma->slot are filled, but only given to the peer
+	 * once all the copies of their packet are done.
+	 */
+	slot = dma->slot;
+	if (type == MEMIF_RING_C2S)
+		n_free = ring_size - slot +
+			rte_atomic_load_explicit(&ring->tail, rte_memory_order_acquire);
+	else
+		n_free = rte_atomic_load_explicit(&ring->head, rte_memory_order_acquire) - slot;
+	capacity = rte_dma_burst_capacity(dma->dma_id, dma->vchan_id);
+
+	while (n_tx_pkts < nb_pkts) {
+		mbuf_head = bufs[n_tx_pkts];
+
+		/*
+		 * Check that the packet fits in the free slots first, copies
+		 * in flight cannot be canceled.
+		 */
+		room = 0;
+		n_need = 0;
+		do {
+			if (n_need == n_free)
+				goto no_free_slots;
+			room += (type == MEMIF_RING_C2S) ? pmd->run.pkt_buffer_size :
+				ring->desc[(slot + n_need) & mask].length;
+			n_need++;
+		} while (room < rte_pktmbuf_pkt_len(mbuf_head));
+
+		nb_segs = mbuf_head->nb_segs;
+		mbuf = mbuf_head;
+		nb_copies = 0;
+
+		saved_slot = slot;
+		d0 = &ring->desc[slot & mask];
+		d0->flags = 0;
+		dst = memif_get_buffer(proc_private, d0);
+		dst_off = 0;
+		dst_len = (type == MEMIF_RING_C2S) ?
+			pmd->run.pkt_buffer_size : d0->length;
+
+next_in_chain:
+		src_off = 0;
+		src_len = rte_pktmbuf_data_len(mbuf);
+
+		while (src_len) {
+			if (dst_len == 0) {
+				slot++;
+				d0->flags |= MEMIF_DESC_FLAG_NEXT;
+				d0 = &ring->desc[slot & mask];
+				d0->flags = 0;
+				dst = memif_get_buffer(proc_private, d0);
+				dst_off = 0;
+				dst_len = (type == MEMIF_RING_C2S) ?
+					pmd->run.pkt_buffer_size : d0->length;
+			}
+			cp_len = RTE_MIN(dst_len, src_len);
+
+			nb_copies += memif_dma_copy(dma, &capacity,
+					dst + dst_off, memif_dma_iova(dst + dst_off),
+					rte_pktmbuf_mtod_offset(mbuf, void *, src_off),
+					rte_pktmbuf_iova_offset(mbuf, src_off), cp_len);
+
+			src_off += cp_len;
+			dst_off += cp_len;
+			src_len -= cp_len;
+			dst_len -= cp_len;
+
+			d0->length = dst_off;
+		}
+
+		if (--nb_segs > 0) {
+			mbuf = mbuf->next;
+			goto next_in_chain;
+		}
+
+		slot++;
+		n_free -= slot - saved_slot;
+
+		/* The mbuf is freed once its copies are done */
+		pkt = &dma->pkts[dma->pkt_head++ & mask];
+		pkt->mbuf = mbuf_head;
+		pkt->nb_copies = nb_copies;
+		pkt->slot = slot;
+		pkt->flags = 0;
+		nb_started += nb_copies;
+
+		mq->n_bytes += rte_pktmbuf_pkt_len(mbuf_head);
+		n_tx_pkts++;
+	}
+
+no_free_slots:
+	dma->slot = slot;
+	if (nb_started != 0) {
+		dma->nb_pending += nb_started;
+		rte_dma_submit(dma->dma_id, dma->vchan_id);
+	}
+
+	/* The packets copied by the CPU only are given to the peer at once */
+	memif_tx_dma_complete(mq, ring);
+
+	mq->n_pkts += n_tx_pkts;
+	return n_tx_pkts;
+}
+
 static uint16_t
 eth_memif_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -331,6 +728,10 @@ eth_memif_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		size = read(rte_intr_fd_get(mq->intr_handle), &b,
 			    sizeof(b));
 
+	if (mq->dma.dma_id >= 0)
+		return eth_memif_rx_dma(mq, ring, proc_private, pmd, bufs,
+					nb_pkts);
+
 	ring_size = 1 << mq->log2_ring_size;
 	mask = ring_size - 1;
 
@@ -667,6 +1068,10 @@ eth_memif_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		return 0;
 	}
 
+	if (mq->dma.dma_id >= 0)
+		return eth_memif_tx_dma(mq, ring, proc_private, pmd, bufs,
+					nb_pkts);
+
 	ring_size = 1 << mq->log2_ring_size;
 	mask = ring_size - 1;
 
@@ -1290,6 +1695,76 @@ memif_init_regions_and_queues(struct rte_eth_dev *dev)
 	return 0;
 }
 
+static int
+memif_dma_queue_init(struct memif_queue *mq)
+{
+	struct memif_queue_dma *dma = &mq->dma;
+
+	if (dma->dma_id < 0)
+		return 0;
+
+	/* A packet uses at least one slot, size the table as the ring */
+	rte_free(dma->pkts);
+	dma->pkts = rte_zmalloc("dma-pkts",
+			sizeof(*dma->pkts) << mq->log2_ring_size, 0);
+	if (dma->pkts == NULL) {
+		MIF_LOG(ERR, "Failed to allocate DMA packet table.");
+		return -ENOMEM;
+	}
+	dma->slot = 0;
+	dma->nb_pending = 0;
+	dma->nb_done = 0;
+	dma->pkt_head = 0;
+	dma->pkt_done = 0;
+	dma->pkt_tail = 0;
+
+	return 0;
+}
+
+static void
+memif_dma_queue_drain(struct memif_queue *mq)
+{
+	struct memif_queue_dma *dma = &mq->dma;
+	uint16_t mask = (1 << mq->log2_ring_size) - 1;
+	uint64_t timeout;
+
+	if (dma->dma_id < 0 || dma->pkts == NULL)
+		return;
+
+	timeout = rte_get_timer_cycles() + rte_get_timer_hz();
+	while (dma->nb_pending != 0 && rte_get_timer_cycles() < timeout)
+		memif_dma_complete(mq);
+	if (dma->nb_pending != 0)
+		MIF_LOG(ERR, "%u DMA copies not completed.", dma->nb_pending);
+
+	while (dma->pkt_tail != dma->pkt_head)
+		rte_pktmbuf_free(dma->pkts[dma->pkt_tail++ & mask].mbuf);
+
+	dma->nb_pending = 0;
+	dma->nb_done = 0;
+	dma->pkt_head = 0;
+	dma->pkt_done = 0;
+	dma->pkt_tail = 0;
+}
+
+void
+memif_dma_drain(struct rte_eth_dev *dev)
+{
+	uint16_t i;
+
+	if (rte_eal_process_type() != RTE_PROC_PRIMARY)
+		return;
+
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
+		if (dev->data->rx_queues[i] != NULL)
+			memif_dma_queue_drain(dev->data->rx_queues[i]);
+	}
+	for (i = 0; i < dev->data->nb_tx_queues; i++) {
+		if (dev->data->tx_queues[i] != NULL)
+			memif_dma_queue_drain(dev->data->tx_queues[i]);
+	}
+}
+
 int
 memif_connect(struct rte_eth_dev *dev)
 {
@@ -1336,6 +1811,8 @@ memif_connect(struct rte_eth_dev *dev)
 			rte_atomic_store_explicit(&ring->tail, 0, rte_memory_order_relaxed);
 			mq->last_head = 0;
 			mq->last_tail = 0;
+			if (memif_dma_queue_init(mq) < 0)
+				return -1;
 			/* enable polling mode */
 			if (pmd->role == MEMIF_ROLE_SERVER)
 				ring->flags = MEMIF_RING_FLAG_MASK_INT;
@@ -1352,6 +1829,8 @@ memif_connect(struct rte_eth_dev *dev)
 			rte_atomic_store_explicit(&ring->tail, 0, rte_memory_order_relaxed);
 			mq->last_head = 0;
 			mq->last_tail = 0;
+			if (memif_dma_queue_init(mq) < 0)
+				return -1;
 			/* enable polling mode */
 			if (pmd->role == MEMIF_ROLE_CLIENT)
 				ring->flags = MEMIF_RING_FLAG_MASK_INT;
@@ -1481,6 +1960,7 @@ memif_tx_queue_setup(struct rte_eth_dev *dev,
 	    (pmd->role == MEMIF_ROLE_CLIENT) ? MEMIF_RING_C2S : MEMIF_RING_S2C;
 	mq->n_pkts = 0;
 	mq->n_bytes = 0;
+	mq->dma.dma_id = -1;
 
 	if (rte_intr_fd_set(mq->intr_handle, -1))
 		return -rte_errno;
@@ -1521,6 +2001,7 @@ memif_rx_queue_setup(struct rte_eth_dev *dev,
 	mq->type = (pmd->role == MEMIF_ROLE_CLIENT) ? MEMIF_RING_S2C : MEMIF_RING_C2S;
 	mq->n_pkts = 0;
 	mq->n_bytes = 0;
+	mq->dma.dma_id = -1;
 
 	if (rte_intr_fd_set(mq->intr_handle, -1))
 		return -rte_errno;
@@ -1544,6 +2025,7 @@ memif_rx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 		return;
 
 	rte_intr_instance_free(mq->intr_handle);
+	rte_free(mq->dma.pkts);
 	rte_free(mq);
 }
 
@@ -1555,6 +2037,7 @@ memif_tx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 	if (!mq)
 		return;
 
+	rte_free(mq->dma.pkts);
 	rte_free(mq);
 }
 
@@ -1602,6 +2085,7 @@ memif_stats_get(struct rte_eth_dev *dev, struct rte_eth_stats *stats)
 		stats->q_ibytes[i] = mq->n_bytes;
 		stats->ipackets += mq->n_pkts;
 		stats->ibytes += mq->n_bytes;
+		stats->ierrors += mq->dma.n_errors;
 	}
 
 	tmp = (pmd->role == MEMIF_ROLE_CLIENT) ? pmd->run.num_c2s_rings :
@@ -1616,6 +2100,7 @@ memif_stats_get(struct rte_eth_dev *dev, struct rte_eth_stats *stats)
 		stats->q_obytes[i] = mq->n_bytes;
 		stats->opackets += mq->n_pkts;
 		stats->obytes += mq->n_bytes;
+		stats->oerrors += mq->dma.n_errors;
 	}
 	return 0;
 }
@@ -1632,12 +2117,14 @@ memif_stats_reset(struct rte_eth_dev *dev)
 		    dev->data->rx_queues[i];
 		mq->n_pkts = 0;
 		mq->n_bytes = 0;
+		mq->dma.n_errors = 0;
 	}
 	for (i = 0; i < pmd->run.num_s2c_rings; i++) {
 		mq = (pmd->role == MEMIF_ROLE_CLIENT) ? dev->data->rx_queues[i] :
 		    dev->data->tx_queues[i];
 		mq->n_pkts = 0;
 		mq->n_bytes = 0;
+		mq->dma.n_errors = 0;
 	}
 
 	return 0;
@@ -1658,6 +2145,87 @@ static const struct eth_dev_ops ops = {
 	.stats_reset = memif_stats_reset,
 };
 
+static int
+memif_dma_configure(uint16_t port_id, uint16_t queue_id, int16_t dma_id,
+		    uint16_t vchan_id, bool tx)
+{
+	struct rte_eth_dev *dev;
+	struct pmd_internals *pmd;
+	struct memif_queue *mq;
+	struct rte_dma_info info;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+	if (dev->dev_ops != &ops)
+		return -ENOTSUP;
+
+	pmd = dev->data->dev_private;
+	if (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY) {
+		MIF_LOG(ERR, "DMA copies are not supported in zero-copy mode.");
+		return -ENOTSUP;
+	}
+	if (dev->data->dev_started)
+		return -EBUSY;
+
+	if (tx) {
+		if (queue_id >= dev->data->nb_tx_queues)
+			return -EINVAL;
+		mq = dev->data->tx_queues[queue_id];
+	} else {
+		if (queue_id >= dev->data->nb_rx_queues)
+			return -EINVAL;
+		mq = dev->data->rx_queues[queue_id];
+	}
+	if (mq == NULL)
+		return -EINVAL;
+
+	if (dma_id < 0) {
+		mq->dma.dma_id = -1;
+		rte_free(mq->dma.pkts);
+		mq->dma.pkts = NULL;
+		return 0;
+	}
+
+	if (rte_eal_iova_mode() != RTE_IOVA_VA) {
+		MIF_LOG(ERR, "DMA copies require IOVA as VA mode.");
+		return -ENOTSUP;
+	}
+	if (!rte_dma_is_valid(dma_id) || rte_dma_info_get(dma_id, &info) != 0 ||
+	    vchan_id >= info.nb_vchans)
+		return -EINVAL;
+	if (!(info.dev_capa & RTE_DMA_CAPA_MEM_TO_MEM) ||
+	    !(info.dev_capa & RTE_DMA_CAPA_OPS_COPY))
+		return -ENOTSUP;
+	/* Each descriptor is copied in a single mbuf segment */
+	if (!tx && rte_pktmbuf_data_room_size(mq->mempool) - RTE_PKTMBUF_HEADROOM <
+	    pmd->cfg.pkt_buffer_size) {
+		MIF_LOG(ERR, "Mbufs smaller than packet buffers (%u).",
+			pmd->cfg.pkt_buffer_size);
+		return -ENOTSUP;
+	}
+
+	mq->dma.dma_id = dma_id;
+	mq->dma.vchan_id = vchan_id;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pmd_memif_rx_dma_configure, 25.07)
+int
+rte_pmd_memif_rx_dma_configure(uint16_t port_id, uint16_t queue_id,
+			       int16_t dma_id, uint16_t vchan_id)
+{
+	return memif_dma_configure(port_id, queue_id, dma_id, vchan_id, false);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pmd_memif_tx_dma_configure, 25.07)
+int
+rte_pmd_memif_tx_dma_configure(uint16_t port_id, uint16_t queue_id,
+			       int16_t dma_id, uint16_t vchan_id)
+{
+	return memif_dma_configure(port_id, queue_id, dma_id, vchan_id, true);
+}
+
 static int
 memif_create(struct rte_vdev_device *vdev, enum memif_role_t role,
 	     memif_interface_id_t id, uint32_t flags,
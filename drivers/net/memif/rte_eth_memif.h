@@ -27,6 +27,11 @@
 
 #define MAX_PKT_BURST				32
 
+/** Copies shorter than this are done by the CPU when a DMA channel is used */
+#define ETH_MEMIF_DMA_COPY_THRESHOLD		256
+/** Maximum number of DMA completions read at once */
+#define ETH_MEMIF_DMA_MAX_COMPLETED		64
+
 extern int memif_logtype;
 #define RTE_LOGTYPE_MEMIF memif_logtype
 
@@ -46,6 +51,34 @@ struct memif_region {
 	/**< offset from 'addr' to first packet buffer */
 };
 
+/* Packet whose copies are offloaded to a DMA channel */
+struct memif_dma_pkt {
+	struct rte_mbuf *mbuf;			/**< copied packet */
+	uint16_t nb_copies;			/**< number of DMA copies */
+	uint16_t slot;				/**< ring slot following the packet */
+	uint16_t flags;
+#define ETH_MEMIF_DMA_PKT_ERROR			(1 << 0)
+/**< a DMA copy of the packet failed */
+#define ETH_MEMIF_DMA_PKT_DROP			(1 << 1)
+/**< packet is freed once its copies are done, its slots are not released */
+};
+
+/* DMA copy offload state of a queue */
+struct memif_queue_dma {
+	int16_t dma_id;				/**< DMA device id, -1 if not used */
+	uint16_t vchan_id;			/**< DMA virtual channel id */
+	uint16_t slot;
+	/**< Tx: next slot to fill, Rx: next slot to copy from */
+	uint16_t nb_pending;			/**< DMA copies not completed */
+	uint16_t nb_done;
+	/**< DMA copies completed, not yet accounted to a packet */
+	uint16_t pkt_head;			/**< next in-flight packet entry */
+	uint16_t pkt_done;			/**< first packet not completed */
+	uint16_t pkt_tail;			/**< oldest in-flight packet */
+	struct memif_dma_pkt *pkts;		/**< in-flight packets, ring size */
+	uint64_t n_errors;			/**< number of failed DMA copies */
+};
+
 struct memif_queue {
 	struct rte_mempool *mempool;		/**< mempool for RX packets */
 	struct pmd_internals *pmd;		/**< device internals */
@@ -73,6 +106,8 @@ struct memif_queue {
 	struct rte_intr_handle *intr_handle;	/**< interrupt handle */
 
 	memif_log2_ring_size_t log2_ring_size;	/**< log2 of ring size */
+
+	struct memif_queue_dma dma;		/**< DMA copy offload */
 };
 
 struct pmd_internals {
@@ -161,6 +196,15 @@ int memif_connect(struct rte_eth_dev *dev);
  */
 int memif_init_regions_and_queues(struct rte_eth_dev *dev);
 
+/**
+ * Wait for the DMA copies in flight on the device queues and free
+ * the packets they belong to. Called before the shared memory is unmapped.
+ *
+ * @param dev
+ *   memif device
+ */
+void memif_dma_drain(struct rte_eth_dev *dev);
+
 /**
  * Get memif version string.
  *
@@ -0,0 +1,101 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_PMD_MEMIF_H_
+#define _RTE_PMD_MEMIF_H_
+
+/**
+ * @file rte_pmd_memif.h
+ * memif PMD specific functions.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Offload the copies of a memif Rx queue to a DMA channel.
+ *
+ * In copy mode, the packets are copied from the shared memory buffers
+ * to the mbufs. With a DMA channel configured, the copies of 256 bytes
+ * or more are done by the DMA device.
+ * A packet is returned by rte_eth_rx_burst() once its copies are done,
+ * which is usually during one of the following calls.
+ *
+ * The DMA channel must be configured for memory to memory copies and
+ * started, and must not be used by other queues. The EAL must run
+ * in IOVA as VA mode, and the DMA device must be able to access the
+ * memif shared memory.
+ *
+ * @param port_id
+ *   The port identifier of the memif device, which must be stopped.
+ * @param queue_id
+ *   The Rx queue identifier.
+ * @param dma_id
+ *   The DMA device identifier, or -1 to copy with the CPU.
+ * @param vchan_id
+ *   The DMA virtual channel identifier.
+ * @return
+ *   - (0) if successful.
+ *   - (-ENODEV) if *port_id* is invalid.
+ *   - (-ENOTSUP) if the port is not a memif device in copy mode,
+ *     or if the DMA channel cannot be used.
+ *   - (-EINVAL) if a parameter is invalid.
+ *   - (-EBUSY) if the port is started.
+ */
+__rte_experimental
+int rte_pmd_memif_rx_dma_configure(uint16_t port_id, uint16_t queue_id,
+		int16_t dma_id, uint16_t vchan_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Offload the copies of a memif Tx queue to a DMA channel.
+ *
+ * In copy mode, the packets are copied from the mbufs to the shared
+ * memory buffers. With a DMA channel configured, the copies of 256 bytes
+ * or more are done by the DMA device.
+ * The packets are given to the peer, and their mbufs are freed, once
+ * their copies are done, in the following calls to rte_eth_tx_burst().
+ * The application should keep calling rte_eth_tx_burst(), possibly
+ * with no packet, to complete the transmission.
+ *
+ * The DMA channel must be configured for memory to memory copies and
+ * started, and must not be used by other queues. The EAL must run
+ * in IOVA as VA mode, and the DMA device must be able to access the
+ * memif shared memory.
+ *
+ * @param port_id
+ *   The port identifier of the memif device, which must be stopped.
+ * @param queue_id
+ *   The Tx queue identifier.
+ * @param dma_id
+ *   The DMA device identifier, or -1 to copy with the CPU.
+ * @param vchan_id
+ *   The DMA virtual channel identifier.
+ * @return
+ *   - (0) if successful.
+ *   - (-ENODEV) if *port_id* is invalid.
+ *   - (-ENOTSUP) if the port is not a memif device in copy mode,
+ *     or if the DMA channel cannot be used.
+ *   - (-EINVAL) if a parameter is invalid.
+ *   - (-EBUSY) if the port is started.
+ */
+__rte_experimental
+int rte_pmd_memif_tx_dma_configure(uint16_t port_id, uint16_t queue_id,
+		int16_t dma_id, uint16_t vchan_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_PMD_MEMIF_H_ */
@@ -15,6 +15,9 @@
 #include <bus_vdev_driver.h>
 #include <rte_kvargs.h>
 #include <rte_errno.h>
+#include <rte_memzone.h>
+#include <rte_ptr_compress.h>
+#include <rte_spinlock.h>
 
 #define ETH_RING_NUMA_NODE_ACTION_ARG	"nodeaction"
 #define ETH_RING_ACTION_CREATE		"CREATE"
@@ -22,10 +25,25 @@
 #define ETH_RING_ACTION_MAX_LEN		8 /* CREATE | ACTION */
 #define ETH_RING_INTERNAL_ARG		"internal"
 #define ETH_RING_INTERNAL_ARG_MAX_LEN	19 /* "0x..16chars..\0" */
+#define ETH_RING_LINK_ARG		"link"
+#define ETH_RING_QUEUES_ARG		"queues"
+#define ETH_RING_SIZE_ARG		"size"
+#define ETH_RING_COMPRESS_ARG		"compress"
+
+#define ETH_RING_LINK_DEFAULT_SIZE	1024
+/* Ring names are "RL<queue><direction>_<link>", 23 characters left */
+#define ETH_RING_LINK_NAME_MAX_LEN	(RTE_RING_NAMESIZE - sizeof("RL0A_"))
+#define ETH_RING_BURST_SIZE		32
+/* Number of compressed pointers copied through the stack at once. */
+#define ETH_RING_COMPRESS_BURST		64
 
 static const char *valid_arguments[] = {
 	ETH_RING_NUMA_NODE_ACTION_ARG,
 	ETH_RING_INTERNAL_ARG,
+	ETH_RING_LINK_ARG,
+	ETH_RING_QUEUES_ARG,
+	ETH_RING_SIZE_ARG,
+	ETH_RING_COMPRESS_ARG,
 	NULL
 };
 
@@ -43,11 +61,43 @@ enum dev_action {
 	DEV_ATTACH
 };
 
+/*
+ * Pair of ring sets shared by the two ports of a link, stored in a named
+ * memzone so that the ports can be probed from any process.
+ * The port attached on side 0 receives from rings[0] and sends to rings[1],
+ * the port attached on side 1 does the opposite.
+ */
+struct ring_link {
+	const struct rte_memzone *mz;
+	unsigned int nb_queues;
+	unsigned int size;
+	bool compress;
+	uint8_t sides; /* bitmask of the attached sides */
+	struct rte_ring *rings[2][RTE_PMD_RING_MAX_RX_RINGS];
+
+	/* memory range of the mbufs, when passing compressed pointers */
+	rte_spinlock_t lock;
+	bool range_set;
+	uintptr_t base;
+	uint8_t shift;
+};
+
 struct ring_queue {
 	struct rte_ring *rng;
 	uint16_t in_port;
 	RTE_ATOMIC(uint64_t) rx_pkts;
 	RTE_ATOMIC(uint64_t) tx_pkts;
+	RTE_ATOMIC(uint64_t) tx_full;
+
+	/* link mode only, the rings are single producer and consumer */
+	uint64_t rx_bytes;
+	uint64_t tx_bytes;
+	uint64_t tx_errors;
+
+	/* compressed pointers */
+	void *base;
+	uint64_t span;
+	uint8_t shift;
 };
 
 struct pmd_internals {
@@ -59,6 +109,9 @@ struct pmd_internals {
 
 	struct rte_ether_addr address;
 	enum dev_action action;
+
+	struct ring_link *link;
+	unsigned int link_side;
 };
 
 static struct rte_eth_link pmd_link = {
@@ -98,19 +151,233 @@ eth_ring_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 	struct ring_queue *r = q;
 	const uint16_t nb_tx = (uint16_t)rte_ring_enqueue_burst(r->rng,
 			ptrs, nb_bufs, NULL);
-	if (r->rng->flags & RING_F_SP_ENQ)
+	if (r->rng->flags & RING_F_SP_ENQ) {
 		r->tx_pkts += nb_tx;
-	else
+		if (unlikely(nb_tx < nb_bufs))
+			r->tx_full += nb_bufs - nb_tx;
+	} else {
 		rte_atomic_fetch_add_explicit(&r->tx_pkts, nb_tx, rte_memory_order_relaxed);
+		if (unlikely(nb_tx < nb_bufs))
+			rte_atomic_fetch_add_explicit(&r->tx_full, nb_bufs - nb_tx,
+					rte_memory_order_relaxed);
+	}
+	return nb_tx;
+}
+
+static uint16_t
+eth_ring_link_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct ring_queue *r = q;
+	uint64_t bytes = 0;
+	uint16_t nb_rx, i;
+
+	nb_rx = (uint16_t)rte_ring_dequeue_burst(r->rng, (void **)bufs,
+			nb_bufs, NULL);
+	for (i = 0; i < nb_rx; i++) {
+		bufs[i]->port = r->in_port;
+		bytes += bufs[i]->pkt_len;
+	}
+	r->rx_pkts += nb_rx;
+	r->rx_bytes += bytes;
+	return nb_rx;
+}
+
+static uint16_t
+eth_ring_link_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct ring_queue *r = q;
+	uint64_t bytes = 0;
+	uint16_t nb_tx, i;
+
+	/* the mbufs belong to the peer once enqueued */
+	for (i = 0; i < nb_bufs; i++)
+		bytes += bufs[i]->pkt_len;
+
+	nb_tx = (uint16_t)rte_ring_enqueue_burst(r->rng, (void **)bufs,
+			nb_bufs, NULL);
+	if (unlikely(nb_tx < nb_bufs)) {
+		for (i = nb_tx; i < nb_bufs; i++)
+			bytes -= bufs[i]->pkt_len;
+		r->tx_full += nb_bufs - nb_tx;
+	}
+	r->tx_pkts += nb_tx;
+	r->tx_bytes += bytes;
+	return nb_tx;
+}
+
+static uint16_t
+eth_ring_link_rx_compressed(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct ring_queue *r = q;
+	uint32_t objs[ETH_RING_COMPRESS_BURST];
+	uint64_t bytes = 0;
+	uint16_t nb_rx = 0;
+	unsigned int n, req, i;
+
+	do {
+		req = RTE_MIN(nb_bufs - nb_rx, ETH_RING_COMPRESS_BURST);
+		n = rte_ring_dequeue_burst_elem(r->rng, objs, sizeof(uint32_t),
+				req, NULL);
+		rte_ptr_decompress_32_shift(r->base, objs, (void **)&bufs[nb_rx],
+				n, r->shift);
+		nb_rx += n;
+	} while (n == req && nb_rx < nb_bufs);
+
+	for (i = 0; i < nb_rx; i++) {
+		bufs[i]->port = r->in_port;
+		bytes += bufs[i]->pkt_len;
+	}
+	r->rx_pkts += nb_rx;
+	r->rx_bytes += bytes;
+	return nb_rx;
+}
+
+static __rte_always_inline bool
+ring_queue_can_compress(const struct ring_queue *r, const struct rte_mbuf *m)
+{
+	uint64_t offset = (uintptr_t)m - (uintptr_t)r->base;
+
+	return offset < r->span && (offset & ((UINT64_C(1) << r->shift) - 1)) == 0;
+}
+
+static uint16_t
+eth_ring_link_tx_compressed(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct ring_queue *r = q;
+	uint32_t objs[ETH_RING_COMPRESS_BURST];
+	uint64_t bytes = 0, pkts = 0;
+	uint16_t nb_tx = 0;
+	unsigned int n, sent, i;
+
+	while (nb_tx < nb_bufs) {
+		n = RTE_MIN(nb_bufs - nb_tx, ETH_RING_COMPRESS_BURST);
+		for (i = 0; i < n; i++) {
+			if (unlikely(!ring_queue_can_compress(r, bufs[nb_tx + i])))
+				break;
+			bytes += bufs[nb_tx + i]->pkt_len;
+		}
+
+		if (i > 0) {
+			rte_ptr_compress_32_shift(r->base, (void * const *)&bufs[nb_tx],
+					objs, i, r->shift);
+			sent = rte_ring_enqueue_burst_elem(r->rng, objs,
+					sizeof(uint32_t), i, NULL);
+			pkts += sent;
+			if (unlikely(sent < i)) {
+				while (i-- > sent)
+					bytes -= bufs[nb_tx + i]->pkt_len;
+				nb_tx += sent;
+				r->tx_full += nb_bufs - nb_tx;
+				break;
+			}
+			nb_tx += sent;
+		}
+
+		if (unlikely(i < n)) {
+			/* the mbuf is out of the range of the compressed pointers */
+			rte_pktmbuf_free(bufs[nb_tx]);
+			r->tx_errors++;
+			nb_tx++;
+		}
+	}
+
+	r->tx_pkts += pkts;
+	r->tx_bytes += bytes;
 	return nb_tx;
 }
 
+static uint32_t
+eth_ring_rx_queue_count(void *rx_queue)
+{
+	const struct ring_queue *r = rx_queue;
+
+	return rte_ring_count(r->rng);
+}
+
+static int
+eth_ring_rx_descriptor_status(void *rx_queue, uint16_t offset)
+{
+	const struct ring_queue *r = rx_queue;
+
+	if (unlikely(offset >= rte_ring_get_capacity(r->rng)))
+		return -EINVAL;
+
+	if (offset < rte_ring_count(r->rng))
+		return RTE_ETH_RX_DESC_DONE;
+
+	return RTE_ETH_RX_DESC_AVAIL;
+}
+
+static int
+eth_ring_tx_descriptor_status(void *tx_queue, uint16_t offset)
+{
+	const struct ring_queue *r = tx_queue;
+
+	if (unlikely(offset >= rte_ring_get_capacity(r->rng)))
+		return -EINVAL;
+
+	/*
+	 * The offset starts at the next free slot, the slots after the
+	 * free ones hold packets in flight until the peer dequeues them.
+	 */
+	if (offset < rte_ring_free_count(r->rng))
+		return RTE_ETH_TX_DESC_DONE;
+
+	return RTE_ETH_TX_DESC_FULL;
+}
+
+static void
+eth_ring_set_burst(struct rte_eth_dev *eth_dev)
+{
+	const struct pmd_internals *internals = eth_dev->data->dev_private;
+
+	if (internals->link == NULL) {
+		eth_dev->rx_pkt_burst = eth_ring_rx;
+		eth_dev->tx_pkt_burst = eth_ring_tx;
+	} else if (internals->link->compress) {
+		eth_dev->rx_pkt_burst = eth_ring_link_rx_compressed;
+		eth_dev->tx_pkt_burst = eth_ring_link_tx_compressed;
+	} else {
+		eth_dev->rx_pkt_burst = eth_ring_link_rx;
+		eth_dev->tx_pkt_burst = eth_ring_link_tx;
+	}
+
+	eth_dev->rx_queue_count = eth_ring_rx_queue_count;
+	eth_dev->rx_descriptor_status = eth_ring_rx_descriptor_status;
+	eth_dev->tx_descriptor_status = eth_ring_tx_descriptor_status;
+}
+
 static int
 eth_dev_configure(struct rte_eth_dev *dev __rte_unused) { return 0; }
 
 static int
 eth_dev_start(struct rte_eth_dev *dev)
 {
+	struct pmd_internals *internals = dev->data->dev_private;
+	struct ring_link *link = internals->link;
+	struct ring_queue *r;
+	uint16_t i;
+
+	if (link != NULL && link->compress) {
+		if (!link->range_set) {
+			PMD_LOG(ERR, "No mempool set up on the link of port %u",
+				dev->data->port_id);
+			return -EINVAL;
+		}
+
+		for (i = 0; i < dev->data->nb_rx_queues; i++) {
+			r = &internals->rx_ring_queues[i];
+			r->base = (void *)link->base;
+			r->shift = link->shift;
+		}
+		for (i = 0; i < dev->data->nb_tx_queues; i++) {
+			r = &internals->tx_ring_queues[i];
+			r->base = (void *)link->base;
+			r->shift = link->shift;
+			r->span = (UINT64_C(1) << 32) << link->shift;
+		}
+	}
+
 	dev->data->dev_link.link_status = RTE_ETH_LINK_UP;
 	return 0;
 }
@@ -152,14 +419,66 @@ eth_dev_set_link_up(struct rte_eth_dev *dev)
 	return 0;
 }
 
+/*
+ * Record the memory range of the mbufs passed on a link with compressed
+ * pointers. The range is shared by both ports of the link, so the mempools
+ * of all their Rx queues must fit in it.
+ */
+static int
+eth_ring_link_set_range(struct ring_link *link, struct rte_mempool *mp)
+{
+	struct rte_mempool_mem_range_info range;
+	uintptr_t start, end;
+	size_t align;
+	uint8_t shift;
+	int ret = 0;
+
+	if (mp == NULL || rte_mempool_get_mem_range(mp, &range) != 0)
+		return -EINVAL;
+
+	align = rte_mempool_get_obj_alignment(mp);
+	shift = RTE_PTR_COMPRESS_BIT_SHIFT_FROM_ALIGNMENT(align);
+	start = (uintptr_t)range.start;
+	end = start + range.length;
+
+	rte_spinlock_lock(&link->lock);
+	if (!link->range_set) {
+		if (RTE_PTR_COMPRESS_CAN_COMPRESS_32_SHIFT(range.length, align)) {
+			link->base = start;
+			link->shift = shift;
+			link->range_set = true;
+		} else {
+			ret = -EINVAL;
+		}
+	} else if (start < link->base || shift < link->shift ||
+			end - link->base > ((UINT64_C(1) << 32) << link->shift)) {
+		ret = -EINVAL;
+	}
+	rte_spinlock_unlock(&link->lock);
+
+	if (ret != 0)
+		PMD_LOG(ERR, "Mempool %s cannot be used with compressed pointers",
+			mp->name);
+
+	return ret;
+}
+
 static int
 eth_rx_queue_setup(struct rte_eth_dev *dev, uint16_t rx_queue_id,
 				    uint16_t nb_rx_desc __rte_unused,
 				    unsigned int socket_id __rte_unused,
 				    const struct rte_eth_rxconf *rx_conf __rte_unused,
-				    struct rte_mempool *mb_pool __rte_unused)
+				    struct rte_mempool *mb_pool)
 {
 	struct pmd_internals *internals = dev->data->dev_private;
+	int ret;
+
+	if (internals->link != NULL && internals->link->compress) {
+		ret = eth_ring_link_set_range(internals->link, mb_pool);
+		if (ret != 0)
+			return ret;
+	}
+
 	internals->rx_ring_queues[rx_queue_id].in_port = dev->data->port_id;
 	dev->data->rx_queues[rx_queue_id] = &internals->rx_ring_queues[rx_queue_id];
 	return 0;
@@ -192,6 +511,15 @@ eth_dev_info(struct rte_eth_dev *dev,
 	dev_info->max_tx_queues = (uint16_t)internals->max_tx_queues;
 	dev_info->min_rx_bufsize = 0;
 
+	dev_info->default_rxportconf.burst_size = ETH_RING_BURST_SIZE;
+	dev_info->default_txportconf.burst_size = ETH_RING_BURST_SIZE;
+	if (internals->link != NULL) {
+		dev_info->default_rxportconf.ring_size = internals->link->size;
+		dev_info->default_txportconf.ring_size = internals->link->size;
+		dev_info->default_rxportconf.nb_queues = internals->link->nb_queues;
+		dev_info->default_txportconf.nb_queues = internals->link->nb_queues;
+	}
+
 	return 0;
 }
 
@@ -200,22 +528,36 @@ eth_stats_get(struct rte_eth_dev *dev, struct rte_eth_stats *stats)
 {
 	unsigned int i;
 	unsigned long rx_total = 0, tx_total = 0;
+	uint64_t rx_bytes = 0, tx_bytes = 0, tx_errors = 0;
 	const struct pmd_internals *internal = dev->data->dev_private;
-
-	for (i = 0; i < RTE_ETHDEV_QUEUE_STAT_CNTRS &&
-			i < dev->data->nb_rx_queues; i++) {
-		stats->q_ipackets[i] = internal->rx_ring_queues[i].rx_pkts;
-		rx_total += stats->q_ipackets[i];
+	const struct ring_queue *r;
+
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
+		r = &internal->rx_ring_queues[i];
+		if (i < RTE_ETHDEV_QUEUE_STAT_CNTRS) {
+			stats->q_ipackets[i] = r->rx_pkts;
+			stats->q_ibytes[i] = r->rx_bytes;
+			rx_total += stats->q_ipackets[i];
+		}
+		rx_bytes += r->rx_bytes;
 	}
 
-	for (i = 0; i < RTE_ETHDEV_QUEUE_STAT_CNTRS &&
-			i < dev->data->nb_tx_queues; i++) {
-		stats->q_opackets[i] = internal->tx_ring_queues[i].tx_pkts;
-		tx_total += stats->q_opackets[i];
+	for (i = 0; i < dev->data->nb_tx_queues; i++) {
+		r = &internal->tx_ring_queues[i];
+		if (i < RTE_ETHDEV_QUEUE_STAT_CNTRS) {
+			stats->q_opackets[i] = r->tx_pkts;
+			stats->q_obytes[i] = r->tx_bytes;
+			tx_total += stats->q_opackets[i];
+		}
+		tx_bytes += r->tx_bytes;
+		tx_errors += r->tx_errors;
 	}
 
 	stats->ipackets = rx_total;
 	stats->opackets = tx_total;
+	stats->ibytes = rx_bytes;
+	stats->obytes = tx_bytes;
+	stats->oerrors = tx_errors;
 
 	return 0;
 }
@@ -226,14 +568,71 @@ eth_stats_reset(struct rte_eth_dev *dev)
 	unsigned int i;
 	struct pmd_internals *internal = dev->data->dev_private;
 
-	for (i = 0; i < dev->data->nb_rx_queues; i++)
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
 		internal->rx_ring_queues[i].rx_pkts = 0;
-	for (i = 0; i < dev->data->nb_tx_queues; i++)
+		internal->rx_ring_queues[i].rx_bytes = 0;
+	}
+	for (i = 0; i < dev->data->nb_tx_queues; i++) {
 		internal->tx_ring_queues[i].tx_pkts = 0;
+		internal->tx_ring_queues[i].tx_full = 0;
+		internal->tx_ring_queues[i].tx_bytes = 0;
+		internal->tx_ring_queues[i].tx_errors = 0;
+	}
 
 	return 0;
 }
 
+static const char * const eth_ring_xstats_names[] = {
+	"ring_full",
+	"compress_errors",
+};
+
+#define ETH_RING_NB_XSTATS RTE_DIM(eth_ring_xstats_names)
+
+static int
+eth_xstats_get_names(struct rte_eth_dev *dev,
+		struct rte_eth_xstat_name *xstats_names,
+		unsigned int limit)
+{
+	unsigned int nstats = dev->data->nb_tx_queues * ETH_RING_NB_XSTATS;
+	unsigned int i, j, count = 0;
+
+	if (xstats_names == NULL || limit < nstats)
+		return nstats;
+
+	for (i = 0; i < dev->data->nb_tx_queues; i++) {
+		for (j = 0; j < ETH_RING_NB_XSTATS; j++)
+			snprintf(xstats_names[count++].name,
+				 sizeof(xstats_names[0].name),
+				 "tx_q%u_%s", i, eth_ring_xstats_names[j]);
+	}
+
+	return count;
+}
+
+static int
+eth_xstats_get(struct rte_eth_dev *dev, struct rte_eth_xstat *xstats,
+		unsigned int n)
+{
+	const struct pmd_internals *internal = dev->data->dev_private;
+	unsigned int nstats = dev->data->nb_tx_queues * ETH_RING_NB_XSTATS;
+	unsigned int i, count = 0;
+
+	if (xstats == NULL || n < nstats)
+		return nstats;
+
+	for (i = 0; i < dev->data->nb_tx_queues; i++) {
+		xstats[count].id = count;
+		xstats[count].value = internal->tx_ring_queues[i].tx_full;
+		count++;
+		xstats[count].id = count;
+		xstats[count].value = internal->tx_ring_queues[i].tx_errors;
+		count++;
+	}
+
+	return count;
+}
+
 static void
 eth_mac_addr_remove(struct rte_eth_dev *dev __rte_unused,
 	uint32_t index __rte_unused)
@@ -277,6 +676,22 @@ static int
 eth_link_update(struct rte_eth_dev *dev __rte_unused,
 		int wait_to_complete __rte_unused) { return 0; }
 
+static void
+eth_ring_link_release(struct ring_link *link, unsigned int side)
+{
+	const struct rte_memzone *mz = link->mz;
+	unsigned int dir, i;
+
+	link->sides &= ~RTE_BIT32(side);
+	if (link->sides != 0)
+		return;
+
+	for (dir = 0; dir < RTE_DIM(link->rings); dir++)
+		for (i = 0; i < link->nb_queues; i++)
+			rte_ring_free(link->rings[dir][i]);
+	rte_memzone_free(mz);
+}
+
 static int
 eth_dev_close(struct rte_eth_dev *dev)
 {
@@ -291,7 +706,10 @@ eth_dev_close(struct rte_eth_dev *dev)
 	ret = eth_dev_stop(dev);
 
 	internals = dev->data->dev_private;
-	if (internals->action == DEV_CREATE) {
+	if (internals->link != NULL) {
+		eth_ring_link_release(internals->link, internals->link_side);
+		internals->link = NULL;
+	} else if (internals->action == DEV_CREATE) {
 		/*
 		 * it is only necessary to delete the rings in rx_queues because
 		 * they are the same used in tx_queues
@@ -344,6 +762,8 @@ static const struct eth_dev_ops ops = {
 	.link_update = eth_link_update,
 	.stats_get = eth_stats_get,
 	.stats_reset = eth_stats_reset,
+	.xstats_get = eth_xstats_get,
+	.xstats_get_names = eth_xstats_get_names,
 	.mac_addr_remove = eth_mac_addr_remove,
 	.mac_addr_add = eth_mac_addr_add,
 	.promiscuous_enable = eth_promiscuous_enable,
@@ -361,6 +781,7 @@ do_eth_dev_ring_create(const char *name,
 		struct rte_ring *const tx_queues[],
 		const unsigned int nb_tx_queues,
 		const unsigned int numa_node, enum dev_action action,
+		struct ring_link *link, unsigned int link_side,
 		struct rte_eth_dev **eth_dev_p)
 {
 	struct rte_eth_dev_data *data = NULL;
@@ -415,6 +836,8 @@ do_eth_dev_ring_create(const char *name,
 	data->tx_queues = tx_queues_local;
 
 	internals->action = action;
+	internals->link = link;
+	internals->link_side = link_side;
 	internals->max_rx_queues = nb_rx_queues;
 	internals->max_tx_queues = nb_tx_queues;
 	for (i = 0; i < nb_rx_queues; i++) {
@@ -441,8 +864,7 @@ do_eth_dev_ring_create(const char *name,
 	data->numa_node = numa_node;
 
 	/* finally assign rx and tx ops */
-	eth_dev->rx_pkt_burst = eth_ring_rx;
-	eth_dev->tx_pkt_burst = eth_ring_tx;
+	eth_ring_set_burst(eth_dev);
 
 	rte_eth_dev_probing_finish(eth_dev);
 	*eth_dev_p = eth_dev;
@@ -558,8 +980,115 @@ eth_dev_ring_create(const char *name,
 	}
 
 	if (do_eth_dev_ring_create(name, vdev, rxtx, num_rings, rxtx, num_rings,
-		numa_node, action, eth_dev) < 0)
+		numa_node, action, NULL, 0, eth_dev) < 0)
+		return -1;
+
+	return 0;
+}
+
+struct ring_link_args {
+	char name[RTE_MEMZONE_NAMESIZE];
+	unsigned int nb_queues;
+	unsigned int size;
+	unsigned int compress;
+};
+
+static struct ring_link *
+eth_ring_link_create(const char *link_name, const struct ring_link_args *args,
+		const unsigned int numa_node)
+{
+	char mz_name[RTE_MEMZONE_NAMESIZE];
+	char rng_name[RTE_RING_NAMESIZE];
+	const struct rte_memzone *mz;
+	struct ring_link *link;
+	unsigned int dir, i;
+	int cc;
+
+	cc = snprintf(mz_name, sizeof(mz_name), "RL_%s", link_name);
+	if (cc >= (int)sizeof(mz_name)) {
+		rte_errno = ENAMETOOLONG;
+		return NULL;
+	}
+
+	mz = rte_memzone_lookup(mz_name);
+	if (mz != NULL)
+		return mz->addr;
+
+	mz = rte_memzone_reserve(mz_name, sizeof(*link), numa_node, 0);
+	if (mz == NULL)
+		return NULL;
+
+	link = mz->addr;
+	memset(link, 0, sizeof(*link));
+	link->mz = mz;
+	link->nb_queues = args->nb_queues;
+	link->size = args->size;
+	link->compress = args->compress != 0;
+	rte_spinlock_init(&link->lock);
+
+	for (dir = 0; dir < RTE_DIM(link->rings); dir++) {
+		for (i = 0; i < link->nb_queues; i++) {
+			cc = snprintf(rng_name, sizeof(rng_name), "RL%u%c_%s",
+				      i, 'A' + dir, link_name);
+			if (cc >= (int)sizeof(rng_name)) {
+				rte_errno = ENAMETOOLONG;
+				goto error;
+			}
+
+			link->rings[dir][i] = rte_ring_create_elem(rng_name,
+				link->compress ? sizeof(uint32_t) : sizeof(void *),
+				link->size, numa_node,
+				RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+			if (link->rings[dir][i] == NULL)
+				goto error;
+		}
+	}
+
+	return link;
+
+error:
+	for (dir = 0; dir < RTE_DIM(link->rings); dir++)
+		for (i = 0; i < link->nb_queues; i++)
+			rte_ring_free(link->rings[dir][i]);
+	rte_memzone_free(mz);
+	return NULL;
+}
+
+static int
+eth_dev_ring_link_create(const char *name,
+		struct rte_vdev_device *vdev,
+		const struct ring_link_args *args,
+		const unsigned int numa_node, struct rte_eth_dev **eth_dev)
+{
+	struct ring_link *link;
+	unsigned int side;
+
+	link = eth_ring_link_create(args->name, args, numa_node);
+	if (link == NULL) {
+		PMD_LOG(ERR, "Cannot create link %s", args->name);
+		return -1;
+	}
+
+	/* the second port uses the configuration of the link */
+	if (link->sides == (RTE_BIT32(0) | RTE_BIT32(1))) {
+		PMD_LOG(ERR, "Link %s already has two ports", args->name);
+		rte_errno = EBUSY;
 		return -1;
+	}
+	side = (link->sides & RTE_BIT32(0)) ? 1 : 0;
+
+	PMD_LOG(INFO, "Attaching %s to side %u of link %s", name, side,
+		args->name);
+
+	if (do_eth_dev_ring_create(name, vdev, link->rings[side], link->nb_queues,
+			link->rings[side ^ 1], link->nb_queues, numa_node,
+			DEV_ATTACH, link, side, eth_dev) < 0) {
+		if (link->sides == 0)
+			eth_ring_link_release(link, side);
+		return -1;
+	}
+
+	link->sides |= RTE_BIT32(side);
 
 	return 0;
 }
@@ -676,6 +1205,76 @@ parse_internal_args(const char *key __rte_unused, const char *value,
 	return 0;
 }
 
+static int
+parse_link_name(const char *key __rte_unused, const char *value, void *data)
+{
+	struct ring_link_args *args = data;
+
+	if (value[0] == '\0' || strlen(value) > ETH_RING_LINK_NAME_MAX_LEN ||
+			strlcpy(args->name, value, sizeof(args->name)) >= sizeof(args->name)) {
+		PMD_LOG(ERR, "Invalid link name %s", value);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+parse_uint(const char *key, const char *value, void *data)
+{
+	unsigned int *val = data;
+	unsigned long v;
+	char *end;
+
+	errno = 0;
+	v = strtoul(value, &end, 0);
+	if (errno != 0 || *end != '\0' || v > UINT32_MAX) {
+		PMD_LOG(ERR, "Invalid %s value %s", key, value);
+		return -1;
+	}
+
+	*val = v;
+
+	return 0;
+}
+
+static int
+parse_link_args(struct rte_kvargs *kvlist, struct ring_link_args *args)
+{
+	args->nb_queues = 1;
+	args->size = ETH_RING_LINK_DEFAULT_SIZE;
+	args->compress = 0;
+
+	if (rte_kvargs_process(kvlist, ETH_RING_LINK_ARG, parse_link_name, args) < 0 ||
+	    rte_kvargs_process(kvlist, ETH_RING_QUEUES_ARG, parse_uint, &args->nb_queues) < 0 ||
+	    rte_kvargs_process(kvlist, ETH_RING_SIZE_ARG, parse_uint, &args->size) < 0 ||
+	    rte_kvargs_process(kvlist, ETH_RING_COMPRESS_ARG, parse_uint, &args->compress) < 0)
+		return -1;
+
+	if (args->nb_queues == 0 ||
+			args->nb_queues > (unsigned int)RTE_MIN(RTE_PMD_RING_MAX_RX_RINGS,
+						RTE_PMD_RING_MAX_TX_RINGS)) {
+		PMD_LOG(ERR, "Invalid number of queues %u", args->nb_queues);
+		return -1;
+	}
+	if (args->size == 0 || args->size > RTE_RING_SZ_MASK) {
+		PMD_LOG(ERR, "Invalid ring size %u", args->size);
+		return -1;
+	}
+	if (args->compress > 1) {
+		PMD_LOG(ERR, "Invalid compress value %u", args->compress);
+		return -1;
+	}
+	if (snprintf(NULL, 0, "RL%u%c_%s", args->nb_queues - 1, 'A',
+			args->name) >= (int)RTE_RING_NAMESIZE) {
+		PMD_LOG(ERR, "Link name %s too long for %u queues",
+			args->name, args->nb_queues);
+		return -1;
+	}
+
+	return 0;
+}
+
 static int
 rte_pmd_ring_probe(struct rte_vdev_device *dev)
 {
@@ -685,6 +1284,7 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 	struct node_action_list *info = NULL;
 	struct rte_eth_dev *eth_dev = NULL;
 	struct ring_internal_args *internal_args;
+	struct ring_link_args link_args;
 
 	name = rte_vdev_device_name(dev);
 	params = rte_vdev_device_args(dev);
@@ -700,8 +1300,7 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 		eth_dev->dev_ops = &ops;
 		eth_dev->device = &dev->device;
 
-		eth_dev->rx_pkt_burst = eth_ring_rx;
-		eth_dev->tx_pkt_burst = eth_ring_tx;
+		eth_ring_set_burst(eth_dev);
 
 		rte_eth_dev_probing_finish(eth_dev);
 
@@ -750,9 +1349,17 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 				internal_args->nb_tx_queues,
 				internal_args->numa_node,
 				DEV_ATTACH,
+				NULL, 0,
 				&eth_dev);
 			if (ret >= 0)
 				ret = 0;
+		} else if (rte_kvargs_count(kvlist, ETH_RING_LINK_ARG) == 1) {
+			ret = parse_link_args(kvlist, &link_args);
+			if (ret < 0)
+				goto out_free;
+
+			ret = eth_dev_ring_link_create(name, dev, &link_args,
+						       rte_socket_id(), &eth_dev);
 		} else {
 			ret = rte_kvargs_count(kvlist, ETH_RING_NUMA_NODE_ACTION_ARG);
 			info = rte_zmalloc("struct node_action_list",
@@ -826,4 +1433,8 @@ static struct rte_vdev_driver pmd_ring_drv = {
 RTE_PMD_REGISTER_VDEV(net_ring, pmd_ring_drv);
 RTE_PMD_REGISTER_ALIAS(net_ring, eth_ring);
 RTE_PMD_REGISTER_PARAM_STRING(net_ring,
-	ETH_RING_NUMA_NODE_ACTION_ARG "=name:node:action(ATTACH|CREATE)");
+	ETH_RING_NUMA_NODE_ACTION_ARG "=name:node:action(ATTACH|CREATE) "
+	ETH_RING_LINK_ARG "=<string> "
+	ETH_RING_QUEUES_ARG "=<int> "
+	ETH_RING_SIZE_ARG "=<int> "
+	ETH_RING_COMPRESS_ARG "=<0|1>");
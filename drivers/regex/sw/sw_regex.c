@@ -0,0 +1,654 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bus_vdev_driver.h>
+#include <rte_errno.h>
+#include <rte_kvargs.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_regexdev_driver.h>
+
+#include "sw_regex.h"
+
+#define SW_REGEX_DRIVER_NAME	regex_sw
+
+RTE_LOG_REGISTER_DEFAULT(sw_regex_logtype, INFO);
+
+static int
+sw_regex_info_get(struct rte_regexdev *dev,
+		struct rte_regexdev_info *info)
+{
+	info->driver_name = RTE_STR(SW_REGEX_DRIVER_NAME);
+	info->dev = dev->device;
+	info->max_matches = SW_REGEX_MAX_MATCHES;
+	info->max_queue_pairs = SW_REGEX_MAX_QPS;
+	info->max_payload_size = SW_REGEX_MAX_PAYLOAD;
+	info->max_segs = SW_REGEX_MAX_SEGS;
+	info->max_rules_per_group = SW_REGEX_MAX_RULES;
+	info->max_groups = SW_REGEX_MAX_GROUPS;
+	info->regexdev_capa = RTE_REGEXDEV_CAPA_RUNTIME_COMPILATION_F |
+			      RTE_REGEXDEV_CAPA_SUPP_PCRE_START_ANCHOR_F;
+	info->rule_flags = SW_REGEX_RULE_FLAGS;
+
+	return 0;
+}
+
+static void
+sw_regex_qps_free(struct sw_regex_priv *priv)
+{
+	struct sw_regex_qp *qp;
+	uint16_t i;
+
+	for (i = 0; i < priv->nb_qps; i++) {
+		qp = priv->qps[i];
+		if (qp == NULL)
+			continue;
+		sw_regex_qp_scratch_free(qp);
+		rte_free(qp->ring);
+		rte_free(qp);
+	}
+	rte_free(priv->qps);
+	priv->qps = NULL;
+	priv->nb_qps = 0;
+}
+
+void
+sw_regex_rules_free(struct sw_regex_priv *priv)
+{
+	uint32_t i;
+
+	for (i = 0; i < priv->nb_rules; i++)
+		rte_free(priv->rules[i].pattern);
+	rte_free(priv->rules);
+	priv->rules = NULL;
+	priv->nb_rules = 0;
+	priv->rules_sz = 0;
+}
+
+static int
+sw_regex_rule_add(struct sw_regex_priv *priv, uint32_t rule_id,
+		uint16_t group_id, uint64_t rule_flags, const char *pattern,
+		size_t len)
+{
+	struct sw_regex_rule_entry *rules, *rule;
+	uint32_t sz;
+
+	if (priv->nb_rules == SW_REGEX_MAX_RULES)
+		return -ENOSPC;
+
+	if (priv->nb_rules == priv->rules_sz) {
+		sz = RTE_MAX(priv->rules_sz * 2, 64U);
+		rules = rte_realloc(priv->rules, sz * sizeof(*rules), 0);
+		if (rules == NULL)
+			return -ENOMEM;
+		priv->rules = rules;
+		priv->rules_sz = sz;
+	}
+
+	rule = &priv->rules[priv->nb_rules];
+	rule->pattern = rte_malloc(NULL, len + 1, 0);
+	if (rule->pattern == NULL)
+		return -ENOMEM;
+	memcpy(rule->pattern, pattern, len);
+	rule->pattern[len] = '\0';
+	rule->rule_id = rule_id;
+	rule->group_id = group_id;
+	rule->rule_flags = rule_flags;
+	priv->nb_rules++;
+
+	return 0;
+}
+
+static void
+sw_regex_rule_remove(struct sw_regex_priv *priv, uint32_t rule_id,
+		uint16_t group_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < priv->nb_rules; i++) {
+		if (priv->rules[i].rule_id != rule_id ||
+				priv->rules[i].group_id != group_id)
+			continue;
+		rte_free(priv->rules[i].pattern);
+		memmove(&priv->rules[i], &priv->rules[i + 1],
+			(priv->nb_rules - i - 1) * sizeof(priv->rules[0]));
+		priv->nb_rules--;
+		i--;
+	}
+}
+
+static int
+sw_regex_rule_db_update(struct rte_regexdev *dev,
+		const struct rte_regexdev_rule *rules, uint16_t nb_rules)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	const struct rte_regexdev_rule *rule;
+	uint16_t i;
+	int ret = 0;
+
+	for (i = 0; i < nb_rules; i++) {
+		rule = &rules[i];
+		if (rule->rule_id > SW_REGEX_MAX_RULE_ID ||
+				rule->group_id >= SW_REGEX_MAX_GROUPS) {
+			SW_REGEX_LOG(ERR, "Invalid rule %u of group %u",
+				rule->rule_id, rule->group_id);
+			ret = -EINVAL;
+			break;
+		}
+		if (rule->op == RTE_REGEX_RULE_OP_REMOVE) {
+			sw_regex_rule_remove(priv, rule->rule_id,
+					rule->group_id);
+			continue;
+		}
+		if (rule->op != RTE_REGEX_RULE_OP_ADD ||
+				rule->pcre_rule == NULL) {
+			ret = -EINVAL;
+			break;
+		}
+		if (rule->rule_flags & ~SW_REGEX_RULE_FLAGS) {
+			SW_REGEX_LOG(ERR, "Unsupported flags 0x%" PRIx64
+				" of rule %u", rule->rule_flags, rule->rule_id);
+			ret = -ENOTSUP;
+			break;
+		}
+		ret = sw_regex_rule_add(priv, rule->rule_id, rule->group_id,
+				rule->rule_flags, rule->pcre_rule,
+				strnlen(rule->pcre_rule, rule->pcre_rule_len));
+		if (ret < 0)
+			break;
+	}
+
+	if (ret < 0)
+		rte_errno = -ret;
+
+	return i;
+}
+
+static int
+sw_regex_rule_db_compile_activate(struct rte_regexdev *dev)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	struct sw_regex_db *db;
+	uint16_t i;
+	int ret;
+
+	if (dev->data->dev_started) {
+		SW_REGEX_LOG(ERR, "Device %s must be stopped",
+			dev->data->dev_name);
+		return -EBUSY;
+	}
+
+	db = sw_regex_compile(priv->rules, priv->nb_rules,
+			priv->max_dfa_states);
+	if (db == NULL)
+		return -rte_errno;
+
+	for (i = 0; i < priv->nb_qps; i++) {
+		if (priv->qps[i] == NULL)
+			continue;
+		ret = sw_regex_qp_scratch_alloc(priv->qps[i], db);
+		if (ret < 0) {
+			sw_regex_db_free(db);
+			return ret;
+		}
+	}
+
+	sw_regex_db_free(priv->db);
+	priv->db = db;
+
+	SW_REGEX_LOG(INFO, "Device %s: %u rules, %u DFA states",
+		dev->data->dev_name, db->nb_rules, db->nb_dfa);
+
+	return 0;
+}
+
+/*
+ * The rule database is a text with a rule per line, as
+ * "rule_id,group_id,pattern". Empty lines and lines starting with '#'
+ * are ignored.
+ */
+int
+sw_regex_rules_parse(struct sw_regex_priv *priv, const char *rule_db,
+		uint32_t rule_db_len)
+{
+	unsigned long rule_id, group_id;
+	const char *line, *eol, *end;
+	char num[32], *p;
+	uint32_t lineno = 0;
+	size_t len;
+	int ret = 0;
+
+	end = rule_db + strnlen(rule_db, rule_db_len);
+	for (line = rule_db; line < end && ret == 0; line = eol + 1) {
+		lineno++;
+		eol = memchr(line, '\n', end - line);
+		if (eol == NULL)
+			eol = end;
+		len = eol - line;
+		if (len != 0 && line[len - 1] == '\r')
+			len--;
+		if (len == 0 || line[0] == '#')
+			continue;
+
+		/* The numbers are parsed from a nul terminated copy */
+		memcpy(num, line, RTE_MIN(len, sizeof(num) - 1));
+		num[RTE_MIN(len, sizeof(num) - 1)] = '\0';
+		errno = 0;
+		rule_id = strtoul(num, &p, 0);
+		if (errno != 0 || p == num || *p != ',')
+			goto syntax_err;
+		group_id = strtoul(p + 1, &p, 0);
+		if (errno != 0 || *p != ',')
+			goto syntax_err;
+		if (rule_id > SW_REGEX_MAX_RULE_ID ||
+				group_id >= SW_REGEX_MAX_GROUPS)
+			goto syntax_err;
+
+		p++;
+		ret = sw_regex_rule_add(priv, rule_id, group_id, 0,
+				line + (p - num), len - (p - num));
+		continue;
+
+syntax_err:
+		SW_REGEX_LOG(ERR, "Invalid rule at line %u", lineno);
+		ret = -EINVAL;
+	}
+
+	return ret;
+}
+
+static int
+sw_regex_rule_db_import(struct rte_regexdev *dev, const char *rule_db,
+		uint32_t rule_db_len)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	struct sw_regex_rule_entry *rules;
+	uint32_t nb_rules, rules_sz;
+	int ret;
+
+	if (dev->data->dev_started)
+		return -EBUSY;
+
+	/* Keep the current rules until the new ones are parsed */
+	rules = priv->rules;
+	nb_rules = priv->nb_rules;
+	rules_sz = priv->rules_sz;
+	priv->rules = NULL;
+	priv->nb_rules = 0;
+	priv->rules_sz = 0;
+
+	ret = sw_regex_rules_parse(priv, rule_db, rule_db_len);
+	if (ret == 0)
+		ret = sw_regex_rule_db_compile_activate(dev);
+
+	if (ret < 0) {
+		/* Restore the previous rules */
+		sw_regex_rules_free(priv);
+		priv->rules = rules;
+		priv->nb_rules = nb_rules;
+		priv->rules_sz = rules_sz;
+	} else {
+		for (; nb_rules != 0; nb_rules--)
+			rte_free(rules[nb_rules - 1].pattern);
+		rte_free(rules);
+	}
+
+	return ret;
+}
+
+static int
+sw_regex_rule_print(char *buf, size_t size,
+		const struct sw_regex_rule_entry *rule)
+{
+	uint64_t flags = rule->rule_flags;
+
+	return snprintf(buf, size, "%u,%u,%s%s%s%s%s\n",
+		rule->rule_id, rule->group_id,
+		(flags & (RTE_REGEX_PCRE_RULE_CASELESS_F |
+			  RTE_REGEX_PCRE_RULE_DOTALL_F)) ? "(?" : "",
+		(flags & RTE_REGEX_PCRE_RULE_CASELESS_F) ? "i" : "",
+		(flags & RTE_REGEX_PCRE_RULE_DOTALL_F) ? "s)" :
+		(flags & RTE_REGEX_PCRE_RULE_CASELESS_F) ? ")" : "",
+		(flags & RTE_REGEX_PCRE_RULE_ANCHORED_F) ? "^" : "",
+		rule->pattern);
+}
+
+/*
+ * Export the rules in the format of sw_regex_rules_parse(), the rule
+ * flags being written as inline options. The returned size includes
+ * the terminating nul character, without buffer only the size is computed.
+ */
+int
+sw_regex_rules_export(const struct sw_regex_priv *priv, char *rule_db)
+{
+	uint32_t i;
+	int len, size;
+
+	size = 1;
+	for (i = 0; i < priv->nb_rules; i++)
+		size += sw_regex_rule_print(NULL, 0, &priv->rules[i]);
+
+	if (rule_db == NULL)
+		return size;
+
+	rule_db[0] = '\0';
+	for (i = 0, len = 0; i < priv->nb_rules; i++)
+		len += sw_regex_rule_print(rule_db + len, size - len,
+				&priv->rules[i]);
+
+	return size;
+}
+
+static int
+sw_regex_rule_db_export(struct rte_regexdev *dev, char *rule_db)
+{
+	return sw_regex_rules_export(dev->data->dev_private, rule_db);
+}
+
+static int
+sw_regex_configure(struct rte_regexdev *dev,
+		const struct rte_regexdev_config *cfg)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	int ret;
+
+	sw_regex_qps_free(priv);
+
+	priv->qps = rte_zmalloc(NULL,
+			cfg->nb_queue_pairs * sizeof(priv->qps[0]), 0);
+	if (priv->qps == NULL)
+		return -ENOMEM;
+	priv->nb_qps = cfg->nb_queue_pairs;
+	priv->nb_max_matches = cfg->nb_max_matches;
+
+	if (cfg->rule_db != NULL) {
+		ret = sw_regex_rule_db_import(dev, cfg->rule_db,
+				cfg->rule_db_len);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int
+sw_regex_qp_setup(struct rte_regexdev *dev, uint16_t qp_id,
+		const struct rte_regexdev_qp_conf *qp_conf)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	struct sw_regex_qp *qp;
+	uint32_t nb_desc;
+	int ret;
+
+	if (qp_id >= priv->nb_qps)
+		return -EINVAL;
+	if (qp_conf->nb_desc == 0)
+		return -EINVAL;
+
+	qp = priv->qps[qp_id];
+	if (qp != NULL) {
+		sw_regex_qp_scratch_free(qp);
+		rte_free(qp->ring);
+		rte_free(qp);
+		priv->qps[qp_id] = NULL;
+	}
+
+	qp = rte_zmalloc(NULL, sizeof(*qp), RTE_CACHE_LINE_SIZE);
+	if (qp == NULL)
+		return -ENOMEM;
+
+	nb_desc = rte_align32pow2(qp_conf->nb_desc);
+	qp->ring = rte_zmalloc(NULL, nb_desc * sizeof(qp->ring[0]),
+			RTE_CACHE_LINE_SIZE);
+	if (qp->ring == NULL) {
+		rte_free(qp);
+		return -ENOMEM;
+	}
+	qp->mask = nb_desc - 1;
+
+	if (priv->db != NULL) {
+		ret = sw_regex_qp_scratch_alloc(qp, priv->db);
+		if (ret < 0) {
+			rte_free(qp->ring);
+			rte_free(qp);
+			return ret;
+		}
+	}
+
+	priv->qps[qp_id] = qp;
+
+	return 0;
+}
+
+static int
+sw_regex_start(struct rte_regexdev *dev)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	uint16_t i;
+
+	for (i = 0; i < priv->nb_qps; i++) {
+		if (priv->qps[i] == NULL) {
+			SW_REGEX_LOG(ERR, "Queue pair %u is not set up", i);
+			return -EINVAL;
+		}
+	}
+
+	if (priv->db == NULL)
+		SW_REGEX_LOG(WARNING, "Device %s started without rules",
+			dev->data->dev_name);
+
+	return 0;
+}
+
+static int
+sw_regex_stop(struct rte_regexdev *dev __rte_unused)
+{
+	return 0;
+}
+
+static int
+sw_regex_close(struct rte_regexdev *dev)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+
+	sw_regex_qps_free(priv);
+	sw_regex_rules_free(priv);
+	sw_regex_db_free(priv->db);
+	priv->db = NULL;
+
+	return 0;
+}
+
+static int
+sw_regex_dump(struct rte_regexdev *dev, FILE *f)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	const struct sw_regex_db *db = priv->db;
+	uint8_t i;
+
+	fprintf(f, "  max_dfa_states: %u\n", priv->max_dfa_states);
+	fprintf(f, "  queue_pairs: %u\n", priv->nb_qps);
+	fprintf(f, "  rules: %u\n", priv->nb_rules);
+	if (db == NULL) {
+		fprintf(f, "  database: none\n");
+		return 0;
+	}
+
+	fprintf(f, "  database:\n");
+	fprintf(f, "    rules: %u\n", db->nb_rules);
+	fprintf(f, "    nfa_states: %u\n", db->nb_nfa);
+	fprintf(f, "    dfa_states: %u\n", db->nb_dfa);
+	fprintf(f, "    byte_classes: %u\n", db->nb_cls);
+	fprintf(f, "    transition_table: %zu bytes\n",
+		(size_t)db->nb_dfa * db->nb_cls * sizeof(uint32_t));
+	fprintf(f, "    idle_escape_bytes:");
+	if (db->nb_escape == 0)
+		fprintf(f, " none");
+	for (i = 0; i < db->nb_escape; i++)
+		fprintf(f, " 0x%02x", db->escape[i]);
+	fprintf(f, "\n");
+
+	return 0;
+}
+
+static int
+sw_regex_dev_selftest(struct rte_regexdev *dev)
+{
+	return sw_regex_selftest(dev);
+}
+
+static const struct rte_regexdev_ops sw_regex_ops = {
+	.dev_info_get = sw_regex_info_get,
+	.dev_configure = sw_regex_configure,
+	.dev_qp_setup = sw_regex_qp_setup,
+	.dev_start = sw_regex_start,
+	.dev_stop = sw_regex_stop,
+	.dev_close = sw_regex_close,
+	.dev_rule_db_update = sw_regex_rule_db_update,
+	.dev_rule_db_compile_activate = sw_regex_rule_db_compile_activate,
+	.dev_db_import = sw_regex_rule_db_import,
+	.dev_db_export = sw_regex_rule_db_export,
+	.dev_selftest = sw_regex_dev_selftest,
+	.dev_dump = sw_regex_dump,
+};
+
+static int
+sw_regex_parse_max_dfa_states(const char *key __rte_unused,
+		const char *value, void *opaque)
+{
+	unsigned long val;
+	char *end;
+
+	if (value == NULL || opaque == NULL)
+		return -EINVAL;
+
+	errno = 0;
+	val = strtoul(value, &end, 0);
+	if (errno != 0 || *end != '\0' || val < 2 ||
+			val > SW_REGEX_MAX_DFA_STATES) {
+		SW_REGEX_LOG(ERR, "Invalid %s %s, must be in [2, %u]",
+			key, value, SW_REGEX_MAX_DFA_STATES);
+		return -EINVAL;
+	}
+	*(uint32_t *)opaque = val;
+
+	return 0;
+}
+
+static int
+sw_regex_parse_vdev_args(struct rte_vdev_device *vdev,
+		struct sw_regex_priv *priv)
+{
+	static const char *const args[] = {
+		SW_REGEX_ARG_MAX_DFA_STATES,
+		NULL
+	};
+	struct rte_kvargs *kvlist;
+	const char *params;
+	int ret;
+
+	params = rte_vdev_device_args(vdev);
+	if (params == NULL || params[0] == '\0')
+		return 0;
+
+	kvlist = rte_kvargs_parse(params, args);
+	if (kvlist == NULL)
+		return -EINVAL;
+
+	ret = rte_kvargs_process(kvlist, SW_REGEX_ARG_MAX_DFA_STATES,
+			sw_regex_parse_max_dfa_states, &priv->max_dfa_states);
+
+	rte_kvargs_free(kvlist);
+
+	return ret;
+}
+
+static int
+sw_regex_probe(struct rte_vdev_device *vdev)
+{
+	struct sw_regex_priv *priv;
+	struct rte_regexdev *dev;
+	const char *name;
+	int ret;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+
+	if (rte_eal_process_type() != RTE_PROC_PRIMARY) {
+		SW_REGEX_LOG(ERR, "Multiple process not supported for %s",
+			name);
+		return -EINVAL;
+	}
+
+	priv = rte_zmalloc_socket(name, sizeof(*priv), RTE_CACHE_LINE_SIZE,
+			rte_socket_id());
+	if (priv == NULL)
+		return -ENOMEM;
+	priv->max_dfa_states = SW_REGEX_DEF_DFA_STATES;
+
+	ret = sw_regex_parse_vdev_args(vdev, priv);
+	if (ret < 0)
+		goto err;
+
+	dev = rte_regexdev_register(name);
+	if (dev == NULL) {
+		SW_REGEX_LOG(ERR, "Failed to register %s", name);
+		ret = -ENOMEM;
+		goto err;
+	}
+
+	priv->dev = dev;
+	dev->dev_ops = &sw_regex_ops;
+	dev->enqueue = sw_regex_enqueue;
+	dev->dequeue = sw_regex_dequeue;
+	dev->device = &vdev->device;
+	dev->data->dev_private = priv;
+	dev->state = RTE_REGEXDEV_READY;
+
+	SW_REGEX_LOG(INFO, "Create %s regexdev with up to %u DFA states",
+		name, priv->max_dfa_states);
+
+	return 0;
+
+err:
+	rte_free(priv);
+	return ret;
+}
+
+static int
+sw_regex_remove(struct rte_vdev_device *vdev)
+{
+	struct sw_regex_priv *priv;
+	struct rte_regexdev *dev;
+	const char *name;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+
+	dev = rte_regexdev_get_device_by_name(name);
+	if (dev == NULL)
+		return -ENODEV;
+
+	priv = dev->data->dev_private;
+	sw_regex_close(dev);
+	rte_regexdev_unregister(dev);
+	rte_free(priv);
+
+	return 0;
+}
+
+static struct rte_vdev_driver sw_regex_pmd_drv = {
+	.probe = sw_regex_probe,
+	.remove = sw_regex_remove,
+};
+
+RTE_PMD_REGISTER_VDEV(SW_REGEX_DRIVER_NAME, sw_regex_pmd_drv);
+RTE_PMD_REGISTER_PARAM_STRING(SW_REGEX_DRIVER_NAME,
+		SW_REGEX_ARG_MAX_DFA_STATES "=<uint32> ");
@@ -0,0 +1,184 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#ifndef _SW_REGEX_H_
+#define _SW_REGEX_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <rte_common.h>
+#include <rte_log.h>
+#include <rte_regexdev.h>
+#include <rte_regexdev_core.h>
+
+extern int sw_regex_logtype;
+#define RTE_LOGTYPE_SW_REGEX sw_regex_logtype
+#define SW_REGEX_LOG(level, ...) \
+	RTE_LOG_LINE_PREFIX(level, SW_REGEX, "%s(): ", __func__, __VA_ARGS__)
+
+#define SW_REGEX_ARG_MAX_DFA_STATES	"max_dfa_states"
+
+#define SW_REGEX_MAX_QPS		RTE_MAX_LCORE
+#define SW_REGEX_MAX_MATCHES		255
+#define SW_REGEX_MAX_PAYLOAD		UINT16_MAX
+#define SW_REGEX_MAX_SEGS		UINT16_MAX
+#define SW_REGEX_MAX_GROUPS		(1 << 12)
+#define SW_REGEX_MAX_RULES		(1 << 16)
+#define SW_REGEX_MAX_RULE_ID		((1 << 20) - 1)
+#define SW_REGEX_MAX_NFA_STATES		(1 << 20)
+#define SW_REGEX_DEF_DFA_STATES		32768
+#define SW_REGEX_MAX_DFA_STATES		(1 << 20)
+#define SW_REGEX_MAX_REPEAT		1000
+
+#define SW_REGEX_RULE_FLAGS	(RTE_REGEX_PCRE_RULE_ANCHORED_F | \
+				 RTE_REGEX_PCRE_RULE_CASELESS_F | \
+				 RTE_REGEX_PCRE_RULE_DOTALL_F)
+
+/* Bytes leaving the idle state looked up with SIMD at most */
+#define SW_REGEX_MAX_ESCAPE	4
+
+/* A DFA transition to an accepting state has this bit set */
+#define SW_REGEX_DFA_ACCEPT	(1U << 31)
+
+enum sw_regex_nfa_type {
+	SW_REGEX_NFA_CLASS,	/**< Consume a byte of a class. */
+	SW_REGEX_NFA_SPLIT,	/**< Epsilon transitions to out and out1. */
+	SW_REGEX_NFA_EMPTY,	/**< Epsilon transition to out. */
+	SW_REGEX_NFA_MATCH,	/**< Match of a rule. */
+};
+
+struct sw_regex_nfa_state {
+	uint8_t type;
+	uint32_t out;
+	/* Second target of a split, class of a class state or rule index
+	 * of a match state.
+	 */
+	uint32_t arg;
+};
+
+/* Rule as stored in the rule set of the device */
+struct sw_regex_rule_entry {
+	uint32_t rule_id;
+	uint16_t group_id;
+	uint64_t rule_flags;
+	char *pattern;
+};
+
+/* Rule as compiled in a database */
+struct sw_regex_rule {
+	uint32_t rule_id;
+	uint16_t group_id;
+	uint8_t anchored;
+	uint8_t end_anchored;
+	/* NFA states of the rule, from its start state */
+	uint32_t nfa_first;
+	uint32_t nfa_nb;
+};
+
+/* Compiled rule database, read only once activated */
+struct sw_regex_db {
+	uint32_t nb_rules;
+	struct sw_regex_rule *rules;
+
+	uint32_t nb_nfa;
+	struct sw_regex_nfa_state *nfa;
+	uint64_t (*classes)[4];
+	uint32_t max_rule_nfa;
+
+	/* DFA states are stored pre-multiplied by the number of byte classes */
+	uint32_t nb_dfa;
+	uint32_t nb_cls;
+	uint8_t cmap[256];
+	uint32_t *trans;
+	uint32_t start;
+	uint32_t idle;
+	/* Rules accepted by each DFA state, indexed by state number */
+	uint32_t *accept_idx;
+	uint32_t *accept_rules;
+
+	/* Bytes leaving the idle state, when few enough to skip to them */
+	uint8_t nb_escape;
+	uint8_t escape[SW_REGEX_MAX_ESCAPE];
+};
+
+/* Per queue pair state, a queue pair being used by a single lcore */
+struct sw_regex_qp {
+	struct rte_regex_ops **ring;
+	uint32_t mask;
+	uint32_t head;
+	uint32_t tail;
+
+	/* Scratch memory of the scan, sized for the active database */
+	uint32_t scan_gen;
+	uint32_t nb_rules_max;
+	uint32_t *rule_gen;
+	uint32_t *rule_end;
+	uint32_t *matched;
+	uint32_t nfa_max;
+	uint32_t *nfa_gen;
+	uint32_t *clist;
+	uint32_t *nlist;
+	uint32_t *stack;
+};
+
+static inline int
+sw_regex_class_test(const uint64_t *cls, uint8_t c)
+{
+	return (cls[c >> 6] >> (c & 63)) & 1;
+}
+
+struct sw_regex_priv {
+	struct rte_regexdev *dev;
+	uint32_t max_dfa_states;
+	uint16_t nb_qps;
+	uint16_t nb_max_matches;
+	struct sw_regex_qp **qps;
+
+	uint32_t nb_rules;
+	uint32_t rules_sz;
+	struct sw_regex_rule_entry *rules;
+	struct sw_regex_db *db;
+};
+
+struct sw_regex_db *
+sw_regex_compile(const struct sw_regex_rule_entry *rules, uint32_t nb_rules,
+		uint32_t max_dfa_states);
+
+void
+sw_regex_db_free(struct sw_regex_db *db);
+
+int
+sw_regex_qp_scratch_alloc(struct sw_regex_qp *qp,
+		const struct sw_regex_db *db);
+
+void
+sw_regex_qp_scratch_free(struct sw_regex_qp *qp);
+
+void
+sw_regex_scan(const struct sw_regex_priv *priv, struct sw_regex_qp *qp,
+		struct rte_regex_ops *op);
+
+uint16_t
+sw_regex_enqueue(struct rte_regexdev *dev, uint16_t qp_id,
+		struct rte_regex_ops **ops, uint16_t nb_ops);
+
+uint16_t
+sw_regex_dequeue(struct rte_regexdev *dev, uint16_t qp_id,
+		struct rte_regex_ops **ops, uint16_t nb_ops);
+
+void
+sw_regex_rules_free(struct sw_regex_priv *priv);
+
+int
+sw_regex_rules_parse(struct sw_regex_priv *priv, const char *rule_db,
+		uint32_t rule_db_len);
+
+int
+sw_regex_rules_export(const struct sw_regex_priv *priv, char *rule_db);
+
+int
+sw_regex_selftest(struct rte_regexdev *dev);
+
+#endif /* _SW_REGEX_H_ */
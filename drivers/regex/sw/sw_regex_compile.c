@@ -0,0 +1,1294 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_malloc.h>
+
+#include "sw_regex.h"
+
+/*
+ * Rule compiler.
+ *
+ * Each rule is parsed in a syntax tree, then translated in a Thompson NFA.
+ * The NFA of all the rules are merged in a single unanchored DFA by subset
+ * construction, over the classes of bytes which are not distinguished by
+ * any rule. For literal rules, this DFA is the Aho-Corasick automaton of
+ * the literals.
+ *
+ * The DFA tells which rules match and where their matches end. The NFA of
+ * a matching rule is then simulated to find the start of its matches.
+ */
+
+#define SW_REGEX_MAX_DEPTH	256
+
+enum ast_type {
+	AST_EMPTY,
+	AST_CLASS,
+	AST_CAT,
+	AST_ALT,
+	AST_REPEAT,
+};
+
+struct ast_node {
+	uint8_t type;
+	uint32_t left;
+	uint32_t right;
+	uint32_t min;
+	uint32_t max;
+	uint64_t cls[4];
+};
+
+#define AST_INFINITE	UINT32_MAX
+#define AST_INVALID	UINT32_MAX
+
+struct parser {
+	const char *p;
+	const char *end;
+	uint32_t depth;
+	int caseless;
+	int dotall;
+	int anchored;
+	int start_anchored;
+	int end_anchored;
+	const char *err;
+	struct ast_node *nodes;
+	uint32_t nb_nodes;
+	uint32_t nodes_sz;
+};
+
+static inline void
+cls_set(uint64_t *cls, uint8_t c)
+{
+	cls[c >> 6] |= 1ULL << (c & 63);
+}
+
+static void
+cls_set_range(uint64_t *cls, uint8_t lo, uint8_t hi)
+{
+	unsigned int c;
+
+	for (c = lo; c <= hi; c++)
+		cls_set(cls, c);
+}
+
+static void
+cls_fold(uint64_t *cls)
+{
+	unsigned int c, u;
+
+	for (c = 'a'; c <= 'z'; c++) {
+		u = c - 'a' + 'A';
+		if (sw_regex_class_test(cls, c) ||
+				sw_regex_class_test(cls, u)) {
+			cls_set(cls, c);
+			cls_set(cls, u);
+		}
+	}
+}
+
+static uint32_t
+ast_new(struct parser *ps, uint8_t type)
+{
+	struct ast_node *nodes;
+	uint32_t sz;
+
+	if (ps->nb_nodes == ps->nodes_sz) {
+		sz = RTE_MAX(ps->nodes_sz * 2, 64U);
+		nodes = realloc(ps->nodes, sz * sizeof(*nodes));
+		if (nodes == NULL) {
+			ps->err = "out of memory";
+			return AST_INVALID;
+		}
+		ps->nodes = nodes;
+		ps->nodes_sz = sz;
+	}
+
+	memset(&ps->nodes[ps->nb_nodes], 0, sizeof(ps->nodes[0]));
+	ps->nodes[ps->nb_nodes].type = type;
+
+	return ps->nb_nodes++;
+}
+
+static uint32_t
+ast_new2(struct parser *ps, uint8_t type, uint32_t left, uint32_t right)
+{
+	uint32_t n = ast_new(ps, type);
+
+	if (n != AST_INVALID) {
+		ps->nodes[n].left = left;
+		ps->nodes[n].right = right;
+	}
+
+	return n;
+}
+
+static int
+hex_digit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+/*
+ * Parse an escape sequence after the backslash, either adding a class
+ * escape to cls and returning -1, or returning the escaped byte.
+ * Returns -2 on error.
+ */
+static int
+parse_escape(struct parser *ps, uint64_t *cls)
+{
+	uint64_t esc[4] = { 0 };
+	int negate = 0;
+	unsigned int i;
+	int h, v;
+	char c;
+
+	if (ps->p == ps->end) {
+		ps->err = "trailing backslash";
+		return -2;
+	}
+
+	c = *ps->p++;
+	switch (c) {
+	case 'n': return '\n';
+	case 'r': return '\r';
+	case 't': return '\t';
+	case 'f': return '\f';
+	case 'v': return '\v';
+	case 'a': return '\a';
+	case 'e': return 0x1b;
+	case '0': return 0;
+	case 'x':
+		if (ps->p < ps->end && *ps->p == '{') {
+			ps->p++;
+			v = 0;
+			for (i = 0; ps->p < ps->end && *ps->p != '}'; i++) {
+				h = hex_digit(*ps->p++);
+				if (h < 0 || i == 2) {
+					ps->err = "invalid hexadecimal escape";
+					return -2;
+				}
+				v = v * 16 + h;
+			}
+			if (ps->p == ps->end || i == 0) {
+				ps->err = "invalid hexadecimal escape";
+				return -2;
+			}
+			ps->p++;
+			return v;
+		}
+		v = 0;
+		for (i = 0; i < 2 && ps->p < ps->end &&
+				hex_digit(*ps->p) >= 0; i++)
+			v = v * 16 + hex_digit(*ps->p++);
+		return v;
+	case 'D':
+		negate = 1;
+		/* fallthrough */
+	case 'd':
+		cls_set_range(esc, '0', '9');
+		break;
+	case 'W':
+		negate = 1;
+		/* fallthrough */
+	case 'w':
+		cls_set_range(esc, '0', '9');
+		cls_set_range(esc, 'a', 'z');
+		cls_set_range(esc, 'A', 'Z');
+		cls_set(esc, '_');
+		break;
+	case 'S':
+		negate = 1;
+		/* fallthrough */
+	case 's':
+		cls_set(esc, ' ');
+		cls_set_range(esc, '\t', '\r');
+		break;
+	default:
+		if (isalnum((unsigned char)c)) {
+			ps->err = "unsupported escape sequence";
+			return -2;
+		}
+		return (unsigned char)c;
+	}
+
+	for (i = 0; i < RTE_DIM(esc); i++)
+		cls[i] |= negate ? ~esc[i] : esc[i];
+
+	return -1;
+}
+
+static uint32_t
+parse_class(struct parser *ps)
+{
+	uint64_t cls[4] = { 0 };
+	int negate = 0, first = 1;
+	int lo, hi;
+	uint32_t n;
+	unsigned int i;
+
+	if (ps->p < ps->end && *ps->p == '^') {
+		negate = 1;
+		ps->p++;
+	}
+
+	for (;;) {
+		if (ps->p == ps->end) {
+			ps->err = "missing terminating ] for character class";
+			return AST_INVALID;
+		}
+		if (*ps->p == ']' && !first) {
+			ps->p++;
+			break;
+		}
+		first = 0;
+
+		lo = (unsigned char)*ps->p++;
+		if (lo == '\\') {
+			lo = parse_escape(ps, cls);
+			if (lo == -2)
+				return AST_INVALID;
+			if (lo == -1)
+				continue;
+		}
+
+		if (ps->end - ps->p >= 2 && ps->p[0] == '-' && ps->p[1] != ']') {
+			ps->p++;
+			hi = (unsigned char)*ps->p++;
+			if (hi == '\\') {
+				hi = parse_escape(ps, cls);
+				if (hi == -2)
+					return AST_INVALID;
+				if (hi == -1) {
+					ps->err = "invalid range in character class";
+					return AST_INVALID;
+				}
+			}
+			if (hi < lo) {
+				ps->err = "range out of order in character class";
+				return AST_INVALID;
+			}
+			cls_set_range(cls, lo, hi);
+		} else {
+			cls_set(cls, lo);
+		}
+	}
+
+	if (ps->caseless)
+		cls_fold(cls);
+	if (negate)
+		for (i = 0; i < RTE_DIM(cls); i++)
+			cls[i] = ~cls[i];
+
+	n = ast_new(ps, AST_CLASS);
+	if (n != AST_INVALID)
+		memcpy(ps->nodes[n].cls, cls, sizeof(cls));
+
+	return n;
+}
+
+static uint32_t parse_alt(struct parser *ps);
+
+static uint32_t
+parse_atom(struct parser *ps)
+{
+	uint64_t cls[4] = { 0 };
+	uint32_t n;
+	int c;
+
+	c = (unsigned char)*ps->p++;
+	switch (c) {
+	case '(':
+		if (ps->end - ps->p >= 2 && ps->p[0] == '?') {
+			if (ps->p[1] != ':') {
+				ps->err = "unsupported group construct";
+				return AST_INVALID;
+			}
+			ps->p += 2;
+		}
+		if (++ps->depth > SW_REGEX_MAX_DEPTH) {
+			ps->err = "parentheses are too deeply nested";
+			return AST_INVALID;
+		}
+		n = parse_alt(ps);
+		ps->depth--;
+		if (n == AST_INVALID)
+			return n;
+		if (ps->p == ps->end || *ps->p != ')') {
+			ps->err = "missing closing parenthesis";
+			return AST_INVALID;
+		}
+		ps->p++;
+		return n;
+	case '[':
+		return parse_class(ps);
+	case '.':
+		memset(cls, 0xff, sizeof(cls));
+		if (!ps->dotall)
+			cls[0] &= ~(1ULL << '\n');
+		break;
+	case '$':
+		if (ps->p != ps->end || ps->depth != 0) {
+			ps->err = "$ is only supported at the end of a rule";
+			return AST_INVALID;
+		}
+		ps->end_anchored = 1;
+		return ast_new(ps, AST_EMPTY);
+	case '^':
+		ps->err = "^ is only supported at the start of a rule";
+		return AST_INVALID;
+	case '\\':
+		c = parse_escape(ps, cls);
+		if (c == -2)
+			return AST_INVALID;
+		if (c >= 0)
+			cls_set(cls, c);
+		break;
+	case '*':
+	case '+':
+	case '?':
+		ps->err = "quantifier does not follow a repeatable item";
+		return AST_INVALID;
+	default:
+		cls_set(cls, c);
+		break;
+	}
+
+	if (ps->caseless)
+		cls_fold(cls);
+
+	n = ast_new(ps, AST_CLASS);
+	if (n != AST_INVALID)
+		memcpy(ps->nodes[n].cls, cls, sizeof(cls));
+
+	return n;
+}
+
+static int
+parse_number(struct parser *ps, uint32_t *val)
+{
+	const char *start = ps->p;
+	uint32_t v = 0;
+
+	while (ps->p < ps->end && isdigit((unsigned char)*ps->p)) {
+		v = v * 10 + (*ps->p++ - '0');
+		if (v > SW_REGEX_MAX_REPEAT)
+			return -1;
+	}
+	*val = v;
+
+	return ps->p == start ? -1 : 0;
+}
+
+/* Parse a {n}, {n,} or {n,m} quantifier, or leave it as literal */
+static int
+parse_bounds(struct parser *ps, uint32_t *min, uint32_t *max)
+{
+	const char *save = ps->p;
+
+	ps->p++;
+	if (parse_number(ps, min) < 0)
+		goto literal;
+	*max = *min;
+	if (ps->p < ps->end && *ps->p == ',') {
+		ps->p++;
+		if (ps->p < ps->end && *ps->p == '}')
+			*max = AST_INFINITE;
+		else if (parse_number(ps, max) < 0)
+			goto literal;
+	}
+	if (ps->p == ps->end || *ps->p != '}')
+		goto literal;
+	ps->p++;
+
+	return 1;
+
+literal:
+	ps->p = save;
+	return 0;
+}
+
+static uint32_t
+parse_repeat(struct parser *ps)
+{
+	uint32_t n, r, min, max;
+	int c;
+
+	n = parse_atom(ps);
+	while (n != AST_INVALID && ps->p < ps->end) {
+		c = *ps->p;
+		if (c == '*') {
+			min = 0;
+			max = AST_INFINITE;
+			ps->p++;
+		} else if (c == '+') {
+			min = 1;
+			max = AST_INFINITE;
+			ps->p++;
+		} else if (c == '?') {
+			min = 0;
+			max = 1;
+			ps->p++;
+		} else if (c == '{' && parse_bounds(ps, &min, &max)) {
+			if (max < min) {
+				ps->err = "numbers out of order in {} quantifier";
+				return AST_INVALID;
+			}
+		} else {
+			break;
+		}
+
+		/* All the matches are reported, so lazy is the same as greedy */
+		if (ps->p < ps->end && *ps->p == '?')
+			ps->p++;
+		else if (ps->p < ps->end && *ps->p == '+') {
+			ps->err = "possessive quantifiers are not supported";
+			return AST_INVALID;
+		}
+
+		r = ast_new2(ps, AST_REPEAT, n, 0);
+		if (r == AST_INVALID)
+			return r;
+		ps->nodes[r].min = min;
+		ps->nodes[r].max = max;
+		n = r;
+	}
+
+	return n;
+}
+
+static uint32_t
+parse_cat(struct parser *ps)
+{
+	uint32_t n = AST_INVALID, r;
+
+	while (ps->p < ps->end && *ps->p != '|' && *ps->p != ')') {
+		r = parse_repeat(ps);
+		if (r == AST_INVALID)
+			return r;
+		n = n == AST_INVALID ? r : ast_new2(ps, AST_CAT, n, r);
+		if (n == AST_INVALID)
+			return n;
+	}
+
+	if (n == AST_INVALID)
+		n = ast_new(ps, AST_EMPTY);
+
+	return n;
+}
+
+static uint32_t
+parse_alt(struct parser *ps)
+{
+	uint32_t n, r;
+
+	n = parse_cat(ps);
+	while (n != AST_INVALID && ps->p < ps->end && *ps->p == '|') {
+		ps->p++;
+		r = parse_cat(ps);
+		if (r == AST_INVALID)
+			return r;
+		n = ast_new2(ps, AST_ALT, n, r);
+	}
+
+	return n;
+}
+
+/* Parse the leading inline options and start anchors of a rule */
+static int
+parse_prefix(struct parser *ps)
+{
+	const char *p;
+
+	for (;;) {
+		if (ps->p < ps->end && *ps->p == '^') {
+			ps->anchored = 1;
+			ps->start_anchored = 1;
+			ps->p++;
+			continue;
+		}
+		if (ps->end - ps->p < 3 || ps->p[0] != '(' ||
+				ps->p[1] != '?' ||
+				(ps->p[2] != 'i' && ps->p[2] != 's'))
+			break;
+		for (p = ps->p + 2; p < ps->end && *p != ')'; p++) {
+			if (*p == 'i')
+				ps->caseless = 1;
+			else if (*p == 's')
+				ps->dotall = 1;
+			else
+				break;
+		}
+		if (p == ps->end || *p != ')') {
+			ps->err = "unsupported inline option";
+			return -1;
+		}
+		ps->p = p + 1;
+	}
+
+	return 0;
+}
+
+static int
+ast_nullable(const struct parser *ps, uint32_t n)
+{
+	const struct ast_node *node = &ps->nodes[n];
+
+	switch (node->type) {
+	case AST_CLASS:
+		return 0;
+	case AST_CAT:
+		return ast_nullable(ps, node->right) &&
+			ast_nullable(ps, node->left);
+	case AST_ALT:
+		return ast_nullable(ps, node->left) ||
+			ast_nullable(ps, node->right);
+	case AST_REPEAT:
+		return node->min == 0 || ast_nullable(ps, node->left);
+	default:
+		return 1;
+	}
+}
+
+struct compiler {
+	struct sw_regex_nfa_state *nfa;
+	uint64_t (*classes)[4];
+	uint32_t nb_nfa;
+	uint32_t nfa_sz;
+	uint32_t nb_classes;
+	uint32_t classes_sz;
+	const char *err;
+};
+
+static uint32_t
+nfa_new(struct compiler *cc, uint8_t type, uint32_t out, uint32_t arg)
+{
+	struct sw_regex_nfa_state *nfa;
+	uint32_t sz;
+
+	if (cc->nb_nfa == SW_REGEX_MAX_NFA_STATES) {
+		cc->err = "too many NFA states";
+		return AST_INVALID;
+	}
+
+	if (cc->nb_nfa == cc->nfa_sz) {
+		sz = RTE_MAX(cc->nfa_sz * 2, 256U);
+		nfa = realloc(cc->nfa, sz * sizeof(*nfa));
+		if (nfa == NULL) {
+			cc->err = "out of memory";
+			return AST_INVALID;
+		}
+		cc->nfa = nfa;
+		cc->nfa_sz = sz;
+	}
+
+	cc->nfa[cc->nb_nfa].type = type;
+	cc->nfa[cc->nb_nfa].out = out;
+	cc->nfa[cc->nb_nfa].arg = arg;
+
+	return cc->nb_nfa++;
+}
+
+static uint32_t
+nfa_class(struct compiler *cc, const uint64_t *cls, uint32_t next)
+{
+	uint64_t (*classes)[4];
+	uint32_t sz;
+
+	if (cc->nb_classes == cc->classes_sz) {
+		sz = RTE_MAX(cc->classes_sz * 2, 256U);
+		classes = realloc(cc->classes, sz * sizeof(*classes));
+		if (classes == NULL) {
+			cc->err = "out of memory";
+			return AST_INVALID;
+		}
+		cc->classes = classes;
+		cc->classes_sz = sz;
+	}
+
+	memcpy(cc->classes[cc->nb_classes], cls, sizeof(cc->classes[0]));
+
+	return nfa_new(cc, SW_REGEX_NFA_CLASS, next, cc->nb_classes++);
+}
+
+/* Generate the NFA of a node continuing to next, return its entry state */
+static uint32_t
+nfa_gen(struct compiler *cc, const struct parser *ps, uint32_t n,
+		uint32_t next)
+{
+	const struct ast_node *node = &ps->nodes[n];
+	uint32_t s, e, i;
+
+	/* Concatenations are left deep, do not recurse on their length */
+	while (node->type == AST_CAT) {
+		next = nfa_gen(cc, ps, node->right, next);
+		if (next == AST_INVALID)
+			return next;
+		node = &ps->nodes[node->left];
+	}
+
+	switch (node->type) {
+	case AST_CLASS:
+		return nfa_class(cc, node->cls, next);
+	case AST_ALT:
+		s = nfa_gen(cc, ps, node->left, next);
+		if (s == AST_INVALID)
+			return s;
+		e = nfa_gen(cc, ps, node->right, next);
+		if (e == AST_INVALID)
+			return e;
+		return nfa_new(cc, SW_REGEX_NFA_SPLIT, s, e);
+	case AST_REPEAT:
+		if (node->max == AST_INFINITE) {
+			/* Loop on the item, then exit to next */
+			s = nfa_new(cc, SW_REGEX_NFA_SPLIT, AST_INVALID, next);
+			if (s == AST_INVALID)
+				return s;
+			e = nfa_gen(cc, ps, node->left, s);
+			if (e == AST_INVALID)
+				return e;
+			cc->nfa[s].out = e;
+			e = s;
+		} else {
+			/* Nested optional items: (x(x)?)? */
+			e = next;
+			for (i = node->min; i < node->max; i++) {
+				s = nfa_gen(cc, ps, node->left, e);
+				if (s == AST_INVALID)
+					return s;
+				e = nfa_new(cc, SW_REGEX_NFA_SPLIT, s, next);
+				if (e == AST_INVALID)
+					return e;
+			}
+		}
+		for (i = 0; i < node->min; i++) {
+			e = nfa_gen(cc, ps, node->left, e);
+			if (e == AST_INVALID)
+				return e;
+		}
+		return e;
+	default:
+		return next;
+	}
+}
+
+static int
+rule_compile(struct compiler *cc, const struct sw_regex_rule_entry *entry,
+		uint32_t rule_idx, struct sw_regex_rule *rule)
+{
+	struct parser ps = {
+		.p = entry->pattern,
+		.end = entry->pattern + strlen(entry->pattern),
+		.caseless = !!(entry->rule_flags &
+				RTE_REGEX_PCRE_RULE_CASELESS_F),
+		.dotall = !!(entry->rule_flags & RTE_REGEX_PCRE_RULE_DOTALL_F),
+		.anchored = !!(entry->rule_flags &
+				RTE_REGEX_PCRE_RULE_ANCHORED_F),
+	};
+	uint32_t root, match, start;
+	int ret = -EINVAL;
+
+	if (parse_prefix(&ps) < 0)
+		goto out;
+
+	root = parse_alt(&ps);
+	if (root == AST_INVALID)
+		goto out;
+	if (ps.p != ps.end) {
+		ps.err = "unmatched closing parenthesis";
+		goto out;
+	}
+	if ((ps.start_anchored || ps.end_anchored) &&
+			ps.nodes[root].type == AST_ALT) {
+		ps.err = "anchors are not supported in alternatives";
+		goto out;
+	}
+	if (ast_nullable(&ps, root)) {
+		ps.err = "rule matches the empty string";
+		goto out;
+	}
+
+	rule->rule_id = entry->rule_id;
+	rule->group_id = entry->group_id;
+	rule->anchored = ps.anchored;
+	rule->end_anchored = ps.end_anchored;
+	rule->nfa_first = cc->nb_nfa;
+
+	match = nfa_new(cc, SW_REGEX_NFA_MATCH, 0, rule_idx);
+	if (match == AST_INVALID)
+		goto nfa_err;
+	start = nfa_gen(cc, &ps, root, match);
+	if (start == AST_INVALID)
+		goto nfa_err;
+	/* Entry of the rule at its first state */
+	if (nfa_new(cc, SW_REGEX_NFA_EMPTY, start, 0) == AST_INVALID)
+		goto nfa_err;
+	rule->nfa_nb = cc->nb_nfa - rule->nfa_first;
+
+	ret = 0;
+	goto out;
+
+nfa_err:
+	ps.err = cc->err;
+	ret = -ENOSPC;
+out:
+	if (ret < 0)
+		SW_REGEX_LOG(ERR, "Rule %u: %s at offset %u of \"%s\"",
+			entry->rule_id, ps.err,
+			(unsigned int)(ps.p - entry->pattern), entry->pattern);
+	free(ps.nodes);
+
+	return ret;
+}
+
+/* The entry of a rule is its last NFA state, see rule_compile() */
+static inline uint32_t
+rule_entry(const struct sw_regex_rule *rule)
+{
+	return rule->nfa_first + rule->nfa_nb - 1;
+}
+
+struct dfa_builder {
+	const struct sw_regex_db *db;
+	uint32_t max_states;
+
+	/* NFA state sets of the DFA states */
+	uint32_t *sets;
+	uint32_t sets_nb;
+	uint32_t sets_sz;
+	uint32_t *set_off;
+	uint32_t *set_len;
+
+	uint32_t *trans;
+	uint32_t states_sz;
+
+	/* Hash table of the NFA state sets */
+	uint32_t *hash;
+	uint32_t hash_mask;
+
+	/* Closure computation */
+	uint32_t *mark;
+	uint32_t mark_gen;
+	uint32_t *stack;
+	uint32_t *cur;
+	uint32_t cur_nb;
+	uint32_t *extra;
+	uint32_t *visit;
+	uint32_t visit_nb;
+	uint32_t *seeds;
+
+	/*
+	 * The closure of the unanchored rule entries is part of every DFA
+	 * state, so it is left out of the sets. Its successors on each byte
+	 * class are computed once, as sorted consuming and match states.
+	 */
+	uint8_t *idle;
+	uint32_t *idle_next;
+	uint32_t *idle_next_off;
+};
+
+static int
+cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+#define DFA_CLASS_NONE	UINT32_MAX
+
+/*
+ * Compute in cur the sorted consuming and match states reached from seeds
+ * and from the idle states on byte class cls, out of the idle states.
+ */
+static void
+dfa_closure(struct dfa_builder *b, const uint32_t *seeds, uint32_t nb_seeds,
+		uint32_t cls)
+{
+	const struct sw_regex_nfa_state *nfa = b->db->nfa;
+	uint32_t sp = 0, nb_extra = 0, s, i, j, end;
+
+	b->visit_nb = 0;
+	b->mark_gen++;
+
+	for (i = 0; i < nb_seeds; i++)
+		b->stack[sp++] = seeds[i];
+
+	while (sp != 0) {
+		s = b->stack[--sp];
+		if (b->mark[s] == b->mark_gen || b->idle[s])
+			continue;
+		b->mark[s] = b->mark_gen;
+		b->visit[b->visit_nb++] = s;
+		switch (nfa[s].type) {
+		case SW_REGEX_NFA_SPLIT:
+			b->stack[sp++] = nfa[s].arg;
+			/* fallthrough */
+		case SW_REGEX_NFA_EMPTY:
+			b->stack[sp++] = nfa[s].out;
+			break;
+		default:
+			b->extra[nb_extra++] = s;
+			break;
+		}
+	}
+
+	qsort(b->extra, nb_extra, sizeof(uint32_t), cmp_u32);
+
+	/* Merge with the idle successors, which may have been reached too */
+	i = 0;
+	j = 0;
+	end = 0;
+	if (cls != DFA_CLASS_NONE) {
+		i = b->idle_next_off[cls];
+		end = b->idle_next_off[cls + 1];
+	}
+	b->cur_nb = 0;
+	while (i < end || j < nb_extra) {
+		if (j == nb_extra || (i < end && b->idle_next[i] < b->extra[j]))
+			s = b->idle_next[i++];
+		else if (i == end || b->extra[j] < b->idle_next[i])
+			s = b->extra[j++];
+		else {
+			s = b->extra[j++];
+			i++;
+		}
+		b->cur[b->cur_nb++] = s;
+	}
+}
+
+/* Compute the idle states and their successors on each byte class */
+static int
+dfa_idle_init(struct dfa_builder *b, const uint8_t *rep)
+{
+	const struct sw_regex_db *db = b->db;
+	uint32_t *idle_cur, nb_idle_cur, nb_seeds, sz = 0, i, k, s;
+	void *p;
+
+	b->idle = calloc(db->nb_nfa, sizeof(uint8_t));
+	b->idle_next_off = malloc((db->nb_cls + 1) * sizeof(uint32_t));
+	idle_cur = malloc(db->nb_nfa * sizeof(uint32_t));
+	if (b->idle == NULL || b->idle_next_off == NULL || idle_cur == NULL)
+		goto nomem;
+
+	nb_seeds = 0;
+	for (i = 0; i < db->nb_rules; i++)
+		if (!db->rules[i].anchored)
+			b->seeds[nb_seeds++] = rule_entry(&db->rules[i]);
+	dfa_closure(b, b->seeds, nb_seeds, DFA_CLASS_NONE);
+	memcpy(idle_cur, b->cur, b->cur_nb * sizeof(uint32_t));
+	nb_idle_cur = b->cur_nb;
+	for (i = 0; i < b->visit_nb; i++)
+		b->idle[b->visit[i]] = 1;
+
+	b->idle_next_off[0] = 0;
+	for (k = 0; k < db->nb_cls; k++) {
+		nb_seeds = 0;
+		for (i = 0; i < nb_idle_cur; i++) {
+			s = idle_cur[i];
+			if (db->nfa[s].type == SW_REGEX_NFA_CLASS &&
+					sw_regex_class_test(db->classes[db->nfa[s].arg],
+						rep[k]))
+				b->seeds[nb_seeds++] = db->nfa[s].out;
+		}
+		dfa_closure(b, b->seeds, nb_seeds, DFA_CLASS_NONE);
+
+		if (b->idle_next_off[k] + b->cur_nb > sz) {
+			sz = RTE_MAX(sz * 2, b->idle_next_off[k] + b->cur_nb);
+			p = realloc(b->idle_next, sz * sizeof(uint32_t));
+			if (p == NULL)
+				goto nomem;
+			b->idle_next = p;
+		}
+		memcpy(&b->idle_next[b->idle_next_off[k]], b->cur,
+			b->cur_nb * sizeof(uint32_t));
+		b->idle_next_off[k + 1] = b->idle_next_off[k] + b->cur_nb;
+	}
+
+	free(idle_cur);
+	return 0;
+
+nomem:
+	free(idle_cur);
+	return -ENOMEM;
+}
+
+static uint32_t
+set_hash(const uint32_t *set, uint32_t nb)
+{
+	uint32_t h = 2166136261U, i;
+
+	for (i = 0; i < nb; i++)
+		h = (h ^ set[i]) * 16777619U;
+
+	return h;
+}
+
+static int
+dfa_hash_resize(struct dfa_builder *b, uint32_t sz)
+{
+	uint32_t *hash, i, h;
+
+	hash = malloc(sz * sizeof(uint32_t));
+	if (hash == NULL)
+		return -ENOMEM;
+	memset(hash, 0xff, sz * sizeof(uint32_t));
+
+	for (i = 0; i < b->db->nb_dfa; i++) {
+		h = set_hash(&b->sets[b->set_off[i]], b->set_len[i]) &
+				(sz - 1);
+		while (hash[h] != UINT32_MAX)
+			h = (h + 1) & (sz - 1);
+		hash[h] = i;
+	}
+
+	free(b->hash);
+	b->hash = hash;
+	b->hash_mask = sz - 1;
+
+	return 0;
+}
+
+/* Find or add the DFA state of the NFA state set in cur */
+static int
+dfa_state_get(struct dfa_builder *b, struct sw_regex_db *db, uint32_t *state)
+{
+	uint32_t h, i, sz;
+	void *p;
+
+	h = set_hash(b->cur, b->cur_nb) & b->hash_mask;
+	while ((i = b->hash[h]) != UINT32_MAX) {
+		if (b->set_len[i] == b->cur_nb &&
+				memcmp(&b->sets[b->set_off[i]], b->cur,
+					b->cur_nb * sizeof(uint32_t)) == 0) {
+			*state = i;
+			return 0;
+		}
+		h = (h + 1) & b->hash_mask;
+	}
+
+	if (db->nb_dfa == b->max_states) {
+		SW_REGEX_LOG(ERR, "DFA exceeds %u states, consider raising %s",
+			b->max_states, SW_REGEX_ARG_MAX_DFA_STATES);
+		return -ENOSPC;
+	}
+
+	if (db->nb_dfa == b->states_sz) {
+		sz = RTE_MAX(b->states_sz * 2, 256U);
+		p = realloc(b->set_off, sz * sizeof(uint32_t));
+		if (p == NULL)
+			return -ENOMEM;
+		b->set_off = p;
+		p = realloc(b->set_len, sz * sizeof(uint32_t));
+		if (p == NULL)
+			return -ENOMEM;
+		b->set_len = p;
+		p = realloc(b->trans, (size_t)sz * db->nb_cls *
+				sizeof(uint32_t));
+		if (p == NULL)
+			return -ENOMEM;
+		b->trans = p;
+		b->states_sz = sz;
+	}
+
+	if (b->sets_nb + b->cur_nb > b->sets_sz) {
+		sz = RTE_MAX(b->sets_sz * 2, b->sets_nb + b->cur_nb);
+		p = realloc(b->sets, sz * sizeof(uint32_t));
+		if (p == NULL)
+			return -ENOMEM;
+		b->sets = p;
+		b->sets_sz = sz;
+	}
+
+	i = db->nb_dfa++;
+	b->set_off[i] = b->sets_nb;
+	b->set_len[i] = b->cur_nb;
+	memcpy(&b->sets[b->sets_nb], b->cur, b->cur_nb * sizeof(uint32_t));
+	b->sets_nb += b->cur_nb;
+
+	if (db->nb_dfa * 2 > b->hash_mask + 1) {
+		if (dfa_hash_resize(b, (b->hash_mask + 1) * 2) < 0)
+			return -ENOMEM;
+	} else {
+		while (b->hash[h] != UINT32_MAX)
+			h = (h + 1) & b->hash_mask;
+		b->hash[h] = i;
+	}
+
+	*state = i;
+
+	return 0;
+}
+
+/* Split the bytes in the classes not distinguished by any NFA class */
+static void
+dfa_byte_classes(struct sw_regex_db *db)
+{
+	const uint64_t *cls;
+	uint16_t newid[512];
+	uint8_t cmap[256];
+	uint32_t i, nb, key;
+	unsigned int c;
+
+	memset(db->cmap, 0, sizeof(db->cmap));
+	db->nb_cls = 1;
+
+	for (i = 0; i < db->nb_nfa; i++) {
+		if (db->nfa[i].type != SW_REGEX_NFA_CLASS)
+			continue;
+		cls = db->classes[db->nfa[i].arg];
+		memset(newid, 0xff, sizeof(newid));
+		nb = 0;
+		for (c = 0; c < 256; c++) {
+			key = db->cmap[c] * 2 + sw_regex_class_test(cls, c);
+			if (newid[key] == UINT16_MAX)
+				newid[key] = nb++;
+			cmap[c] = newid[key];
+		}
+		memcpy(db->cmap, cmap, sizeof(cmap));
+		db->nb_cls = nb;
+		if (nb == 256)
+			break;
+	}
+}
+
+static int
+dfa_build(struct sw_regex_db *db, uint32_t max_states)
+{
+	struct dfa_builder b = {
+		.db = db,
+		.max_states = max_states,
+	};
+	uint8_t rep[256];
+	uint32_t i, k, j, nb_seeds, s, next, nb_accept;
+	uint32_t *accept_idx = NULL, *accept_rules = NULL, *trans = NULL;
+	const uint32_t *set;
+	unsigned int c;
+	int ret = -ENOMEM;
+
+	dfa_byte_classes(db);
+	for (c = 256; c-- > 0; )
+		rep[db->cmap[c]] = c;
+
+	b.mark = calloc(db->nb_nfa, sizeof(uint32_t));
+	b.stack = malloc(db->nb_nfa * 3 * sizeof(uint32_t));
+	b.cur = malloc(db->nb_nfa * sizeof(uint32_t));
+	b.extra = malloc(db->nb_nfa * sizeof(uint32_t));
+	b.visit = malloc(db->nb_nfa * sizeof(uint32_t));
+	b.seeds = malloc(db->nb_nfa * sizeof(uint32_t));
+	if (b.mark == NULL || b.stack == NULL || b.cur == NULL ||
+			b.extra == NULL || b.visit == NULL || b.seeds == NULL)
+		goto out;
+	if (dfa_hash_resize(&b, 1024) < 0 || dfa_idle_init(&b, rep) < 0)
+		goto out;
+
+	/* Initial state with the anchored rules, then idle state */
+	nb_seeds = 0;
+	for (i = 0; i < db->nb_rules; i++)
+		if (db->rules[i].anchored)
+			b.seeds[nb_seeds++] = rule_entry(&db->rules[i]);
+	dfa_closure(&b, b.seeds, nb_seeds, DFA_CLASS_NONE);
+	ret = dfa_state_get(&b, db, &db->start);
+	if (ret < 0)
+		goto out;
+	b.cur_nb = 0;
+	ret = dfa_state_get(&b, db, &db->idle);
+	if (ret < 0)
+		goto out;
+
+	for (i = 0; i < db->nb_dfa; i++) {
+		for (k = 0; k < db->nb_cls; k++) {
+			nb_seeds = 0;
+			set = &b.sets[b.set_off[i]];
+			for (j = 0; j < b.set_len[i]; j++) {
+				s = set[j];
+				if (db->nfa[s].type != SW_REGEX_NFA_CLASS)
+					continue;
+				if (sw_regex_class_test(db->classes[db->nfa[s].arg],
+						rep[k]))
+					b.seeds[nb_seeds++] = db->nfa[s].out;
+			}
+			dfa_closure(&b, b.seeds, nb_seeds, k);
+			ret = dfa_state_get(&b, db, &next);
+			if (ret < 0)
+				goto out;
+			b.trans[i * db->nb_cls + k] = next;
+		}
+	}
+
+	/* Rules accepted in each state */
+	ret = -ENOMEM;
+	accept_idx = rte_malloc(NULL, (db->nb_dfa + 1) * sizeof(uint32_t), 0);
+	if (accept_idx == NULL)
+		goto out;
+	nb_accept = 0;
+	for (i = 0; i < db->nb_dfa; i++) {
+		accept_idx[i] = nb_accept;
+		for (j = 0; j < b.set_len[i]; j++)
+			if (db->nfa[b.sets[b.set_off[i] + j]].type ==
+					SW_REGEX_NFA_MATCH)
+				nb_accept++;
+	}
+	accept_idx[db->nb_dfa] = nb_accept;
+	accept_rules = rte_malloc(NULL,
+			RTE_MAX(nb_accept, 1U) * sizeof(uint32_t), 0);
+	if (accept_rules == NULL)
+		goto out;
+	nb_accept = 0;
+	for (i = 0; i < db->nb_dfa; i++) {
+		set = &b.sets[b.set_off[i]];
+		for (j = 0; j < b.set_len[i]; j++)
+			if (db->nfa[set[j]].type == SW_REGEX_NFA_MATCH)
+				accept_rules[nb_accept++] = db->nfa[set[j]].arg;
+	}
+
+	/* Pre-multiplied transitions, flagged when reaching a match */
+	trans = rte_malloc(NULL, (size_t)db->nb_dfa * db->nb_cls *
+			sizeof(uint32_t), RTE_CACHE_LINE_SIZE);
+	if (trans == NULL)
+		goto out;
+	for (i = 0; i < db->nb_dfa * db->nb_cls; i++) {
+		next = b.trans[i];
+		trans[i] = next * db->nb_cls;
+		if (accept_idx[next] != accept_idx[next + 1])
+			trans[i] |= SW_REGEX_DFA_ACCEPT;
+	}
+
+	/* Bytes leaving the idle state, to skip to them */
+	db->nb_escape = 0;
+	for (c = 0; c < 256; c++) {
+		if (trans[db->idle * db->nb_cls + db->cmap[c]] ==
+				db->idle * db->nb_cls)
+			continue;
+		if (db->nb_escape == SW_REGEX_MAX_ESCAPE) {
+			db->nb_escape = 0;
+			break;
+		}
+		db->escape[db->nb_escape++] = c;
+	}
+	/* Unused escape bytes repeat the first one for the vector compare */
+	for (i = db->nb_escape; i < SW_REGEX_MAX_ESCAPE; i++)
+		db->escape[i] = db->escape[0];
+
+	db->trans = trans;
+	db->accept_idx = accept_idx;
+	db->accept_rules = accept_rules;
+	db->start *= db->nb_cls;
+	db->idle *= db->nb_cls;
+	trans = NULL;
+	accept_idx = NULL;
+	accept_rules = NULL;
+	ret = 0;
+
+out:
+	rte_free(trans);
+	rte_free(accept_idx);
+	rte_free(accept_rules);
+	free(b.mark);
+	free(b.stack);
+	free(b.cur);
+	free(b.extra);
+	free(b.visit);
+	free(b.seeds);
+	free(b.idle);
+	free(b.idle_next);
+	free(b.idle_next_off);
+	free(b.hash);
+	free(b.sets);
+	free(b.set_off);
+	free(b.set_len);
+	free(b.trans);
+
+	return ret;
+}
+
+void
+sw_regex_db_free(struct sw_regex_db *db)
+{
+	if (db == NULL)
+		return;
+
+	rte_free(db->rules);
+	rte_free(db->nfa);
+	rte_free(db->classes);
+	rte_free(db->trans);
+	rte_free(db->accept_idx);
+	rte_free(db->accept_rules);
+	rte_free(db);
+}
+
+struct sw_regex_db *
+sw_regex_compile(const struct sw_regex_rule_entry *rules, uint32_t nb_rules,
+		uint32_t max_dfa_states)
+{
+	struct compiler cc = { 0 };
+	struct sw_regex_db *db;
+	uint32_t i;
+	int ret = -ENOMEM;
+
+	db = rte_zmalloc(NULL, sizeof(*db), RTE_CACHE_LINE_SIZE);
+	if (db == NULL)
+		goto err;
+
+	db->rules = rte_zmalloc(NULL,
+			RTE_MAX(nb_rules, 1U) * sizeof(*db->rules), 0);
+	if (db->rules == NULL)
+		goto err;
+
+	for (i = 0; i < nb_rules; i++) {
+		ret = rule_compile(&cc, &rules[i], i, &db->rules[i]);
+		if (ret < 0)
+			goto err;
+		db->max_rule_nfa = RTE_MAX(db->max_rule_nfa,
+				db->rules[i].nfa_nb);
+	}
+	db->nb_rules = nb_rules;
+
+	ret = -ENOMEM;
+	db->nb_nfa = cc.nb_nfa;
+	db->nfa = rte_malloc(NULL,
+			RTE_MAX(cc.nb_nfa, 1U) * sizeof(*db->nfa), 0);
+	db->classes = rte_malloc(NULL,
+			RTE_MAX(cc.nb_classes, 1U) * sizeof(*db->classes), 0);
+	if (db->nfa == NULL || db->classes == NULL)
+		goto err;
+	if (cc.nb_nfa != 0)
+		memcpy(db->nfa, cc.nfa, cc.nb_nfa * sizeof(*db->nfa));
+	if (cc.nb_classes != 0)
+		memcpy(db->classes, cc.classes,
+			cc.nb_classes * sizeof(*db->classes));
+
+	ret = dfa_build(db, max_dfa_states);
+	if (ret < 0)
+		goto err;
+
+	SW_REGEX_LOG(DEBUG, "Compiled %u rules: %u NFA states, "
+		"%u DFA states, %u byte classes, %u idle escape bytes",
+		db->nb_rules, db->nb_nfa, db->nb_dfa, db->nb_cls,
+		db->nb_escape);
+
+	free(cc.nfa);
+	free(cc.classes);
+
+	return db;
+
+err:
+	free(cc.nfa);
+	free(cc.classes);
+	sw_regex_db_free(db);
+	rte_errno = -ret;
+
+	return NULL;
+}
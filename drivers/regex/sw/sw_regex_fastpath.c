@@ -0,0 +1,450 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <string.h>
+
+#include <rte_branch_prediction.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_vect.h>
+
+#include "sw_regex.h"
+
+/* State of the scan of an operation */
+struct scan_state {
+	const struct sw_regex_db *db;
+	struct sw_regex_qp *qp;
+	struct rte_regex_ops *op;
+	uint32_t len;
+	uint32_t gen;
+	uint16_t max_matches;
+	uint8_t stop_on_match;
+	uint8_t high_priority;
+	uint8_t nb_groups;
+	uint16_t groups[4];
+
+	/* Rules matched by the DFA */
+	uint32_t nb_matched;
+	uint32_t stop_rule;
+	uint32_t stop_end;
+
+	/* Best match for a high priority request */
+	const struct sw_regex_rule *best;
+	uint32_t best_start;
+	uint32_t best_end;
+};
+
+void
+sw_regex_qp_scratch_free(struct sw_regex_qp *qp)
+{
+	rte_free(qp->rule_gen);
+	rte_free(qp->rule_end);
+	rte_free(qp->matched);
+	rte_free(qp->nfa_gen);
+	rte_free(qp->clist);
+	rte_free(qp->nlist);
+	rte_free(qp->stack);
+	qp->rule_gen = NULL;
+	qp->rule_end = NULL;
+	qp->matched = NULL;
+	qp->nfa_gen = NULL;
+	qp->clist = NULL;
+	qp->nlist = NULL;
+	qp->stack = NULL;
+	qp->nb_rules_max = 0;
+	qp->nfa_max = 0;
+}
+
+int
+sw_regex_qp_scratch_alloc(struct sw_regex_qp *qp, const struct sw_regex_db *db)
+{
+	uint32_t nb_rules = RTE_MAX(db->nb_rules, 1U);
+	uint32_t nfa_max = RTE_MAX(db->max_rule_nfa, 1U);
+
+	if (qp->nb_rules_max >= nb_rules && qp->nfa_max >= nfa_max)
+		return 0;
+
+	sw_regex_qp_scratch_free(qp);
+
+	qp->rule_gen = rte_zmalloc(NULL, nb_rules * sizeof(uint32_t), 0);
+	qp->rule_end = rte_malloc(NULL, nb_rules * sizeof(uint32_t), 0);
+	qp->matched = rte_malloc(NULL, nb_rules * sizeof(uint32_t), 0);
+	/* Lists of (state, match start) threads */
+	qp->nfa_gen = rte_zmalloc(NULL, nfa_max * sizeof(uint32_t), 0);
+	qp->clist = rte_malloc(NULL, nfa_max * 2 * sizeof(uint32_t), 0);
+	qp->nlist = rte_malloc(NULL, nfa_max * 2 * sizeof(uint32_t), 0);
+	qp->stack = rte_malloc(NULL, (nfa_max * 2 + 1) * sizeof(uint32_t), 0);
+	if (qp->rule_gen == NULL || qp->rule_end == NULL ||
+			qp->matched == NULL || qp->nfa_gen == NULL ||
+			qp->clist == NULL || qp->nlist == NULL ||
+			qp->stack == NULL) {
+		sw_regex_qp_scratch_free(qp);
+		return -ENOMEM;
+	}
+
+	qp->nb_rules_max = nb_rules;
+	qp->nfa_max = nfa_max;
+	qp->scan_gen = 0;
+
+	return 0;
+}
+
+static inline uint32_t
+qp_gen_next(struct sw_regex_qp *qp)
+{
+	if (unlikely(++qp->scan_gen == 0)) {
+		memset(qp->rule_gen, 0, qp->nb_rules_max * sizeof(uint32_t));
+		memset(qp->nfa_gen, 0, qp->nfa_max * sizeof(uint32_t));
+		qp->scan_gen = 1;
+	}
+
+	return qp->scan_gen;
+}
+
+/* Return the offset of the next byte leaving the idle state, or len */
+static inline uint32_t
+scan_skip(const struct sw_regex_db *db, const uint8_t *data, uint32_t i,
+		uint32_t len)
+{
+	const uint8_t *p;
+
+#ifdef RTE_ARCH_X86
+	if (len - i >= 16) {
+		const __m128i e0 = _mm_set1_epi8(db->escape[0]);
+		const __m128i e1 = _mm_set1_epi8(db->escape[1]);
+		const __m128i e2 = _mm_set1_epi8(db->escape[2]);
+		const __m128i e3 = _mm_set1_epi8(db->escape[3]);
+		__m128i v, m;
+		int mask;
+
+		for (; i + 16 <= len; i += 16) {
+			v = _mm_loadu_si128((const __m128i *)(data + i));
+			m = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(v, e0),
+					_mm_cmpeq_epi8(v, e1)),
+				_mm_or_si128(_mm_cmpeq_epi8(v, e2),
+					_mm_cmpeq_epi8(v, e3)));
+			mask = _mm_movemask_epi8(m);
+			if (mask != 0)
+				return i + rte_ctz32(mask);
+		}
+	}
+#endif
+
+	if (db->nb_escape == 1) {
+		p = memchr(data + i, db->escape[0], len - i);
+		return p != NULL ? (uint32_t)(p - data) : len;
+	}
+
+	for (; i < len; i++)
+		if (data[i] == db->escape[0] || data[i] == db->escape[1] ||
+				data[i] == db->escape[2] ||
+				data[i] == db->escape[3])
+			break;
+
+	return i;
+}
+
+static inline int
+scan_group_valid(const struct scan_state *scan,
+		const struct sw_regex_rule *rule)
+{
+	uint8_t i;
+
+	if (scan->nb_groups == 0)
+		return 1;
+
+	for (i = 0; i < scan->nb_groups; i++)
+		if (scan->groups[i] == rule->group_id)
+			return 1;
+
+	return 0;
+}
+
+/* Record the rules accepted by a DFA state at the end of a match */
+static int
+scan_accept(struct scan_state *scan, uint32_t state, uint32_t end)
+{
+	const struct sw_regex_db *db = scan->db;
+	struct sw_regex_qp *qp = scan->qp;
+	const struct sw_regex_rule *rule;
+	uint32_t i, r;
+
+	state /= db->nb_cls;
+	for (i = db->accept_idx[state]; i < db->accept_idx[state + 1]; i++) {
+		r = db->accept_rules[i];
+		rule = &db->rules[r];
+		if (!scan_group_valid(scan, rule))
+			continue;
+		if (rule->end_anchored && end != scan->len)
+			continue;
+		if (scan->stop_on_match) {
+			scan->stop_rule = r;
+			scan->stop_end = end;
+			return 1;
+		}
+		if (qp->rule_gen[r] != scan->gen) {
+			qp->rule_gen[r] = scan->gen;
+			qp->matched[scan->nb_matched++] = r;
+		}
+		qp->rule_end[r] = end;
+	}
+
+	return 0;
+}
+
+/* Run the DFA, return 1 when stopping on the first match */
+static int
+scan_dfa(struct scan_state *scan)
+{
+	const struct sw_regex_db *db = scan->db;
+	const uint32_t *trans = db->trans;
+	const struct rte_mbuf *m;
+	const uint8_t *data;
+	uint32_t state, t, pos, n, i;
+
+	state = db->start;
+	for (m = scan->op->mbuf, pos = 0; m != NULL && pos < scan->len;
+			m = m->next, pos += n) {
+		data = rte_pktmbuf_mtod(m, const uint8_t *);
+		n = RTE_MIN((uint32_t)m->data_len, scan->len - pos);
+		i = 0;
+		while (i < n) {
+			if (state == db->idle && db->nb_escape != 0) {
+				i = scan_skip(db, data, i, n);
+				if (i == n)
+					break;
+			}
+			t = trans[state + db->cmap[data[i++]]];
+			state = t & ~SW_REGEX_DFA_ACCEPT;
+			if (unlikely(t & SW_REGEX_DFA_ACCEPT) &&
+					scan_accept(scan, state, pos + i))
+				return 1;
+		}
+	}
+
+	return 0;
+}
+
+static void
+scan_match_add(struct scan_state *scan, const struct sw_regex_rule *rule,
+		uint32_t start, uint32_t end)
+{
+	struct rte_regex_ops *op = scan->op;
+	struct rte_regexdev_match *match;
+
+	if (rule->end_anchored && end != scan->len)
+		return;
+
+	if (op->nb_actual_matches != UINT16_MAX)
+		op->nb_actual_matches++;
+
+	if (scan->high_priority) {
+		if (scan->best != NULL &&
+				(scan->best->rule_id < rule->rule_id ||
+				 (scan->best->rule_id == rule->rule_id &&
+				  (scan->best_start < start ||
+				   (scan->best_start == start &&
+				    scan->best_end <= end)))))
+			return;
+		scan->best = rule;
+		scan->best_start = start;
+		scan->best_end = end;
+		return;
+	}
+
+	if (op->nb_matches == scan->max_matches) {
+		op->rsp_flags |= RTE_REGEX_OPS_RSP_MAX_MATCH_F;
+		return;
+	}
+
+	match = &op->matches[op->nb_matches++];
+	match->u64 = 0;
+	match->rule_id = rule->rule_id;
+	match->group_id = rule->group_id;
+	match->start_offset = start;
+	match->len = end - start;
+}
+
+/* Add a thread of the NFA of a rule and follow its epsilon transitions */
+static void
+pike_add(struct scan_state *scan, const struct sw_regex_rule *rule,
+		uint32_t *list, uint32_t *nb, uint32_t s, uint32_t start,
+		uint32_t pos, uint32_t gen)
+{
+	const struct sw_regex_nfa_state *nfa = scan->db->nfa;
+	struct sw_regex_qp *qp = scan->qp;
+	uint32_t sp = 0, local;
+
+	qp->stack[sp++] = s;
+	while (sp != 0) {
+		s = qp->stack[--sp];
+		local = s - rule->nfa_first;
+		if (qp->nfa_gen[local] == gen)
+			continue;
+		qp->nfa_gen[local] = gen;
+		switch (nfa[s].type) {
+		case SW_REGEX_NFA_SPLIT:
+			qp->stack[sp++] = nfa[s].arg;
+			/* fallthrough */
+		case SW_REGEX_NFA_EMPTY:
+			qp->stack[sp++] = nfa[s].out;
+			break;
+		case SW_REGEX_NFA_CLASS:
+			list[*nb * 2] = s;
+			list[*nb * 2 + 1] = start;
+			(*nb)++;
+			break;
+		default:
+			scan_match_add(scan, rule, start, pos);
+			break;
+		}
+	}
+}
+
+/*
+ * Simulate the NFA of a rule up to its last match end, to find the start
+ * of its matches. The threads are kept in order of match start, so that the
+ * first thread reaching a state has the leftmost start.
+ */
+static void
+pike_run(struct scan_state *scan, uint32_t r, uint32_t limit)
+{
+	const struct sw_regex_db *db = scan->db;
+	const struct sw_regex_rule *rule = &db->rules[r];
+	const uint32_t entry = rule->nfa_first + rule->nfa_nb - 1;
+	struct sw_regex_qp *qp = scan->qp;
+	uint32_t *clist = qp->clist, *nlist = qp->nlist, *tmp;
+	uint32_t nc = 0, nn, pos, n, i, j, s, gen;
+	const struct rte_mbuf *m;
+	const uint8_t *data;
+
+	gen = qp_gen_next(qp);
+	pike_add(scan, rule, clist, &nc, entry, 0, 0, gen);
+
+	for (m = scan->op->mbuf, pos = 0; m != NULL && pos < limit;
+			m = m->next, pos += n) {
+		data = rte_pktmbuf_mtod(m, const uint8_t *);
+		n = RTE_MIN((uint32_t)m->data_len, limit - pos);
+		for (i = 0; i < n; i++) {
+			gen = qp_gen_next(qp);
+			nn = 0;
+			for (j = 0; j < nc; j++) {
+				s = clist[j * 2];
+				if (sw_regex_class_test(db->classes[db->nfa[s].arg],
+						data[i]))
+					pike_add(scan, rule, nlist, &nn,
+						db->nfa[s].out, clist[j * 2 + 1],
+						pos + i + 1, gen);
+			}
+			if (!rule->anchored)
+				pike_add(scan, rule, nlist, &nn, entry,
+					pos + i + 1, pos + i + 1, gen);
+			else if (nn == 0)
+				return;
+			tmp = clist;
+			clist = nlist;
+			nlist = tmp;
+			nc = nn;
+		}
+	}
+}
+
+void
+sw_regex_scan(const struct sw_regex_priv *priv, struct sw_regex_qp *qp,
+		struct rte_regex_ops *op)
+{
+	const struct sw_regex_db *db = priv->db;
+	struct scan_state scan = {
+		.db = db,
+		.qp = qp,
+		.op = op,
+		.max_matches = priv->nb_max_matches,
+		.stop_on_match = !!(op->req_flags &
+				RTE_REGEX_OPS_REQ_STOP_ON_MATCH_F),
+		.high_priority = !!(op->req_flags &
+				RTE_REGEX_OPS_REQ_MATCH_HIGH_PRIORITY_F),
+	};
+	struct rte_regexdev_match *match;
+	uint32_t i, r;
+
+	op->rsp_flags = 0;
+	op->nb_actual_matches = 0;
+	op->nb_matches = 0;
+
+	scan.len = rte_pktmbuf_pkt_len(op->mbuf);
+	if (scan.len > SW_REGEX_MAX_PAYLOAD) {
+		scan.len = SW_REGEX_MAX_PAYLOAD;
+		op->rsp_flags |= RTE_REGEX_OPS_RSP_RESOURCE_LIMIT_REACHED_F;
+	}
+
+	if (db == NULL || db->nb_rules == 0)
+		return;
+
+	if (op->req_flags & RTE_REGEX_OPS_REQ_GROUP_ID0_VALID_F)
+		scan.groups[scan.nb_groups++] = op->group_id0;
+	if (op->req_flags & RTE_REGEX_OPS_REQ_GROUP_ID1_VALID_F)
+		scan.groups[scan.nb_groups++] = op->group_id1;
+	if (op->req_flags & RTE_REGEX_OPS_REQ_GROUP_ID2_VALID_F)
+		scan.groups[scan.nb_groups++] = op->group_id2;
+	if (op->req_flags & RTE_REGEX_OPS_REQ_GROUP_ID3_VALID_F)
+		scan.groups[scan.nb_groups++] = op->group_id3;
+
+	scan.gen = qp_gen_next(qp);
+	if (scan_dfa(&scan)) {
+		pike_run(&scan, scan.stop_rule, scan.stop_end);
+	} else {
+		for (i = 0; i < scan.nb_matched; i++) {
+			r = qp->matched[i];
+			pike_run(&scan, r, qp->rule_end[r]);
+		}
+	}
+
+	if (scan.best != NULL) {
+		match = &op->matches[0];
+		match->u64 = 0;
+		match->rule_id = scan.best->rule_id;
+		match->group_id = scan.best->group_id;
+		match->start_offset = scan.best_start;
+		match->len = scan.best_end - scan.best_start;
+		op->nb_matches = 1;
+	}
+}
+
+uint16_t
+sw_regex_enqueue(struct rte_regexdev *dev, uint16_t qp_id,
+		struct rte_regex_ops **ops, uint16_t nb_ops)
+{
+	const struct sw_regex_priv *priv = dev->data->dev_private;
+	struct sw_regex_qp *qp = priv->qps[qp_id];
+	uint32_t free_slots;
+	uint16_t i;
+
+	free_slots = qp->mask + 1 - (qp->head - qp->tail);
+	nb_ops = RTE_MIN(nb_ops, free_slots);
+
+	for (i = 0; i < nb_ops; i++) {
+		if (i + 1 < nb_ops)
+			rte_prefetch0(rte_pktmbuf_mtod(ops[i + 1]->mbuf, void *));
+		sw_regex_scan(priv, qp, ops[i]);
+		qp->ring[qp->head++ & qp->mask] = ops[i];
+	}
+
+	return nb_ops;
+}
+
+uint16_t
+sw_regex_dequeue(struct rte_regexdev *dev, uint16_t qp_id,
+		struct rte_regex_ops **ops, uint16_t nb_ops)
+{
+	const struct sw_regex_priv *priv = dev->data->dev_private;
+	struct sw_regex_qp *qp = priv->qps[qp_id];
+	uint16_t i;
+
+	nb_ops = RTE_MIN(nb_ops, qp->head - qp->tail);
+	for (i = 0; i < nb_ops; i++)
+		ops[i] = qp->ring[qp->tail++ & qp->mask];
+
+	return nb_ops;
+}
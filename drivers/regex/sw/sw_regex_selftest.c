@@ -0,0 +1,318 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <string.h>
+
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+
+#include "sw_regex.h"
+
+#define SELFTEST_MAX_MATCHES	8
+#define SELFTEST_MAX_SEGS	4
+#define SELFTEST_CANARY		0x5a
+
+static char selftest_patterns[][16] = {
+	"hello",
+	"wor?ld",
+	"^abc",
+	"[0-9]+x",
+	"(?i)dpdk",
+	"end$",
+	"q.z",
+	"x{2,3}y",
+	"rte",
+};
+
+#define SELFTEST_NB_RULES	RTE_DIM(selftest_patterns)
+
+static char selftest_invalid[][16] = {
+	"(ab",
+	"ab)",
+	"[a-",
+	"a|",
+	"x{3,2}",
+	"\\1",
+	"a^b",
+	"a$b",
+};
+
+struct selftest_match {
+	uint32_t rule_id;
+	uint16_t start;
+	uint16_t len;
+};
+
+struct selftest_vector {
+	const char *input;
+	/* Size of the first segments, the last one holding the rest */
+	uint16_t segs[SELFTEST_MAX_SEGS - 1];
+	uint16_t req_flags;
+	uint16_t group_id0;
+	uint16_t nb_matches;
+	struct selftest_match matches[SELFTEST_MAX_MATCHES];
+};
+
+static const struct selftest_vector selftest_vectors[] = {
+	{ .input = "say hello world", .nb_matches = 2,
+	  .matches = { { 1, 4, 5 }, { 2, 10, 5 } } },
+	{ .input = "say hello world", .segs = { 6, 1, 4 }, .nb_matches = 2,
+	  .matches = { { 1, 4, 5 }, { 2, 10, 5 } } },
+	{ .input = "say hello world",
+	  .req_flags = RTE_REGEX_OPS_REQ_GROUP_ID0_VALID_F, .group_id0 = 1,
+	  .nb_matches = 1, .matches = { { 2, 10, 5 } } },
+	{ .input = "say hello world",
+	  .req_flags = RTE_REGEX_OPS_REQ_STOP_ON_MATCH_F,
+	  .nb_matches = 1, .matches = { { 1, 4, 5 } } },
+	{ .input = "wold hello",
+	  .req_flags = RTE_REGEX_OPS_REQ_MATCH_HIGH_PRIORITY_F,
+	  .nb_matches = 1, .matches = { { 1, 5, 5 } } },
+	{ .input = "abc abc", .nb_matches = 1, .matches = { { 3, 0, 3 } } },
+	{ .input = " abc", .nb_matches = 0 },
+	{ .input = "a 12345x", .nb_matches = 1, .matches = { { 4, 2, 6 } } },
+	{ .input = "I like DpDk and RTE", .nb_matches = 2,
+	  .matches = { { 5, 7, 4 }, { 9, 16, 3 } } },
+	{ .input = "end the end", .nb_matches = 1, .matches = { { 6, 8, 3 } } },
+	{ .input = "q\nz qaz", .nb_matches = 1, .matches = { { 7, 4, 3 } } },
+	{ .input = "xxxxy", .nb_matches = 1, .matches = { { 8, 1, 4 } } },
+	{ .input = "xxyxxy", .segs = { 1, 3 }, .nb_matches = 2,
+	  .matches = { { 8, 0, 3 }, { 8, 3, 3 } } },
+	{ .input = "nothing to see here", .nb_matches = 0 },
+};
+
+static struct rte_mbuf *
+selftest_mbuf(struct rte_mempool *pool, const struct selftest_vector *v)
+{
+	struct rte_mbuf *head = NULL, *m;
+	size_t len = strlen(v->input), off = 0, n;
+	unsigned int i;
+	char *data;
+
+	for (i = 0; off < len || head == NULL; i++) {
+		n = len - off;
+		if (i < RTE_DIM(v->segs) && v->segs[i] != 0)
+			n = RTE_MIN(n, (size_t)v->segs[i]);
+		m = rte_pktmbuf_alloc(pool);
+		if (m == NULL)
+			goto err;
+		data = rte_pktmbuf_append(m, n);
+		if (data == NULL && n != 0) {
+			rte_pktmbuf_free(m);
+			goto err;
+		}
+		memcpy(data, v->input + off, n);
+		off += n;
+		if (head == NULL)
+			head = m;
+		else if (rte_pktmbuf_chain(head, m) < 0) {
+			rte_pktmbuf_free(m);
+			goto err;
+		}
+	}
+
+	return head;
+
+err:
+	rte_pktmbuf_free(head);
+	return NULL;
+}
+
+static int
+selftest_check(const struct selftest_vector *v, const struct rte_regex_ops *op)
+{
+	const struct rte_regexdev_match *m;
+	uint16_t i, j;
+
+	if (op->nb_matches != v->nb_matches) {
+		SW_REGEX_LOG(ERR, "\"%s\": %u matches instead of %u",
+			v->input, op->nb_matches, v->nb_matches);
+		return -1;
+	}
+
+	for (i = 0; i < v->nb_matches; i++) {
+		for (j = 0; j < op->nb_matches; j++) {
+			m = &op->matches[j];
+			if (m->rule_id == v->matches[i].rule_id &&
+					m->start_offset == v->matches[i].start &&
+					m->len == v->matches[i].len)
+				break;
+		}
+		if (j == op->nb_matches) {
+			SW_REGEX_LOG(ERR, "\"%s\": missing match of rule %u"
+				" at %u length %u", v->input,
+				v->matches[i].rule_id, v->matches[i].start,
+				v->matches[i].len);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Export the rules, import them back and check the imported rules are valid
+ * and exported the same way, without writing past the exported size.
+ */
+static int
+selftest_export(struct sw_regex_rule_entry *rules, uint32_t nb_rules,
+		uint32_t max_dfa_states)
+{
+	struct sw_regex_priv src = {
+		.nb_rules = nb_rules,
+		.rules_sz = nb_rules,
+		.rules = rules,
+	};
+	struct sw_regex_priv dst = { 0 };
+	struct sw_regex_db *db;
+	char *buf, *buf2;
+	uint32_t i;
+	int size, ret = -1;
+
+	size = sw_regex_rules_export(&src, NULL);
+	buf = rte_malloc(NULL, size + 1, 0);
+	buf2 = rte_malloc(NULL, size + 1, 0);
+	if (buf == NULL || buf2 == NULL) {
+		SW_REGEX_LOG(ERR, "Failed to allocate the exported rules");
+		goto out;
+	}
+
+	buf[size] = SELFTEST_CANARY;
+	if (sw_regex_rules_export(&src, buf) != size ||
+			buf[size] != SELFTEST_CANARY ||
+			strlen(buf) + 1 != (size_t)size) {
+		SW_REGEX_LOG(ERR, "Exported rules do not match their size");
+		goto out;
+	}
+
+	if (sw_regex_rules_parse(&dst, buf, size) < 0 ||
+			dst.nb_rules != nb_rules) {
+		SW_REGEX_LOG(ERR, "Failed to import the exported rules");
+		goto out;
+	}
+	for (i = 0; i < nb_rules; i++) {
+		if (dst.rules[i].rule_id != rules[i].rule_id ||
+				dst.rules[i].group_id != rules[i].group_id) {
+			SW_REGEX_LOG(ERR, "Rule %u imported as rule %u"
+				" of group %u", rules[i].rule_id,
+				dst.rules[i].rule_id, dst.rules[i].group_id);
+			goto out;
+		}
+	}
+
+	db = sw_regex_compile(dst.rules, dst.nb_rules, max_dfa_states);
+	if (db == NULL) {
+		SW_REGEX_LOG(ERR, "Failed to compile the imported rules");
+		goto out;
+	}
+	sw_regex_db_free(db);
+
+	buf2[size] = SELFTEST_CANARY;
+	if (sw_regex_rules_export(&dst, buf2) != size ||
+			memcmp(buf, buf2, size + 1) != 0) {
+		SW_REGEX_LOG(ERR, "Imported rules are exported differently");
+		goto out;
+	}
+
+	ret = 0;
+
+out:
+	sw_regex_rules_free(&dst);
+	rte_free(buf2);
+	rte_free(buf);
+
+	return ret;
+}
+
+/*
+ * Compile a fixed set of rules in a private database and check the matches
+ * found in a few buffers. The configuration of the device is not used.
+ */
+int
+sw_regex_selftest(struct rte_regexdev *dev)
+{
+	const struct sw_regex_priv *dev_priv = dev->data->dev_private;
+	struct sw_regex_priv priv = {
+		.nb_max_matches = SELFTEST_MAX_MATCHES,
+	};
+	struct sw_regex_rule_entry rules[SELFTEST_NB_RULES] = { 0 };
+	struct sw_regex_rule_entry invalid = { 0 };
+	struct sw_regex_qp qp = { 0 };
+	struct rte_regex_ops *op = NULL;
+	struct rte_mempool *pool = NULL;
+	const struct selftest_vector *v;
+	struct sw_regex_db *db;
+	struct rte_mbuf *m;
+	unsigned int i;
+	int ret = -1;
+
+	for (i = 0; i < RTE_DIM(selftest_invalid); i++) {
+		invalid.pattern = selftest_invalid[i];
+		db = sw_regex_compile(&invalid, 1, dev_priv->max_dfa_states);
+		if (db != NULL) {
+			SW_REGEX_LOG(ERR, "Invalid rule \"%s\" compiled",
+				selftest_invalid[i]);
+			sw_regex_db_free(db);
+			return -1;
+		}
+	}
+
+	/* Rule i + 1 for pattern i, "wor?ld" in group 1 and "rte" caseless */
+	for (i = 0; i < SELFTEST_NB_RULES; i++) {
+		rules[i].rule_id = i + 1;
+		rules[i].pattern = selftest_patterns[i];
+	}
+	rules[1].group_id = 1;
+	rules[8].rule_flags = RTE_REGEX_PCRE_RULE_CASELESS_F;
+
+	if (selftest_export(rules, SELFTEST_NB_RULES,
+			dev_priv->max_dfa_states) < 0)
+		return -1;
+
+	priv.db = sw_regex_compile(rules, SELFTEST_NB_RULES,
+			dev_priv->max_dfa_states);
+	if (priv.db == NULL) {
+		SW_REGEX_LOG(ERR, "Failed to compile the rules");
+		return -1;
+	}
+	if (sw_regex_qp_scratch_alloc(&qp, priv.db) < 0)
+		goto out;
+
+	op = rte_zmalloc(NULL, sizeof(*op) +
+			SELFTEST_MAX_MATCHES * sizeof(op->matches[0]), 0);
+	pool = rte_pktmbuf_pool_create("sw_regex_selftest", 63, 0, 0,
+			RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (op == NULL || pool == NULL) {
+		SW_REGEX_LOG(ERR, "Failed to allocate the selftest resources");
+		goto out;
+	}
+
+	for (i = 0; i < RTE_DIM(selftest_vectors); i++) {
+		v = &selftest_vectors[i];
+		m = selftest_mbuf(pool, v);
+		if (m == NULL)
+			goto out;
+
+		memset(op, 0, sizeof(*op));
+		op->mbuf = m;
+		op->req_flags = v->req_flags;
+		op->group_id0 = v->group_id0;
+		sw_regex_scan(&priv, &qp, op);
+		rte_pktmbuf_free(m);
+
+		if (selftest_check(v, op) < 0)
+			goto out;
+	}
+
+	SW_REGEX_LOG(INFO, "Selftest passed: %u vectors, %u DFA states",
+		(unsigned int)RTE_DIM(selftest_vectors), priv.db->nb_dfa);
+	ret = 0;
+
+out:
+	rte_mempool_free(pool);
+	rte_free(op);
+	sw_regex_qp_scratch_free(&qp);
+	sw_regex_db_free(priv.db);
+
+	return ret;
+}
@@ -53,6 +53,8 @@ rte_comp_get_feature_name(uint64_t flag)
 		return "LZ4_BLOCK_INDEPENDENCE";
 	case RTE_COMP_FF_LZ4_BLOCK_WITH_CHECKSUM:
 		return "LZ4_BLOCK_WITH_CHECKSUM";
+	case RTE_COMP_FF_PRESET_DICT:
+		return "PRESET_DICT";
 	default:
 		return NULL;
 	}
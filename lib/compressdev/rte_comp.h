@@ -78,6 +78,11 @@ extern "C" {
 /**< LZ4 block independent is supported */
 #define RTE_COMP_FF_LZ4_BLOCK_WITH_CHECKSUM	(1ULL << 20)
 /**< LZ4 block with checksum is supported */
+#define RTE_COMP_FF_PRESET_DICT			(1ULL << 21)
+/**< Preset dictionaries are supported, see
+ * rte_compressdev_private_xform_dict_set() and
+ * rte_compressdev_stream_dict_set()
+ */
 
 /** Status of comp operation */
 enum rte_comp_op_status {
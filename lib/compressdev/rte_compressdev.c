@@ -784,6 +784,60 @@ rte_compressdev_stream_free(uint8_t dev_id, void *stream)
 	return 0;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_compressdev_private_xform_dict_set, 25.07)
+int
+rte_compressdev_private_xform_dict_set(uint8_t dev_id, void *priv_xform,
+		const uint8_t *dict, uint32_t dict_len)
+{
+	struct rte_compressdev *dev;
+	int ret;
+
+	dev = rte_compressdev_get_dev(dev_id);
+
+	if (dev == NULL || priv_xform == NULL ||
+			(dict == NULL && dict_len != 0))
+		return -EINVAL;
+
+	if (dev->dev_ops->private_xform_dict_set == NULL)
+		return -ENOTSUP;
+	ret = dev->dev_ops->private_xform_dict_set(dev, priv_xform,
+			dict, dict_len);
+	if (ret < 0) {
+		COMPRESSDEV_LOG(ERR,
+			"dev_id %d failed to set private xform dictionary: err=%d",
+			dev_id, ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_compressdev_stream_dict_set, 25.07)
+int
+rte_compressdev_stream_dict_set(uint8_t dev_id, void *stream,
+		const uint8_t *dict, uint32_t dict_len)
+{
+	struct rte_compressdev *dev;
+	int ret;
+
+	dev = rte_compressdev_get_dev(dev_id);
+
+	if (dev == NULL || stream == NULL || (dict == NULL && dict_len != 0))
+		return -EINVAL;
+
+	if (dev->dev_ops->stream_dict_set == NULL)
+		return -ENOTSUP;
+	ret = dev->dev_ops->stream_dict_set(dev, stream, dict, dict_len);
+	if (ret < 0) {
+		COMPRESSDEV_LOG(ERR,
+			"dev_id %d failed to set stream dictionary: err=%d",
+			dev_id, ret);
+		return ret;
+	}
+
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_compressdev_name_get)
 const char *
 rte_compressdev_name_get(uint8_t dev_id)
@@ -13,6 +13,8 @@
  * Defines comp device APIs for the provisioning of compression operations.
  */
 
+#include <rte_compat.h>
+
 #include "rte_comp.h"
 
 #ifdef __cplusplus
@@ -543,6 +545,79 @@ rte_compressdev_private_xform_create(uint8_t dev_id,
 int
 rte_compressdev_private_xform_free(uint8_t dev_id, void *private_xform);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Set the preset dictionary of a private_xform.
+ *
+ * The dictionary is the history which precedes the data of each
+ * operation using the private_xform. Data compressed with a dictionary
+ * can only be decompressed with the same dictionary set on the
+ * decompression side. It improves the compression ratio of small
+ * independent records which share common content.
+ *
+ * The dictionary is copied by the PMD, only its last window of data is kept.
+ * The private_xform must not be used by in-flight operations.
+ * Requires the RTE_COMP_FF_PRESET_DICT feature flag.
+ *
+ * @param dev_id
+ *   Compress device identifier
+ * @param private_xform
+ *   PMD's private_xform data
+ * @param dict
+ *   Dictionary data, NULL to remove the dictionary
+ * @param dict_len
+ *   Dictionary length, 0 to remove the dictionary
+ *
+ * @return
+ *  - 0 if successful
+ *  - <0 in error cases
+ *  - Returns -EINVAL if input parameters are invalid.
+ *  - Returns -ENOTSUP if comp device does not support preset dictionaries.
+ *  - Returns -ENOMEM if the dictionary could not be allocated.
+ */
+__rte_experimental
+int
+rte_compressdev_private_xform_dict_set(uint8_t dev_id, void *private_xform,
+		const uint8_t *dict, uint32_t dict_len);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Set the preset dictionary of a stream.
+ *
+ * The dictionary is the history which precedes the data of the stream.
+ * It is used again when the stream restarts after an operation with
+ * RTE_COMP_FLUSH_FINAL, so that a stream can be reused for a sequence of
+ * records sharing the same dictionary. The stream restarts when the
+ * dictionary is set, which must be done while it has no in-flight operation.
+ *
+ * The dictionary is copied by the PMD, only its last window of data is kept.
+ * Requires the RTE_COMP_FF_PRESET_DICT feature flag.
+ *
+ * @param dev_id
+ *   Compress device identifier
+ * @param stream
+ *   PMD's private stream data
+ * @param dict
+ *   Dictionary data, NULL to remove the dictionary
+ * @param dict_len
+ *   Dictionary length, 0 to remove the dictionary
+ *
+ * @return
+ *  - 0 if successful
+ *  - <0 in error cases
+ *  - Returns -EINVAL if input parameters are invalid.
+ *  - Returns -ENOTSUP if comp device does not support preset dictionaries.
+ *  - Returns -ENOMEM if the dictionary could not be allocated.
+ */
+__rte_experimental
+int
+rte_compressdev_stream_dict_set(uint8_t dev_id, void *stream,
+		const uint8_t *dict, uint32_t dict_len);
+
 #ifdef __cplusplus
 }
 #endif
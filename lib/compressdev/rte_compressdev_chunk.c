@@ -0,0 +1,489 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_memcpy.h>
+#include <rte_mempool.h>
+#include <rte_stdatomic.h>
+
+#include "rte_compressdev.h"
+#include "rte_compressdev_chunk.h"
+#include "rte_compressdev_internal.h"
+
+/* Worst case size of the output of a chunk, including the full flush */
+#define CHUNK_OUT_BOUND(sz)	((sz) + ((sz) >> 3) + 64)
+
+/* Empty final fixed Huffman block, ending the DEFLATE stream */
+static const uint8_t chunk_last_block[] = { 0x03, 0x00 };
+
+/* A chunk in flight, one per stream */
+struct chunk_slot {
+	struct rte_comp_op *op;
+	struct rte_mbuf *m_src;
+	struct rte_mbuf *m_dst;
+	void *stream;
+	uint32_t chunk_id;
+};
+
+struct __rte_cache_aligned chunk_worker {
+	struct chunk_slot *slots;
+	/* Slots with no chunk in flight */
+	struct chunk_slot **free_slots;
+	uint16_t nb_free;
+	/* Ops not enqueued yet, as the queue pair was full */
+	struct rte_comp_op **pending;
+	uint16_t nb_pending;
+	struct rte_comp_op **deq_ops;
+};
+
+struct rte_compressdev_chunk_ctx {
+	uint8_t dev_id;
+	uint16_t nb_qps;
+	uint16_t depth;
+	uint32_t chunk_sz;
+	uint32_t dict_sz;
+	uint32_t out_bound;
+	int socket_id;
+	/* Streams are restarted by setting their dictionary, or recreated */
+	bool has_dict_set;
+	struct rte_comp_xform xform;
+	struct rte_mempool *op_pool;
+	struct rte_mempool *mbuf_pool;
+	struct chunk_worker *workers;
+
+	/* Buffer in progress */
+	const uint8_t *src;
+	size_t src_len;
+	uint32_t nb_chunks;
+	uint8_t *out;
+	uint32_t *out_len;
+	RTE_ATOMIC(uint32_t) next_chunk;
+	RTE_ATOMIC(uint32_t) nb_done;
+	RTE_ATOMIC(uint32_t) error;
+};
+
+static RTE_ATOMIC(uint32_t) chunk_ctx_id;
+
+static int
+chunk_slot_init(struct rte_compressdev_chunk_ctx *ctx, struct chunk_slot *slot)
+{
+	slot->op = rte_comp_op_alloc(ctx->op_pool);
+	slot->m_src = rte_pktmbuf_alloc(ctx->mbuf_pool);
+	slot->m_dst = rte_pktmbuf_alloc(ctx->mbuf_pool);
+	if (slot->op == NULL || slot->m_src == NULL || slot->m_dst == NULL)
+		return -ENOMEM;
+
+	/* The op private area points back to its slot */
+	*(struct chunk_slot **)(slot->op + 1) = slot;
+
+	if (rte_pktmbuf_append(slot->m_dst, ctx->out_bound) == NULL)
+		return -ENOMEM;
+
+	return rte_compressdev_stream_create(ctx->dev_id, &ctx->xform,
+			&slot->stream);
+}
+
+static void
+chunk_slot_free(struct rte_compressdev_chunk_ctx *ctx, struct chunk_slot *slot)
+{
+	if (slot->stream != NULL)
+		rte_compressdev_stream_free(ctx->dev_id, slot->stream);
+	rte_pktmbuf_free(slot->m_src);
+	rte_pktmbuf_free(slot->m_dst);
+	rte_comp_op_free(slot->op);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_compressdev_chunk_ctx_create, 25.07)
+struct rte_compressdev_chunk_ctx *
+rte_compressdev_chunk_ctx_create(const struct rte_compressdev_chunk_conf *conf)
+{
+	const struct rte_compressdev_capabilities *cap;
+	struct rte_compressdev_chunk_ctx *ctx;
+	char name[RTE_MEMPOOL_NAMESIZE];
+	struct chunk_worker *w;
+	uint32_t nb_slots, id;
+	uint16_t i, j;
+	int ret;
+
+	if (conf == NULL || conf->xform == NULL ||
+			conf->xform->type != RTE_COMP_COMPRESS ||
+			conf->xform->compress.algo != RTE_COMP_ALGO_DEFLATE ||
+			conf->xform->compress.chksum != RTE_COMP_CHECKSUM_NONE ||
+			conf->nb_qps == 0 || conf->depth == 0 ||
+			conf->chunk_sz == 0 ||
+			conf->chunk_sz > RTE_COMPRESSDEV_CHUNK_SZ_MAX) {
+		COMPRESSDEV_LOG(ERR, "Invalid chunked compression configuration");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	if (conf->nb_qps > rte_compressdev_queue_pair_count(conf->dev_id)) {
+		COMPRESSDEV_LOG(ERR, "Device %u has less than %u queue pairs",
+				conf->dev_id, conf->nb_qps);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	cap = rte_compressdev_capability_get(conf->dev_id,
+			RTE_COMP_ALGO_DEFLATE);
+	if (cap == NULL ||
+			!(cap->comp_feature_flags &
+				RTE_COMP_FF_STATEFUL_COMPRESSION) ||
+			(conf->dict_sz != 0 && !(cap->comp_feature_flags &
+				RTE_COMP_FF_PRESET_DICT))) {
+		COMPRESSDEV_LOG(ERR,
+			"Device %u does not support chunked compression",
+			conf->dev_id);
+		rte_errno = ENOTSUP;
+		return NULL;
+	}
+
+	ctx = rte_zmalloc_socket("compressdev_chunk_ctx", sizeof(*ctx), 0,
+			conf->socket_id);
+	if (ctx == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	ctx->dev_id = conf->dev_id;
+	ctx->nb_qps = conf->nb_qps;
+	ctx->depth = conf->depth;
+	ctx->chunk_sz = conf->chunk_sz;
+	ctx->dict_sz = conf->dict_sz;
+	ctx->out_bound = CHUNK_OUT_BOUND(conf->chunk_sz);
+	ctx->socket_id = conf->socket_id;
+	ctx->has_dict_set = !!(cap->comp_feature_flags &
+			RTE_COMP_FF_PRESET_DICT);
+	ctx->xform = *conf->xform;
+
+	nb_slots = conf->nb_qps * conf->depth;
+	id = rte_atomic_fetch_add_explicit(&chunk_ctx_id, 1,
+			rte_memory_order_relaxed);
+
+	snprintf(name, sizeof(name), "comp_chunk_op_%u", id);
+	ctx->op_pool = rte_comp_op_pool_create(name, nb_slots, 0,
+			sizeof(struct chunk_slot *), conf->socket_id);
+	snprintf(name, sizeof(name), "comp_chunk_mbuf_%u", id);
+	ctx->mbuf_pool = rte_pktmbuf_pool_create(name, 2 * nb_slots, 0, 0,
+			RTE_PKTMBUF_HEADROOM + ctx->out_bound, conf->socket_id);
+	ctx->workers = rte_zmalloc_socket("compressdev_chunk_workers",
+			sizeof(*ctx->workers) * conf->nb_qps, 0, conf->socket_id);
+	if (ctx->op_pool == NULL || ctx->mbuf_pool == NULL ||
+			ctx->workers == NULL) {
+		ret = -ENOMEM;
+		goto err;
+	}
+
+	for (i = 0; i < conf->nb_qps; i++) {
+		w = &ctx->workers[i];
+		w->slots = rte_zmalloc_socket(NULL,
+				sizeof(*w->slots) * conf->depth, 0,
+				conf->socket_id);
+		w->free_slots = rte_malloc_socket(NULL,
+				sizeof(*w->free_slots) * conf->depth, 0,
+				conf->socket_id);
+		w->pending = rte_malloc_socket(NULL,
+				sizeof(*w->pending) * conf->depth, 0,
+				conf->socket_id);
+		w->deq_ops = rte_malloc_socket(NULL,
+				sizeof(*w->deq_ops) * conf->depth, 0,
+				conf->socket_id);
+		if (w->slots == NULL || w->free_slots == NULL ||
+				w->pending == NULL || w->deq_ops == NULL) {
+			ret = -ENOMEM;
+			goto err;
+		}
+
+		for (j = 0; j < conf->depth; j++) {
+			ret = chunk_slot_init(ctx, &w->slots[j]);
+			if (ret < 0) {
+				COMPRESSDEV_LOG(ERR,
+					"Failed to allocate chunk resources");
+				goto err;
+			}
+			w->free_slots[j] = &w->slots[j];
+		}
+		w->nb_free = conf->depth;
+	}
+
+	return ctx;
+
+err:
+	rte_compressdev_chunk_ctx_free(ctx);
+	rte_errno = -ret;
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_compressdev_chunk_ctx_free, 25.07)
+void
+rte_compressdev_chunk_ctx_free(struct rte_compressdev_chunk_ctx *ctx)
+{
+	struct chunk_worker *w;
+	uint16_t i, j;
+
+	if (ctx == NULL)
+		return;
+
+	for (i = 0; ctx->workers != NULL && i < ctx->nb_qps; i++) {
+		w = &ctx->workers[i];
+		for (j = 0; w->slots != NULL && j < ctx->depth; j++)
+			chunk_slot_free(ctx, &w->slots[j]);
+		rte_free(w->slots);
+		rte_free(w->free_slots);
+		rte_free(w->pending);
+		rte_free(w->deq_ops);
+	}
+
+	rte_free(ctx->out);
+	rte_free(ctx->out_len);
+	rte_free(ctx->workers);
+	rte_mempool_free(ctx->mbuf_pool);
+	rte_mempool_free(ctx->op_pool);
+	rte_free(ctx);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_compressdev_chunk_start, 25.07)
+int
+rte_compressdev_chunk_start(struct rte_compressdev_chunk_ctx *ctx,
+		const uint8_t *src, size_t src_len)
+{
+	uint64_t nb_chunks;
+
+	if (ctx == NULL || (src == NULL && src_len != 0) || ctx->src != NULL)
+		return -EINVAL;
+
+	nb_chunks = (src_len + ctx->chunk_sz - 1) / ctx->chunk_sz;
+	if (nb_chunks > UINT32_MAX)
+		return -EINVAL;
+
+	if (nb_chunks != 0) {
+		ctx->out = rte_malloc_socket("compressdev_chunk_out",
+				nb_chunks * ctx->out_bound, 0, ctx->socket_id);
+		ctx->out_len = rte_malloc_socket("compressdev_chunk_out_len",
+				nb_chunks * sizeof(*ctx->out_len), 0,
+				ctx->socket_id);
+		if (ctx->out == NULL || ctx->out_len == NULL) {
+			rte_free(ctx->out);
+			rte_free(ctx->out_len);
+			ctx->out = NULL;
+			ctx->out_len = NULL;
+			return -ENOMEM;
+		}
+	}
+
+	ctx->src = src;
+	ctx->src_len = src_len;
+	ctx->nb_chunks = nb_chunks;
+	rte_atomic_store_explicit(&ctx->next_chunk, 0, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&ctx->nb_done, 0, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&ctx->error, 0, rte_memory_order_release);
+
+	return 0;
+}
+
+/* Restart the stream of a slot and prepare its op for a chunk */
+static int
+chunk_prepare(struct rte_compressdev_chunk_ctx *ctx, struct chunk_slot *slot,
+		uint32_t chunk_id)
+{
+	size_t offset = (size_t)chunk_id * ctx->chunk_sz;
+	uint32_t len = RTE_MIN(ctx->src_len - offset, (size_t)ctx->chunk_sz);
+	uint32_t dict_len = RTE_MIN(offset, (size_t)ctx->dict_sz);
+	struct rte_comp_op *op = slot->op;
+	int ret;
+
+	/* The chunk must not reference the history of the previous one */
+	if (ctx->has_dict_set) {
+		ret = rte_compressdev_stream_dict_set(ctx->dev_id, slot->stream,
+				ctx->src + offset - dict_len, dict_len);
+	} else {
+		rte_compressdev_stream_free(ctx->dev_id, slot->stream);
+		slot->stream = NULL;
+		ret = rte_compressdev_stream_create(ctx->dev_id, &ctx->xform,
+				&slot->stream);
+	}
+	if (ret < 0)
+		return ret;
+
+	rte_pktmbuf_reset(slot->m_src);
+	rte_memcpy(rte_pktmbuf_append(slot->m_src, len), ctx->src + offset,
+			len);
+
+	op->op_type = RTE_COMP_OP_STATEFUL;
+	op->stream = slot->stream;
+	op->m_src = slot->m_src;
+	op->m_dst = slot->m_dst;
+	op->src.offset = 0;
+	op->src.length = len;
+	op->dst.offset = 0;
+	op->flush_flag = RTE_COMP_FLUSH_FULL;
+	op->consumed = 0;
+	op->produced = 0;
+	op->status = RTE_COMP_OP_STATUS_NOT_PROCESSED;
+	slot->chunk_id = chunk_id;
+
+	return 0;
+}
+
+static int
+chunk_complete(struct rte_compressdev_chunk_ctx *ctx, struct chunk_slot *slot)
+{
+	struct rte_comp_op *op = slot->op;
+
+	if (op->status != RTE_COMP_OP_STATUS_SUCCESS ||
+			op->consumed != op->src.length) {
+		COMPRESSDEV_LOG(ERR, "Compression of chunk %u failed, status %u",
+				slot->chunk_id, op->status);
+		return -EIO;
+	}
+
+	rte_memcpy(ctx->out + (size_t)slot->chunk_id * ctx->out_bound,
+			rte_pktmbuf_mtod(slot->m_dst, uint8_t *), op->produced);
+	ctx->out_len[slot->chunk_id] = op->produced;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_compressdev_chunk_process, 25.07)
+int
+rte_compressdev_chunk_process(struct rte_compressdev_chunk_ctx *ctx,
+		uint16_t qp_id)
+{
+	uint16_t nb_enq, nb_deq, nb_inflight = 0, i;
+	struct chunk_slot *slot;
+	struct chunk_worker *w;
+	bool claim = true;
+	uint32_t chunk_id;
+	int nb_chunks = 0;
+
+	if (ctx == NULL || qp_id >= ctx->nb_qps)
+		return -EINVAL;
+
+	w = &ctx->workers[qp_id];
+
+	do {
+		if (rte_atomic_load_explicit(&ctx->error,
+				rte_memory_order_relaxed) != 0)
+			claim = false;
+
+		/* Claim chunks for the free slots */
+		while (claim && w->nb_free != 0) {
+			chunk_id = rte_atomic_fetch_add_explicit(
+					&ctx->next_chunk, 1,
+					rte_memory_order_relaxed);
+			if (chunk_id >= ctx->nb_chunks) {
+				claim = false;
+				break;
+			}
+
+			slot = w->free_slots[--w->nb_free];
+			if (chunk_prepare(ctx, slot, chunk_id) < 0) {
+				COMPRESSDEV_LOG(ERR,
+					"Failed to restart the stream of chunk %u",
+					chunk_id);
+				rte_atomic_store_explicit(&ctx->error, 1,
+						rte_memory_order_relaxed);
+				w->free_slots[w->nb_free++] = slot;
+				claim = false;
+				break;
+			}
+			w->pending[w->nb_pending++] = slot->op;
+		}
+
+		if (w->nb_pending != 0) {
+			nb_enq = rte_compressdev_enqueue_burst(ctx->dev_id, qp_id,
+					w->pending, w->nb_pending);
+			nb_inflight += nb_enq;
+			w->nb_pending -= nb_enq;
+			if (w->nb_pending != 0)
+				memmove(w->pending, w->pending + nb_enq,
+					w->nb_pending * sizeof(*w->pending));
+		}
+
+		if (nb_inflight == 0)
+			continue;
+
+		nb_deq = rte_compressdev_dequeue_burst(ctx->dev_id, qp_id,
+				w->deq_ops, ctx->depth);
+		nb_inflight -= nb_deq;
+		for (i = 0; i < nb_deq; i++) {
+			slot = *(struct chunk_slot **)(w->deq_ops[i] + 1);
+			if (chunk_complete(ctx, slot) < 0)
+				rte_atomic_store_explicit(&ctx->error, 1,
+						rte_memory_order_relaxed);
+			else
+				nb_chunks++;
+			w->free_slots[w->nb_free++] = slot;
+		}
+	} while (claim || w->nb_pending != 0 || nb_inflight != 0);
+
+	rte_atomic_fetch_add_explicit(&ctx->nb_done, nb_chunks,
+			rte_memory_order_release);
+
+	if (rte_atomic_load_explicit(&ctx->error,
+			rte_memory_order_relaxed) != 0)
+		return -EIO;
+
+	return nb_chunks;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_compressdev_chunk_finish, 25.07)
+int
+rte_compressdev_chunk_finish(struct rte_compressdev_chunk_ctx *ctx,
+		uint8_t *dst, size_t *dst_len)
+{
+	size_t len = sizeof(chunk_last_block);
+	uint32_t i;
+	int ret = 0;
+
+	if (ctx == NULL || dst_len == NULL || (dst == NULL && *dst_len != 0))
+		return -EINVAL;
+
+	if (rte_atomic_load_explicit(&ctx->error,
+			rte_memory_order_acquire) != 0) {
+		ret = -EIO;
+		goto end;
+	}
+
+	if (rte_atomic_load_explicit(&ctx->nb_done,
+			rte_memory_order_acquire) != ctx->nb_chunks)
+		return -EINVAL;
+
+	for (i = 0; i < ctx->nb_chunks; i++)
+		len += ctx->out_len[i];
+	if (len > *dst_len) {
+		*dst_len = len;
+		return -ENOSPC;
+	}
+
+	/* The chunks end with a full flush, so their outputs are byte
+	 * aligned and can be concatenated.
+	 */
+	len = 0;
+	for (i = 0; i < ctx->nb_chunks; i++) {
+		rte_memcpy(dst + len, ctx->out + (size_t)i * ctx->out_bound,
+				ctx->out_len[i]);
+		len += ctx->out_len[i];
+	}
+	memcpy(dst + len, chunk_last_block, sizeof(chunk_last_block));
+	*dst_len = len + sizeof(chunk_last_block);
+
+end:
+	rte_free(ctx->out);
+	rte_free(ctx->out_len);
+	ctx->out = NULL;
+	ctx->out_len = NULL;
+	ctx->src = NULL;
+	ctx->src_len = 0;
+	ctx->nb_chunks = 0;
+
+	return ret;
+}
@@ -0,0 +1,188 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_COMPRESSDEV_CHUNK_H_
+#define _RTE_COMPRESSDEV_CHUNK_H_
+
+/**
+ * @file rte_compressdev_chunk.h
+ *
+ * RTE Compression Device chunked compression helper.
+ *
+ * Compresses a large buffer by splitting it in chunks which are processed
+ * in parallel on several queue pairs of a device, usually one per lcore.
+ * Each chunk is compressed on a stateful stream ended with a full flush,
+ * so that its output is byte aligned and does not reference the data of
+ * the previous chunks. The outputs of the chunks are concatenated in order
+ * and terminated with an empty final block, which gives a single valid
+ * DEFLATE stream.
+ *
+ * Optionally, the compression of each chunk is primed with the data
+ * preceding it as a preset dictionary, which keeps the compression ratio
+ * close to the one of a single stream.
+ *
+ * The sequence of calls is:
+ *  - rte_compressdev_chunk_ctx_create(), once the device is started;
+ *  - rte_compressdev_chunk_start() to submit a buffer;
+ *  - rte_compressdev_chunk_process() on each queue pair, concurrently
+ *    from different lcores, each call returning once no chunk is left;
+ *  - rte_compressdev_chunk_finish() once all the calls have returned.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+
+#include "rte_comp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum size of a chunk, so that its output fits in a single mbuf */
+#define RTE_COMPRESSDEV_CHUNK_SZ_MAX	(56 * 1024)
+
+/** Configuration of a chunked compression context */
+struct rte_compressdev_chunk_conf {
+	uint8_t dev_id;
+	/**< Compression device identifier, configured and started */
+	uint16_t nb_qps;
+	/**< Number of queue pairs used, from queue pair 0 */
+	uint16_t depth;
+	/**< Maximum number of chunks in flight per queue pair */
+	uint32_t chunk_sz;
+	/**< Size of a chunk, up to RTE_COMPRESSDEV_CHUNK_SZ_MAX */
+	uint32_t dict_sz;
+	/**< Size of the data preceding a chunk used as its preset dictionary,
+	 * 0 to compress the chunks independently. It requires
+	 * RTE_COMP_FF_PRESET_DICT.
+	 */
+	const struct rte_comp_xform *xform;
+	/**< DEFLATE compression xform, without checksum */
+	int socket_id;
+	/**< Socket on which the resources are allocated */
+};
+
+/** Chunked compression context */
+struct rte_compressdev_chunk_ctx;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Create a chunked compression context.
+ *
+ * One stream is created per chunk in flight, so the device must be
+ * configured with at least *nb_qps* x *depth* streams, and the queue pairs
+ * with at least *depth* descriptors.
+ *
+ * @param conf
+ *   The context configuration.
+ * @return
+ *  - The context, to be freed with rte_compressdev_chunk_ctx_free().
+ *  - NULL on error, with rte_errno set:
+ *    - EINVAL if the configuration is invalid.
+ *    - ENOTSUP if the device does not support stateful compression,
+ *      or preset dictionaries when *dict_sz* is not 0.
+ *    - ENOMEM if the resources cannot be allocated.
+ */
+__rte_experimental
+struct rte_compressdev_chunk_ctx *
+rte_compressdev_chunk_ctx_create(const struct rte_compressdev_chunk_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Free a chunked compression context.
+ *
+ * @param ctx
+ *   The context, may be NULL.
+ */
+__rte_experimental
+void
+rte_compressdev_chunk_ctx_free(struct rte_compressdev_chunk_ctx *ctx);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Submit a buffer to compress.
+ *
+ * The buffer must not be modified until rte_compressdev_chunk_finish()
+ * returns.
+ *
+ * @param ctx
+ *   The context, with no buffer in progress.
+ * @param src
+ *   The buffer to compress.
+ * @param src_len
+ *   The size of the buffer.
+ * @return
+ *  - 0 on success.
+ *  - -EINVAL if a parameter is invalid.
+ *  - -ENOMEM if the output buffer cannot be allocated.
+ */
+__rte_experimental
+int
+rte_compressdev_chunk_start(struct rte_compressdev_chunk_ctx *ctx,
+		const uint8_t *src, size_t src_len);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Compress the chunks of the current buffer on a queue pair, until no
+ * chunk is left to compress.
+ *
+ * It may be called concurrently on different queue pairs. A queue pair
+ * must not be used by another thread during the call.
+ *
+ * @param ctx
+ *   The context.
+ * @param qp_id
+ *   The queue pair index, lower than the number of queue pairs of the
+ *   context.
+ * @return
+ *  - The number of chunks compressed on the queue pair, on success.
+ *  - -EINVAL if a parameter is invalid.
+ *  - -EIO if the compression of a chunk failed.
+ */
+__rte_experimental
+int
+rte_compressdev_chunk_process(struct rte_compressdev_chunk_ctx *ctx,
+		uint16_t qp_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Write the DEFLATE stream of the current buffer, once all the calls to
+ * rte_compressdev_chunk_process() have returned.
+ *
+ * The buffer is released on success, or when the compression failed.
+ *
+ * @param ctx
+ *   The context.
+ * @param dst
+ *   The output buffer.
+ * @param[in,out] dst_len
+ *   The size of the output buffer, updated with the size of the stream.
+ * @return
+ *  - 0 on success.
+ *  - -EINVAL if a parameter is invalid, or if chunks are not compressed.
+ *  - -EIO if the compression of a chunk failed.
+ *  - -ENOSPC if the output buffer is too small, *dst_len* is updated
+ *    with the size needed.
+ */
+__rte_experimental
+int
+rte_compressdev_chunk_finish(struct rte_compressdev_chunk_ctx *ctx,
+		uint8_t *dst, size_t *dst_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_COMPRESSDEV_CHUNK_H_ */
@@ -245,6 +245,26 @@ typedef int (*compressdev_private_xform_create_t)(struct rte_compressdev *dev,
 typedef int (*compressdev_private_xform_free_t)(struct rte_compressdev *dev,
 		void *private_xform);
 
+/**
+ * Set the preset dictionary of driver private_xform or stream data.
+ *
+ * @param dev
+ *   Compressdev device
+ * @param priv
+ *   handle of pmd's private_xform or stream data
+ * @param dict
+ *   dictionary data, NULL to remove the dictionary
+ * @param dict_len
+ *   dictionary length
+ * @return
+ *  - 0 if successful
+ *  - <0 in error cases
+ *  - Returns -EINVAL if input parameters are invalid.
+ *  - Returns -ENOMEM if the dictionary could not be allocated.
+ */
+typedef int (*compressdev_dict_set_t)(struct rte_compressdev *dev,
+		void *priv, const uint8_t *dict, uint32_t dict_len);
+
 /** comp device operations function pointer table */
 struct rte_compressdev_ops {
 	compressdev_configure_t dev_configure;	/**< Configure device. */
@@ -273,6 +293,11 @@ struct rte_compressdev_ops {
 	/**< Create a comp private_xform and initialise its private data. */
 	compressdev_private_xform_free_t private_xform_free;
 	/**< Free a comp private_xform's data. */
+
+	compressdev_dict_set_t private_xform_dict_set;
+	/**< Set the preset dictionary of a comp private_xform. */
+	compressdev_dict_set_t stream_dict_set;
+	/**< Set the preset dictionary of a comp stream. */
 };
 
 /**
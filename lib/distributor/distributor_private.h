@@ -59,16 +59,22 @@ union __rte_cache_aligned rte_distributor_buffer_single {
 };
 
 /*
- * Transfer up to 8 mbufs at a time to/from workers, and
+ * Transfer up to 8 mbufs at a time to/from workers by default, and
  * flow matching algorithm optimized for 8 flow IDs at a time
  */
 #define RTE_DIST_BURST_SIZE 8
 
+/*
+ * Largest number of mbufs that can be transferred to/from a worker
+ * in one handshake, see rte_distributor_params::burst_size.
+ */
+#define RTE_DIST_BURST_SIZE_MAX 32
+
 struct __rte_cache_aligned rte_distributor_backlog {
 	unsigned int start;
 	unsigned int count;
-	alignas(RTE_CACHE_LINE_SIZE) int64_t pkts[RTE_DIST_BURST_SIZE];
-	uint16_t *tags; /* will point to second cacheline of inflights */
+	alignas(RTE_CACHE_LINE_SIZE) int64_t pkts[RTE_DIST_BURST_SIZE_MAX];
+	uint16_t *tags; /* will point to the backlog half of inflights */
 };
 
 
@@ -103,6 +109,8 @@ struct rte_distributor_single {
 enum rte_distributor_match_function {
 	RTE_DIST_MATCH_SCALAR = 0,
 	RTE_DIST_MATCH_VECTOR,
+	RTE_DIST_MATCH_AVX2,
+	RTE_DIST_MATCH_AVX512,
 	RTE_DIST_NUM_MATCH_FNS
 };
 
@@ -111,16 +119,17 @@ enum rte_distributor_match_function {
  * line aligned, but to improve performance and prevent adjacent cache-line
  * prefetches of buffers for other workers, e.g. when worker 1's buffer is on
  * the next cache line to worker 0, we pad this out to two cache lines.
- * We can pass up to 8 mbufs at a time in one cacheline.
- * There is a separate cacheline for returns in the burst API.
+ * We can pass up to 8 mbufs at a time in one cacheline, larger bursts
+ * span several consecutive cachelines.
+ * There is a separate set of cachelines for returns in the burst API.
  */
 struct rte_distributor_buffer {
-	volatile alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int64_t) bufptr64[RTE_DIST_BURST_SIZE];
+	volatile alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int64_t) bufptr64[RTE_DIST_BURST_SIZE_MAX];
 		/* <= outgoing to worker */
 
 	alignas(RTE_CACHE_LINE_SIZE) int64_t pad1;    /* <= one cache line  */
 
-	volatile alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int64_t) retptr64[RTE_DIST_BURST_SIZE];
+	volatile alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int64_t) retptr64[RTE_DIST_BURST_SIZE_MAX];
 		/* <= incoming from worker */
 
 	alignas(RTE_CACHE_LINE_SIZE) int64_t pad2;    /* <= one cache line  */
@@ -134,14 +143,17 @@ struct rte_distributor {
 	char name[RTE_DISTRIBUTOR_NAMESIZE];  /**< Name of the ring. */
 	unsigned int num_workers;             /**< Number of workers polling */
 	unsigned int alg_type;                /**< Number of alg types */
+	unsigned int burst_size;              /**< Max mbufs per handshake */
+	unsigned int next_wkr;                /**< Next worker for new flows */
+	uint64_t flags;                       /**< RTE_DISTRIBUTOR_F_* flags */
 
 	/**>
-	 * First cache line in the this array are the tags inflight
-	 * on the worker core. Second cache line are the backlog
-	 * that are going to go to the worker core.
+	 * First burst_size entries of each row are the tags inflight
+	 * on the worker core. The following burst_size entries are the
+	 * backlog that are going to go to the worker core.
 	 */
 	alignas(RTE_CACHE_LINE_SIZE) uint16_t
-		in_flight_tags[RTE_DISTRIB_MAX_WORKERS][RTE_DIST_BURST_SIZE*2];
+		in_flight_tags[RTE_DISTRIB_MAX_WORKERS][RTE_DIST_BURST_SIZE_MAX*2];
 
 	alignas(RTE_CACHE_LINE_SIZE) struct rte_distributor_backlog
 		backlog[RTE_DISTRIB_MAX_WORKERS];
@@ -156,6 +168,15 @@ struct rte_distributor {
 
 	uint8_t active[RTE_DISTRIB_MAX_WORKERS];
 	uint8_t activesum;
+
+	/* Fields below are used with RTE_DISTRIBUTOR_F_ORDERED only. */
+	int seqn_offset;          /**< Offset of the sequence mbuf dynfield */
+	uint32_t order_size;      /**< Number of entries in order_win */
+	uint32_t order_mask;      /**< order_size - 1 */
+	uint32_t next_seqn;       /**< Sequence number of next incoming mbuf */
+	uint32_t head_seqn;       /**< Sequence number of next returned mbuf */
+	uint32_t skip_seqn;       /**< Missing mbufs before it are skipped */
+	struct rte_mbuf **order_win; /**< Returned mbufs by sequence number */
 };
 
 void
@@ -168,4 +189,14 @@ find_match_vec(struct rte_distributor *d,
 			uint16_t *data_ptr,
 			uint16_t *output_ptr);
 
+void
+find_match_avx2(struct rte_distributor *d,
+			uint16_t *data_ptr,
+			uint16_t *output_ptr);
+
+void
+find_match_avx512(struct rte_distributor *d,
+			uint16_t *data_ptr,
+			uint16_t *output_ptr);
+
 #endif /* _DIST_PRIV_H_ */
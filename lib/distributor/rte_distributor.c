@@ -8,7 +8,10 @@
 #include <sys/queue.h>
 #include <string.h>
 #include <eal_export.h>
+#include <rte_common.h>
+#include <rte_cpuflags.h>
 #include <rte_mbuf.h>
+#include <rte_mbuf_dyn.h>
 #include <rte_cycles.h>
 #include <rte_memzone.h>
 #include <rte_errno.h>
@@ -16,6 +19,7 @@
 #include <rte_eal_memconfig.h>
 #include <rte_pause.h>
 #include <rte_tailq.h>
+#include <rte_vect.h>
 
 #include "rte_distributor.h"
 #include "rte_distributor_single.h"
@@ -28,6 +32,16 @@ static struct rte_tailq_elem rte_dist_burst_tailq = {
 };
 EAL_REGISTER_TAILQ(rte_dist_burst_tailq)
 
+/* Sequence number stored in mbufs when RTE_DISTRIBUTOR_F_ORDERED is set. */
+typedef uint32_t rte_distributor_seqn_t;
+
+static inline rte_distributor_seqn_t *
+distributor_seqn(const struct rte_distributor *d, struct rte_mbuf *mbuf)
+{
+	return RTE_MBUF_DYNFIELD(mbuf, d->seqn_offset,
+			rte_distributor_seqn_t *);
+}
+
 /**** APIs called by workers ****/
 
 /**** Burst Packet APIs called by workers ****/
@@ -67,7 +81,7 @@ rte_distributor_request_pkt(struct rte_distributor *d,
 	 * handshake bits. Populate the retptrs with returning packets.
 	 */
 
-	for (i = count; i < RTE_DIST_BURST_SIZE; i++)
+	for (i = count; i < d->burst_size; i++)
 		buf->retptr64[i] = 0;
 
 	/* Set VALID_BUF bit for each packet returned */
@@ -111,7 +125,7 @@ rte_distributor_poll_pkt(struct rte_distributor *d,
 		return -1;
 
 	/* since bufptr64 is signed, this should be an arithmetic shift */
-	for (i = 0; i < RTE_DIST_BURST_SIZE; i++) {
+	for (i = 0; i < d->burst_size; i++) {
 		if (likely(buf->bufptr64[i] & RTE_DISTRIB_VALID_BUF)) {
 			ret = buf->bufptr64[i] >> RTE_DISTRIB_FLAG_BITS;
 			pkts[count++] = (struct rte_mbuf *)((uintptr_t)(ret));
@@ -194,7 +208,7 @@ rte_distributor_return_pkt(struct rte_distributor *d,
 
 	/* Sync with distributor to acquire retptrs */
 	rte_atomic_thread_fence(rte_memory_order_acquire);
-	for (i = 0; i < RTE_DIST_BURST_SIZE; i++)
+	for (i = 0; i < d->burst_size; i++)
 		/* Switch off the return bit first */
 		buf->retptr64[i] = 0;
 
@@ -235,6 +249,29 @@ store_return(uintptr_t oldbuf, struct rte_distributor *d,
 	*ret_count += (*ret_count != RTE_DISTRIB_RETURNS_MASK);
 }
 
+/*
+ * stores a packet returned from a worker in the reorder window, at the
+ * position given by its sequence number. Packets with a sequence number
+ * outside of the window, e.g. skipped by a flush, go to the returns array.
+ */
+static inline void
+store_return_ordered(uintptr_t oldbuf, struct rte_distributor *d,
+		unsigned int *ret_start, unsigned int *ret_count)
+{
+	struct rte_mbuf *mbuf = (struct rte_mbuf *)oldbuf;
+	uint32_t seqn;
+
+	if (!oldbuf)
+		return;
+
+	seqn = *distributor_seqn(d, mbuf);
+	if (likely(seqn - d->head_seqn < d->next_seqn - d->head_seqn &&
+			d->order_win[seqn & d->order_mask] == NULL))
+		d->order_win[seqn & d->order_mask] = mbuf;
+	else
+		store_return(oldbuf, d, ret_start, ret_count);
+}
+
 /*
  * Match then flow_ids (tags) of the incoming packets to the flow_ids
  * of the inflight packets (both inflight on the workers and in each worker
@@ -264,13 +301,13 @@ find_match_scalar(struct rte_distributor *d,
 		bl = &d->backlog[i];
 
 		for (j = 0; j < RTE_DIST_BURST_SIZE ; j++)
-			for (w = 0; w < RTE_DIST_BURST_SIZE; w++)
+			for (w = 0; w < d->burst_size; w++)
 				if (d->in_flight_tags[i][w] == data_ptr[j]) {
 					output_ptr[j] = i+1;
 					break;
 				}
 		for (j = 0; j < RTE_DIST_BURST_SIZE; j++)
-			for (w = 0; w < RTE_DIST_BURST_SIZE; w++)
+			for (w = 0; w < d->burst_size; w++)
 				if (bl->tags[w] == data_ptr[j]) {
 					output_ptr[j] = i+1;
 					break;
@@ -290,12 +327,16 @@ find_match_scalar(struct rte_distributor *d,
  * distributor must retrieve both inflight and backlog packets assigned
  * to the worker and reprocess them to another worker.
  */
+static int
+distributor_process(struct rte_distributor *d,
+		struct rte_mbuf **mbufs, unsigned int num_mbufs);
+
 static void
 handle_worker_shutdown(struct rte_distributor *d, unsigned int wkr)
 {
 	struct rte_distributor_buffer *buf = &(d->bufs[wkr]);
 	/* double BURST size for storing both inflights and backlog */
-	struct rte_mbuf *pkts[RTE_DIST_BURST_SIZE * 2];
+	struct rte_mbuf *pkts[RTE_DIST_BURST_SIZE_MAX * 2];
 	unsigned int pkts_count = 0;
 	unsigned int i;
 
@@ -305,7 +346,7 @@ handle_worker_shutdown(struct rte_distributor *d, unsigned int wkr)
 	 */
 	if (!(rte_atomic_load_explicit(&(buf->bufptr64[0]), rte_memory_order_acquire)
 		& RTE_DISTRIB_GET_BUF))
-		for (i = 0; i < RTE_DIST_BURST_SIZE; i++)
+		for (i = 0; i < d->burst_size; i++)
 			if (buf->bufptr64[i] & RTE_DISTRIB_VALID_BUF)
 				pkts[pkts_count++] = (void *)((uintptr_t)
 					(buf->bufptr64[i]
@@ -327,14 +368,14 @@ handle_worker_shutdown(struct rte_distributor *d, unsigned int wkr)
 	d->backlog[wkr].count = 0;
 
 	/* Clear both inflight and backlog tags */
-	for (i = 0; i < RTE_DIST_BURST_SIZE; i++) {
+	for (i = 0; i < d->burst_size; i++) {
 		d->in_flight_tags[wkr][i] = 0;
 		d->backlog[wkr].tags[i] = 0;
 	}
 
-	/* Recursive call */
+	/* Recursive call, packets keep their sequence number if any */
 	if (pkts_count > 0)
-		rte_distributor_process(d, pkts, pkts_count);
+		distributor_process(d, pkts, pkts_count);
 }
 
 
@@ -356,12 +397,17 @@ handle_returns(struct rte_distributor *d, unsigned int wkr)
 	/* Sync on GET_BUF flag. Acquire retptrs. */
 	if (rte_atomic_load_explicit(&(buf->retptr64[0]), rte_memory_order_acquire)
 		& (RTE_DISTRIB_GET_BUF | RTE_DISTRIB_RETURN_BUF)) {
-		for (i = 0; i < RTE_DIST_BURST_SIZE; i++) {
+		for (i = 0; i < d->burst_size; i++) {
 			if (buf->retptr64[i] & RTE_DISTRIB_VALID_BUF) {
 				oldbuf = ((uintptr_t)(buf->retptr64[i] >>
 					RTE_DISTRIB_FLAG_BITS));
 				/* store returns in a circular buffer */
-				store_return(oldbuf, d, &ret_start, &ret_count);
+				if (d->flags & RTE_DISTRIBUTOR_F_ORDERED)
+					store_return_ordered(oldbuf, d,
+						&ret_start, &ret_count);
+				else
+					store_return(oldbuf, d, &ret_start,
+						&ret_count);
 				count++;
 				buf->retptr64[i] &= ~RTE_DISTRIB_VALID_BUF;
 			}
@@ -426,7 +472,7 @@ release(struct rte_distributor *d, unsigned int wkr)
 		d->in_flight_tags[wkr][i] = d->backlog[wkr].tags[i];
 	}
 	buf->count = i;
-	for ( ; i < RTE_DIST_BURST_SIZE ; i++) {
+	for ( ; i < d->burst_size ; i++) {
 		buf->bufptr64[i] = RTE_DISTRIB_GET_BUF;
 		d->in_flight_tags[wkr][i] = 0;
 	}
@@ -444,25 +490,18 @@ release(struct rte_distributor *d, unsigned int wkr)
 
 
 /* process a set of packets to distribute them to workers */
-RTE_EXPORT_SYMBOL(rte_distributor_process)
-int
-rte_distributor_process(struct rte_distributor *d,
+static int
+distributor_process(struct rte_distributor *d,
 		struct rte_mbuf **mbufs, unsigned int num_mbufs)
 {
 	unsigned int next_idx = 0;
-	static unsigned int wkr;
+	unsigned int wkr = d->next_wkr;
 	struct rte_mbuf *next_mb = NULL;
 	int64_t next_value = 0;
 	uint16_t new_tag = 0;
 	alignas(RTE_CACHE_LINE_SIZE) uint16_t flows[RTE_DIST_BURST_SIZE];
 	unsigned int i, j, w, wid, matching_required;
 
-	if (d->alg_type == RTE_DIST_ALG_SINGLE) {
-		/* Call the old API */
-		return rte_distributor_process_single(d->d_single,
-			mbufs, num_mbufs);
-	}
-
 	for (wid = 0 ; wid < d->num_workers; wid++)
 		handle_returns(d, wid);
 
@@ -505,8 +544,10 @@ rte_distributor_process(struct rte_distributor *d,
 		matching_required = 1;
 
 		for (j = 0; j < pkts; j++) {
-			if (unlikely(!d->activesum))
+			if (unlikely(!d->activesum)) {
+				d->next_wkr = wkr;
 				return next_idx;
+			}
 
 			if (unlikely(matching_required)) {
 				switch (d->dist_match_fn) {
@@ -514,6 +555,18 @@ rte_distributor_process(struct rte_distributor *d,
 					find_match_vec(d, &flows[0],
 						&matches[0]);
 					break;
+#if defined(RTE_ARCH_X86)
+				case RTE_DIST_MATCH_AVX2:
+					find_match_avx2(d, &flows[0],
+						&matches[0]);
+					break;
+#ifdef CC_AVX512_SUPPORT
+				case RTE_DIST_MATCH_AVX512:
+					find_match_avx512(d, &flows[0],
+						&matches[0]);
+					break;
+#endif
+#endif
 				default:
 					find_match_scalar(d, &flows[0],
 						&matches[0]);
@@ -549,7 +602,7 @@ rte_distributor_process(struct rte_distributor *d,
 				struct rte_distributor_backlog *bl =
 						&d->backlog[matches[j]-1];
 				if (unlikely(bl->count ==
-						RTE_DIST_BURST_SIZE)) {
+						d->burst_size)) {
 					release(d, matches[j]-1);
 					if (!d->active[matches[j]-1]) {
 						j--;
@@ -573,7 +626,7 @@ rte_distributor_process(struct rte_distributor *d,
 				bl = &d->backlog[wkr];
 
 				if (unlikely(bl->count ==
-						RTE_DIST_BURST_SIZE)) {
+						d->burst_size)) {
 					release(d, wkr);
 					if (!d->active[wkr]) {
 						j--;
@@ -601,6 +654,7 @@ rte_distributor_process(struct rte_distributor *d,
 		}
 		wkr = (wkr + 1) % d->num_workers;
 	}
+	d->next_wkr = wkr;
 
 	/* Flush out all non-full cache-lines to workers. */
 	for (wid = 0 ; wid < d->num_workers; wid++)
@@ -614,6 +668,77 @@ rte_distributor_process(struct rte_distributor *d,
 	return num_mbufs;
 }
 
+RTE_EXPORT_SYMBOL(rte_distributor_process)
+int
+rte_distributor_process(struct rte_distributor *d,
+		struct rte_mbuf **mbufs, unsigned int num_mbufs)
+{
+	unsigned int i;
+	int processed;
+
+	if (d->alg_type == RTE_DIST_ALG_SINGLE) {
+		/* Call the old API */
+		return rte_distributor_process_single(d->d_single,
+			mbufs, num_mbufs);
+	}
+
+	if (!(d->flags & RTE_DISTRIBUTOR_F_ORDERED))
+		return distributor_process(d, mbufs, num_mbufs);
+
+	/*
+	 * Do not accept more packets than the reorder window can hold,
+	 * including the ones not yet retrieved by the application.
+	 */
+	num_mbufs = RTE_MIN(num_mbufs,
+			d->order_size - (d->next_seqn - d->head_seqn));
+	for (i = 0; i < num_mbufs; i++)
+		*distributor_seqn(d, mbufs[i]) = d->next_seqn + i;
+	d->next_seqn += num_mbufs;
+
+	processed = distributor_process(d, mbufs, num_mbufs);
+
+	/* Give back the sequence numbers of the packets not processed. */
+	d->next_seqn -= num_mbufs - processed;
+
+	return processed;
+}
+
+/*
+ * return to the caller, in sequence order, packets returned from workers.
+ * The run stops at the first packet not yet returned, unless it was
+ * skipped by a flush. Packets from the returns array come last.
+ */
+static unsigned int
+returned_pkts_ordered(struct rte_distributor *d,
+		struct rte_mbuf **mbufs, unsigned int max_mbufs)
+{
+	struct rte_distributor_returned_pkts *returns = &d->returns;
+	struct rte_mbuf *mbuf;
+	unsigned int i = 0, nb;
+
+	while (i < max_mbufs && d->head_seqn != d->next_seqn) {
+		mbuf = d->order_win[d->head_seqn & d->order_mask];
+		if (mbuf == NULL) {
+			if ((int32_t)(d->skip_seqn - d->head_seqn) <= 0)
+				break;
+		} else {
+			d->order_win[d->head_seqn & d->order_mask] = NULL;
+			mbufs[i++] = mbuf;
+		}
+		d->head_seqn++;
+	}
+
+	nb = RTE_MIN(max_mbufs - i, returns->count);
+	for (; nb > 0; nb--) {
+		mbufs[i++] = returns->mbufs[returns->start &
+				RTE_DISTRIB_RETURNS_MASK];
+		returns->start++;
+		returns->count--;
+	}
+
+	return i;
+}
+
 /* return to the caller, packets returned from workers */
 RTE_EXPORT_SYMBOL(rte_distributor_returned_pkts)
 int
@@ -631,6 +756,9 @@ rte_distributor_returned_pkts(struct rte_distributor *d,
 				mbufs, max_mbufs);
 	}
 
+	if (d->flags & RTE_DISTRIBUTOR_F_ORDERED)
+		return returned_pkts_ordered(d, mbufs, max_mbufs);
+
 	for (i = 0; i < retval; i++) {
 		unsigned int idx = (returns->start + i) &
 				RTE_DISTRIB_RETURNS_MASK;
@@ -691,6 +819,9 @@ rte_distributor_flush(struct rte_distributor *d)
 	for (wkr = 0; wkr < d->num_workers; wkr++)
 		handle_returns(d, wkr);
 
+	/* Do not wait any longer for packets not returned by workers */
+	d->skip_seqn = d->next_seqn;
+
 	return flushed;
 }
 
@@ -714,20 +845,45 @@ rte_distributor_clear_returns(struct rte_distributor *d)
 				rte_memory_order_release);
 
 	d->returns.start = d->returns.count = 0;
+
+	if (d->flags & RTE_DISTRIBUTOR_F_ORDERED) {
+		memset(d->order_win, 0, d->order_size * sizeof(d->order_win[0]));
+		d->head_seqn = d->skip_seqn = d->next_seqn;
+	}
 }
 
+#if defined(RTE_ARCH_X86) && defined(CC_AVX512_SUPPORT)
+/*
+ * The AVX512 match is built with the AVX512 march flags,
+ * so all the extensions they enable must be available.
+ */
+static int
+distributor_check_avx512_cpu_flags(void)
+{
+	return rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512CD) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512DQ) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512VL) == 1;
+}
+#endif
+
 /* creates a distributor instance */
-RTE_EXPORT_SYMBOL(rte_distributor_create)
-struct rte_distributor *
-rte_distributor_create(const char *name,
-		unsigned int socket_id,
-		unsigned int num_workers,
-		unsigned int alg_type)
+static struct rte_distributor *
+distributor_create(const struct rte_distributor_params *params)
 {
+	static const struct rte_mbuf_dynfield seqn_dynfield_desc = {
+		.name = "rte_distributor_dynfield_seqn",
+		.size = sizeof(rte_distributor_seqn_t),
+		.align = alignof(rte_distributor_seqn_t),
+	};
 	struct rte_distributor *d;
 	struct rte_dist_burst_list *dist_burst_list;
 	char mz_name[RTE_MEMZONE_NAMESIZE];
 	const struct rte_memzone *mz;
+	unsigned int burst_size = params->burst_size;
+	uint32_t order_size = 0;
+	int seqn_offset = -1;
 	unsigned int i;
 
 	/* TODO Reorganise function properly around RTE_DIST_ALG_SINGLE/BURST */
@@ -736,57 +892,106 @@ rte_distributor_create(const char *name,
 	RTE_BUILD_BUG_ON((sizeof(*d) & RTE_CACHE_LINE_MASK) != 0);
 	RTE_BUILD_BUG_ON((RTE_DISTRIB_MAX_WORKERS & 7) != 0);
 
-	if (name == NULL || num_workers >=
-		(unsigned int)RTE_MIN(RTE_DISTRIB_MAX_WORKERS, RTE_MAX_LCORE)) {
+	if (burst_size == 0)
+		burst_size = RTE_DIST_BURST_SIZE;
+
+	if (params->name == NULL || params->num_workers >=
+		(unsigned int)RTE_MIN(RTE_DISTRIB_MAX_WORKERS, RTE_MAX_LCORE) ||
+		params->alg_type >= RTE_DIST_NUM_ALG_TYPES ||
+		(burst_size != 8 && burst_size != 16 && burst_size != 32) ||
+		(params->flags & ~RTE_DISTRIBUTOR_F_ORDERED) != 0) {
 		rte_errno = EINVAL;
 		return NULL;
 	}
 
-	if (alg_type == RTE_DIST_ALG_SINGLE) {
+	if (params->alg_type == RTE_DIST_ALG_SINGLE) {
+		if (burst_size != RTE_DIST_BURST_SIZE || params->flags != 0) {
+			rte_errno = EINVAL;
+			return NULL;
+		}
 		d = malloc(sizeof(struct rte_distributor));
 		if (d == NULL) {
 			rte_errno = ENOMEM;
 			return NULL;
 		}
-		d->d_single = rte_distributor_create_single(name,
-				socket_id, num_workers);
+		d->d_single = rte_distributor_create_single(params->name,
+				params->socket_id, params->num_workers);
 		if (d->d_single == NULL) {
 			free(d);
 			/* rte_errno will have been set */
 			return NULL;
 		}
-		d->alg_type = alg_type;
+		d->alg_type = params->alg_type;
 		return d;
 	}
 
-	snprintf(mz_name, sizeof(mz_name), RTE_DISTRIB_PREFIX"%s", name);
-	mz = rte_memzone_reserve(mz_name, sizeof(*d), socket_id, NO_FLAGS);
+	if (params->flags & RTE_DISTRIBUTOR_F_ORDERED) {
+		seqn_offset = rte_mbuf_dynfield_register(&seqn_dynfield_desc);
+		if (seqn_offset < 0)
+			return NULL;
+		/*
+		 * The window holds all packets which can be in flight or in
+		 * a backlog, and the same amount waiting to be retrieved.
+		 */
+		order_size = rte_align32pow2(params->num_workers *
+				burst_size * 4);
+	}
+
+	snprintf(mz_name, sizeof(mz_name), RTE_DISTRIB_PREFIX"%s",
+			params->name);
+	mz = rte_memzone_reserve(mz_name,
+			sizeof(*d) + order_size * sizeof(struct rte_mbuf *),
+			params->socket_id, NO_FLAGS);
 	if (mz == NULL) {
 		rte_errno = ENOMEM;
 		return NULL;
 	}
 
 	d = mz->addr;
-	strlcpy(d->name, name, sizeof(d->name));
-	d->num_workers = num_workers;
-	d->alg_type = alg_type;
+	strlcpy(d->name, params->name, sizeof(d->name));
+	d->num_workers = params->num_workers;
+	d->alg_type = params->alg_type;
+	d->burst_size = burst_size;
+	d->next_wkr = 0;
+	d->flags = params->flags;
 
 	d->dist_match_fn = RTE_DIST_MATCH_SCALAR;
 #if defined(RTE_ARCH_X86)
 	if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_128)
 		d->dist_match_fn = RTE_DIST_MATCH_VECTOR;
+	if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_256 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2))
+		d->dist_match_fn = RTE_DIST_MATCH_AVX2;
+#ifdef CC_AVX512_SUPPORT
+	if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512 &&
+			distributor_check_avx512_cpu_flags())
+		d->dist_match_fn = RTE_DIST_MATCH_AVX512;
+#endif
 #endif
 
 	/*
-	 * Set up the backlog tags so they're pointing at the second cache
-	 * line for performance during flow matching
+	 * Set up the backlog tags so they're following the inflight tags,
+	 * for performance during flow matching
 	 */
-	for (i = 0 ; i < num_workers ; i++)
-		d->backlog[i].tags = &d->in_flight_tags[i][RTE_DIST_BURST_SIZE];
+	memset(d->in_flight_tags, 0, sizeof(d->in_flight_tags));
+	for (i = 0 ; i < params->num_workers ; i++)
+		d->backlog[i].tags = &d->in_flight_tags[i][burst_size];
 
 	memset(d->active, 0, sizeof(d->active));
 	d->activesum = 0;
 
+	d->seqn_offset = seqn_offset;
+	d->order_size = order_size;
+	d->order_mask = order_size - 1;
+	d->next_seqn = 0;
+	d->head_seqn = 0;
+	d->skip_seqn = 0;
+	d->order_win = NULL;
+	if (order_size != 0) {
+		d->order_win = (struct rte_mbuf **)(d + 1);
+		memset(d->order_win, 0, order_size * sizeof(d->order_win[0]));
+	}
+
 	dist_burst_list = RTE_TAILQ_CAST(rte_dist_burst_tailq.head,
 					  rte_dist_burst_list);
 
@@ -797,3 +1002,33 @@ rte_distributor_create(const char *name,
 
 	return d;
 }
+
+RTE_EXPORT_SYMBOL(rte_distributor_create)
+struct rte_distributor *
+rte_distributor_create(const char *name,
+		unsigned int socket_id,
+		unsigned int num_workers,
+		unsigned int alg_type)
+{
+	struct rte_distributor_params params = {
+		.name = name,
+		.socket_id = socket_id,
+		.num_workers = num_workers,
+		.alg_type = alg_type,
+		.burst_size = RTE_DIST_BURST_SIZE,
+	};
+
+	return distributor_create(&params);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_distributor_create_with_params, 25.07)
+struct rte_distributor *
+rte_distributor_create_with_params(const struct rte_distributor_params *params)
+{
+	if (params == NULL) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	return distributor_create(params);
+}
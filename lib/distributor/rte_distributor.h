@@ -13,6 +13,11 @@
  * one-at-a-time to workers, with dynamic load balancing.
  */
 
+#include <stdint.h>
+
+#include <rte_bitops.h>
+#include <rte_compat.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -52,6 +57,64 @@ rte_distributor_create(const char *name, unsigned int socket_id,
 		unsigned int num_workers,
 		unsigned int alg_type);
 
+/**
+ * Return packets from rte_distributor_returned_pkts() in the order they
+ * were passed to rte_distributor_process(), across all flows.
+ * Only supported with RTE_DIST_ALG_BURST.
+ */
+#define RTE_DISTRIBUTOR_F_ORDERED RTE_BIT64(0)
+
+/**
+ * Parameters used when creating a distributor instance with
+ * rte_distributor_create_with_params().
+ */
+struct rte_distributor_params {
+	const char *name;         /**< Name of the distributor instance. */
+	int socket_id;            /**< NUMA node to allocate memory from. */
+	unsigned int num_workers; /**< Maximum number of workers. */
+	unsigned int alg_type;    /**< Distribution algorithm, see rte_distributor_alg_type. */
+	/**
+	 * Maximum number of mbufs passed to or returned by a worker in one
+	 * call: 8, 16 or 32, 0 selects the default of 8.
+	 * Only supported with RTE_DIST_ALG_BURST.
+	 * Larger bursts reduce the number of cache line handshakes per mbuf
+	 * at the cost of a coarser load balancing.
+	 */
+	unsigned int burst_size;
+	uint64_t flags;           /**< Bitmask of RTE_DISTRIBUTOR_F_* flags. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Function to create a new distributor instance with extended parameters.
+ *
+ * Several distributor instances may be used on different lcores at the same
+ * time, each of them having its own distributor lcore. A worker lcore may
+ * serve several instances, using its own worker id in each of them.
+ * Flow affinity is kept as long as all the packets of a flow are given to
+ * the same instance, e.g. by assigning each instance a set of RSS queues.
+ *
+ * With RTE_DISTRIBUTOR_F_ORDERED, the distributor stores a sequence number
+ * in a mbuf dynamic field of each packet given to rte_distributor_process(),
+ * and workers must return the same mbufs they received.
+ * rte_distributor_process() may then accept fewer packets than requested,
+ * until returned packets are retrieved with rte_distributor_returned_pkts().
+ * Packets not returned by the workers are skipped by rte_distributor_flush().
+ *
+ * @param params
+ *   Parameters of the distributor instance.
+ * @return
+ *   The newly created distributor instance, NULL on error with rte_errno set:
+ *   - EINVAL - invalid parameters
+ *   - ENOMEM - no appropriate memory area found
+ *   - other values from rte_mbuf_dynfield_register()
+ */
+__rte_experimental
+struct rte_distributor *
+rte_distributor_create_with_params(const struct rte_distributor_params *params);
+
 /*  *** APIS to be called on the distributor lcore ***  */
 /*
  * The following APIs are the public APIs which are designed for use on a
@@ -82,7 +145,9 @@ rte_distributor_create(const char *name, unsigned int socket_id,
  * @param num_mbufs
  *   The number of mbufs in the mbufs array
  * @return
- *   The number of mbufs processed.
+ *   The number of mbufs processed. It may be lower than num_mbufs when the
+ *   distributor was created with RTE_DISTRIBUTOR_F_ORDERED, the remaining
+ *   mbufs should be given again after retrieving the returned packets.
  */
 int
 rte_distributor_process(struct rte_distributor *d,
@@ -153,7 +218,8 @@ rte_distributor_clear_returns(struct rte_distributor *d);
  *   The worker instance number to use - must be less that num_workers passed
  *   at distributor creation time.
  * @param pkts
- *   The mbufs pointer array to be filled in (up to 8 packets)
+ *   The mbufs pointer array to be filled in (up to 8 packets, or the
+ *   burst size given at distributor creation time)
  * @param oldpkt
  *   The previous packets, if any, being processed by the worker
  * @param retcount
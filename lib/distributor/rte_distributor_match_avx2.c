@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <rte_mbuf.h>
+#include <rte_vect.h>
+
+#include "distributor_private.h"
+
+void
+find_match_avx2(struct rte_distributor *d,
+			uint16_t *data_ptr,
+			uint16_t *output_ptr)
+{
+	__m256i incoming_fids[RTE_DIST_BURST_SIZE];
+	__m256i tags;
+	const unsigned int nb_tags = d->burst_size * 2;
+	unsigned int i, j, k;
+	uint32_t hit;
+
+	/*
+	 * Function overview:
+	 * 1. Broadcast each incoming flow id into its own ymm reg
+	 * 2. Loop through all worker ID's
+	 *  2a. Load the inflights and backlog of the worker, which are
+	 *      contiguous, 16 tags at a time
+	 *  2b. Compare them against each broadcast flow id
+	 *  2c. Store the worker ID in the output for any match
+	 */
+	for (j = 0; j < RTE_DIST_BURST_SIZE; j++) {
+		incoming_fids[j] = _mm256_set1_epi16(data_ptr[j]);
+		output_ptr[j] = 0;
+	}
+
+	for (i = 0; i < d->num_workers; i++) {
+		hit = 0;
+		for (k = 0; k < nb_tags; k += 16) {
+			tags = _mm256_load_si256(
+				(const __m256i *)&d->in_flight_tags[i][k]);
+			for (j = 0; j < RTE_DIST_BURST_SIZE; j++)
+				hit |= (uint32_t)(_mm256_movemask_epi8(
+					_mm256_cmpeq_epi16(tags,
+						incoming_fids[j])) != 0) << j;
+		}
+
+		for (j = 0; j < RTE_DIST_BURST_SIZE; j++)
+			if (hit & (1u << j))
+				output_ptr[j] = i + 1;
+	}
+
+	/*
+	 * At this stage, the output contains 8 16-bit values, with
+	 * each non-zero value containing the worker ID on which the
+	 * corresponding flow is pinned to.
+	 */
+}
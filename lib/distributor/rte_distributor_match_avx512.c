@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <rte_mbuf.h>
+#include <rte_vect.h>
+
+#include "distributor_private.h"
+
+void
+find_match_avx512(struct rte_distributor *d,
+			uint16_t *data_ptr,
+			uint16_t *output_ptr)
+{
+	__m512i incoming_fids[RTE_DIST_BURST_SIZE];
+	__m512i tags;
+	const unsigned int nb_tags = d->burst_size * 2;
+	unsigned int i, j, k;
+	__mmask32 valid, match;
+
+	/*
+	 * Function overview:
+	 * 1. Broadcast each incoming flow id into its own zmm reg
+	 * 2. Loop through all worker ID's
+	 *  2a. Load the inflights and backlog of the worker, which are
+	 *      contiguous, 32 tags at a time. With the default burst size
+	 *      there are only 16 tags per worker, so two workers are
+	 *      loaded into a single zmm reg.
+	 *  2b. Compare them against each broadcast flow id
+	 *  2c. Store the worker ID in the output for any match
+	 */
+	for (j = 0; j < RTE_DIST_BURST_SIZE; j++) {
+		incoming_fids[j] = _mm512_set1_epi16(data_ptr[j]);
+		output_ptr[j] = 0;
+	}
+
+	if (nb_tags == 16) {
+		/*
+		 * num_workers is lower than RTE_DISTRIB_MAX_WORKERS, so the
+		 * row following the last worker can always be read.
+		 */
+		for (i = 0; i < d->num_workers; i += 2) {
+			tags = _mm512_inserti64x4(_mm512_castsi256_si512(
+				_mm256_load_si256((const __m256i *)
+					d->in_flight_tags[i])),
+				_mm256_load_si256((const __m256i *)
+					d->in_flight_tags[i + 1]), 1);
+			valid = (i + 1 < d->num_workers) ? UINT32_MAX :
+					UINT16_MAX;
+
+			for (j = 0; j < RTE_DIST_BURST_SIZE; j++) {
+				match = _mm512_mask_cmpeq_epi16_mask(valid,
+						tags, incoming_fids[j]);
+				if (match & UINT16_MAX)
+					output_ptr[j] = i + 1;
+				if (match >> 16)
+					output_ptr[j] = i + 2;
+			}
+		}
+		return;
+	}
+
+	for (i = 0; i < d->num_workers; i++) {
+		for (k = 0; k < nb_tags; k += 32) {
+			tags = _mm512_load_si512(&d->in_flight_tags[i][k]);
+			for (j = 0; j < RTE_DIST_BURST_SIZE; j++)
+				if (_mm512_cmpeq_epi16_mask(tags,
+						incoming_fids[j]))
+					output_ptr[j] = i + 1;
+		}
+	}
+}
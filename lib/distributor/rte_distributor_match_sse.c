@@ -21,13 +21,15 @@ find_match_vec(struct rte_distributor *d,
 	__m128i mask2;
 	__m128i output;
 	struct rte_distributor_backlog *bl;
-	uint16_t i;
+	uint16_t i, j;
 
 	/*
 	 * Function overview:
 	 * 2. Loop through all worker ID's
-	 *  2a. Load the current inflights for that worker into an xmm reg
-	 *  2b. Load the current backlog for that worker into an xmm reg
+	 *  2a. Load the current inflights for that worker into an xmm reg,
+	 *      8 tags at a time
+	 *  2b. Load the current backlog for that worker into an xmm reg,
+	 *      8 tags at a time
 	 *  2c. use cmpestrm to intersect flow_ids with backlog and inflights
 	 *  2d. Add any matches to the output
 	 * 3. Write the output xmm (matching worker ids).
@@ -40,11 +42,6 @@ find_match_vec(struct rte_distributor *d,
 	for (i = 0; i < d->num_workers; i++) {
 		bl = &d->backlog[i];
 
-		inflight_fids =
-			_mm_load_si128((__m128i *)&(d->in_flight_tags[i]));
-		preflight_fids =
-			_mm_load_si128((__m128i *)(bl->tags));
-
 		/*
 		 * Any incoming_fid that exists anywhere in inflight_fids will
 		 * have 0xffff in same position of the mask as the incoming fid
@@ -52,18 +49,28 @@ find_match_vec(struct rte_distributor *d,
 		 * incoming_fids   0x01 0x02 0x03 0x04 0x05 0x06 0x07 0x08
 		 * inflight_fids   0x03 0x05 0x07 0x00 0x00 0x00 0x00 0x00
 		 * mask            0x00 0x00 0xff 0x00 0xff 0x00 0xff 0x00
+		 *
+		 * Bursts larger than 8 are compared 8 tags at a time.
 		 */
+		mask1 = _mm_setzero_si128();
+		for (j = 0; j < d->burst_size; j += 8) {
+			inflight_fids = _mm_load_si128(
+				(__m128i *)&(d->in_flight_tags[i][j]));
+			preflight_fids = _mm_load_si128(
+				(__m128i *)&(bl->tags[j]));
 
-		mask1 = _mm_cmpestrm(inflight_fids, 8, incoming_fids, 8,
-			_SIDD_UWORD_OPS |
-			_SIDD_CMP_EQUAL_ANY |
-			_SIDD_UNIT_MASK);
-		mask2 = _mm_cmpestrm(preflight_fids, 8, incoming_fids, 8,
-			_SIDD_UWORD_OPS |
-			_SIDD_CMP_EQUAL_ANY |
-			_SIDD_UNIT_MASK);
+			mask2 = _mm_cmpestrm(inflight_fids, 8, incoming_fids, 8,
+				_SIDD_UWORD_OPS |
+				_SIDD_CMP_EQUAL_ANY |
+				_SIDD_UNIT_MASK);
+			mask1 = _mm_or_si128(mask1, mask2);
+			mask2 = _mm_cmpestrm(preflight_fids, 8, incoming_fids, 8,
+				_SIDD_UWORD_OPS |
+				_SIDD_CMP_EQUAL_ANY |
+				_SIDD_UNIT_MASK);
+			mask1 = _mm_or_si128(mask1, mask2);
+		}
 
-		mask1 = _mm_or_si128(mask1, mask2);
 		/*
 		 * Now mask contains 0xffff where there's a match.
 		 * Next we need to store the worker_id in the relevant position
@@ -18,10 +18,13 @@
 #include <rte_malloc.h>
 #include <rte_prefetch.h>
 #include <rte_branch_prediction.h>
+#include <rte_bitops.h>
 #include <rte_memcpy.h>
 #include <rte_ring.h>
 #include <rte_jhash.h>
 #include <rte_hash_crc.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
 #include <rte_tailq.h>
 
 #include "rte_efd.h"
@@ -196,6 +199,12 @@ struct efd_offline_group_rules {
  * Those rules are split into EFD_CHUNK_NUM_GROUPS groups per chunk.
  */
 struct efd_offline_chunk_rules {
+	rte_spinlock_t lock;
+	/**< Serializes the writers updating this chunk. A bin can only be
+	 * moved between groups of the same chunk, so writers of different
+	 * chunks never touch the same offline or online data.
+	 */
+
 	uint16_t num_rules;
 	/**< Number of rules in the entire chunk;
 	 * used to detect unbalanced groups
@@ -242,7 +251,7 @@ struct rte_efd_table {
 	uint32_t max_num_rules;
 	/**< Static maximum number of entries the table was constructed to hold. */
 
-	uint32_t num_rules;
+	RTE_ATOMIC(uint32_t) num_rules;
 	/**< Number of entries currently in the table . */
 
 	uint32_t num_chunks;
@@ -582,7 +591,8 @@ rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
 			"on socket %u", offline_cpu_socket);
 
 	table->max_num_rules = num_chunks * EFD_TARGET_CHUNK_MAX_NUM_RULES;
-	table->num_rules = 0;
+	rte_atomic_store_explicit(&table->num_rules, 0,
+			rte_memory_order_relaxed);
 	table->num_chunks = num_chunks;
 	table->num_chunks_shift = num_chunks_shift;
 	table->key_len = key_len;
@@ -687,6 +697,9 @@ rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
 		goto error_unlock_exit;
 	}
 
+	for (i = 0; i < num_chunks; i++)
+		rte_spinlock_init(&table->offline_chunks[i].lock);
+
 	EFD_LOG(DEBUG,
 			"Allocated EFD offline table of size %"PRIu64" bytes "
 			" (%.2f MB) on socket %u", offline_table_size,
@@ -935,11 +948,11 @@ revert_groups(struct efd_offline_group_rules *previous_group,
  * @param value
  *   Value to associate with key
  * @param chunk_id
- *   Chunk ID of the chunk that was modified
+ *   Chunk ID of the key, as computed by efd_compute_ids
+ * @param bin_id
+ *   Bin ID of the key, as computed by efd_compute_ids
  * @param group_id
  *   Group ID of the group that was modified
- * @param bin_id
- *   Bin ID that was modified
  * @param new_bin_choice
  *   Newly chosen permutation which this bin will use
  * @param entry
@@ -966,8 +979,8 @@ revert_groups(struct efd_offline_group_rules *previous_group,
 static inline int
 efd_compute_update(struct rte_efd_table * const table,
 		const unsigned int socket_id, const void *key,
-		const efd_value_t value, uint32_t * const chunk_id,
-		uint32_t * const group_id, uint32_t * const bin_id,
+		const efd_value_t value, const uint32_t chunk_id,
+		const uint32_t bin_id, uint32_t * const group_id,
 		uint8_t * const new_bin_choice,
 		struct efd_online_group_entry * const entry)
 {
@@ -978,15 +991,13 @@ efd_compute_update(struct rte_efd_table * const table,
 	int status = EXIT_SUCCESS;
 	unsigned int found = 0;
 
-	efd_compute_ids(table, key, chunk_id, bin_id);
-
 	struct efd_offline_chunk_rules * const chunk =
-			&table->offline_chunks[*chunk_id];
+			&table->offline_chunks[chunk_id];
 	struct efd_offline_group_rules *new_group;
 
 	uint8_t current_choice = efd_get_choice(table, socket_id,
-			*chunk_id, *bin_id);
-	uint32_t current_group_id = efd_bin_to_group[current_choice][*bin_id];
+			chunk_id, bin_id);
+	uint32_t current_group_id = efd_bin_to_group[current_choice][bin_id];
 	struct efd_offline_group_rules * const current_group =
 			&chunk->group_rules[current_group_id];
 	uint8_t bin_size = 0;
@@ -996,7 +1007,7 @@ efd_compute_update(struct rte_efd_table * const table,
 
 	/* Scan the current group and see if the key is already present */
 	for (i = 0; i < current_group->num_rules; i++) {
-		if (current_group->bin_id[i] == *bin_id)
+		if (current_group->bin_id[i] == bin_id)
 			bin_size++;
 		else
 			continue;
@@ -1027,8 +1038,8 @@ efd_compute_update(struct rte_efd_table * const table,
 			EFD_LOG(ERR,
 					"Fatal: No room remaining for insert into "
 					"chunk %u group %u bin %u",
-					*chunk_id,
-					current_group_id, *bin_id);
+					chunk_id,
+					current_group_id, bin_id);
 			return RTE_EFD_UPDATE_FAILED;
 		}
 
@@ -1036,12 +1047,12 @@ efd_compute_update(struct rte_efd_table * const table,
 				(EFD_MAX_GROUP_NUM_RULES - 1))) {
 			EFD_LOG(INFO, "Warn: Insert into last "
 					"available slot in chunk %u "
-					"group %u bin %u", *chunk_id,
-					current_group_id, *bin_id);
+					"group %u bin %u", chunk_id,
+					current_group_id, bin_id);
 			status = RTE_EFD_UPDATE_WARN_GROUP_FULL;
 		}
 
-		if (rte_ring_sc_dequeue(table->free_slots, &slot_id) != 0)
+		if (rte_ring_mc_dequeue(table->free_slots, &slot_id) != 0)
 			return RTE_EFD_UPDATE_FAILED;
 
 		new_k = RTE_PTR_ADD(table->keys, (uintptr_t) slot_id *
@@ -1052,9 +1063,10 @@ efd_compute_update(struct rte_efd_table * const table,
 		rte_memcpy(EFD_KEY(new_idx, table), key, table->key_len);
 		current_group->key_idx[current_group->num_rules] = new_idx;
 		current_group->value[current_group->num_rules] = value;
-		current_group->bin_id[current_group->num_rules] = *bin_id;
+		current_group->bin_id[current_group->num_rules] = bin_id;
 		current_group->num_rules++;
-		table->num_rules++;
+		rte_atomic_fetch_add_explicit(&table->num_rules, 1,
+				rte_memory_order_relaxed);
 		bin_size++;
 	} else {
 		uint32_t last = current_group->num_rules - 1;
@@ -1072,7 +1084,7 @@ efd_compute_update(struct rte_efd_table * const table,
 		 */
 		current_group->key_idx[last] = key_idx_previous;
 		current_group->value[last] = value;
-		current_group->bin_id[last] = *bin_id;
+		current_group->bin_id[last] = bin_id;
 	}
 
 	*new_bin_choice = current_choice;
@@ -1101,7 +1113,7 @@ efd_compute_update(struct rte_efd_table * const table,
 		for (choice = 0; choice < EFD_CHUNK_NUM_BIN_TO_GROUP_SETS;
 				choice++) {
 			uint32_t test_group_id =
-					efd_bin_to_group[choice][*bin_id];
+					efd_bin_to_group[choice][bin_id];
 			uint32_t num_rules =
 					chunk->group_rules[test_group_id].num_rules;
 			if (num_rules < smallest_size) {
@@ -1131,7 +1143,7 @@ efd_compute_update(struct rte_efd_table * const table,
 					choice - 1);
 			goto next_choice;
 		}
-		move_groups(*bin_id, bin_size, new_group, current_group);
+		move_groups(bin_id, bin_size, new_group, current_group);
 		/*
 		 * Recompute the hash function for the modified group,
 		 * and return it to the caller
@@ -1152,31 +1164,37 @@ efd_compute_update(struct rte_efd_table * const table,
 		if (choice == EFD_CHUNK_NUM_BIN_TO_GROUP_SETS)
 			break;
 		*new_bin_choice = choice;
-		*group_id = efd_bin_to_group[choice][*bin_id];
+		*group_id = efd_bin_to_group[choice][bin_id];
 		new_group = &chunk->group_rules[*group_id];
 		choice++;
 	}
 
 	if (!found) {
 		current_group->num_rules--;
-		table->num_rules--;
+		rte_atomic_fetch_sub_explicit(&table->num_rules, 1,
+				rte_memory_order_relaxed);
 	} else
 		current_group->value[current_group->num_rules - 1] =
 			key_changed_previous_value;
 	return RTE_EFD_UPDATE_FAILED;
 }
 
-RTE_EXPORT_SYMBOL(rte_efd_update)
-int
-rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
-		const void *key, const efd_value_t value)
+/*
+ * Compute and apply the update of a single key.
+ * The caller must hold the lock of the key chunk.
+ */
+static inline int
+efd_update_locked(struct rte_efd_table * const table,
+		const unsigned int socket_id, const void *key,
+		const efd_value_t value, const uint32_t chunk_id,
+		const uint32_t bin_id)
 {
-	uint32_t chunk_id = 0, group_id = 0, bin_id = 0;
+	uint32_t group_id = 0;
 	uint8_t new_bin_choice = 0;
 	struct efd_online_group_entry entry = {{0}};
 
 	int status = efd_compute_update(table, socket_id, key, value,
-			&chunk_id, &group_id, &bin_id,
+			chunk_id, bin_id, &group_id,
 			&new_bin_choice, &entry);
 
 	if (status == RTE_EFD_UPDATE_NO_CHANGE)
@@ -1190,6 +1208,272 @@ rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
 	return status;
 }
 
+RTE_EXPORT_SYMBOL(rte_efd_update)
+int
+rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
+		const void *key, const efd_value_t value)
+{
+	uint32_t chunk_id, bin_id;
+	int status;
+
+	efd_compute_ids(table, key, &chunk_id, &bin_id);
+
+	rte_spinlock_t * const lock = &table->offline_chunks[chunk_id].lock;
+
+	rte_spinlock_lock(lock);
+	status = efd_update_locked(table, socket_id, key, value,
+			chunk_id, bin_id);
+	rte_spinlock_unlock(lock);
+
+	return status;
+}
+
+/*
+ * Apply a burst of updates falling in the same chunk.
+ *
+ * All the keys are first added to the offline groups, rebalancing the bins
+ * like efd_compute_update does, and the perfect hash is then searched once
+ * per modified group rather than once per key. The online tables are only
+ * modified when a hash could be found for every modified group.
+ * The caller must hold the chunk lock.
+ *
+ * @return
+ *   0 if all the updates were applied and status_list is filled,
+ *   -1 if the offline chunk was restored and nothing was applied.
+ */
+static inline int
+efd_update_chunk_bulk(struct rte_efd_table * const table,
+		const unsigned int socket_id, const uint32_t chunk_id,
+		const int * const order, const int num_keys,
+		const void **key_list, const efd_value_t *value_list,
+		const uint32_t * const bin_ids, int * const status_list)
+{
+	struct efd_offline_chunk_rules * const chunk =
+			&table->offline_chunks[chunk_id];
+	struct efd_offline_group_rules saved[EFD_CHUNK_NUM_GROUPS];
+	struct efd_online_group_entry entries[EFD_CHUNK_NUM_GROUPS];
+	uint8_t choices[EFD_CHUNK_NUM_BINS / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS];
+	void *slots[RTE_EFD_BURST_MAX];
+	unsigned int num_slots = 0;
+	uint64_t touched = 0, dirty = 0, mask;
+	uint32_t group_id, i;
+	int n, s;
+
+	rte_memcpy(choices, table->chunks[socket_id][chunk_id].bin_choice_list,
+			sizeof(choices));
+
+#define EFD_BULK_TOUCH(g) do { \
+		if ((touched & RTE_BIT64(g)) == 0) { \
+			saved[g] = chunk->group_rules[g]; \
+			touched |= RTE_BIT64(g); \
+		} \
+	} while (0)
+
+	for (n = 0; n < num_keys; n++) {
+		const int k = order[n];
+		const void *key = key_list[k];
+		const efd_value_t value = value_list[k];
+		const uint32_t bin_id = bin_ids[k];
+		const int offset = (bin_id & 0x3) * 2;
+		uint8_t choice = (choices[bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS] >>
+				offset) & 0x3;
+		struct efd_offline_group_rules *group, *new_group;
+		uint8_t bin_size = 0;
+		int found = -1;
+
+		group_id = efd_bin_to_group[choice][bin_id];
+		group = &chunk->group_rules[group_id];
+
+		for (i = 0; i < group->num_rules; i++) {
+			if (group->bin_id[i] != bin_id)
+				continue;
+			bin_size++;
+			if (found < 0 && memcmp(EFD_KEY(group->key_idx[i], table),
+					key, table->key_len) == 0)
+				found = i;
+		}
+
+		if (found >= 0) {
+			/* Value change, only the group hash needs a refresh */
+			if (group->value[found] != value) {
+				EFD_BULK_TOUCH(group_id);
+				group->value[found] = value;
+				dirty |= RTE_BIT64(group_id);
+			}
+			status_list[k] = EXIT_SUCCESS;
+			continue;
+		}
+
+		/* Let the single key path report the failure */
+		if (group->num_rules >= EFD_MAX_GROUP_NUM_RULES ||
+				rte_ring_mc_dequeue(table->free_slots,
+					&slots[num_slots]) != 0)
+			goto restore;
+
+		EFD_BULK_TOUCH(group_id);
+		i = (uint32_t)(uintptr_t)slots[num_slots++];
+		rte_memcpy(EFD_KEY(i, table), key, table->key_len);
+		group->key_idx[group->num_rules] = i;
+		group->value[group->num_rules] = value;
+		group->bin_id[group->num_rules] = bin_id;
+		group->num_rules++;
+		rte_atomic_fetch_add_explicit(&table->num_rules, 1,
+				rte_memory_order_relaxed);
+		bin_size++;
+		status_list[k] = group->num_rules == EFD_MAX_GROUP_NUM_RULES ?
+				RTE_EFD_UPDATE_WARN_GROUP_FULL : EXIT_SUCCESS;
+
+		/* Move the bin to the smallest group once loaded */
+		if (group->num_rules > EFD_MIN_BALANCED_NUM_RULES) {
+			uint8_t smallest_size = group->num_rules - bin_size;
+			uint8_t smallest_choice = choice;
+			uint8_t c;
+
+			for (c = 0; c < EFD_CHUNK_NUM_BIN_TO_GROUP_SETS; c++) {
+				uint32_t test_group_id = efd_bin_to_group[c][bin_id];
+
+				if (test_group_id != group_id &&
+						chunk->group_rules[test_group_id].num_rules <
+						smallest_size) {
+					smallest_choice = c;
+					smallest_size =
+						chunk->group_rules[test_group_id].num_rules;
+				}
+			}
+
+			if (smallest_choice != choice) {
+				group_id = efd_bin_to_group[smallest_choice][bin_id];
+				new_group = &chunk->group_rules[group_id];
+				EFD_BULK_TOUCH(group_id);
+				move_groups(bin_id, bin_size, new_group, group);
+				choices[bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS] =
+					(choices[bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS] &
+						~(0x03 << offset)) |
+					(smallest_choice << offset);
+			}
+		}
+		dirty |= RTE_BIT64(group_id);
+	}
+
+#undef EFD_BULK_TOUCH
+
+	/*
+	 * Start the search from the current hash functions of the group,
+	 * most of them are still valid after a few keys were added.
+	 */
+	for (mask = dirty; mask != 0; mask &= mask - 1) {
+		group_id = rte_ctz64(mask);
+		entries[group_id] =
+			table->chunks[socket_id][chunk_id].groups[group_id];
+		if (efd_search_hash(table, &chunk->group_rules[group_id],
+				&entries[group_id]) != 0) {
+			EFD_LOG(DEBUG, "Failed to find perfect hash for chunk %u "
+					"group %u in burst, retrying per key",
+					chunk_id, group_id);
+			goto restore;
+		}
+	}
+
+	/* Update the online table with the new data across all sockets */
+	for (s = 0; s < RTE_MAX_NUMA_NODES; s++) {
+		struct efd_online_chunk *online;
+
+		if (table->chunks[s] == NULL)
+			continue;
+		online = &table->chunks[s][chunk_id];
+		for (mask = dirty; mask != 0; mask &= mask - 1) {
+			group_id = rte_ctz64(mask);
+			memcpy(&online->groups[group_id], &entries[group_id],
+					sizeof(struct efd_online_group_entry));
+		}
+		memcpy(online->bin_choice_list, choices, sizeof(choices));
+	}
+
+	return 0;
+
+restore:
+	for (mask = touched; mask != 0; mask &= mask - 1) {
+		group_id = rte_ctz64(mask);
+		chunk->group_rules[group_id] = saved[group_id];
+	}
+	if (num_slots != 0) {
+		rte_ring_mp_enqueue_bulk(table->free_slots, slots, num_slots,
+				NULL);
+		rte_atomic_fetch_sub_explicit(&table->num_rules, num_slots,
+				rte_memory_order_relaxed);
+	}
+	return -1;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_efd_update_bulk, 25.07)
+int
+rte_efd_update_bulk(struct rte_efd_table * const table,
+		const unsigned int socket_id, const int num_keys,
+		const void **key_list, const efd_value_t *value_list,
+		int * const status_list)
+{
+	uint32_t chunk_ids[RTE_EFD_BURST_MAX];
+	uint32_t bin_ids[RTE_EFD_BURST_MAX];
+	int order[RTE_EFD_BURST_MAX];
+	int i, j, k, start, end;
+	int num_updated = 0;
+
+	if (table == NULL || key_list == NULL || value_list == NULL ||
+			status_list == NULL || num_keys < 0 ||
+			num_keys > RTE_EFD_BURST_MAX)
+		return -EINVAL;
+
+	/*
+	 * Group the keys by chunk, keeping the order of the keys of a chunk
+	 * so that the last update of a key wins.
+	 */
+	for (i = 0; i < num_keys; i++) {
+		efd_compute_ids(table, key_list[i], &chunk_ids[i], &bin_ids[i]);
+		for (j = i; j > 0 && chunk_ids[order[j - 1]] > chunk_ids[i]; j--)
+			order[j] = order[j - 1];
+		order[j] = i;
+	}
+
+	for (start = 0; start < num_keys; start = end) {
+		const uint32_t chunk_id = chunk_ids[order[start]];
+		rte_spinlock_t * const lock = &table->offline_chunks[chunk_id].lock;
+
+		for (end = start + 1; end < num_keys &&
+				chunk_ids[order[end]] == chunk_id; end++)
+			;
+
+		rte_spinlock_lock(lock);
+		if (efd_update_chunk_bulk(table, socket_id, chunk_id,
+				&order[start], end - start, key_list, value_list,
+				bin_ids, status_list) != 0) {
+			for (i = start; i < end; i++) {
+				k = order[i];
+				status_list[k] = efd_update_locked(table,
+						socket_id, key_list[k], value_list[k],
+						chunk_id, bin_ids[k]);
+			}
+		}
+		rte_spinlock_unlock(lock);
+
+		for (i = start; i < end; i++)
+			if (status_list[order[i]] != RTE_EFD_UPDATE_FAILED)
+				num_updated++;
+	}
+
+	return num_updated;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_efd_count, 25.07)
+uint32_t
+rte_efd_count(const struct rte_efd_table *table)
+{
+	if (table == NULL)
+		return 0;
+
+	return rte_atomic_load_explicit(&table->num_rules,
+			rte_memory_order_relaxed);
+}
+
 RTE_EXPORT_SYMBOL(rte_efd_delete)
 int
 rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
@@ -1204,6 +1488,8 @@ rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 	struct efd_offline_chunk_rules * const chunk =
 			&table->offline_chunks[chunk_id];
 
+	rte_spinlock_lock(&chunk->lock);
+
 	uint8_t current_choice = efd_get_choice(table, socket_id,
 			chunk_id, bin_id);
 	uint32_t current_group_id = efd_bin_to_group[current_choice][bin_id];
@@ -1224,7 +1510,7 @@ rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 					*prev_value = current_group->value[i];
 
 				not_found = 0;
-				rte_ring_sp_enqueue(table->free_slots,
+				rte_ring_mp_enqueue(table->free_slots,
 					(void *)((uintptr_t)current_group->key_idx[i]));
 			}
 		} else {
@@ -1241,10 +1527,13 @@ rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 	}
 
 	if (not_found == 0) {
-		table->num_rules--;
+		rte_atomic_fetch_sub_explicit(&table->num_rules, 1,
+				rte_memory_order_relaxed);
 		current_group->num_rules--;
 	}
 
+	rte_spinlock_unlock(&chunk->lock);
+
 	return not_found;
 }
 
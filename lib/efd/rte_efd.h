@@ -13,6 +13,8 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -172,8 +174,8 @@ rte_efd_find_existing(const char *name);
  * Computes an updated table entry for the supplied key/value pair.
  * The update is then immediately applied to the provided table and
  * all socket-local copies of the chunks are updated.
- * This operation is not multi-thread safe
- * and should only be called one from thread.
+ * This operation is multi-thread safe: concurrent updates and deletes
+ * are only serialized when their keys fall in the same chunk.
  *
  * @param table
  *   EFD table to reference
@@ -201,10 +203,62 @@ int
 rte_efd_update(struct rte_efd_table *table, unsigned int socket_id,
 	const void *key, efd_value_t value);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Updates the table entries for several key/value pairs.
+ * The keys are grouped by chunk and the perfect hash of each modified group
+ * is computed once for the whole burst, which is cheaper than calling
+ * rte_efd_update() for each key. If the hash cannot be found for the burst,
+ * the keys of the chunk are updated one by one as rte_efd_update() does.
+ * When a key appears several times in the burst, the last value is kept.
+ * This operation is multi-thread safe.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param socket_id
+ *   Socket ID to use to lookup existing values (ideally caller's socket id)
+ * @param num_keys
+ *   Number of keys in the key_list array, must be less than or equal to
+ *   RTE_EFD_BURST_MAX
+ * @param key_list
+ *   Array of num_keys pointers which point to keys to modify
+ * @param value_list
+ *   Array of num_keys values to associate with the keys
+ * @param status_list
+ *   Array of size num_keys where the status of each update is stored,
+ *   with the same values as rte_efd_update() returns
+ *
+ * @return
+ *   Number of keys successfully updated, i.e. whose status is not
+ *   RTE_EFD_UPDATE_FAILED, or -EINVAL if the parameters are invalid
+ */
+__rte_experimental
+int
+rte_efd_update_bulk(struct rte_efd_table *table, unsigned int socket_id,
+	int num_keys, const void **key_list, const efd_value_t *value_list,
+	int *status_list);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Returns the number of keys stored in the table.
+ *
+ * @param table
+ *   EFD table to reference
+ *
+ * @return
+ *   Number of keys in the table, 0 if table is NULL
+ */
+__rte_experimental
+uint32_t
+rte_efd_count(const struct rte_efd_table *table);
+
 /**
  * Removes any value currently associated with the specified key from the table
- * This operation is not multi-thread safe
- * and should only be called from one thread.
+ * This operation is multi-thread safe.
  *
  * @param table
  *   EFD table to reference
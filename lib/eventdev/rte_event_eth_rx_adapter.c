@@ -11,6 +11,7 @@
 #include <unistd.h>
 
 #include <eal_export.h>
+#include <rte_cpuflags.h>
 #include <rte_cycles.h>
 #include <rte_thread.h>
 #include <rte_common.h>
@@ -23,6 +24,7 @@
 #include <rte_thash.h>
 #include <rte_interrupts.h>
 #include <rte_mbuf_dyn.h>
+#include <rte_power_intrinsics.h>
 #include <rte_telemetry.h>
 
 #include "rte_eventdev.h"
@@ -37,8 +39,15 @@
 #define MIN_VECTOR_SIZE		4
 #define MAX_VECTOR_NS		1E9
 #define MIN_VECTOR_NS		1E5
+/* Number of vectors aggregated per Rx queue, by flow hash, when the event
+ * device schedules vector events by flow
+ */
+#define RXA_NB_FLOW_VECTORS	8
+#define RXA_FLOW_VECTOR_SHIFT	17
 
 #define RXA_NB_RX_WORK_DEFAULT 128
+/* Maximum number of Rx queues monitored while idle */
+#define RXA_IDLE_MONITOR_MAX	32
 
 #define ETH_RX_ADAPTER_SERVICE_NAME_LEN	32
 #define ETH_RX_ADAPTER_MEM_NAME_LEN	32
@@ -129,6 +138,21 @@ struct __rte_cache_aligned event_eth_rx_adapter {
 	uint32_t wrr_len;
 	/* Next entry in wrr[] to begin polling */
 	uint32_t wrr_pos;
+	/* Timer cycles between servicing weight updates, 0 if disabled */
+	uint64_t wt_update_ticks;
+	/* Timestamp of the previous servicing weight update */
+	uint64_t wt_update_ts;
+	/* Servicing weight update period */
+	uint32_t weight_update_ms;
+	/* Service function calls without packets before waiting, or 0 */
+	uint32_t idle_polls;
+	/* Consecutive service function calls without packets */
+	uint32_t nb_empty_polls;
+	/* Maximum wait of an idle service function call */
+	uint32_t idle_wait_us;
+	uint64_t idle_wait_ticks;
+	/* Power intrinsics supported by the CPU */
+	struct rte_cpu_intrinsics intrinsics;
 	/* Event burst buffer */
 	struct eth_event_enqueue_buffer event_enqueue_buffer;
 	/* Vector enable flag */
@@ -247,9 +271,13 @@ struct eth_rx_queue_info {
 	int intr_enabled;
 	uint8_t ena_vector;
 	uint16_t wt;		/* Polling weight */
+	uint16_t adaptive_wt;	/* Polling weight from the Rx rate, or 0 */
+	uint64_t nb_adaptive_rx; /* Packets received since weight update */
 	uint32_t flow_id_mask;	/* Set to ~0 if app provides flow id else 0 */
 	uint64_t event;
-	struct eth_rx_vector_data vector_data;
+	uint16_t nb_vectors;	/* Vectors aggregated, 1 or by flow hash */
+	/* Vector state, only allocated if the queue aggregates vectors */
+	struct eth_rx_vector_data *vector_data;
 	struct eth_event_enqueue_buffer *event_buf;
 	/* use adapter stats struct for queue level stats,
 	 * as same stats need to be updated for adapter and queue
@@ -337,6 +365,14 @@ static uint16_t rxa_gcd_u16(uint16_t a, uint16_t b)
 	return r ? rxa_gcd_u16(b, r) : b;
 }
 
+/* Polling weight of a queue, as updated from its Rx rate if enabled */
+static inline uint16_t
+rxa_poll_wt(const struct eth_rx_queue_info *queue_info)
+{
+	return queue_info->adaptive_wt ? queue_info->adaptive_wt :
+			queue_info->wt;
+}
+
 /* Returns the next queue in the polling sequence
  *
  * http://kb.linuxvirtualserver.org/wiki/Weighted_Round-Robin_Scheduling
@@ -362,7 +398,7 @@ rxa_wrr_next(struct event_eth_rx_adapter *rx_adapter, unsigned int n, int *cw,
 
 		q = eth_rx_poll[i].eth_rx_qid;
 		d = eth_rx_poll[i].eth_dev_id;
-		w = rx_adapter->eth_devices[d].rx_queue[q].wt;
+		w = rxa_poll_wt(&rx_adapter->eth_devices[d].rx_queue[q]);
 
 		if ((int)w >= *cw)
 			return i;
@@ -634,10 +670,14 @@ rxa_alloc_poll_arrays(struct event_eth_rx_adapter *rx_adapter, uint32_t nb_poll,
 	return 0;
 }
 
-/* Precalculate WRR polling sequence for all queues in rx_adapter */
+/* Precalculate WRR polling sequence for all queues in rx_adapter.
+ * Unless adaptive is set, the weights updated from the Rx rates are reset
+ * to the configured ones, which sum up to the size of rx_wrr.
+ */
 static void
 rxa_calc_wrr_sequence(struct event_eth_rx_adapter *rx_adapter,
-		      struct eth_rx_poll_entry *rx_poll, uint32_t *rx_wrr)
+		      struct eth_rx_poll_entry *rx_poll, uint32_t *rx_wrr,
+		      bool adaptive)
 {
 	uint16_t d;
 	uint16_t q;
@@ -674,11 +714,15 @@ rxa_calc_wrr_sequence(struct event_eth_rx_adapter *rx_adapter,
 
 			if (!rxa_polled_queue(dev_info, q))
 				continue;
-			wt = queue_info->wt;
+			if (!adaptive) {
+				queue_info->adaptive_wt = 0;
+				queue_info->nb_adaptive_rx = 0;
+			}
+			wt = rxa_poll_wt(queue_info);
 			rx_poll[poll_q].eth_dev_id = d;
 			rx_poll[poll_q].eth_rx_qid = q;
 			max_wrr_pos += wt;
-			dev_info->wrr_len += wt;
+			dev_info->wrr_len += queue_info->wt;
 			max_wt = RTE_MAX(max_wt, wt);
 			gcd = (gcd) ? rxa_gcd_u16(gcd, wt) : wt;
 			poll_q++;
@@ -876,7 +920,7 @@ rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 	uint16_t filled, space, sz;
 
 	filled = 0;
-	vec = &queue_info->vector_data;
+	vec = &queue_info->vector_data[0];
 
 	if (vec->vector_ev == NULL) {
 		if (rte_mempool_get(vec->vector_pool,
@@ -925,6 +969,55 @@ rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 	return filled;
 }
 
+/* Aggregate the packets into the vectors of their flow hash, for the flows
+ * of the Rx queue to be scheduled independently.
+ */
+static inline uint16_t
+rxa_create_flow_event_vectors(struct event_eth_rx_adapter *rx_adapter,
+			      struct eth_rx_queue_info *queue_info,
+			      struct eth_event_enqueue_buffer *buf,
+			      struct rte_mbuf **mbufs, uint16_t num)
+{
+	struct rte_event *ev = &buf->events[buf->count];
+	struct eth_rx_vector_data *vec;
+	uint64_t ts = rte_rdtsc();
+	uint16_t filled = 0;
+	uint16_t i;
+
+	for (i = 0; i < num; i++) {
+		struct rte_mbuf *m = mbufs[i];
+		uint32_t rss;
+
+		rss = m->ol_flags & RTE_MBUF_F_RX_RSS_HASH ? m->hash.rss :
+			rxa_do_softrss(m, rx_adapter->rss_key_be);
+		vec = &queue_info->vector_data[rss & (RXA_NB_FLOW_VECTORS - 1)];
+
+		if (vec->vector_ev == NULL) {
+			if (rte_mempool_get(vec->vector_pool,
+					    (void **)&vec->vector_ev) < 0) {
+				rte_pktmbuf_free_bulk(&mbufs[i], num - i);
+				return filled;
+			}
+			rxa_init_vector(rx_adapter, vec);
+		}
+
+		vec->vector_ev->mbufs[vec->vector_ev->nb_elem++] = m;
+		vec->ts = ts;
+
+		if (vec->vector_ev->nb_elem == vec->max_vector_count) {
+			/* Event ready. */
+			ev->event = vec->event;
+			ev->vec = vec->vector_ev;
+			ev++;
+			filled++;
+			vec->vector_ev = NULL;
+			TAILQ_REMOVE(&rx_adapter->vector_list, vec, next);
+		}
+	}
+
+	return filled;
+}
+
 static inline void
 rxa_buffer_mbufs(struct event_eth_rx_adapter *rx_adapter, uint16_t eth_dev_id,
 		 uint16_t rx_queue_id, struct rte_mbuf **mbufs, uint16_t num,
@@ -977,6 +1070,10 @@ rxa_buffer_mbufs(struct event_eth_rx_adapter *rx_adapter, uint16_t eth_dev_id,
 			ev->mbuf = m;
 			new_tail++;
 		}
+	} else if (eth_rx_queue_info->nb_vectors > 1) {
+		num = rxa_create_flow_event_vectors(rx_adapter,
+						    eth_rx_queue_info,
+						    buf, mbufs, num);
 	} else {
 		num = rxa_create_event_vector(rx_adapter, eth_rx_queue_info,
 					      buf, mbufs, num);
@@ -1330,6 +1427,7 @@ rxa_poll(struct event_eth_rx_adapter *rx_adapter)
 	struct rte_event_eth_rx_adapter_stats *stats = NULL;
 	uint32_t wrr_pos;
 	uint32_t max_nb_rx;
+	uint32_t n;
 	bool work = false;
 
 	wrr_pos = rx_adapter->wrr_pos;
@@ -1347,8 +1445,6 @@ rxa_poll(struct event_eth_rx_adapter *rx_adapter)
 		 * enough space in the enqueue buffer.
 		 */
 		if (buf->count >= BATCH_SIZE) {
-			uint16_t n;
-
 			n = rxa_flush_event_buffer(rx_adapter, buf, stats);
 
 			if (likely(n > 0))
@@ -1363,8 +1459,12 @@ rxa_poll(struct event_eth_rx_adapter *rx_adapter)
 			}
 		}
 
-		nb_rx += rxa_eth_rx(rx_adapter, d, qid, nb_rx, max_nb_rx,
-				NULL, buf, stats);
+		n = rxa_eth_rx(rx_adapter, d, qid, nb_rx, max_nb_rx, NULL,
+			       buf, stats);
+		if (rx_adapter->wt_update_ticks != 0)
+			rx_adapter->eth_devices[d].rx_queue[qid].nb_adaptive_rx +=
+				n;
+		nb_rx += n;
 		if (nb_rx > max_nb_rx) {
 			rx_adapter->wrr_pos =
 				    (wrr_pos + 1) % rx_adapter->wrr_len;
@@ -1408,6 +1508,122 @@ rxa_vector_expire(struct eth_rx_vector_data *vec, void *arg)
 	vec->ts = 0;
 }
 
+/* Share out the sum of the configured polling weights between the polled
+ * queues, in proportion of the packets received on each queue since the
+ * previous update.
+ */
+static void
+rxa_update_weights(struct event_eth_rx_adapter *rx_adapter)
+{
+	struct eth_rx_queue_info *busiest = NULL;
+	uint64_t now = rte_get_timer_cycles();
+	uint64_t nb_rx_total = 0;
+	uint32_t spare, assigned = 0;
+	uint32_t i;
+
+	if (now - rx_adapter->wt_update_ts < rx_adapter->wt_update_ticks)
+		return;
+	rx_adapter->wt_update_ts = now;
+
+	if (rx_adapter->num_rx_polled == 0)
+		return;
+
+	for (i = 0; i < rx_adapter->num_rx_polled; i++) {
+		struct eth_rx_poll_entry *poll = &rx_adapter->eth_rx_poll[i];
+
+		nb_rx_total += rx_adapter->eth_devices[poll->eth_dev_id]
+				.rx_queue[poll->eth_rx_qid].nb_adaptive_rx;
+	}
+
+	/* Keep the previous weights until traffic resumes */
+	if (nb_rx_total == 0)
+		return;
+
+	spare = rx_adapter->wrr_len - rx_adapter->num_rx_polled;
+	for (i = 0; i < rx_adapter->num_rx_polled; i++) {
+		struct eth_rx_poll_entry *poll = &rx_adapter->eth_rx_poll[i];
+		struct eth_rx_queue_info *queue_info =
+			&rx_adapter->eth_devices[poll->eth_dev_id]
+				.rx_queue[poll->eth_rx_qid];
+		uint64_t wt;
+
+		wt = 1 + spare * queue_info->nb_adaptive_rx / nb_rx_total;
+		queue_info->adaptive_wt = RTE_MIN(wt, (uint64_t)UINT16_MAX);
+		assigned += queue_info->adaptive_wt;
+		if (busiest == NULL ||
+		    queue_info->nb_adaptive_rx > busiest->nb_adaptive_rx)
+			busiest = queue_info;
+	}
+
+	/* Rounding leftovers go to the busiest queue */
+	busiest->adaptive_wt = RTE_MIN((uint32_t)busiest->adaptive_wt +
+				       rx_adapter->wrr_len - assigned,
+				       (uint32_t)UINT16_MAX);
+
+	for (i = 0; i < rx_adapter->num_rx_polled; i++) {
+		struct eth_rx_poll_entry *poll = &rx_adapter->eth_rx_poll[i];
+
+		rx_adapter->eth_devices[poll->eth_dev_id]
+			.rx_queue[poll->eth_rx_qid].nb_adaptive_rx = 0;
+	}
+
+	rxa_calc_wrr_sequence(rx_adapter, rx_adapter->eth_rx_poll,
+			      rx_adapter->wrr_sched, true);
+	rx_adapter->wrr_pos = 0;
+}
+
+/* Get the monitoring conditions of the polled queues, returns 0 if the
+ * queues cannot all be monitored.
+ */
+static uint32_t
+rxa_idle_monitor_get(struct event_eth_rx_adapter *rx_adapter,
+		     struct rte_power_monitor_cond *pmc)
+{
+	uint32_t i;
+
+	/* Packets of interrupt queues are signaled through the intr ring */
+	if (rx_adapter->num_rx_intr != 0 ||
+	    rx_adapter->num_rx_polled == 0 ||
+	    rx_adapter->num_rx_polled > RXA_IDLE_MONITOR_MAX)
+		return 0;
+
+	if (rx_adapter->num_rx_polled == 1 ?
+	    !rx_adapter->intrinsics.power_monitor :
+	    !rx_adapter->intrinsics.power_monitor_multi)
+		return 0;
+
+	for (i = 0; i < rx_adapter->num_rx_polled; i++) {
+		struct eth_rx_poll_entry *poll = &rx_adapter->eth_rx_poll[i];
+
+		if (rte_eth_get_monitor_addr(poll->eth_dev_id,
+					     poll->eth_rx_qid, &pmc[i]) != 0)
+			return 0;
+	}
+
+	return rx_adapter->num_rx_polled;
+}
+
+/* Wait for packets to be received on the monitored queues, or for the
+ * idle wait time to elapse.
+ */
+static void
+rxa_idle_wait(struct event_eth_rx_adapter *rx_adapter,
+	      const struct rte_power_monitor_cond *pmc, uint32_t nb_pmc)
+{
+	const uint64_t deadline = rte_get_tsc_cycles() +
+				  rx_adapter->idle_wait_ticks;
+
+	if (nb_pmc == 1)
+		rte_power_monitor(&pmc[0], deadline);
+	else if (nb_pmc > 1)
+		rte_power_monitor_multi(pmc, nb_pmc, deadline);
+	else if (rx_adapter->intrinsics.power_pause)
+		rte_power_pause(deadline);
+	else
+		while (rte_get_tsc_cycles() < deadline)
+			rte_pause();
+}
+
 static int
 rxa_service_func(void *args)
 {
@@ -1443,6 +1659,23 @@ rxa_service_func(void *args)
 	intr_work = rxa_intr_ring_dequeue(rx_adapter);
 	poll_work = rxa_poll(rx_adapter);
 
+	if (rx_adapter->wt_update_ticks != 0)
+		rxa_update_weights(rx_adapter);
+
+	if (intr_work || poll_work) {
+		rx_adapter->nb_empty_polls = 0;
+	} else if (rx_adapter->idle_polls != 0 &&
+		   ++rx_adapter->nb_empty_polls >= rx_adapter->idle_polls) {
+		struct rte_power_monitor_cond pmc[RXA_IDLE_MONITOR_MAX];
+		uint32_t nb_pmc;
+
+		rx_adapter->nb_empty_polls = rx_adapter->idle_polls;
+		nb_pmc = rxa_idle_monitor_get(rx_adapter, pmc);
+		rte_spinlock_unlock(&rx_adapter->rx_lock);
+		rxa_idle_wait(rx_adapter, pmc, nb_pmc);
+		return -EAGAIN;
+	}
+
 	rte_spinlock_unlock(&rx_adapter->rx_lock);
 
 	return intr_work || poll_work ? 0 : -EAGAIN;
@@ -1983,15 +2216,15 @@ rxa_update_queue(struct event_eth_rx_adapter *rx_adapter,
 }
 
 static void
-rxa_set_vector_data(struct eth_rx_queue_info *queue_info, uint16_t vector_count,
-		    uint64_t vector_ns, struct rte_mempool *mp, uint32_t qid,
-		    uint16_t port_id)
+rxa_set_vector_data(struct eth_rx_queue_info *queue_info, uint16_t vec_idx,
+		    uint16_t vector_count, uint64_t vector_ns,
+		    struct rte_mempool *mp, uint32_t qid, uint16_t port_id)
 {
 #define NSEC2TICK(__ns, __freq) (((__ns) * (__freq)) / 1E9)
 	struct eth_rx_vector_data *vector_data;
 	uint32_t flow_id;
 
-	vector_data = &queue_info->vector_data;
+	vector_data = &queue_info->vector_data[vec_idx];
 	vector_data->max_vector_count = vector_count;
 	vector_data->port = port_id;
 	vector_data->queue = qid;
@@ -2002,14 +2235,41 @@ rxa_set_vector_data(struct eth_rx_queue_info *queue_info, uint16_t vector_count,
 	flow_id = queue_info->event & 0xFFFFF;
 	flow_id =
 		flow_id == 0 ? (qid & 0xFFF) | (port_id & 0xFF) << 12 : flow_id;
-	vector_data->event = (queue_info->event & ~0xFFFFF) | flow_id;
+	/* Each flow vector of the queue has its own flow id */
+	flow_id ^= (uint32_t)vec_idx << RXA_FLOW_VECTOR_SHIFT;
+	vector_data->event = (queue_info->event & ~0xFFFFF) | (flow_id & 0xFFFFF);
+}
+
+/* Push the partial event vectors of a queue to the event device and free
+ * its vector state.
+ */
+static void
+rxa_free_vector_data(struct event_eth_rx_adapter *rx_adapter,
+		     struct eth_rx_queue_info *queue_info)
+{
+	struct eth_rx_vector_data *vec;
+
+	queue_info->ena_vector = 0;
+	if (queue_info->vector_data == NULL)
+		return;
+
+	TAILQ_FOREACH(vec, &rx_adapter->vector_list, next) {
+		if (vec < queue_info->vector_data ||
+		    vec >= queue_info->vector_data + queue_info->nb_vectors)
+			continue;
+		rxa_vector_expire(vec, rx_adapter);
+		TAILQ_REMOVE(&rx_adapter->vector_list, vec, next);
+	}
+
+	rte_free(queue_info->vector_data);
+	queue_info->vector_data = NULL;
+	queue_info->nb_vectors = 0;
 }
 
 static void
 rxa_sw_del(struct event_eth_rx_adapter *rx_adapter,
 	   struct eth_device_info *dev_info, int32_t rx_queue_id)
 {
-	struct eth_rx_vector_data *vec;
 	int pollq;
 	int intrq;
 	int sintrq;
@@ -2027,13 +2287,9 @@ rxa_sw_del(struct event_eth_rx_adapter *rx_adapter,
 		return;
 	}
 
-	/* Push all the partial event vectors to event device. */
-	TAILQ_FOREACH(vec, &rx_adapter->vector_list, next) {
-		if (vec->queue != rx_queue_id)
-			continue;
-		rxa_vector_expire(vec, rx_adapter);
-		TAILQ_REMOVE(&rx_adapter->vector_list, vec, next);
-	}
+	if (dev_info->rx_queue != NULL)
+		rxa_free_vector_data(rx_adapter,
+				     &dev_info->rx_queue[rx_queue_id]);
 
 	pollq = rxa_polled_queue(dev_info, rx_queue_id);
 	intrq = rxa_intr_queue(dev_info, rx_queue_id);
@@ -2104,21 +2360,49 @@ rxa_add_queue(struct event_eth_rx_adapter *rx_adapter,
 	} else
 		qi_ev->flow_id = 0;
 
+	/* The vectors of a queue added again may have another layout */
+	rxa_free_vector_data(rx_adapter, queue_info);
+
 	if (conf->rx_queue_flags &
 	    RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR) {
+		struct rte_event_dev_info evdev_info;
+		uint16_t nb_vectors, i;
+
+		/* Aggregate by flow unless the application set the flow id */
+		nb_vectors = 1;
+		if (!queue_info->flow_id_mask &&
+		    rte_event_dev_info_get(rx_adapter->eventdev_id,
+					   &evdev_info) == 0 &&
+		    (evdev_info.event_dev_cap &
+		     RTE_EVENT_DEV_CAP_EVENT_VECTOR))
+			nb_vectors = RXA_NB_FLOW_VECTORS;
+
+		queue_info->vector_data = rte_zmalloc_socket("rx_vector_data",
+				nb_vectors * sizeof(*queue_info->vector_data),
+				0, rte_eth_dev_socket_id(eth_dev_id));
+		if (queue_info->vector_data == NULL) {
+			RTE_EDEV_LOG_ERR("Failed to allocate vector data for "
+					 "dev_id: %d queue_id: %d",
+					 eth_dev_id, rx_queue_id);
+			return -ENOMEM;
+		}
+		queue_info->nb_vectors = nb_vectors;
 		queue_info->ena_vector = 1;
 		qi_ev->event_type = RTE_EVENT_TYPE_ETH_RX_ADAPTER_VECTOR;
-		rxa_set_vector_data(queue_info, conf->vector_sz,
-				    conf->vector_timeout_ns, conf->vector_mp,
-				    rx_queue_id, dev_info->dev->data->port_id);
+
+		for (i = 0; i < queue_info->nb_vectors; i++)
+			rxa_set_vector_data(queue_info, i, conf->vector_sz,
+					    conf->vector_timeout_ns,
+					    conf->vector_mp, rx_queue_id,
+					    dev_info->dev->data->port_id);
 		rx_adapter->ena_vector = 1;
 		rx_adapter->vector_tmo_ticks =
 			rx_adapter->vector_tmo_ticks ?
-				      RTE_MIN(queue_info->vector_data
+				      RTE_MIN(queue_info->vector_data[0]
 							.vector_timeout_ticks >>
 						1,
 					rx_adapter->vector_tmo_ticks) :
-				queue_info->vector_data.vector_timeout_ticks >>
+				queue_info->vector_data[0].vector_timeout_ticks >>
 					1;
 	}
 
@@ -2311,7 +2595,7 @@ rxa_sw_add(struct event_eth_rx_adapter *rx_adapter, uint16_t eth_dev_id,
 	ret = rxa_add_queue(rx_adapter, dev_info, rx_queue_id, queue_conf);
 	if (ret)
 		goto err_free_rxqueue;
-	rxa_calc_wrr_sequence(rx_adapter, rx_poll, rx_wrr);
+	rxa_calc_wrr_sequence(rx_adapter, rx_poll, rx_wrr, false);
 
 	rte_free(rx_adapter->eth_rx_poll);
 	rte_free(rx_adapter->wrr_sched);
@@ -3056,7 +3340,7 @@ rte_event_eth_rx_adapter_queue_del(uint8_t id, uint16_t eth_dev_id,
 		}
 
 		rxa_sw_del(rx_adapter, dev_info, rx_queue_id);
-		rxa_calc_wrr_sequence(rx_adapter, rx_poll, rx_wrr);
+		rxa_calc_wrr_sequence(rx_adapter, rx_poll, rx_wrr, false);
 
 		rte_free(rx_adapter->eth_rx_poll);
 		rte_free(rx_adapter->wrr_sched);
@@ -3558,11 +3842,15 @@ rte_event_eth_rx_adapter_queue_conf_get(uint8_t id,
 
 	queue_conf->ev.event = queue_info->event;
 
-	queue_conf->vector_sz = queue_info->vector_data.max_vector_count;
-	queue_conf->vector_mp = queue_info->vector_data.vector_pool;
-	/* need to be converted from ticks to ns */
-	queue_conf->vector_timeout_ns = TICK2NSEC(
-		queue_info->vector_data.vector_timeout_ticks, rte_get_timer_hz());
+	if (queue_info->vector_data != NULL) {
+		queue_conf->vector_sz =
+			queue_info->vector_data[0].max_vector_count;
+		queue_conf->vector_mp = queue_info->vector_data[0].vector_pool;
+		/* need to be converted from ticks to ns */
+		queue_conf->vector_timeout_ns = TICK2NSEC(
+			queue_info->vector_data[0].vector_timeout_ticks,
+			rte_get_timer_hz());
+	}
 
 	if (queue_info->event_buf != NULL)
 		queue_conf->event_buf_size = queue_info->event_buf->events_size;
@@ -3722,6 +4010,24 @@ rte_event_eth_rx_adapter_runtime_params_set(uint8_t id,
 
 	rte_spinlock_lock(&rxa->rx_lock);
 	rxa->max_nb_rx = params->max_nb_rx;
+
+	rxa->idle_polls = params->idle_polls;
+	rxa->idle_wait_us = params->idle_wait_us;
+	rxa->idle_wait_ticks = (uint64_t)params->idle_wait_us *
+			       rte_get_tsc_hz() / US_PER_S;
+	rxa->nb_empty_polls = 0;
+	rte_cpu_get_intrinsics_support(&rxa->intrinsics);
+
+	if (rxa->weight_update_ms != params->weight_update_ms) {
+		rxa->weight_update_ms = params->weight_update_ms;
+		rxa->wt_update_ticks = (uint64_t)params->weight_update_ms *
+				       rte_get_timer_hz() / MS_PER_S;
+		rxa->wt_update_ts = rte_get_timer_cycles();
+		/* Restart from the configured weights */
+		rxa_calc_wrr_sequence(rxa, rxa->eth_rx_poll, rxa->wrr_sched,
+				      false);
+		rxa->wrr_pos = 0;
+	}
 	rte_spinlock_unlock(&rxa->rx_lock);
 
 	return 0;
@@ -3750,6 +4056,9 @@ rte_event_eth_rx_adapter_runtime_params_get(uint8_t id,
 		return ret;
 
 	params->max_nb_rx = rxa->max_nb_rx;
+	params->idle_polls = rxa->idle_polls;
+	params->idle_wait_us = rxa->idle_wait_us;
+	params->weight_update_ms = rxa->weight_update_ms;
 
 	return 0;
 }
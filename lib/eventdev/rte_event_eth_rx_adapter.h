@@ -326,7 +326,37 @@ struct rte_event_eth_rx_adapter_runtime_params {
 	 * This is valid for the devices without
 	 * RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT capability.
 	 */
-	uint32_t rsvd[15];
+	uint32_t idle_polls;
+	/**< Number of consecutive service function calls finding no packet
+	 * after which the adapter considers its Rx queues idle. While idle,
+	 * each service function call waits for up to idle_wait_us before
+	 * returning: the CPU is put in a power optimized state, monitoring
+	 * the Rx descriptors of the polled queues when the CPU and the
+	 * ethernet devices support it, or paused otherwise.
+	 * A packet received ends the idle period.
+	 *
+	 * Default value is 0, disabling the idle waits.
+	 * This is valid for the devices without
+	 * RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT capability.
+	 */
+	uint32_t idle_wait_us;
+	/**< Maximum time in microseconds waited by an idle service function
+	 * call, which bounds the latency added to the first packets received
+	 * when the Rx queues cannot be monitored.
+	 * Valid when idle_polls is not 0.
+	 */
+	uint32_t weight_update_ms;
+	/**< Period in milliseconds at which the servicing weights of the
+	 * polled Rx queues are recomputed from the number of packets received
+	 * on each queue during the period. The sum of the weights is kept,
+	 * the busiest queues getting the largest shares, with a weight of at
+	 * least 1 per queue. The weights are not updated over a period without
+	 * any packet.
+	 *
+	 * Default value is 0, meaning the servicing weights set with
+	 * rte_event_eth_rx_adapter_queue_add() are used.
+	 */
+	uint32_t rsvd[12];
 	/**< Reserved fields for future use */
 };
 
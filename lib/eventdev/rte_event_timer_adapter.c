@@ -21,6 +21,7 @@
 #include <rte_service_component.h>
 #include <rte_telemetry.h>
 #include <rte_reciprocal.h>
+#include <rte_spinlock.h>
 
 #include "event_timer_adapter_pmd.h"
 #include "eventdev_pmd.h"
@@ -619,6 +620,43 @@ event_buffer_flush(struct event_buffer *bufp, uint8_t dev_id, uint8_t port_id,
 	bufp->tail = bufp->tail + *nb_events_flushed + *nb_events_inv;
 }
 
+/*
+ * Software event timer adapter timer wheels
+ */
+
+/* Each level of a wheel has SWTIM_WHEEL_SLOTS slots, and a slot of level n
+ * covers 2^(n * SWTIM_WHEEL_BITS) adapter ticks. The timers expiring beyond
+ * the wheel range are parked in the top level until they get in range.
+ */
+#define SWTIM_WHEEL_BITS 6
+#define SWTIM_WHEEL_SLOTS (1 << SWTIM_WHEEL_BITS)
+#define SWTIM_WHEEL_MASK (SWTIM_WHEEL_SLOTS - 1)
+#define SWTIM_WHEEL_LEVELS 5
+#define SWTIM_WHEEL_RANGE (1ULL << (SWTIM_WHEEL_BITS * SWTIM_WHEEL_LEVELS))
+
+struct swtim_wheel;
+
+struct swtim_wheel_tim {
+	struct swtim_wheel_tim *next;
+	struct swtim_wheel_tim **pprev;
+	/* Adapter tick at which the timer is processed */
+	uint64_t expiry;
+	/* Timer cycle count at which the timer expires */
+	uint64_t expire_cycles;
+	struct rte_event_timer *evtim;
+	/* Wheel the timer is linked in */
+	struct swtim_wheel *wheel;
+};
+
+struct __rte_cache_aligned swtim_wheel {
+	rte_spinlock_t lock;
+	/* Next adapter tick to be processed */
+	uint64_t cur_tick;
+	/* Number of timers linked in the wheel */
+	uint32_t nb_timers;
+	struct swtim_wheel_tim *slots[SWTIM_WHEEL_LEVELS][SWTIM_WHEEL_SLOTS];
+};
+
 /*
  * Software event timer adapter implementation
  */
@@ -652,9 +690,14 @@ struct swtim {
 	/* The number of lists that should be polled */
 	RTE_ATOMIC(int) n_poll_lcores;
 	/* Timers which have expired and can be returned to a mempool */
-	struct rte_timer *expired_timers[EXP_TIM_BUF_SZ];
+	void *expired_timers[EXP_TIM_BUF_SZ];
 	/* The number of timers that can be returned to a mempool */
 	size_t n_expired_timers;
+	/* Timer wheel of each lcore, if the adapter uses timer wheels */
+	struct swtim_wheel *wheels;
+	/* Number of timer cycles per adapter tick, used by the wheels */
+	uint64_t tick_cycles;
+	struct rte_reciprocal_u64 tick_cycles_inverse;
 };
 
 static inline struct swtim *
@@ -750,6 +793,19 @@ swtim_callback(struct rte_timer *tim)
 	}
 }
 
+static __rte_always_inline int
+check_timeout_ticks(const struct rte_event_timer *evtim, const struct swtim *sw)
+{
+	uint64_t timeout_nsecs = evtim->timeout_ticks * sw->timer_tick_ns;
+
+	if (timeout_nsecs > sw->max_tmo_ns)
+		return -1;
+	if (timeout_nsecs < sw->timer_tick_ns)
+		return -2;
+
+	return 0;
+}
+
 static __rte_always_inline int
 get_timeout_cycles(struct rte_event_timer *evtim,
 		   const struct rte_event_timer_adapter *adapter,
@@ -761,15 +817,15 @@ get_timeout_cycles(struct rte_event_timer *evtim,
 	uint64_t secs, timeout_nsecs;
 	uint64_t nsecpersec;
 	struct swtim *sw;
+	int ret;
 
 	sw = swtim_pmd_priv(adapter);
 	nsecpersec = (uint64_t)NSECPERSEC;
 
+	ret = check_timeout_ticks(evtim, sw);
+	if (ret < 0)
+		return ret;
 	timeout_nsecs = evtim->timeout_ticks * sw->timer_tick_ns;
-	if (timeout_nsecs > sw->max_tmo_ns)
-		return -1;
-	if (timeout_nsecs < sw->timer_tick_ns)
-		return -2;
 
 	/* Set these values in the first invocation */
 	if (!timer_hz) {
@@ -850,6 +906,172 @@ check_destination_event_queue(struct rte_event_timer *evtim,
 	return -1;
 }
 
+static inline uint64_t
+swtim_wheel_cur_tick(const struct swtim *sw, uint64_t cycles)
+{
+	return rte_reciprocal_divide_u64(cycles, &sw->tick_cycles_inverse);
+}
+
+/* Link a timer in the slot matching its expiry, the wheel lock must be held. */
+static inline void
+swtim_wheel_link(struct swtim_wheel *wheel, struct swtim_wheel_tim *tim)
+{
+	struct swtim_wheel_tim **slot;
+	unsigned int level = 0;
+	uint64_t expiry, delta;
+
+	expiry = RTE_MAX(tim->expiry, wheel->cur_tick);
+	delta = expiry - wheel->cur_tick;
+	if (unlikely(delta >= SWTIM_WHEEL_RANGE)) {
+		expiry = wheel->cur_tick + SWTIM_WHEEL_RANGE - 1;
+		delta = SWTIM_WHEEL_RANGE - 1;
+	}
+
+	while (delta >> ((level + 1) * SWTIM_WHEEL_BITS))
+		level++;
+
+	slot = &wheel->slots[level][(expiry >> (level * SWTIM_WHEEL_BITS)) &
+				    SWTIM_WHEEL_MASK];
+	tim->next = *slot;
+	if (tim->next != NULL)
+		tim->next->pprev = &tim->next;
+	tim->pprev = slot;
+	*slot = tim;
+}
+
+static inline void
+swtim_wheel_unlink(struct swtim_wheel_tim *tim)
+{
+	*tim->pprev = tim->next;
+	if (tim->next != NULL)
+		tim->next->pprev = tim->pprev;
+}
+
+/* Buffer the expiry event of a timer linked in the current slot of a wheel,
+ * and unlink it unless it is periodic.
+ */
+static inline int
+swtim_wheel_fire(struct swtim *sw, struct swtim_wheel *wheel,
+		 struct swtim_wheel_tim *tim, bool periodic)
+{
+	struct rte_event_timer_adapter *adapter = sw->adapter;
+	struct rte_event_timer *evtim = tim->evtim;
+	uint16_t nb_evs_flushed = 0;
+	uint16_t nb_evs_invalid = 0;
+
+	if (unlikely(event_buffer_add(&sw->buffer, &evtim->ev) < 0)) {
+		/* Leave the timer in its slot, it is processed again on the
+		 * next adapter tick.
+		 */
+		sw->stats.evtim_retry_count++;
+		return -1;
+	}
+
+	swtim_wheel_unlink(tim);
+	if (periodic) {
+		tim->expiry = wheel->cur_tick + evtim->timeout_ticks;
+		tim->expire_cycles += evtim->timeout_ticks * sw->tick_cycles;
+		swtim_wheel_link(wheel, tim);
+	} else {
+		if (unlikely(sw->n_expired_timers == EXP_TIM_BUF_SZ)) {
+			rte_mempool_put_bulk(sw->tim_pool,
+					     (void **)sw->expired_timers,
+					     sw->n_expired_timers);
+			sw->n_expired_timers = 0;
+		}
+		sw->expired_timers[sw->n_expired_timers++] = tim;
+		wheel->nb_timers--;
+		rte_atomic_store_explicit(&evtim->state,
+				RTE_EVENT_TIMER_NOT_ARMED,
+				rte_memory_order_release);
+	}
+	sw->stats.evtim_exp_count++;
+
+	if (event_buffer_batch_ready(&sw->buffer)) {
+		event_buffer_flush(&sw->buffer,
+				   adapter->data->event_dev_id,
+				   adapter->data->event_port_id,
+				   &nb_evs_flushed,
+				   &nb_evs_invalid);
+
+		sw->stats.ev_enq_count += nb_evs_flushed;
+		sw->stats.ev_inv_count += nb_evs_invalid;
+	}
+
+	return 0;
+}
+
+/* Process the ticks of a wheel up to the given one, cascading the timers of
+ * the higher levels into the lower ones when the lower level wraps around.
+ */
+static int
+swtim_wheel_expire(struct swtim *sw, struct swtim_wheel *wheel,
+		   uint64_t now_tick, bool periodic)
+{
+	struct swtim_wheel_tim *tim, *next, **slot;
+	unsigned int level;
+	uint64_t tick;
+
+	while (wheel->cur_tick <= now_tick) {
+		if (wheel->nb_timers == 0) {
+			wheel->cur_tick = now_tick + 1;
+			break;
+		}
+
+		tick = wheel->cur_tick;
+		for (level = SWTIM_WHEEL_LEVELS - 1; level > 0; level--) {
+			if (tick & ((1ULL << (level * SWTIM_WHEEL_BITS)) - 1))
+				continue;
+
+			slot = &wheel->slots[level][(tick >>
+					(level * SWTIM_WHEEL_BITS)) &
+					SWTIM_WHEEL_MASK];
+			tim = *slot;
+			*slot = NULL;
+			for (; tim != NULL; tim = next) {
+				next = tim->next;
+				swtim_wheel_link(wheel, tim);
+			}
+		}
+
+		slot = &wheel->slots[0][tick & SWTIM_WHEEL_MASK];
+		while (*slot != NULL)
+			if (swtim_wheel_fire(sw, wheel, *slot, periodic) < 0)
+				return -1;
+
+		wheel->cur_tick++;
+	}
+
+	return 0;
+}
+
+static void
+swtim_wheel_manage(struct swtim *sw)
+{
+	bool periodic = get_timer_type(sw->adapter) == PERIODICAL;
+	struct swtim_wheel *wheel;
+	uint64_t now_tick;
+	unsigned int lcore;
+	int i, n_lcores;
+	int ret;
+
+	now_tick = swtim_wheel_cur_tick(sw, rte_get_timer_cycles());
+	n_lcores = rte_atomic_load_explicit(&sw->n_poll_lcores,
+					    rte_memory_order_relaxed);
+
+	for (i = 0; i < n_lcores; i++) {
+		lcore = rte_atomic_load_explicit(&sw->poll_lcores[i],
+						 rte_memory_order_relaxed);
+		wheel = &sw->wheels[lcore];
+
+		rte_spinlock_lock(&wheel->lock);
+		ret = swtim_wheel_expire(sw, wheel, now_tick, periodic);
+		rte_spinlock_unlock(&wheel->lock);
+		if (ret < 0)
+			break;
+	}
+}
+
 static int
 swtim_service_func(void *arg)
 {
@@ -860,10 +1082,13 @@ swtim_service_func(void *arg)
 	const uint64_t prior_enq_count = sw->stats.ev_enq_count;
 
 	if (swtim_did_tick(sw)) {
-		rte_timer_alt_manage(sw->timer_data_id,
-				     (unsigned int *)(uintptr_t)sw->poll_lcores,
-				     sw->n_poll_lcores,
-				     swtim_callback);
+		if (sw->wheels != NULL)
+			swtim_wheel_manage(sw);
+		else
+			rte_timer_alt_manage(sw->timer_data_id,
+				(unsigned int *)(uintptr_t)sw->poll_lcores,
+				sw->n_poll_lcores,
+				swtim_callback);
 
 		/* Return expired timer objects back to mempool */
 		rte_mempool_put_bulk(sw->tim_pool, (void **)sw->expired_timers,
@@ -924,6 +1149,7 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	int i, ret;
 	struct swtim *sw;
 	unsigned int flags;
+	size_t tim_size;
 	struct rte_service_spec service;
 
 	/* Allocate storage for private data area */
@@ -946,6 +1172,28 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	sw->timer_tick_ns = adapter->data->conf.timer_tick_ns;
 	sw->max_tmo_ns = adapter->data->conf.max_tmo_ns;
 
+	if (adapter->data->conf.flags & RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL) {
+		sw->wheels = rte_zmalloc_socket(swtim_name,
+				sizeof(struct swtim_wheel) * RTE_MAX_LCORE,
+				RTE_CACHE_LINE_SIZE, adapter->data->socket_id);
+		if (sw->wheels == NULL) {
+			EVTIM_LOG_ERR("failed to allocate timer wheels");
+			rte_errno = ENOMEM;
+			goto free_alloc;
+		}
+
+		for (i = 0; i < RTE_MAX_LCORE; i++)
+			rte_spinlock_init(&sw->wheels[i].lock);
+
+		sw->tick_cycles = RTE_MAX((uint64_t)(sw->timer_tick_ns *
+				(rte_get_timer_hz() / NSECPERSEC)), UINT64_C(1));
+		sw->tick_cycles_inverse =
+			rte_reciprocal_value_u64(sw->tick_cycles);
+		tim_size = sizeof(struct swtim_wheel_tim);
+	} else {
+		tim_size = sizeof(struct rte_timer);
+	}
+
 	/* Create a timer pool */
 	char pool_name[SWTIM_NAMESIZE];
 	snprintf(pool_name, SWTIM_NAMESIZE, "swtim_pool_%"PRIu8,
@@ -957,7 +1205,7 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 				adapter->data->conf.nb_timers, nb_timers);
 	flags = 0; /* pool is multi-producer, multi-consumer */
 	sw->tim_pool = rte_mempool_create(pool_name, pool_size,
-			sizeof(struct rte_timer), cache_size, 0, NULL, NULL,
+			tim_size, cache_size, 0, NULL, NULL,
 			NULL, NULL, adapter->data->socket_id, flags);
 	if (sw->tim_pool == NULL) {
 		EVTIM_LOG_ERR("failed to create timer object mempool");
@@ -969,23 +1217,27 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	for (i = 0; i < RTE_MAX_LCORE; i++)
 		sw->in_use[i].v = 0;
 
-	/* Initialize the timer subsystem and allocate timer data instance */
-	ret = rte_timer_subsystem_init();
-	if (ret < 0) {
-		if (ret != -EALREADY) {
-			EVTIM_LOG_ERR("failed to initialize timer subsystem");
+	/* Initialize the timer subsystem and allocate timer data instance,
+	 * unless the timers are kept in the adapter wheels.
+	 */
+	if (sw->wheels == NULL) {
+		ret = rte_timer_subsystem_init();
+		if (ret < 0) {
+			if (ret != -EALREADY) {
+				EVTIM_LOG_ERR("failed to initialize timer subsystem");
+				rte_errno = -ret;
+				goto free_mempool;
+			}
+		}
+
+		ret = rte_timer_data_alloc(&sw->timer_data_id);
+		if (ret < 0) {
+			EVTIM_LOG_ERR("failed to allocate timer data instance");
 			rte_errno = -ret;
 			goto free_mempool;
 		}
 	}
 
-	ret = rte_timer_data_alloc(&sw->timer_data_id);
-	if (ret < 0) {
-		EVTIM_LOG_ERR("failed to allocate timer data instance");
-		rte_errno = -ret;
-		goto free_mempool;
-	}
-
 	/* Initialize timer event buffer */
 	event_buffer_init(&sw->buffer);
 
@@ -1006,7 +1258,7 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 			      ret);
 
 		rte_errno = ENOSPC;
-		goto free_mempool;
+		goto free_timer_data;
 	}
 
 	EVTIM_LOG_DBG("registered service %s with id %"PRIu32, service.name,
@@ -1016,9 +1268,13 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	adapter->data->service_inited = 1;
 
 	return 0;
+free_timer_data:
+	if (sw->wheels == NULL)
+		rte_timer_data_dealloc(sw->timer_data_id);
 free_mempool:
 	rte_mempool_free(sw->tim_pool);
 free_alloc:
+	rte_free(sw->wheels);
 	rte_free(sw);
 	return -1;
 }
@@ -1031,6 +1287,28 @@ swtim_free_tim(struct rte_timer *tim, void *arg)
 	rte_mempool_put(sw->tim_pool, tim);
 }
 
+static void
+swtim_wheel_free_tims(struct swtim *sw)
+{
+	struct swtim_wheel_tim *tim, *next;
+	struct swtim_wheel *wheel;
+	int i, level, slot;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++) {
+		wheel = &sw->wheels[i];
+		for (level = 0; level < SWTIM_WHEEL_LEVELS; level++)
+			for (slot = 0; slot < SWTIM_WHEEL_SLOTS; slot++) {
+				tim = wheel->slots[level][slot];
+				for (; tim != NULL; tim = next) {
+					next = tim->next;
+					rte_mempool_put(sw->tim_pool, tim);
+				}
+				wheel->slots[level][slot] = NULL;
+			}
+		wheel->nb_timers = 0;
+	}
+}
+
 /* Traverse the list of outstanding timers and put them back in the mempool
  * before freeing the adapter to avoid leaking the memory.
  */
@@ -1041,16 +1319,20 @@ swtim_uninit(struct rte_event_timer_adapter *adapter)
 	struct swtim *sw = swtim_pmd_priv(adapter);
 
 	/* Free outstanding timers */
-	rte_timer_stop_all(sw->timer_data_id,
-			   (unsigned int *)(uintptr_t)sw->poll_lcores,
-			   sw->n_poll_lcores,
-			   swtim_free_tim,
-			   sw);
+	if (sw->wheels != NULL) {
+		swtim_wheel_free_tims(sw);
+	} else {
+		rte_timer_stop_all(sw->timer_data_id,
+				   (unsigned int *)(uintptr_t)sw->poll_lcores,
+				   sw->n_poll_lcores,
+				   swtim_free_tim,
+				   sw);
 
-	ret = rte_timer_data_dealloc(sw->timer_data_id);
-	if (ret < 0) {
-		EVTIM_LOG_ERR("failed to deallocate timer data instance");
-		return ret;
+		ret = rte_timer_data_dealloc(sw->timer_data_id);
+		if (ret < 0) {
+			EVTIM_LOG_ERR("failed to deallocate timer data instance");
+			return ret;
+		}
 	}
 
 	ret = rte_service_component_unregister(sw->service_id);
@@ -1060,6 +1342,7 @@ swtim_uninit(struct rte_event_timer_adapter *adapter)
 	}
 
 	rte_mempool_free(sw->tim_pool);
+	rte_free(sw->wheels);
 	rte_free(sw);
 	adapter->data->adapter_priv = NULL;
 
@@ -1153,8 +1436,8 @@ swtim_remaining_ticks_get(const struct rte_event_timer_adapter *adapter,
 	uint64_t nsecs_per_adapter_tick, opaque, cycles_remaining;
 	enum rte_event_timer_state n_state;
 	double nsecs_per_cycle;
-	struct rte_timer *tim;
 	uint64_t cur_cycles;
+	uint64_t expire;
 
 	/* Check that timer is armed */
 	n_state = rte_atomic_load_explicit(&evtim->state, rte_memory_order_acquire);
@@ -1162,15 +1445,18 @@ swtim_remaining_ticks_get(const struct rte_event_timer_adapter *adapter,
 		return -EINVAL;
 
 	opaque = evtim->impl_opaque[0];
-	tim = (struct rte_timer *)(uintptr_t)opaque;
+	if (swtim_pmd_priv(adapter)->wheels != NULL)
+		expire = ((struct swtim_wheel_tim *)(uintptr_t)opaque)->expire_cycles;
+	else
+		expire = ((struct rte_timer *)(uintptr_t)opaque)->expire;
 
 	cur_cycles = rte_get_timer_cycles();
-	if (cur_cycles > tim->expire) {
+	if (cur_cycles > expire) {
 		*ticks_remaining = 0;
 		return 0;
 	}
 
-	cycles_remaining = tim->expire - cur_cycles;
+	cycles_remaining = expire - cur_cycles;
 	nsecs_per_cycle = (double)NSECPERSEC / rte_get_timer_hz();
 	nsecs_per_adapter_tick = adapter->data->conf.timer_tick_ns;
 
@@ -1180,29 +1466,13 @@ swtim_remaining_ticks_get(const struct rte_event_timer_adapter *adapter,
 	return 0;
 }
 
-static uint16_t
-__swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
-		struct rte_event_timer **evtims,
-		uint16_t nb_evtims)
+static inline uint32_t
+swtim_arm_lcore_get(struct swtim *sw)
 {
-	int i, ret;
-	struct swtim *sw = swtim_pmd_priv(adapter);
 	uint32_t lcore_id = rte_lcore_id();
-	struct rte_timer *tim, *tims[nb_evtims];
-	uint64_t cycles;
 	int n_lcores;
 	/* Timer list for this lcore is not in use. */
 	uint16_t exp_state = 0;
-	enum rte_event_timer_state n_state;
-	enum rte_timer_type type = SINGLE;
-
-#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
-	/* Check that the service is running. */
-	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
-		rte_errno = EINVAL;
-		return 0;
-	}
-#endif
 
 	/* Adjust lcore_id if non-EAL thread. Arbitrarily pick the timer list of
 	 * the highest lcore to insert such timers into
@@ -1227,6 +1497,132 @@ __swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
 				rte_memory_order_relaxed);
 	}
 
+	return lcore_id;
+}
+
+static uint16_t
+swtim_wheel_arm_burst(const struct rte_event_timer_adapter *adapter,
+		      struct rte_event_timer **evtims,
+		      uint16_t nb_evtims)
+{
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	struct swtim_wheel_tim *tim, *tims[nb_evtims];
+	enum rte_event_timer_state n_state;
+	struct swtim_wheel *wheel;
+	uint64_t cycles, now_tick;
+	int i, ret;
+
+	wheel = &sw->wheels[swtim_arm_lcore_get(sw)];
+
+	ret = rte_mempool_get_bulk(sw->tim_pool, (void **)tims,
+				   nb_evtims);
+	if (ret < 0) {
+		rte_errno = ENOSPC;
+		return 0;
+	}
+
+	cycles = rte_get_timer_cycles();
+	now_tick = swtim_wheel_cur_tick(sw, cycles);
+
+	rte_spinlock_lock(&wheel->lock);
+
+	/* An empty wheel may lag behind if the service did not visit it */
+	if (wheel->nb_timers == 0)
+		wheel->cur_tick = now_tick;
+
+	for (i = 0; i < nb_evtims; i++) {
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (!(n_state == RTE_EVENT_TIMER_NOT_ARMED ||
+			     n_state == RTE_EVENT_TIMER_CANCELED)) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(check_destination_event_queue(evtims[i],
+							   adapter) < 0)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		ret = check_timeout_ticks(evtims[i], sw);
+		if (unlikely(ret == -1)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOLATE,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		} else if (unlikely(ret == -2)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOEARLY,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		/* The timer is processed on the first adapter tick following
+		 * its expiry, as with the timer library.
+		 */
+		tim = tims[i];
+		tim->evtim = evtims[i];
+		tim->wheel = wheel;
+		tim->expiry = now_tick + evtims[i]->timeout_ticks + 1;
+		tim->expire_cycles = cycles +
+				evtims[i]->timeout_ticks * sw->tick_cycles;
+		swtim_wheel_link(wheel, tim);
+
+		evtims[i]->impl_opaque[0] = (uintptr_t)tim;
+		evtims[i]->impl_opaque[1] = (uintptr_t)adapter;
+
+		EVTIM_LOG_DBG("armed an event timer");
+		/* RELEASE ordering guarantees the adapter specific value
+		 * changes observed before the update of state.
+		 */
+		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_ARMED,
+				rte_memory_order_release);
+	}
+
+	wheel->nb_timers += i;
+	rte_spinlock_unlock(&wheel->lock);
+
+	if (i < nb_evtims)
+		rte_mempool_put_bulk(sw->tim_pool,
+				     (void **)&tims[i], nb_evtims - i);
+
+	return i;
+}
+
+static uint16_t
+__swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
+		struct rte_event_timer **evtims,
+		uint16_t nb_evtims)
+{
+	int i, ret;
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	uint32_t lcore_id;
+	struct rte_timer *tim, *tims[nb_evtims];
+	uint64_t cycles;
+	enum rte_event_timer_state n_state;
+	enum rte_timer_type type = SINGLE;
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	if (sw->wheels != NULL)
+		return swtim_wheel_arm_burst(adapter, evtims, nb_evtims);
+
+	lcore_id = swtim_arm_lcore_get(sw);
+
 	ret = rte_mempool_get_bulk(sw->tim_pool, (void **)tims,
 				   nb_evtims);
 	if (ret < 0) {
@@ -1311,6 +1707,51 @@ swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
 	return __swtim_arm_burst(adapter, evtims, nb_evtims);
 }
 
+static uint16_t
+swtim_wheel_cancel_burst(struct swtim *sw, struct rte_event_timer **evtims,
+			 uint16_t nb_evtims)
+{
+	struct swtim_wheel_tim *tim;
+	enum rte_event_timer_state n_state;
+	struct swtim_wheel *wheel;
+	int i;
+
+	for (i = 0; i < nb_evtims; i++) {
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_CANCELED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (n_state != RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		tim = (struct swtim_wheel_tim *)(uintptr_t)evtims[i]->impl_opaque[0];
+		RTE_ASSERT(tim != NULL);
+		wheel = tim->wheel;
+
+		/* The timer may have expired since its state was read, in
+		 * which case its object has been released by the service.
+		 */
+		rte_spinlock_lock(&wheel->lock);
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_relaxed);
+		if (n_state != RTE_EVENT_TIMER_ARMED) {
+			rte_spinlock_unlock(&wheel->lock);
+			rte_errno = EINVAL;
+			break;
+		}
+		swtim_wheel_unlink(tim);
+		wheel->nb_timers--;
+		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_CANCELED,
+				rte_memory_order_release);
+		rte_spinlock_unlock(&wheel->lock);
+
+		rte_mempool_put(sw->tim_pool, tim);
+	}
+
+	return i;
+}
+
 static uint16_t
 swtim_cancel_burst(const struct rte_event_timer_adapter *adapter,
 		   struct rte_event_timer **evtims,
@@ -1330,6 +1771,9 @@ swtim_cancel_burst(const struct rte_event_timer_adapter *adapter,
 	}
 #endif
 
+	if (sw->wheels != NULL)
+		return swtim_wheel_cancel_burst(sw, evtims, nb_evtims);
+
 	for (i = 0; i < nb_evtims; i++) {
 		/* Don't modify the event timer state in these cases */
 		/* ACQUIRE ordering guarantees the access of implementation
@@ -157,6 +157,16 @@ enum rte_event_timer_adapter_clk_src {
  * @see struct rte_event_timer_adapter_conf::flags
  */
 
+#define RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL	(1ULL << 3)
+/**< Flag to make the software event timer adapter keep the armed timers in
+ * per lcore hierarchical timer wheels instead of the timer library skiplists.
+ * Arming and cancelling a timer is done in constant time, and the expired
+ * timers of a wheel are processed in bulk by the adapter service.
+ * This flag is ignored by the adapters with an internal port.
+ *
+ * @see struct rte_event_timer_adapter_conf::flags
+ */
+
 /**
  * Timer adapter configuration structure
  */
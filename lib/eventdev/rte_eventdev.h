@@ -505,6 +505,22 @@ struct rte_event;
  * @see rte_event_port_preschedule()
  */
 
+#define RTE_EVENT_DEV_CAP_EVENT_VECTOR RTE_BIT32(21)
+/**< Event device schedules vector events by their flow.
+ *
+ * When this flag is set, an event of type RTE_EVENT_TYPE_VECTOR is scheduled
+ * as a whole like any other event, according to the scheduling type of its
+ * queue and its flow identifier, without any cost depending on the number of
+ * objects in the vector.
+ * The software event ethernet Rx adapter then aggregates the packets of an
+ * Rx queue into several vectors, one per group of flows, instead of a single
+ * one, so that the vectors of an Rx queue can be scheduled atomically to
+ * different workers.
+ *
+ * @see rte_event_vector
+ * @see RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR
+ */
+
 /* Event device priority levels */
 #define RTE_EVENT_DEV_PRIORITY_HIGHEST   0
 /**< Highest priority level for events and queues.
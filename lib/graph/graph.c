@@ -17,6 +17,7 @@
 
 #include "graph_private.h"
 #include "graph_pcap_private.h"
+#include "graph_profile_private.h"
 
 static struct graph_head graph_list = STAILQ_HEAD_INITIALIZER(graph_list);
 static rte_spinlock_t graph_lock = RTE_SPINLOCK_INITIALIZER;
@@ -524,6 +525,8 @@ rte_graph_destroy(rte_graph_t id)
 
 			/* Call fini() of the all the nodes in the graph */
 			graph_node_fini(graph);
+			/* Release profiling memory if profiling was ever enabled */
+			graph_profile_fini(graph);
 			/* Destroy graph fast path memory */
 			rc = graph_fp_mem_destroy(graph);
 			if (rc)
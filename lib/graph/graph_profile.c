@@ -0,0 +1,457 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include <eal_export.h>
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_stdatomic.h>
+#include <rte_telemetry.h>
+#ifdef RTE_LIB_PMU
+#include <rte_pmu.h>
+#endif
+
+#include "graph_private.h"
+#include "graph_profile_private.h"
+
+static inline uint64_t
+graph_profile_pmu_read(unsigned int idx)
+{
+#ifdef RTE_LIB_PMU
+	return rte_pmu_read(idx);
+#else
+	RTE_SET_USED(idx);
+	return 0;
+#endif
+}
+
+uint16_t
+graph_profile_dispatch(struct rte_graph *graph, struct rte_node *node,
+		       void **objs, uint16_t nb_objs)
+{
+	uint64_t pmu_start[RTE_GRAPH_PROFILE_PMU_EVENTS_MAX];
+	struct graph_node_profile *prof = node->profile;
+	struct rte_graph_node_profile *data = &prof->data;
+	uint64_t start, cycles, per_obj;
+	unsigned int bucket;
+	uint16_t i, rc;
+
+	for (i = 0; i < data->nb_pmu_events; i++)
+		pmu_start[i] = graph_profile_pmu_read(prof->pmu_idx[i]);
+	start = rte_rdtsc();
+
+	rc = node->original_process(graph, node, objs, nb_objs);
+
+	cycles = rte_rdtsc() - start;
+	for (i = 0; i < data->nb_pmu_events; i++)
+		data->pmu[i] += graph_profile_pmu_read(prof->pmu_idx[i]) - pmu_start[i];
+
+	/* Source nodes are called with no objects, account what they produced */
+	per_obj = cycles / RTE_MAX(rc, 1);
+	bucket = RTE_MIN(rte_fls_u64(per_obj), RTE_GRAPH_PROFILE_HIST_BUCKETS - 1u);
+	data->hist[bucket]++;
+	data->calls++;
+	data->objs += rc;
+	data->cycles += cycles;
+
+	return rc;
+}
+
+static struct graph *
+graph_profile_graph_get(rte_graph_t id)
+{
+	struct graph *graph;
+
+	STAILQ_FOREACH(graph, graph_list_head_get(), next)
+		if (graph->id == id)
+			return graph;
+
+	return NULL;
+}
+
+static int
+graph_profile_pmu_setup(struct graph_profile *profile,
+			const struct rte_graph_profile_param *prm)
+{
+	uint16_t i;
+#ifdef RTE_LIB_PMU
+	rte_node_t n;
+	int idx;
+#endif
+
+	profile->nb_pmu_events = 0;
+	if (prm == NULL || prm->nb_pmu_events == 0)
+		return 0;
+
+	if (prm->nb_pmu_events > RTE_GRAPH_PROFILE_PMU_EVENTS_MAX || prm->pmu_events == NULL) {
+		graph_err("Invalid number of PMU events %u", prm->nb_pmu_events);
+		return -EINVAL;
+	}
+
+#ifdef RTE_LIB_PMU
+	if (rte_pmu_init() < 0) {
+		graph_err("PMU library init failed");
+		return -ENODEV;
+	}
+
+	for (i = 0; i < prm->nb_pmu_events; i++) {
+		if (prm->pmu_events[i] == NULL)
+			return -EINVAL;
+
+		idx = rte_pmu_add_event(prm->pmu_events[i]);
+		if (idx < 0) {
+			graph_err("PMU event %s not available", prm->pmu_events[i]);
+			return idx;
+		}
+		if (rte_strscpy(profile->pmu_events[i], prm->pmu_events[i],
+				GRAPH_PROFILE_EVENT_NAMESIZE) < 0)
+			return -E2BIG;
+
+		for (n = 0; n < profile->nb_nodes; n++)
+			profile->nodes[n].pmu_idx[i] = idx;
+	}
+	profile->nb_pmu_events = prm->nb_pmu_events;
+
+	return 0;
+#else
+	RTE_SET_USED(i);
+	graph_err("PMU events requested but PMU library is not available");
+	return -ENOTSUP;
+#endif
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_profile_enable, 25.07)
+int
+rte_graph_profile_enable(rte_graph_t id, const struct rte_graph_profile_param *prm)
+{
+	struct graph_profile *profile;
+	struct rte_graph *graph_fp;
+	struct rte_node *node;
+	struct graph *graph;
+	rte_graph_off_t off;
+	rte_node_t count;
+	int rc = -EINVAL;
+
+	graph_spinlock_lock();
+
+	graph = graph_profile_graph_get(id);
+	if (graph == NULL)
+		SET_ERR_JMP(EINVAL, fail, "Graph %u not found", id);
+
+	graph_fp = graph->graph;
+	if (graph_fp->pcap_enable) {
+		rc = -EBUSY;
+		SET_ERR_JMP(EBUSY, fail, "Graph %s has pcap trace enabled", graph->name);
+	}
+
+	if (graph_fp->profile_enable) {
+		rc = -EALREADY;
+		SET_ERR_JMP(EALREADY, fail, "Graph %s profiling already enabled", graph->name);
+	}
+
+	profile = graph->profile;
+	if (profile == NULL) {
+		profile = rte_zmalloc_socket(NULL, sizeof(*profile) +
+					     graph->node_count * sizeof(profile->nodes[0]),
+					     RTE_CACHE_LINE_SIZE, graph->socket);
+		if (profile == NULL) {
+			rc = -ENOMEM;
+			SET_ERR_JMP(ENOMEM, fail, "Failed to alloc profile memory");
+		}
+		graph->profile = profile;
+	} else {
+		memset(profile->nodes, 0, graph->node_count * sizeof(profile->nodes[0]));
+	}
+	profile->nb_nodes = graph->node_count;
+
+	rc = graph_profile_pmu_setup(profile, prm);
+	if (rc < 0)
+		SET_ERR_JMP(-rc, fail, "Graph %s PMU setup failed", graph->name);
+
+	rte_graph_foreach_node(count, off, graph_fp, node) {
+		profile->nodes[count].data.nb_pmu_events = profile->nb_pmu_events;
+		node->profile = &profile->nodes[count];
+		node->original_process = node->process;
+		/* Worker may be walking the graph, publish the wrapper last */
+		rte_atomic_thread_fence(rte_memory_order_release);
+		node->process = graph_profile_dispatch;
+	}
+	graph_fp->profile_enable = true;
+
+	graph_spinlock_unlock();
+	return 0;
+fail:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_profile_disable, 25.07)
+int
+rte_graph_profile_disable(rte_graph_t id)
+{
+	struct rte_graph *graph_fp;
+	struct rte_node *node;
+	struct graph *graph;
+	rte_graph_off_t off;
+	rte_node_t count;
+
+	graph_spinlock_lock();
+
+	graph = graph_profile_graph_get(id);
+	if (graph == NULL) {
+		graph_spinlock_unlock();
+		return -EINVAL;
+	}
+
+	graph_fp = graph->graph;
+	if (graph_fp->profile_enable) {
+		rte_graph_foreach_node(count, off, graph_fp, node)
+			node->process = node->original_process;
+		graph_fp->profile_enable = false;
+	}
+
+	graph_spinlock_unlock();
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_profile_is_enabled, 25.07)
+int
+rte_graph_profile_is_enabled(rte_graph_t id)
+{
+	struct graph *graph;
+	int rc = 0;
+
+	graph_spinlock_lock();
+	graph = graph_profile_graph_get(id);
+	if (graph != NULL)
+		rc = graph->graph->profile_enable;
+	graph_spinlock_unlock();
+
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_node_profile_get, 25.07)
+int
+rte_graph_node_profile_get(rte_graph_t id, rte_node_t node_id,
+			   struct rte_graph_node_profile *prof)
+{
+	struct rte_node *node;
+	struct graph *graph;
+	rte_graph_off_t off;
+	rte_node_t count;
+	int rc = -ENOENT;
+
+	if (prof == NULL)
+		return -EINVAL;
+
+	graph_spinlock_lock();
+
+	graph = graph_profile_graph_get(id);
+	if (graph == NULL) {
+		rc = -EINVAL;
+		goto done;
+	}
+
+	if (graph->profile == NULL)
+		goto done;
+
+	rte_graph_foreach_node(count, off, graph->graph, node) {
+		if (node->id != node_id)
+			continue;
+
+		*prof = graph->profile->nodes[count].data;
+		rc = 0;
+		break;
+	}
+done:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_profile_reset, 25.07)
+int
+rte_graph_profile_reset(rte_graph_t id)
+{
+	struct rte_graph_node_profile *data;
+	struct graph *graph;
+	rte_node_t count;
+	int rc = 0;
+
+	graph_spinlock_lock();
+
+	graph = graph_profile_graph_get(id);
+	if (graph == NULL) {
+		rc = -EINVAL;
+		goto done;
+	}
+
+	if (graph->profile == NULL)
+		goto done;
+
+	for (count = 0; count < graph->profile->nb_nodes; count++) {
+		data = &graph->profile->nodes[count].data;
+		data->calls = 0;
+		data->objs = 0;
+		data->cycles = 0;
+		memset(data->hist, 0, sizeof(data->hist));
+		memset(data->pmu, 0, sizeof(data->pmu));
+	}
+done:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+static void
+graph_profile_node_dump(FILE *f, const struct graph_profile *profile,
+			const struct rte_node *node, const struct rte_graph_node_profile *data)
+{
+	const double objs = RTE_MAX(data->objs, UINT64_C(1));
+	unsigned int i;
+
+	fprintf(f, "  node=%s calls=%" PRIu64 " objs=%" PRIu64 " cycles/obj=%.2f\n",
+		node->name, data->calls, data->objs, data->cycles / objs);
+
+	for (i = 0; i < data->nb_pmu_events; i++)
+		fprintf(f, "    %s/obj=%.2f\n", profile->pmu_events[i], data->pmu[i] / objs);
+
+	fprintf(f, "    cycles/obj histogram:");
+	for (i = 0; i < RTE_GRAPH_PROFILE_HIST_BUCKETS; i++) {
+		if (data->hist[i] == 0)
+			continue;
+		if (i == 0)
+			fprintf(f, " [0]=%" PRIu64, data->hist[i]);
+		else if (i == RTE_GRAPH_PROFILE_HIST_BUCKETS - 1)
+			fprintf(f, " [>=%" PRIu64 "]=%" PRIu64, RTE_BIT64(i - 1), data->hist[i]);
+		else
+			fprintf(f, " [%" PRIu64 "-%" PRIu64 "]=%" PRIu64, RTE_BIT64(i - 1),
+				RTE_BIT64(i) - 1, data->hist[i]);
+	}
+	fprintf(f, "\n");
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_profile_dump, 25.07)
+int
+rte_graph_profile_dump(FILE *f, rte_graph_t id)
+{
+	struct graph_profile *profile;
+	struct rte_node *node;
+	struct graph *graph;
+	rte_graph_off_t off;
+	rte_node_t count;
+	int rc = 0;
+
+	graph_spinlock_lock();
+
+	graph = graph_profile_graph_get(id);
+	if (graph == NULL) {
+		rc = -EINVAL;
+		goto done;
+	}
+
+	profile = graph->profile;
+	fprintf(f, "graph <%s> profile %s\n", graph->name,
+		graph->graph->profile_enable ? "enabled" : "disabled");
+	if (profile == NULL)
+		goto done;
+
+	rte_graph_foreach_node(count, off, graph->graph, node) {
+		if (profile->nodes[count].data.calls == 0)
+			continue;
+		graph_profile_node_dump(f, profile, node, &profile->nodes[count].data);
+	}
+done:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+void
+graph_profile_fini(struct graph *graph)
+{
+	rte_free(graph->profile);
+	graph->profile = NULL;
+}
+
+static int
+graph_profile_tel_node_add(struct rte_tel_data *d, const struct graph_profile *profile,
+			   const struct rte_node *node,
+			   const struct rte_graph_node_profile *data)
+{
+	struct rte_tel_data *node_data, *hist;
+	unsigned int i;
+
+	node_data = rte_tel_data_alloc();
+	if (node_data == NULL)
+		return -ENOMEM;
+
+	hist = rte_tel_data_alloc();
+	if (hist == NULL) {
+		rte_tel_data_free(node_data);
+		return -ENOMEM;
+	}
+
+	rte_tel_data_start_dict(node_data);
+	rte_tel_data_add_dict_uint(node_data, "calls", data->calls);
+	rte_tel_data_add_dict_uint(node_data, "objs", data->objs);
+	rte_tel_data_add_dict_uint(node_data, "cycles", data->cycles);
+	for (i = 0; i < data->nb_pmu_events; i++)
+		rte_tel_data_add_dict_uint(node_data, profile->pmu_events[i], data->pmu[i]);
+
+	rte_tel_data_start_array(hist, RTE_TEL_UINT_VAL);
+	for (i = 0; i < RTE_GRAPH_PROFILE_HIST_BUCKETS; i++)
+		rte_tel_data_add_array_uint(hist, data->hist[i]);
+	rte_tel_data_add_dict_container(node_data, "cycles_per_obj_hist", hist, 0);
+
+	return rte_tel_data_add_dict_container(d, node->name, node_data, 0);
+}
+
+static int
+graph_handle_graph_profile(const char *cmd __rte_unused, const char *params,
+			   struct rte_tel_data *d)
+{
+	struct graph_profile *profile;
+	struct graph *graph, *tmp;
+	struct rte_node *node;
+	rte_graph_off_t off;
+	rte_node_t count;
+	int rc = 0;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	graph_spinlock_lock();
+
+	graph = NULL;
+	STAILQ_FOREACH(tmp, graph_list_head_get(), next)
+		if (strncmp(tmp->name, params, RTE_GRAPH_NAMESIZE) == 0) {
+			graph = tmp;
+			break;
+		}
+
+	if (graph == NULL || graph->profile == NULL) {
+		rc = -EINVAL;
+		goto done;
+	}
+
+	profile = graph->profile;
+	rte_tel_data_start_dict(d);
+	rte_graph_foreach_node(count, off, graph->graph, node) {
+		rc = graph_profile_tel_node_add(d, profile, node, &profile->nodes[count].data);
+		if (rc < 0)
+			break;
+	}
+done:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+RTE_INIT(graph_init_telemetry)
+{
+	rte_telemetry_register_cmd("/graph/profile", graph_handle_graph_profile,
+			"Returns per node profiling data of a graph. Parameters: string graph_name");
+}
@@ -0,0 +1,71 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_GRAPH_PROFILE_PRIVATE_H_
+#define _RTE_GRAPH_PROFILE_PRIVATE_H_
+
+#include <stdint.h>
+
+#include "graph_private.h"
+
+#define GRAPH_PROFILE_EVENT_NAMESIZE 64
+
+/**
+ * @internal
+ *
+ * Structure that holds the profiling data of a node within a graph.
+ */
+struct __rte_cache_aligned graph_node_profile {
+	struct rte_graph_node_profile data; /**< Data reported to application. */
+	unsigned int pmu_idx[RTE_GRAPH_PROFILE_PMU_EVENTS_MAX];
+	/**< PMU library event indexes. */
+};
+
+/**
+ * @internal
+ *
+ * Structure that holds the profiling data of a graph.
+ */
+struct graph_profile {
+	uint16_t nb_pmu_events; /**< Number of PMU events. */
+	char pmu_events[RTE_GRAPH_PROFILE_PMU_EVENTS_MAX][GRAPH_PROFILE_EVENT_NAMESIZE];
+	/**< Names of the PMU events. */
+	rte_node_t nb_nodes; /**< Number of entries in nodes[]. */
+	struct graph_node_profile nodes[]; /**< Per node profiling data. */
+};
+
+/**
+ * @internal
+ *
+ * Release the profiling memory of a graph.
+ *
+ * @param graph
+ *   Pointer to graph structure.
+ */
+void graph_profile_fini(struct graph *graph);
+
+/**
+ * @internal
+ *
+ * Record cycles and PMU events of a node process() call.
+ *
+ * When graph profiling is enabled, this function is invoked in place of the
+ * node process() function and calls the original one.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object.
+ * @param objs
+ *   Pointer to an array of objects to be processed.
+ * @param nb_objs
+ *   Number of objects in the array.
+ *
+ * @return
+ *   Return value of the original process() function.
+ */
+uint16_t graph_profile_dispatch(struct rte_graph *graph, struct rte_node *node,
+				void **objs, uint16_t nb_objs);
+
+#endif /* _RTE_GRAPH_PROFILE_PRIVATE_H_ */
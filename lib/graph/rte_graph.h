@@ -466,6 +466,151 @@ void rte_graph_cluster_stats_get(struct rte_graph_cluster_stats *stat,
  */
 void rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat);
 
+#define RTE_GRAPH_PROFILE_HIST_BUCKETS 16
+/**< Number of log2 buckets in the cycles per object histogram. */
+#define RTE_GRAPH_PROFILE_PMU_EVENTS_MAX 4
+/**< Max number of PMU events sampled per node. */
+
+/**
+ * Structure to hold configuration parameters for graph profiling.
+ *
+ * @see rte_graph_profile_enable()
+ */
+struct rte_graph_profile_param {
+	uint16_t nb_pmu_events; /**< Number of PMU events, zero for cycles only. */
+	const char **pmu_events;
+	/**< Array of PMU event names as listed under
+	 *   /sys/bus/event_source/devices/<pmu>/events, e.g. "instructions".
+	 */
+};
+
+/**
+ * Per node profiling data.
+ *
+ * @see rte_graph_node_profile_get()
+ */
+struct rte_graph_node_profile {
+	uint64_t calls;  /**< Number of profiled process() calls. */
+	uint64_t objs;   /**< Number of objects processed by profiled calls. */
+	uint64_t cycles; /**< Cycles spent in profiled calls. */
+	uint64_t hist[RTE_GRAPH_PROFILE_HIST_BUCKETS];
+	/**< Calls binned by cycles per object, bucket n counts calls that took
+	 *   [2^(n-1), 2^n) cycles per object. The last bucket also counts overflows.
+	 */
+	uint16_t nb_pmu_events; /**< Number of valid entries in pmu[]. */
+	uint64_t pmu[RTE_GRAPH_PROFILE_PMU_EVENTS_MAX];
+	/**< PMU event counts accumulated over profiled calls, in the order of
+	 *   struct rte_graph_profile_param::pmu_events.
+	 */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enable per node profiling on a graph.
+ *
+ * Every node process() call of the graph is wrapped to record the cycles per
+ * object histogram and, when PMU events are requested and the PMU library is
+ * available, the per node deltas of those events.
+ * It cannot be combined with the pcap trace of the graph.
+ *
+ * Profiling data is kept until the graph is destroyed, so it can still be
+ * read after rte_graph_profile_disable(). Enabling profiling again resets it.
+ *
+ * @param id
+ *   Graph id to profile.
+ * @param prm
+ *   Profiling parameters. NULL records cycles only.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ */
+__rte_experimental
+int rte_graph_profile_enable(rte_graph_t id, const struct rte_graph_profile_param *prm);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Disable per node profiling on a graph.
+ *
+ * @param id
+ *   Graph id.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ */
+__rte_experimental
+int rte_graph_profile_disable(rte_graph_t id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Check whether per node profiling is enabled on a graph.
+ *
+ * @param id
+ *   Graph id.
+ *
+ * @return
+ *   1 if enabled, 0 otherwise.
+ */
+__rte_experimental
+int rte_graph_profile_is_enabled(rte_graph_t id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the profiling data of a node within a graph.
+ *
+ * @param id
+ *   Graph id.
+ * @param node_id
+ *   Node id.
+ * @param[out] prof
+ *   Profiling data of the node.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ */
+__rte_experimental
+int rte_graph_node_profile_get(rte_graph_t id, rte_node_t node_id,
+			       struct rte_graph_node_profile *prof);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reset the profiling data of all the nodes within a graph.
+ *
+ * @param id
+ *   Graph id.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ */
+__rte_experimental
+int rte_graph_profile_reset(rte_graph_t id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dump the profiling data of all the nodes within a graph.
+ *
+ * @param f
+ *   File pointer to dump the profiling data.
+ * @param id
+ *   Graph id.
+ *
+ * @return
+ *   0 on success, negative errno value otherwise.
+ */
+__rte_experimental
+int rte_graph_profile_dump(FILE *f, rte_graph_t id);
+
 /**
  * Structure defines the number of xstats a given node has and each xstat
  * description.
@@ -76,6 +76,7 @@ struct __rte_cache_aligned rte_graph {
 	int socket;	/**< Socket ID where memory is allocated. */
 	char name[RTE_GRAPH_NAMESIZE];	/**< Name of the graph. */
 	bool pcap_enable;	        /**< Pcap trace enabled. */
+	bool profile_enable;	        /**< Node profiling enabled. */
 	/** Number of packets captured per core. */
 	uint64_t nb_pkt_captured;
 	/** Number of packets to capture per core. */
@@ -101,8 +102,10 @@ struct __rte_cache_aligned rte_node {
 	char parent[RTE_NODE_NAMESIZE];	/**< Parent node name. */
 	char name[RTE_NODE_NAMESIZE];	/**< Name of the node. */
 
-	/** Original process function when pcap is enabled. */
+	/** Original process function when pcap or profiling is enabled. */
 	rte_node_process_t original_process;
+	/** Profiling data when profiling is enabled. */
+	void *profile;
 
 	/** Fast schedule area for mcore dispatch model. */
 	union {
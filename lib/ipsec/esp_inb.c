@@ -265,7 +265,8 @@ inb_get_sqn(const struct rte_ipsec_sa *sa, const struct replay_sqn *rsn,
 	 */
 	sqn = rte_be_to_cpu_32(esph->seq);
 	if (IS_ESN(sa))
-		sqn = reconstruct_esn(rsn->sqn, sqn, sa->replay.win_sz);
+		sqn = reconstruct_esn(rsn_get_sqn(sa, rsn), sqn,
+			sa->replay.win_sz);
 	*sqc = rte_cpu_to_be_64(sqn);
 
 	/* check IPsec window */
@@ -626,8 +627,7 @@ tun_process(struct rte_ipsec_sa *sa, struct rte_mbuf *mb[],
 			dr[i - k] = i;
 	}
 
-	sa->statistics.count += k;
-	sa->statistics.bytes += bytes;
+	sa_stats_update(sa, k, bytes);
 	return k;
 }
 
@@ -683,8 +683,7 @@ trs_process(struct rte_ipsec_sa *sa, struct rte_mbuf *mb[],
 			dr[i - k] = i;
 	}
 
-	sa->statistics.count += k;
-	sa->statistics.bytes += bytes;
+	sa_stats_update(sa, k, bytes);
 	return k;
 }
 
@@ -695,23 +694,19 @@ static inline uint16_t
 esp_inb_rsn_update(struct rte_ipsec_sa *sa, const uint32_t sqn[],
 	uint32_t dr[], uint16_t num)
 {
-	uint32_t i, k;
+	uint32_t k;
 	struct replay_sqn *rsn;
 
 	/* replay not enabled */
 	if (sa->replay.win_sz == 0)
 		return num;
 
-	rsn = rsn_update_start(sa);
-
-	k = 0;
-	for (i = 0; i != num; i++) {
-		if (esn_inb_update_sqn(rsn, sa, rte_be_to_cpu_32(sqn[i])) == 0)
-			k++;
-		else
-			dr[i - k] = i;
-	}
+	/* nothing to update */
+	if (num == 0)
+		return 0;
 
+	rsn = rsn_update_start(sa);
+	k = esn_inb_update_sqn_bulk(rsn, sa, sqn, dr, num);
 	rsn_update_finish(sa, rsn);
 	return k;
 }
@@ -687,8 +687,7 @@ esp_outb_sqh_process(const struct rte_ipsec_session *ss, struct rte_mbuf *mb[],
 		} else
 			dr[i - k] = i;
 	}
-	sa->statistics.count += k;
-	sa->statistics.bytes += bytes;
+	sa_stats_update(sa, k, bytes);
 
 	/* handle unprocessed mbufs */
 	if (k != num) {
@@ -720,8 +719,7 @@ inline_outb_mbuf_prepare(const struct rte_ipsec_session *ss,
 			rte_security_set_pkt_metadata(ss->security.ctx,
 				ss->security.ses, mb[i], NULL);
 	}
-	ss->sa->statistics.count += num;
-	ss->sa->statistics.bytes += bytes;
+	sa_stats_update(ss->sa, num, bytes);
 }
 
 
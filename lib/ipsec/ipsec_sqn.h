@@ -13,10 +13,25 @@
 #define WINDOW_BUCKET_MIN		2
 #define WINDOW_BUCKET_MAX		(INT16_MAX + 1)
 
+/*
+ * replay window updated by multiple threads (RTE_IPSEC_SAFLAG_SQN_MT):
+ * each bucket holds the block number of its sequence numbers
+ * in upper 32 bits and the bitmap of the block in lower 32 bits.
+ */
+#define WINDOW_MT_BUCKET_BITS		5 /* uint32_t */
+#define WINDOW_MT_BUCKET_SIZE		(1 << WINDOW_MT_BUCKET_BITS)
+#define WINDOW_MT_BIT_LOC_MASK		(WINDOW_MT_BUCKET_SIZE - 1)
+
 #define IS_ESN(sa)	((sa)->sqn_mask == UINT64_MAX)
 
 #define	SQN_ATOMIC(sa)	((sa)->type & RTE_IPSEC_SATP_SQN_ATOM)
 
+#define	SQN_MT(sa)	((sa)->type & RTE_IPSEC_SATP_SQN_MT_ENABLE)
+
+#define RSN_MT_SQN(rsn)		((uint64_t __rte_atomic *)(uintptr_t)&(rsn)->sqn)
+#define RSN_MT_BUCKET(rsn, n)	\
+	((uint64_t __rte_atomic *)(uintptr_t)&(rsn)->window[n])
+
 /*
  * gets SQN.hi32 bits, SQN supposed to be in network byte order.
  */
@@ -80,6 +95,71 @@ reconstruct_esn(uint64_t t, uint32_t sqn, uint32_t w)
 	return (uint64_t)th << 32 | sqn;
 }
 
+/**
+ * Get the highest sequence number seen so far.
+ */
+static inline uint64_t
+rsn_get_sqn(const struct rte_ipsec_sa *sa, const struct replay_sqn *rsn)
+{
+	if (SQN_MT(sa))
+		return rte_atomic_load_explicit(RSN_MT_SQN(rsn),
+			rte_memory_order_relaxed);
+	return rsn->sqn;
+}
+
+/**
+ * For replay window updated by multiple threads, setup block numbers
+ * of all buckets to be older than initial sequence number.
+ */
+static inline void
+rsn_mt_init(const struct rte_ipsec_sa *sa, struct replay_sqn *rsn)
+{
+	uint32_t blk, i;
+
+	blk = (rsn->sqn >> WINDOW_MT_BUCKET_BITS) - sa->replay.nb_bucket;
+	for (i = 0; i != sa->replay.nb_bucket; i++)
+		rsn->window[i] = (uint64_t)blk << 32;
+}
+
+/**
+ * Perform the replay checking for replay window updated by multiple threads.
+ * Bucket of given sequence number is valid as long as it contains
+ * block number of that sequence number. Once reused for a newer block,
+ * the sequence number is considered as already seen.
+ */
+static inline int32_t
+esn_inb_check_sqn_mt(const struct replay_sqn *rsn,
+	const struct rte_ipsec_sa *sa, uint64_t sqn)
+{
+	uint32_t blk, bucket;
+	uint64_t bit, top, w;
+
+	top = rte_atomic_load_explicit(RSN_MT_SQN(rsn),
+		rte_memory_order_relaxed);
+
+	/* seq is larger than lastseq */
+	if (sqn > top)
+		return 0;
+
+	/* seq is outside window */
+	if (sqn == 0 || sqn + sa->replay.win_sz < top)
+		return -EINVAL;
+
+	blk = sqn >> WINDOW_MT_BUCKET_BITS;
+	bucket = blk & sa->replay.bucket_index_mask;
+	bit = (uint64_t)1 << (sqn & WINDOW_MT_BIT_LOC_MASK);
+
+	w = rte_atomic_load_explicit(RSN_MT_BUCKET(rsn, bucket),
+		rte_memory_order_relaxed);
+
+	/* bucket reused for newer block or already seen packet */
+	if ((int32_t)(blk - (uint32_t)(w >> 32)) < 0 ||
+			(blk == (uint32_t)(w >> 32) && (w & bit) != 0))
+		return -EINVAL;
+
+	return 0;
+}
+
 /**
  * Perform the replay checking.
  *
@@ -99,6 +179,9 @@ esn_inb_check_sqn(const struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 	if (sa->replay.win_sz == 0)
 		return 0;
 
+	if (SQN_MT(sa))
+		return esn_inb_check_sqn_mt(rsn, sa, sqn);
+
 	/* seq is larger than lastseq */
 	if (sqn > rsn->sqn)
 		return 0;
@@ -150,7 +233,8 @@ static inline int32_t
 esn_inb_update_sqn(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 	uint64_t sqn)
 {
-	uint32_t bit, bucket, last_bucket, new_bucket, diff, i;
+	uint32_t bucket, last_bucket, new_bucket, diff, i;
+	uint64_t bit;
 
 	/* handle ESN */
 	if (IS_ESN(sa))
@@ -190,6 +274,169 @@ esn_inb_update_sqn(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 	return 0;
 }
 
+/**
+ * For inbound SA perform the sequence number and replay window update,
+ * for replay window updated by multiple threads.
+ * Bucket is either updated with the bit of the sequence number,
+ * or reset for the block of the sequence number when it holds an older one.
+ * The highest sequence number is moved forward only.
+ */
+static inline int32_t
+esn_inb_update_sqn_mt(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
+	uint64_t sqn)
+{
+	uint32_t blk, bucket, wblk;
+	uint64_t bit, top, w, nw;
+
+	top = rte_atomic_load_explicit(RSN_MT_SQN(rsn),
+		rte_memory_order_relaxed);
+
+	/*
+	 * handle ESN, a packet which became too old while the window was
+	 * moved by other threads would be taken for the next ESN subspace.
+	 */
+	if (IS_ESN(sa)) {
+		sqn = reconstruct_esn(top, sqn, sa->replay.win_sz);
+		if (sqn > top && sqn - top > INT32_MAX)
+			return -EINVAL;
+	}
+
+	/* seq is outside window*/
+	if (sqn == 0 || sqn + sa->replay.win_sz < top)
+		return -EINVAL;
+
+	blk = sqn >> WINDOW_MT_BUCKET_BITS;
+	bucket = blk & sa->replay.bucket_index_mask;
+	bit = (uint64_t)1 << (sqn & WINDOW_MT_BIT_LOC_MASK);
+
+	w = rte_atomic_load_explicit(RSN_MT_BUCKET(rsn, bucket),
+		rte_memory_order_relaxed);
+	do {
+		wblk = w >> 32;
+
+		/* bucket reused for newer block */
+		if ((int32_t)(blk - wblk) < 0)
+			return -EINVAL;
+
+		if (blk == wblk) {
+			/* already seen packet */
+			if ((w & bit) != 0)
+				return -EINVAL;
+			nw = w | bit;
+		} else
+			nw = (uint64_t)blk << 32 | bit;
+	} while (rte_atomic_compare_exchange_weak_explicit(
+			RSN_MT_BUCKET(rsn, bucket), &w, nw,
+			rte_memory_order_relaxed,
+			rte_memory_order_relaxed) == 0);
+
+	/* move the window forward */
+	while (sqn > top && rte_atomic_compare_exchange_weak_explicit(
+			RSN_MT_SQN(rsn), &top, sqn,
+			rte_memory_order_relaxed,
+			rte_memory_order_relaxed) == 0)
+		;
+
+	return 0;
+}
+
+/**
+ * For inbound SA perform the sequence number and replay window update
+ * for a group of packets at once.
+ * When all the sequence numbers of the group fit into the replay window
+ * positioned at the highest of them, the window is moved once and
+ * the bits of all packets are set in a single pass.
+ * Otherwise the packets are handled one by one, in arrival order.
+ * Returns number of accepted packets, indexes of rejected ones
+ * are stored in *dr*.
+ */
+static inline uint32_t
+esn_inb_update_sqn_bulk(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
+	const uint32_t sqn[], uint32_t dr[], uint32_t num)
+{
+	uint32_t bucket, i, k, last_bucket, diff;
+	uint64_t bit, max, s[num];
+
+	/* window shared with other threads: update packet by packet */
+	if (SQN_MT(sa)) {
+		k = 0;
+		for (i = 0; i != num; i++) {
+			if (esn_inb_update_sqn_mt(rsn, sa,
+					rte_be_to_cpu_32(sqn[i])) == 0)
+				k++;
+			else
+				dr[i - k] = i;
+		}
+		return k;
+	}
+
+	max = rsn->sqn;
+	for (i = 0; i != num; i++) {
+		s[i] = rte_be_to_cpu_32(sqn[i]);
+		/* handle ESN, relative to the window before the update */
+		if (IS_ESN(sa))
+			s[i] = reconstruct_esn(rsn->sqn, s[i],
+				sa->replay.win_sz);
+		max = RTE_MAX(max, s[i]);
+	}
+
+	/*
+	 * make sure that all packets stay strictly inside the window once
+	 * it is moved, so that their ESN would not change either, and that
+	 * none of them shares a bucket with the new ones.
+	 */
+	for (i = 0; i != num; i++) {
+		if (s[i] == 0 || s[i] + sa->replay.win_sz <= max ||
+				(max >> WINDOW_BUCKET_BITS) -
+				(s[i] >> WINDOW_BUCKET_BITS) >=
+				sa->replay.nb_bucket)
+			break;
+	}
+
+	/* slow path: process packets one by one */
+	if (i != num) {
+		k = 0;
+		for (i = 0; i != num; i++) {
+			if (esn_inb_update_sqn(rsn, sa,
+					rte_be_to_cpu_32(sqn[i])) == 0)
+				k++;
+			else
+				dr[i - k] = i;
+		}
+		return k;
+	}
+
+	/* move the window once */
+	if (max > rsn->sqn) {
+		last_bucket = rsn->sqn >> WINDOW_BUCKET_BITS;
+		diff = (max >> WINDOW_BUCKET_BITS) - last_bucket;
+		if (diff > sa->replay.nb_bucket)
+			diff = sa->replay.nb_bucket;
+
+		for (i = 0; i != diff; i++)
+			rsn->window[(i + last_bucket + 1) &
+				sa->replay.bucket_index_mask] = 0;
+		rsn->sqn = max;
+	}
+
+	/* set the bits, rejecting packets already seen */
+	k = 0;
+	for (i = 0; i != num; i++) {
+		bucket = (s[i] >> WINDOW_BUCKET_BITS) &
+			sa->replay.bucket_index_mask;
+		bit = (uint64_t)1 << (s[i] & WINDOW_BIT_LOC_MASK);
+
+		if (rsn->window[bucket] & bit)
+			dr[i - k] = i;
+		else {
+			rsn->window[bucket] |= bit;
+			k++;
+		}
+	}
+
+	return k;
+}
+
 /**
  * To achieve ability to do multiple readers single writer for
  * SA replay window information and sequence number (RSN)
@@ -235,7 +482,7 @@ rsn_acquire(struct rte_ipsec_sa *sa)
 	n = sa->sqn.inb.rdidx;
 	rsn = sa->sqn.inb.rsn[n];
 
-	if (!SQN_ATOMIC(sa))
+	if (!SQN_ATOMIC(sa) || SQN_MT(sa))
 		return rsn;
 
 	/* check there are no writers */
@@ -255,7 +502,7 @@ rsn_acquire(struct rte_ipsec_sa *sa)
 static inline void
 rsn_release(struct rte_ipsec_sa *sa, struct replay_sqn *rsn)
 {
-	if (SQN_ATOMIC(sa))
+	if (SQN_ATOMIC(sa) && !SQN_MT(sa))
 		rte_rwlock_read_unlock(&rsn->rwl);
 }
 
@@ -273,7 +520,7 @@ rsn_update_start(struct rte_ipsec_sa *sa)
 	/* no active writers */
 	RTE_ASSERT(n == sa->sqn.inb.rdidx);
 
-	if (!SQN_ATOMIC(sa))
+	if (!SQN_ATOMIC(sa) || SQN_MT(sa))
 		return sa->sqn.inb.rsn[n];
 
 	k = REPLAY_SQN_NEXT(n);
@@ -294,7 +541,7 @@ rsn_update_finish(struct rte_ipsec_sa *sa, struct replay_sqn *rsn)
 {
 	uint32_t n;
 
-	if (!SQN_ATOMIC(sa))
+	if (!SQN_ATOMIC(sa) || SQN_MT(sa))
 		return;
 
 	n = sa->sqn.inb.wridx;
@@ -305,5 +552,25 @@ rsn_update_finish(struct rte_ipsec_sa *sa, struct replay_sqn *rsn)
 	sa->sqn.inb.rdidx = n;
 }
 
+/**
+ * Account processed packets in SA statistics.
+ * SA that can be processed by multiple threads concurrently
+ * has to update its counters atomically.
+ */
+static inline void
+sa_stats_update(struct rte_ipsec_sa *sa, uint32_t num, uint32_t bytes)
+{
+	if (SQN_ATOMIC(sa)) {
+		rte_atomic_fetch_add_explicit((uint64_t __rte_atomic *)
+			(uintptr_t)&sa->statistics.count, num,
+			rte_memory_order_relaxed);
+		rte_atomic_fetch_add_explicit((uint64_t __rte_atomic *)
+			(uintptr_t)&sa->statistics.bytes, bytes,
+			rte_memory_order_relaxed);
+	} else {
+		sa->statistics.count += num;
+		sa->statistics.bytes += bytes;
+	}
+}
 
 #endif /* _IPSEC_SQN_H_ */
@@ -69,6 +69,23 @@ struct rte_ipsec_sa_prm {
  */
 #define	RTE_IPSEC_SAFLAG_SQN_ATOM	(1ULL << 0)
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this flag may change, or be removed, without prior notice
+ *
+ * Indicates that inbound SA replay window can be updated by multiple
+ * threads at once.
+ * With that flag, rte_ipsec_pkt_crypto_prepare() and rte_ipsec_pkt_process()
+ * can be invoked for the same inbound SA by several threads concurrently,
+ * so that the traffic of a single SA can be spread among several lcores.
+ * The replay window is updated with atomic operations only, no lock is taken,
+ * which makes large windows (thousands of packets) affordable.
+ * Packets of the SA can be processed in any order, the replay check
+ * still guarantees that each sequence number is accepted only once.
+ * For outbound SA that flag has the same meaning as RTE_IPSEC_SAFLAG_SQN_ATOM.
+ */
+#define	RTE_IPSEC_SAFLAG_SQN_MT		(1ULL << 1)
+
 /**
  * SA type is an 64-bit value that contain the following information:
  * - IP version (IPv4/IPv6)
@@ -79,6 +96,7 @@ struct rte_ipsec_sa_prm {
  * - are SA SQN operations 'atomic'
  * - ESN enabled/disabled
  * - NAT-T UDP encapsulated (TUNNEL mode only)
+ * - is inbound replay window updated by multiple threads
  * ...
  */
 
@@ -91,7 +109,8 @@ enum {
 	RTE_SATP_LOG2_ESN,
 	RTE_SATP_LOG2_ECN,
 	RTE_SATP_LOG2_DSCP,
-	RTE_SATP_LOG2_NATT
+	RTE_SATP_LOG2_NATT,
+	RTE_SATP_LOG2_SQN_MT
 };
 
 #define RTE_IPSEC_SATP_IPV_MASK		(1ULL << RTE_SATP_LOG2_IPV)
@@ -131,6 +150,10 @@ enum {
 #define RTE_IPSEC_SATP_NATT_DISABLE	(0ULL << RTE_SATP_LOG2_NATT)
 #define RTE_IPSEC_SATP_NATT_ENABLE	(1ULL << RTE_SATP_LOG2_NATT)
 
+#define RTE_IPSEC_SATP_SQN_MT_MASK	(1ULL << RTE_SATP_LOG2_SQN_MT)
+#define RTE_IPSEC_SATP_SQN_MT_DISABLE	(0ULL << RTE_SATP_LOG2_SQN_MT)
+#define RTE_IPSEC_SATP_SQN_MT_ENABLE	(1ULL << RTE_SATP_LOG2_SQN_MT)
+
 
 /**
  * get type of given SA
@@ -176,6 +199,33 @@ rte_ipsec_sa_init(struct rte_ipsec_sa *sa, const struct rte_ipsec_sa_prm *prm,
 void
 rte_ipsec_sa_fini(struct rte_ipsec_sa *sa);
 
+/**
+ * SA statistics.
+ */
+struct rte_ipsec_sa_stats {
+	uint64_t count; /**< number of successfully processed packets */
+	uint64_t bytes; /**< number of bytes of successfully processed packets */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Retrieve SA statistics.
+ * Can be called while the SA is being processed by other threads.
+ * @param sa
+ *   Pointer to SA object.
+ * @param stats
+ *   Structure to fill with the SA statistics.
+ * @return
+ *   - Zero if operation completed successfully.
+ *   - -EINVAL if the parameters are invalid.
+ */
+__rte_experimental
+int
+rte_ipsec_sa_stats_get(const struct rte_ipsec_sa *sa,
+	struct rte_ipsec_sa_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
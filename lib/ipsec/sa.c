@@ -122,6 +122,22 @@ replay_num_bucket(uint32_t wsz)
 	return nb;
 }
 
+/*
+ * for given size, calculate required number of buckets for the replay
+ * window updated by multiple threads: buckets hold less bits, and the
+ * window must not reuse the bucket of its oldest sequence number.
+ */
+static uint32_t
+replay_num_bucket_mt(uint32_t wsz)
+{
+	uint32_t nb;
+
+	nb = rte_align32pow2(wsz / WINDOW_MT_BUCKET_SIZE + 2);
+	nb = RTE_MAX(nb, (uint32_t)WINDOW_BUCKET_MIN);
+
+	return nb;
+}
+
 static int32_t
 ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 {
@@ -141,7 +157,10 @@ ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 			RTE_IPSEC_SATP_ESN_DISABLE) ?
 			wsz : RTE_MAX(wsz, (uint32_t)WINDOW_BUCKET_SIZE);
 		if (wsz != 0)
-			n = replay_num_bucket(wsz);
+			n = ((type & RTE_IPSEC_SATP_SQN_MT_MASK) ==
+				RTE_IPSEC_SATP_SQN_MT_ENABLE) ?
+				replay_num_bucket_mt(wsz) :
+				replay_num_bucket(wsz);
 	}
 
 	if (n > WINDOW_BUCKET_MAX)
@@ -151,7 +170,9 @@ ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 	*nb_bucket = n;
 
 	sz = rsn_size(n);
-	if ((type & RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM)
+	if ((type & RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM &&
+			(type & RTE_IPSEC_SATP_SQN_MT_MASK) ==
+			RTE_IPSEC_SATP_SQN_MT_DISABLE)
 		sz *= REPLAY_SQN_NUM;
 
 	sz += sizeof(struct rte_ipsec_sa);
@@ -241,11 +262,16 @@ fill_sa_type(const struct rte_ipsec_sa_prm *prm, uint64_t *type)
 		tp |= RTE_IPSEC_SATP_DSCP_ENABLE;
 
 	/* interpret flags */
-	if (prm->flags & RTE_IPSEC_SAFLAG_SQN_ATOM)
+	if (prm->flags & (RTE_IPSEC_SAFLAG_SQN_ATOM | RTE_IPSEC_SAFLAG_SQN_MT))
 		tp |= RTE_IPSEC_SATP_SQN_ATOM;
 	else
 		tp |= RTE_IPSEC_SATP_SQN_RAW;
 
+	if (prm->flags & RTE_IPSEC_SAFLAG_SQN_MT)
+		tp |= RTE_IPSEC_SATP_SQN_MT_ENABLE;
+	else
+		tp |= RTE_IPSEC_SATP_SQN_MT_DISABLE;
+
 	*type = tp;
 	return 0;
 }
@@ -521,13 +547,30 @@ fill_sa_replay(struct rte_ipsec_sa *sa, uint32_t wnd_sz, uint32_t nb_bucket,
 	sa->replay.bucket_index_mask = nb_bucket - 1;
 	sa->sqn.inb.rsn[0] = (struct replay_sqn *)(sa + 1);
 	sa->sqn.inb.rsn[0]->sqn = sqn;
-	if ((sa->type & RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM) {
+	if (SQN_MT(sa))
+		rsn_mt_init(sa, sa->sqn.inb.rsn[0]);
+	else if (SQN_ATOMIC(sa)) {
 		sa->sqn.inb.rsn[1] = (struct replay_sqn *)
 			((uintptr_t)sa->sqn.inb.rsn[0] + rsn_size(nb_bucket));
 		sa->sqn.inb.rsn[1]->sqn = sqn;
 	}
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ipsec_sa_stats_get, 25.07)
+int
+rte_ipsec_sa_stats_get(const struct rte_ipsec_sa *sa,
+	struct rte_ipsec_sa_stats *stats)
+{
+	if (sa == NULL || stats == NULL)
+		return -EINVAL;
+
+	stats->count = rte_atomic_load_explicit((const uint64_t __rte_atomic *)
+		(uintptr_t)&sa->statistics.count, rte_memory_order_relaxed);
+	stats->bytes = rte_atomic_load_explicit((const uint64_t __rte_atomic *)
+		(uintptr_t)&sa->statistics.bytes, rte_memory_order_relaxed);
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_ipsec_sa_size)
 int
 rte_ipsec_sa_size(const struct rte_ipsec_sa_prm *prm)
@@ -675,8 +718,7 @@ pkt_flag_process(const struct rte_ipsec_session *ss,
 			dr[i - k] = i;
 	}
 
-	ss->sa->statistics.count += k;
-	ss->sa->statistics.bytes += bytes;
+	sa_stats_update(ss->sa, k, bytes);
 
 	/* handle unprocessed mbufs */
 	if (k != num) {
@@ -17,6 +17,7 @@
 #include "rte_member_ht.h"
 #include "rte_member_vbf.h"
 #include "rte_member_sketch.h"
+#include "rte_member_cuckoo.h"
 
 TAILQ_HEAD(rte_member_list, rte_tailq_entry);
 static struct rte_tailq_elem rte_member_tailq = {
@@ -81,6 +82,9 @@ rte_member_free(struct rte_member_setsum *setsum)
 	case RTE_MEMBER_TYPE_SKETCH:
 		rte_member_free_sketch(setsum);
 		break;
+	case RTE_MEMBER_TYPE_CUCKOO:
+		rte_member_free_cuckoo(setsum);
+		break;
 	default:
 		break;
 	}
@@ -170,6 +174,9 @@ rte_member_create(const struct rte_member_parameters *params)
 	case RTE_MEMBER_TYPE_SKETCH:
 		ret = rte_member_create_sketch(setsum, params, sketch_key_ring);
 		break;
+	case RTE_MEMBER_TYPE_CUCKOO:
+		ret = rte_member_create_cuckoo(setsum, params);
+		break;
 	default:
 		goto error_unlock_exit;
 	}
@@ -207,6 +214,8 @@ rte_member_add(const struct rte_member_setsum *setsum, const void *key,
 		return rte_member_add_vbf(setsum, key, set_id);
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_add_sketch(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_add_cuckoo(setsum, key, set_id);
 	default:
 		return -EINVAL;
 	}
@@ -243,6 +252,8 @@ rte_member_lookup(const struct rte_member_setsum *setsum, const void *key,
 		return rte_member_lookup_vbf(setsum, key, set_id);
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_lookup_sketch(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_lookup_cuckoo(setsum, key, set_id);
 	default:
 		return -EINVAL;
 	}
@@ -264,6 +275,9 @@ rte_member_lookup_bulk(const struct rte_member_setsum *setsum,
 	case RTE_MEMBER_TYPE_VBF:
 		return rte_member_lookup_bulk_vbf(setsum, keys, num_keys,
 				set_ids);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_lookup_bulk_cuckoo(setsum, keys, num_keys,
+				set_ids);
 	default:
 		return -EINVAL;
 	}
@@ -284,6 +298,9 @@ rte_member_lookup_multi(const struct rte_member_setsum *setsum, const void *key,
 	case RTE_MEMBER_TYPE_VBF:
 		return rte_member_lookup_multi_vbf(setsum, key, match_per_key,
 				set_id);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_lookup_multi_cuckoo(setsum, key,
+				match_per_key, set_id);
 	default:
 		return -EINVAL;
 	}
@@ -307,6 +324,10 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
 	case RTE_MEMBER_TYPE_VBF:
 		return rte_member_lookup_multi_bulk_vbf(setsum, keys, num_keys,
 				max_match_per_key, match_count, set_ids);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_lookup_multi_bulk_cuckoo(setsum, keys,
+				num_keys, max_match_per_key, match_count,
+				set_ids);
 	default:
 		return -EINVAL;
 	}
@@ -358,6 +379,8 @@ rte_member_delete(const struct rte_member_setsum *setsum, const void *key,
 	/* current vBF implementation does not support delete function */
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_delete_sketch(setsum, key);
+	case RTE_MEMBER_TYPE_CUCKOO:
+		return rte_member_delete_cuckoo(setsum, key, set_id);
 	case RTE_MEMBER_TYPE_VBF:
 	default:
 		return -EINVAL;
@@ -380,6 +403,9 @@ rte_member_reset(const struct rte_member_setsum *setsum)
 	case RTE_MEMBER_TYPE_SKETCH:
 		rte_member_reset_sketch(setsum);
 		return;
+	case RTE_MEMBER_TYPE_CUCKOO:
+		rte_member_reset_cuckoo(setsum);
+		return;
 	default:
 		return;
 	}
@@ -48,6 +48,20 @@
  * |properties| used for heavy hitter       |
  * |          | detection.                  |
  * +----------+-----------------------------+
+ * +==========+=============================+
+ * |   type   |      cuckoo                 |
+ * +==========+=============================+
+ * |structure | cuckoo filter of 12-bit     |
+ * |          | fingerprints                |
+ * +----------+-----------------------------+
+ * |set id    | 1: key is in the set        |
+ * |          |                             |
+ * +----------+-----------------------------+
+ * |usages &  | single set, can delete,     |
+ * |properties| about 12.6 bits per key,    |
+ * |          | false-positive rate below   |
+ * |          | 0.2%, no false-negative.    |
+ * +----------+-----------------------------+
  * -->
  */
 
@@ -115,6 +129,7 @@ enum rte_member_setsum_type {
 	RTE_MEMBER_TYPE_HT = 0,  /**< Hash table based set summary. */
 	RTE_MEMBER_TYPE_VBF,     /**< Vector of bloom filters. */
 	RTE_MEMBER_TYPE_SKETCH,
+	RTE_MEMBER_TYPE_CUCKOO,  /**< Cuckoo filter. */
 	RTE_MEMBER_NUM_TYPE
 };
 
@@ -204,6 +219,9 @@ struct __rte_cache_aligned rte_member_parameters {
 	 *
 	 * vBF setsummary is a vector of bloom filters. It is used when number
 	 * of sets is not big (less than 32 for current implementation).
+	 *
+	 * Cuckoo filter setsummary records a single set (set id 1) in less
+	 * memory than HT and, unlike vBF, supports deletion.
 	 */
 	enum rte_member_setsum_type type;
 
@@ -243,6 +261,10 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * number of bits we need for each BF. User does not specify the size of
 	 * each BF directly because the optimal size depends on the num_keys
 	 * and false positive rate.
+	 *
+	 * For cuckoo filter, num_keys is the expected number of keys. The
+	 * table is sized to be 95% full with this number of keys, adding more
+	 * keys may fail with -ENOSPC.
 	 */
 	uint32_t num_keys;
 
@@ -281,6 +303,9 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * to number of entries (num_keys) divided by entry count per bucket
 	 * (RTE_MEMBER_BUCKET_ENTRIES). Thus, the false_positive_rate is not
 	 * directly set by users for HT mode.
+	 *
+	 * For cuckoo filter, the false positive rate is fixed by the 12-bit
+	 * fingerprints: it is lower than 2 * 4 / 2^12 (about 0.2%).
 	 */
 	float false_positive_rate;
 
@@ -291,6 +316,8 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * for bucket location.
 	 * For vBF type, these two hashes and their combinations are used as
 	 * hash locations to index the bit array.
+	 * For cuckoo filter, one hash is used for the primary bucket and the
+	 * other one for the fingerprint.
 	 * For Sketch type, these seeds are not used.
 	 */
 	uint32_t prim_hash_seed;
@@ -473,6 +500,7 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
  *   For HT mode, the set_id has range as [1, 0x7FFF], MSB is reserved.
  *   For vBF mode the set id is limited by the num_set parameter when create
  *   the set-summary. For sketch mode, this id is ignored.
+ *   For cuckoo filter mode, the set_id must be 1.
  * @return
  *   HT (cache mode) and vBF should never fail unless the set_id is not in the
  *   valid range. In such case -EINVAL is returned.
@@ -484,6 +512,9 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
  *   eviction, return 1 otherwise. Return 0 for non-cache mode if success,
  *   -ENOSPC for full, and 1 if cuckoo eviction happens.
  *   Always returns 0 for vBF mode and sketch.
+ *   For cuckoo filter mode, return 0 if success, 1 if fingerprints were moved
+ *   to their alternate bucket and -ENOSPC for full. Adding the same key twice
+ *   stores it twice, so it must be deleted twice.
  */
 int
 rte_member_add(const struct rte_member_setsum *setsum, const void *key,
@@ -561,6 +592,9 @@ rte_member_reset(const struct rte_member_setsum *setsum);
  *   For HT mode, we need both key and its corresponding set_id to
  *   properly delete the key. Without set_id, we may delete other keys with the
  *   same signature.
+ *   For cuckoo filter mode, set_id must be 1. Only keys that were added
+ *   should be deleted, otherwise the fingerprint of another key may be
+ *   removed.
  * @return
  *   If no entry found to delete, an error code of -ENOENT could be returned.
  */
@@ -0,0 +1,345 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_prefetch.h>
+#include <rte_random.h>
+#include <rte_log.h>
+#include <rte_vect.h>
+
+#include "member.h"
+#include "rte_member.h"
+#include "rte_member_cuckoo.h"
+
+/*
+ * Cuckoo filter: each key is represented by a 12-bit fingerprint stored in
+ * one of two candidate buckets of 4 entries. The alternate bucket is
+ * computed from the current bucket and the fingerprint only, so entries can
+ * be moved and deleted without the original key. With the table filled at
+ * 95%, a key costs about 12.6 bits and the false positive rate is bounded
+ * by 2 * 4 / 2^12 (about 0.2%).
+ */
+
+static inline void
+cuckoo_write(uint8_t *table, uint32_t bkt, uint32_t entry, uint32_t fp)
+{
+	uint8_t *p = table + (size_t)bkt * MEMBER_CUCKOO_BUCKET_SIZE;
+	uint32_t shift = entry * MEMBER_CUCKOO_FP_BITS;
+	uint64_t w;
+
+	/* the upper 16 bits of the word belong to the next bucket */
+	memcpy(&w, p, sizeof(w));
+	w = rte_le_to_cpu_64(w);
+	w &= ~(MEMBER_CUCKOO_FP_MASK << shift);
+	w |= (uint64_t)fp << shift;
+	w = rte_cpu_to_le_64(w);
+	memcpy(p, &w, sizeof(w));
+}
+
+static inline uint32_t
+cuckoo_entry(uint64_t w, uint32_t entry)
+{
+	return (w >> (entry * MEMBER_CUCKOO_FP_BITS)) & MEMBER_CUCKOO_FP_MASK;
+}
+
+/* Store the fingerprint in a free entry of the bucket if any. */
+static inline int
+cuckoo_try_insert(uint8_t *table, uint32_t bkt, uint32_t fp)
+{
+	uint64_t w = member_cuckoo_read(table, bkt);
+	uint32_t i;
+
+	for (i = 0; i < MEMBER_CUCKOO_BUCKET_ENTRIES; i++) {
+		if (cuckoo_entry(w, i) == 0) {
+			cuckoo_write(table, bkt, i, fp);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static inline void
+cuckoo_hash(const struct rte_member_setsum *ss, const void *key,
+		uint32_t *bkt, uint32_t *alt, uint32_t *fp)
+{
+	uint32_t h1 = MEMBER_HASH_FUNC(key, ss->key_len, ss->prim_hash_seed);
+	uint32_t h2 = MEMBER_HASH_FUNC(&h1, sizeof(uint32_t),
+			ss->sec_hash_seed);
+
+	*fp = h2 & MEMBER_CUCKOO_FP_MASK;
+	/* zero marks an empty entry */
+	if (*fp == 0)
+		*fp = 1;
+	*bkt = member_cuckoo_reduce(h1, ss->bucket_cnt);
+	*alt = member_cuckoo_alt_bucket(*bkt, *fp, ss->bucket_cnt);
+}
+
+#if defined(RTE_ARCH_X86) && defined(CC_AVX512_SUPPORT)
+/*
+ * The AVX512 lookup is built with the AVX512 march flags and IFMA,
+ * so all the extensions they enable must be available.
+ */
+static int
+member_cuckoo_check_avx512_cpu_flags(void)
+{
+	return rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512CD) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512DQ) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512VL) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512IFMA) == 1;
+}
+#endif
+
+int
+rte_member_create_cuckoo(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params)
+{
+	uint64_t num_buckets;
+	uint8_t *table;
+
+	if (params->num_keys == 0 ||
+			params->num_keys > RTE_MEMBER_ENTRIES_MAX) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR,
+			"Membership cuckoo filter create with invalid parameters");
+		return -EINVAL;
+	}
+
+	/* Size the table so that num_keys fill it at the expected load. */
+	num_buckets = ((uint64_t)params->num_keys * 100 +
+			MEMBER_CUCKOO_BUCKET_ENTRIES * MEMBER_CUCKOO_LOAD - 1) /
+			(MEMBER_CUCKOO_BUCKET_ENTRIES * MEMBER_CUCKOO_LOAD);
+
+	table = rte_zmalloc_socket(NULL,
+			num_buckets * MEMBER_CUCKOO_BUCKET_SIZE + sizeof(uint64_t),
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (table == NULL) {
+		MEMBER_LOG(ERR, "memory allocation failed for cuckoo filter "
+						"setsummary");
+		return -ENOMEM;
+	}
+
+	ss->table = table;
+	ss->bucket_cnt = num_buckets;
+	ss->sig_cmp_fn = RTE_MEMBER_COMPARE_SCALAR;
+
+#if defined(RTE_ARCH_X86)
+#ifdef CC_AVX512_SUPPORT
+	if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512 &&
+			member_cuckoo_check_avx512_cpu_flags())
+		ss->use_avx512 = true;
+#endif
+	if (ss->use_avx512 == false &&
+			rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_256 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) == 1)
+		ss->sig_cmp_fn = RTE_MEMBER_COMPARE_AVX2;
+#endif
+
+	MEMBER_LOG(DEBUG, "Cuckoo filter created, "
+			"%u buckets of %u %u-bit fingerprints",
+			ss->bucket_cnt, MEMBER_CUCKOO_BUCKET_ENTRIES,
+			MEMBER_CUCKOO_FP_BITS);
+	return 0;
+}
+
+int
+rte_member_lookup_cuckoo(const struct rte_member_setsum *ss,
+		const void *key, member_set_t *set_id)
+{
+	const uint8_t *table = ss->table;
+	uint32_t bkt, alt, fp;
+	uint64_t fp_word;
+
+	cuckoo_hash(ss, key, &bkt, &alt, &fp);
+	fp_word = member_cuckoo_fp_word(fp);
+
+	if (member_cuckoo_match(member_cuckoo_read(table, bkt), fp_word) ||
+			member_cuckoo_match(member_cuckoo_read(table, alt),
+				fp_word)) {
+		*set_id = MEMBER_CUCKOO_SET_ID;
+		return 1;
+	}
+
+	*set_id = RTE_MEMBER_NO_MATCH;
+	return 0;
+}
+
+static uint32_t
+cuckoo_lookup_bulk_scalar(const struct rte_member_setsum *ss,
+		const struct member_cuckoo_bulk *bulk, uint32_t num_keys,
+		member_set_t *set_ids)
+{
+	const uint8_t *table = ss->table;
+	uint32_t num_matches = 0;
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		if (member_cuckoo_bulk_match(table, bulk, i)) {
+			set_ids[i] = MEMBER_CUCKOO_SET_ID;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
+
+uint32_t
+rte_member_lookup_bulk_cuckoo(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, member_set_t *set_ids)
+{
+	const uint8_t *table = ss->table;
+	struct member_cuckoo_bulk bulk;
+	uint32_t bkt, alt, fp;
+	uint32_t i;
+
+	for (i = 0; i < num_keys; i++) {
+		cuckoo_hash(ss, keys[i], &bkt, &alt, &fp);
+		bulk.prim[i] = bkt * MEMBER_CUCKOO_BUCKET_SIZE;
+		bulk.sec[i] = alt * MEMBER_CUCKOO_BUCKET_SIZE;
+		bulk.fp[i] = member_cuckoo_fp_word(fp);
+		rte_prefetch0(table + bulk.prim[i]);
+		rte_prefetch0(table + bulk.sec[i]);
+	}
+
+#if defined(RTE_ARCH_X86)
+#ifdef CC_AVX512_SUPPORT
+	if (ss->use_avx512 == true)
+		return member_cuckoo_lookup_bulk_avx512(ss, &bulk, num_keys,
+				set_ids);
+#endif
+	if (ss->sig_cmp_fn == RTE_MEMBER_COMPARE_AVX2)
+		return member_cuckoo_lookup_bulk_avx2(ss, &bulk, num_keys,
+				set_ids);
+#endif
+	return cuckoo_lookup_bulk_scalar(ss, &bulk, num_keys, set_ids);
+}
+
+uint32_t
+rte_member_lookup_multi_cuckoo(const struct rte_member_setsum *ss,
+		const void *key, uint32_t match_per_key,
+		member_set_t *set_id)
+{
+	/* a cuckoo filter holds a single set */
+	if (match_per_key == 0)
+		return 0;
+	return rte_member_lookup_cuckoo(ss, key, set_id);
+}
+
+uint32_t
+rte_member_lookup_multi_bulk_cuckoo(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, uint32_t match_per_key,
+		uint32_t *match_count,
+		member_set_t *set_ids)
+{
+	member_set_t tmp_set_ids[RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint32_t num_matches;
+	uint32_t i;
+
+	if (match_per_key == 0) {
+		memset(match_count, 0, sizeof(*match_count) * num_keys);
+		return 0;
+	}
+
+	num_matches = rte_member_lookup_bulk_cuckoo(ss, keys, num_keys,
+			tmp_set_ids);
+	for (i = 0; i < num_keys; i++) {
+		match_count[i] = tmp_set_ids[i] != RTE_MEMBER_NO_MATCH;
+		set_ids[i * match_per_key] = tmp_set_ids[i];
+	}
+	return num_matches;
+}
+
+/*
+ * Add the fingerprint of the key. When both buckets are full, entries are
+ * moved to their alternate bucket. If no free entry is found, the moves are
+ * reverted so that no other key is lost.
+ */
+int
+rte_member_add_cuckoo(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	uint32_t path_bkt[MEMBER_CUCKOO_MAX_KICKS];
+	uint8_t path_entry[MEMBER_CUCKOO_MAX_KICKS];
+	uint8_t *table = ss->table;
+	uint32_t bkt, alt, fp, victim;
+	uint32_t entry;
+	int i;
+
+	if (set_id != MEMBER_CUCKOO_SET_ID)
+		return -EINVAL;
+
+	cuckoo_hash(ss, key, &bkt, &alt, &fp);
+
+	if (cuckoo_try_insert(table, bkt, fp) ||
+			cuckoo_try_insert(table, alt, fp))
+		return 0;
+
+	if (rte_rand() & 1)
+		bkt = alt;
+
+	for (i = 0; i < MEMBER_CUCKOO_MAX_KICKS; i++) {
+		entry = rte_rand_max(MEMBER_CUCKOO_BUCKET_ENTRIES);
+		victim = cuckoo_entry(member_cuckoo_read(table, bkt), entry);
+		cuckoo_write(table, bkt, entry, fp);
+		path_bkt[i] = bkt;
+		path_entry[i] = entry;
+
+		fp = victim;
+		bkt = member_cuckoo_alt_bucket(bkt, fp, ss->bucket_cnt);
+		if (cuckoo_try_insert(table, bkt, fp))
+			return 1;
+	}
+
+	/* Table is full, put back the entries that were moved. */
+	while (--i >= 0) {
+		victim = cuckoo_entry(member_cuckoo_read(table, path_bkt[i]),
+				path_entry[i]);
+		cuckoo_write(table, path_bkt[i], path_entry[i], fp);
+		fp = victim;
+	}
+	return -ENOSPC;
+}
+
+int
+rte_member_delete_cuckoo(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	uint8_t *table = ss->table;
+	uint32_t bkt[2], fp;
+	uint64_t w;
+	uint32_t i, j;
+
+	if (set_id != MEMBER_CUCKOO_SET_ID)
+		return -EINVAL;
+
+	cuckoo_hash(ss, key, &bkt[0], &bkt[1], &fp);
+
+	for (i = 0; i < RTE_DIM(bkt); i++) {
+		w = member_cuckoo_read(table, bkt[i]);
+		for (j = 0; j < MEMBER_CUCKOO_BUCKET_ENTRIES; j++) {
+			if (cuckoo_entry(w, j) == fp) {
+				cuckoo_write(table, bkt[i], j, 0);
+				return 0;
+			}
+		}
+	}
+	return -ENOENT;
+}
+
+void
+rte_member_free_cuckoo(struct rte_member_setsum *ss)
+{
+	rte_free(ss->table);
+}
+
+void
+rte_member_reset_cuckoo(const struct rte_member_setsum *ss)
+{
+	memset(ss->table, 0, (size_t)ss->bucket_cnt *
+			MEMBER_CUCKOO_BUCKET_SIZE + sizeof(uint64_t));
+}
@@ -0,0 +1,159 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_MEMBER_CUCKOO_H_
+#define _RTE_MEMBER_CUCKOO_H_
+
+#include <string.h>
+
+#include <rte_byteorder.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of fingerprints in a cuckoo filter bucket. */
+#define MEMBER_CUCKOO_BUCKET_ENTRIES 4
+/* Number of bits of a fingerprint, zero means an empty entry. */
+#define MEMBER_CUCKOO_FP_BITS 12
+#define MEMBER_CUCKOO_FP_MASK ((1ULL << MEMBER_CUCKOO_FP_BITS) - 1)
+/* Bytes used by a bucket, the 4 fingerprints are packed in 48 bits. */
+#define MEMBER_CUCKOO_BUCKET_SIZE 6
+/* Maximum number of evictions when adding a key. */
+#define MEMBER_CUCKOO_MAX_KICKS 500
+/* Expected load of the table in percent when num_keys are added. */
+#define MEMBER_CUCKOO_LOAD 95
+
+/* Lowest and highest bit of each fingerprint in a bucket word. */
+#define MEMBER_CUCKOO_LO_BITS 0x001001001001ULL
+#define MEMBER_CUCKOO_HI_BITS 0x800800800800ULL
+
+/* Set id reported for the keys found in the cuckoo filter. */
+#define MEMBER_CUCKOO_SET_ID 1
+
+/*
+ * The cuckoo filter is an array of bucket_cnt buckets of 6 bytes, followed
+ * by padding so that a bucket can always be read as a 64-bit word. Only the
+ * lower 48 bits of such a word belong to the bucket.
+ */
+
+static inline uint32_t
+member_cuckoo_reduce(uint32_t hash, uint32_t n)
+{
+	return ((uint64_t)hash * n) >> 32;
+}
+
+/*
+ * Alternate bucket of a fingerprint. (h - bkt) mod n is its own inverse,
+ * so the bucket count does not need to be a power of 2.
+ */
+static inline uint32_t
+member_cuckoo_alt_bucket(uint32_t bkt, uint32_t fp, uint32_t n)
+{
+	uint32_t h = member_cuckoo_reduce(fp * 0x5bd1e995, n);
+
+	return h >= bkt ? h - bkt : h + n - bkt;
+}
+
+/* Fingerprint word with the fingerprint replicated in all the entries. */
+static inline uint64_t
+member_cuckoo_fp_word(uint32_t fp)
+{
+	return fp * MEMBER_CUCKOO_LO_BITS;
+}
+
+static inline uint64_t
+member_cuckoo_read(const uint8_t *table, uint32_t bkt)
+{
+	uint64_t w;
+
+	memcpy(&w, table + (size_t)bkt * MEMBER_CUCKOO_BUCKET_SIZE, sizeof(w));
+	return rte_le_to_cpu_64(w);
+}
+
+/*
+ * Check if any entry of a bucket word equals the fingerprint, with the
+ * usual "has zero field" trick applied to the xor of both words.
+ */
+static inline int
+member_cuckoo_match(uint64_t w, uint64_t fp_word)
+{
+	uint64_t x = w ^ fp_word;
+
+	return ((x - MEMBER_CUCKOO_LO_BITS) & ~x & MEMBER_CUCKOO_HI_BITS) != 0;
+}
+
+/* Hashed keys prepared for the bulk lookup. */
+struct member_cuckoo_bulk {
+	uint32_t prim[RTE_MEMBER_LOOKUP_BULK_MAX]; /* Primary bucket offset. */
+	uint32_t sec[RTE_MEMBER_LOOKUP_BULK_MAX];  /* Alternate bucket offset. */
+	uint64_t fp[RTE_MEMBER_LOOKUP_BULK_MAX];   /* Fingerprint words. */
+};
+
+/* Scalar lookup of one of the prepared keys. */
+static inline int
+member_cuckoo_bulk_match(const uint8_t *table,
+		const struct member_cuckoo_bulk *bulk, uint32_t i)
+{
+	uint64_t w1, w2;
+
+	memcpy(&w1, table + bulk->prim[i], sizeof(w1));
+	memcpy(&w2, table + bulk->sec[i], sizeof(w2));
+	return member_cuckoo_match(rte_le_to_cpu_64(w1), bulk->fp[i]) ||
+		member_cuckoo_match(rte_le_to_cpu_64(w2), bulk->fp[i]);
+}
+
+int
+rte_member_create_cuckoo(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params);
+
+int
+rte_member_lookup_cuckoo(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_bulk_cuckoo(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys,
+		member_set_t *set_ids);
+
+uint32_t
+rte_member_lookup_multi_cuckoo(const struct rte_member_setsum *setsum,
+		const void *key, uint32_t match_per_key,
+		member_set_t *set_id);
+
+uint32_t
+rte_member_lookup_multi_bulk_cuckoo(const struct rte_member_setsum *setsum,
+		const void **keys, uint32_t num_keys, uint32_t match_per_key,
+		uint32_t *match_count,
+		member_set_t *set_ids);
+
+int
+rte_member_add_cuckoo(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+int
+rte_member_delete_cuckoo(const struct rte_member_setsum *setsum,
+		const void *key, member_set_t set_id);
+
+void
+rte_member_free_cuckoo(struct rte_member_setsum *ss);
+
+void
+rte_member_reset_cuckoo(const struct rte_member_setsum *setsum);
+
+uint32_t
+member_cuckoo_lookup_bulk_avx2(const struct rte_member_setsum *ss,
+		const struct member_cuckoo_bulk *bulk, uint32_t num_keys,
+		member_set_t *set_ids);
+
+uint32_t
+member_cuckoo_lookup_bulk_avx512(const struct rte_member_setsum *ss,
+		const struct member_cuckoo_bulk *bulk, uint32_t num_keys,
+		member_set_t *set_ids);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMBER_CUCKOO_H_ */
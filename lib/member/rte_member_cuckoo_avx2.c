@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <rte_bitops.h>
+#include <rte_vect.h>
+
+#include "rte_member.h"
+#include "rte_member_cuckoo.h"
+
+/* Return a lane mask of the keys found in either of their two buckets. */
+static __rte_always_inline uint32_t
+cuckoo_match_x4(const uint8_t *table, const struct member_cuckoo_bulk *bulk,
+		uint32_t i)
+{
+	const __m256i lo = _mm256_set1_epi64x(MEMBER_CUCKOO_LO_BITS);
+	const __m256i hi = _mm256_set1_epi64x(MEMBER_CUCKOO_HI_BITS);
+	__m128i prim = _mm_loadu_si128((const __m128i *)&bulk->prim[i]);
+	__m128i sec = _mm_loadu_si128((const __m128i *)&bulk->sec[i]);
+	__m256i fp = _mm256_loadu_si256((const __m256i *)&bulk->fp[i]);
+	__m256i x1, x2, t;
+
+	/* each gather reads one 64-bit bucket word per key */
+	x1 = _mm256_xor_si256(fp, _mm256_i32gather_epi64(
+			(const long long *)table, prim, 1));
+	x2 = _mm256_xor_si256(fp, _mm256_i32gather_epi64(
+			(const long long *)table, sec, 1));
+
+	/* an entry equals the fingerprint if its xor is zero */
+	t = _mm256_or_si256(
+		_mm256_andnot_si256(x1, _mm256_sub_epi64(x1, lo)),
+		_mm256_andnot_si256(x2, _mm256_sub_epi64(x2, lo)));
+	t = _mm256_cmpeq_epi64(_mm256_and_si256(t, hi),
+			_mm256_setzero_si256());
+
+	return ~_mm256_movemask_pd(_mm256_castsi256_pd(t)) & 0xf;
+}
+
+uint32_t
+member_cuckoo_lookup_bulk_avx2(const struct rte_member_setsum *ss,
+		const struct member_cuckoo_bulk *bulk, uint32_t num_keys,
+		member_set_t *set_ids)
+{
+	const uint8_t *table = ss->table;
+	uint32_t num_matches = 0;
+	uint32_t i, j, hits;
+
+	for (i = 0; i + 4 <= num_keys; i += 4) {
+		hits = cuckoo_match_x4(table, bulk, i);
+		for (j = 0; j < 4; j++)
+			set_ids[i + j] = (hits >> j) & 1 ?
+				MEMBER_CUCKOO_SET_ID : RTE_MEMBER_NO_MATCH;
+		num_matches += rte_popcount32(hits);
+	}
+
+	for (; i < num_keys; i++) {
+		if (member_cuckoo_bulk_match(table, bulk, i)) {
+			set_ids[i] = MEMBER_CUCKOO_SET_ID;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
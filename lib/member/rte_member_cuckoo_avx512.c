@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2025 The DPDK contributors
+ */
+
+#include <rte_bitops.h>
+#include <rte_vect.h>
+
+#include "rte_member.h"
+#include "rte_member_cuckoo.h"
+
+/* Return a lane mask of the keys found in either of their two buckets. */
+static __rte_always_inline uint32_t
+cuckoo_match_x8(const uint8_t *table, const struct member_cuckoo_bulk *bulk,
+		uint32_t i)
+{
+	const __m512i lo = _mm512_set1_epi64(MEMBER_CUCKOO_LO_BITS);
+	const __m512i hi = _mm512_set1_epi64(MEMBER_CUCKOO_HI_BITS);
+	__m256i prim = _mm256_loadu_si256((const __m256i *)&bulk->prim[i]);
+	__m256i sec = _mm256_loadu_si256((const __m256i *)&bulk->sec[i]);
+	__m512i fp = _mm512_loadu_si512(&bulk->fp[i]);
+	__m512i x1, x2, t;
+
+	/* each gather reads one 64-bit bucket word per key */
+	x1 = _mm512_xor_si512(fp, _mm512_i32gather_epi64(prim, table, 1));
+	x2 = _mm512_xor_si512(fp, _mm512_i32gather_epi64(sec, table, 1));
+
+	/* an entry equals the fingerprint if its xor is zero */
+	t = _mm512_or_si512(
+		_mm512_andnot_si512(x1, _mm512_sub_epi64(x1, lo)),
+		_mm512_andnot_si512(x2, _mm512_sub_epi64(x2, lo)));
+
+	return _mm512_test_epi64_mask(t, hi);
+}
+
+uint32_t
+member_cuckoo_lookup_bulk_avx512(const struct rte_member_setsum *ss,
+		const struct member_cuckoo_bulk *bulk, uint32_t num_keys,
+		member_set_t *set_ids)
+{
+	const uint8_t *table = ss->table;
+	uint32_t num_matches = 0;
+	uint32_t i, j, hits;
+
+	for (i = 0; i + 8 <= num_keys; i += 8) {
+		hits = cuckoo_match_x8(table, bulk, i);
+		for (j = 0; j < 8; j++)
+			set_ids[i + j] = (hits >> j) & 1 ?
+				MEMBER_CUCKOO_SET_ID : RTE_MEMBER_NO_MATCH;
+		num_matches += rte_popcount32(hits);
+	}
+
+	for (; i < num_keys; i++) {
+		if (member_cuckoo_bulk_match(table, bulk, i)) {
+			set_ids[i] = MEMBER_CUCKOO_SET_ID;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
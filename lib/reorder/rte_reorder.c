@@ -7,6 +7,7 @@
 #include <sys/queue.h>
 
 #include <eal_export.h>
+#include <rte_bitops.h>
 #include <rte_string_fns.h>
 #include <rte_log.h>
 #include <rte_mbuf.h>
@@ -56,8 +57,12 @@ struct __rte_cache_aligned rte_reorder_buffer {
 
 	struct cir_buffer ready_buf; /**< temp buffer for dequeued entries */
 	struct cir_buffer order_buf; /**< buffer used to reorder entries */
+	uint64_t *order_bmp; /**< bit set for each non-empty order_buf entry */
 };
 
+/* Number of 64-bit words in the bitmap tracking an order buffer of given size */
+#define REORDER_BMP_WORDS(size) (((size) + 63) / 64)
+
 static void
 rte_reorder_free_mbufs(struct rte_reorder_buffer *b);
 
@@ -65,7 +70,8 @@ RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_memory_footprint_get, 23.07)
 unsigned int
 rte_reorder_memory_footprint_get(unsigned int size)
 {
-	return sizeof(struct rte_reorder_buffer) + (2 * size * sizeof(struct rte_mbuf *));
+	return sizeof(struct rte_reorder_buffer) + (2 * size * sizeof(struct rte_mbuf *)) +
+		REORDER_BMP_WORDS(size) * sizeof(uint64_t);
 }
 
 RTE_EXPORT_SYMBOL(rte_reorder_init)
@@ -122,6 +128,8 @@ rte_reorder_init(struct rte_reorder_buffer *b, unsigned int bufsize,
 	b->ready_buf.entries = (void *)&b[1];
 	b->order_buf.entries = RTE_PTR_ADD(&b[1],
 			size * sizeof(b->ready_buf.entries[0]));
+	b->order_bmp = RTE_PTR_ADD(&b[1],
+			2 * size * sizeof(b->ready_buf.entries[0]));
 
 	return b;
 }
@@ -305,6 +313,98 @@ rte_reorder_find_existing(const char *name)
 	return b;
 }
 
+/* Mark order_buf entry at given position as filled */
+static inline void
+order_bmp_set(struct rte_reorder_buffer *b, unsigned int position)
+{
+	b->order_bmp[position / 64] |= RTE_BIT64(position % 64);
+}
+
+/* Mark n order_buf entries starting at given position as empty */
+static inline void
+order_bmp_clear(struct rte_reorder_buffer *b, unsigned int position,
+		unsigned int n)
+{
+	const unsigned int mask = b->order_buf.mask;
+	unsigned int bits;
+
+	while (n > 0) {
+		bits = RTE_MIN(n, RTE_MIN(64 - position % 64,
+				b->order_buf.size - position));
+		b->order_bmp[position / 64] &=
+			~(RTE_GENMASK64(bits - 1, 0) << (position % 64));
+		position = (position + bits) & mask;
+		n -= bits;
+	}
+}
+
+/*
+ * Count the filled order_buf entries starting from the head, up to max.
+ * The bitmap is scanned 64 entries at a time.
+ */
+static inline unsigned int
+order_buf_run_len(const struct rte_reorder_buffer *b, unsigned int max)
+{
+	const struct cir_buffer *order_buf = &b->order_buf;
+	unsigned int position = order_buf->head;
+	unsigned int bits, run, n = 0;
+	uint64_t word;
+
+	max = RTE_MIN(max, order_buf->size);
+	while (n < max) {
+		word = ~(b->order_bmp[position / 64] >> (position % 64));
+		bits = RTE_MIN(64 - position % 64, order_buf->size - position);
+		run = (word == 0) ? bits : RTE_MIN(rte_ctz64(word), bits);
+		n += run;
+		if (run < bits)
+			break;
+		position = (position + run) & order_buf->mask;
+	}
+
+	return RTE_MIN(n, max);
+}
+
+/*
+ * Copy n entries of a circular buffer starting at its given position,
+ * and empty them.
+ */
+static inline void
+cir_buffer_move(struct cir_buffer *buf, unsigned int position,
+		struct rte_mbuf **mbufs, unsigned int n)
+{
+	unsigned int n1 = RTE_MIN(n, buf->size - position);
+
+	memcpy(mbufs, &buf->entries[position], n1 * sizeof(mbufs[0]));
+	memset(&buf->entries[position], 0, n1 * sizeof(mbufs[0]));
+	if (n1 < n) {
+		memcpy(&mbufs[n1], &buf->entries[0], (n - n1) * sizeof(mbufs[0]));
+		memset(&buf->entries[0], 0, (n - n1) * sizeof(mbufs[0]));
+	}
+}
+
+/*
+ * Move the run of in-order entries at the head of order_buf,
+ * up to max entries, to the mbufs array.
+ */
+static inline unsigned int
+order_buf_drain_run(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
+		unsigned int max)
+{
+	struct cir_buffer *order_buf = &b->order_buf;
+	unsigned int n;
+
+	n = order_buf_run_len(b, max);
+	if (n == 0)
+		return 0;
+
+	cir_buffer_move(order_buf, order_buf->head, mbufs, n);
+	order_bmp_clear(b, order_buf->head, n);
+	order_buf->head = (order_buf->head + n) & order_buf->mask;
+	b->min_seqn += n;
+
+	return n;
+}
+
 static unsigned
 rte_reorder_fill_overflow(struct rte_reorder_buffer *b, unsigned n)
 {
@@ -340,6 +440,7 @@ rte_reorder_fill_overflow(struct rte_reorder_buffer *b, unsigned n)
 					order_buf->entries[order_buf->head];
 
 			order_buf->entries[order_buf->head] = NULL;
+			order_bmp_clear(b, order_buf->head, 1);
 			order_head_adv++;
 
 			order_buf->head = (order_buf->head + 1) & order_buf->mask;
@@ -356,23 +457,11 @@ rte_reorder_fill_overflow(struct rte_reorder_buffer *b, unsigned n)
 	return order_head_adv;
 }
 
-RTE_EXPORT_SYMBOL(rte_reorder_insert)
-int
-rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
+static inline int
+reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
 {
 	uint32_t offset, position;
-	struct cir_buffer *order_buf;
-
-	if (b == NULL || mbuf == NULL) {
-		rte_errno = EINVAL;
-		return -1;
-	}
-
-	order_buf = &b->order_buf;
-	if (!b->is_initialized) {
-		b->min_seqn = *rte_reorder_seqn(mbuf);
-		b->is_initialized = 1;
-	}
+	struct cir_buffer *order_buf = &b->order_buf;
 
 	/*
 	 * calculate the offset from the head pointer we need to go.
@@ -402,9 +491,10 @@ rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
 	 *       was previously skipped, so just enqueue the packet for
 	 *       immediate return on the next drain call, or else return error.
 	 */
-	if (offset < b->order_buf.size) {
+	if (likely(offset < b->order_buf.size)) {
 		position = (order_buf->head + offset) & order_buf->mask;
 		order_buf->entries[position] = mbuf;
+		order_bmp_set(b, position);
 	} else if (offset < 2 * b->order_buf.size) {
 		if (rte_reorder_fill_overflow(b, offset + 1 - order_buf->size)
 				< (offset + 1 - order_buf->size)) {
@@ -415,6 +505,7 @@ rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
 		offset = *rte_reorder_seqn(mbuf) - b->min_seqn;
 		position = (order_buf->head + offset) & order_buf->mask;
 		order_buf->entries[position] = mbuf;
+		order_bmp_set(b, position);
 	} else {
 		/* Put in handling for enqueue straight to output */
 		rte_errno = ERANGE;
@@ -423,34 +514,83 @@ rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
 	return 0;
 }
 
+RTE_EXPORT_SYMBOL(rte_reorder_insert)
+int
+rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
+{
+	if (b == NULL || mbuf == NULL) {
+		rte_errno = EINVAL;
+		return -1;
+	}
+
+	if (!b->is_initialized) {
+		b->min_seqn = *rte_reorder_seqn(mbuf);
+		b->is_initialized = 1;
+	}
+
+	return reorder_insert(b, mbuf);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_insert_bulk, 25.07)
+unsigned int
+rte_reorder_insert_bulk(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
+		unsigned int nb_mbufs)
+{
+	unsigned int i;
+
+	if (b == NULL || mbufs == NULL) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+
+	if (nb_mbufs == 0)
+		return 0;
+
+	if (!b->is_initialized) {
+		if (mbufs[0] == NULL) {
+			rte_errno = EINVAL;
+			return 0;
+		}
+		b->min_seqn = *rte_reorder_seqn(mbufs[0]);
+		b->is_initialized = 1;
+	}
+
+	for (i = 0; i < nb_mbufs; i++) {
+		if (unlikely(mbufs[i] == NULL)) {
+			rte_errno = EINVAL;
+			break;
+		}
+		if (reorder_insert(b, mbufs[i]) != 0)
+			break;
+	}
+
+	return i;
+}
+
 RTE_EXPORT_SYMBOL(rte_reorder_drain)
 unsigned int
 rte_reorder_drain(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
 		unsigned max_mbufs)
 {
-	unsigned int drain_cnt = 0;
+	unsigned int drain_cnt;
 
-	struct cir_buffer *order_buf = &b->order_buf,
-			*ready_buf = &b->ready_buf;
+	struct cir_buffer *ready_buf = &b->ready_buf;
 
 	/* Try to fetch requested number of mbufs from ready buffer */
-	while ((drain_cnt < max_mbufs) && (ready_buf->tail != ready_buf->head)) {
-		mbufs[drain_cnt++] = ready_buf->entries[ready_buf->tail];
-		ready_buf->entries[ready_buf->tail] = NULL;
-		ready_buf->tail = (ready_buf->tail + 1) & ready_buf->mask;
+	drain_cnt = RTE_MIN(max_mbufs,
+			(ready_buf->head - ready_buf->tail) & ready_buf->mask);
+	if (drain_cnt > 0) {
+		cir_buffer_move(ready_buf, ready_buf->tail, mbufs, drain_cnt);
+		ready_buf->tail = (ready_buf->tail + drain_cnt) & ready_buf->mask;
 	}
 
 	/*
 	 * If requested number of buffers not fetched from ready buffer, fetch
-	 * remaining buffers from order buffer
+	 * the in-order run of remaining buffers from order buffer
 	 */
-	while ((drain_cnt < max_mbufs) &&
-			(order_buf->entries[order_buf->head] != NULL)) {
-		mbufs[drain_cnt++] = order_buf->entries[order_buf->head];
-		order_buf->entries[order_buf->head] = NULL;
-		b->min_seqn++;
-		order_buf->head = (order_buf->head + 1) & order_buf->mask;
-	}
+	if (drain_cnt < max_mbufs)
+		drain_cnt += order_buf_drain_run(b, &mbufs[drain_cnt],
+				max_mbufs - drain_cnt);
 
 	return drain_cnt;
 }
@@ -528,6 +668,7 @@ rte_reorder_drain_up_to_seqn(struct rte_reorder_buffer *b, struct rte_mbuf **mbu
 		mbufs[drain_cnt++] = order_buf->entries[position];
 		order_buf->entries[position] = NULL;
 	}
+	order_bmp_clear(b, order_buf->head, i);
 	b->min_seqn += i;
 	order_buf->head = (order_buf->head + i) & order_buf->mask;
 
@@ -544,9 +685,9 @@ rte_reorder_is_empty(const struct rte_reorder_buffer *b)
 	if (ready_buf->tail != ready_buf->head)
 		return false;
 
-	/* Order buffer could have gaps, iterate */
-	for (i = 0; i < order_buf->size; i++) {
-		if (order_buf->entries[i] != NULL)
+	/* Order buffer could have gaps, check its bitmap */
+	for (i = 0; i < REORDER_BMP_WORDS(order_buf->size); i++) {
+		if (b->order_bmp[i] != 0)
 			return false;
 	}
 
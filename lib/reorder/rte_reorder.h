@@ -148,6 +148,31 @@ rte_reorder_reset(struct rte_reorder_buffer *b);
 int
 rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Insert a burst of mbufs in reorder buffer in their correct positions.
+ *
+ * This is equivalent to calling rte_reorder_insert() for each mbuf,
+ * stopping at the first mbuf which cannot be inserted.
+ *
+ * @param b
+ *   Reorder buffer where the mbufs have to be inserted.
+ * @param mbufs
+ *   Array of mbufs of packets that need to be inserted in reorder buffer.
+ * @param nb_mbufs
+ *   Number of mbufs in the array.
+ * @return
+ *   Number of mbufs inserted, starting from the first one.
+ *   If lower than nb_mbufs, rte_errno is set as by rte_reorder_insert()
+ *   for the first mbuf not inserted.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_insert_bulk(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
+		unsigned int nb_mbufs);
+
 /**
  * Fetch reordered buffers
  *
@@ -156,6 +181,9 @@ rte_reorder_insert(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf);
  * delayed too long before reaching the reorder window, or have been previously
  * dropped by the system.
  *
+ * The longest run of in-order buffers is located with a bitmap of the
+ * reorder window, and copied out at once.
+ *
  * @param b
  *   Reorder buffer instance from which packets are to be drained
  * @param mbufs
@@ -90,7 +90,7 @@ vhost_queue_stats_update(const struct virtio_net *dev, struct vhost_virtqueue *v
 static __rte_always_inline int64_t
 vhost_async_dma_transfer_one(struct virtio_net *dev, struct vhost_virtqueue *vq,
 		int16_t dma_id, uint16_t vchan_id, uint16_t flag_idx,
-		struct vhost_iov_iter *pkt)
+		struct vhost_iov_iter *pkt, uint16_t *nr_free)
 	__rte_requires_shared_capability(&vq->access_lock)
 {
 	struct async_dma_vchan_info *dma_info = &dma_copy_track[dma_id].vchans[vchan_id];
@@ -103,7 +103,7 @@ vhost_async_dma_transfer_one(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	uint32_t nr_segs = pkt->nr_segs;
 	uint16_t i;
 
-	if (rte_dma_burst_capacity(dma_id, vchan_id) < nr_segs)
+	if (*nr_free < nr_segs)
 		return -1;
 
 	for (i = 0; i < nr_segs; i++) {
@@ -133,6 +133,7 @@ vhost_async_dma_transfer_one(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	 * slot, and other slots are set to NULL.
 	 */
 	dma_info->pkts_cmpl_flag_addr[copy_idx & ring_mask] = &vq->async->pkts_cmpl_flag[flag_idx];
+	*nr_free -= nr_segs;
 
 	return nr_segs;
 }
@@ -146,12 +147,19 @@ vhost_async_dma_transfer(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	struct async_dma_vchan_info *dma_info = &dma_copy_track[dma_id].vchans[vchan_id];
 	int64_t ret, nr_copies = 0;
 	uint16_t pkt_idx;
+	uint16_t nr_free;
 
 	rte_spinlock_lock(&dma_info->dma_lock);
 
+	/*
+	 * The vChannel is only fed under the lock, so its capacity is read
+	 * once and the copies of the whole burst are submitted together.
+	 */
+	nr_free = rte_dma_burst_capacity(dma_id, vchan_id);
+
 	for (pkt_idx = 0; pkt_idx < nr_pkts; pkt_idx++) {
 		ret = vhost_async_dma_transfer_one(dev, vq, dma_id, vchan_id, head_idx,
-				&pkts[pkt_idx]);
+				&pkts[pkt_idx], &nr_free);
 		if (unlikely(ret < 0))
 			break;
 
@@ -2273,6 +2281,51 @@ write_back_completed_descs_packed(struct vhost_virtqueue *vq,
 	async->last_buffer_idx_packed = from;
 }
 
+/*
+ * With VIRTIO_F_IN_ORDER, the completed dequeue buffers are returned
+ * with a single used descriptor holding the id of the last buffer.
+ */
+static __rte_always_inline void
+write_back_completed_descs_packed_inorder(struct virtio_net *dev,
+				struct vhost_virtqueue *vq, uint16_t n_buffers)
+	__rte_requires_shared_capability(&vq->access_lock)
+{
+	struct vhost_async *async = vq->async;
+	uint16_t from = async->last_buffer_idx_packed;
+	uint16_t used_idx = vq->last_used_idx;
+	uint16_t last = from;
+	uint16_t flags;
+	uint16_t i;
+
+	if (unlikely(n_buffers == 0))
+		return;
+
+	flags = PACKED_DESC_DEQUEUE_USED_FLAG(vq->used_wrap_counter);
+
+	for (i = 0; i < n_buffers; i++) {
+		last = from;
+		vq_inc_last_used_packed(vq, async->buffers_packed[from].count);
+
+		from++;
+		if (from >= vq->size)
+			from = 0;
+	}
+
+	vq->desc_packed[used_idx].id = async->buffers_packed[last].id;
+	vq->desc_packed[used_idx].len = 0;
+	/* desc flags is the synchronization point for virtio packed vring */
+	rte_atomic_store_explicit(
+		(unsigned short __rte_atomic *)&vq->desc_packed[used_idx].flags,
+		flags, rte_memory_order_release);
+
+	vhost_log_cache_used_vring(dev, vq, used_idx *
+				   sizeof(struct vring_packed_desc),
+				   sizeof(struct vring_packed_desc));
+	vhost_log_cache_sync(dev, vq);
+
+	async->last_buffer_idx_packed = from;
+}
+
 static __rte_always_inline uint16_t
 vhost_poll_enqueue_completed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	struct rte_mbuf **pkts, uint16_t count, int16_t dma_id, uint16_t vchan_id)
@@ -3735,7 +3788,10 @@ async_poll_dequeue_completed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 
 	/* write back completed descs to used ring and update used idx */
 	if (vq_is_packed(dev)) {
-		write_back_completed_descs_packed(vq, nr_cpl_pkts);
+		if (virtio_net_is_inorder(dev))
+			write_back_completed_descs_packed_inorder(dev, vq, nr_cpl_pkts);
+		else
+			write_back_completed_descs_packed(vq, nr_cpl_pkts);
 		vhost_vring_call_packed(dev, vq);
 	} else {
 		write_back_completed_descs_split(vq, nr_cpl_pkts);
@@ -4078,6 +4134,7 @@ virtio_dev_tx_async_packed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	uint16_t slot_idx = 0;
 	uint16_t nr_done_pkts = 0;
 	uint16_t pkt_err = 0;
+	uint16_t nr_avail;
 	uint32_t n_xfer;
 	uint16_t i;
 	struct vhost_async *async = vq->async;
@@ -4088,8 +4145,13 @@ virtio_dev_tx_async_packed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 
 	async_iter_reset(async);
 
-	if (rte_pktmbuf_alloc_bulk(mbuf_pool, pkts_prealloc, count)) {
-		vq->stats.mbuf_alloc_failed += count;
+	/* Only allocate mbufs for the buffers made available by the guest. */
+	nr_avail = get_nb_avail_entries_packed(vq, count);
+	if (nr_avail == 0)
+		goto out;
+
+	if (rte_pktmbuf_alloc_bulk(mbuf_pool, pkts_prealloc, nr_avail)) {
+		vq->stats.mbuf_alloc_failed += nr_avail;
 		goto out;
 	}
 
@@ -4099,7 +4161,7 @@ virtio_dev_tx_async_packed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 		rte_prefetch0(&vq->desc_packed[vq->last_avail_idx]);
 
 		slot_idx = (async->pkts_idx + pkt_idx) % vq->size;
-		if (count - pkt_idx >= PACKED_BATCH_SIZE) {
+		if (nr_avail - pkt_idx >= PACKED_BATCH_SIZE) {
 			if (!virtio_dev_tx_async_packed_batch(dev, vq, &pkts_prealloc[pkt_idx],
 						slot_idx, dma_id, vchan_id)) {
 				for (i = 0; i < PACKED_BATCH_SIZE; i++) {
@@ -4115,7 +4177,7 @@ virtio_dev_tx_async_packed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 
 		if (unlikely(virtio_dev_tx_async_single_packed(dev, vq, mbuf_pool, pkt,
 				slot_idx, legacy_ol_flags))) {
-			rte_pktmbuf_free_bulk(&pkts_prealloc[pkt_idx], count - pkt_idx);
+			rte_pktmbuf_free_bulk(&pkts_prealloc[pkt_idx], nr_avail - pkt_idx);
 
 			if (slot_idx == 0)
 				slot_idx = vq->size - 1;
@@ -4127,7 +4189,7 @@ virtio_dev_tx_async_packed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 
 		pkts_info[slot_idx].mbuf = pkt;
 		pkt_idx++;
-	} while (pkt_idx < count);
+	} while (pkt_idx < nr_avail);
 
 	n_xfer = vhost_async_dma_transfer(dev, vq, dma_id, vchan_id, async->pkts_idx,
 					async->iov_iter, pkt_idx);